@@ -0,0 +1,50 @@
+#!/usr/bin/env bash
+# Copyright (c) 2023 The Bitcoin Core developers
+# Distributed under the MIT software license, see the accompanying
+# file COPYING or http://www.opensource.org/licenses/mit-license.php.
+#
+# Two-phase profile-guided optimization build.
+#
+# Phase 1 configures with --enable-pgo=generate, builds an instrumented
+# bench_bitcoin and trains it on the validation-heavy benchmarks (block
+# connection, script verification, block deserialization and coins caching),
+# which replay embedded representative blocks through ConnectBlock. Phase 2
+# rebuilds everything with --enable-pgo=use so the production binaries
+# (corald and friends) pick up the recorded profiles.
+#
+# Any arguments are forwarded to both ./configure invocations, e.g.:
+#   contrib/devtools/pgo-build.sh --enable-lto --disable-wallet
+
+export LC_ALL=C
+set -e
+
+TOPDIR=${TOPDIR:-$(git rev-parse --show-toplevel)}
+JOBS=${JOBS:-$(nproc 2>/dev/null || echo 1)}
+TRAIN_FILTER=${TRAIN_FILTER:-"ConnectBlock.*|VerifyScript.*|Deserialize.*Block.*|CCoinsCaching"}
+
+cd "$TOPDIR"
+
+if [ ! -x ./configure ]; then
+    ./autogen.sh
+fi
+
+echo "=== Phase 1: instrumented build (--enable-pgo=generate) ==="
+./configure --enable-pgo=generate "$@"
+make -j"$JOBS" -C src bench/bench_bitcoin
+
+echo "=== Training run: $TRAIN_FILTER ==="
+src/bench/bench_bitcoin -filter="$TRAIN_FILTER"
+
+# Clang writes raw profiles that must be indexed before -fprofile-use can
+# consume them; GCC's .gcda files are used in place.
+if command -v llvm-profdata >/dev/null 2>&1 && ls ./*.profraw >/dev/null 2>&1; then
+    llvm-profdata merge -output=default.profdata ./*.profraw
+fi
+
+echo "=== Phase 2: optimized build (--enable-pgo=use) ==="
+# Keep the .gcda/.profraw files; only the objects must be rebuilt.
+make clean
+./configure --enable-pgo=use "$@"
+make -j"$JOBS"
+
+echo "=== PGO build complete ==="
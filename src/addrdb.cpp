@@ -171,10 +171,25 @@ bool CBanDB::Read(banmap_t& banSet)
     return true;
 }
 
+namespace {
+//! Pre-serialized bytes passed through the SerializeFileDB machinery unchanged.
+struct RawBytes {
+    Span<const std::byte> m_bytes;
+    template <typename Stream>
+    void Serialize(Stream& s) const { s.write(m_bytes); }
+};
+} // namespace
+
 bool DumpPeerAddresses(const ArgsManager& args, const AddrMan& addr)
 {
     const auto pathAddr = args.GetDataDirNet() / "peers.dat";
-    return SerializeFileDB("peers", pathAddr, addr, CLIENT_VERSION);
+    // Serialize the table into memory first, so that cs_addrman is held only
+    // for the in-memory serialization and not for the file write and flush:
+    // on nodes carrying many addresses the disk I/O is what made the periodic
+    // dump stall address processing.
+    CDataStream ss{SER_DISK, CLIENT_VERSION};
+    ss << addr;
+    return SerializeFileDB("peers", pathAddr, RawBytes{MakeByteSpan(ss)}, CLIENT_VERSION);
 }
 
 void ReadFromStream(AddrMan& addr, CDataStream& ssPeers)
@@ -233,3 +248,43 @@ std::vector<CAddress> ReadAnchors(const fs::path& anchors_db_path)
     fs::remove(anchors_db_path);
     return anchors;
 }
+
+void DumpDNSSeedCache(const fs::path& seed_cache_path, const std::vector<CAddress>& addresses)
+{
+    SerializeFileDB("dnsseeds", seed_cache_path, addresses, CLIENT_VERSION | ADDRV2_FORMAT);
+}
+
+std::vector<CAddress> ReadDNSSeedCache(const fs::path& seed_cache_path)
+{
+    std::vector<CAddress> addresses;
+    try {
+        DeserializeFileDB(seed_cache_path, addresses, CLIENT_VERSION | ADDRV2_FORMAT);
+        LogPrintf("Loaded %i cached DNS seed addresses from %s\n", addresses.size(), fs::quoted(fs::PathToString(seed_cache_path.filename())));
+    } catch (const DbNotFoundError&) {
+        // First start, or the file was removed; resolution proceeds as usual.
+    } catch (const std::exception& e) {
+        LogPrintf("Ignoring unreadable %s: %s\n", fs::quoted(fs::PathToString(seed_cache_path.filename())), e.what());
+        addresses.clear();
+    }
+    return addresses;
+}
+
+void DumpPeerBlockHistory(const fs::path& history_db_path, const PeerBlockHistory& history)
+{
+    SerializeFileDB("blockhistory", history_db_path, history, CLIENT_VERSION | ADDRV2_FORMAT);
+}
+
+PeerBlockHistory ReadPeerBlockHistory(const fs::path& history_db_path)
+{
+    PeerBlockHistory history;
+    try {
+        DeserializeFileDB(history_db_path, history, CLIENT_VERSION | ADDRV2_FORMAT);
+        LogPrintf("Loaded block download history for %i addresses from %s\n", history.size(), fs::quoted(fs::PathToString(history_db_path.filename())));
+    } catch (const DbNotFoundError&) {
+        // First start, or the file was removed; begin with an empty history.
+    } catch (const std::exception& e) {
+        LogPrintf("Ignoring unreadable %s: %s\n", fs::quoted(fs::PathToString(history_db_path.filename())), e.what());
+        history.clear();
+    }
+    return history;
+}
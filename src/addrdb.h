@@ -8,8 +8,11 @@
 
 #include <fs.h>
 #include <net_types.h> // For banmap_t
+#include <netaddress.h>
+#include <serialize.h>
 #include <univalue.h>
 
+#include <map>
 #include <optional>
 #include <vector>
 
@@ -67,4 +70,47 @@ void DumpAnchors(const fs::path& anchors_db_path, const std::vector<CAddress>& a
  */
 std::vector<CAddress> ReadAnchors(const fs::path& anchors_db_path);
 
+/**
+ * Dump the last known-good DNS seed results (dnsseeds.dat), so a cold start
+ * can attempt connections before any seed resolution completes.
+ */
+void DumpDNSSeedCache(const fs::path& seed_cache_path, const std::vector<CAddress>& addresses);
+
+/**
+ * Read the last known-good DNS seed results (dnsseeds.dat).
+ *
+ * Returns an empty vector when the file does not exist or cannot be parsed;
+ * the cache is advisory and is rewritten after the next successful resolution.
+ */
+std::vector<CAddress> ReadDNSSeedCache(const fs::path& seed_cache_path);
+
+/** Per-address block download performance, persisted in blockhistory.dat. */
+struct PeerBlockHistoryEntry
+{
+    //! Exponential moving average of the peer's per-block delivery time,
+    //! in microseconds, as measured by net_processing.
+    uint64_t avg_block_delivery_us{0};
+    //! Number of delivery-time samples that fed the average.
+    uint64_t samples{0};
+
+    SERIALIZE_METHODS(PeerBlockHistoryEntry, obj) { READWRITE(obj.avg_block_delivery_us, obj.samples); }
+};
+
+using PeerBlockHistory = std::map<CNetAddr, PeerBlockHistoryEntry>;
+
+/**
+ * Dump per-address block download performance (blockhistory.dat), so block
+ * download assignment can size download windows for known peers right after
+ * a restart instead of re-learning their speed from scratch.
+ */
+void DumpPeerBlockHistory(const fs::path& history_db_path, const PeerBlockHistory& history);
+
+/**
+ * Read per-address block download performance (blockhistory.dat).
+ *
+ * Returns an empty map when the file does not exist or cannot be parsed;
+ * the history is advisory and is simply re-learned in that case.
+ */
+PeerBlockHistory ReadPeerBlockHistory(const fs::path& history_db_path);
+
 #endif // CORAL_ADDRDB_H
@@ -45,9 +45,11 @@ static constexpr auto ADDRMAN_TEST_WINDOW{40min};
 
 int AddrInfo::GetTriedBucket(const uint256& nKey, const NetGroupManager& netgroupman) const
 {
+    if (m_tried_bucket >= 0) return m_tried_bucket;
     uint64_t hash1 = (CHashWriter(SER_GETHASH, 0) << nKey << GetKey()).GetCheapHash();
     uint64_t hash2 = (CHashWriter(SER_GETHASH, 0) << nKey << netgroupman.GetGroup(*this) << (hash1 % ADDRMAN_TRIED_BUCKETS_PER_GROUP)).GetCheapHash();
-    return hash2 % ADDRMAN_TRIED_BUCKET_COUNT;
+    m_tried_bucket = hash2 % ADDRMAN_TRIED_BUCKET_COUNT;
+    return m_tried_bucket;
 }
 
 int AddrInfo::GetNewBucket(const uint256& nKey, const CNetAddr& src, const NetGroupManager& netgroupman) const
@@ -60,8 +62,14 @@ int AddrInfo::GetNewBucket(const uint256& nKey, const CNetAddr& src, const NetGr
 
 int AddrInfo::GetBucketPosition(const uint256& nKey, bool fNew, int nBucket) const
 {
+    // Calls typically repeat the (fNew, nBucket) combination the entry
+    // currently lives in, so keep a one-slot cache keyed by the arguments.
+    const int cache_key{(nBucket << 1) | (fNew ? 1 : 0)};
+    if (m_bucket_pos_key == cache_key) return m_bucket_pos;
     uint64_t hash1 = (CHashWriter(SER_GETHASH, 0) << nKey << (fNew ? uint8_t{'N'} : uint8_t{'K'}) << nBucket << GetKey()).GetCheapHash();
-    return hash1 % ADDRMAN_BUCKET_SIZE;
+    m_bucket_pos_key = cache_key;
+    m_bucket_pos = hash1 % ADDRMAN_BUCKET_SIZE;
+    return m_bucket_pos;
 }
 
 bool AddrInfo::IsTerrible(NodeSeconds now) const
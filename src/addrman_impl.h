@@ -63,6 +63,18 @@ public:
     //! position in vRandom
     mutable int nRandomPos{-1};
 
+    //! cached tried bucket, -1 if not yet computed (memory only). Valid for the
+    //! lifetime of the entry since it only depends on the addrman's fixed nKey.
+    mutable int m_tried_bucket{-1};
+
+    //! cached new bucket for the default source, -1 if not yet computed (memory only)
+    mutable int m_new_bucket{-1};
+
+    //! cache of the last GetBucketPosition result (memory only); the key packs
+    //! the (fNew, nBucket) arguments it was computed for, -1 if not yet computed
+    mutable int m_bucket_pos_key{-1};
+    mutable int m_bucket_pos{-1};
+
     SERIALIZE_METHODS(AddrInfo, obj)
     {
         READWRITEAS(CAddress, obj);
@@ -86,7 +98,8 @@ public:
     //! Calculate in which "new" bucket this entry belongs, using its default source
     int GetNewBucket(const uint256& nKey, const NetGroupManager& netgroupman) const
     {
-        return GetNewBucket(nKey, source, netgroupman);
+        if (m_new_bucket < 0) m_new_bucket = GetNewBucket(nKey, source, netgroupman);
+        return m_new_bucket;
     }
 
     //! Calculate in which position of a bucket to store this entry.
@@ -108,10 +108,17 @@ base_uint<BITS>& base_uint<BITS>::operator/=(const base_uint& b)
 template <unsigned int BITS>
 int base_uint<BITS>::CompareTo(const base_uint<BITS>& b) const
 {
-    for (int i = WIDTH - 1; i >= 0; i--) {
-        if (pn[i] < b.pn[i])
+    // Compare two limbs at a time. Composing adjacent 32-bit limbs into a
+    // 64-bit value is endian-neutral and compiles to a single load on
+    // little-endian targets, halving the number of branches on the hot
+    // header-validation path.
+    static_assert(WIDTH % 2 == 0, "64-bit limb walk requires an even number of 32-bit limbs");
+    for (int i = WIDTH - 2; i >= 0; i -= 2) {
+        const uint64_t a64 = (uint64_t{pn[i + 1]} << 32) | pn[i];
+        const uint64_t b64 = (uint64_t{b.pn[i + 1]} << 32) | b.pn[i];
+        if (a64 < b64)
             return -1;
-        if (pn[i] > b.pn[i])
+        if (a64 > b64)
             return 1;
     }
     return 0;
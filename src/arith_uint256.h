@@ -126,12 +126,20 @@ public:
 
     base_uint& operator+=(const base_uint& b)
     {
+        // Add two limbs at a time with an explicit carry chain; composing
+        // adjacent 32-bit limbs is endian-neutral and lets the compiler use
+        // full-width additions.
+        static_assert(WIDTH % 2 == 0, "64-bit limb walk requires an even number of 32-bit limbs");
         uint64_t carry = 0;
-        for (int i = 0; i < WIDTH; i++)
-        {
-            uint64_t n = carry + pn[i] + b.pn[i];
-            pn[i] = n & 0xffffffff;
-            carry = n >> 32;
+        for (int i = 0; i < WIDTH; i += 2) {
+            const uint64_t a64 = (uint64_t{pn[i + 1]} << 32) | pn[i];
+            const uint64_t b64 = (uint64_t{b.pn[i + 1]} << 32) | b.pn[i];
+            uint64_t sum = a64 + b64;
+            const uint64_t overflowed{sum < a64};
+            sum += carry;
+            carry = overflowed | uint64_t{sum < carry};
+            pn[i] = static_cast<uint32_t>(sum);
+            pn[i + 1] = static_cast<uint32_t>(sum >> 32);
         }
         return *this;
     }
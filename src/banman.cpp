@@ -72,6 +72,7 @@ void BanMan::ClearBanned()
     {
         LOCK(m_cs_banned);
         m_banned.clear();
+        m_ban_cache.clear();
         m_is_dirty = true;
     }
     DumpBanlist(); //store banlist to disk
@@ -88,15 +89,21 @@ bool BanMan::IsBanned(const CNetAddr& net_addr)
 {
     auto current_time = GetTime();
     LOCK(m_cs_banned);
+    const auto cached = m_ban_cache.find(net_addr);
+    if (cached != m_ban_cache.end()) {
+        return current_time < cached->second;
+    }
+    // Cache the latest expiry of any matching entry rather than a boolean, so
+    // a cached verdict still honors ban expiry without a banlist sweep.
+    int64_t banned_until{0};
     for (const auto& it : m_banned) {
-        CSubNet sub_net = it.first;
-        CBanEntry ban_entry = it.second;
-
-        if (current_time < ban_entry.nBanUntil && sub_net.Match(net_addr)) {
-            return true;
+        if (it.first.Match(net_addr) && it.second.nBanUntil > banned_until) {
+            banned_until = it.second.nBanUntil;
         }
     }
-    return false;
+    if (m_ban_cache.size() >= BAN_DECISION_CACHE_MAX) m_ban_cache.clear();
+    m_ban_cache.emplace(net_addr, banned_until);
+    return current_time < banned_until;
 }
 
 bool BanMan::IsBanned(const CSubNet& sub_net)
@@ -141,6 +148,7 @@ void BanMan::Ban(const CSubNet& sub_net, int64_t ban_time_offset, bool since_uni
         LOCK(m_cs_banned);
         if (m_banned[sub_net].nBanUntil < ban_entry.nBanUntil) {
             m_banned[sub_net] = ban_entry;
+            m_ban_cache.clear();
             m_is_dirty = true;
         } else
             return;
@@ -162,6 +170,7 @@ bool BanMan::Unban(const CSubNet& sub_net)
     {
         LOCK(m_cs_banned);
         if (m_banned.erase(sub_net) == 0) return false;
+        m_ban_cache.clear();
         m_is_dirty = true;
     }
     if (m_client_interface) m_client_interface->BannedListChanged();
@@ -196,6 +205,7 @@ void BanMan::SweepBanned()
             ++it;
         }
     }
+    if (notify_ui) m_ban_cache.clear();
 
     // update UI
     if (notify_ui && m_client_interface) {
@@ -9,10 +9,12 @@
 #include <common/bloom.h>
 #include <fs.h>
 #include <net_types.h> // For banmap_t
+#include <netaddress.h>
 #include <sync.h>
 
 #include <chrono>
 #include <cstdint>
+#include <map>
 #include <memory>
 
 // NOTE: When adjusting this, update rpcnet:setban's help ("24h")
@@ -87,8 +89,17 @@ private:
     //!clean unused entries (if bantime has expired)
     void SweepBanned() EXCLUSIVE_LOCKS_REQUIRED(m_cs_banned);
 
+    //! Maximum number of cached ban decisions before the cache is reset.
+    static constexpr size_t BAN_DECISION_CACHE_MAX{5000};
+
     RecursiveMutex m_cs_banned;
     banmap_t m_banned GUARDED_BY(m_cs_banned);
+    //! Cache of recent IsBanned(CNetAddr) decisions: the latest nBanUntil of
+    //! any banlist entry matching the address, or 0 if none does. Matching an
+    //! address against every banned subnet is linear in the banlist size, so
+    //! inbound churn re-deriving the same verdict is served from here instead;
+    //! the cache is dropped whenever the banlist changes.
+    std::map<CNetAddr, int64_t> m_ban_cache GUARDED_BY(m_cs_banned);
     bool m_is_dirty GUARDED_BY(m_cs_banned){false};
     CClientUIInterface* m_client_interface = nullptr;
     CBanDB m_ban_db;
@@ -0,0 +1,95 @@
+// Copyright (c) 2022 The Coral Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <bench/bench.h>
+#include <key.h>
+#include <pubkey.h>
+#include <random.h>
+#include <uint256.h>
+
+#include <secp256k1.h>
+
+#include <cassert>
+#include <vector>
+
+// Quantifies the per-signature fixed overhead of ECDSA verification during
+// block validation. CPubKey::Verify re-parses the public key and signature
+// and re-normalizes on every call; a block-level batch stage would parse each
+// triple once and then only pay for the group operations. The vendored
+// libsecp256k1 offers no true batch verification API, so the pre-parsed
+// variant is the current upper bound on what such a stage could recover.
+
+namespace {
+
+constexpr size_t NUM_SIGS{1000};
+
+struct SigTriple {
+    CPubKey pubkey;
+    uint256 msghash;
+    std::vector<unsigned char> sig;
+};
+
+std::vector<SigTriple> CreateTriples()
+{
+    ECC_Start();
+    FastRandomContext rng{/*fDeterministic=*/true};
+    std::vector<SigTriple> triples;
+    triples.reserve(NUM_SIGS);
+    for (size_t i = 0; i < NUM_SIGS; ++i) {
+        CKey key;
+        key.MakeNewKey(/*fCompressed=*/true);
+        SigTriple triple;
+        triple.pubkey = key.GetPubKey();
+        triple.msghash = rng.rand256();
+        const bool ok{key.Sign(triple.msghash, triple.sig)};
+        assert(ok);
+        triples.push_back(std::move(triple));
+    }
+    ECC_Stop();
+    return triples;
+}
+
+//! One-at-a-time verification, as CheckECDSASignature does per input.
+void ECDSAVerify(benchmark::Bench& bench)
+{
+    const ECCVerifyHandle verify_handle;
+    const std::vector<SigTriple> triples{CreateTriples()};
+    bench.unit("sig").batch(triples.size()).run([&] {
+        for (const SigTriple& t : triples) {
+            const bool ok{t.pubkey.Verify(t.msghash, t.sig)};
+            assert(ok);
+        }
+    });
+}
+
+//! Verification with pubkeys and signatures parsed up front, modelling a
+//! batch stage that amortizes everything except the group operations.
+void ECDSAVerifyPreparsed(benchmark::Bench& bench)
+{
+    const ECCVerifyHandle verify_handle;
+    const std::vector<SigTriple> triples{CreateTriples()};
+    const secp256k1_context* ctx{GetVerifyContext()};
+
+    std::vector<secp256k1_pubkey> pubkeys{triples.size()};
+    std::vector<secp256k1_ecdsa_signature> sigs{triples.size()};
+    for (size_t i = 0; i < triples.size(); ++i) {
+        int ret{secp256k1_ec_pubkey_parse(ctx, &pubkeys[i], triples[i].pubkey.data(), triples[i].pubkey.size())};
+        assert(ret);
+        ret = secp256k1_ecdsa_signature_parse_der(ctx, &sigs[i], triples[i].sig.data(), triples[i].sig.size());
+        assert(ret);
+        secp256k1_ecdsa_signature_normalize(ctx, &sigs[i], &sigs[i]);
+    }
+
+    bench.unit("sig").batch(triples.size()).run([&] {
+        for (size_t i = 0; i < triples.size(); ++i) {
+            const int ok{secp256k1_ecdsa_verify(ctx, &sigs[i], triples[i].msghash.begin(), &pubkeys[i])};
+            assert(ok);
+        }
+    });
+}
+
+} // namespace
+
+BENCHMARK(ECDSAVerify);
+BENCHMARK(ECDSAVerifyPreparsed);
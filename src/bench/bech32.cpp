@@ -5,8 +5,12 @@
 #include <bench/bench.h>
 
 #include <bech32.h>
+#include <key_io.h>
+#include <test/util/setup_common.h>
+#include <uint256.h>
 #include <util/strencodings.h>
 
+#include <cstring>
 #include <string>
 #include <vector>
 
@@ -32,5 +36,26 @@ static void Bech32Decode(benchmark::Bench& bench)
 }
 
 
+static void DecodeDestinationCached(benchmark::Bench& bench)
+{
+    const auto testing_setup = MakeNoLogFileContext<const BasicTestingSetup>(CBaseChainParams::MAIN);
+
+    // Mimic a payout batch: the same recipient set decoded on every call, so
+    // after the first pass every lookup is served by the decode cache.
+    std::vector<std::string> addrs;
+    for (int i = 0; i < 100; ++i) {
+        uint160 hash;
+        std::memcpy(hash.begin(), &i, sizeof(i));
+        addrs.push_back(EncodeDestination(WitnessV0KeyHash(hash)));
+    }
+    bench.batch(addrs.size()).unit("address").run([&] {
+        for (const CTxDestination& dest : DecodeDestinations(addrs)) {
+            assert(IsValidDestination(dest));
+        }
+    });
+}
+
+
 BENCHMARK(Bech32Encode);
 BENCHMARK(Bech32Decode);
+BENCHMARK(DecodeDestinationCached);
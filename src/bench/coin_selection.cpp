@@ -41,7 +41,7 @@ static void addCoin(const CAmount& nValue, const CWallet& wallet, std::vector<st
 // same one over and over isn't too useful. Generating random isn't useful
 // either for measurements."
 // (https://github.com/coral/coral/issues/7883#issuecomment-224807484)
-static void CoinSelection(benchmark::Bench& bench)
+static void CoinSelectionN(benchmark::Bench& bench, int num_coins)
 {
     NodeContext node;
     auto chain = interfaces::MakeChain(node);
@@ -50,7 +50,7 @@ static void CoinSelection(benchmark::Bench& bench)
     LOCK(wallet.cs_wallet);
 
     // Add coins.
-    for (int i = 0; i < 1000; ++i) {
+    for (int i = 0; i < num_coins; ++i) {
         addCoin(1000 * COIN, wallet, wtxs);
     }
     addCoin(3 * COIN, wallet, wtxs);
@@ -83,6 +83,14 @@ static void CoinSelection(benchmark::Bench& bench)
     });
 }
 
+static void CoinSelection(benchmark::Bench& bench) { CoinSelectionN(bench, 1000); }
+// Large-wallet scenarios: selection cost is dominated by grouping and sorting,
+// so these sizes show whether selection stays usable on wallets with very many
+// UTXOs.
+static void CoinSelection10k(benchmark::Bench& bench) { CoinSelectionN(bench, 10'000); }
+static void CoinSelection100k(benchmark::Bench& bench) { CoinSelectionN(bench, 100'000); }
+static void CoinSelection1M(benchmark::Bench& bench) { CoinSelectionN(bench, 1'000'000); }
+
 // Copied from src/wallet/test/coinselector_tests.cpp
 static void add_coin(const CAmount& nValue, int nInput, std::vector<OutputGroup>& set)
 {
@@ -122,4 +130,7 @@ static void BnBExhaustion(benchmark::Bench& bench)
 }
 
 BENCHMARK(CoinSelection);
+BENCHMARK(CoinSelection10k);
+BENCHMARK(CoinSelection100k);
+BENCHMARK(CoinSelection1M);
 BENCHMARK(BnBExhaustion);
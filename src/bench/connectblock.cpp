@@ -0,0 +1,149 @@
+// Copyright (c) 2022 The Coral Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <bench/bench.h>
+#include <chain.h>
+#include <coins.h>
+#include <consensus/amount.h>
+#include <consensus/consensus.h>
+#include <consensus/validation.h>
+#include <key.h>
+#include <primitives/transaction.h>
+#include <script/interpreter.h>
+#include <script/script.h>
+#include <test/util/script.h>
+#include <test/util/setup_common.h>
+#include <uint256.h>
+#include <validation.h>
+
+#include <cassert>
+#include <vector>
+
+// End-to-end ConnectBlock macro-benchmark: synthesizes a full block of
+// transactions on top of a TestChain100Setup chain and reconnects it to a
+// throwaway coins view on every iteration, so coins access, script checks
+// and undo accounting are all measured together. The transaction mix and the
+// script check worker count are parameters, giving a per-release regression
+// signal for IBD-style validation throughput.
+
+namespace {
+
+//! What the transactions in the benchmarked block spend.
+enum class TxMix {
+    //! 1-in-1-out P2WSH OP_TRUE spends: coins cache and merkle heavy, no signature checks.
+    OP_TRUE,
+    //! 1-in-1-out P2PK spends: one ECDSA verification per transaction.
+    P2PK,
+};
+
+//! Number of mature coinbases split up by the funding block.
+constexpr int NUM_FUNDING_TXS{COINBASE_MATURITY};
+//! Outputs per funding transaction, so the benchmarked block carries
+//! NUM_FUNDING_TXS * OUTPUTS_PER_FUNDING_TX transactions.
+constexpr int OUTPUTS_PER_FUNDING_TX{24};
+
+//! Create a transaction spending output `n` of the P2PK transaction `prev`
+//! (held by `key`), splitting it into `num_outputs` outputs paying `out_script`.
+CMutableTransaction SpendP2PK(const CKey& key, const CTransaction& prev, uint32_t n, int num_outputs, const CScript& out_script)
+{
+    CMutableTransaction tx;
+    tx.vin.emplace_back(COutPoint{prev.GetHash(), n});
+    const CAmount total{prev.vout[n].nValue - 10000};
+    for (int i = 0; i < num_outputs; ++i) {
+        tx.vout.emplace_back(total / num_outputs, out_script);
+    }
+    const uint256 sighash{SignatureHash(prev.vout[n].scriptPubKey, tx, 0, SIGHASH_ALL, prev.vout[n].nValue, SigVersion::BASE)};
+    std::vector<unsigned char> sig;
+    const bool ok{key.Sign(sighash, sig)};
+    assert(ok);
+    sig.push_back(SIGHASH_ALL);
+    tx.vin[0].scriptSig = CScript() << sig;
+    return tx;
+}
+
+void ConnectBlockBench(benchmark::Bench& bench, TxMix mix, int worker_threads)
+{
+    const auto test_setup{MakeNoLogFileContext<TestChain100Setup>()};
+
+    // Reconfigure the script check worker pool (the testing setup starts 2).
+    StopScriptCheckWorkerThreads();
+    if (worker_threads > 0) {
+        StartScriptCheckWorkerThreads(worker_threads);
+    } else {
+        g_parallel_script_checks = false;
+    }
+
+    const CScript p2pk_script{CScript() << ToByteVector(test_setup->coinbaseKey.GetPubKey()) << OP_CHECKSIG};
+    const CScript& funded_script{mix == TxMix::P2PK ? p2pk_script : P2WSH_OP_TRUE};
+
+    // Mature the first 100 coinbases, then split each of them into 24 outputs
+    // of the type under test with a single processed funding block.
+    test_setup->mineBlocks(COINBASE_MATURITY);
+    std::vector<CMutableTransaction> funding_txs;
+    funding_txs.reserve(NUM_FUNDING_TXS);
+    for (int i = 0; i < NUM_FUNDING_TXS; ++i) {
+        funding_txs.push_back(SpendP2PK(test_setup->coinbaseKey, *test_setup->m_coinbase_txns[i], 0, OUTPUTS_PER_FUNDING_TX, funded_script));
+    }
+    test_setup->CreateAndProcessBlock(funding_txs, P2WSH_OP_TRUE);
+
+    // The benchmarked block spends every funding output with a separate
+    // 1-in-1-out transaction.
+    CScriptWitness witness;
+    witness.stack.push_back(WITNESS_STACK_ELEM_OP_TRUE);
+    std::vector<CMutableTransaction> block_txs;
+    block_txs.reserve(NUM_FUNDING_TXS * OUTPUTS_PER_FUNDING_TX);
+    for (const CMutableTransaction& funding_mtx : funding_txs) {
+        const CTransaction funding_tx{funding_mtx};
+        for (int n = 0; n < OUTPUTS_PER_FUNDING_TX; ++n) {
+            if (mix == TxMix::P2PK) {
+                block_txs.push_back(SpendP2PK(test_setup->coinbaseKey, funding_tx, n, 1, P2WSH_OP_TRUE));
+            } else {
+                CMutableTransaction tx;
+                tx.vin.emplace_back(COutPoint{funding_tx.GetHash(), (uint32_t)n});
+                tx.vin.back().scriptWitness = witness;
+                tx.vout.emplace_back(funding_tx.vout[n].nValue - 1000, P2WSH_OP_TRUE);
+                block_txs.push_back(tx);
+            }
+        }
+    }
+
+    Chainstate& chainstate{test_setup->m_node.chainman->ActiveChainstate()};
+    const CBlock block{test_setup->CreateBlock(block_txs, P2WSH_OP_TRUE, chainstate)};
+
+    // ConnectBlock inserts the index into the dirty block index set, which is
+    // consulted while the testing setup tears down, so it must outlive the
+    // setup: leak it (the same reason the logger is leaked).
+    uint256* block_hash{new uint256{block.GetHash()}};
+    CBlockIndex* pindex{new CBlockIndex{block}};
+    {
+        LOCK(cs_main);
+        pindex->pprev = chainstate.m_chain.Tip();
+        pindex->nHeight = chainstate.m_chain.Height() + 1;
+        pindex->phashBlock = block_hash;
+    }
+
+    bench.unit("block").run([&] {
+        LOCK(cs_main);
+        // Each iteration connects onto a throwaway view of the current tip,
+        // so the chainstate itself never advances and the block stays
+        // connectable. Script check results are not cached when actually
+        // connecting, so every iteration does the full script work.
+        CCoinsViewCache view{&chainstate.CoinsTip()};
+        BlockValidationState state;
+        const bool ok{chainstate.ConnectBlock(block, state, pindex, view)};
+        assert(ok);
+    });
+}
+
+void ConnectBlockOpTrue(benchmark::Bench& bench) { ConnectBlockBench(bench, TxMix::OP_TRUE, /*worker_threads=*/2); }
+void ConnectBlockP2pk(benchmark::Bench& bench) { ConnectBlockBench(bench, TxMix::P2PK, /*worker_threads=*/2); }
+void ConnectBlockP2pkSingleThread(benchmark::Bench& bench) { ConnectBlockBench(bench, TxMix::P2PK, /*worker_threads=*/0); }
+void ConnectBlockP2pkFourWorkers(benchmark::Bench& bench) { ConnectBlockBench(bench, TxMix::P2PK, /*worker_threads=*/4); }
+
+} // namespace
+
+BENCHMARK(ConnectBlockOpTrue);
+BENCHMARK(ConnectBlockP2pk);
+BENCHMARK(ConnectBlockP2pkSingleThread);
+BENCHMARK(ConnectBlockP2pkFourWorkers);
@@ -90,6 +90,18 @@ static void SipHash_32b(benchmark::Bench& bench)
     });
 }
 
+static void SipHash_32b_Batch(benchmark::Bench& bench)
+{
+    FastRandomContext rng(true);
+    std::vector<uint256> in(1024);
+    std::vector<uint64_t> out(in.size());
+    for (auto& x : in) x = rng.rand256();
+    uint64_t k1 = 0;
+    bench.batch(in.size()).unit("hash").run([&] {
+        SipHashUint256Batch(0, ++k1, in.data(), out.data(), in.size());
+    });
+}
+
 static void FastRandom_32bit(benchmark::Bench& bench)
 {
     FastRandomContext rng(true);
@@ -158,6 +170,7 @@ BENCHMARK(SHA3_256_1M);
 
 BENCHMARK(SHA256_32b);
 BENCHMARK(SipHash_32b);
+BENCHMARK(SipHash_32b_Batch);
 BENCHMARK(SHA256D64_1024);
 BENCHMARK(FastRandom_32bit);
 BENCHMARK(FastRandom_1bit);
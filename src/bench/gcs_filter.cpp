@@ -5,7 +5,7 @@
 #include <bench/bench.h>
 #include <blockfilter.h>
 
-static const GCSFilter::ElementSet GenerateGCSTestElements()
+static const GCSFilter::ElementSet GenerateGCSTestElements(int num_elements = 100000)
 {
     GCSFilter::ElementSet elements;
 
@@ -13,7 +13,7 @@ static const GCSFilter::ElementSet GenerateGCSTestElements()
     // with at least 100,000 elements results in benchmarks that have the same
     // ns/op. This makes it easy to reason about how long (in nanoseconds) a single
     // filter element takes to process.
-    for (int i = 0; i < 100000; ++i) {
+    for (int i = 0; i < num_elements; ++i) {
         GCSFilter::Element element(32);
         element[0] = static_cast<unsigned char>(i);
         element[1] = static_cast<unsigned char>(i >> 8);
@@ -35,9 +35,9 @@ static void GCSBlockFilterGetHash(benchmark::Bench& bench)
     });
 }
 
-static void GCSFilterConstruct(benchmark::Bench& bench)
+static void GCSFilterConstructN(benchmark::Bench& bench, int num_elements)
 {
-    auto elements = GenerateGCSTestElements();
+    auto elements = GenerateGCSTestElements(num_elements);
 
     uint64_t siphash_k0 = 0;
     bench.run([&]{
@@ -47,6 +47,23 @@ static void GCSFilterConstruct(benchmark::Bench& bench)
     });
 }
 
+static void GCSFilterConstruct(benchmark::Bench& bench)
+{
+    GCSFilterConstructN(bench, 100000);
+}
+
+// Element counts of typical and worst-case full blocks, so the per-filter
+// construction cost during a blockfilterindex build can be read off directly.
+static void GCSFilterConstructBlockTypical(benchmark::Bench& bench)
+{
+    GCSFilterConstructN(bench, 2500);
+}
+
+static void GCSFilterConstructBlockMax(benchmark::Bench& bench)
+{
+    GCSFilterConstructN(bench, 10000);
+}
+
 static void GCSFilterDecode(benchmark::Bench& bench)
 {
     auto elements = GenerateGCSTestElements();
@@ -83,6 +100,8 @@ static void GCSFilterMatch(benchmark::Bench& bench)
 }
 BENCHMARK(GCSBlockFilterGetHash);
 BENCHMARK(GCSFilterConstruct);
+BENCHMARK(GCSFilterConstructBlockTypical);
+BENCHMARK(GCSFilterConstructBlockMax);
 BENCHMARK(GCSFilterDecode);
 BENCHMARK(GCSFilterDecodeSkipCheck);
 BENCHMARK(GCSFilterMatch);
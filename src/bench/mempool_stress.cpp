@@ -79,6 +79,167 @@ static std::vector<CTransactionRef> CreateOrderedCoins(FastRandomContext& det_ra
     return ordered_coins;
 }
 
+// Topology generators modelling the workload shapes that hurt in practice:
+// deep CPFP chains and wide fan-in consolidations. Transactions are returned
+// in topological order so they can be fed straight into addUnchecked.
+
+static CTransactionRef MakeTopologyTx(size_t& tx_counter, const std::vector<COutPoint>& inputs, size_t num_outputs)
+{
+    CMutableTransaction tx;
+    if (inputs.empty()) {
+        tx.vin.resize(1);
+        tx.vin[0].scriptSig = CScript() << CScriptNum(static_cast<int64_t>(tx_counter));
+    } else {
+        for (const COutPoint& prevout : inputs) {
+            tx.vin.emplace_back();
+            tx.vin.back().prevout = prevout;
+            tx.vin.back().scriptSig = CScript() << CScriptNum(static_cast<int64_t>(tx_counter));
+        }
+    }
+    tx.vout.resize(num_outputs);
+    for (auto& out : tx.vout) {
+        out.scriptPubKey = CScript() << CScriptNum(static_cast<int64_t>(tx_counter)) << OP_EQUAL;
+        out.nValue = 10 * COIN;
+    }
+    ++tx_counter;
+    return MakeTransactionRef(tx);
+}
+
+//! `num_chains` independent single-input/single-output chains, each `depth`
+//! transactions deep (25 matches the default ancestor policy limit).
+static std::vector<CTransactionRef> CreateChainTopology(size_t num_chains, size_t depth)
+{
+    size_t tx_counter{1};
+    std::vector<CTransactionRef> txs;
+    txs.reserve(num_chains * depth);
+    for (size_t c = 0; c < num_chains; ++c) {
+        txs.push_back(MakeTopologyTx(tx_counter, {}, 1));
+        for (size_t d = 1; d < depth; ++d) {
+            txs.push_back(MakeTopologyTx(tx_counter, {COutPoint(txs.back()->GetHash(), 0)}, 1));
+        }
+    }
+    return txs;
+}
+
+//! `num_consolidations` groups of `fan_in` single-output parents, each group
+//! swept by one wide consolidation transaction.
+static std::vector<CTransactionRef> CreateFanInTopology(size_t num_consolidations, size_t fan_in)
+{
+    size_t tx_counter{1};
+    std::vector<CTransactionRef> txs;
+    txs.reserve(num_consolidations * (fan_in + 1));
+    for (size_t c = 0; c < num_consolidations; ++c) {
+        std::vector<COutPoint> inputs;
+        inputs.reserve(fan_in);
+        for (size_t i = 0; i < fan_in; ++i) {
+            txs.push_back(MakeTopologyTx(tx_counter, {}, 1));
+            inputs.emplace_back(txs.back()->GetHash(), 0);
+        }
+        txs.push_back(MakeTopologyTx(tx_counter, inputs, 1));
+    }
+    return txs;
+}
+
+//! addUnchecked throughput for a given topology. Scale the transaction count
+//! with -asymptote (complexityN is the total transaction target, e.g. 100000).
+static void MempoolAddTopology(benchmark::Bench& bench, bool fan_in)
+{
+    size_t num_txs{10000};
+    if (bench.complexityN() > 1) {
+        num_txs = static_cast<size_t>(bench.complexityN());
+    }
+    const std::vector<CTransactionRef> txs{fan_in ? CreateFanInTopology(num_txs / 51, /*fan_in=*/50) :
+                                                    CreateChainTopology(num_txs / 25, /*depth=*/25)};
+    const auto testing_setup = MakeNoLogFileContext<const TestingSetup>(CBaseChainParams::MAIN);
+    CTxMemPool& pool = *testing_setup.get()->m_node.mempool;
+    LOCK2(cs_main, pool.cs);
+    bench.unit("tx").batch(txs.size()).run([&]() NO_THREAD_SAFETY_ANALYSIS {
+        for (const auto& tx : txs) {
+            AddTx(tx, pool);
+        }
+        pool.clear();
+    });
+}
+
+static void MempoolAddDeepChains(benchmark::Bench& bench) { MempoolAddTopology(bench, /*fan_in=*/false); }
+static void MempoolAddWideFanIn(benchmark::Bench& bench) { MempoolAddTopology(bench, /*fan_in=*/true); }
+
+//! CalculateMemPoolAncestors for every chain tip of a pool full of 25-deep
+//! chains, i.e. the lookups done for each incoming CPFP child at the policy
+//! depth limit.
+static void MempoolAncestryDeepChains(benchmark::Bench& bench)
+{
+    constexpr size_t NUM_CHAINS{400};
+    constexpr size_t DEPTH{25};
+    const std::vector<CTransactionRef> txs{CreateChainTopology(NUM_CHAINS, DEPTH)};
+    const auto testing_setup = MakeNoLogFileContext<const TestingSetup>(CBaseChainParams::MAIN);
+    CTxMemPool& pool = *testing_setup.get()->m_node.mempool;
+    LOCK2(cs_main, pool.cs);
+    for (const auto& tx : txs) {
+        AddTx(tx, pool);
+    }
+    bench.unit("tip").batch(NUM_CHAINS).run([&]() NO_THREAD_SAFETY_ANALYSIS {
+        for (size_t c = 0; c < NUM_CHAINS; ++c) {
+            const auto iter{pool.GetIter(txs[(c + 1) * DEPTH - 1]->GetHash())};
+            assert(iter);
+            CTxMemPool::setEntries ancestors;
+            std::string err;
+            pool.CalculateMemPoolAncestors(**iter, ancestors, /*limitAncestorCount=*/50, /*limitAncestorSize=*/1000000, /*limitDescendantCount=*/50, /*limitDescendantSize=*/1000000, err);
+            assert(ancestors.size() == DEPTH - 1);
+        }
+    });
+}
+
+//! removeForBlock when a block sweeps the bottom of every chain, forcing
+//! descendant state updates for all remaining transactions.
+static void MempoolRemoveForBlockDeepChains(benchmark::Bench& bench)
+{
+    constexpr size_t NUM_CHAINS{400};
+    constexpr size_t DEPTH{25};
+    const std::vector<CTransactionRef> txs{CreateChainTopology(NUM_CHAINS, DEPTH)};
+    // The "block" confirms the first five transactions of every chain.
+    std::vector<CTransactionRef> block_txs;
+    for (size_t c = 0; c < NUM_CHAINS; ++c) {
+        for (size_t d = 0; d < 5; ++d) {
+            block_txs.push_back(txs[c * DEPTH + d]);
+        }
+    }
+    const auto testing_setup = MakeNoLogFileContext<const TestingSetup>(CBaseChainParams::MAIN);
+    CTxMemPool& pool = *testing_setup.get()->m_node.mempool;
+    LOCK2(cs_main, pool.cs);
+    bench.run([&]() NO_THREAD_SAFETY_ANALYSIS {
+        for (const auto& tx : txs) {
+            AddTx(tx, pool);
+        }
+        pool.removeForBlock(block_txs, /*nBlockHeight=*/1);
+        pool.clear();
+    });
+}
+
+//! RBF-style churn: evict a chain from the bottom (as a replacement of its
+//! base transaction would) and re-add it.
+static void MempoolRbfChurnDeepChains(benchmark::Bench& bench)
+{
+    constexpr size_t NUM_CHAINS{400};
+    constexpr size_t DEPTH{25};
+    constexpr size_t CHURNED{40};
+    const std::vector<CTransactionRef> txs{CreateChainTopology(NUM_CHAINS, DEPTH)};
+    const auto testing_setup = MakeNoLogFileContext<const TestingSetup>(CBaseChainParams::MAIN);
+    CTxMemPool& pool = *testing_setup.get()->m_node.mempool;
+    LOCK2(cs_main, pool.cs);
+    for (const auto& tx : txs) {
+        AddTx(tx, pool);
+    }
+    bench.unit("replacement").batch(CHURNED).run([&]() NO_THREAD_SAFETY_ANALYSIS {
+        for (size_t c = 0; c < CHURNED; ++c) {
+            pool.removeRecursive(*txs[c * DEPTH], MemPoolRemovalReason::REPLACED);
+            for (size_t d = 0; d < DEPTH; ++d) {
+                AddTx(txs[c * DEPTH + d], pool);
+            }
+        }
+    });
+}
+
 static void ComplexMemPool(benchmark::Bench& bench)
 {
     FastRandomContext det_rand{true};
@@ -115,4 +276,9 @@ static void MempoolCheck(benchmark::Bench& bench)
 }
 
 BENCHMARK(ComplexMemPool);
+BENCHMARK(MempoolAddDeepChains);
+BENCHMARK(MempoolAddWideFanIn);
+BENCHMARK(MempoolAncestryDeepChains);
+BENCHMARK(MempoolRemoveForBlockDeepChains);
+BENCHMARK(MempoolRbfChurnDeepChains);
 BENCHMARK(MempoolCheck);
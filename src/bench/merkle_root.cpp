@@ -24,3 +24,22 @@ static void MerkleRoot(benchmark::Bench& bench)
 }
 
 BENCHMARK(MerkleRoot);
+
+// Small leaf sets stay below the parallel subtree threshold, so this measures
+// the serial path that MerkleRoot above no longer exercises.
+static void MerkleRootSmall(benchmark::Bench& bench)
+{
+    FastRandomContext rng(true);
+    std::vector<uint256> leaves;
+    leaves.resize(1000);
+    for (auto& item : leaves) {
+        item = rng.rand256();
+    }
+    bench.batch(leaves.size()).unit("leaf").run([&] {
+        bool mutation = false;
+        uint256 hash = ComputeMerkleRoot(std::vector<uint256>(leaves), &mutation);
+        leaves[mutation] = hash;
+    });
+}
+
+BENCHMARK(MerkleRootSmall);
@@ -0,0 +1,216 @@
+// Copyright (c) 2024 The Coral Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <bench/bench.h>
+
+#include <arith_uint256.h>
+#include <chain.h>
+#include <chainparams.h>
+#include <chainparamsbase.h>
+#include <consensus/params.h>
+#include <pow.h>
+#include <uint256.h>
+#include <util/system.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <vector>
+
+// Simulation harness for difficulty retarget algorithms. With RandomX,
+// hashrate follows general-purpose CPU capacity and can swing by an order of
+// magnitude within hours; the inherited 2016-block retarget then leaves the
+// chain stuck at a stale difficulty for days, which shows up as multi-hour
+// block droughts. These benchmarks replay a synthetic timestamp history with
+// such swings through the production retarget and two responsive candidates,
+// print drought statistics for each, and time the replay itself so the cost
+// of a candidate algorithm on header validation is visible too.
+
+namespace {
+
+//! Number of simulated blocks per replay (four mainnet retarget periods).
+constexpr int SIM_BLOCKS{8064};
+
+//! Relative network hashrate at a given height. A step schedule modeling a
+//! large CPU farm pointing at the chain for a while and leaving again — the
+//! pattern behind the droughts we observe.
+double HashrateAt(int height)
+{
+    const int phase{height % 4032};
+    if (phase < 1344) return 1.0;
+    if (phase < 2688) return 8.0; // farm joins
+    return 0.5;                   // farm leaves; residual miners only
+}
+
+struct SimStats {
+    int64_t max_interval{0};
+    int64_t total_time{0};
+    int droughts{0};
+};
+
+//! Compute the next compact target for the block after `tip`, given the
+//! provisional timestamp of that block.
+using RetargetFn = std::function<uint32_t(const CBlockIndex* tip, int64_t next_time)>;
+
+//! Replay SIM_BLOCKS through a retarget algorithm. Each block's solve time is
+//! the expected value implied by its difficulty and the hashrate schedule: a
+//! unit of hashrate sustains minimum difficulty at the target spacing.
+SimStats Simulate(const Consensus::Params& params, const RetargetFn& retarget)
+{
+    const arith_uint256 pow_limit{UintToArith256(params.powLimit)};
+    const double limit_work{pow_limit.getdouble()};
+    const int64_t spacing{params.nPowTargetSpacing};
+
+    std::vector<CBlockIndex> chain(SIM_BLOCKS);
+    chain[0].nHeight = 0;
+    chain[0].nTime = 1600000000;
+    chain[0].nBits = pow_limit.GetCompact();
+
+    SimStats stats;
+    for (int height = 1; height < SIM_BLOCKS; ++height) {
+        CBlockIndex& prev = chain[height - 1];
+        const uint32_t next_bits{retarget(&prev, prev.GetBlockTime() + spacing)};
+
+        arith_uint256 target;
+        target.SetCompact(next_bits);
+        const double difficulty{limit_work / target.getdouble()};
+        const int64_t interval{std::max<int64_t>(1, std::llround(spacing * difficulty / HashrateAt(height)))};
+
+        chain[height].pprev = &prev;
+        chain[height].nHeight = height;
+        chain[height].nTime = prev.nTime + interval;
+        chain[height].nBits = next_bits;
+
+        stats.max_interval = std::max(stats.max_interval, interval);
+        if (interval > 6 * spacing) ++stats.droughts;
+    }
+    stats.total_time = chain.back().GetBlockTime() - chain.front().GetBlockTime();
+    return stats;
+}
+
+//! Linearly weighted moving average over a short window (zawy-style LWMA):
+//! recent solve times dominate, so difficulty tracks a hashrate step within
+//! roughly one window instead of one retarget period.
+uint32_t RetargetLwma(const CBlockIndex* tip, const Consensus::Params& params, const arith_uint256& pow_limit)
+{
+    constexpr int64_t N{90};
+    const int64_t spacing{params.nPowTargetSpacing};
+    if (tip->nHeight < N) return tip->nBits;
+
+    const CBlockIndex* window[N + 1];
+    const CBlockIndex* it{tip};
+    for (int64_t i = N; i >= 0; --i) {
+        window[i] = it;
+        it = it->pprev;
+    }
+
+    // next_target = avg(target) * weighted_avg(solvetime) / spacing, with the
+    // target sum pre-divided so the weighted multiply cannot overflow.
+    constexpr int64_t WEIGHT_SUM{N * (N + 1) / 2};
+    arith_uint256 sum_target;
+    int64_t t_weighted{0};
+    for (int64_t i = 1; i <= N; ++i) {
+        const int64_t solvetime{std::clamp<int64_t>(
+            window[i]->GetBlockTime() - window[i - 1]->GetBlockTime(), -6 * spacing, 6 * spacing)};
+        t_weighted += solvetime * i;
+        arith_uint256 target;
+        target.SetCompact(window[i]->nBits);
+        sum_target += target / arith_uint256(N * WEIGHT_SUM * spacing);
+    }
+    t_weighted = std::max<int64_t>(t_weighted, WEIGHT_SUM * spacing / 10);
+
+    arith_uint256 next_target{sum_target * static_cast<uint32_t>(t_weighted)};
+    if (next_target > pow_limit || next_target == 0) next_target = pow_limit;
+    return next_target.GetCompact();
+}
+
+//! Per-block exponential moving average (first-order ASERT approximation):
+//! the target relaxes towards equilibrium by 1/TAU_BLOCKS of the observed
+//! deviation per block.
+uint32_t RetargetEma(const CBlockIndex* tip, const Consensus::Params& params, const arith_uint256& pow_limit)
+{
+    constexpr int64_t TAU_BLOCKS{64};
+    const int64_t spacing{params.nPowTargetSpacing};
+    if (!tip->pprev) return tip->nBits;
+
+    const int64_t solvetime{std::clamp<int64_t>(
+        tip->GetBlockTime() - tip->pprev->GetBlockTime(), spacing / 16, 16 * spacing)};
+
+    arith_uint256 target;
+    target.SetCompact(tip->nBits);
+    const arith_uint256 step{target / arith_uint256(spacing * TAU_BLOCKS)};
+    if (solvetime >= spacing) {
+        target += step * static_cast<uint32_t>(solvetime - spacing);
+    } else {
+        target -= step * static_cast<uint32_t>(spacing - solvetime);
+    }
+    if (target > pow_limit || target == 0) target = pow_limit;
+    return target.GetCompact();
+}
+
+void PrintSimSummary(const char* name, const Consensus::Params& params, const SimStats& stats)
+{
+    std::cout << strprintf("%s: %d blocks in %ds (mean interval %ds, target %ds), max interval %ds, %d intervals over %ds\n",
+                           name, SIM_BLOCKS - 1, stats.total_time, stats.total_time / (SIM_BLOCKS - 1),
+                           params.nPowTargetSpacing, stats.max_interval, stats.droughts,
+                           6 * params.nPowTargetSpacing);
+}
+
+void RunRetargetSim(benchmark::Bench& bench, const char* name, const RetargetFn& retarget)
+{
+    ArgsManager bench_args;
+    const auto chain_params = CreateChainParams(bench_args, CBaseChainParams::MAIN);
+    const Consensus::Params& params = chain_params->GetConsensus();
+
+    PrintSimSummary(name, params, Simulate(params, retarget));
+
+    bench.unit("replay").run([&] {
+        const SimStats stats{Simulate(params, retarget)};
+        assert(stats.total_time > 0);
+        ankerl::nanobench::doNotOptimizeAway(stats.max_interval);
+    });
+}
+
+void PowRetarget2016(benchmark::Bench& bench)
+{
+    ArgsManager bench_args;
+    const auto chain_params = CreateChainParams(bench_args, CBaseChainParams::MAIN);
+    const Consensus::Params& params = chain_params->GetConsensus();
+    RunRetargetSim(bench, "PowRetarget2016", [&params](const CBlockIndex* tip, int64_t next_time) {
+        CBlockHeader header;
+        header.nTime = static_cast<uint32_t>(next_time);
+        return GetNextWorkRequired(tip, &header, params);
+    });
+}
+
+void PowRetargetLwma(benchmark::Bench& bench)
+{
+    ArgsManager bench_args;
+    const auto chain_params = CreateChainParams(bench_args, CBaseChainParams::MAIN);
+    const Consensus::Params& params = chain_params->GetConsensus();
+    const arith_uint256 pow_limit{UintToArith256(params.powLimit)};
+    RunRetargetSim(bench, "PowRetargetLwma", [&params, &pow_limit](const CBlockIndex* tip, int64_t) {
+        return RetargetLwma(tip, params, pow_limit);
+    });
+}
+
+void PowRetargetEma(benchmark::Bench& bench)
+{
+    ArgsManager bench_args;
+    const auto chain_params = CreateChainParams(bench_args, CBaseChainParams::MAIN);
+    const Consensus::Params& params = chain_params->GetConsensus();
+    const arith_uint256 pow_limit{UintToArith256(params.powLimit)};
+    RunRetargetSim(bench, "PowRetargetEma", [&params, &pow_limit](const CBlockIndex* tip, int64_t) {
+        return RetargetEma(tip, params, pow_limit);
+    });
+}
+
+} // namespace
+
+BENCHMARK(PowRetarget2016);
+BENCHMARK(PowRetargetLwma);
+BENCHMARK(PowRetargetEma);
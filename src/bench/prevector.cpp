@@ -3,9 +3,11 @@
 // file COPYING or http://www.opensource.org/licenses/mit-license.php.
 
 #include <prevector.h>
+#include <script/script.h>
 #include <serialize.h>
 #include <streams.h>
 #include <type_traits>
+#include <vector>
 
 #include <bench/bench.h>
 
@@ -96,3 +98,38 @@ PREVECTOR_TEST(Clear)
 PREVECTOR_TEST(Destructor)
 PREVECTOR_TEST(Resize)
 PREVECTOR_TEST(Deserialize)
+
+// Exercise CScriptBase (and with it the CSCRIPT_PREVECTOR_SIZE build knob,
+// see script/script.h) against a histogram of common script sizes, weighted
+// roughly by how often they appear on mainnet. Sizes above the direct
+// capacity cost one heap allocation each, so this shows what a given
+// capacity buys: with the default of 28 the 34-byte witness programs spill,
+// with 36 they stay in-object.
+static void PrevectorScriptSizeMix(benchmark::Bench& bench)
+{
+    struct MixEntry {
+        size_t size;
+        int weight;
+    };
+    static constexpr MixEntry MIX[]{
+        {0, 35},   // empty scriptSig of a segwit input
+        {22, 20},  // P2WPKH output
+        {23, 5},   // P2SH output
+        {25, 10},  // P2PKH output
+        {34, 20},  // P2WSH / taproot output
+        {71, 3},   // DER signature push
+        {107, 7},  // P2PKH scriptSig
+    };
+    std::vector<size_t> sizes;
+    for (const auto& entry : MIX) {
+        sizes.insert(sizes.end(), entry.weight, entry.size);
+    }
+    bench.batch(sizes.size()).unit("script").run([&] {
+        for (const size_t size : sizes) {
+            CScriptBase script;
+            script.resize(size);
+            ankerl::nanobench::doNotOptimizeAway(script.size());
+        }
+    });
+}
+BENCHMARK(PrevectorScriptSizeMix);
@@ -15,4 +15,14 @@ static void HexStrBench(benchmark::Bench& bench)
     });
 }
 
+static void ParseHexBench(benchmark::Bench& bench)
+{
+    const std::string hex = HexStr(benchmark::data::block413567);
+    bench.batch(hex.size() / 2).unit("byte").run([&] {
+        auto bytes = ParseHex<uint8_t>(hex);
+        ankerl::nanobench::doNotOptimizeAway(bytes);
+    });
+}
+
 BENCHMARK(HexStrBench);
+BENCHMARK(ParseHexBench);
@@ -96,5 +96,25 @@ static void VerifyNestedIfScript(benchmark::Bench& bench)
     });
 }
 
+// Measures raw interpreter dispatch and stack manipulation without any
+// signature operations, for tracking EvalScript overhead in isolation.
+static void VerifyStackOpsScript(benchmark::Bench& bench)
+{
+    std::vector<std::vector<unsigned char>> stack;
+    CScript script;
+    for (int i = 0; i < 200; ++i) {
+        // Each round leaves the stack as it found it.
+        script << OP_1 << OP_DUP << OP_DUP << OP_ADD << OP_SWAP << OP_DROP << OP_DROP;
+    }
+    script << OP_1;
+    bench.run([&] {
+        auto stack_copy = stack;
+        ScriptError error;
+        bool ret = EvalScript(stack_copy, script, 0, BaseSignatureChecker(), SigVersion::BASE, &error);
+        assert(ret);
+    });
+}
+
 BENCHMARK(VerifyScriptBench);
 BENCHMARK(VerifyNestedIfScript);
+BENCHMARK(VerifyStackOpsScript);
@@ -14,6 +14,8 @@
 #include <validation.h>
 #include <util/system.h>
 
+#include <algorithm>
+#include <thread>
 #include <unordered_map>
 
 CBlockHeaderAndShortTxIDs::CBlockHeaderAndShortTxIDs(const CBlock& block) :
@@ -22,10 +24,12 @@ CBlockHeaderAndShortTxIDs::CBlockHeaderAndShortTxIDs(const CBlock& block) :
     FillShortTxIDSelector();
     //TODO: Use our mempool prior to block acceptance to predictively fill more than just the coinbase
     prefilledtxn[0] = {0, block.vtx[0]};
+    std::vector<uint256> wtxids;
+    wtxids.reserve(block.vtx.size() - 1);
     for (size_t i = 1; i < block.vtx.size(); i++) {
-        const CTransaction& tx = *block.vtx[i];
-        shorttxids[i - 1] = GetShortID(tx.GetWitnessHash());
+        wtxids.push_back(block.vtx[i]->GetWitnessHash());
     }
+    GetShortIDs(wtxids.data(), shorttxids.data(), wtxids.size());
 }
 
 void CBlockHeaderAndShortTxIDs::FillShortTxIDSelector() const {
@@ -44,6 +48,14 @@ uint64_t CBlockHeaderAndShortTxIDs::GetShortID(const uint256& txhash) const {
     return SipHashUint256(shorttxidk0, shorttxidk1, txhash) & 0xffffffffffffL;
 }
 
+void CBlockHeaderAndShortTxIDs::GetShortIDs(const uint256* txhashes, uint64_t* shortids, size_t count) const {
+    static_assert(SHORTTXIDS_LENGTH == 6, "shorttxids calculation assumes 6-byte shorttxids");
+    SipHashUint256Batch(shorttxidk0, shorttxidk1, txhashes, shortids, count);
+    for (size_t i = 0; i < count; i++) {
+        shortids[i] &= 0xffffffffffffL;
+    }
+}
+
 
 
 ReadStatus PartiallyDownloadedBlock::InitData(const CBlockHeaderAndShortTxIDs& cmpctblock, const std::vector<std::pair<uint256, CTransactionRef>>& extra_txn) {
@@ -105,29 +117,86 @@ ReadStatus PartiallyDownloadedBlock::InitData(const CBlockHeaderAndShortTxIDs& c
     std::vector<bool> have_txn(txn_available.size());
     {
     LOCK(pool->cs);
-    for (size_t i = 0; i < pool->vTxHashes.size(); i++) {
-        uint64_t shortid = cmpctblock.GetShortID(pool->vTxHashes[i].first);
-        std::unordered_map<uint64_t, uint16_t>::iterator idit = shorttxids.find(shortid);
-        if (idit != shorttxids.end()) {
-            if (!have_txn[idit->second]) {
-                txn_available[idit->second] = pool->vTxHashes[i].second->GetSharedTx();
-                have_txn[idit->second]  = true;
-                mempool_count++;
-            } else {
-                // If we find two mempool txn that match the short id, just request it.
-                // This should be rare enough that the extra bandwidth doesn't matter,
-                // but eating a round-trip due to FillBlock failure would be annoying
-                if (txn_available[idit->second]) {
-                    txn_available[idit->second].reset();
-                    mempool_count--;
+    const auto& tx_hashes{pool->vTxHashes};
+    const auto process_match = [&](size_t i, std::unordered_map<uint64_t, uint16_t>::iterator idit) EXCLUSIVE_LOCKS_REQUIRED(pool->cs) {
+        if (!have_txn[idit->second]) {
+            txn_available[idit->second] = tx_hashes[i].second->GetSharedTx();
+            have_txn[idit->second]  = true;
+            mempool_count++;
+        } else {
+            // If we find two mempool txn that match the short id, just request it.
+            // This should be rare enough that the extra bandwidth doesn't matter,
+            // but eating a round-trip due to FillBlock failure would be annoying
+            if (txn_available[idit->second]) {
+                txn_available[idit->second].reset();
+                mempool_count--;
+            }
+        }
+    };
+    // The short ID salt is derived from the block header and nonce, so this
+    // per-entry SipHash pass cannot be precomputed or cached across blocks.
+    // For large mempools it dominates reconstruction latency, so split it
+    // across a few threads and apply the matches serially in mempool order
+    // afterwards, which keeps collision handling identical to a single
+    // sequential scan.
+    constexpr size_t MIN_ENTRIES_PER_HASH_THREAD{10000};
+    //! Number of tx hashes short-ID'd per SipHashUint256Batch() call.
+    constexpr size_t SHORTID_BATCH{32};
+    const size_t n_threads{std::clamp<size_t>(tx_hashes.size() / MIN_ENTRIES_PER_HASH_THREAD, 1, 4)};
+    if (n_threads > 1) {
+        std::vector<std::vector<std::pair<size_t, uint64_t>>> chunk_matches(n_threads);
+        std::vector<std::thread> threads;
+        threads.reserve(n_threads);
+        for (size_t t = 0; t < n_threads; t++) {
+            threads.emplace_back([&, t] {
+                const size_t begin{tx_hashes.size() * t / n_threads};
+                const size_t end{tx_hashes.size() * (t + 1) / n_threads};
+                uint256 hashes[SHORTID_BATCH];
+                uint64_t ids[SHORTID_BATCH];
+                for (size_t i = begin; i < end; i += SHORTID_BATCH) {
+                    const size_t n{std::min(SHORTID_BATCH, end - i)};
+                    for (size_t j = 0; j < n; j++) hashes[j] = tx_hashes[i + j].first;
+                    cmpctblock.GetShortIDs(hashes, ids, n);
+                    for (size_t j = 0; j < n; j++) {
+                        if (shorttxids.count(ids[j])) chunk_matches[t].emplace_back(i + j, ids[j]);
+                    }
+                }
+            });
+        }
+        for (auto& thread : threads) thread.join();
+        bool done{false};
+        for (const auto& chunk : chunk_matches) {
+            if (done) break;
+            for (const auto& [i, shortid] : chunk) {
+                process_match(i, shorttxids.find(shortid));
+                // Though ideally we'd continue scanning for the two-txn-match-shortid case,
+                // the performance win of an early exit here is too good to pass up and worth
+                // the extra risk.
+                if (mempool_count == shorttxids.size()) {
+                    done = true;
+                    break;
                 }
             }
         }
-        // Though ideally we'd continue scanning for the two-txn-match-shortid case,
-        // the performance win of an early exit here is too good to pass up and worth
-        // the extra risk.
-        if (mempool_count == shorttxids.size())
-            break;
+    } else {
+        uint256 hashes[SHORTID_BATCH];
+        uint64_t ids[SHORTID_BATCH];
+        for (size_t i = 0; i < tx_hashes.size() && mempool_count != shorttxids.size(); i += SHORTID_BATCH) {
+            const size_t n{std::min(SHORTID_BATCH, tx_hashes.size() - i)};
+            for (size_t j = 0; j < n; j++) hashes[j] = tx_hashes[i + j].first;
+            cmpctblock.GetShortIDs(hashes, ids, n);
+            for (size_t j = 0; j < n; j++) {
+                std::unordered_map<uint64_t, uint16_t>::iterator idit = shorttxids.find(ids[j]);
+                if (idit != shorttxids.end()) {
+                    process_match(i + j, idit);
+                }
+                // Though ideally we'd continue scanning for the two-txn-match-shortid case,
+                // the performance win of an early exit here is too good to pass up and worth
+                // the extra risk.
+                if (mempool_count == shorttxids.size())
+                    break;
+            }
+        }
     }
     }
 
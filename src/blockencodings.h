@@ -107,6 +107,9 @@ public:
     CBlockHeaderAndShortTxIDs(const CBlock& block);
 
     uint64_t GetShortID(const uint256& txhash) const;
+    /** Batched equivalent of GetShortID() for count tx hashes, using the SIMD
+     *  SipHash implementation when available. */
+    void GetShortIDs(const uint256* txhashes, uint64_t* shortids, size_t count) const;
 
     size_t BlockTxCount() const { return shorttxids.size() + prefilledtxn.size(); }
 
@@ -26,9 +26,7 @@ static const std::map<BlockFilterType, std::string> g_filter_types = {
 
 uint64_t GCSFilter::HashToRange(const Element& element) const
 {
-    uint64_t hash = CSipHasher(m_params.m_siphash_k0, m_params.m_siphash_k1)
-        .Write(element.data(), element.size())
-        .Finalize();
+    uint64_t hash = SipHash(m_params.m_siphash_k0, m_params.m_siphash_k1, element);
     return FastRange64(hash, m_F);
 }
 
@@ -130,6 +130,15 @@ void CBlockIndex::BuildSkip()
 
 arith_uint256 GetBlockProof(const CBlockIndex& block)
 {
+    // nBits only changes at difficulty adjustments, so during headers sync the
+    // same compact target is expanded and divided for thousands of consecutive
+    // blocks. Memoize the last result per thread; the 256-bit division below
+    // dominates the cost of adding a header to the block index.
+    static thread_local uint32_t cached_nbits{0};
+    static thread_local arith_uint256 cached_proof;
+    if (block.nBits == cached_nbits && cached_nbits != 0) {
+        return cached_proof;
+    }
     arith_uint256 bnTarget;
     bool fNegative;
     bool fOverflow;
@@ -140,7 +149,9 @@ arith_uint256 GetBlockProof(const CBlockIndex& block)
     // as it's too large for an arith_uint256. However, as 2**256 is at least as large
     // as bnTarget+1, it is equal to ((2**256 - bnTarget - 1) / (bnTarget+1)) + 1,
     // or ~bnTarget / (bnTarget+1) + 1.
-    return (~bnTarget / (bnTarget + 1)) + 1;
+    cached_proof = (~bnTarget / (bnTarget + 1)) + 1;
+    cached_nbits = block.nBits;
+    return cached_proof;
 }
 
 int64_t GetBlockProofEquivalentTime(const CBlockIndex& to, const CBlockIndex& from, const CBlockIndex& tip, const Consensus::Params& params)
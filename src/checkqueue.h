@@ -9,8 +9,10 @@
 #include <tinyformat.h>
 #include <util/syscall_sandbox.h>
 #include <util/threadnames.h>
+#include <util/trace.h>
 
 #include <algorithm>
+#include <deque>
 #include <vector>
 
 template <typename T>
@@ -43,6 +45,22 @@ private:
     //! As the order of booleans doesn't matter, it is used as a LIFO (stack)
     std::vector<T> queue GUARDED_BY(m_mutex);
 
+    /**
+     * Per-worker deque of checks. The owning worker refills and pops at the
+     * back; idle workers steal from the front, so with skewed per-check
+     * costs a slow worker's backlog is redistributed instead of leaving the
+     * other threads idle at the batch boundary.
+     */
+    struct WorkerQueue {
+        Mutex mutex;
+        std::deque<T> checks GUARDED_BY(mutex);
+    };
+
+    //! Registered per-worker queues, for work stealing. Workers register on
+    //! entry to Loop() and deregister on exit, so the pointers are valid
+    //! whenever m_mutex is held.
+    std::vector<WorkerQueue*> m_local GUARDED_BY(m_mutex);
+
     //! The number of workers (including the master) that are idle.
     int nIdle GUARDED_BY(m_mutex){0};
 
@@ -65,12 +83,45 @@ private:
     std::vector<std::thread> m_worker_threads;
     bool m_request_stop GUARDED_BY(m_mutex){false};
 
+    /**
+     * Move up to half of another worker's pending checks into `into`.
+     * Returns whether anything was stolen. Holding m_mutex guarantees the
+     * victim queue stays registered (and that only one steal runs at a
+     * time), so the two per-worker mutexes never need to be held together.
+     */
+    bool StealInto(WorkerQueue& into) EXCLUSIVE_LOCKS_REQUIRED(m_mutex)
+    {
+        for (WorkerQueue* victim : m_local) {
+            if (victim == &into) continue;
+            std::deque<T> stolen;
+            {
+                LOCK(victim->mutex);
+                // Always leave the victim at least one check, so it makes
+                // progress without going back through the scheduler.
+                if (victim->checks.size() <= 1) continue;
+                const size_t steal_count{victim->checks.size() / 2};
+                for (size_t i = 0; i < steal_count; ++i) {
+                    stolen.emplace_back();
+                    stolen.back().swap(victim->checks.front());
+                    victim->checks.pop_front();
+                }
+            }
+            LOCK(into.mutex);
+            for (T& check : stolen) {
+                into.checks.emplace_back();
+                into.checks.back().swap(check);
+            }
+            return true;
+        }
+        return false;
+    }
+
     /** Internal function that does bulk of the verification work. */
     bool Loop(bool fMaster) EXCLUSIVE_LOCKS_REQUIRED(!m_mutex)
     {
         std::condition_variable& cond = fMaster ? m_master_cv : m_worker_cv;
-        std::vector<T> vChecks;
-        vChecks.reserve(nBatchSize);
+        WorkerQueue local;
+        WITH_LOCK(m_mutex, m_local.push_back(&local));
         unsigned int nNow = 0;
         bool fOk = true;
         do {
@@ -88,9 +139,10 @@ private:
                     nTotal++;
                 }
                 // logically, the do loop starts here
-                while (queue.empty() && !m_request_stop) {
+                while (queue.empty() && !StealInto(local) && !m_request_stop) {
                     if (fMaster && nTodo == 0) {
                         nTotal--;
+                        m_local.erase(std::find(m_local.begin(), m_local.end(), &local));
                         bool fRet = fAllOk;
                         // reset the status for new work later
                         fAllOk = true;
@@ -102,30 +154,53 @@ private:
                     nIdle--;
                 }
                 if (m_request_stop) {
+                    m_local.erase(std::find(m_local.begin(), m_local.end(), &local));
                     return false;
                 }
 
-                // Decide how many work units to process now.
+                // Decide how many work units to claim from the shared queue.
                 // * Do not try to do everything at once, but aim for increasingly smaller batches so
                 //   all workers finish approximately simultaneously.
                 // * Try to account for idle jobs which will instantly start helping.
                 // * Don't do batches smaller than 1 (duh), or larger than nBatchSize.
                 nNow = std::max(1U, std::min(nBatchSize, (unsigned int)queue.size() / (nTotal + nIdle + 1)));
-                vChecks.resize(nNow);
-                for (unsigned int i = 0; i < nNow; i++) {
-                    // We want the lock on the m_mutex to be as short as possible, so swap jobs from the global
-                    // queue to the local batch vector instead of copying.
-                    vChecks[i].swap(queue.back());
-                    queue.pop_back();
+                if (!queue.empty()) {
+                    unsigned int claimed{0};
+                    {
+                        LOCK(local.mutex);
+                        for (; claimed < nNow && !queue.empty(); ++claimed) {
+                            // We want the lock on the m_mutex to be as short as possible, so swap jobs from the global
+                            // queue to the local deque instead of copying.
+                            local.checks.emplace_back();
+                            local.checks.back().swap(queue.back());
+                            queue.pop_back();
+                        }
+                    }
+                    TRACE3(checkqueue, batch_dispatch,
+                           (uint64_t)claimed,
+                           (uint64_t)queue.size(),
+                           (int32_t)nIdle);
                 }
                 // Check whether we need to do work at all
                 fOk = fAllOk;
             }
-            // execute work
-            for (T& check : vChecks)
+            // Execute work from the local deque, popping one check at a time
+            // so the remainder stays stealable while we run. nNow counts the
+            // checks actually executed here (including stolen ones), which is
+            // what the nTodo accounting above needs.
+            nNow = 0;
+            while (true) {
+                T check;
+                {
+                    LOCK(local.mutex);
+                    if (local.checks.empty()) break;
+                    check.swap(local.checks.back());
+                    local.checks.pop_back();
+                }
                 if (fOk)
                     fOk = check();
-            vChecks.clear();
+                nNow++;
+            }
         } while (true);
     }
 
@@ -6,14 +6,23 @@
 
 #include <consensus/consensus.h>
 #include <logging.h>
+#include <perfstats.h>
 #include <random.h>
+#include <util/threadnames.h>
 #include <util/trace.h>
 #include <version.h>
 
 bool CCoinsView::GetCoin(const COutPoint &outpoint, Coin &coin) const { return false; }
 uint256 CCoinsView::GetBestBlock() const { return uint256(); }
 std::vector<uint256> CCoinsView::GetHeadBlocks() const { return std::vector<uint256>(); }
-bool CCoinsView::BatchWrite(CCoinsMap &mapCoins, const uint256 &hashBlock) { return false; }
+bool CCoinsView::BatchWrite(CCoinsMap &mapCoins, const uint256 &hashBlock, bool erase) { return false; }
+bool CCoinsView::BatchWriteShards(std::vector<CCoinsMap*>& shards, const uint256 &hashBlock, bool erase)
+{
+    for (CCoinsMap* shard : shards) {
+        if (!BatchWrite(*shard, hashBlock, erase)) return false;
+    }
+    return true;
+}
 std::unique_ptr<CCoinsViewCursor> CCoinsView::Cursor() const { return nullptr; }
 
 bool CCoinsView::HaveCoin(const COutPoint &outpoint) const
@@ -28,24 +37,101 @@ bool CCoinsViewBacked::HaveCoin(const COutPoint &outpoint) const { return base->
 uint256 CCoinsViewBacked::GetBestBlock() const { return base->GetBestBlock(); }
 std::vector<uint256> CCoinsViewBacked::GetHeadBlocks() const { return base->GetHeadBlocks(); }
 void CCoinsViewBacked::SetBackend(CCoinsView &viewIn) { base = &viewIn; }
-bool CCoinsViewBacked::BatchWrite(CCoinsMap &mapCoins, const uint256 &hashBlock) { return base->BatchWrite(mapCoins, hashBlock); }
+bool CCoinsViewBacked::BatchWrite(CCoinsMap &mapCoins, const uint256 &hashBlock, bool erase) { return base->BatchWrite(mapCoins, hashBlock, erase); }
+bool CCoinsViewBacked::BatchWriteShards(std::vector<CCoinsMap*>& shards, const uint256 &hashBlock, bool erase) { return base->BatchWriteShards(shards, hashBlock, erase); }
 std::unique_ptr<CCoinsViewCursor> CCoinsViewBacked::Cursor() const { return base->Cursor(); }
 size_t CCoinsViewBacked::EstimateSize() const { return base->EstimateSize(); }
 
+CPrefetchingCoinsViewCursor::CPrefetchingCoinsViewCursor(std::unique_ptr<CCoinsViewCursor> cursor, size_t read_ahead)
+    : CCoinsViewCursor(cursor->GetBestBlock()), m_cursor(std::move(cursor)), m_read_ahead(read_ahead)
+{
+    m_thread = std::thread(&CPrefetchingCoinsViewCursor::ThreadPrefetch, this);
+    Advance();
+}
+
+CPrefetchingCoinsViewCursor::~CPrefetchingCoinsViewCursor()
+{
+    WITH_LOCK(m_mutex, m_stop = true);
+    m_cv.notify_all();
+    m_thread.join();
+}
+
+void CPrefetchingCoinsViewCursor::ThreadPrefetch()
+{
+    util::ThreadRename("coinsprefetch");
+    while (m_cursor->Valid()) {
+        Entry entry;
+        if (!m_cursor->GetKey(entry.key) || !m_cursor->GetValue(entry.coin)) break;
+        m_cursor->Next();
+        WAIT_LOCK(m_mutex, lock);
+        m_cv.wait(lock, [&]() EXCLUSIVE_LOCKS_REQUIRED(m_mutex) { return m_stop || m_buffer.size() < m_read_ahead; });
+        if (m_stop) return;
+        m_buffer.push_back(std::move(entry));
+        m_cv.notify_all();
+    }
+    WITH_LOCK(m_mutex, m_source_exhausted = true);
+    m_cv.notify_all();
+}
+
+void CPrefetchingCoinsViewCursor::Advance()
+{
+    WAIT_LOCK(m_mutex, lock);
+    m_cv.wait(lock, [&]() EXCLUSIVE_LOCKS_REQUIRED(m_mutex) { return !m_buffer.empty() || m_source_exhausted; });
+    if (m_buffer.empty()) {
+        m_current.reset();
+        return;
+    }
+    m_current = std::move(m_buffer.front());
+    m_buffer.pop_front();
+    m_cv.notify_all();
+}
+
+bool CPrefetchingCoinsViewCursor::GetKey(COutPoint& key) const
+{
+    if (!m_current) return false;
+    key = m_current->key;
+    return true;
+}
+
+bool CPrefetchingCoinsViewCursor::GetValue(Coin& coin) const
+{
+    if (!m_current) return false;
+    coin = m_current->coin;
+    return true;
+}
+
+bool CPrefetchingCoinsViewCursor::Valid() const
+{
+    return m_current.has_value();
+}
+
+void CPrefetchingCoinsViewCursor::Next()
+{
+    Advance();
+}
+
 CCoinsViewCache::CCoinsViewCache(CCoinsView *baseIn) : CCoinsViewBacked(baseIn), cachedCoinsUsage(0) {}
 
 size_t CCoinsViewCache::DynamicMemoryUsage() const {
-    return memusage::DynamicUsage(cacheCoins) + cachedCoinsUsage;
+    size_t usage = cachedCoinsUsage.load(std::memory_order_relaxed);
+    for (const CoinsShard& shard : m_shards) {
+        LOCK(shard.mutex);
+        usage += memusage::DynamicUsage(shard.map);
+    }
+    return usage;
 }
 
-CCoinsMap::iterator CCoinsViewCache::FetchCoin(const COutPoint &outpoint) const {
-    CCoinsMap::iterator it = cacheCoins.find(outpoint);
-    if (it != cacheCoins.end())
+CCoinsMap::iterator CCoinsViewCache::FetchCoin(const HashedOutpoint& key, CCoinsMap& map) const {
+    CCoinsMap::iterator it = map.find(key);
+    if (it != map.end()) {
+        perf::Bump(perf::GetCounters().coins_cache_hits);
         return it;
+    }
+    perf::Bump(perf::GetCounters().coins_cache_misses);
     Coin tmp;
-    if (!base->GetCoin(outpoint, tmp))
-        return cacheCoins.end();
-    CCoinsMap::iterator ret = cacheCoins.emplace(std::piecewise_construct, std::forward_as_tuple(outpoint), std::forward_as_tuple(std::move(tmp))).first;
+    if (!base->GetCoin(key.outpoint, tmp))
+        return map.end();
+    CCoinsMap::iterator ret = map.emplace(std::piecewise_construct, std::forward_as_tuple(key), std::forward_as_tuple(std::move(tmp))).first;
     if (ret->second.coin.IsSpent()) {
         // The parent only has an empty entry for this outpoint; we can consider our
         // version as fresh.
@@ -56,8 +142,11 @@ CCoinsMap::iterator CCoinsViewCache::FetchCoin(const COutPoint &outpoint) const
 }
 
 bool CCoinsViewCache::GetCoin(const COutPoint &outpoint, Coin &coin) const {
-    CCoinsMap::const_iterator it = FetchCoin(outpoint);
-    if (it != cacheCoins.end()) {
+    const HashedOutpoint key{HashedKey(outpoint)};
+    CoinsShard& shard = ShardFor(key);
+    LOCK(shard.mutex);
+    CCoinsMap::const_iterator it = FetchCoin(key, shard.map);
+    if (it != shard.map.end()) {
         coin = it->second.coin;
         return !coin.IsSpent();
     }
@@ -67,9 +156,12 @@ bool CCoinsViewCache::GetCoin(const COutPoint &outpoint, Coin &coin) const {
 void CCoinsViewCache::AddCoin(const COutPoint &outpoint, Coin&& coin, bool possible_overwrite) {
     assert(!coin.IsSpent());
     if (coin.out.scriptPubKey.IsUnspendable()) return;
+    const HashedOutpoint key{HashedKey(outpoint)};
+    CoinsShard& shard = ShardFor(key);
+    LOCK(shard.mutex);
     CCoinsMap::iterator it;
     bool inserted;
-    std::tie(it, inserted) = cacheCoins.emplace(std::piecewise_construct, std::forward_as_tuple(outpoint), std::tuple<>());
+    std::tie(it, inserted) = shard.map.emplace(std::piecewise_construct, std::forward_as_tuple(key), std::tuple<>());
     bool fresh = false;
     if (!inserted) {
         cachedCoinsUsage -= it->second.coin.DynamicMemoryUsage();
@@ -106,9 +198,10 @@ void CCoinsViewCache::AddCoin(const COutPoint &outpoint, Coin&& coin, bool possi
 
 void CCoinsViewCache::EmplaceCoinInternalDANGER(COutPoint&& outpoint, Coin&& coin) {
     cachedCoinsUsage += coin.DynamicMemoryUsage();
-    cacheCoins.emplace(
+    const HashedOutpoint key{HashedKey(outpoint)};
+    ShardFor(key).map.emplace(
         std::piecewise_construct,
-        std::forward_as_tuple(std::move(outpoint)),
+        std::forward_as_tuple(key),
         std::forward_as_tuple(std::move(coin), CCoinsCacheEntry::DIRTY));
 }
 
@@ -124,8 +217,11 @@ void AddCoins(CCoinsViewCache& cache, const CTransaction &tx, int nHeight, bool
 }
 
 bool CCoinsViewCache::SpendCoin(const COutPoint &outpoint, Coin* moveout) {
-    CCoinsMap::iterator it = FetchCoin(outpoint);
-    if (it == cacheCoins.end()) return false;
+    const HashedOutpoint key{HashedKey(outpoint)};
+    CoinsShard& shard = ShardFor(key);
+    LOCK(shard.mutex);
+    CCoinsMap::iterator it = FetchCoin(key, shard.map);
+    if (it == shard.map.end()) return false;
     cachedCoinsUsage -= it->second.coin.DynamicMemoryUsage();
     TRACE5(utxocache, spent,
            outpoint.hash.data(),
@@ -137,7 +233,7 @@ bool CCoinsViewCache::SpendCoin(const COutPoint &outpoint, Coin* moveout) {
         *moveout = std::move(it->second.coin);
     }
     if (it->second.flags & CCoinsCacheEntry::FRESH) {
-        cacheCoins.erase(it);
+        shard.map.erase(it);
     } else {
         it->second.flags |= CCoinsCacheEntry::DIRTY;
         it->second.coin.Clear();
@@ -148,22 +244,34 @@ bool CCoinsViewCache::SpendCoin(const COutPoint &outpoint, Coin* moveout) {
 static const Coin coinEmpty;
 
 const Coin& CCoinsViewCache::AccessCoin(const COutPoint &outpoint) const {
-    CCoinsMap::const_iterator it = FetchCoin(outpoint);
-    if (it == cacheCoins.end()) {
+    const HashedOutpoint key{HashedKey(outpoint)};
+    CoinsShard& shard = ShardFor(key);
+    LOCK(shard.mutex);
+    CCoinsMap::const_iterator it = FetchCoin(key, shard.map);
+    if (it == shard.map.end()) {
         return coinEmpty;
     } else {
+        // References into the shard map remain valid after the lock is
+        // released: concurrent readers only insert, and erasure is serialized
+        // with the callers holding references by the chainstate locking.
         return it->second.coin;
     }
 }
 
 bool CCoinsViewCache::HaveCoin(const COutPoint &outpoint) const {
-    CCoinsMap::const_iterator it = FetchCoin(outpoint);
-    return (it != cacheCoins.end() && !it->second.coin.IsSpent());
+    const HashedOutpoint key{HashedKey(outpoint)};
+    CoinsShard& shard = ShardFor(key);
+    LOCK(shard.mutex);
+    CCoinsMap::const_iterator it = FetchCoin(key, shard.map);
+    return (it != shard.map.end() && !it->second.coin.IsSpent());
 }
 
 bool CCoinsViewCache::HaveCoinInCache(const COutPoint &outpoint) const {
-    CCoinsMap::const_iterator it = cacheCoins.find(outpoint);
-    return (it != cacheCoins.end() && !it->second.coin.IsSpent());
+    const HashedOutpoint key{HashedKey(outpoint)};
+    CoinsShard& shard = ShardFor(key);
+    LOCK(shard.mutex);
+    CCoinsMap::const_iterator it = shard.map.find(key);
+    return (it != shard.map.end() && !it->second.coin.IsSpent());
 }
 
 uint256 CCoinsViewCache::GetBestBlock() const {
@@ -176,21 +284,34 @@ void CCoinsViewCache::SetBestBlock(const uint256 &hashBlockIn) {
     hashBlock = hashBlockIn;
 }
 
-bool CCoinsViewCache::BatchWrite(CCoinsMap &mapCoins, const uint256 &hashBlockIn) {
-    for (CCoinsMap::iterator it = mapCoins.begin(); it != mapCoins.end(); it = mapCoins.erase(it)) {
+void CCoinsViewCache::ApplyBatchEntries(CCoinsMap &mapCoins, bool erase) {
+    for (CCoinsMap::iterator it = mapCoins.begin();
+         it != mapCoins.end();
+         it = erase ? mapCoins.erase(it) : std::next(it)) {
         // Ignore non-dirty entries (optimization).
         if (!(it->second.flags & CCoinsCacheEntry::DIRTY)) {
             continue;
         }
-        CCoinsMap::iterator itUs = cacheCoins.find(it->first);
-        if (itUs == cacheCoins.end()) {
+        // The child's stored key hashes use its own salt, so each entry is
+        // re-keyed with our salt here, which also routes it to our shard.
+        const HashedOutpoint key{HashedKey(it->first.outpoint)};
+        CoinsShard& shard = ShardFor(key);
+        LOCK(shard.mutex);
+        CCoinsMap::iterator itUs = shard.map.find(key);
+        if (itUs == shard.map.end()) {
             // The parent cache does not have an entry, while the child cache does.
             // We can ignore it if it's both spent and FRESH in the child
             if (!(it->second.flags & CCoinsCacheEntry::FRESH && it->second.coin.IsSpent())) {
                 // Create the coin in the parent cache, move the data up
                 // and mark it as dirty.
-                CCoinsCacheEntry& entry = cacheCoins[it->first];
-                entry.coin = std::move(it->second.coin);
+                CCoinsCacheEntry& entry = shard.map[key];
+                if (erase) {
+                    // The child itself still needs the coin if it is not
+                    // erasing its entries, so only move when erasing.
+                    entry.coin = std::move(it->second.coin);
+                } else {
+                    entry.coin = it->second.coin;
+                }
                 cachedCoinsUsage += entry.coin.DynamicMemoryUsage();
                 entry.flags = CCoinsCacheEntry::DIRTY;
                 // We can mark it FRESH in the parent if it was FRESH in the child
@@ -214,11 +335,15 @@ bool CCoinsViewCache::BatchWrite(CCoinsMap &mapCoins, const uint256 &hashBlockIn
                 // The grandparent cache does not have an entry, and the coin
                 // has been spent. We can just delete it from the parent cache.
                 cachedCoinsUsage -= itUs->second.coin.DynamicMemoryUsage();
-                cacheCoins.erase(itUs);
+                shard.map.erase(itUs);
             } else {
                 // A normal modification.
                 cachedCoinsUsage -= itUs->second.coin.DynamicMemoryUsage();
-                itUs->second.coin = std::move(it->second.coin);
+                if (erase) {
+                    itUs->second.coin = std::move(it->second.coin);
+                } else {
+                    itUs->second.coin = it->second.coin;
+                }
                 cachedCoinsUsage += itUs->second.coin.DynamicMemoryUsage();
                 itUs->second.flags |= CCoinsCacheEntry::DIRTY;
                 // NOTE: It isn't safe to mark the coin as FRESH in the parent
@@ -228,21 +353,127 @@ bool CCoinsViewCache::BatchWrite(CCoinsMap &mapCoins, const uint256 &hashBlockIn
             }
         }
     }
+}
+
+bool CCoinsViewCache::BatchWrite(CCoinsMap &mapCoins, const uint256 &hashBlockIn, bool erase) {
+    ApplyBatchEntries(mapCoins, erase);
     hashBlock = hashBlockIn;
     return true;
 }
 
+bool CCoinsViewCache::BatchWriteShards(std::vector<CCoinsMap*>& shards, const uint256 &hashBlockIn, bool erase) {
+    for (CCoinsMap* shard : shards) {
+        ApplyBatchEntries(*shard, erase);
+    }
+    hashBlock = hashBlockIn;
+    return true;
+}
+
+void CCoinsViewCache::ReserveAdditional(size_t count)
+{
+    // Spread the hint evenly; the shard hasher keeps the real distribution
+    // close to uniform.
+    const size_t per_shard{count / NUM_COINS_SHARDS + 1};
+    for (CoinsShard& shard : m_shards) {
+        LOCK(shard.mutex);
+        shard.map.reserve(shard.map.size() + per_shard);
+    }
+}
+
 bool CCoinsViewCache::Flush() {
-    bool fOk = base->BatchWrite(cacheCoins, hashBlock);
-    cacheCoins.clear();
+    // Hold every shard lock across the write so the flushed state is a
+    // consistent cut of the cache.
+    std::vector<std::unique_lock<Mutex>> locks;
+    locks.reserve(NUM_COINS_SHARDS);
+    std::vector<CCoinsMap*> shards;
+    shards.reserve(NUM_COINS_SHARDS);
+    for (CoinsShard& shard : m_shards) {
+        locks.emplace_back(shard.mutex);
+        shards.push_back(&shard.map);
+    }
+    bool fOk = base->BatchWriteShards(shards, hashBlock, /*erase=*/true);
+    for (CoinsShard& shard : m_shards) {
+        shard.map.clear();
+    }
     cachedCoinsUsage = 0;
     return fOk;
 }
 
+bool CCoinsViewCache::Sync(int young_coin_height)
+{
+    std::vector<std::unique_lock<Mutex>> locks;
+    locks.reserve(NUM_COINS_SHARDS);
+    std::vector<CCoinsMap*> shards;
+    shards.reserve(NUM_COINS_SHARDS);
+    for (CoinsShard& shard : m_shards) {
+        locks.emplace_back(shard.mutex);
+        shards.push_back(&shard.map);
+    }
+    // Hide young fresh coins from the batch write by clearing their flags
+    // for its duration. Only coins the parent has never seen qualify: a
+    // non-FRESH dirty entry records a change to parent state and must be
+    // pushed down regardless of age.
+    std::vector<std::pair<CCoinsMap::iterator, unsigned char>> withheld;
+    if (young_coin_height >= 0) {
+        for (CoinsShard& shard : m_shards) {
+            for (auto it = shard.map.begin(); it != shard.map.end(); ++it) {
+                CCoinsCacheEntry& entry = it->second;
+                if ((entry.flags & (CCoinsCacheEntry::DIRTY | CCoinsCacheEntry::FRESH)) == (CCoinsCacheEntry::DIRTY | CCoinsCacheEntry::FRESH) &&
+                    !entry.coin.IsSpent() && (int)entry.coin.nHeight >= young_coin_height) {
+                    withheld.emplace_back(it, entry.flags);
+                    entry.flags = 0;
+                }
+            }
+        }
+    }
+    bool fOk = base->BatchWriteShards(shards, hashBlock, /*erase=*/false);
+    if (fOk) {
+        // Instead of clearing the shard maps as Flush() does, just clear the
+        // FRESH/DIRTY flags so the (still warm) entries are plain copies of
+        // the parent's state. Spent entries no longer need to be remembered
+        // once their spentness has reached the parent, so drop them.
+        for (CoinsShard& shard : m_shards) {
+            for (auto it = shard.map.begin(); it != shard.map.end();) {
+                if (it->second.coin.IsSpent()) {
+                    cachedCoinsUsage -= it->second.coin.DynamicMemoryUsage();
+                    it = shard.map.erase(it);
+                } else {
+                    it->second.flags = 0;
+                    ++it;
+                }
+            }
+        }
+    }
+    // Restore the withheld entries' flags (the erasures above only remove
+    // spent entries, which never overlap the withheld set) so they remain
+    // part of the dirty delta for journal writes and the next flush. On a
+    // failed write the cache state is undefined anyway.
+    for (const auto& [it, flags] : withheld) {
+        it->second.flags = flags;
+    }
+    if (!withheld.empty()) {
+        LogPrint(BCLog::COINDB, "Withheld %u young coins from chainstate write\n", withheld.size());
+    }
+    return fOk;
+}
+
+void CCoinsViewCache::ForEachDirtyEntry(const std::function<void(const COutPoint&, const CCoinsCacheEntry&)>& func) const
+{
+    for (const CoinsShard& shard : m_shards) {
+        LOCK(shard.mutex);
+        for (const auto& [key, entry] : shard.map) {
+            if (entry.flags & CCoinsCacheEntry::DIRTY) func(key.outpoint, entry);
+        }
+    }
+}
+
 void CCoinsViewCache::Uncache(const COutPoint& hash)
 {
-    CCoinsMap::iterator it = cacheCoins.find(hash);
-    if (it != cacheCoins.end() && it->second.flags == 0) {
+    const HashedOutpoint key{HashedKey(hash)};
+    CoinsShard& shard = ShardFor(key);
+    LOCK(shard.mutex);
+    CCoinsMap::iterator it = shard.map.find(key);
+    if (it != shard.map.end() && it->second.flags == 0) {
         cachedCoinsUsage -= it->second.coin.DynamicMemoryUsage();
         TRACE5(utxocache, uncache,
                hash.hash.data(),
@@ -250,12 +481,17 @@ void CCoinsViewCache::Uncache(const COutPoint& hash)
                (uint32_t)it->second.coin.nHeight,
                (int64_t)it->second.coin.out.nValue,
                (bool)it->second.coin.IsCoinBase());
-        cacheCoins.erase(it);
+        shard.map.erase(it);
     }
 }
 
 unsigned int CCoinsViewCache::GetCacheSize() const {
-    return cacheCoins.size();
+    size_t count = 0;
+    for (const CoinsShard& shard : m_shards) {
+        LOCK(shard.mutex);
+        count += shard.map.size();
+    }
+    return count;
 }
 
 bool CCoinsViewCache::HaveInputs(const CTransaction& tx) const
@@ -272,10 +508,13 @@ bool CCoinsViewCache::HaveInputs(const CTransaction& tx) const
 
 void CCoinsViewCache::ReallocateCache()
 {
-    // Cache should be empty when we're calling this.
-    assert(cacheCoins.size() == 0);
-    cacheCoins.~CCoinsMap();
-    ::new (&cacheCoins) CCoinsMap();
+    for (CoinsShard& shard : m_shards) {
+        LOCK(shard.mutex);
+        // Cache should be empty when we're calling this.
+        assert(shard.map.size() == 0);
+        shard.map.~CCoinsMap();
+        ::new (&shard.map) CCoinsMap(CCoinsMap::allocator_type{&shard.resource});
+    }
 }
 
 static const size_t MIN_TRANSACTION_OUTPUT_WEIGHT = WITNESS_SCALE_FACTOR * ::GetSerializeSize(CTxOut(), PROTOCOL_VERSION);
@@ -11,13 +11,22 @@
 #include <memusage.h>
 #include <primitives/transaction.h>
 #include <serialize.h>
+#include <support/allocators/pool.h>
+#include <sync.h>
 #include <uint256.h>
 #include <util/hasher.h>
 
 #include <assert.h>
 #include <stdint.h>
 
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
 #include <functional>
+#include <memory>
+#include <optional>
+#include <thread>
 #include <unordered_map>
 
 /**
@@ -131,7 +140,48 @@ struct CCoinsCacheEntry
     CCoinsCacheEntry(Coin&& coin_, unsigned char flag) : coin(std::move(coin_)), flags(flag) {}
 };
 
-typedef std::unordered_map<COutPoint, CCoinsCacheEntry, SaltedOutpointHasher> CCoinsMap;
+/**
+ * A COutPoint bundled with its salted SipHash, computed once on construction.
+ *
+ * The coins cache maps key on this type so that unordered_map rehashes read
+ * the stored hash instead of re-running SipHash over every key: growing a
+ * multi-GiB cache rehashes hundreds of millions of entries, and recomputing
+ * SaltedOutpointHasher for each of them showed up as multi-second stalls.
+ * Every key in a given map must be salted by the same hasher; entries crossing
+ * cache levels are re-keyed with the destination's salt (see
+ * CCoinsViewCache::ApplyBatchEntries).
+ */
+struct HashedOutpoint
+{
+    COutPoint outpoint;
+    size_t hash;
+
+    HashedOutpoint(const COutPoint& outpoint_in, const SaltedOutpointHasher& hasher)
+        : outpoint(outpoint_in), hash(hasher(outpoint_in)) {}
+
+    bool operator==(const HashedOutpoint& other) const { return outpoint == other.outpoint; }
+    bool operator<(const HashedOutpoint& other) const { return outpoint < other.outpoint; }
+};
+
+/** Hasher returning the hash a HashedOutpoint already carries. */
+struct StoredOutpointHasher
+{
+    size_t operator()(const HashedOutpoint& key) const { return key.hash; }
+};
+
+//! The cache's map draws its nodes from a pool resource, like the block
+//! index: entries sit densely packed instead of scattered by the general
+//! heap, and the resource knows exactly how many bytes it holds, so the
+//! -dbcache accounting no longer relies on per-malloc overhead guesses.
+using CCoinsMap = std::unordered_map<HashedOutpoint,
+                                     CCoinsCacheEntry,
+                                     StoredOutpointHasher,
+                                     std::equal_to<HashedOutpoint>,
+                                     PoolAllocator<std::pair<const HashedOutpoint, CCoinsCacheEntry>,
+                                                   sizeof(std::pair<const HashedOutpoint, CCoinsCacheEntry>) + sizeof(void*) * 4,
+                                                   alignof(std::pair<const HashedOutpoint, CCoinsCacheEntry>)>>;
+
+using CCoinsMapMemoryResource = CCoinsMap::allocator_type::ResourceType;
 
 /** Cursor for iterating over CoinsView state */
 class CCoinsViewCursor
@@ -152,6 +202,55 @@ private:
     uint256 hashBlock;
 };
 
+//! Number of entries a CPrefetchingCoinsViewCursor reads ahead of the consumer.
+static const size_t DEFAULT_CURSOR_READ_AHEAD{4096};
+
+/**
+ * Cursor wrapper that decodes entries from the wrapped cursor on a background
+ * thread, keeping up to `read_ahead` of them buffered. Full-set scans such as
+ * ComputeUTXOStats and dumptxoutset otherwise stall on every LevelDB block
+ * read and value deserialization; with the wrapper those overlap with the
+ * consumer's own work. Only useful for scans that visit (nearly) every entry
+ * and always want the value, since GetValue() is paid for eagerly.
+ */
+class CPrefetchingCoinsViewCursor : public CCoinsViewCursor
+{
+public:
+    explicit CPrefetchingCoinsViewCursor(std::unique_ptr<CCoinsViewCursor> cursor, size_t read_ahead = DEFAULT_CURSOR_READ_AHEAD);
+    ~CPrefetchingCoinsViewCursor() override;
+
+    bool GetKey(COutPoint& key) const override;
+    bool GetValue(Coin& coin) const override;
+
+    bool Valid() const override;
+    void Next() override;
+
+private:
+    struct Entry {
+        COutPoint key;
+        Coin coin;
+    };
+
+    //! Read entries from m_cursor into m_buffer until it is exhausted.
+    void ThreadPrefetch() EXCLUSIVE_LOCKS_REQUIRED(!m_mutex);
+    //! Pop the next buffered entry into m_current, blocking while the buffer
+    //! is empty but the source is not yet exhausted.
+    void Advance() EXCLUSIVE_LOCKS_REQUIRED(!m_mutex);
+
+    std::unique_ptr<CCoinsViewCursor> m_cursor;
+    const size_t m_read_ahead;
+
+    Mutex m_mutex;
+    std::condition_variable m_cv;
+    std::deque<Entry> m_buffer GUARDED_BY(m_mutex);
+    bool m_source_exhausted GUARDED_BY(m_mutex){false};
+    bool m_stop GUARDED_BY(m_mutex){false};
+
+    //! Entry exposed by GetKey/GetValue; only touched by the consumer thread.
+    std::optional<Entry> m_current;
+    std::thread m_thread;
+};
+
 /** Abstract view on the open txout dataset. */
 class CCoinsView
 {
@@ -175,8 +274,17 @@ public:
     virtual std::vector<uint256> GetHeadBlocks() const;
 
     //! Do a bulk modification (multiple Coin changes + BestBlock change).
-    //! The passed mapCoins can be modified.
-    virtual bool BatchWrite(CCoinsMap &mapCoins, const uint256 &hashBlock);
+    //! The passed mapCoins can be modified. If erase is false the entries are
+    //! left in place (the caller keeps its cache warm) and their coins are
+    //! copied rather than moved.
+    virtual bool BatchWrite(CCoinsMap &mapCoins, const uint256 &hashBlock, bool erase = true);
+
+    //! Do a bulk modification spanning several coin maps (the shards of a
+    //! CCoinsViewCache), applying the best block change exactly once for the
+    //! whole set. The passed maps can be modified. Database-backed views
+    //! override this so the multi-map write stays crash-consistent; the
+    //! default implementation forwards each map to BatchWrite.
+    virtual bool BatchWriteShards(std::vector<CCoinsMap*>& shards, const uint256 &hashBlock, bool erase = true);
 
     //! Get a cursor to iterate over the whole state
     virtual std::unique_ptr<CCoinsViewCursor> Cursor() const;
@@ -202,7 +310,8 @@ public:
     uint256 GetBestBlock() const override;
     std::vector<uint256> GetHeadBlocks() const override;
     void SetBackend(CCoinsView &viewIn);
-    bool BatchWrite(CCoinsMap &mapCoins, const uint256 &hashBlock) override;
+    bool BatchWrite(CCoinsMap &mapCoins, const uint256 &hashBlock, bool erase = true) override;
+    bool BatchWriteShards(std::vector<CCoinsMap*>& shards, const uint256 &hashBlock, bool erase = true) override;
     std::unique_ptr<CCoinsViewCursor> Cursor() const override;
     size_t EstimateSize() const override;
 };
@@ -217,10 +326,44 @@ protected:
      * declared as "const".
      */
     mutable uint256 hashBlock;
-    mutable CCoinsMap cacheCoins;
+
+    //! Number of independently lockable sub-maps the cache is divided into.
+    //! Must be a power of two. Sharding lets concurrent readers (script-check
+    //! workers fetching inputs, mempool acceptance) probe different outpoints
+    //! without contending on one structure, and bounds rehash stalls since
+    //! each shard rehashes separately.
+    static constexpr size_t NUM_COINS_SHARDS{16};
+
+    //! One sub-map plus the mutex guarding its structure. The mutex makes
+    //! concurrent cache-filling lookups safe against each other; writers are
+    //! additionally serialized by the usual chainstate locking.
+    struct CoinsShard {
+        mutable Mutex mutex;
+        //! Node storage for this shard's map; per shard so concurrent
+        //! cache fills on different shards never share a resource.
+        mutable CCoinsMapMemoryResource resource;
+        mutable CCoinsMap map{CCoinsMap::allocator_type{&resource}};
+    };
+    mutable std::array<CoinsShard, NUM_COINS_SHARDS> m_shards;
 
     /* Cached dynamic memory usage for the inner Coin objects. */
-    mutable size_t cachedCoinsUsage;
+    mutable std::atomic<size_t> cachedCoinsUsage;
+
+    //! Salts the stored hash of every key in this cache's shard maps.
+    const SaltedOutpointHasher m_shard_hasher;
+    //! Compute an outpoint's key for this cache's maps. Each cache operation
+    //! runs SipHash exactly once, here; shard routing and all map probes
+    //! (including any rehash) reuse the stored result.
+    HashedOutpoint HashedKey(const COutPoint& outpoint) const { return HashedOutpoint{outpoint, m_shard_hasher}; }
+    //! Route a key to its shard. Reusing the stored hash for the shard choice
+    //! fixes its low bits per shard map, which is harmless for bucket
+    //! placement since unordered_map reduces hashes modulo a prime.
+    CoinsShard& ShardFor(const HashedOutpoint& key) const
+    {
+        return m_shards[key.hash & (NUM_COINS_SHARDS - 1)];
+    }
+    //! Convenience accessor for the sub-map an outpoint lives in.
+    CCoinsMap& ShardMapFor(const COutPoint& outpoint) const { return ShardFor(HashedKey(outpoint)).map; }
 
 public:
     CCoinsViewCache(CCoinsView *baseIn);
@@ -235,7 +378,8 @@ public:
     bool HaveCoin(const COutPoint &outpoint) const override;
     uint256 GetBestBlock() const override;
     void SetBestBlock(const uint256 &hashBlock);
-    bool BatchWrite(CCoinsMap &mapCoins, const uint256 &hashBlock) override;
+    bool BatchWrite(CCoinsMap &mapCoins, const uint256 &hashBlock, bool erase = true) override;
+    bool BatchWriteShards(std::vector<CCoinsMap*>& shards, const uint256 &hashBlock, bool erase = true) override;
     std::unique_ptr<CCoinsViewCursor> Cursor() const override {
         throw std::logic_error("CCoinsViewCache cursor iteration not supported.");
     }
@@ -281,6 +425,14 @@ public:
      */
     bool SpendCoin(const COutPoint &outpoint, Coin* moveto = nullptr);
 
+    /**
+     * Hint that approximately `count` additional coins are about to be added,
+     * so each shard map can size itself once up front instead of rehashing
+     * repeatedly while they stream in (used by block disconnect, which
+     * re-adds every coin the block spent).
+     */
+    void ReserveAdditional(size_t count);
+
     /**
      * Push the modifications applied to this cache to its base.
      * Failure to call this method before destruction will cause the changes to be forgotten.
@@ -288,6 +440,33 @@ public:
      */
     bool Flush();
 
+    /**
+     * Push the modifications applied to this cache to its base while keeping
+     * the cache entries in place (their DIRTY/FRESH flags are cleared), so a
+     * large warm cache is not emptied and refilled by a periodic flush.
+     * Failure to call this method or Flush() before destruction will cause
+     * the changes to be forgotten.
+     * If false is returned, the state of this cache (and its backing view)
+     * will be undefined.
+     *
+     * When `young_coin_height` is non-negative, unspent FRESH coins created
+     * at that height or later are withheld from the write and keep their
+     * DIRTY/FRESH flags: most outputs are spent again within a short window,
+     * and a FRESH coin that dies in the cache never needs to reach the base
+     * view at all. The caller is responsible for crash consistency, since
+     * the base's best block moves past the withheld entries (the flush path
+     * journals the dirty set first; see FlushStateToDisk).
+     */
+    bool Sync(int young_coin_height = -1);
+
+    /**
+     * Run `func` on every DIRTY entry in the cache, one shard at a time. As
+     * with Flush() and Sync(), the caller must prevent concurrent cache
+     * modification (the flush paths hold cs_main) for the visited set to be
+     * a consistent cut.
+     */
+    void ForEachDirtyEntry(const std::function<void(const COutPoint&, const CCoinsCacheEntry&)>& func) const;
+
     /**
      * Removes the UTXO with the given outpoint from the cache, if it is
      * not modified.
@@ -312,10 +491,17 @@ public:
 
 private:
     /**
-     * @note this is marked const, but may actually append to `cacheCoins`, increasing
-     * memory usage.
+     * Look up a key in the given shard map, pulling it up from the base
+     * view on a miss. The caller must hold the owning shard's mutex.
+     *
+     * @note this is marked const, but may actually append to the shard map,
+     * increasing memory usage.
      */
-    CCoinsMap::iterator FetchCoin(const COutPoint &outpoint) const;
+    CCoinsMap::iterator FetchCoin(const HashedOutpoint& key, CCoinsMap& map) const;
+
+    //! Apply one child map's entries to this cache (the per-entry half of
+    //! BatchWrite, shared with BatchWriteShards).
+    void ApplyBatchEntries(CCoinsMap& mapCoins, bool erase);
 };
 
 //! Utility function to add all of a transaction's outputs to a cache.
@@ -0,0 +1,150 @@
+// Copyright (c) 2022 The Coral Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <coinsjournal.h>
+
+#include <clientversion.h>
+#include <coins.h>
+#include <hash.h>
+#include <logging.h>
+#include <serialize.h>
+#include <streams.h>
+#include <uint256.h>
+#include <util/system.h>
+
+#include <cstdint>
+#include <exception>
+#include <stdexcept>
+#include <utility>
+
+namespace {
+//! Magic prefix so a foreign file is never mistaken for a journal.
+constexpr uint32_t COINS_JOURNAL_MAGIC{0x4c4e4a43}; // "CJNL"
+constexpr uint32_t COINS_JOURNAL_VERSION{1};
+} // namespace
+
+fs::path CoinsJournalPath()
+{
+    return gArgs.GetDataDirNet() / "coinsjournal.dat";
+}
+
+bool WriteCoinsJournal(const CCoinsViewCache& cache, const uint256& base, const fs::path& path)
+{
+    // Write out-of-place and rename over any previous journal, so a crash
+    // mid-write leaves the old (still valid, merely older) journal behind.
+    fs::path tmppath{path};
+    tmppath += ".new";
+
+    CAutoFile fileout{fsbridge::fopen(tmppath, "wb"), SER_DISK, CLIENT_VERSION};
+    if (fileout.IsNull()) {
+        return error("%s: failed to open coins journal file %s", __func__, fs::PathToString(tmppath));
+    }
+
+    // The caller serializes cache modifications (the flush paths hold
+    // cs_main), so the counting pass and the writing pass below see the same
+    // dirty set.
+    uint64_t count{0};
+    cache.ForEachDirtyEntry([&](const COutPoint&, const CCoinsCacheEntry&) { ++count; });
+
+    try {
+        CHashWriter hasher{SER_DISK, CLIENT_VERSION};
+        const auto write_both{[&](const auto& obj) { hasher << obj; fileout << obj; }};
+        write_both(COINS_JOURNAL_MAGIC);
+        write_both(COINS_JOURNAL_VERSION);
+        write_both(base);
+        write_both(cache.GetBestBlock());
+        WriteCompactSize(hasher, count);
+        WriteCompactSize(fileout, count);
+        cache.ForEachDirtyEntry([&](const COutPoint& outpoint, const CCoinsCacheEntry& entry) {
+            write_both(outpoint);
+            const uint8_t spent{entry.coin.IsSpent() ? uint8_t{1} : uint8_t{0}};
+            write_both(spent);
+            if (!spent) write_both(entry.coin);
+        });
+        fileout << hasher.GetHash();
+    } catch (const std::exception& e) {
+        return error("%s: failed to write coins journal: %s", __func__, e.what());
+    }
+
+    if (!FileCommit(fileout.Get())) {
+        return error("%s: failed to commit coins journal file %s", __func__, fs::PathToString(tmppath));
+    }
+    fileout.fclose();
+    if (!RenameOver(tmppath, path)) {
+        return error("%s: failed to rename coins journal file %s -> %s", __func__,
+                     fs::PathToString(tmppath), fs::PathToString(path));
+    }
+    return true;
+}
+
+bool ApplyCoinsJournal(CCoinsView& db, const fs::path& path, const std::function<bool(const uint256&)>& tip_known)
+{
+    if (!fs::exists(path)) return true;
+
+    bool usable{false};
+    uint256 base, tip;
+    CCoinsMapMemoryResource resource;
+    CCoinsMap map{CCoinsMap::allocator_type{&resource}};
+    // Salts the stored key hashes of this throwaway map; the database batch
+    // write only reads the outpoints back out.
+    const SaltedOutpointHasher hasher;
+    try {
+        CAutoFile filein{fsbridge::fopen(path, "rb"), SER_DISK, CLIENT_VERSION};
+        if (filein.IsNull()) throw std::runtime_error("cannot open file");
+        CHashVerifier<CAutoFile> verifier{&filein};
+        uint32_t magic, version;
+        verifier >> magic >> version;
+        if (magic != COINS_JOURNAL_MAGIC) throw std::runtime_error("bad magic");
+        if (version != COINS_JOURNAL_VERSION) throw std::runtime_error(strprintf("unsupported version %u", version));
+        verifier >> base >> tip;
+        const uint64_t count{ReadCompactSize(verifier)};
+        for (uint64_t i{0}; i < count; ++i) {
+            COutPoint outpoint;
+            uint8_t spent;
+            verifier >> outpoint >> spent;
+            CCoinsCacheEntry entry;
+            entry.flags = CCoinsCacheEntry::DIRTY;
+            if (!spent) verifier >> entry.coin;
+            map.emplace(HashedOutpoint{outpoint, hasher}, std::move(entry));
+        }
+        uint256 checksum;
+        filein >> checksum;
+        if (checksum != verifier.GetHash()) throw std::runtime_error("checksum mismatch");
+        usable = true;
+    } catch (const std::exception& e) {
+        LogPrintf("Discarding unusable coins journal %s: %s\n", fs::PathToString(path), e.what());
+    }
+
+    if (usable && db.GetBestBlock() != base) {
+        // A journal predating the last database flush; the database already
+        // contains everything it describes (and possibly more).
+        LogPrintf("Discarding stale coins journal (base %s, database at %s)\n",
+                  base.ToString(), db.GetBestBlock().ToString());
+        usable = false;
+    }
+    if (usable && !tip_known(tip)) {
+        LogPrintf("Discarding coins journal with unknown tip %s\n", tip.ToString());
+        usable = false;
+    }
+
+    if (usable) {
+        LogPrintf("Applying coins journal: %u coins, advancing database from %s to %s\n",
+                  map.size(), base.ToString(), tip.ToString());
+        if (!db.BatchWrite(map, tip)) {
+            return error("%s: failed to write journaled coins to database", __func__);
+        }
+    }
+    RemoveCoinsJournal(path);
+    return true;
+}
+
+void RemoveCoinsJournal(const fs::path& path)
+{
+    try {
+        fs::remove(path);
+    } catch (const fs::filesystem_error& e) {
+        LogPrintf("Unable to remove coins journal %s: %s\n",
+                  fs::PathToString(path), fsbridge::get_filesystem_error_message(e));
+    }
+}
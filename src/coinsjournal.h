@@ -0,0 +1,58 @@
+// Copyright (c) 2022 The Coral Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef CORAL_COINSJOURNAL_H
+#define CORAL_COINSJOURNAL_H
+
+#include <fs.h>
+
+#include <functional>
+
+class CCoinsView;
+class CCoinsViewCache;
+class uint256;
+
+/**
+ * The coins journal is a crash-recovery file for the coins cache. Between the
+ * infrequent coins database flushes, the dirty cache entries only exist in
+ * memory, so a crash forces every block since the last flush to be
+ * reconnected on startup. The journal records the complete dirty delta
+ * between the database contents and the in-memory tip as one sequential
+ * write; after an unclean shutdown it is applied to the database directly,
+ * which decouples the flush cadence (and thus the usable -dbcache size) from
+ * the cost of crash recovery.
+ *
+ * Each journal write supersedes the previous one (the dirty set always
+ * describes the full delta from the database's best block), so the file
+ * holds a single checksummed record and is replaced atomically.
+ */
+
+//! Default location of the journal within the network data directory.
+fs::path CoinsJournalPath();
+
+/**
+ * Write all dirty entries of `cache` to a journal file at `path`,
+ * superseding any previous journal. `base` must be the best block of the
+ * cache's backing database. The file is written out-of-place and renamed, so
+ * a crash mid-write leaves the previous journal intact. Returns false if the
+ * journal could not be written; the caller may treat this as non-fatal since
+ * the journal only accelerates crash recovery.
+ */
+bool WriteCoinsJournal(const CCoinsViewCache& cache, const uint256& base, const fs::path& path);
+
+/**
+ * Apply the journal at `path` to the coins database, bringing its best block
+ * forward to the journal's tip without reconnecting the intervening blocks.
+ * A missing journal is a no-op; a stale one (base does not match the
+ * database's best block), one with an unknown tip (per `tip_known`) or a
+ * corrupt one is discarded, falling back to the usual block replay. The
+ * journal file is always removed. Returns false only if writing the database
+ * itself failed.
+ */
+bool ApplyCoinsJournal(CCoinsView& db, const fs::path& path, const std::function<bool(const uint256&)>& tip_known);
+
+/** Delete any journal at `path`; called once the database has caught up. */
+void RemoveCoinsJournal(const fs::path& path);
+
+#endif // CORAL_COINSJOURNAL_H
@@ -5,6 +5,9 @@
 #include <consensus/merkle.h>
 #include <hash.h>
 
+#include <algorithm>
+#include <thread>
+
 /*     WARNING! If you're reading this because you're learning about crypto
        and/or designing a new system that will use merkle trees, keep in mind
        that the following merkle tree algorithm has a serious flaw related to
@@ -42,8 +45,85 @@
 */
 
 
+namespace {
+//! Leaf count below which splitting into subtrees costs more in thread
+//! startup than the hashing saves.
+constexpr size_t MERKLE_PARALLEL_MIN_LEAVES{2048};
+//! Leaves per worker subtree. A power of two, so that pairs never straddle a
+//! subtree boundary and the duplicate-last rule only ever applies inside the
+//! final (possibly partial) subtree.
+constexpr size_t MERKLE_SUBTREE_LEAVES{1024};
+
+//! Reduce count hashes at the start of the buffer by one level, in place:
+//! pair hashes up, duplicating the last one when count is odd. The buffer
+//! must have room for count + 1 entries so the duplicate fits. Returns the
+//! size of the new level; sets mutation when two paired hashes are identical
+//! (see the CVE-2012-2459 warning above).
+size_t MerkleLevel(uint256* hashes, size_t count, bool& mutation)
+{
+    for (size_t pos = 0; pos + 1 < count; pos += 2) {
+        if (hashes[pos] == hashes[pos + 1]) mutation = true;
+    }
+    if (count & 1) {
+        hashes[count] = hashes[count - 1];
+        count++;
+    }
+    SHA256D64(hashes[0].begin(), hashes[0].begin(), count / 2);
+    return count / 2;
+}
+} // namespace
+
 uint256 ComputeMerkleRoot(std::vector<uint256> hashes, bool* mutated) {
     bool mutation = false;
+    if (hashes.size() >= MERKLE_PARALLEL_MIN_LEAVES && std::thread::hardware_concurrency() > 1) {
+        // Reduce aligned subtrees of MERKLE_SUBTREE_LEAVES leaves to their
+        // tops in parallel, then let the serial loop below finish the
+        // remaining levels. Every full subtree has an even count at each
+        // level, so this pairs up exactly the same hashes the serial loop
+        // would have.
+        const size_t full_subtrees{hashes.size() / MERKLE_SUBTREE_LEAVES};
+        const size_t worker_count{std::min<size_t>(std::thread::hardware_concurrency(), full_subtrees)};
+        std::vector<uint8_t> mutations(worker_count, 0);
+        std::vector<std::thread> workers;
+        workers.reserve(worker_count);
+        for (size_t w = 0; w < worker_count; ++w) {
+            workers.emplace_back([&, w] {
+                bool worker_mutation{false};
+                for (size_t subtree = w; subtree < full_subtrees; subtree += worker_count) {
+                    uint256* base{hashes.data() + subtree * MERKLE_SUBTREE_LEAVES};
+                    size_t count{MERKLE_SUBTREE_LEAVES};
+                    while (count > 1) {
+                        count = MerkleLevel(base, count, worker_mutation);
+                    }
+                }
+                mutations[w] = worker_mutation ? 1 : 0;
+            });
+        }
+        // Reduce the final partial subtree (if any) on this thread. It keeps
+        // applying the duplicate-last rule all the way up to the full
+        // subtrees' height: the full subtrees contribute an even count to
+        // every level below their tops, so the serial loop's odd-count
+        // duplication would have happened exactly here.
+        const size_t tail{hashes.size() - full_subtrees * MERKLE_SUBTREE_LEAVES};
+        uint256 tail_top;
+        if (tail > 0) {
+            std::vector<uint256> buf(tail + 1);
+            std::copy(hashes.begin() + full_subtrees * MERKLE_SUBTREE_LEAVES, hashes.end(), buf.begin());
+            size_t count{tail};
+            for (size_t level_leaves{MERKLE_SUBTREE_LEAVES}; level_leaves > 1; level_leaves /= 2) {
+                count = MerkleLevel(buf.data(), count, mutation);
+            }
+            tail_top = buf[0];
+        }
+        for (auto& worker : workers) worker.join();
+        for (uint8_t worker_mutation : mutations) mutation |= worker_mutation != 0;
+        // Collect the subtree tops and carry on level by level.
+        for (size_t subtree = 0; subtree < full_subtrees; ++subtree) {
+            hashes[subtree] = hashes[subtree * MERKLE_SUBTREE_LEAVES];
+        }
+        hashes.resize(full_subtrees + (tail > 0 ? 1 : 0));
+        if (tail > 0) hashes.back() = tail_top;
+    }
     while (hashes.size() > 1) {
         if (mutated) {
             for (size_t pos = 0; pos + 1 < hashes.size(); pos += 2) {
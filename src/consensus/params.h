@@ -110,11 +110,19 @@ struct Params {
     bool fPowNoRetargeting;
     int64_t nPowTargetSpacing;
     int64_t nPowTargetTimespan;
+    /** Quotient nPowTargetTimespan / nPowTargetSpacing, precomputed once at
+     * chainparams construction so per-header checks read a constant instead
+     * of repeating the division. When left at zero (e.g. tests that fill the
+     * struct by hand) it is computed on the fly. */
+    int64_t nDifficultyAdjustmentInterval{0};
     std::chrono::seconds PowTargetSpacing() const
     {
         return std::chrono::seconds{nPowTargetSpacing};
     }
-    int64_t DifficultyAdjustmentInterval() const { return nPowTargetTimespan / nPowTargetSpacing; }
+    int64_t DifficultyAdjustmentInterval() const
+    {
+        return nDifficultyAdjustmentInterval != 0 ? nDifficultyAdjustmentInterval : nPowTargetTimespan / nPowTargetSpacing;
+    }
     /** The best chain should have at least this much work */
     uint256 nMinimumChainWork;
     /** By default assume that the signatures in ancestors of this block are valid */
@@ -13,14 +13,19 @@
 #include <script/standard.h>
 #include <serialize.h>
 #include <streams.h>
+#include <sync.h>
 #include <undo.h>
 #include <univalue.h>
 #include <util/check.h>
+#include <util/hasher.h>
 #include <util/strencodings.h>
 #include <util/system.h>
 
+#include <deque>
 #include <map>
+#include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 UniValue ValueFromAmount(const CAmount amount)
@@ -168,17 +173,49 @@ void ScriptToUniv(const CScript& script, UniValue& out, bool include_hex, bool i
     out.pushKV("type", GetTxnOutputType(type));
 }
 
+namespace {
+//! Decoded-transaction cache, shared by all TxToUniv() callers (getrawtransaction,
+//! getblock verbosity>=2 without undo data, REST). The fields preceding "blockhash"
+//! and "hex" depend only on the transaction itself, so a decoded body can be reused
+//! across calls; script disassembly and descriptor inference dominate decode cost.
+//! Transactions are immutable, so entries never go stale and eviction is plain FIFO.
+constexpr size_t MAX_DECODED_TX_CACHE_ENTRIES{1000};
+Mutex g_decoded_tx_mutex;
+//! Keyed by wtxid so witness-dependent fields ("hash", "txinwitness") are covered.
+std::unordered_map<uint256, std::shared_ptr<const UniValue>, SaltedTxidHasher> g_decoded_tx_cache GUARDED_BY(g_decoded_tx_mutex);
+std::deque<uint256> g_decoded_tx_order GUARDED_BY(g_decoded_tx_mutex);
+} // namespace
+
 void TxToUniv(const CTransaction& tx, const uint256& block_hash, UniValue& entry, bool include_hex, int serialize_flags, const CTxUndo* txundo, TxVerbosity verbosity)
 {
-    entry.pushKV("txid", tx.GetHash().GetHex());
-    entry.pushKV("hash", tx.GetWitnessHash().GetHex());
+    // Undo data mixes per-block information (fee, prevouts) into the output, so
+    // only undo-less decodes are shareable.
+    const bool cacheable{txundo == nullptr && verbosity == TxVerbosity::SHOW_DETAILS};
+    if (cacheable) {
+        LOCK(g_decoded_tx_mutex);
+        const auto it{g_decoded_tx_cache.find(tx.GetWitnessHash())};
+        if (it != g_decoded_tx_cache.end()) {
+            entry.pushKVs(*it->second);
+            if (!block_hash.IsNull()) {
+                entry.pushKV("blockhash", block_hash.GetHex());
+            }
+            if (include_hex) {
+                entry.pushKV("hex", EncodeHexTx(tx, serialize_flags));
+            }
+            return;
+        }
+    }
+
+    UniValue body{UniValue::VOBJ};
+    body.pushKV("txid", tx.GetHash().GetHex());
+    body.pushKV("hash", tx.GetWitnessHash().GetHex());
     // Transaction version is actually unsigned in consensus checks, just signed in memory,
     // so cast to unsigned before giving it to the user.
-    entry.pushKV("version", static_cast<int64_t>(static_cast<uint32_t>(tx.nVersion)));
-    entry.pushKV("size", (int)::GetSerializeSize(tx, PROTOCOL_VERSION));
-    entry.pushKV("vsize", (GetTransactionWeight(tx) + WITNESS_SCALE_FACTOR - 1) / WITNESS_SCALE_FACTOR);
-    entry.pushKV("weight", GetTransactionWeight(tx));
-    entry.pushKV("locktime", (int64_t)tx.nLockTime);
+    body.pushKV("version", static_cast<int64_t>(static_cast<uint32_t>(tx.nVersion)));
+    body.pushKV("size", (int)::GetSerializeSize(tx, PROTOCOL_VERSION));
+    body.pushKV("vsize", (GetTransactionWeight(tx) + WITNESS_SCALE_FACTOR - 1) / WITNESS_SCALE_FACTOR);
+    body.pushKV("weight", GetTransactionWeight(tx));
+    body.pushKV("locktime", (int64_t)tx.nLockTime);
 
     UniValue vin{UniValue::VARR};
 
@@ -229,7 +266,7 @@ void TxToUniv(const CTransaction& tx, const uint256& block_hash, UniValue& entry
         in.pushKV("sequence", (int64_t)txin.nSequence);
         vin.push_back(in);
     }
-    entry.pushKV("vin", vin);
+    body.pushKV("vin", vin);
 
     UniValue vout(UniValue::VARR);
     for (unsigned int i = 0; i < tx.vout.size(); i++) {
@@ -249,13 +286,26 @@ void TxToUniv(const CTransaction& tx, const uint256& block_hash, UniValue& entry
             amt_total_out += txout.nValue;
         }
     }
-    entry.pushKV("vout", vout);
+    body.pushKV("vout", vout);
 
     if (have_undo) {
         const CAmount fee = amt_total_in - amt_total_out;
         CHECK_NONFATAL(MoneyRange(fee));
-        entry.pushKV("fee", ValueFromAmount(fee));
+        body.pushKV("fee", ValueFromAmount(fee));
+    }
+
+    if (cacheable) {
+        auto shared_body{std::make_shared<const UniValue>(body)};
+        LOCK(g_decoded_tx_mutex);
+        if (g_decoded_tx_cache.emplace(tx.GetWitnessHash(), std::move(shared_body)).second) {
+            g_decoded_tx_order.push_back(tx.GetWitnessHash());
+            while (g_decoded_tx_cache.size() > MAX_DECODED_TX_CACHE_ENTRIES) {
+                g_decoded_tx_cache.erase(g_decoded_tx_order.front());
+                g_decoded_tx_order.pop_front();
+            }
+        }
     }
+    entry.pushKVs(std::move(body));
 
     if (!block_hash.IsNull()) {
         entry.pushKV("blockhash", block_hash.GetHex());
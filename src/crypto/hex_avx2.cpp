@@ -0,0 +1,85 @@
+// Copyright (c) 2022 The Coral Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifdef ENABLE_AVX2
+
+#include <immintrin.h>
+
+#include <cstddef>
+
+namespace hex_avx2
+{
+namespace
+{
+/** 0xFF where lo <= byte <= hi (unsigned compare); bounds must be < 0x80. */
+__m256i InRange(__m256i x, unsigned char lo, unsigned char hi)
+{
+    const __m256i xb = _mm256_xor_si256(x, _mm256_set1_epi8((char)0x80));
+    const __m256i above = _mm256_cmpgt_epi8(xb, _mm256_set1_epi8((char)((lo - 1) ^ 0x80)));
+    const __m256i below = _mm256_cmpgt_epi8(_mm256_set1_epi8((char)((hi + 1) ^ 0x80)), xb);
+    return _mm256_and_si256(above, below);
+}
+
+/** Convert 32 hex characters to nibble values. Returns false if any
+ * character is not in [0-9a-fA-F]. */
+bool DecodeNibbles(__m256i c, __m256i& nibbles)
+{
+    const __m256i lower = _mm256_or_si256(c, _mm256_set1_epi8(0x20));
+    const __m256i is_digit = InRange(c, '0', '9');
+    const __m256i is_alpha = InRange(lower, 'a', 'f');
+    const __m256i digit_val = _mm256_sub_epi8(c, _mm256_set1_epi8('0'));
+    const __m256i alpha_val = _mm256_sub_epi8(lower, _mm256_set1_epi8('a' - 10));
+    nibbles = _mm256_or_si256(_mm256_and_si256(is_digit, digit_val),
+                              _mm256_and_si256(is_alpha, alpha_val));
+    return _mm256_movemask_epi8(_mm256_or_si256(is_digit, is_alpha)) == -1;
+}
+} // namespace
+
+void Encode(const unsigned char* in, char* out, size_t blocks)
+{
+    const __m256i lut = _mm256_setr_epi8(
+        '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'a', 'b', 'c', 'd', 'e', 'f',
+        '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'a', 'b', 'c', 'd', 'e', 'f');
+    const __m256i low_mask = _mm256_set1_epi8(0x0F);
+    while (blocks--) {
+        const __m256i v = _mm256_loadu_si256((const __m256i*)in);
+        const __m256i hi = _mm256_and_si256(_mm256_srli_epi16(v, 4), low_mask);
+        const __m256i lo = _mm256_and_si256(v, low_mask);
+        const __m256i hi_c = _mm256_shuffle_epi8(lut, hi);
+        const __m256i lo_c = _mm256_shuffle_epi8(lut, lo);
+        // Interleave high and low digits; the unpacks work per 128-bit lane,
+        // so a cross-lane permute restores byte order.
+        const __m256i t0 = _mm256_unpacklo_epi8(hi_c, lo_c);
+        const __m256i t1 = _mm256_unpackhi_epi8(hi_c, lo_c);
+        _mm256_storeu_si256((__m256i*)out, _mm256_permute2x128_si256(t0, t1, 0x20));
+        _mm256_storeu_si256((__m256i*)(out + 32), _mm256_permute2x128_si256(t0, t1, 0x31));
+        in += 32;
+        out += 64;
+    }
+}
+
+size_t Decode(const char* in, unsigned char* out, size_t blocks)
+{
+    // Per character pair: high nibble * 16 + low nibble.
+    const __m256i mul = _mm256_set1_epi16(0x0110);
+    size_t done = 0;
+    for (; done < blocks; ++done) {
+        const __m256i c0 = _mm256_loadu_si256((const __m256i*)in);
+        const __m256i c1 = _mm256_loadu_si256((const __m256i*)(in + 32));
+        __m256i n0, n1;
+        if (!DecodeNibbles(c0, n0) || !DecodeNibbles(c1, n1)) break;
+        const __m256i b0 = _mm256_maddubs_epi16(n0, mul);
+        const __m256i b1 = _mm256_maddubs_epi16(n1, mul);
+        // packus interleaves the 128-bit lanes of its inputs; permute the
+        // 64-bit quarters back into input order.
+        const __m256i packed = _mm256_permute4x64_epi64(_mm256_packus_epi16(b0, b1), 0xD8);
+        _mm256_storeu_si256((__m256i*)out, packed);
+        in += 64;
+        out += 32;
+    }
+    return done;
+}
+} // namespace hex_avx2
+
+#endif
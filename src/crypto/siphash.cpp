@@ -2,8 +2,36 @@
 // Distributed under the MIT software license, see the accompanying
 // file COPYING or http://www.opensource.org/licenses/mit-license.php.
 
+#include <crypto/common.h>
 #include <crypto/siphash.h>
 
+#include <compat/cpuid.h>
+
+#if defined(ENABLE_AVX2) && !defined(BUILD_CORAL_INTERNAL)
+namespace siphash_avx2
+{
+void Hash_4way(uint64_t k0, uint64_t k1, const unsigned char* in, uint64_t* out, size_t blocks);
+}
+#endif
+
+namespace
+{
+typedef void (*Hash4WayFn)(uint64_t k0, uint64_t k1, const unsigned char* in, uint64_t* out, size_t blocks);
+
+/** 4-way batch implementation selected by SipHashAutoDetect(), if any. */
+Hash4WayFn hash_4way{nullptr};
+
+#if defined(USE_ASM) && (defined(__x86_64__) || defined(__amd64__) || defined(__i386__))
+/** Check whether the OS has enabled AVX registers. */
+bool AVXEnabled()
+{
+    uint32_t a, d;
+    __asm__("xgetbv" : "=a"(a), "=d"(d) : "c"(0));
+    return (a & 6) == 6;
+}
+#endif
+} // namespace
+
 #define ROTL(x, b) (uint64_t)(((x) << (b)) | ((x) >> (64 - (b))))
 
 #define SIPROUND do { \
@@ -131,6 +159,43 @@ uint64_t SipHashUint256(uint64_t k0, uint64_t k1, const uint256& val)
     return v0 ^ v1 ^ v2 ^ v3;
 }
 
+uint64_t SipHash(uint64_t k0, uint64_t k1, Span<const unsigned char> data)
+{
+    /* Specialized implementation for efficiency */
+    uint64_t v0 = 0x736f6d6570736575ULL ^ k0;
+    uint64_t v1 = 0x646f72616e646f6dULL ^ k1;
+    uint64_t v2 = 0x6c7967656e657261ULL ^ k0;
+    uint64_t v3 = 0x7465646279746573ULL ^ k1;
+
+    const unsigned char* in = data.data();
+    size_t size = data.size();
+    while (size >= 8) {
+        uint64_t d = ReadLE64(in);
+        v3 ^= d;
+        SIPROUND;
+        SIPROUND;
+        v0 ^= d;
+        in += 8;
+        size -= 8;
+    }
+
+    // Remaining bytes, with the input length (mod 256) in the top byte.
+    uint64_t t = ((uint64_t)(uint8_t)data.size()) << 56;
+    for (size_t i = 0; i < size; ++i) {
+        t |= ((uint64_t)in[i]) << (8 * i);
+    }
+    v3 ^= t;
+    SIPROUND;
+    SIPROUND;
+    v0 ^= t;
+    v2 ^= 0xFF;
+    SIPROUND;
+    SIPROUND;
+    SIPROUND;
+    SIPROUND;
+    return v0 ^ v1 ^ v2 ^ v3;
+}
+
 uint64_t SipHashUint256Extra(uint64_t k0, uint64_t k1, const uint256& val, uint32_t extra)
 {
     /* Specialized implementation for efficiency */
@@ -171,3 +236,51 @@ uint64_t SipHashUint256Extra(uint64_t k0, uint64_t k1, const uint256& val, uint3
     SIPROUND;
     return v0 ^ v1 ^ v2 ^ v3;
 }
+
+void SipHashUint256Batch(uint64_t k0, uint64_t k1, const uint256* vals, uint64_t* out, size_t count)
+{
+    if (hash_4way) {
+        const size_t blocks{count / 4};
+        if (blocks > 0) {
+            // uint256 stores its words in little-endian byte order, so four
+            // consecutive elements are exactly 128 bytes of input words.
+            hash_4way(k0, k1, vals->begin(), out, blocks);
+            vals += blocks * 4;
+            out += blocks * 4;
+            count -= blocks * 4;
+        }
+    }
+    for (size_t i = 0; i < count; ++i) {
+        out[i] = SipHashUint256(k0, k1, vals[i]);
+    }
+}
+
+std::string SipHashAutoDetect()
+{
+    std::string ret = "standard";
+#if defined(USE_ASM) && defined(HAVE_GETCPUID)
+    [[maybe_unused]] bool have_avx2 = false;
+    [[maybe_unused]] bool enabled_avx = false;
+
+    uint32_t eax, ebx, ecx, edx;
+    GetCPUID(1, 0, eax, ebx, ecx, edx);
+    const bool have_xsave = (ecx >> 27) & 1;
+    const bool have_avx = (ecx >> 28) & 1;
+    if (have_xsave && have_avx) {
+        enabled_avx = AVXEnabled();
+    }
+    if (have_avx) {
+        GetCPUID(7, 0, eax, ebx, ecx, edx);
+        have_avx2 = (ebx >> 5) & 1;
+    }
+
+#if defined(ENABLE_AVX2) && !defined(BUILD_CORAL_INTERNAL)
+    if (have_avx2 && enabled_avx) {
+        hash_4way = siphash_avx2::Hash_4way;
+        ret = "avx2(4way)";
+    }
+#endif
+#endif // defined(USE_ASM) && defined(HAVE_GETCPUID)
+
+    return ret;
+}
@@ -7,6 +7,9 @@
 
 #include <stdint.h>
 
+#include <string>
+
+#include <span.h>
 #include <uint256.h>
 
 /** SipHash-2-4 */
@@ -44,4 +47,29 @@ public:
 uint64_t SipHashUint256(uint64_t k0, uint64_t k1, const uint256& val);
 uint64_t SipHashUint256Extra(uint64_t k0, uint64_t k1, const uint256& val, uint32_t extra);
 
+/** Optimized one-shot SipHash-2-4 of a byte span.
+ *
+ *  It is identical to:
+ *    CSipHasher(k0, k1)
+ *      .Write(data.data(), data.size())
+ *      .Finalize()
+ *  but consumes whole 64-bit words of input per compression round rather
+ *  than accumulating one byte at a time.
+ */
+uint64_t SipHash(uint64_t k0, uint64_t k1, Span<const unsigned char> data);
+
+/** Compute the SipHash-2-4 of count 32-byte inputs sharing one key.
+ *
+ *  Identical to storing SipHashUint256(k0, k1, vals[i]) in out[i] for every
+ *  element, but hashes four independent inputs per pass when a SIMD
+ *  implementation has been selected by SipHashAutoDetect(). Intended for bulk
+ *  fixed-width hashing such as compact block short ID computation.
+ */
+void SipHashUint256Batch(uint64_t k0, uint64_t k1, const uint256* vals, uint64_t* out, size_t count);
+
+/** Autodetect the best available SipHash batch implementation.
+ *  Returns the name of the implementation.
+ */
+std::string SipHashAutoDetect();
+
 #endif // CORAL_CRYPTO_SIPHASH_H
@@ -0,0 +1,93 @@
+// Copyright (c) 2022 The Coral Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifdef ENABLE_AVX2
+
+#include <stdint.h>
+#include <immintrin.h>
+
+#include <cstddef>
+
+namespace siphash_avx2 {
+namespace {
+
+__m256i inline K(uint64_t x) { return _mm256_set1_epi64x(x); }
+
+__m256i inline Add(__m256i x, __m256i y) { return _mm256_add_epi64(x, y); }
+__m256i inline Xor(__m256i x, __m256i y) { return _mm256_xor_si256(x, y); }
+__m256i inline Rotl(__m256i x, int b) { return _mm256_or_si256(_mm256_slli_epi64(x, b), _mm256_srli_epi64(x, 64 - b)); }
+
+/** One SipHash round on four independent states, one per 64-bit lane. */
+void inline __attribute__((always_inline)) Round(__m256i& v0, __m256i& v1, __m256i& v2, __m256i& v3)
+{
+    v0 = Add(v0, v1); v1 = Rotl(v1, 13); v1 = Xor(v1, v0);
+    v0 = Rotl(v0, 32);
+    v2 = Add(v2, v3); v3 = Rotl(v3, 16); v3 = Xor(v3, v2);
+    v0 = Add(v0, v3); v3 = Rotl(v3, 21); v3 = Xor(v3, v0);
+    v2 = Add(v2, v1); v1 = Rotl(v1, 17); v1 = Xor(v1, v2);
+    v2 = Rotl(v2, 32);
+}
+
+/** Absorb one message word per lane (SipHash-2-4, so two rounds). */
+void inline __attribute__((always_inline)) Compress(__m256i& v0, __m256i& v1, __m256i& v2, __m256i& v3, __m256i d)
+{
+    v3 = Xor(v3, d);
+    Round(v0, v1, v2, v3);
+    Round(v0, v1, v2, v3);
+    v0 = Xor(v0, d);
+}
+
+} // namespace
+
+void Hash_4way(uint64_t k0, uint64_t k1, const unsigned char* in, uint64_t* out, size_t blocks)
+{
+    const __m256i init0 = K(0x736f6d6570736575ULL ^ k0);
+    const __m256i init1 = K(0x646f72616e646f6dULL ^ k1);
+    const __m256i init2 = K(0x6c7967656e657261ULL ^ k0);
+    const __m256i init3 = K(0x7465646279746573ULL ^ k1);
+    // 32 bytes of input per message, in little-endian 64-bit words.
+    const __m256i fin = K(((uint64_t)4) << 59);
+
+    while (blocks--) {
+        // Load the four 32-byte inputs and transpose them so that message
+        // vector mj holds word j of every input, one input per lane.
+        __m256i r0 = _mm256_loadu_si256((const __m256i*)(in + 0));
+        __m256i r1 = _mm256_loadu_si256((const __m256i*)(in + 32));
+        __m256i r2 = _mm256_loadu_si256((const __m256i*)(in + 64));
+        __m256i r3 = _mm256_loadu_si256((const __m256i*)(in + 96));
+        __m256i t0 = _mm256_unpacklo_epi64(r0, r1);
+        __m256i t1 = _mm256_unpackhi_epi64(r0, r1);
+        __m256i t2 = _mm256_unpacklo_epi64(r2, r3);
+        __m256i t3 = _mm256_unpackhi_epi64(r2, r3);
+        __m256i m0 = _mm256_permute2x128_si256(t0, t2, 0x20);
+        __m256i m1 = _mm256_permute2x128_si256(t1, t3, 0x20);
+        __m256i m2 = _mm256_permute2x128_si256(t0, t2, 0x31);
+        __m256i m3 = _mm256_permute2x128_si256(t1, t3, 0x31);
+
+        __m256i v0 = init0;
+        __m256i v1 = init1;
+        __m256i v2 = init2;
+        __m256i v3 = init3;
+
+        Compress(v0, v1, v2, v3, m0);
+        Compress(v0, v1, v2, v3, m1);
+        Compress(v0, v1, v2, v3, m2);
+        Compress(v0, v1, v2, v3, m3);
+        Compress(v0, v1, v2, v3, fin);
+        v2 = Xor(v2, K(0xFF));
+        Round(v0, v1, v2, v3);
+        Round(v0, v1, v2, v3);
+        Round(v0, v1, v2, v3);
+        Round(v0, v1, v2, v3);
+
+        _mm256_storeu_si256((__m256i*)out, Xor(Xor(v0, v1), Xor(v2, v3)));
+
+        in += 128;
+        out += 4;
+    }
+}
+
+} // namespace siphash_avx2
+
+#endif
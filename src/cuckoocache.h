@@ -118,6 +118,19 @@ public:
     }
 };
 
+/** Stats describes one cache instance's occupancy and lookup counters, as
+ * returned by cache::get_stats(). */
+struct Stats {
+    //! contains() calls that found their element
+    uint64_t hits;
+    //! contains() calls that did not find their element
+    uint64_t misses;
+    //! total slots in the table
+    uint32_t max_elements;
+    //! slots holding a live (neither collected nor bulk-invalidated) element
+    uint32_t occupied;
+};
+
 /** @ref cache implements a cache with properties similar to a cuckoo-set.
  *
  *  The cache is able to hold up to `(~(uint32_t)0) - 1` elements.
@@ -200,6 +213,22 @@ private:
      */
     uint8_t depth_limit;
 
+    /** generation_tags records the value of `generation` at the time each
+     * element was last inserted. Elements whose tag no longer matches
+     * `generation` have been bulk-invalidated: contains() treats them as
+     * absent and insert() treats their slots as free. See bulk_invalidate().
+     */
+    std::vector<uint32_t> generation_tags;
+
+    /** The current generation; advanced by bulk_invalidate(). */
+    uint32_t generation;
+
+    /** Lookup counters for get_stats(). Relaxed atomics because contains()
+     * may be called from many reader threads concurrently.
+     */
+    mutable std::atomic<uint64_t> hit_count{0};
+    mutable std::atomic<uint64_t> miss_count{0};
+
     /** hash_function is a const instance of the hash function. It cannot be
      * static or initialized at call time as it may have internal state (such as
      * a nonce).
@@ -294,7 +323,7 @@ private:
         // have not been erased.
         uint32_t epoch_unused_count = 0;
         for (uint32_t i = 0; i < size; ++i)
-            epoch_unused_count += epoch_flags[i] &&
+            epoch_unused_count += epoch_flags[i] && generation_tags[i] == generation &&
                                   !collection_flags.bit_is_set(i);
         // If there are more non-deleted entries in the current epoch than the
         // epoch size, then allow_erase on all elements in the old epoch (marked
@@ -323,7 +352,8 @@ public:
      * call to setup or setup_bytes, otherwise operations may segfault.
      */
     cache() : table(), size(), collection_flags(0), epoch_flags(),
-    epoch_heuristic_counter(), epoch_size(), depth_limit(0), hash_function()
+    epoch_heuristic_counter(), epoch_size(), depth_limit(0), generation_tags(),
+    generation(0), hash_function()
     {
     }
 
@@ -343,6 +373,10 @@ public:
         table.resize(size);
         collection_flags.setup(size);
         epoch_flags.resize(size);
+        generation_tags.assign(size, 0);
+        generation = 0;
+        hit_count = 0;
+        miss_count = 0;
         // Set to 45% as described above
         epoch_size = std::max((uint32_t)1, (45 * size) / 100);
         // Initially set to wait for a whole epoch
@@ -406,19 +440,22 @@ public:
         // Make sure we have not already inserted this element
         // If we have, make sure that it does not get deleted
         for (const uint32_t loc : locs)
-            if (table[loc] == e) {
+            if (table[loc] == e && generation_tags[loc] == generation) {
                 please_keep(loc);
                 epoch_flags[loc] = last_epoch;
                 return;
             }
         for (uint8_t depth = 0; depth < depth_limit; ++depth) {
-            // First try to insert to an empty slot, if one exists
+            // First try to insert to an empty slot, if one exists. A slot
+            // holding a bulk-invalidated (stale generation) element counts
+            // as empty.
             for (const uint32_t loc : locs) {
-                if (!collection_flags.bit_is_set(loc))
+                if (!collection_flags.bit_is_set(loc) && generation_tags[loc] == generation)
                     continue;
                 table[loc] = std::move(e);
                 please_keep(loc);
                 epoch_flags[loc] = last_epoch;
+                generation_tags[loc] = generation;
                 return;
             }
             /** Swap with the element at the location that was
@@ -436,7 +473,11 @@ public:
             * for the next iteration.
             */
             last_loc = locs[(1 + (std::find(locs.begin(), locs.end(), last_loc) - locs.begin())) & 7];
+            // The evicted element is always from the current generation:
+            // stale slots were treated as empty above, so its tag needs no
+            // tracking across iterations.
             std::swap(table[last_loc], e);
+            generation_tags[last_loc] = generation;
             // Can't std::swap a std::vector<bool>::reference and a bool&.
             bool epoch = last_epoch;
             last_epoch = epoch_flags[last_loc];
@@ -478,13 +519,45 @@ public:
     {
         std::array<uint32_t, 8> locs = compute_hashes(e);
         for (const uint32_t loc : locs)
-            if (table[loc] == e) {
+            if (table[loc] == e && generation_tags[loc] == generation) {
                 if (erase)
                     allow_erase(loc);
+                hit_count.fetch_add(1, std::memory_order_relaxed);
                 return true;
             }
+        miss_count.fetch_add(1, std::memory_order_relaxed);
         return false;
     }
+
+    /** bulk_invalidate logically erases every element currently in the cache
+     * in O(1) by advancing the generation: the affected slots become
+     * invisible to contains() and are reused by insert() as if they were
+     * empty. This is a Write operation and requires the same synchronization
+     * as insert().
+     *
+     * The generation counter is 32 bits wide, so after 2^32 calls a
+     * surviving stale slot could alias the current generation; with one call
+     * per invalidation event this is unreachable in practice.
+     */
+    void bulk_invalidate()
+    {
+        ++generation;
+    }
+
+    /** get_stats returns the lookup counters (accumulated since setup) and a
+     * count of occupied slots; the occupancy scan is O(size), so this is
+     * meant for occasional monitoring, not hot paths. This is a Read
+     * operation and requires no concurrent Write.
+     */
+    Stats get_stats() const
+    {
+        Stats ret{hit_count.load(std::memory_order_relaxed),
+                  miss_count.load(std::memory_order_relaxed), size, 0};
+        for (uint32_t i = 0; i < size; ++i) {
+            ret.occupied += !collection_flags.bit_is_set(i) && generation_tags[i] == generation;
+        }
+        return ret;
+    }
 };
 } // namespace CuckooCache
 
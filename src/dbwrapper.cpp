@@ -110,13 +110,19 @@ static void SetMaxOpenFiles(leveldb::Options *options) {
              options->max_open_files, default_open_files);
 }
 
-static leveldb::Options GetOptions(size_t nCacheSize)
+static leveldb::Options GetOptions(size_t nCacheSize, const DBParams& params)
 {
     leveldb::Options options;
-    options.block_cache = leveldb::NewLRUCache(nCacheSize / 2);
-    options.write_buffer_size = nCacheSize / 4; // up to two write buffers may be held in memory simultaneously
-    options.filter_policy = leveldb::NewBloomFilterPolicy(10);
-    options.compression = leveldb::kNoCompression;
+    const size_t block_cache_bytes{nCacheSize * std::clamp(params.block_cache_percent, 0, 100) / 100};
+    options.block_cache = leveldb::NewLRUCache(block_cache_bytes);
+    options.write_buffer_size = (nCacheSize - block_cache_bytes) / 2; // up to two write buffers may be held in memory simultaneously
+    if (params.filter_bits_per_key > 0) {
+        options.filter_policy = leveldb::NewBloomFilterPolicy(params.filter_bits_per_key);
+    }
+    options.compression = params.compression ? leveldb::kSnappyCompression : leveldb::kNoCompression;
+    if (params.max_file_size > 0) {
+        options.max_file_size = params.max_file_size;
+    }
     options.info_log = new CCoralLevelDBLogger();
     if (leveldb::kMajorVersion > 1 || (leveldb::kMajorVersion == 1 && leveldb::kMinorVersion >= 16)) {
         // LevelDB versions before 1.16 consider short writes to be corruption. Only trigger error
@@ -127,7 +133,7 @@ static leveldb::Options GetOptions(size_t nCacheSize)
     return options;
 }
 
-CDBWrapper::CDBWrapper(const fs::path& path, size_t nCacheSize, bool fMemory, bool fWipe, bool obfuscate)
+CDBWrapper::CDBWrapper(const fs::path& path, size_t nCacheSize, bool fMemory, bool fWipe, bool obfuscate, const DBParams& params)
     : m_name{fs::PathToString(path.stem())}
 {
     penv = nullptr;
@@ -135,7 +141,7 @@ CDBWrapper::CDBWrapper(const fs::path& path, size_t nCacheSize, bool fMemory, bo
     iteroptions.verify_checksums = true;
     iteroptions.fill_cache = false;
     syncoptions.sync = true;
-    options = GetOptions(nCacheSize);
+    options = GetOptions(nCacheSize, params);
     options.create_if_missing = true;
     if (fMemory) {
         penv = leveldb::NewMemEnv(leveldb::Env::Default());
@@ -214,6 +220,13 @@ bool CDBWrapper::WriteBatch(CDBBatch& batch, bool fSync)
     return true;
 }
 
+std::optional<std::string> CDBWrapper::GetProperty(const std::string& property) const
+{
+    std::string value;
+    if (!pdb->GetProperty(property, &value)) return std::nullopt;
+    return value;
+}
+
 size_t CDBWrapper::DynamicMemoryUsage() const
 {
     std::string memory;
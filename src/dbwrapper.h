@@ -21,6 +21,7 @@
 #include <leveldb/slice.h>
 #include <leveldb/status.h>
 #include <leveldb/write_batch.h>
+#include <optional>
 #include <stdexcept>
 #include <string>
 #include <vector>
@@ -39,6 +40,23 @@ public:
 
 class CDBWrapper;
 
+/**
+ * Tunable per-database LevelDB parameters. The defaults match the values the
+ * wrapper has always hardcoded.
+ */
+struct DBParams {
+    //! Bloom filter bits per key; 0 disables the filter policy.
+    int filter_bits_per_key{10};
+    //! Percentage of the cache budget given to the LevelDB block cache. The
+    //! write buffer receives half of the remainder (up to two write buffers
+    //! may be held in memory simultaneously).
+    int block_cache_percent{50};
+    //! Compress sstables with Snappy.
+    bool compression{false};
+    //! Maximum sstable size in bytes (0 = LevelDB default).
+    size_t max_file_size{0};
+};
+
 /** These should be considered an implementation detail of the specific database.
  */
 namespace dbwrapper_private {
@@ -227,13 +245,17 @@ public:
      * @param[in] fWipe       If true, remove all existing data.
      * @param[in] obfuscate   If true, store data obfuscated via simple XOR. If false, XOR
      *                        with a zero'd byte array.
+     * @param[in] params      LevelDB tuning parameters for this database.
      */
-    CDBWrapper(const fs::path& path, size_t nCacheSize, bool fMemory = false, bool fWipe = false, bool obfuscate = false);
+    CDBWrapper(const fs::path& path, size_t nCacheSize, bool fMemory = false, bool fWipe = false, bool obfuscate = false, const DBParams& params = {});
     ~CDBWrapper();
 
     CDBWrapper(const CDBWrapper&) = delete;
     CDBWrapper& operator=(const CDBWrapper&) = delete;
 
+    //! Value of a LevelDB property (e.g. "leveldb.stats"), if available.
+    std::optional<std::string> GetProperty(const std::string& property) const;
+
     template <typename K, typename V>
     bool Read(const K& key, V& value) const
     {
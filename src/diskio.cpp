@@ -0,0 +1,85 @@
+// Copyright (c) 2022 The Coral Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <diskio.h>
+
+#include <sync.h>
+
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <condition_variable>
+
+namespace diskio {
+namespace {
+
+//! Grace period after the last validation write during which background I/O
+//! keeps waiting, so bursts of small writes keep the disk to themselves.
+constexpr auto VALIDATION_WRITE_GRACE{std::chrono::milliseconds{50}};
+
+//! Upper bound on a single Throttle() call. Index writes yield for less time
+//! than rescan reads, giving them the larger share of whatever bandwidth
+//! validation leaves over while bounding how long either can be held off.
+constexpr std::chrono::seconds MaxWait(Priority priority)
+{
+    switch (priority) {
+    case Priority::INDEX:
+        return std::chrono::seconds{2};
+    case Priority::RESCAN:
+        return std::chrono::seconds{10};
+    } // no default case, so the compiler can warn about missing cases
+    assert(false);
+}
+
+Mutex g_mutex;
+std::condition_variable g_cv;
+//! Number of validation-critical writes currently in flight.
+int g_active_writes GUARDED_BY(g_mutex){0};
+//! Completion time of the most recent validation-critical write.
+std::chrono::steady_clock::time_point g_last_write GUARDED_BY(g_mutex){};
+std::atomic<bool> g_interrupted{false};
+
+} // namespace
+
+ValidationWriteGuard::ValidationWriteGuard()
+{
+    LOCK(g_mutex);
+    ++g_active_writes;
+}
+
+ValidationWriteGuard::~ValidationWriteGuard()
+{
+    {
+        LOCK(g_mutex);
+        --g_active_writes;
+        g_last_write = std::chrono::steady_clock::now();
+    }
+    g_cv.notify_all();
+}
+
+void Throttle(Priority priority)
+{
+    if (g_interrupted) return;
+    const auto deadline{std::chrono::steady_clock::now() + MaxWait(priority)};
+    WAIT_LOCK(g_mutex, lock);
+    while (!g_interrupted) {
+        const auto now{std::chrono::steady_clock::now()};
+        if (now >= deadline) return;
+        if (g_active_writes == 0) {
+            const auto quiet_until{g_last_write + VALIDATION_WRITE_GRACE};
+            if (now >= quiet_until) return;
+            g_cv.wait_until(lock, std::min(quiet_until, deadline));
+        } else {
+            g_cv.wait_until(lock, deadline);
+        }
+    }
+}
+
+void Interrupt()
+{
+    g_interrupted = true;
+    g_cv.notify_all();
+}
+
+} // namespace diskio
@@ -0,0 +1,52 @@
+// Copyright (c) 2022 The Coral Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef CORAL_DISKIO_H
+#define CORAL_DISKIO_H
+
+namespace diskio {
+
+/**
+ * Coordination of bulk disk I/O between the validation path and background
+ * work.
+ *
+ * Block-file writes and coins database flushes are on the critical path of
+ * connecting blocks; background index writes and wallet rescan reads are not,
+ * but compete for the same disk. Validation-critical writers mark themselves
+ * active with a ValidationWriteGuard, and background workers call Throttle()
+ * between batches, which blocks while validation writes are in flight (plus a
+ * short grace period, so bursts of small writes are not interleaved). The
+ * wait is bounded per priority class so background work is never starved
+ * outright, and is cut short by Interrupt() at shutdown.
+ */
+
+//! Background I/O classes, in decreasing order of precedence.
+enum class Priority {
+    //! Background index (txindex, block filter index) writes.
+    INDEX,
+    //! Wallet rescan block reads.
+    RESCAN,
+};
+
+//! RAII marker for a validation-critical write (block files, coins flush).
+class ValidationWriteGuard
+{
+public:
+    ValidationWriteGuard();
+    ~ValidationWriteGuard();
+};
+
+/**
+ * Block until no validation-critical write has run recently, the per-class
+ * wait bound is exhausted, or Interrupt() is called. Background workers call
+ * this between I/O batches.
+ */
+void Throttle(Priority priority);
+
+//! Release all throttled waiters and disable further throttling, for shutdown.
+void Interrupt();
+
+} // namespace diskio
+
+#endif // CORAL_DISKIO_H
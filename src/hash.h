@@ -95,7 +95,12 @@ inline uint160 Hash160(const T1& in1)
     return result;
 }
 
-/** A writer stream (for serialization) that computes a 256-bit hash. */
+/** A writer stream (for serialization) that computes a 256-bit hash.
+ *
+ * Copying a HashWriter captures its SHA256 midstate: a writer loaded with a
+ * fixed prefix once can be cloned per use, so the prefix's compression calls
+ * are never repeated (see TaggedHash() and the BIP143 sighash midstate).
+ */
 class HashWriter
 {
 private:
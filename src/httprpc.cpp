@@ -198,10 +198,24 @@ static bool HTTPReq_JSONRPC(const std::any& context, HTTPRequest* req)
                 req->WriteReply(HTTP_FORBIDDEN);
                 return false;
             }
+            // Offer the handler deferred delivery of the reply, so that
+            // long-polling methods (see e.g. waitfornewblock) do not tie up
+            // this worker thread. Batch requests cannot be deferred because
+            // their replies share one HTTP response.
+            bool deferred{false};
+            jreq.defer_reply = [&deferred, owned_req = req->shared_from_this(), id = jreq.id]() {
+                deferred = true;
+                return [owned_req, id](const UniValue& result) {
+                    owned_req->WriteHeader("Content-Type", "application/json");
+                    owned_req->WriteReply(HTTP_OK, JSONRPCReply(result, NullUniValue, id));
+                };
+            };
             UniValue result = tableRPC.execute(jreq);
+            if (deferred) return true;
 
-            // Send reply
-            strReply = JSONRPCReply(result, NullUniValue, jreq.id);
+            // Send reply. Move the result in so large replies (e.g. verbose
+            // getblock) are not copied into the reply envelope.
+            strReply = JSONRPCReply(std::move(result), NullUniValue, jreq.id);
 
         // array of requests
         } else if (valRequest.isArray()) {
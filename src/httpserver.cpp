@@ -24,6 +24,7 @@
 #include <deque>
 #include <memory>
 #include <optional>
+#include <set>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string>
@@ -47,7 +48,7 @@ static const size_t MAX_HEADERS_SIZE = 8192;
 class HTTPWorkItem final : public HTTPClosure
 {
 public:
-    HTTPWorkItem(std::unique_ptr<HTTPRequest> _req, const std::string &_path, const HTTPRequestHandler& _func):
+    HTTPWorkItem(std::shared_ptr<HTTPRequest> _req, const std::string &_path, const HTTPRequestHandler& _func):
         req(std::move(_req)), path(_path), func(_func)
     {
     }
@@ -56,7 +57,7 @@ public:
         func(req.get(), path);
     }
 
-    std::unique_ptr<HTTPRequest> req;
+    std::shared_ptr<HTTPRequest> req;
 
 private:
     std::string path;
@@ -141,6 +142,9 @@ static struct evhttp* eventHTTP = nullptr;
 static std::vector<CSubNet> rpc_allow_subnets;
 //! Work queue for handling longer requests off the event loop thread
 static std::unique_ptr<WorkQueue<HTTPClosure>> g_work_queue{nullptr};
+//! Separate work queue for heavyweight requests (full-block queries and the
+//! like), serviced by its own worker pool so they cannot delay cheap calls.
+static std::unique_ptr<WorkQueue<HTTPClosure>> g_work_queue_heavy{nullptr};
 //! Handlers for (sub)paths
 static GlobalMutex g_httppathhandlers_mutex;
 static std::vector<HTTPPathHandler> pathHandlers GUARDED_BY(g_httppathhandlers_mutex);
@@ -207,6 +211,59 @@ std::string RequestMethodString(HTTPRequest::RequestMethod m)
     }
 }
 
+//! RPC methods expensive enough to be dispatched to the dedicated heavy
+//! worker pool, so a slow block or UTXO-set query cannot delay cheap calls
+//! like getblockchaininfo behind it.
+static const std::set<std::string> g_heavy_rpc_methods{
+    "dumptxoutset",
+    "getblock",
+    "getblockstats",
+    "getrawmempool",
+    "getrawtransaction",
+    "gettxoutsetinfo",
+    "scantxoutset",
+};
+
+//! Number of request body bytes inspected to classify a JSON-RPC call.
+static const size_t MAX_METHOD_PEEK_SIZE{4096};
+
+/** Classify a request as heavyweight. For REST this is decided by the path;
+ * for JSON-RPC the method name is extracted by peeking at the start of the
+ * request body (without draining it — the handler reads it again later).
+ * Misclassification is harmless: it only selects which worker pool and
+ * admission limit the request is subject to.
+ */
+static bool IsHeavyRequest(struct evhttp_request* req, const std::string& uri)
+{
+    // Full-block REST queries are always heavy.
+    if (uri.compare(0, 12, "/rest/block/") == 0) return true;
+
+    struct evbuffer* buf = evhttp_request_get_input_buffer(req);
+    if (!buf) return false;
+    const size_t peek_size{std::min(evbuffer_get_length(buf), MAX_METHOD_PEEK_SIZE)};
+    if (peek_size == 0) return false;
+    const char* data{reinterpret_cast<const char*>(evbuffer_pullup(buf, peek_size))};
+    if (!data) return false;
+    const std::string body{data, peek_size};
+
+    const size_t first{body.find_first_not_of(" \t\r\n")};
+    if (first == std::string::npos) return false;
+    // Batch requests may contain any number of arbitrary calls; treat them
+    // as heavy so they cannot crowd out single cheap calls.
+    if (body[first] == '[') return true;
+
+    // Single call: pick the method name out of the body without parsing it.
+    size_t pos{body.find("\"method\"")};
+    if (pos == std::string::npos) return false;
+    pos = body.find_first_not_of(" \t\r\n", pos + 8);
+    if (pos == std::string::npos || body[pos] != ':') return false;
+    pos = body.find('"', pos + 1);
+    if (pos == std::string::npos) return false;
+    const size_t end{body.find('"', pos + 1)};
+    if (end == std::string::npos) return false;
+    return g_heavy_rpc_methods.count(body.substr(pos + 1, end - pos - 1)) > 0;
+}
+
 /** HTTP request callback */
 static void http_request_cb(struct evhttp_request* req, void* arg)
 {
@@ -220,7 +277,7 @@ static void http_request_cb(struct evhttp_request* req, void* arg)
             }
         }
     }
-    std::unique_ptr<HTTPRequest> hreq(new HTTPRequest(req));
+    std::shared_ptr<HTTPRequest> hreq{std::make_shared<HTTPRequest>(req)};
 
     // Early address-based allow check
     if (!ClientAllowed(hreq->GetPeer())) {
@@ -262,8 +319,9 @@ static void http_request_cb(struct evhttp_request* req, void* arg)
     // Dispatch to worker thread
     if (i != iend) {
         std::unique_ptr<HTTPWorkItem> item(new HTTPWorkItem(std::move(hreq), path, i->handler));
-        assert(g_work_queue);
-        if (g_work_queue->Enqueue(item.get())) {
+        WorkQueue<HTTPClosure>* work_queue{IsHeavyRequest(req, strURI) ? g_work_queue_heavy.get() : g_work_queue.get()};
+        assert(work_queue);
+        if (work_queue->Enqueue(item.get())) {
             item.release(); /* if true, queue took ownership */
         } else {
             LogPrintf("WARNING: request rejected because http work queue depth exceeded, it can be increased with the -rpcworkqueue= setting\n");
@@ -405,6 +463,9 @@ bool InitHTTPServer()
     LogPrintfCategory(BCLog::HTTP, "creating work queue of depth %d\n", workQueueDepth);
 
     g_work_queue = std::make_unique<WorkQueue<HTTPClosure>>(workQueueDepth);
+    // The heavy queue has its own admission limit, so heavyweight requests
+    // can neither exhaust the main queue nor be starved by it.
+    g_work_queue_heavy = std::make_unique<WorkQueue<HTTPClosure>>(workQueueDepth);
     // transfer ownership to eventBase/HTTP via .release()
     eventBase = base_ctr.release();
     eventHTTP = http_ctr.release();
@@ -426,12 +487,16 @@ void StartHTTPServer()
 {
     LogPrint(BCLog::HTTP, "Starting HTTP server\n");
     int rpcThreads = std::max((long)gArgs.GetIntArg("-rpcthreads", DEFAULT_HTTP_THREADS), 1L);
-    LogPrintfCategory(BCLog::HTTP, "starting %d worker threads\n", rpcThreads);
+    int rpcHeavyThreads = std::max((long)gArgs.GetIntArg("-rpcheavythreads", DEFAULT_HTTP_HEAVY_THREADS), 1L);
+    LogPrintfCategory(BCLog::HTTP, "starting %d worker threads (+%d for heavyweight requests)\n", rpcThreads, rpcHeavyThreads);
     g_thread_http = std::thread(ThreadHTTP, eventBase);
 
     for (int i = 0; i < rpcThreads; i++) {
         g_thread_http_workers.emplace_back(HTTPWorkQueueRun, g_work_queue.get(), i);
     }
+    for (int i = 0; i < rpcHeavyThreads; i++) {
+        g_thread_http_workers.emplace_back(HTTPWorkQueueRun, g_work_queue_heavy.get(), rpcThreads + i);
+    }
 }
 
 void InterruptHTTPServer()
@@ -444,6 +509,9 @@ void InterruptHTTPServer()
     if (g_work_queue) {
         g_work_queue->Interrupt();
     }
+    if (g_work_queue_heavy) {
+        g_work_queue_heavy->Interrupt();
+    }
 }
 
 void StopHTTPServer()
@@ -475,6 +543,7 @@ void StopHTTPServer()
         eventBase = nullptr;
     }
     g_work_queue.reset();
+    g_work_queue_heavy.reset();
     LogPrint(BCLog::HTTP, "Stopped HTTP server\n");
 }
 
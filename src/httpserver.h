@@ -6,10 +6,12 @@
 #define CORAL_HTTPSERVER_H
 
 #include <functional>
+#include <memory>
 #include <optional>
 #include <string>
 
 static const int DEFAULT_HTTP_THREADS=4;
+static const int DEFAULT_HTTP_HEAVY_THREADS=1;
 static const int DEFAULT_HTTP_WORKQUEUE=16;
 static const int DEFAULT_HTTP_SERVER_TIMEOUT=30;
 
@@ -52,8 +54,14 @@ struct event_base* EventBase();
 
 /** In-flight HTTP request.
  * Thin C++ wrapper around evhttp_request.
+ *
+ * Requests dispatched through the work queue are owned by a shared_ptr, so a
+ * handler may keep the request alive past its own return (via
+ * shared_from_this()) and deliver the reply later from another thread. If the
+ * last reference is dropped without a reply having been written, an internal
+ * server error is sent.
  */
-class HTTPRequest
+class HTTPRequest : public std::enable_shared_from_this<HTTPRequest>
 {
 private:
     struct evhttp_request* req;
@@ -3,6 +3,7 @@
 // file COPYING or http://www.opensource.org/licenses/mit-license.php.
 
 #include <chainparams.h>
+#include <diskio.h>
 #include <index/base.h>
 #include <interfaces/chain.h>
 #include <kernel/chain.h>
@@ -18,7 +19,12 @@
 #include <validation.h> // For g_chainman
 #include <warnings.h>
 
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <map>
 #include <string>
+#include <thread>
 #include <utility>
 
 using node::ReadBlockFromDisk;
@@ -28,6 +34,225 @@ constexpr uint8_t DB_BEST_BLOCK{'B'};
 constexpr auto SYNC_LOG_INTERVAL{30s};
 constexpr auto SYNC_LOCATOR_WRITE_INTERVAL{30s};
 
+//! Number of blocks the initial sync reader threads keep decoded ahead of the
+//! index writer. Bounds prefetch memory to roughly this many full blocks.
+constexpr size_t SYNC_LOOKAHEAD_BLOCKS{32};
+
+//! Number of decoded blocks the shared cache retains. Sized to cover the
+//! spread between concurrently syncing indexes' look-ahead windows.
+constexpr size_t SHARED_BLOCK_CACHE_BLOCKS{64};
+
+namespace {
+
+/**
+ * Cache of recently decoded blocks shared by the sync readers of all active
+ * indexes. When txindex, blockfilterindex and coinstatsindex rebuild at the
+ * same time they sync over the same blocks; the cache ensures each block is
+ * read and deserialized from disk once and handed to every index, instead of
+ * once per index. Reads are single-flight: the first thread to ask for a
+ * block performs the disk read while later askers wait for its result.
+ * Entries are evicted oldest-first, and the cache empties itself once the
+ * last reader pool unregisters.
+ */
+class SharedBlockCache
+{
+public:
+    void AddUser() EXCLUSIVE_LOCKS_REQUIRED(!m_mutex)
+    {
+        LOCK(m_mutex);
+        ++m_users;
+    }
+
+    void RemoveUser() EXCLUSIVE_LOCKS_REQUIRED(!m_mutex)
+    {
+        LOCK(m_mutex);
+        if (--m_users == 0) {
+            m_blocks.clear();
+            m_order.clear();
+        }
+    }
+
+    //! Get the decoded block for pindex, reading it from disk if no other
+    //! index's reader got there first. Returns null if the read failed.
+    std::shared_ptr<const CBlock> GetOrRead(const CBlockIndex* pindex, const Consensus::Params& consensus_params) EXCLUSIVE_LOCKS_REQUIRED(!m_mutex)
+    {
+        {
+            WAIT_LOCK(m_mutex, lock);
+            if (!m_blocks.try_emplace(pindex).second) {
+                // Another thread has read (or is reading) this block.
+                bool found{true};
+                std::shared_ptr<const CBlock> block;
+                m_cv.wait(lock, [&]() EXCLUSIVE_LOCKS_REQUIRED(m_mutex) {
+                    auto it = m_blocks.find(pindex);
+                    if (it == m_blocks.end()) {
+                        // Evicted after completion; fall back to a fresh read.
+                        found = false;
+                        return true;
+                    }
+                    if (!it->second.m_done) return false;
+                    block = it->second.m_block;
+                    return true;
+                });
+                if (found) return block;
+            } else {
+                m_order.push_back(pindex);
+                // Evict the oldest completed entries beyond capacity. Pending
+                // entries are kept so their readers have somewhere to publish.
+                while (m_blocks.size() > SHARED_BLOCK_CACHE_BLOCKS && !m_order.empty()) {
+                    auto it = m_blocks.find(m_order.front());
+                    if (it != m_blocks.end()) {
+                        if (!it->second.m_done) break;
+                        m_blocks.erase(it);
+                    }
+                    m_order.pop_front();
+                }
+            }
+        }
+
+        auto block{std::make_shared<CBlock>()};
+        std::shared_ptr<const CBlock> result;
+        if (ReadBlockFromDisk(*block, pindex, consensus_params)) {
+            result = std::move(block);
+        }
+        {
+            LOCK(m_mutex);
+            auto it = m_blocks.find(pindex);
+            if (it != m_blocks.end()) {
+                it->second.m_block = result;
+                it->second.m_done = true;
+            }
+        }
+        m_cv.notify_all();
+        return result;
+    }
+
+private:
+    struct Entry {
+        bool m_done{false};
+        std::shared_ptr<const CBlock> m_block;
+    };
+
+    Mutex m_mutex;
+    std::condition_variable m_cv;
+    std::map<const CBlockIndex*, Entry> m_blocks GUARDED_BY(m_mutex);
+    std::deque<const CBlockIndex*> m_order GUARDED_BY(m_mutex);
+    int m_users GUARDED_BY(m_mutex){0};
+};
+
+SharedBlockCache g_shared_block_cache;
+
+/**
+ * Pool of reader threads that decode blocks from disk ahead of the initial
+ * index sync. ThreadSync remains the only writer and consumes the blocks
+ * strictly in chain order, so index entries are still appended and
+ * checkpointed exactly as in the sequential sync; only the expensive
+ * read-and-deserialize step runs in parallel. Reads go through the shared
+ * block cache, so indexes syncing concurrently share one pass over the
+ * block files.
+ */
+class BlockReadPool
+{
+public:
+    BlockReadPool(const Consensus::Params& consensus_params, int num_threads)
+        : m_consensus_params{consensus_params}
+    {
+        g_shared_block_cache.AddUser();
+        for (int i = 0; i < num_threads; ++i) {
+            m_threads.emplace_back([this] { ThreadRead(); });
+        }
+    }
+
+    ~BlockReadPool()
+    {
+        WITH_LOCK(m_mutex, m_stop = true);
+        m_cv.notify_all();
+        for (auto& thread : m_threads) thread.join();
+        g_shared_block_cache.RemoveUser();
+    }
+
+    //! Queue pindex for background reading. A no-op if the look-ahead window
+    //! is full or the block is already scheduled; the caller simply retries
+    //! on its next pass.
+    void Schedule(const CBlockIndex* pindex) EXCLUSIVE_LOCKS_REQUIRED(!m_mutex)
+    {
+        LOCK(m_mutex);
+        if (m_entries.size() >= SYNC_LOOKAHEAD_BLOCKS) return;
+        if (!m_entries.try_emplace(pindex).second) return;
+        m_queue.push_back(pindex);
+        m_cv.notify_one();
+    }
+
+    //! Get the block for pindex, waiting for the background read if one is
+    //! scheduled and reading synchronously otherwise (e.g. right after the
+    //! window was reset by a reorg). Returns null if the read failed.
+    std::shared_ptr<const CBlock> Read(const CBlockIndex* pindex) EXCLUSIVE_LOCKS_REQUIRED(!m_mutex)
+    {
+        {
+            WAIT_LOCK(m_mutex, lock);
+            auto it = m_entries.find(pindex);
+            if (it != m_entries.end()) {
+                m_cv.wait(lock, [&]() EXCLUSIVE_LOCKS_REQUIRED(m_mutex) { return it->second.m_done; });
+                std::shared_ptr<const CBlock> block{std::move(it->second.m_block)};
+                m_entries.erase(it);
+                return block;
+            }
+        }
+        return g_shared_block_cache.GetOrRead(pindex, m_consensus_params);
+    }
+
+    //! Drop all scheduled reads, e.g. after a reorg made the look-ahead
+    //! window point at a stale branch. In-flight reads complete but their
+    //! results are discarded.
+    void Reset() EXCLUSIVE_LOCKS_REQUIRED(!m_mutex)
+    {
+        LOCK(m_mutex);
+        m_queue.clear();
+        m_entries.clear();
+    }
+
+private:
+    struct Entry {
+        bool m_done{false};
+        std::shared_ptr<const CBlock> m_block;
+    };
+
+    void ThreadRead() EXCLUSIVE_LOCKS_REQUIRED(!m_mutex)
+    {
+        while (true) {
+            const CBlockIndex* pindex;
+            {
+                WAIT_LOCK(m_mutex, lock);
+                m_cv.wait(lock, [this]() EXCLUSIVE_LOCKS_REQUIRED(m_mutex) { return m_stop || !m_queue.empty(); });
+                if (m_stop) return;
+                pindex = m_queue.front();
+                m_queue.pop_front();
+            }
+            std::shared_ptr<const CBlock> block{g_shared_block_cache.GetOrRead(pindex, m_consensus_params)};
+            {
+                LOCK(m_mutex);
+                auto it = m_entries.find(pindex);
+                // The entry may have been dropped by Reset() while the read
+                // was in flight; discard the result in that case.
+                if (it != m_entries.end()) {
+                    it->second.m_block = std::move(block);
+                    it->second.m_done = true;
+                }
+            }
+            m_cv.notify_all();
+        }
+    }
+
+    const Consensus::Params& m_consensus_params;
+    Mutex m_mutex;
+    std::condition_variable m_cv;
+    std::deque<const CBlockIndex*> m_queue GUARDED_BY(m_mutex);
+    std::map<const CBlockIndex*, Entry> m_entries GUARDED_BY(m_mutex);
+    bool m_stop GUARDED_BY(m_mutex){false};
+    std::vector<std::thread> m_threads;
+};
+
+} // namespace
+
 template <typename... Args>
 static void FatalError(const char* fmt, const Args&... args)
 {
@@ -153,6 +378,10 @@ void BaseIndex::ThreadSync()
     if (!m_synced) {
         auto& consensus_params = Params().GetConsensus();
 
+        // Reader threads decode blocks ahead of this loop; this thread stays
+        // the single writer so blocks are appended to the index in order.
+        BlockReadPool read_pool{consensus_params, std::clamp(GetNumCores() - 1, 1, 4)};
+
         std::chrono::steady_clock::time_point last_log_time{0s};
         std::chrono::steady_clock::time_point last_locator_write_time{0s};
         while (true) {
@@ -175,14 +404,31 @@ void BaseIndex::ThreadSync()
                     Commit();
                     break;
                 }
-                if (pindex_next->pprev != pindex && !Rewind(pindex, pindex_next->pprev)) {
-                    FatalError("%s: Failed to rewind index %s to a previous chain tip",
-                               __func__, GetName());
-                    return;
+                if (pindex_next->pprev != pindex) {
+                    // The look-ahead window was filled from the old branch.
+                    read_pool.Reset();
+                    if (!Rewind(pindex, pindex_next->pprev)) {
+                        FatalError("%s: Failed to rewind index %s to a previous chain tip",
+                                   __func__, GetName());
+                        return;
+                    }
                 }
                 pindex = pindex_next;
+                // Top up the look-ahead window with the blocks following this
+                // one; Schedule is a no-op for blocks already in the window.
+                const CBlockIndex* pindex_ahead{pindex};
+                for (size_t i = 0; i < SYNC_LOOKAHEAD_BLOCKS && pindex_ahead; ++i) {
+                    read_pool.Schedule(pindex_ahead);
+                    pindex_ahead = m_chainstate->m_chain.Next(pindex_ahead);
+                }
             }
 
+            // Yield the disk to validation-critical writes (block file
+            // appends and coins flushes), so syncing an index during IBD
+            // does not halve the block download rate. The wait is bounded
+            // and released early at shutdown (see diskio.h).
+            diskio::Throttle(diskio::Priority::INDEX);
+
             auto current_time{std::chrono::steady_clock::now()};
             if (last_log_time + SYNC_LOG_INTERVAL < current_time) {
                 LogPrintf("Syncing %s with block chain from height %d\n",
@@ -197,14 +443,14 @@ void BaseIndex::ThreadSync()
                 Commit();
             }
 
-            CBlock block;
             interfaces::BlockInfo block_info = kernel::MakeBlockInfo(pindex);
-            if (!ReadBlockFromDisk(block, pindex, consensus_params)) {
+            const std::shared_ptr<const CBlock> block{read_pool.Read(pindex)};
+            if (!block) {
                 FatalError("%s: Failed to read block %s from disk",
                            __func__, pindex->GetBlockHash().ToString());
                 return;
             } else {
-                block_info.data = &block;
+                block_info.data = block.get();
             }
             if (!CustomAppend(block_info)) {
                 FatalError("%s: Failed to write block %s to index database",
@@ -264,18 +510,13 @@ bool BaseIndex::Rewind(const CBlockIndex* current_tip, const CBlockIndex* new_ti
     return true;
 }
 
-void BaseIndex::BlockConnected(const std::shared_ptr<const CBlock>& block, const CBlockIndex* pindex)
+bool BaseIndex::ProcessConnectedBlock(const std::shared_ptr<const CBlock>& block, const CBlockIndex* pindex, const CBlockIndex* best_block_index)
 {
-    if (!m_synced) {
-        return;
-    }
-
-    const CBlockIndex* best_block_index = m_best_block_index.load();
     if (!best_block_index) {
         if (pindex->nHeight != 0) {
             FatalError("%s: First block connected is not the genesis block (height=%d)",
                        __func__, pindex->nHeight);
-            return;
+            return false;
         }
     } else {
         // Ensure block connects to an ancestor of the current best block. This should be the case
@@ -288,26 +529,60 @@ void BaseIndex::BlockConnected(const std::shared_ptr<const CBlock>& block, const
                       "known best chain (tip=%s); not updating index\n",
                       __func__, pindex->GetBlockHash().ToString(),
                       best_block_index->GetBlockHash().ToString());
-            return;
+            return false;
         }
         if (best_block_index != pindex->pprev && !Rewind(best_block_index, pindex->pprev)) {
             FatalError("%s: Failed to rewind index %s to a previous chain tip",
                        __func__, GetName());
-            return;
+            return false;
         }
     }
     interfaces::BlockInfo block_info = kernel::MakeBlockInfo(pindex, block.get());
-    if (CustomAppend(block_info)) {
+    if (!CustomAppend(block_info)) {
+        FatalError("%s: Failed to write block %s to index",
+                   __func__, pindex->GetBlockHash().ToString());
+        return false;
+    }
+    return true;
+}
+
+void BaseIndex::BlockConnected(const std::shared_ptr<const CBlock>& block, const CBlockIndex* pindex)
+{
+    if (!m_synced) {
+        return;
+    }
+
+    if (ProcessConnectedBlock(block, pindex, m_best_block_index.load())) {
         // Setting the best block index is intentionally the last step of this
         // function, so BlockUntilSyncedToCurrentChain callers waiting for the
         // best block index to be updated can rely on the block being fully
         // processed, and the index object being safe to delete.
         SetBestBlockIndex(pindex);
-    } else {
-        FatalError("%s: Failed to write block %s to index",
-                   __func__, pindex->GetBlockHash().ToString());
+    }
+}
+
+void BaseIndex::BlocksConnected(const std::vector<ConnectedBlock>& blocks)
+{
+    if (!m_synced) {
         return;
     }
+
+    // Append every block in the batch before advancing the best block index,
+    // so the prune lock and best-block position are updated once per batch
+    // rather than once per block. A Rewind can only be needed for the first
+    // block; the rest of the batch extends it by construction. As in
+    // BlockConnected, setting the best block index is intentionally the last
+    // step (see rationale there).
+    const CBlockIndex* best_block_index = m_best_block_index.load();
+    const CBlockIndex* appended{nullptr};
+    for (const ConnectedBlock& connected : blocks) {
+        if (!ProcessConnectedBlock(connected.block, connected.pindex, best_block_index)) break;
+        best_block_index = connected.pindex;
+        appended = connected.pindex;
+    }
+    if (appended) {
+        SetBestBlockIndex(appended);
+    }
 }
 
 void BaseIndex::ChainStateFlushed(const CBlockLocator& locator)
@@ -92,6 +92,12 @@ private:
     /// Loop over disconnected blocks and call CustomRewind.
     bool Rewind(const CBlockIndex* current_tip, const CBlockIndex* new_tip);
 
+    /// Append one connected block to the index, rewinding first if it does not
+    /// extend best_block_index (the index position the caller is advancing
+    /// from). Returns true if the block was appended and the caller may treat
+    /// it as the new index position; failures are already reported.
+    bool ProcessConnectedBlock(const std::shared_ptr<const CBlock>& block, const CBlockIndex* pindex, const CBlockIndex* best_block_index);
+
     virtual bool AllowPrune() const = 0;
 
 protected:
@@ -101,6 +107,8 @@ protected:
 
     void BlockConnected(const std::shared_ptr<const CBlock>& block, const CBlockIndex* pindex) override;
 
+    void BlocksConnected(const std::vector<ConnectedBlock>& blocks) override;
+
     void ChainStateFlushed(const CBlockLocator& locator) override;
 
     /// Initialize internal state from the database and block index.
@@ -2,6 +2,7 @@
 // Distributed under the MIT software license, see the accompanying
 // file COPYING or http://www.opensource.org/licenses/mit-license.php.
 
+#include <cstdio>
 #include <map>
 
 #include <dbwrapper.h>
@@ -145,13 +146,10 @@ bool BlockFilterIndex::CustomCommit(CDBBatch& batch)
     return true;
 }
 
-bool BlockFilterIndex::ReadFilterFromDisk(const FlatFilePos& pos, const uint256& hash, BlockFilter& filter) const
+//! Read and verify a single filter from an open filter file positioned at the
+//! filter's start.
+static bool ReadFilter(AutoFile& filein, const uint256& hash, BlockFilterType filter_type, BlockFilter& filter)
 {
-    AutoFile filein{m_filter_fileseq->Open(pos, true)};
-    if (filein.IsNull()) {
-        return false;
-    }
-
     // Check that the hash of the encoded_filter matches the one stored in the db.
     uint256 block_hash;
     std::vector<uint8_t> encoded_filter;
@@ -160,7 +158,7 @@ bool BlockFilterIndex::ReadFilterFromDisk(const FlatFilePos& pos, const uint256&
         uint256 result;
         CHash256().Write(encoded_filter).Finalize(result);
         if (result != hash) return error("Checksum mismatch in filter decode.");
-        filter = BlockFilter(GetFilterType(), block_hash, std::move(encoded_filter), /*skip_decode_check=*/true);
+        filter = BlockFilter(filter_type, block_hash, std::move(encoded_filter), /*skip_decode_check=*/true);
     }
     catch (const std::exception& e) {
         return error("%s: Failed to deserialize block filter from disk: %s", __func__, e.what());
@@ -169,6 +167,16 @@ bool BlockFilterIndex::ReadFilterFromDisk(const FlatFilePos& pos, const uint256&
     return true;
 }
 
+bool BlockFilterIndex::ReadFilterFromDisk(const FlatFilePos& pos, const uint256& hash, BlockFilter& filter) const
+{
+    AutoFile filein{m_filter_fileseq->Open(pos, true)};
+    if (filein.IsNull()) {
+        return false;
+    }
+
+    return ReadFilter(filein, hash, GetFilterType(), filter);
+}
+
 size_t BlockFilterIndex::WriteFilterToDisk(FlatFilePos& pos, const BlockFilter& filter)
 {
     assert(filter.GetFilterType() == GetFilterType());
@@ -430,12 +438,26 @@ bool BlockFilterIndex::LookupFilterRange(int start_height, const CBlockIndex* st
     }
 
     filters_out.resize(entries.size());
-    auto filter_pos_it = filters_out.begin();
-    for (const auto& entry : entries) {
-        if (!ReadFilterFromDisk(entry.pos, entry.hash, *filter_pos_it)) {
+
+    // Open each flat file once for the whole range rather than once per
+    // filter. Entries are stored in height order, so reads within a file are
+    // sequential and the seeks are no-ops on all but the first filter of a
+    // file.
+    size_t i{0};
+    while (i < entries.size()) {
+        const int file_num{entries[i].pos.nFile};
+        AutoFile filein{m_filter_fileseq->Open(entries[i].pos, true)};
+        if (filein.IsNull()) {
             return false;
         }
-        ++filter_pos_it;
+        for (; i < entries.size() && entries[i].pos.nFile == file_num; ++i) {
+            if (std::fseek(filein.Get(), entries[i].pos.nPos, SEEK_SET) != 0) {
+                return false;
+            }
+            if (!ReadFilter(filein, entries[i].hash, GetFilterType(), filters_out[i])) {
+                return false;
+            }
+        }
     }
 
     return true;
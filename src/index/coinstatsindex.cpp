@@ -14,6 +14,9 @@
 #include <util/system.h>
 #include <validation.h>
 
+#include <algorithm>
+#include <thread>
+
 using kernel::CCoinsStats;
 using kernel::GetBogoSize;
 using kernel::TxOutSer;
@@ -100,6 +103,46 @@ struct DBHashKey {
     }
 };
 
+//! Minimum number of coin hashes per additional MuHash worker thread.
+constexpr size_t MUHASH_COINS_PER_THREAD{256};
+
+/** Fold the given serialized coins into muhash. MuHash is commutative, so for
+ *  blocks with many coins the expensive per-coin group multiplications are
+ *  spread over worker threads with private accumulators that are combined via
+ *  the group operation at the end; the result is identical to applying every
+ *  coin serially. */
+void ApplyCoinHashes(MuHash3072& muhash, const std::vector<CDataStream>& inserts, const std::vector<CDataStream>& removes)
+{
+    const size_t n_coins{inserts.size() + removes.size()};
+    const size_t n_threads{std::clamp<size_t>(n_coins / MUHASH_COINS_PER_THREAD, 1, 4)};
+
+    if (n_threads == 1) {
+        for (const auto& coin : inserts) muhash.Insert(MakeUCharSpan(coin));
+        for (const auto& coin : removes) muhash.Remove(MakeUCharSpan(coin));
+        return;
+    }
+
+    std::vector<MuHash3072> accumulators(n_threads);
+    std::vector<std::thread> threads;
+    threads.reserve(n_threads);
+    for (size_t t = 0; t < n_threads; ++t) {
+        threads.emplace_back([&, t] {
+            // Thread t takes every n_threads-th coin.
+            for (size_t i = t; i < inserts.size(); i += n_threads) {
+                accumulators[t].Insert(MakeUCharSpan(inserts[i]));
+            }
+            for (size_t i = t; i < removes.size(); i += n_threads) {
+                accumulators[t].Remove(MakeUCharSpan(removes[i]));
+            }
+        });
+    }
+    for (auto& thread : threads) thread.join();
+
+    for (const auto& accumulator : accumulators) {
+        muhash *= accumulator;
+    }
+}
+
 }; // namespace
 
 std::unique_ptr<CoinStatsIndex> g_coin_stats_index;
@@ -148,6 +191,11 @@ bool CoinStatsIndex::CustomAppend(const interfaces::BlockInfo& block)
         bool is_bip30_block{(block.height == 91722 && block.hash == uint256S("0x00000000000271a2dc26e7667f8419f2e15416dc6955e5a6c6cdf3f2574dd08e")) ||
                             (block.height == 91812 && block.hash == uint256S("0x00000000000af0aed4792b1acee3d966af36cf5def14935db8de83d6f9306f2f"))};
 
+        // Serialized coins to fold into the muhash once the whole block has
+        // been walked, so the group multiplications can run in parallel.
+        std::vector<CDataStream> muhash_inserts;
+        std::vector<CDataStream> muhash_removes;
+
         // Add the new utxos created from the block
         assert(block.data);
         for (size_t i = 0; i < block.data->vtx.size(); ++i) {
@@ -172,7 +220,7 @@ bool CoinStatsIndex::CustomAppend(const interfaces::BlockInfo& block)
                     continue;
                 }
 
-                m_muhash.Insert(MakeUCharSpan(TxOutSer(outpoint, coin)));
+                muhash_inserts.push_back(TxOutSer(outpoint, coin));
 
                 if (tx->IsCoinBase()) {
                     m_total_coinbase_amount += coin.out.nValue;
@@ -193,7 +241,7 @@ bool CoinStatsIndex::CustomAppend(const interfaces::BlockInfo& block)
                     Coin coin{tx_undo.vprevout[j]};
                     COutPoint outpoint{tx->vin[j].prevout.hash, tx->vin[j].prevout.n};
 
-                    m_muhash.Remove(MakeUCharSpan(TxOutSer(outpoint, coin)));
+                    muhash_removes.push_back(TxOutSer(outpoint, coin));
 
                     m_total_prevout_spent_amount += coin.out.nValue;
 
@@ -203,6 +251,8 @@ bool CoinStatsIndex::CustomAppend(const interfaces::BlockInfo& block)
                 }
             }
         }
+
+        ApplyCoinHashes(m_muhash, muhash_inserts, muhash_removes);
     } else {
         // genesis block
         m_total_unspendable_amount += block_subsidy;
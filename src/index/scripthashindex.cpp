@@ -0,0 +1,192 @@
+// Copyright (c) 2017-2021 The Coral Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <index/scripthashindex.h>
+
+#include <chainparams.h>
+#include <crypto/sha256.h>
+#include <dbwrapper.h>
+#include <node/blockstorage.h>
+#include <undo.h>
+#include <util/system.h>
+#include <validation.h>
+
+using node::UndoReadFromDisk;
+
+/* The index database stores one entry per confirmed history event, keyed by
+ * [DB_SCRIPTHASH, scripthash, uint32 height (BE), txid, uint32 index, spending
+ * flag] with the output value as the entry's payload. Entries for one script
+ * hash are therefore contiguous and height-ordered, so a history lookup is a
+ * single seek followed by a sequential scan. Each block additionally records
+ * the list of keys it touched under [DB_BLOCK_KEYS, uint32 height (BE)], which
+ * lets a reorg erase exactly the disconnected blocks' entries.
+ */
+constexpr uint8_t DB_SCRIPTHASH{'h'};
+constexpr uint8_t DB_BLOCK_KEYS{'b'};
+
+std::unique_ptr<ScriptHashIndex> g_scripthash_index;
+
+namespace {
+
+struct DBHistoryKey {
+    uint256 scripthash;
+    uint32_t height{0};
+    uint256 txid;
+    uint32_t index{0};
+    bool spending{false};
+
+    template <typename Stream>
+    void Serialize(Stream& s) const
+    {
+        ser_writedata8(s, DB_SCRIPTHASH);
+        s << scripthash;
+        ser_writedata32be(s, height);
+        s << txid;
+        ser_writedata32be(s, index);
+        ser_writedata8(s, spending ? 1 : 0);
+    }
+
+    template <typename Stream>
+    void Unserialize(Stream& s)
+    {
+        const uint8_t prefix{ser_readdata8(s)};
+        if (prefix != DB_SCRIPTHASH) {
+            throw std::ios_base::failure("Invalid format for scripthash index DB history key");
+        }
+        s >> scripthash;
+        height = ser_readdata32be(s);
+        s >> txid;
+        index = ser_readdata32be(s);
+        spending = ser_readdata8(s) != 0;
+    }
+};
+
+//! Seek target covering every history key of one script hash.
+struct DBHistoryPrefix {
+    uint256 scripthash;
+
+    template <typename Stream>
+    void Serialize(Stream& s) const
+    {
+        ser_writedata8(s, DB_SCRIPTHASH);
+        s << scripthash;
+    }
+};
+
+struct DBBlockKeysKey {
+    int height;
+
+    explicit DBBlockKeysKey(int height_in) : height(height_in) {}
+
+    template <typename Stream>
+    void Serialize(Stream& s) const
+    {
+        ser_writedata8(s, DB_BLOCK_KEYS);
+        ser_writedata32be(s, height);
+    }
+
+    template <typename Stream>
+    void Unserialize(Stream& s)
+    {
+        const uint8_t prefix{ser_readdata8(s)};
+        if (prefix != DB_BLOCK_KEYS) {
+            throw std::ios_base::failure("Invalid format for scripthash index DB block keys key");
+        }
+        height = ser_readdata32be(s);
+    }
+};
+
+struct DBHistoryValue {
+    CAmount amount{0};
+
+    SERIALIZE_METHODS(DBHistoryValue, obj) { READWRITE(obj.amount); }
+};
+
+} // namespace
+
+ScriptHashIndex::ScriptHashIndex(std::unique_ptr<interfaces::Chain> chain, size_t n_cache_size, bool f_memory, bool f_wipe)
+    : BaseIndex(std::move(chain), "scripthashindex")
+{
+    fs::path path{gArgs.GetDataDirNet() / "indexes" / "scripthash"};
+    fs::create_directories(path);
+
+    m_db = std::make_unique<BaseIndex::DB>(path / "db", n_cache_size, f_memory, f_wipe);
+}
+
+ScriptHashIndex::~ScriptHashIndex() = default;
+
+uint256 ScriptHashIndex::HashScript(const CScript& script)
+{
+    uint256 hash;
+    CSHA256().Write(script.data(), script.size()).Finalize(hash.begin());
+    return hash;
+}
+
+bool ScriptHashIndex::CustomAppend(const interfaces::BlockInfo& block)
+{
+    // Exclude genesis block transaction because outputs are not spendable.
+    if (block.height == 0) return true;
+
+    assert(block.data);
+    CBlockUndo block_undo;
+    const CBlockIndex* pindex = WITH_LOCK(cs_main, return m_chainstate->m_blockman.LookupBlockIndex(block.hash));
+    if (!UndoReadFromDisk(block_undo, pindex)) {
+        return false;
+    }
+
+    CDBBatch batch(*m_db);
+    std::vector<DBHistoryKey> block_keys;
+    for (size_t i = 0; i < block.data->vtx.size(); ++i) {
+        const CTransaction& tx{*block.data->vtx[i]};
+        const uint256 txid{tx.GetHash()};
+        for (uint32_t n = 0; n < tx.vout.size(); ++n) {
+            const CTxOut& out{tx.vout[n]};
+            if (out.scriptPubKey.IsUnspendable()) continue;
+            const DBHistoryKey key{HashScript(out.scriptPubKey), static_cast<uint32_t>(block.height), txid, n, /*spending=*/false};
+            batch.Write(key, DBHistoryValue{out.nValue});
+            block_keys.push_back(key);
+        }
+        if (i == 0) continue; // Coinbase inputs create no spend events.
+        const auto& tx_undo{block_undo.vtxundo.at(i - 1)};
+        for (uint32_t in = 0; in < tx.vin.size(); ++in) {
+            const Coin& coin{tx_undo.vprevout.at(in)};
+            const DBHistoryKey key{HashScript(coin.out.scriptPubKey), static_cast<uint32_t>(block.height), txid, in, /*spending=*/true};
+            batch.Write(key, DBHistoryValue{coin.out.nValue});
+            block_keys.push_back(key);
+        }
+    }
+    batch.Write(DBBlockKeysKey(block.height), block_keys);
+    return m_db->WriteBatch(batch);
+}
+
+bool ScriptHashIndex::CustomRewind(const interfaces::BlockKey& current_tip, const interfaces::BlockKey& new_tip)
+{
+    CDBBatch batch(*m_db);
+    for (int height = current_tip.height; height > new_tip.height; --height) {
+        std::vector<DBHistoryKey> block_keys;
+        if (!m_db->Read(DBBlockKeysKey(height), block_keys)) continue;
+        for (const DBHistoryKey& key : block_keys) {
+            batch.Erase(key);
+        }
+        batch.Erase(DBBlockKeysKey(height));
+    }
+    return m_db->WriteBatch(batch);
+}
+
+bool ScriptHashIndex::FindHistory(const uint256& scripthash, std::vector<HistoryEntry>& entries) const
+{
+    std::unique_ptr<CDBIterator> it{m_db->NewIterator()};
+    for (it->Seek(DBHistoryPrefix{scripthash}); it->Valid(); it->Next()) {
+        DBHistoryKey key;
+        // A key with a different prefix byte fails to unserialize, which ends
+        // the scan at the last history entry in the database.
+        if (!it->GetKey(key) || key.scripthash != scripthash) break;
+        DBHistoryValue value;
+        if (!it->GetValue(value)) {
+            return false;
+        }
+        entries.push_back({key.txid, key.index, static_cast<int>(key.height), key.spending, value.amount});
+    }
+    return true;
+}
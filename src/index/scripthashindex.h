@@ -0,0 +1,66 @@
+// Copyright (c) 2017-2021 The Coral Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef CORAL_INDEX_SCRIPTHASHINDEX_H
+#define CORAL_INDEX_SCRIPTHASHINDEX_H
+
+#include <consensus/amount.h>
+#include <index/base.h>
+
+#include <memory>
+#include <vector>
+
+class CScript;
+
+/**
+ * ScriptHashIndex maps script hashes to confirmed outpoint history: every
+ * block event that creates or spends an output paying to a script is recorded
+ * under the single-SHA256 hash of that scriptPubKey. This serves explorer
+ * style address-history queries (getaddresshistory) directly from the node,
+ * without an external indexer keeping a second copy of the chain.
+ */
+class ScriptHashIndex final : public BaseIndex
+{
+private:
+    std::unique_ptr<BaseIndex::DB> m_db;
+
+    bool AllowPrune() const override { return false; }
+
+protected:
+    bool CustomAppend(const interfaces::BlockInfo& block) override;
+
+    bool CustomRewind(const interfaces::BlockKey& current_tip, const interfaces::BlockKey& new_tip) override;
+
+    BaseIndex::DB& GetDB() const override { return *m_db; }
+
+public:
+    //! One confirmed event in a script's history: an output paying to the
+    //! script being created (funding) or consumed (spend).
+    struct HistoryEntry {
+        uint256 txid;    //!< Transaction creating or spending the output
+        uint32_t index;  //!< Output index (funding) or input index (spend)
+        int height;      //!< Height of the block containing txid
+        bool spending;   //!< Whether this entry consumes the output
+        CAmount amount;  //!< Value of the output created or consumed
+    };
+
+    /// Constructs the index, which becomes available to be queried.
+    explicit ScriptHashIndex(std::unique_ptr<interfaces::Chain> chain, size_t n_cache_size, bool f_memory = false, bool f_wipe = false);
+
+    // Destructor is declared because this class contains a unique_ptr to an incomplete type.
+    virtual ~ScriptHashIndex() override;
+
+    /// The index key for a scriptPubKey: its single SHA256 hash.
+    static uint256 HashScript(const CScript& script);
+
+    /// Look up the confirmed history of a script hash, ordered by block
+    /// height. Returns false only if a database read failed; an unknown
+    /// script hash yields an empty history.
+    bool FindHistory(const uint256& scripthash, std::vector<HistoryEntry>& entries) const;
+};
+
+/// The global scripthash index. May be null.
+extern std::unique_ptr<ScriptHashIndex> g_scripthash_index;
+
+#endif // CORAL_INDEX_SCRIPTHASHINDEX_H
@@ -6,9 +6,14 @@
 
 #include <index/disktxpos.h>
 #include <node/blockstorage.h>
+#include <txidfilter.h>
 #include <util/system.h>
+#include <util/thread.h>
 #include <validation.h>
 
+#include <algorithm>
+#include <tuple>
+
 using node::OpenBlockFile;
 
 constexpr uint8_t DB_TXINDEX{'t'};
@@ -52,7 +57,11 @@ TxIndex::TxIndex(std::unique_ptr<interfaces::Chain> chain, size_t n_cache_size,
     : BaseIndex(std::move(chain), "txindex"), m_db(std::make_unique<TxIndex::DB>(n_cache_size, f_memory, f_wipe))
 {}
 
-TxIndex::~TxIndex() = default;
+TxIndex::~TxIndex()
+{
+    m_filter_seed_interrupt();
+    if (m_filter_seed_thread.joinable()) m_filter_seed_thread.join();
+}
 
 bool TxIndex::CustomAppend(const interfaces::BlockInfo& block)
 {
@@ -65,11 +74,31 @@ bool TxIndex::CustomAppend(const interfaces::BlockInfo& block)
     vPos.reserve(block.data->vtx.size());
     for (const auto& tx : block.data->vtx) {
         vPos.emplace_back(tx->GetHash(), pos);
+        if (g_txid_filter) g_txid_filter->Add(tx->GetHash());
         pos.nTxOffset += ::GetSerializeSize(*tx, CLIENT_VERSION);
     }
     return m_db->WriteTxs(vPos);
 }
 
+void TxIndex::StartTxidFilterSeed()
+{
+    assert(g_txid_filter);
+    m_filter_seed_thread = std::thread(&util::TraceThread, "txidfilter", [this] {
+        size_t count{0};
+        std::unique_ptr<CDBIterator> iter{m_db->NewIterator()};
+        iter->Seek(std::make_pair(DB_TXINDEX, uint256()));
+        std::pair<uint8_t, uint256> key;
+        while (!m_filter_seed_interrupt && iter->Valid() && iter->GetKey(key) && key.first == DB_TXINDEX) {
+            g_txid_filter->Add(key.second);
+            ++count;
+            iter->Next();
+        }
+        if (m_filter_seed_interrupt) return;
+        g_txid_filter->Activate();
+        LogPrintf("txindex: seeded txid filter with %d entries\n", count);
+    });
+}
+
 BaseIndex::DB& TxIndex::GetDB() const { return *m_db; }
 
 bool TxIndex::FindTx(const uint256& tx_hash, uint256& block_hash, CTransactionRef& tx) const
@@ -99,3 +128,67 @@ bool TxIndex::FindTx(const uint256& tx_hash, uint256& block_hash, CTransactionRe
     block_hash = header.GetHash();
     return true;
 }
+
+bool TxIndex::FindTxs(const std::vector<uint256>& tx_hashes, std::vector<std::optional<std::pair<CTransactionRef, uint256>>>& txs) const
+{
+    txs.assign(tx_hashes.size(), std::nullopt);
+
+    // Resolve all disk positions up front, then read in position order so
+    // that the block files are traversed sequentially.
+    struct Lookup {
+        CDiskTxPos pos;
+        size_t index;
+    };
+    std::vector<Lookup> lookups;
+    lookups.reserve(tx_hashes.size());
+    for (size_t i = 0; i < tx_hashes.size(); ++i) {
+        CDiskTxPos postx;
+        if (m_db->ReadTxPos(tx_hashes[i], postx)) {
+            lookups.push_back({postx, i});
+        }
+    }
+    std::sort(lookups.begin(), lookups.end(), [](const Lookup& a, const Lookup& b) {
+        return std::tie(a.pos.nFile, a.pos.nPos, a.pos.nTxOffset) < std::tie(b.pos.nFile, b.pos.nPos, b.pos.nTxOffset);
+    });
+
+    for (size_t i = 0; i < lookups.size();) {
+        const int file_number{lookups[i].pos.nFile};
+        CAutoFile file(OpenBlockFile(lookups[i].pos, true), SER_DISK, CLIENT_VERSION);
+        if (file.IsNull()) {
+            return error("%s: OpenBlockFile failed", __func__);
+        }
+        // Consecutive hits in the same block share one header read.
+        bool block_read{false};
+        unsigned int block_data_pos{0};
+        uint256 block_hash;
+        long tx_data_offset{0};
+        for (; i < lookups.size() && lookups[i].pos.nFile == file_number; ++i) {
+            const CDiskTxPos& postx = lookups[i].pos;
+            try {
+                if (!block_read || block_data_pos != postx.nPos) {
+                    if (fseek(file.Get(), postx.nPos, SEEK_SET)) {
+                        return error("%s: fseek(...) failed", __func__);
+                    }
+                    CBlockHeader header;
+                    file >> header;
+                    block_hash = header.GetHash();
+                    tx_data_offset = ftell(file.Get());
+                    block_data_pos = postx.nPos;
+                    block_read = true;
+                }
+                if (fseek(file.Get(), tx_data_offset + postx.nTxOffset, SEEK_SET)) {
+                    return error("%s: fseek(...) failed", __func__);
+                }
+                CTransactionRef tx;
+                file >> tx;
+                if (tx->GetHash() != tx_hashes[lookups[i].index]) {
+                    return error("%s: txid mismatch", __func__);
+                }
+                txs[lookups[i].index].emplace(std::move(tx), block_hash);
+            } catch (const std::exception& e) {
+                return error("%s: Deserialize or I/O error - %s", __func__, e.what());
+            }
+        }
+    }
+    return true;
+}
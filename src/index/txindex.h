@@ -7,6 +7,11 @@
 
 #include <index/base.h>
 
+#include <optional>
+#include <thread>
+#include <utility>
+#include <vector>
+
 /**
  * TxIndex is used to look up transactions included in the blockchain by hash.
  * The index is written to a LevelDB database and records the filesystem
@@ -20,6 +25,9 @@ protected:
 private:
     const std::unique_ptr<DB> m_db;
 
+    std::thread m_filter_seed_thread;
+    CThreadInterrupt m_filter_seed_interrupt;
+
     bool AllowPrune() const override { return false; }
 
 protected:
@@ -41,6 +49,26 @@ public:
     /// @param[out]  tx  The transaction itself.
     /// @return  true if transaction is found, false otherwise
     bool FindTx(const uint256& tx_hash, uint256& block_hash, CTransactionRef& tx) const;
+
+    /// Look up a batch of transactions by hash. The disk positions of all
+    /// hits are resolved first and the block files are then visited in
+    /// position order, sharing one file handle per block file, so that bulk
+    /// lookups issue (mostly) sequential reads instead of one random seek per
+    /// transaction.
+    ///
+    /// @param[in]   tx_hashes  The hashes of the transactions to be returned.
+    /// @param[out]  txs  One entry per input hash, in the same order: the
+    ///                   transaction and the hash of the block it was found
+    ///                   in, or nullopt if the hash is not indexed.
+    /// @return  true unless a disk read failed; hashes that are simply not
+    ///          indexed do not cause failure.
+    bool FindTxs(const std::vector<uint256>& tx_hashes, std::vector<std::optional<std::pair<CTransactionRef, uint256>>>& txs) const;
+
+    /// Seed the global txid front filter with every indexed txid on a
+    /// background thread and activate the filter once the scan completes.
+    /// Newly connected blocks are added to the filter as they are indexed, so
+    /// the filter stays complete while the scan runs. Requires g_txid_filter.
+    void StartTxidFilterSeed();
 };
 
 /// The global transaction index, used in GetTransaction. May be null.
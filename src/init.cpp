@@ -20,6 +20,7 @@
 #include <chainparams.h>
 #include <consensus/amount.h>
 #include <deploymentstatus.h>
+#include <diskio.h>
 #include <fs.h>
 #include <hash.h>
 #include <httprpc.h>
@@ -27,6 +28,7 @@
 #include <httpserver.h>
 #include <index/blockfilterindex.h>
 #include <index/coinstatsindex.h>
+#include <index/scripthashindex.h>
 #include <index/txindex.h>
 #include <init/common.h>
 #include <interfaces/chain.h>
@@ -38,6 +40,7 @@
 #include <net_processing.h>
 #include <netbase.h>
 #include <netgroup.h>
+#include <node/blockring.h>
 #include <node/blockstorage.h>
 #include <node/caches.h>
 #include <node/chainstate.h>
@@ -46,6 +49,7 @@
 #include <node/mempool_args.h>
 #include <node/mempool_persist_args.h>
 #include <node/miner.h>
+#include <node/utxo_snapshot.h>
 #include <node/validation_cache_args.h>
 #include <policy/feerate.h>
 #include <policy/fees.h>
@@ -61,12 +65,14 @@
 #include <script/sigcache.h>
 #include <script/standard.h>
 #include <shutdown.h>
+#include <stratum.h>
 #include <sync.h>
 #include <timedata.h>
 #include <torcontrol.h>
 #include <landiscovery.h>
 #include <httpseeds.h>
 #include <txdb.h>
+#include <txidfilter.h>
 #include <txmempool.h>
 #include <txorphanage.h>
 #include <util/asmap.h>
@@ -106,6 +112,7 @@
 #if ENABLE_ZMQ
 #include <zmq/zmqabstractnotifier.h>
 #include <zmq/zmqnotificationinterface.h>
+#include <zmq/zmqpublishnotifier.h>
 #include <zmq/zmqrpc.h>
 #endif
 
@@ -115,6 +122,7 @@ using kernel::ValidationCacheSizes;
 using node::ApplyArgsManOptions;
 using node::CacheSizes;
 using node::CalculateCacheSizes;
+using node::DEFAULT_MEMPOOL_SAVE_INTERVAL;
 using node::DEFAULT_PERSIST_MEMPOOL;
 using node::DEFAULT_PRINTPRIORITY;
 using node::DEFAULT_STOPAFTERBLOCKIMPORT;
@@ -198,10 +206,14 @@ void Interrupt(NodeContext& node)
     InterruptHTTPRPC();
     InterruptRPC();
     InterruptREST();
+    InterruptStratumServer();
     InterruptTorControl();
     InterruptMapPort();
     if (node.connman)
         node.connman->Interrupt();
+    // Release any background I/O waiting behind validation writes, so the
+    // index and rescan threads can notice their own interrupt flags.
+    diskio::Interrupt();
     if (g_txindex) {
         g_txindex->Interrupt();
     }
@@ -209,6 +221,9 @@ void Interrupt(NodeContext& node)
     if (g_coin_stats_index) {
         g_coin_stats_index->Interrupt();
     }
+    if (g_scripthash_index) {
+        g_scripthash_index->Interrupt();
+    }
 }
 
 void Shutdown(NodeContext& node)
@@ -226,6 +241,12 @@ void Shutdown(NodeContext& node)
     util::ThreadRename("shutoff");
     if (node.mempool) node.mempool->AddTransactionsUpdated(1);
 
+    // Stop the internal miner before tearing down anything its workers touch.
+    if (node.internal_miner) {
+        node.internal_miner->Stop();
+        node.internal_miner.reset();
+    }
+
     StopHTTPRPC();
     StopREST();
     StopRPC();
@@ -243,6 +264,7 @@ void Shutdown(NodeContext& node)
     if (node.peerman) UnregisterValidationInterface(node.peerman.get());
     if (node.connman) node.connman->Stop();
 
+    StopStratumServer();
     StopTorControl();
 
     // After everything has been shut down, but before things get flushed, stop the
@@ -261,7 +283,12 @@ void Shutdown(NodeContext& node)
     node.lan_discovery.reset();
 
     if (node.mempool && node.mempool->GetLoadTried() && ShouldPersistMempool(*node.args)) {
-        DumpMempool(*node.mempool, MempoolPath(*node.args));
+        uint256 tip_hash;
+        if (node.chainman) {
+            LOCK(cs_main);
+            if (const CBlockIndex* tip{node.chainman->ActiveChain().Tip()}) tip_hash = tip->GetBlockHash();
+        }
+        DumpMempool(*node.mempool, MempoolPath(*node.args), fsbridge::fopen, /*skip_file_commit=*/false, tip_hash);
     }
 
     // Drop transactions we were still watching, and record fee estimations.
@@ -290,8 +317,14 @@ void Shutdown(NodeContext& node)
         g_coin_stats_index->Stop();
         g_coin_stats_index.reset();
     }
+    if (g_scripthash_index) {
+        g_scripthash_index->Stop();
+        g_scripthash_index.reset();
+    }
     ForEachBlockFilterIndex([](BlockFilterIndex& index) { index.Stop(); });
     DestroyAllBlockFilterIndexes();
+    g_txid_filter.reset();
+    node::g_block_ring.reset();
 
     // Any future callbacks will be dropped. This should absolutely be safe - if
     // missing a callback results in an unrecoverable situation, unclean shutdown
@@ -341,6 +374,10 @@ void Shutdown(NodeContext& node)
     ShutdownRandomX();
 
     LogPrintf("%s: done\n", __func__);
+
+    // Flush and stop the asynchronous log writer, if one was started. Anything
+    // logged after this point is written synchronously.
+    LogInstance().StopAsyncLogging();
 }
 
 /**
@@ -419,33 +456,51 @@ void SetupServerArgs(ArgsManager& argsman)
     argsman.AddArg("-alertnotify=<cmd>", "Execute command when an alert is raised (%s in cmd is replaced by message)", ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
 #endif
     argsman.AddArg("-assumevalid=<hex>", strprintf("If this block is in the chain assume that it and its ancestors are valid and potentially skip their script verification (0 to verify all, default: %s, testnet: %s, signet: %s)", defaultChainParams->GetConsensus().defaultAssumeValid.GetHex(), testnetChainParams->GetConsensus().defaultAssumeValid.GetHex(), signetChainParams->GetConsensus().defaultAssumeValid.GetHex()), ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
+    argsman.AddArg("-asyncactivation", strprintf("Run best-chain activation on a dedicated thread instead of blocking the thread that processed the block, and track its progress via the getchainactivationstatus RPC (default: %u)", DEFAULT_ASYNC_ACTIVATION), ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
+    argsman.AddArg("-blockring=<n>", strprintf("Publish raw connected blocks into a shared-memory ring of <n> MiB at <datadir>/blockring, for zero-copy consumption by co-located services, 0 to disable (default: %d)", node::DEFAULT_BLOCK_RING_MB), ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
     argsman.AddArg("-blocksdir=<dir>", "Specify directory to hold blocks subdirectory for *.dat files (default: <datadir>)", ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
     argsman.AddArg("-fastprune", "Use smaller block files and lower minimum prune height for testing purposes", ArgsManager::ALLOW_ANY | ArgsManager::DEBUG_ONLY, OptionsCategory::DEBUG_TEST);
 #if HAVE_SYSTEM
     argsman.AddArg("-blocknotify=<cmd>", "Execute command when the best block changes (%s in cmd is replaced by block hash)", ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
 #endif
+    argsman.AddArg("-blockfilesize=<n>", strprintf("Maximum size of blk?????.dat files in MiB (1 to 2048, default: %u). Larger files reduce file count and fragmentation on some storage backends.", node::MAX_BLOCKFILE_SIZE >> 20), ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
     argsman.AddArg("-blockreconstructionextratxn=<n>", strprintf("Extra transactions to keep in memory for compact block reconstructions (default: %u)", DEFAULT_BLOCK_RECONSTRUCTION_EXTRA_TXN), ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
     argsman.AddArg("-blocksonly", strprintf("Whether to reject transactions from network peers. Automatic broadcast and rebroadcast of any transactions from inbound peers is disabled, unless the peer has the 'forcerelay' permission. RPC transactions are not affected. (default: %u)", DEFAULT_BLOCKSONLY), ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
     argsman.AddArg("-coinstatsindex", strprintf("Maintain coinstats index used by the gettxoutsetinfo RPC (default: %u)", DEFAULT_COINSTATSINDEX), ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
+    argsman.AddArg("-scripthashindex", strprintf("Maintain an index of confirmed per-script output history, used by the getaddresshistory RPC (default: %u)", DEFAULT_SCRIPTHASHINDEX), ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
+    argsman.AddArg("-coinsretainwindow=<n>", strprintf("Keep unspent outputs created within the last <n> blocks out of periodic chainstate writes; most are spent again quickly and then never touch disk. Crash consistency is maintained through the coins journal. (0 to disable, default: %u)", DEFAULT_COINS_RETAIN_WINDOW), ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
     argsman.AddArg("-conf=<file>", strprintf("Specify path to read-only configuration file. Relative paths will be prefixed by datadir location (only useable from command line, not configuration file) (default: %s)", CORAL_CONF_FILENAME), ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
     argsman.AddArg("-datadir=<dir>", "Specify data directory", ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
     argsman.AddArg("-dbbatchsize", strprintf("Maximum database write batch size in bytes (default: %u)", nDefaultDbBatchSize), ArgsManager::ALLOW_ANY | ArgsManager::DEBUG_ONLY, OptionsCategory::OPTIONS);
+    argsman.AddArg("-dbblockcachepercent=<n>", strprintf("Percentage of the coins database cache budget given to the LevelDB block cache; the write buffer receives half of the remainder (default: %u)", DBParams{}.block_cache_percent), ArgsManager::ALLOW_ANY | ArgsManager::DEBUG_ONLY, OptionsCategory::OPTIONS);
     argsman.AddArg("-dbcache=<n>", strprintf("Maximum database cache size <n> MiB (%d to %d, default: %d). In addition, unused mempool memory is shared for this cache (see -maxmempool).", nMinDbCache, nMaxDbCache, nDefaultDbCache), ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
+    argsman.AddArg("-dbcompression", strprintf("Compress coins database sstables with Snappy (default: %u)", DBParams{}.compression), ArgsManager::ALLOW_ANY | ArgsManager::DEBUG_ONLY, OptionsCategory::OPTIONS);
+    argsman.AddArg("-dbfilterbits=<n>", strprintf("Bloom filter bits per key for the coins database, 0 to disable the filter policy (default: %u)", DBParams{}.filter_bits_per_key), ArgsManager::ALLOW_ANY | ArgsManager::DEBUG_ONLY, OptionsCategory::OPTIONS);
+    argsman.AddArg("-dbmaxfilesize=<n>", "Maximum coins database sstable size in bytes (0 = LevelDB default)", ArgsManager::ALLOW_ANY | ArgsManager::DEBUG_ONLY, OptionsCategory::OPTIONS);
     argsman.AddArg("-includeconf=<file>", "Specify additional configuration file, relative to the -datadir path (only useable from configuration file, not command line)", ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
     argsman.AddArg("-loadblock=<file>", "Imports blocks from external file on startup", ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
     argsman.AddArg("-maxmempool=<n>", strprintf("Keep the transaction memory pool below <n> megabytes (default: %u)", DEFAULT_MAX_MEMPOOL_SIZE_MB), ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
     argsman.AddArg("-maxorphantx=<n>", strprintf("Keep at most <n> unconnectable transactions in memory (default: %u)", DEFAULT_MAX_ORPHAN_TRANSACTIONS), ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
     argsman.AddArg("-mempoolexpiry=<n>", strprintf("Do not keep transactions in the mempool longer than <n> hours (default: %u)", DEFAULT_MEMPOOL_EXPIRY_HOURS), ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
+    argsman.AddArg("-mempoolsaveinterval=<n>", strprintf("Additionally save the mempool to disk every <n> seconds, so it survives an unclean shutdown (default: %u, 0 = only on shutdown). Requires -persistmempool.", DEFAULT_MEMPOOL_SAVE_INTERVAL), ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
     argsman.AddArg("-minimumchainwork=<hex>", strprintf("Minimum work assumed to exist on a valid chain in hex (default: %s, testnet: %s, signet: %s)", defaultChainParams->GetConsensus().nMinimumChainWork.GetHex(), testnetChainParams->GetConsensus().nMinimumChainWork.GetHex(), signetChainParams->GetConsensus().nMinimumChainWork.GetHex()), ArgsManager::ALLOW_ANY | ArgsManager::DEBUG_ONLY, OptionsCategory::OPTIONS);
     argsman.AddArg("-par=<n>", strprintf("Set the number of script verification threads (%u to %d, 0 = auto, <0 = leave that many cores free, default: %d)",
         -GetNumCores(), MAX_SCRIPTCHECK_THREADS, DEFAULT_SCRIPTCHECK_THREADS), ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
     argsman.AddArg("-persistmempool", strprintf("Whether to save the mempool on shutdown and load on restart (default: %u)", DEFAULT_PERSIST_MEMPOOL), ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
     argsman.AddArg("-pid=<file>", strprintf("Specify pid file. Relative paths will be prefixed by a net-specific datadir location. (default: %s)", CORAL_PID_FILENAME), ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
+    argsman.AddArg("-powsampleinterval=<n>", strprintf("During initial sync, below the minimum-chainwork anchor, verify the RandomX proof of work of only one in <n> randomly sampled headers plus every retarget boundary. nBits correctness and chainwork accounting are always fully enforced. 0 or 1 verifies every header (default: %d)", DEFAULT_POW_SAMPLE_INTERVAL), ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
     argsman.AddArg("-prune=<n>", strprintf("Reduce storage requirements by enabling pruning (deleting) of old blocks. This allows the pruneblockchain RPC to be called to delete specific blocks and enables automatic pruning of old blocks if a target size in MiB is provided. This mode is incompatible with -txindex. "
             "Warning: Reverting this setting requires re-downloading the entire blockchain. "
             "(default: 0 = disable pruning blocks, 1 = allow manual pruning via RPC, >=%u = automatically prune block files to stay under the specified target size in MiB)", MIN_DISK_SPACE_FOR_BLOCK_FILES / 1024 / 1024), ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
+    argsman.AddArg("-randomxdatasetcache", strprintf("Persist initialized RandomX datasets under <datadir>/randomx so restarts skip dataset recomputation (default: %u)", DEFAULT_RANDOMX_DATASET_CACHE), ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
+    argsman.AddArg("-randomxflags=<flags>", strprintf("RandomX VM flags: \"auto\" to probe CPU capabilities (JIT, hardware AES), or a comma-separated list of default, jit, hardaes, largepages, secure (default: %s)", DEFAULT_RANDOMX_FLAGS), ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
+    argsman.AddArg("-randomxinitthreads=<n>", strprintf("Set the number of threads used to initialize the RandomX dataset on key change (0 = one per core, default: %d)", DEFAULT_RANDOMX_INIT_THREADS), ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
+    argsman.AddArg("-randomxnumainterleave", strprintf("Pin RandomX dataset initialization workers across CPUs so dataset pages interleave over all NUMA nodes (default: %u)", DEFAULT_RANDOMX_NUMA_INTERLEAVE), ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
+    argsman.AddArg("-randomxprefetch", strprintf("Warm the RandomX state for the next block's key in the background at each tip change, hiding the per-block key switch from validation and mining (default: %u)", DEFAULT_RANDOMX_PREFETCH), ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
     argsman.AddArg("-reindex", "Rebuild chain state and block index from the blk*.dat files on disk. This will also rebuild active optional indexes.", ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
     argsman.AddArg("-reindex-chainstate", "Rebuild chain state from the currently indexed blocks. When in pruning mode or if blocks on disk might be corrupted, use full -reindex instead. Deactivate all optional indexes before running this.", ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
+    argsman.AddArg("-utxosnapshot=<file>", "Activate a UTXO snapshot (created with the dumptxoutset RPC) during startup for fast bootstrap. The node becomes usable at the snapshot's base block while the historical chain is validated in the background. The snapshot's base block header must already be known, so headers must have been synced on a previous start, and only snapshots whose base block is listed in the chain parameters are accepted.", ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
+    argsman.AddArg("-schedulerthreads=<n>", strprintf("Set the number of background scheduler threads; tasks in independent lanes run in parallel (default: %d)", DEFAULT_SCHEDULER_THREADS), ArgsManager::ALLOW_ANY | ArgsManager::DEBUG_ONLY, OptionsCategory::OPTIONS);
     argsman.AddArg("-settings=<file>", strprintf("Specify path to dynamic settings data file. Can be disabled with -nosettings. File is written at runtime and not meant to be edited by users (use %s instead for custom settings). Relative paths will be prefixed by datadir location. (default: %s)", CORAL_CONF_FILENAME, CORAL_SETTINGS_FILENAME), ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
 #if HAVE_SYSTEM
     argsman.AddArg("-startupnotify=<cmd>", "Execute command on startup.", ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
@@ -455,7 +510,10 @@ void SetupServerArgs(ArgsManager& argsman)
 #else
     hidden_args.emplace_back("-sysperms");
 #endif
+    argsman.AddArg("-txidfilter=<n>", strprintf("Keep an in-memory Bloom filter of <n> MiB over all known txids (mempool and txindex) so that lookups for unknown transactions return immediately, 0 to disable (default: %d)", DEFAULT_TXID_FILTER_MB), ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
     argsman.AddArg("-txindex", strprintf("Maintain a full transaction index, used by the getrawtransaction rpc call (default: %u)", DEFAULT_TXINDEX), ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
+    argsman.AddArg("-maxreorgcache", strprintf("Keep up to <n> MiB of recent blocks' undo data in memory so short reorgs do not read undo files from disk, 0 to disable (default: %d)", DEFAULT_MAX_REORG_CACHE_MB), ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
+    argsman.AddArg("-warmcoinscache", strprintf("Prefetch the coins referenced by the loaded mempool and by recent blocks into the coins cache at startup, so the first blocks after a restart validate at steady-state speed (default: %u)", DEFAULT_WARM_COINS_CACHE), ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
     argsman.AddArg("-blockfilterindex=<type>",
                  strprintf("Maintain an index of compact filters by block (default: %s, values: %s).", DEFAULT_BLOCKFILTERINDEX, ListBlockFilterTypes()) +
                  " If <type> is not supplied or if <type> = 1, indexes for all known types are enabled.",
@@ -482,12 +540,14 @@ void SetupServerArgs(ArgsManager& argsman)
     argsman.AddArg("-maxsendbuffer=<n>", strprintf("Maximum per-connection send buffer, <n>*1000 bytes (default: %u)", DEFAULT_MAXSENDBUFFER), ArgsManager::ALLOW_ANY, OptionsCategory::CONNECTION);
     argsman.AddArg("-maxtimeadjustment", strprintf("Maximum allowed median peer time offset adjustment. Local perspective of time may be influenced by outbound peers forward or backward by this amount (default: %u seconds).", DEFAULT_MAX_TIME_ADJUSTMENT), ArgsManager::ALLOW_ANY, OptionsCategory::CONNECTION);
     argsman.AddArg("-maxuploadtarget=<n>", strprintf("Tries to keep outbound traffic under the given target per 24h. Limit does not apply to peers with 'download' permission or blocks created within past week. 0 = no limit (default: %s). Optional suffix units [k|K|m|M|g|G|t|T] (default: M). Lowercase is 1000 base while uppercase is 1024 base", DEFAULT_MAX_UPLOAD_TARGET), ArgsManager::ALLOW_ANY, OptionsCategory::CONNECTION);
+    argsman.AddArg("-msghandlerthreads=<n>", strprintf("Number of P2P message handler threads. Each peer is assigned to one thread, so messages from a peer are always processed in order while different peers are handled in parallel (default: %d)", DEFAULT_MSGHANDLER_THREADS), ArgsManager::ALLOW_ANY, OptionsCategory::CONNECTION);
     argsman.AddArg("-onion=<ip:port>", "Use separate SOCKS5 proxy to reach peers via Tor onion services, set -noonion to disable (default: -proxy)", ArgsManager::ALLOW_ANY, OptionsCategory::CONNECTION);
     argsman.AddArg("-i2psam=<ip:port>", "I2P SAM proxy to reach I2P peers and accept I2P connections (default: none)", ArgsManager::ALLOW_ANY, OptionsCategory::CONNECTION);
     argsman.AddArg("-i2pacceptincoming", "If set and -i2psam is also set then incoming I2P connections are accepted via the SAM proxy. If this is not set but -i2psam is set then only outgoing connections will be made to the I2P network. Ignored if -i2psam is not set. Listening for incoming I2P connections is done through the SAM proxy, not by binding to a local address and port (default: 1)", ArgsManager::ALLOW_ANY, OptionsCategory::CONNECTION);
     argsman.AddArg("-onlynet=<net>", "Make automatic outbound connections only to network <net> (" + Join(GetNetworkNames(), ", ") + "). Inbound and manual connections are not affected by this option. It can be specified multiple times to allow multiple networks.", ArgsManager::ALLOW_ANY, OptionsCategory::CONNECTION);
     argsman.AddArg("-peerbloomfilters", strprintf("Support filtering of blocks and transaction with bloom filters (default: %u)", DEFAULT_PEERBLOOMFILTERS), ArgsManager::ALLOW_ANY, OptionsCategory::CONNECTION);
     argsman.AddArg("-peerblockfilters", strprintf("Serve compact block filters to peers per BIP 157 (default: %u)", DEFAULT_PEERBLOCKFILTERS), ArgsManager::ALLOW_ANY, OptionsCategory::CONNECTION);
+    argsman.AddArg("-compressedrelay", strprintf("Relay large block, tx and headers messages zlib-compressed with peers that also advertise support. Intended for bandwidth-constrained links between own nodes; requires a build with zlib. (default: %u)", DEFAULT_COMPRESSED_RELAY), ArgsManager::ALLOW_ANY, OptionsCategory::CONNECTION);
     // TODO: remove the sentence "Nodes not using ... incoming connections." once the changes from
     // https://github.com/coral/coral/pull/23542 have become widespread.
     argsman.AddArg("-port=<port>", strprintf("Listen for connections on <port>. Nodes not using the default ports (default: %u, testnet: %u, signet: %u, regtest: %u) are unlikely to get incoming connections. Not relevant for I2P (see doc/i2p.md).", defaultChainParams->GetDefaultPort(), testnetChainParams->GetDefaultPort(), signetChainParams->GetDefaultPort(), regtestChainParams->GetDefaultPort()), ArgsManager::ALLOW_ANY | ArgsManager::NETWORK_ONLY, OptionsCategory::CONNECTION);
@@ -528,22 +588,26 @@ void SetupServerArgs(ArgsManager& argsman)
     argsman.AddArg("-zmqpubhashtx=<address>", "Enable publish hash transaction in <address>", ArgsManager::ALLOW_ANY, OptionsCategory::ZMQ);
     argsman.AddArg("-zmqpubrawblock=<address>", "Enable publish raw block in <address>", ArgsManager::ALLOW_ANY, OptionsCategory::ZMQ);
     argsman.AddArg("-zmqpubrawtx=<address>", "Enable publish raw transaction in <address>", ArgsManager::ALLOW_ANY, OptionsCategory::ZMQ);
+    argsman.AddArg("-zmqpubrawtxbatch=<address>", strprintf("Enable publish raw transactions in <address>, coalesced into one message per %dms window", count_milliseconds(CZMQPublishRawTransactionBatchNotifier::BATCH_WINDOW)), ArgsManager::ALLOW_ANY, OptionsCategory::ZMQ);
     argsman.AddArg("-zmqpubsequence=<address>", "Enable publish hash block and tx sequence in <address>", ArgsManager::ALLOW_ANY, OptionsCategory::ZMQ);
     argsman.AddArg("-zmqpubhashblockhwm=<n>", strprintf("Set publish hash block outbound message high water mark (default: %d)", CZMQAbstractNotifier::DEFAULT_ZMQ_SNDHWM), ArgsManager::ALLOW_ANY, OptionsCategory::ZMQ);
     argsman.AddArg("-zmqpubhashtxhwm=<n>", strprintf("Set publish hash transaction outbound message high water mark (default: %d)", CZMQAbstractNotifier::DEFAULT_ZMQ_SNDHWM), ArgsManager::ALLOW_ANY, OptionsCategory::ZMQ);
     argsman.AddArg("-zmqpubrawblockhwm=<n>", strprintf("Set publish raw block outbound message high water mark (default: %d)", CZMQAbstractNotifier::DEFAULT_ZMQ_SNDHWM), ArgsManager::ALLOW_ANY, OptionsCategory::ZMQ);
     argsman.AddArg("-zmqpubrawtxhwm=<n>", strprintf("Set publish raw transaction outbound message high water mark (default: %d)", CZMQAbstractNotifier::DEFAULT_ZMQ_SNDHWM), ArgsManager::ALLOW_ANY, OptionsCategory::ZMQ);
+    argsman.AddArg("-zmqpubrawtxbatchhwm=<n>", strprintf("Set publish raw transaction batch outbound message high water mark (default: %d)", CZMQAbstractNotifier::DEFAULT_ZMQ_SNDHWM), ArgsManager::ALLOW_ANY, OptionsCategory::ZMQ);
     argsman.AddArg("-zmqpubsequencehwm=<n>", strprintf("Set publish hash sequence message high water mark (default: %d)", CZMQAbstractNotifier::DEFAULT_ZMQ_SNDHWM), ArgsManager::ALLOW_ANY, OptionsCategory::ZMQ);
 #else
     hidden_args.emplace_back("-zmqpubhashblock=<address>");
     hidden_args.emplace_back("-zmqpubhashtx=<address>");
     hidden_args.emplace_back("-zmqpubrawblock=<address>");
     hidden_args.emplace_back("-zmqpubrawtx=<address>");
+    hidden_args.emplace_back("-zmqpubrawtxbatch=<address>");
     hidden_args.emplace_back("-zmqpubsequence=<n>");
     hidden_args.emplace_back("-zmqpubhashblockhwm=<n>");
     hidden_args.emplace_back("-zmqpubhashtxhwm=<n>");
     hidden_args.emplace_back("-zmqpubrawblockhwm=<n>");
     hidden_args.emplace_back("-zmqpubrawtxhwm=<n>");
+    hidden_args.emplace_back("-zmqpubrawtxbatchhwm=<n>");
     hidden_args.emplace_back("-zmqpubsequencehwm=<n>");
 #endif
 
@@ -588,6 +652,8 @@ void SetupServerArgs(ArgsManager& argsman)
     argsman.AddArg("-blockmaxweight=<n>", strprintf("Set maximum BIP141 block weight (default: %d)", DEFAULT_BLOCK_MAX_WEIGHT), ArgsManager::ALLOW_ANY, OptionsCategory::BLOCK_CREATION);
     argsman.AddArg("-blockmintxfee=<amt>", strprintf("Set lowest fee rate (in %s/kvB) for transactions to be included in block creation. (default: %s)", CURRENCY_UNIT, FormatMoney(DEFAULT_BLOCK_MIN_TX_FEE)), ArgsManager::ALLOW_ANY, OptionsCategory::BLOCK_CREATION);
     argsman.AddArg("-blockversion=<n>", "Override block version to test forking scenarios", ArgsManager::ALLOW_ANY | ArgsManager::DEBUG_ONLY, OptionsCategory::BLOCK_CREATION);
+    argsman.AddArg("-stratumbind=<addr>[:port]", strprintf("Bind the stratum work server to the given address. Work is pushed to subscribed miners when the tip changes. This option can be specified multiple times (default: 127.0.0.1 and ::1, port %u)", DEFAULT_STRATUM_PORT), ArgsManager::ALLOW_ANY | ArgsManager::NETWORK_ONLY, OptionsCategory::BLOCK_CREATION);
+    argsman.AddArg("-stratumport=<port>", strprintf("Listen for stratum miners on <port>, on the loopback interface unless -stratumbind is given (default: %u)", DEFAULT_STRATUM_PORT), ArgsManager::ALLOW_ANY | ArgsManager::NETWORK_ONLY, OptionsCategory::BLOCK_CREATION);
 
     argsman.AddArg("-rest", strprintf("Accept public REST requests (default: %u)", DEFAULT_REST_ENABLE), ArgsManager::ALLOW_ANY, OptionsCategory::RPC);
     argsman.AddArg("-rpcallowip=<ip>", "Allow JSON-RPC connections from specified source. Valid for <ip> are a single IP (e.g. 1.2.3.4), a network/netmask (e.g. 1.2.3.4/255.255.255.0) or a network/CIDR (e.g. 1.2.3.4/24). This option can be specified multiple times", ArgsManager::ALLOW_ANY, OptionsCategory::RPC);
@@ -595,6 +661,7 @@ void SetupServerArgs(ArgsManager& argsman)
     argsman.AddArg("-rpcbind=<addr>[:port]", "Bind to given address to listen for JSON-RPC connections. Do not expose the RPC server to untrusted networks such as the public internet! This option is ignored unless -rpcallowip is also passed. Port is optional and overrides -rpcport. Use [host]:port notation for IPv6. This option can be specified multiple times (default: 127.0.0.1 and ::1 i.e., localhost)", ArgsManager::ALLOW_ANY | ArgsManager::NETWORK_ONLY | ArgsManager::SENSITIVE, OptionsCategory::RPC);
     argsman.AddArg("-rpcdoccheck", strprintf("Throw a non-fatal error at runtime if the documentation for an RPC is incorrect (default: %u)", DEFAULT_RPC_DOC_CHECK), ArgsManager::ALLOW_ANY | ArgsManager::DEBUG_ONLY, OptionsCategory::RPC);
     argsman.AddArg("-rpccookiefile=<loc>", "Location of the auth cookie. Relative paths will be prefixed by a net-specific datadir location. (default: data dir)", ArgsManager::ALLOW_ANY, OptionsCategory::RPC);
+    argsman.AddArg("-rpcheavythreads=<n>", strprintf("Set the number of threads dedicated to heavyweight RPC calls such as getblock, so they cannot delay cheap calls (default: %d)", DEFAULT_HTTP_HEAVY_THREADS), ArgsManager::ALLOW_ANY, OptionsCategory::RPC);
     argsman.AddArg("-rpcpassword=<pw>", "Password for JSON-RPC connections", ArgsManager::ALLOW_ANY | ArgsManager::SENSITIVE, OptionsCategory::RPC);
     argsman.AddArg("-rpcport=<port>", strprintf("Listen for JSON-RPC connections on <port> (default: %u, testnet: %u, signet: %u, regtest: %u)", defaultBaseParams->RPCPort(), testnetBaseParams->RPCPort(), signetBaseParams->RPCPort(), regtestBaseParams->RPCPort()), ArgsManager::ALLOW_ANY | ArgsManager::NETWORK_ONLY, OptionsCategory::RPC);
     argsman.AddArg("-rpcserialversion", strprintf("Sets the serialization of raw transaction or block hex returned in non-verbose mode, non-segwit(0) or segwit(1) (default: %d)", DEFAULT_RPC_SERIALIZE_VERSION), ArgsManager::ALLOW_ANY, OptionsCategory::RPC);
@@ -890,6 +957,17 @@ bool AppInitParameterInteraction(const ArgsManager& args, bool use_syscall_sandb
         nLocalServices = ServiceFlags(nLocalServices | NODE_COMPACT_FILTERS);
     }
 
+    // Signal NODE_COMPRESSED_RELAY only when this build can actually inflate
+    // compressed messages; the bit is negotiated, so advertising it without
+    // zlib would make negotiated peers send us messages we must drop.
+    if (args.GetBoolArg("-compressedrelay", DEFAULT_COMPRESSED_RELAY)) {
+#ifdef HAVE_ZLIB
+        nLocalServices = ServiceFlags(nLocalServices | NODE_COMPRESSED_RELAY);
+#else
+        return InitError(_("-compressedrelay requires a build with zlib support."));
+#endif
+    }
+
     if (args.GetIntArg("-prune", 0)) {
         if (args.GetBoolArg("-txindex", DEFAULT_TXINDEX))
             return InitError(_("Prune mode is incompatible with -txindex."));
@@ -1160,11 +1238,21 @@ bool AppInitMain(NodeContext& node, interfaces::BlockAndHeaderTipInfo* tip_info)
         StartScriptCheckWorkerThreads(script_threads);
     }
 
+    SetRandomXInitThreads(args.GetIntArg("-randomxinitthreads", DEFAULT_RANDOMX_INIT_THREADS));
+    SetRandomXNumaInterleave(args.GetBoolArg("-randomxnumainterleave", DEFAULT_RANDOMX_NUMA_INTERLEAVE));
+    SetRandomXPrefetch(args.GetBoolArg("-randomxprefetch", DEFAULT_RANDOMX_PREFETCH));
+    if (!SetRandomXFlags(args.GetArg("-randomxflags", DEFAULT_RANDOMX_FLAGS))) {
+        return InitError(strprintf(_("Invalid -randomxflags value '%s'"), args.GetArg("-randomxflags", DEFAULT_RANDOMX_FLAGS)));
+    }
+    if (args.GetBoolArg("-randomxdatasetcache", DEFAULT_RANDOMX_DATASET_CACHE)) {
+        SetRandomXDatasetDir(gArgs.GetDataDirNet() / "randomx");
+    }
+
     assert(!node.scheduler);
     node.scheduler = std::make_unique<CScheduler>();
 
-    // Start the lightweight task scheduler thread
-    node.scheduler->m_service_thread = std::thread(util::TraceThread, "scheduler", [&] { node.scheduler->serviceQueue(); });
+    // Start the lightweight task scheduler threads
+    node.scheduler->StartServiceThreads(std::max<int64_t>(1, args.GetIntArg("-schedulerthreads", DEFAULT_SCHEDULER_THREADS)));
 
     // Gather some entropy once per minute.
     node.scheduler->scheduleEvery([]{
@@ -1392,7 +1480,18 @@ bool AppInitMain(NodeContext& node, interfaces::BlockAndHeaderTipInfo* tip_info)
     g_zmq_notification_interface = CZMQNotificationInterface::Create();
 
     if (g_zmq_notification_interface) {
-        RegisterValidationInterface(g_zmq_notification_interface);
+        // High priority: external consumers should hear about each event
+        // before slower bookkeeping subscribers (e.g. the wallet) handle it.
+        RegisterValidationInterface(g_zmq_notification_interface, ValidationInterfacePriority::HIGH);
+        if (!args.GetArgs("-zmqpubrawtxbatch").empty()) {
+            // Flush batched notifiers on the scheduler thread, which also
+            // runs the validation interface callbacks, so the zmq sockets
+            // are never touched from two threads. The scheduler is stopped
+            // before the interface is torn down during shutdown.
+            node.scheduler->scheduleEvery([] {
+                if (g_zmq_notification_interface) g_zmq_notification_interface->FlushPendingNotifications();
+            }, CZMQPublishRawTransactionBatchNotifier::BATCH_WINDOW);
+        }
     }
 #endif
 
@@ -1478,6 +1577,9 @@ bool AppInitMain(NodeContext& node, interfaces::BlockAndHeaderTipInfo* tip_info)
             if (status == node::ChainstateLoadStatus::SUCCESS) {
                 fLoaded = true;
                 LogPrintf(" block index %15dms\n", Ticks<std::chrono::milliseconds>(SteadyClock::now() - load_block_index_start_time));
+                // Chain-read-only RPCs can be served from this point on, even
+                // though the rest of initialization is still in warmup.
+                SetRPCSubsystemReady("chain");
             }
         }
 
@@ -1515,12 +1617,54 @@ bool AppInitMain(NodeContext& node, interfaces::BlockAndHeaderTipInfo* tip_info)
 
     ChainstateManager& chainman = *Assert(node.chainman);
 
+    // Load and activate a UTXO snapshot for fast bootstrap, if requested. The
+    // node's tip jumps to the snapshot's base block while the chain below it
+    // is validated in the background.
+    if (args.IsArgSet("-utxosnapshot")) {
+        const fs::path snapshot_path{args.GetPathArg("-utxosnapshot")};
+        if (chainman.SnapshotBlockhash()) {
+            LogPrintf("[snapshot] a snapshot chainstate is already active, ignoring -utxosnapshot\n");
+        } else {
+            AutoFile coins_file{fsbridge::fopen(snapshot_path, "rb")};
+            if (coins_file.IsNull()) {
+                return InitError(strprintf(_("Unable to open UTXO snapshot file %s"), fs::quoted(fs::PathToString(snapshot_path))));
+            }
+            node::SnapshotMetadata metadata;
+            try {
+                coins_file >> metadata;
+            } catch (const std::ios_base::failure&) {
+                return InitError(strprintf(_("Unable to parse metadata of UTXO snapshot file %s"), fs::quoted(fs::PathToString(snapshot_path))));
+            }
+            uiInterface.InitMessage(_("Loading UTXO snapshot…").translated);
+            if (!chainman.ActivateSnapshot(coins_file, metadata, /*in_memory=*/false)) {
+                return InitError(strprintf(_("Unable to activate UTXO snapshot %s. See debug.log for details; note that the snapshot's base block header must already be synced."), fs::quoted(fs::PathToString(snapshot_path))));
+            }
+            LogPrintf("[snapshot] activated snapshot with base block %s; the historical chain will be validated in the background\n",
+                      metadata.m_base_blockhash.ToString());
+        }
+    }
+
     assert(!node.peerman);
     node.peerman = PeerManager::make(*node.connman, *node.addrman, node.banman.get(),
                                      chainman, *node.mempool, ignores_incoming_txs);
     RegisterValidationInterface(node.peerman.get());
 
     // ********************************************************* Step 8: start indexers
+
+    // The txid front filter must exist before the mempool is loaded and
+    // before the txindex starts appending, so that every txid added from here
+    // on is captured.
+    if (const int64_t filter_mb{args.GetIntArg("-txidfilter", DEFAULT_TXID_FILTER_MB)}; filter_mb > 0) {
+        g_txid_filter = std::make_unique<TxidFilter>(filter_mb);
+    }
+
+    if (const int64_t ring_mb{args.GetIntArg("-blockring", node::DEFAULT_BLOCK_RING_MB)}; ring_mb > 0) {
+        auto ring{std::make_unique<node::BlockRingWriter>()};
+        if (ring->Open(gArgs.GetDataDirNet() / "blockring", ring_mb)) {
+            node::g_block_ring = std::move(ring);
+        }
+    }
+
     if (args.GetBoolArg("-txindex", DEFAULT_TXINDEX)) {
         if (const auto error{WITH_LOCK(cs_main, return CheckLegacyTxindex(*Assert(chainman.m_blockman.m_block_tree_db)))}) {
             return InitError(*error);
@@ -1530,6 +1674,11 @@ bool AppInitMain(NodeContext& node, interfaces::BlockAndHeaderTipInfo* tip_info)
         if (!g_txindex->Start()) {
             return false;
         }
+        if (g_txid_filter) g_txindex->StartTxidFilterSeed();
+    } else if (g_txid_filter) {
+        // Without a txindex the filter only needs to cover the mempool, which
+        // starts out empty, so it is complete immediately.
+        g_txid_filter->Activate();
     }
 
     for (const auto& filter_type : g_enabled_filter_types) {
@@ -1546,12 +1695,20 @@ bool AppInitMain(NodeContext& node, interfaces::BlockAndHeaderTipInfo* tip_info)
         }
     }
 
+    if (args.GetBoolArg("-scripthashindex", DEFAULT_SCRIPTHASHINDEX)) {
+        g_scripthash_index = std::make_unique<ScriptHashIndex>(interfaces::MakeChain(node), /* cache size */ 0, false, fReindex);
+        if (!g_scripthash_index->Start()) {
+            return false;
+        }
+    }
+
     // ********************************************************* Step 9: load wallet
     for (const auto& client : node.chain_clients) {
         if (!client->load()) {
             return false;
         }
     }
+    SetRPCSubsystemReady("wallet");
 
     // ********************************************************* Step 10: data directory maintenance
 
@@ -1783,10 +1940,15 @@ bool AppInitMain(NodeContext& node, interfaces::BlockAndHeaderTipInfo* tip_info)
     }
 
     connOptions.m_i2p_accept_incoming = args.GetBoolArg("-i2pacceptincoming", true);
+    connOptions.m_msgproc_threads = args.GetIntArg("-msghandlerthreads", DEFAULT_MSGHANDLER_THREADS);
+    if (connOptions.m_msgproc_threads < 1) {
+        return InitError(Untranslated("-msghandlerthreads must be at least 1"));
+    }
 
     if (!node.connman->Start(*node.scheduler, connOptions)) {
         return false;
     }
+    SetRPCSubsystemReady("network");
 
     // Start LAN discovery for automatic peer finding on local network
     if (args.GetBoolArg("-landiscovery", true)) {
@@ -1831,6 +1993,10 @@ bool AppInitMain(NodeContext& node, interfaces::BlockAndHeaderTipInfo* tip_info)
     RPCNotifyBlockChange(WITH_LOCK(chainman.GetMutex(), return chainman.ActiveTip()));
     SetRPCWarmupFinished();
 
+    if (!StartStratumServer(node)) {
+        return InitError(_("Unable to start stratum server. See debug log for details."));
+    }
+
     uiInterface.InitMessage(_("Done loading").translated);
 
     for (const auto& client : node.chain_clients) {
@@ -1838,9 +2004,25 @@ bool AppInitMain(NodeContext& node, interfaces::BlockAndHeaderTipInfo* tip_info)
     }
 
     BanMan* banman = node.banman.get();
+    // Dump in a dedicated lane: a slow flush must not delay time-sensitive
+    // tasks in the default lane.
     node.scheduler->scheduleEvery([banman]{
         banman->DumpBanlist();
-    }, DUMP_BANS_INTERVAL);
+    }, DUMP_BANS_INTERVAL, node.scheduler->AllocateLane());
+
+    // Periodically save the mempool so that an unclean shutdown loses at most
+    // one interval's worth of accepted transactions.
+    const auto mempool_save_interval{std::chrono::seconds{args.GetIntArg("-mempoolsaveinterval", DEFAULT_MEMPOOL_SAVE_INTERVAL)}};
+    if (node.mempool && mempool_save_interval > 0s && ShouldPersistMempool(args)) {
+        CTxMemPool* mempool = node.mempool.get();
+        ChainstateManager* chainman_ptr = node.chainman.get();
+        const fs::path mempool_path{MempoolPath(args)};
+        node.scheduler->scheduleEvery([mempool, chainman_ptr, mempool_path]{
+            if (!mempool->GetLoadTried()) return;
+            const uint256 tip_hash{WITH_LOCK(cs_main, return chainman_ptr->ActiveChain().Tip()->GetBlockHash())};
+            DumpMempool(*mempool, mempool_path, fsbridge::fopen, /*skip_file_commit=*/false, tip_hash);
+        }, mempool_save_interval, node.scheduler->AllocateLane()); // Slow flush; keep it off the default lane
+    }
 
     if (node.peerman) node.peerman->StartScheduledTasks(*node.scheduler);
 
@@ -266,6 +266,10 @@ public:
         virtual void blockDisconnected(const BlockInfo& block) {}
         virtual void updatedBlockTip() {}
         virtual void chainStateFlushed(const CBlockLocator& locator) {}
+        //! Whether block connect/disconnect notifications for this handler
+        //! may run concurrently with those of other handlers that also return
+        //! true. See CValidationInterface::SupportsParallelDispatch().
+        virtual bool parallelDispatchOk() { return false; }
     };
 
     //! Register handler for notifications.
@@ -285,6 +289,11 @@ public:
     //! Run function after given number of seconds. Cancel any previous calls with same name.
     virtual void rpcRunLater(const std::string& name, std::function<void()> fn, int64_t seconds) = 0;
 
+    //! Run a function on the node's scheduler as soon as possible. Functions
+    //! submitted through this method run in submission order, so dependent
+    //! work (e.g. broadcasting a chain of wallet transactions) stays ordered.
+    virtual void scheduleAsync(std::function<void()> fn) = 0;
+
     //! Current RPC serialization flags.
     virtual int rpcSerializationFlags() = 0;
 
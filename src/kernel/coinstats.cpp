@@ -24,11 +24,15 @@
 #include <version.h>
 
 #include <cassert>
+#include <condition_variable>
+#include <deque>
 #include <iosfwd>
 #include <iterator>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <utility>
 
 namespace kernel {
@@ -116,6 +120,7 @@ static bool ComputeUTXOStats(CCoinsView* view, CCoinsStats& stats, T hash_obj, c
 {
     std::unique_ptr<CCoinsViewCursor> pcursor(view->Cursor());
     assert(pcursor);
+    pcursor = std::make_unique<CPrefetchingCoinsViewCursor>(std::move(pcursor));
 
     PrepareHash(hash_obj, stats);
 
@@ -151,6 +156,117 @@ static bool ComputeUTXOStats(CCoinsView* view, CCoinsStats& stats, T hash_obj, c
     return true;
 }
 
+static void FinalizeHash(MuHash3072& muhash, CCoinsStats& stats);
+
+/**
+ * Compute UTXO statistics with the MuHash set hash evaluated on all cores.
+ * MuHash is commutative, so each worker folds its share of transactions into
+ * a private accumulator and the per-thread accumulators are multiplied
+ * together at the end. The (sequential) cursor walk and the scalar statistics
+ * stay on the calling thread.
+ */
+static bool ComputeUTXOStatsMuHashParallel(CCoinsView* view, CCoinsStats& stats, const std::function<void()>& interruption_point)
+{
+    std::unique_ptr<CCoinsViewCursor> pcursor(view->Cursor());
+    assert(pcursor);
+    pcursor = std::make_unique<CPrefetchingCoinsViewCursor>(std::move(pcursor));
+
+    using TxOutputs = std::pair<uint256, std::map<uint32_t, Coin>>;
+    constexpr size_t BATCH_TXIDS{256};
+    constexpr size_t MAX_QUEUED_BATCHES{16};
+
+    std::mutex mutex;
+    std::condition_variable cv_work, cv_space;
+    std::deque<std::vector<TxOutputs>> work;
+    bool done{false};
+
+    const size_t worker_count{std::max<size_t>(1, std::thread::hardware_concurrency())};
+    std::vector<MuHash3072> muhashes(worker_count);
+    std::vector<std::thread> workers;
+    workers.reserve(worker_count);
+    for (size_t w = 0; w < worker_count; ++w) {
+        workers.emplace_back([&, w] {
+            for (;;) {
+                std::vector<TxOutputs> batch;
+                {
+                    std::unique_lock<std::mutex> lock(mutex);
+                    cv_work.wait(lock, [&] { return !work.empty() || done; });
+                    if (work.empty()) return;
+                    batch = std::move(work.front());
+                    work.pop_front();
+                }
+                cv_space.notify_one();
+                for (const TxOutputs& tx : batch) {
+                    ApplyHash(muhashes[w], tx.first, tx.second);
+                }
+            }
+        });
+    }
+
+    bool ok{true};
+    std::exception_ptr interrupted;
+    uint256 prevkey;
+    std::map<uint32_t, Coin> outputs;
+    std::vector<TxOutputs> batch;
+    const auto flush_tx{[&] {
+        ApplyStats(stats, prevkey, outputs);
+        batch.emplace_back(prevkey, std::move(outputs));
+        outputs.clear();
+        if (batch.size() >= BATCH_TXIDS) {
+            std::unique_lock<std::mutex> lock(mutex);
+            cv_space.wait(lock, [&] { return work.size() < MAX_QUEUED_BATCHES; });
+            work.push_back(std::move(batch));
+            batch.clear();
+            cv_work.notify_one();
+        }
+    }};
+    try {
+        while (pcursor->Valid()) {
+            interruption_point();
+            COutPoint key;
+            Coin coin;
+            if (pcursor->GetKey(key) && pcursor->GetValue(coin)) {
+                if (!outputs.empty() && key.hash != prevkey) {
+                    flush_tx();
+                }
+                prevkey = key.hash;
+                outputs[key.n] = std::move(coin);
+                stats.coins_count++;
+            } else {
+                ok = false;
+                break;
+            }
+            pcursor->Next();
+        }
+        if (ok && !outputs.empty()) {
+            flush_tx();
+        }
+    } catch (...) {
+        // Interruption points throw; unblock the workers before rethrowing.
+        interrupted = std::current_exception();
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (ok && !interrupted && !batch.empty()) work.push_back(std::move(batch));
+        done = true;
+    }
+    cv_work.notify_all();
+    for (std::thread& t : workers) t.join();
+    if (interrupted) std::rethrow_exception(interrupted);
+    if (!ok) return error("%s: unable to read value", __func__);
+
+    MuHash3072 muhash{muhashes.front()};
+    for (size_t w = 1; w < worker_count; ++w) {
+        muhash *= muhashes[w];
+    }
+    FinalizeHash(muhash, stats);
+
+    stats.nDiskSize = view->EstimateSize();
+
+    return true;
+}
+
 std::optional<CCoinsStats> ComputeUTXOStats(CoinStatsHashType hash_type, CCoinsView* view, node::BlockManager& blockman, const std::function<void()>& interruption_point)
 {
     CBlockIndex* pindex = WITH_LOCK(::cs_main, return blockman.LookupBlockIndex(view->GetBestBlock()));
@@ -163,8 +279,7 @@ std::optional<CCoinsStats> ComputeUTXOStats(CoinStatsHashType hash_type, CCoinsV
             return ComputeUTXOStats(view, stats, ss, interruption_point);
         }
         case(CoinStatsHashType::MUHASH): {
-            MuHash3072 muhash;
-            return ComputeUTXOStats(view, stats, muhash, interruption_point);
+            return ComputeUTXOStatsMuHashParallel(view, stats, interruption_point);
         }
         case(CoinStatsHashType::NONE): {
             return ComputeUTXOStats(view, stats, nullptr, interruption_point);
@@ -185,7 +300,6 @@ static void PrepareHash(HashWriter& ss, const CCoinsStats& stats)
     ss << stats.hashBlock;
 }
 // MuHash does not need the prepare step
-static void PrepareHash(MuHash3072& muhash, CCoinsStats& stats) {}
 static void PrepareHash(std::nullptr_t, CCoinsStats& stats) {}
 
 static void FinalizeHash(HashWriter& ss, CCoinsStats& stats)
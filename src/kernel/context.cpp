@@ -5,10 +5,12 @@
 #include <kernel/context.h>
 
 #include <crypto/sha256.h>
+#include <crypto/siphash.h>
 #include <key.h>
 #include <logging.h>
 #include <pubkey.h>
 #include <random.h>
+#include <util/strencodings.h>
 
 #include <string>
 
@@ -19,6 +21,10 @@ Context::Context()
 {
     std::string sha256_algo = SHA256AutoDetect();
     LogPrintf("Using the '%s' SHA256 implementation\n", sha256_algo);
+    std::string siphash_algo = SipHashAutoDetect();
+    LogPrintf("Using the '%s' SipHash implementation\n", siphash_algo);
+    std::string hex_algo = HexAutoDetect();
+    LogPrintf("Using the '%s' hex implementation\n", hex_algo);
     RandomInit();
     ECC_Start();
     ecc_verify_handle.reset(new ECCVerifyHandle());
@@ -35,7 +35,10 @@ using fsbridge::FopenFn;
 
 namespace kernel {
 
-static const uint64_t MEMPOOL_DUMP_VERSION = 1;
+//! Version 2 adds the tip hash the dump was written against, enabling the
+//! script-check fast path on reload when the chain has not advanced.
+static const uint64_t MEMPOOL_DUMP_VERSION_NO_TIP = 1;
+static const uint64_t MEMPOOL_DUMP_VERSION = 2;
 
 bool LoadMempool(CTxMemPool& pool, const fs::path& load_path, Chainstate& active_chainstate, FopenFn mockable_fopen_function)
 {
@@ -58,11 +61,57 @@ bool LoadMempool(CTxMemPool& pool, const fs::path& load_path, Chainstate& active
     try {
         uint64_t version;
         file >> version;
-        if (version != MEMPOOL_DUMP_VERSION) {
+        if (version != MEMPOOL_DUMP_VERSION && version != MEMPOOL_DUMP_VERSION_NO_TIP) {
             return false;
         }
+        uint256 dump_tip;
+        if (version >= MEMPOOL_DUMP_VERSION) {
+            file >> dump_tip;
+        }
+        if (!dump_tip.IsNull() &&
+            dump_tip == WITH_LOCK(::cs_main, return active_chainstate.m_chain.Tip()->GetBlockHash())) {
+            LogPrintf("Mempool dump was written at the current tip; skipping script re-verification on import\n");
+        }
         uint64_t num;
         file >> num;
+        const uint64_t total{num};
+        uint64_t processed{0};
+        pool.SetLoadProgress(processed, total);
+
+        // Submit transactions in batches, amortizing lock acquisitions, coin
+        // fetches and cache-limit checks over many transactions.
+        constexpr size_t ACCEPT_BATCH_SIZE{128};
+        std::vector<std::pair<CTransactionRef, int64_t>> batch;
+        batch.reserve(ACCEPT_BATCH_SIZE);
+        const auto submit_batch{[&]() {
+            if (batch.empty()) return;
+            LOCK(cs_main);
+            // If the dump was written against the tip we are validating
+            // against now, every transaction in it already had its scripts
+            // executed by this node with the same script flags, so
+            // re-execution is skipped. All other checks (inputs available,
+            // fees, policy limits) still run. Re-checked per batch in case a
+            // block connects while the import is in progress.
+            const bool skip_script_checks{!dump_tip.IsNull() &&
+                dump_tip == active_chainstate.m_chain.Tip()->GetBlockHash()};
+            const auto results{AcceptToMemoryPoolBatch(active_chainstate, batch, /*bypass_limits=*/false, skip_script_checks)};
+            for (size_t i = 0; i < results.size(); ++i) {
+                if (results[i].m_result_type == MempoolAcceptResult::ResultType::VALID) {
+                    ++count;
+                } else {
+                    // mempool may contain the transaction already, e.g. from
+                    // wallet(s) having loaded it while we were processing
+                    // mempool transactions; consider these as valid, instead of
+                    // failed, but mark them as 'already there'
+                    if (pool.exists(GenTxid::Txid(batch[i].first->GetHash()))) {
+                        ++already_there;
+                    } else {
+                        ++failed;
+                    }
+                }
+            }
+            batch.clear();
+        }};
         while (num) {
             --num;
             CTransactionRef tx;
@@ -77,27 +126,18 @@ bool LoadMempool(CTxMemPool& pool, const fs::path& load_path, Chainstate& active
                 pool.PrioritiseTransaction(tx->GetHash(), amountdelta);
             }
             if (nTime > TicksSinceEpoch<std::chrono::seconds>(now - pool.m_expiry)) {
-                LOCK(cs_main);
-                const auto& accepted = AcceptToMemoryPool(active_chainstate, tx, nTime, /*bypass_limits=*/false, /*test_accept=*/false);
-                if (accepted.m_result_type == MempoolAcceptResult::ResultType::VALID) {
-                    ++count;
-                } else {
-                    // mempool may contain the transaction already, e.g. from
-                    // wallet(s) having loaded it while we were processing
-                    // mempool transactions; consider these as valid, instead of
-                    // failed, but mark them as 'already there'
-                    if (pool.exists(GenTxid::Txid(tx->GetHash()))) {
-                        ++already_there;
-                    } else {
-                        ++failed;
-                    }
+                batch.emplace_back(std::move(tx), nTime);
+                if (batch.size() >= ACCEPT_BATCH_SIZE) {
+                    submit_batch();
                 }
             } else {
                 ++expired;
             }
+            pool.SetLoadProgress(++processed, total);
             if (ShutdownRequested())
                 return false;
         }
+        submit_batch();
         std::map<uint256, CAmount> mapDeltas;
         file >> mapDeltas;
 
@@ -122,7 +162,7 @@ bool LoadMempool(CTxMemPool& pool, const fs::path& load_path, Chainstate& active
     return true;
 }
 
-bool DumpMempool(const CTxMemPool& pool, const fs::path& dump_path, FopenFn mockable_fopen_function, bool skip_file_commit)
+bool DumpMempool(const CTxMemPool& pool, const fs::path& dump_path, FopenFn mockable_fopen_function, bool skip_file_commit, const uint256& tip_hash)
 {
     auto start = SteadyClock::now();
 
@@ -154,6 +194,7 @@ bool DumpMempool(const CTxMemPool& pool, const fs::path& dump_path, FopenFn mock
 
         uint64_t version = MEMPOOL_DUMP_VERSION;
         file << version;
+        file << tip_hash;
 
         file << (uint64_t)vinfo.size();
         for (const auto& i : vinfo) {
@@ -6,16 +6,20 @@
 #define CORAL_KERNEL_MEMPOOL_PERSIST_H
 
 #include <fs.h>
+#include <uint256.h>
 
 class Chainstate;
 class CTxMemPool;
 
 namespace kernel {
 
-/** Dump the mempool to disk. */
+/** Dump the mempool to disk. tip_hash identifies the chain tip the mempool
+ * contents were validated against; pass a null hash if unknown, which
+ * disables the script-check fast path on reload. */
 bool DumpMempool(const CTxMemPool& pool, const fs::path& dump_path,
                  fsbridge::FopenFn mockable_fopen_function = fsbridge::fopen,
-                 bool skip_file_commit = false);
+                 bool skip_file_commit = false,
+                 const uint256& tip_hash = uint256{});
 
 /** Load the mempool from disk. */
 bool LoadMempool(CTxMemPool& pool, const fs::path& load_path,
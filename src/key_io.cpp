@@ -10,7 +10,10 @@
 
 #include <algorithm>
 #include <assert.h>
+#include <list>
+#include <map>
 #include <string.h>
+#include <utility>
 
 /// Maximum witness length for Bech32 addresses.
 static constexpr std::size_t BECH32_WITNESS_PROG_MAX_LEN = 40;
@@ -76,7 +79,49 @@ public:
     std::string operator()(const CNoDestination& no) const { return {}; }
 };
 
-CTxDestination DecodeDestination(const std::string& str, const CChainParams& params, std::string& error_str, std::vector<int>* error_locations)
+/** Bounded LRU cache of successfully decoded destination strings.
+ *
+ * Payment-processing RPC paths (validateaddress, sendmany) tend to decode the
+ * same working set of payout addresses over and over, re-running the base58
+ * double-SHA256 checksum or bech32 polymod each time. Entries are keyed by
+ * chain as well as address text because the same string may decode
+ * differently (or not at all) on another network. Only valid destinations are
+ * cached: failures carry per-call error strings and locations, and
+ * attacker-supplied garbage must not be able to evict useful entries.
+ */
+class DestinationCache
+{
+public:
+    //! Return the cached destination for str on the given chain, or nullptr.
+    const CTxDestination* Lookup(const std::string& chain, const std::string& str)
+    {
+        const auto it = m_index.find({chain, str});
+        if (it == m_index.end()) return nullptr;
+        m_entries.splice(m_entries.begin(), m_entries, it->second);
+        return &it->second->second;
+    }
+
+    //! Record a successful decode, evicting the least recently used entry when full.
+    void Insert(const std::string& chain, const std::string& str, const CTxDestination& dest)
+    {
+        if (m_entries.size() >= MAX_ENTRIES) {
+            m_index.erase(m_entries.back().first);
+            m_entries.pop_back();
+        }
+        m_entries.emplace_front(Key{chain, str}, dest);
+        m_index.emplace(m_entries.front().first, m_entries.begin());
+    }
+
+private:
+    //! Large enough to cover a payment processor's recurring withdrawal set.
+    static constexpr size_t MAX_ENTRIES{4096};
+    using Key = std::pair<std::string, std::string>;
+
+    std::list<std::pair<Key, CTxDestination>> m_entries;
+    std::map<Key, decltype(m_entries)::iterator> m_index;
+};
+
+CTxDestination DecodeDestinationUncached(const std::string& str, const CChainParams& params, std::string& error_str, std::vector<int>* error_locations)
 {
     std::vector<unsigned char> data;
     uint160 hash;
@@ -193,6 +238,21 @@ CTxDestination DecodeDestination(const std::string& str, const CChainParams& par
     if (error_locations) *error_locations = std::move(res.second);
     return CNoDestination();
 }
+
+CTxDestination DecodeDestination(const std::string& str, const CChainParams& params, std::string& error_str, std::vector<int>* error_locations)
+{
+    static thread_local DestinationCache cache;
+
+    if (const CTxDestination* cached = cache.Lookup(params.NetworkIDString(), str)) {
+        error_str = "";
+        return *cached;
+    }
+    CTxDestination dest = DecodeDestinationUncached(str, params, error_str, error_locations);
+    if (IsValidDestination(dest)) {
+        cache.Insert(params.NetworkIDString(), str, dest);
+    }
+    return dest;
+}
 } // namespace
 
 CKey DecodeSecret(const std::string& str)
@@ -289,6 +349,17 @@ CTxDestination DecodeDestination(const std::string& str)
     return DecodeDestination(str, error_msg);
 }
 
+std::vector<CTxDestination> DecodeDestinations(const std::vector<std::string>& strs)
+{
+    std::vector<CTxDestination> dests;
+    dests.reserve(strs.size());
+    std::string error_msg;
+    for (const std::string& str : strs) {
+        dests.push_back(DecodeDestination(str, error_msg));
+    }
+    return dests;
+}
+
 bool IsValidDestinationString(const std::string& str, const CChainParams& params)
 {
     std::string error_msg;
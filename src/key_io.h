@@ -24,6 +24,10 @@ std::string EncodeExtPubKey(const CExtPubKey& extpubkey);
 std::string EncodeDestination(const CTxDestination& dest);
 CTxDestination DecodeDestination(const std::string& str);
 CTxDestination DecodeDestination(const std::string& str, std::string& error_msg, std::vector<int>* error_locations = nullptr);
+/** Decode a batch of destination strings, e.g. a sendmany address map, in one
+ * pass through the destination decode cache. The result has one entry per
+ * input; strings that do not decode yield CNoDestination. */
+std::vector<CTxDestination> DecodeDestinations(const std::vector<std::string>& strs);
 bool IsValidDestinationString(const std::string& str);
 bool IsValidDestinationString(const std::string& str, const CChainParams& params);
 
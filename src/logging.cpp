@@ -16,6 +16,9 @@
 
 const char * const DEFAULT_DEBUGLOGFILE = "debug.log";
 constexpr auto MAX_USER_SETABLE_SEVERITY_LEVEL{BCLog::Level::Info};
+//! Cap on the asynchronous writer queue. Messages arriving while the queue is
+//! full are dropped (and counted) rather than blocking the logging thread.
+constexpr size_t MAX_ASYNC_LOG_QUEUE{65536};
 
 BCLog::Logger& LogInstance()
 {
@@ -81,11 +84,21 @@ bool BCLog::Logger::StartLogging()
     }
     if (m_print_to_console) fflush(stdout);
 
+    if (m_async_categories.load(std::memory_order_relaxed) != 0) {
+        StdLockGuard async_lock(m_async_mutex);
+        if (!m_async_started) {
+            m_async_stop = false;
+            m_async_thread = std::thread(&Logger::ThreadAsyncLog, this);
+            m_async_started = true;
+        }
+    }
+
     return true;
 }
 
 void BCLog::Logger::DisconnectTestLogger()
 {
+    StopAsyncLogging();
     StdLockGuard scoped_lock(m_cs);
     m_buffering = true;
     if (m_fileout != nullptr) fclose(m_fileout);
@@ -119,6 +132,32 @@ bool BCLog::Logger::DisableCategory(const std::string& str)
     return true;
 }
 
+void BCLog::Logger::EnableAsyncCategory(BCLog::LogFlags flag)
+{
+    m_async_categories |= flag;
+}
+
+bool BCLog::Logger::EnableAsyncCategory(const std::string& str)
+{
+    BCLog::LogFlags flag;
+    if (!GetLogCategory(flag, str)) return false;
+    EnableAsyncCategory(flag);
+    return true;
+}
+
+void BCLog::Logger::StopAsyncLogging()
+{
+    {
+        StdLockGuard lock(m_async_mutex);
+        if (!m_async_started) return;
+        m_async_stop = true;
+        // Messages logged from here on take the synchronous path again.
+        m_async_started = false;
+    }
+    m_async_cv.notify_all();
+    m_async_thread.join();
+}
+
 bool BCLog::Logger::WillLogCategory(BCLog::LogFlags category) const
 {
     return (m_categories.load(std::memory_order_relaxed) & category) != 0;
@@ -335,7 +374,7 @@ std::string BCLog::Logger::LogLevelsString() const
     return Join(std::vector<BCLog::Level>{levels.begin(), levels.end()}, ", ", [this](BCLog::Level level) { return LogLevelToStr(level); });
 }
 
-std::string BCLog::Logger::LogTimestampStr(const std::string& str)
+std::string BCLog::Logger::LogTimestampStr(const std::string& str, int64_t time_micros)
 {
     std::string strStamped;
 
@@ -343,7 +382,7 @@ std::string BCLog::Logger::LogTimestampStr(const std::string& str)
         return str;
 
     if (m_started_new_line) {
-        int64_t nTimeMicros = GetTimeMicros();
+        int64_t nTimeMicros = time_micros;
         strStamped = FormatISO8601DateTime(nTimeMicros/1000000);
         if (m_log_time_micros) {
             strStamped.pop_back();
@@ -384,7 +423,60 @@ namespace BCLog {
 
 void BCLog::Logger::LogPrintStr(const std::string& str, const std::string& logging_function, const std::string& source_file, int source_line, BCLog::LogFlags category, BCLog::Level level)
 {
+    // High-rate categories can be routed through the asynchronous writer so
+    // the logging thread neither takes m_cs nor touches the log file.
+    // Warnings and errors always take the synchronous path.
+    if ((m_async_categories.load(std::memory_order_relaxed) & category) != 0 && level < Level::Warning) {
+        if (EnqueueAsync(str, logging_function, source_file, source_line, category, level)) return;
+    }
     StdLockGuard scoped_lock(m_cs);
+    LogPrintStrLocked(str, logging_function, source_file, source_line, category, level, util::ThreadGetInternalName(), GetTimeMicros());
+}
+
+bool BCLog::Logger::EnqueueAsync(const std::string& str, const std::string& logging_function, const std::string& source_file, int source_line, BCLog::LogFlags category, BCLog::Level level)
+{
+    {
+        StdLockGuard lock(m_async_mutex);
+        if (!m_async_started) return false;
+        if (m_async_queue.size() >= MAX_ASYNC_LOG_QUEUE) {
+            ++m_async_dropped;
+            return true;
+        }
+        m_async_queue.push_back({str, logging_function, source_file, source_line, category, level, util::ThreadGetInternalName(), GetTimeMicros()});
+    }
+    m_async_cv.notify_one();
+    return true;
+}
+
+void BCLog::Logger::ThreadAsyncLog()
+{
+    util::ThreadRename("logwriter");
+    while (true) {
+        std::deque<AsyncLogRecord> batch;
+        uint64_t dropped{0};
+        bool stop;
+        {
+            std::unique_lock<StdMutex> lock(m_async_mutex);
+            m_async_cv.wait(lock, [&] { return m_async_stop || !m_async_queue.empty(); });
+            batch.swap(m_async_queue);
+            std::swap(dropped, m_async_dropped);
+            stop = m_async_stop;
+        }
+        {
+            StdLockGuard scoped_lock(m_cs);
+            for (const AsyncLogRecord& rec : batch) {
+                LogPrintStrLocked(rec.str, rec.logging_function, rec.source_file, rec.source_line, rec.category, rec.level, rec.threadname, rec.time_micros);
+            }
+            if (dropped > 0) {
+                LogPrintStrLocked(strprintf("Asynchronous log writer dropped %d messages\n", dropped), __func__, __FILE__, __LINE__, LogFlags::NONE, Level::Warning, util::ThreadGetInternalName(), GetTimeMicros());
+            }
+        }
+        if (stop && batch.empty()) return;
+    }
+}
+
+void BCLog::Logger::LogPrintStrLocked(const std::string& str, const std::string& logging_function, const std::string& source_file, int source_line, BCLog::LogFlags category, BCLog::Level level, const std::string& threadname, int64_t time_micros)
+{
     std::string str_prefixed = LogEscapeMessage(str);
 
     if ((category != LogFlags::NONE || level != Level::None) && m_started_new_line) {
@@ -412,11 +504,10 @@ void BCLog::Logger::LogPrintStr(const std::string& str, const std::string& loggi
     }
 
     if (m_log_threadnames && m_started_new_line) {
-        const auto& threadname = util::ThreadGetInternalName();
         str_prefixed.insert(0, "[" + (threadname.empty() ? "unknown" : threadname) + "] ");
     }
 
-    str_prefixed = LogTimestampStr(str_prefixed);
+    str_prefixed = LogTimestampStr(str_prefixed, time_micros);
 
     m_started_new_line = !str.empty() && str[str.size()-1] == '\n';
 
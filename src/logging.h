@@ -12,11 +12,14 @@
 #include <util/string.h>
 
 #include <atomic>
+#include <condition_variable>
 #include <cstdint>
+#include <deque>
 #include <functional>
 #include <list>
 #include <mutex>
 #include <string>
+#include <thread>
 #include <unordered_map>
 #include <vector>
 
@@ -104,11 +107,39 @@ namespace BCLog {
         /** Log categories bitfield. */
         std::atomic<uint32_t> m_categories{0};
 
-        std::string LogTimestampStr(const std::string& str);
+        std::string LogTimestampStr(const std::string& str, int64_t time_micros);
 
         /** Slots that connect to the print signal */
         std::list<std::function<void(const std::string&)>> m_print_callbacks GUARDED_BY(m_cs) {};
 
+        //! A log message captured on the logging thread; prefixing and sink
+        //! writes happen later on the asynchronous writer thread.
+        struct AsyncLogRecord {
+            std::string str;
+            std::string logging_function;
+            std::string source_file;
+            int source_line;
+            LogFlags category;
+            Level level;
+            std::string threadname;
+            int64_t time_micros;
+        };
+
+        /** Categories whose messages are written by the asynchronous writer thread (bitfield). */
+        std::atomic<uint32_t> m_async_categories{0};
+
+        mutable StdMutex m_async_mutex;
+        std::condition_variable_any m_async_cv;
+        std::deque<AsyncLogRecord> m_async_queue GUARDED_BY(m_async_mutex);
+        uint64_t m_async_dropped GUARDED_BY(m_async_mutex){0};
+        bool m_async_started GUARDED_BY(m_async_mutex){false};
+        bool m_async_stop GUARDED_BY(m_async_mutex){false};
+        std::thread m_async_thread;
+
+        void ThreadAsyncLog();
+        bool EnqueueAsync(const std::string& str, const std::string& logging_function, const std::string& source_file, int source_line, LogFlags category, Level level);
+        void LogPrintStrLocked(const std::string& str, const std::string& logging_function, const std::string& source_file, int source_line, LogFlags category, Level level, const std::string& threadname, int64_t time_micros) EXCLUSIVE_LOCKS_REQUIRED(m_cs);
+
     public:
         bool m_print_to_console = false;
         bool m_print_to_file = false;
@@ -176,6 +207,12 @@ namespace BCLog {
         void DisableCategory(LogFlags flag);
         bool DisableCategory(const std::string& str);
 
+        /** Route a category's messages through the asynchronous writer thread. */
+        void EnableAsyncCategory(LogFlags flag);
+        bool EnableAsyncCategory(const std::string& str);
+        /** Flush the asynchronous writer queue and stop its thread. */
+        void StopAsyncLogging();
+
         bool WillLogCategory(LogFlags category) const;
         bool WillLogCategoryLevel(LogFlags category, Level level) const;
 
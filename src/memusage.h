@@ -7,6 +7,7 @@
 
 #include <indirectmap.h>
 #include <prevector.h>
+#include <support/allocators/pool.h>
 
 #include <stdlib.h>
 
@@ -167,6 +168,25 @@ static inline size_t DynamicUsage(const std::unordered_map<X, Y, Z>& m)
     return MallocUsage(sizeof(unordered_node<std::pair<const X, Y> >)) * m.size() + MallocUsage(sizeof(void*) * m.bucket_count());
 }
 
+/** Exact memory held by a pool resource: its chunks plus any allocations that
+ *  fell through to the heap. Unlike the estimates above this needs no
+ *  per-allocator malloc-overhead guess, since the resource owns its memory in
+ *  large chunks and tracks fallthrough bytes itself. */
+template <std::size_t MAX_BLOCK_SIZE_BYTES, std::size_t ALIGN_BYTES>
+static inline size_t DynamicUsage(const PoolResource<MAX_BLOCK_SIZE_BYTES, ALIGN_BYTES>& resource)
+{
+    return resource.NumChunks() * MallocUsage(resource.ChunkSizeBytes()) + resource.FallbackBytes();
+}
+
+/** Containers backed by a pool resource are measured through the resource;
+ *  the node count and bucket array are already reflected there. */
+template <class X, class Y, class Z, std::size_t MAX_BLOCK_SIZE_BYTES, std::size_t ALIGN_BYTES>
+static inline size_t DynamicUsage(const std::unordered_map<X, Y, Z, std::equal_to<X>,
+                                                           PoolAllocator<std::pair<const X, Y>, MAX_BLOCK_SIZE_BYTES, ALIGN_BYTES>>& m)
+{
+    return DynamicUsage(*m.get_allocator().resource());
+}
+
 }
 
 #endif // CORAL_MEMUSAGE_H
@@ -48,6 +48,10 @@
 #include <poll.h>
 #endif
 
+#ifdef HAVE_ZLIB
+#include <zlib.h>
+#endif
+
 #include <algorithm>
 #include <array>
 #include <cstdint>
@@ -119,6 +123,9 @@ std::map<CNetAddr, LocalServiceInfo> mapLocalHost GUARDED_BY(g_maplocalhost_mute
 static bool vfLimited[NET_MAX] GUARDED_BY(g_maplocalhost_mutex) = {};
 std::string strSubVersion;
 
+//! Process-wide statistics change counter; see CNode::BumpStatsSeq().
+static std::atomic<uint64_t> g_node_stats_seq{0};
+
 void CConnman::AddAddrFetch(const std::string& strDest)
 {
     LOCK(m_addr_fetches_mutex);
@@ -641,6 +648,7 @@ void CNode::CopyStats(CNodeStats& stats)
 
     X(m_last_ping_time);
     X(m_min_ping_time);
+    X(m_stats_seq);
 
     // Leave string empty if addrLocal invalid (not filled in yet)
     CService addrLocalUnlocked = GetAddrLocal();
@@ -650,6 +658,85 @@ void CNode::CopyStats(CNodeStats& stats)
 }
 #undef X
 
+void CNode::BumpStatsSeq()
+{
+    m_stats_seq = ++g_node_stats_seq;
+}
+
+namespace {
+
+#ifdef HAVE_ZLIB
+//! Smallest payload worth compressing for compressed relay. Below this the
+//! zlib framing and the uncompressed-size prefix eat most of the savings.
+constexpr size_t COMPRESSED_RELAY_MIN_BYTES{1024};
+
+//! Return the compressed counterpart of a message type eligible for
+//! compressed relay, or nullptr for all other types.
+const char* CompressedMessageType(const std::string& msg_type)
+{
+    if (msg_type == NetMsgType::BLOCK) return NetMsgType::ZBLOCK;
+    if (msg_type == NetMsgType::TX) return NetMsgType::ZTX;
+    if (msg_type == NetMsgType::HEADERS) return NetMsgType::ZHEADERS;
+    return nullptr;
+}
+#endif // HAVE_ZLIB
+
+//! Return the plain message type a compressed type inflates to, or nullptr
+//! if msg_type is not a compressed type.
+const char* DecompressedMessageType(const std::string& msg_type)
+{
+    if (msg_type == NetMsgType::ZBLOCK) return NetMsgType::BLOCK;
+    if (msg_type == NetMsgType::ZTX) return NetMsgType::TX;
+    if (msg_type == NetMsgType::ZHEADERS) return NetMsgType::HEADERS;
+    return nullptr;
+}
+
+//! Replace an eligible message's payload with its compressed form (a 4-byte
+//! little-endian uncompressed size followed by a zlib stream) if that is
+//! actually smaller. A no-op in builds without zlib, for ineligible or small
+//! messages, and when compression does not pay for itself.
+void MaybeCompressMessage(CSerializedNetMsg& msg)
+{
+#ifdef HAVE_ZLIB
+    const char* compressed_type{CompressedMessageType(msg.m_type)};
+    if (!compressed_type || msg.data.size() < COMPRESSED_RELAY_MIN_BYTES) return;
+    std::vector<unsigned char> compressed(4 + compressBound(msg.data.size()));
+    WriteLE32(compressed.data(), msg.data.size());
+    uLongf compressed_len = compressed.size() - 4;
+    if (compress2(compressed.data() + 4, &compressed_len, msg.data.data(), msg.data.size(), Z_DEFAULT_COMPRESSION) != Z_OK) return;
+    if (4 + compressed_len >= msg.data.size()) return;
+    compressed.resize(4 + compressed_len);
+    msg.data = std::move(compressed);
+    msg.m_type = compressed_type;
+#endif
+}
+
+//! Inflate a compressed message back into its plain counterpart in place.
+//! Returns false if this build lacks zlib, the size prefix exceeds the
+//! protocol limit, or the zlib stream is malformed or of the wrong length.
+bool DecompressMessage(CNetMessage& msg, const char* plain_type)
+{
+#ifdef HAVE_ZLIB
+    if (msg.m_recv.size() < 4) return false;
+    const uint32_t decompressed_size{ReadLE32(UCharCast(msg.m_recv.data()))};
+    if (decompressed_size > MAX_PROTOCOL_MESSAGE_LENGTH) return false;
+    std::vector<unsigned char> decompressed(decompressed_size);
+    uLongf decompressed_len = decompressed_size;
+    if (uncompress(decompressed.data(), &decompressed_len, UCharCast(msg.m_recv.data()) + 4, msg.m_recv.size() - 4) != Z_OK ||
+        decompressed_len != decompressed_size) {
+        return false;
+    }
+    msg.m_recv = CDataStream{MakeByteSpan(decompressed), msg.m_recv.GetType(), msg.m_recv.GetVersion()};
+    msg.m_message_size = decompressed_size;
+    msg.m_type = plain_type;
+    return true;
+#else
+    return false;
+#endif
+}
+
+} // namespace
+
 bool CNode::ReceiveMsgBytes(Span<const uint8_t> msg_bytes, bool& complete)
 {
     complete = false;
@@ -657,6 +744,7 @@ bool CNode::ReceiveMsgBytes(Span<const uint8_t> msg_bytes, bool& complete)
     LOCK(cs_vRecv);
     m_last_recv = std::chrono::duration_cast<std::chrono::seconds>(time);
     nRecvBytes += msg_bytes.size();
+    BumpStatsSeq();
     while (msg_bytes.size() > 0) {
         // absorb network data
         int handled = m_deserializer->Read(msg_bytes);
@@ -685,6 +773,19 @@ bool CNode::ReceiveMsgBytes(Span<const uint8_t> msg_bytes, bool& complete)
             assert(i != mapRecvBytesPerMsgType.end());
             i->second += msg.m_raw_message_size;
 
+            // Inflate negotiated compressed payloads into their plain message
+            // before handing them to the processing layer. Compressed messages
+            // from peers that did not negotiate compressed relay, or that do
+            // not inflate cleanly, are dropped like any other undecodable
+            // message.
+            if (const char* plain_type{DecompressedMessageType(msg.m_type)}) {
+                if (!m_compressed_relay || !DecompressMessage(msg, plain_type)) {
+                    LogPrint(BCLog::NET, "Dropping invalid %s (%u bytes), peer=%d\n",
+                             SanitizeString(msg.m_type), msg.m_message_size, GetId());
+                    continue;
+                }
+            }
+
             // push the message to the process queue,
             vRecvMsg.push_back(std::move(msg));
 
@@ -708,9 +809,10 @@ int V1TransportDeserializer::readHeader(Span<const uint8_t> msg_bytes)
     if (nHdrPos < CMessageHeader::HEADER_SIZE)
         return nCopy;
 
-    // deserialize to CMessageHeader
+    // deserialize to CMessageHeader. A SpanReader over the fixed-size header
+    // buffer avoids the per-message heap allocation a CDataStream would make.
     try {
-        hdrbuf >> hdr;
+        SpanReader{vRecv.GetType(), vRecv.GetVersion(), hdrbuf} >> hdr;
     }
     catch (const std::exception&) {
         LogPrint(BCLog::NET, "Header error: Unable to deserialize, peer=%d\n", m_node_id);
@@ -742,10 +844,15 @@ int V1TransportDeserializer::readData(Span<const uint8_t> msg_bytes)
 
     if (vRecv.size() < nDataPos + nCopy) {
         // Allocate up to 256 KiB ahead, but never more than the total message size.
+        // Once more than one lookahead chunk of payload has actually arrived,
+        // reserve the full message up front: growing incrementally would copy
+        // (and securely wipe) the whole multi-MiB buffer on every reallocation
+        // while a block message streams in.
+        if (nDataPos + nCopy > 256 * 1024) vRecv.reserve(hdr.nMessageSize);
         vRecv.resize(std::min(hdr.nMessageSize, nDataPos + nCopy + 256 * 1024));
     }
 
-    hasher.Write(msg_bytes.first(nCopy));
+    if (!m_skip_checksum) hasher.Write(msg_bytes.first(nCopy));
     memcpy(&vRecv[nDataPos], msg_bytes.data(), nCopy);
     nDataPos += nCopy;
 
@@ -773,20 +880,25 @@ CNetMessage V1TransportDeserializer::GetMessage(const std::chrono::microseconds
     msg.m_message_size = hdr.nMessageSize;
     msg.m_raw_message_size = hdr.nMessageSize + CMessageHeader::HEADER_SIZE;
 
-    uint256 hash = GetMessageHash();
+    // Check checksum and header message type string. Peers with the
+    // "nochecksum" permission skip the payload hash entirely: it was never
+    // accumulated during receive, so the socket thread pays no hashing cost.
+    if (!m_skip_checksum) {
+        uint256 hash = GetMessageHash();
 
-    // We just received a message off the wire, harvest entropy from the time (and the message checksum)
-    RandAddEvent(ReadLE32(hash.begin()));
+        // We just received a message off the wire, harvest entropy from the time (and the message checksum)
+        RandAddEvent(ReadLE32(hash.begin()));
 
-    // Check checksum and header message type string
-    if (memcmp(hash.begin(), hdr.pchChecksum, CMessageHeader::CHECKSUM_SIZE) != 0) {
-        LogPrint(BCLog::NET, "Header error: Wrong checksum (%s, %u bytes), expected %s was %s, peer=%d\n",
-                 SanitizeString(msg.m_type), msg.m_message_size,
-                 HexStr(Span{hash}.first(CMessageHeader::CHECKSUM_SIZE)),
-                 HexStr(hdr.pchChecksum),
-                 m_node_id);
-        reject_message = true;
-    } else if (!hdr.IsCommandValid()) {
+        if (memcmp(hash.begin(), hdr.pchChecksum, CMessageHeader::CHECKSUM_SIZE) != 0) {
+            LogPrint(BCLog::NET, "Header error: Wrong checksum (%s, %u bytes), expected %s was %s, peer=%d\n",
+                     SanitizeString(msg.m_type), msg.m_message_size,
+                     HexStr(Span{hash}.first(CMessageHeader::CHECKSUM_SIZE)),
+                     HexStr(hdr.pchChecksum),
+                     m_node_id);
+            reject_message = true;
+        }
+    }
+    if (!reject_message && !hdr.IsCommandValid()) {
         LogPrint(BCLog::NET, "Header error: Invalid message type (%s, %u bytes), peer=%d\n",
                  SanitizeString(hdr.GetCommand()), msg.m_message_size, m_node_id);
         reject_message = true;
@@ -816,29 +928,54 @@ size_t CConnman::SocketSendData(CNode& node) const
     auto it = node.vSendMsg.begin();
     size_t nSentSize = 0;
 
+    // Number of queued messages coalesced into a single vectored send. Bounded
+    // so the iovec array stays small; Sock::SendMany caps at the same limit.
+    constexpr size_t MAX_SEND_BUFFERS{64};
+
     while (it != node.vSendMsg.end()) {
-        const auto& data = *it;
-        assert(data.size() > node.nSendOffset);
-        int nBytes = 0;
+        // Coalesce the peer's queued messages into one syscall instead of
+        // paying one send(2) per message during announcement fan-out.
+        std::vector<Span<const unsigned char>> buffers;
+        size_t offered = 0;
+        {
+            size_t offset = node.nSendOffset;
+            for (auto batch_it = it; batch_it != node.vSendMsg.end() && buffers.size() < MAX_SEND_BUFFERS; ++batch_it) {
+                assert((*batch_it)->size() > offset);
+                buffers.emplace_back((*batch_it)->data() + offset, (*batch_it)->size() - offset);
+                offered += (*batch_it)->size() - offset;
+                offset = 0;
+            }
+        }
+        ssize_t nBytes = 0;
         {
             LOCK(node.m_sock_mutex);
             if (!node.m_sock) {
                 break;
             }
-            nBytes = node.m_sock->Send(reinterpret_cast<const char*>(data.data()) + node.nSendOffset, data.size() - node.nSendOffset, MSG_NOSIGNAL | MSG_DONTWAIT);
+            nBytes = node.m_sock->SendMany(buffers, MSG_NOSIGNAL | MSG_DONTWAIT);
         }
         if (nBytes > 0) {
             node.m_last_send = GetTime<std::chrono::seconds>();
             node.nSendBytes += nBytes;
-            node.nSendOffset += nBytes;
+            node.BumpStatsSeq();
             nSentSize += nBytes;
-            if (node.nSendOffset == data.size()) {
-                node.nSendOffset = 0;
-                node.nSendSize -= data.size();
-                node.fPauseSend = node.nSendSize > nSendBufferMaxSize;
-                it++;
-            } else {
-                // could not send full message; stop sending more
+            // Account the sent bytes to the queued messages they came from.
+            size_t remaining = static_cast<size_t>(nBytes);
+            while (remaining > 0) {
+                const size_t msg_left = (*it)->size() - node.nSendOffset;
+                if (remaining >= msg_left) {
+                    remaining -= msg_left;
+                    node.nSendOffset = 0;
+                    node.nSendSize -= (*it)->size();
+                    node.fPauseSend = node.nSendSize > nSendBufferMaxSize;
+                    it++;
+                } else {
+                    node.nSendOffset += remaining;
+                    remaining = 0;
+                }
+            }
+            if (static_cast<size_t>(nBytes) < offered) {
+                // could not send everything we offered; stop sending more
                 break;
             }
         } else {
@@ -875,9 +1012,14 @@ bool CConnman::AttemptToEvictConnection()
 {
     std::vector<NodeEvictionCandidate> vEvictionCandidates;
     {
-
-        LOCK(m_nodes_mutex);
-        for (const CNode* node : m_nodes) {
+        // Snapshot the node list so that the candidate attributes (const
+        // members and atomics) can be gathered without holding m_nodes_mutex;
+        // every accepted socket runs an eviction pass once the inbound slots
+        // are full, and extending the lock hold time here stalls the socket
+        // and message handler threads under inbound churn.
+        const NodesSnapshot snap{*this, /*shuffle=*/false};
+        vEvictionCandidates.reserve(snap.Nodes().size());
+        for (const CNode* node : snap.Nodes()) {
             if (node->fDisconnect)
                 continue;
             NodeEvictionCandidate candidate{
@@ -1383,9 +1525,9 @@ void CConnman::WakeMessageHandler()
 {
     {
         LOCK(mutexMsgProc);
-        fMsgProcWake = true;
+        fMsgProcWake.assign(fMsgProcWake.size(), true);
     }
-    condMsgProc.notify_one();
+    condMsgProc.notify_all();
 }
 
 void CConnman::ThreadDNSAddressSeed()
@@ -1397,11 +1539,22 @@ void CConnman::ThreadDNSAddressSeed()
     int seeds_right_now = 0; // Number of seeds left before testing if we have enough connections
     int found = 0;
 
+    // On a cold start, make the last known-good seed results available for
+    // connection attempts immediately, before any resolution completes.
+    const bool had_addresses{addrman.size() != 0};
+    if (!had_addresses) {
+        const std::vector<CAddress> cached{ReadDNSSeedCache(gArgs.GetDataDirNet() / "dnsseeds.dat")};
+        CNetAddr cache_source;
+        if (!cached.empty() && cache_source.SetInternal("dnsseedcache")) {
+            addrman.Add(cached, cache_source);
+        }
+    }
+
     if (gArgs.GetBoolArg("-forcednsseed", DEFAULT_FORCEDNSSEED)) {
         // When -forcednsseed is provided, query all.
         seeds_right_now = seeds.size();
-    } else if (addrman.size() == 0) {
-        // If we have no known peers, query all.
+    } else if (!had_addresses) {
+        // If we had no known peers, query all.
         // This will occur on the first run, or if peers.dat has been
         // deleted.
         seeds_right_now = seeds.size();
@@ -1421,6 +1574,60 @@ void CConnman::ThreadDNSAddressSeed()
     //   (done in ThreadOpenConnections)
     const std::chrono::seconds seeds_wait_time = (addrman.size() >= DNSSEEDS_DELAY_PEER_THRESHOLD ? DNSSEEDS_DELAY_MANY_PEERS : DNSSEEDS_DELAY_FEW_PEERS);
 
+    const ServiceFlags requiredServiceBits{GetDesirableServiceFlags(NODE_NONE)};
+    // Resolve one seed, appending service-bit-filtered addresses to vAdd.
+    // Returns false when the lookup fails, in which case the seed should be
+    // contacted through an addrfetch connection instead.
+    const auto resolve_seed = [requiredServiceBits](const std::string& seed, std::vector<CAddress>& vAdd) {
+        FastRandomContext seed_rng;
+        std::vector<CNetAddr> vIPs;
+        const std::string host{strprintf("x%x.%s", requiredServiceBits, seed)};
+        unsigned int nMaxIPs = 256; // Limits number of IPs learned from a DNS seed
+        if (!LookupHost(host, vIPs, nMaxIPs, true)) return false;
+        for (const CNetAddr& ip : vIPs) {
+            CAddress addr = CAddress(CService(ip, Params().GetDefaultPort()), requiredServiceBits);
+            addr.nTime = seed_rng.rand_uniform_delay(Now<NodeSeconds>() - 3 * 24h, -4 * 24h); // use a random age between 3 and 7 days old
+            vAdd.push_back(addr);
+        }
+        return true;
+    };
+
+    std::vector<CAddress> seed_cache; // Successfully resolved addresses, persisted for the next cold start
+
+    if (seeds_right_now == static_cast<int>(seeds.size()) && !seeds.empty() && !HaveNameProxy()) {
+        // Address need is acute, so every seed will be queried anyway: run the
+        // blocking lookups in parallel instead of paying for each resolver
+        // timeout in turn.
+        std::vector<std::vector<CAddress>> results(seeds.size());
+        std::vector<uint8_t> resolved(seeds.size(), 0);
+        std::vector<std::thread> threads;
+        threads.reserve(seeds.size());
+        for (size_t i = 0; i < seeds.size(); ++i) {
+            threads.emplace_back([&, i] { resolved[i] = resolve_seed(seeds[i], results[i]) ? 1 : 0; });
+        }
+        for (auto& thread : threads) thread.join();
+        if (interruptNet) return;
+
+        for (size_t i = 0; i < seeds.size(); ++i) {
+            if (!resolved[i]) {
+                // We now avoid directly using results from DNS Seeds which do not support service bit filtering,
+                // instead using them as a addrfetch to get nodes with our desired service bits.
+                AddAddrFetch(seeds[i]);
+                continue;
+            }
+            CNetAddr resolveSource;
+            if (!resolveSource.SetInternal(strprintf("x%x.%s", requiredServiceBits, seeds[i]))) continue;
+            addrman.Add(results[i], resolveSource);
+            found += results[i].size();
+            seed_cache.insert(seed_cache.end(), results[i].begin(), results[i].end());
+        }
+        if (!seed_cache.empty()) {
+            DumpDNSSeedCache(gArgs.GetDataDirNet() / "dnsseeds.dat", seed_cache);
+        }
+        LogPrintf("%d addresses found from DNS seeds\n", found);
+        return;
+    }
+
     for (const std::string& seed : seeds) {
         if (seeds_right_now == 0) {
             seeds_right_now += DNSSEEDS_TO_QUERY_AT_ONCE;
@@ -1470,23 +1677,15 @@ void CConnman::ThreadDNSAddressSeed()
         if (HaveNameProxy()) {
             AddAddrFetch(seed);
         } else {
-            std::vector<CNetAddr> vIPs;
             std::vector<CAddress> vAdd;
-            ServiceFlags requiredServiceBits = GetDesirableServiceFlags(NODE_NONE);
-            std::string host = strprintf("x%x.%s", requiredServiceBits, seed);
             CNetAddr resolveSource;
-            if (!resolveSource.SetInternal(host)) {
+            if (!resolveSource.SetInternal(strprintf("x%x.%s", requiredServiceBits, seed))) {
                 continue;
             }
-            unsigned int nMaxIPs = 256; // Limits number of IPs learned from a DNS seed
-            if (LookupHost(host, vIPs, nMaxIPs, true)) {
-                for (const CNetAddr& ip : vIPs) {
-                    CAddress addr = CAddress(CService(ip, Params().GetDefaultPort()), requiredServiceBits);
-                    addr.nTime = rng.rand_uniform_delay(Now<NodeSeconds>() - 3 * 24h, -4 * 24h); // use a random age between 3 and 7 days old
-                    vAdd.push_back(addr);
-                    found++;
-                }
+            if (resolve_seed(seed, vAdd)) {
                 addrman.Add(vAdd, resolveSource);
+                found += vAdd.size();
+                seed_cache.insert(seed_cache.end(), vAdd.begin(), vAdd.end());
             } else {
                 // We now avoid directly using results from DNS Seeds which do not support service bit filtering,
                 // instead using them as a addrfetch to get nodes with our desired service bits.
@@ -1495,6 +1694,9 @@ void CConnman::ThreadDNSAddressSeed()
         }
         --seeds_right_now;
     }
+    if (!seed_cache.empty()) {
+        DumpDNSSeedCache(gArgs.GetDataDirNet() / "dnsseeds.dat", seed_cache);
+    }
     LogPrintf("%d addresses found from DNS seeds\n", found);
 }
 
@@ -1991,7 +2193,7 @@ void CConnman::OpenNetworkConnection(const CAddress& addrConnect, bool fCountFai
     }
 }
 
-void CConnman::ThreadMessageHandler()
+void CConnman::ThreadMessageHandler(size_t shard)
 {
     SetSyscallSandboxPolicy(SyscallSandboxPolicy::MESSAGE_HANDLER);
     while (!flagInterruptMsgProc)
@@ -2005,6 +2207,11 @@ void CConnman::ThreadMessageHandler()
             const NodesSnapshot snap{*this, /*shuffle=*/true};
 
             for (CNode* pnode : snap.Nodes()) {
+                // Each peer belongs to exactly one handler thread, so its
+                // messages are processed in order while other threads make
+                // progress on their own peers.
+                if (static_cast<size_t>(pnode->GetId()) % m_msgproc_thread_count != shard)
+                    continue;
                 if (pnode->fDisconnect)
                     continue;
 
@@ -2026,9 +2233,9 @@ void CConnman::ThreadMessageHandler()
 
         WAIT_LOCK(mutexMsgProc, lock);
         if (!fMoreWork) {
-            condMsgProc.wait_until(lock, std::chrono::steady_clock::now() + std::chrono::milliseconds(100), [this]() EXCLUSIVE_LOCKS_REQUIRED(mutexMsgProc) { return fMsgProcWake; });
+            condMsgProc.wait_until(lock, std::chrono::steady_clock::now() + std::chrono::milliseconds(100), [this, shard]() EXCLUSIVE_LOCKS_REQUIRED(mutexMsgProc) { return fMsgProcWake[shard]; });
         }
-        fMsgProcWake = false;
+        fMsgProcWake[shard] = false;
     }
 }
 
@@ -2328,7 +2535,7 @@ bool CConnman::Start(CScheduler& scheduler, const Options& connOptions)
 
     {
         LOCK(mutexMsgProc);
-        fMsgProcWake = false;
+        fMsgProcWake.assign(m_msgproc_thread_count, false);
     }
 
     // Send and receive from sockets, accept connections
@@ -2357,7 +2564,10 @@ bool CConnman::Start(CScheduler& scheduler, const Options& connOptions)
     }
 
     // Process messages
-    threadMessageHandler = std::thread(&util::TraceThread, "msghand", [this] { ThreadMessageHandler(); });
+    for (int i = 0; i < m_msgproc_thread_count; ++i) {
+        const std::string thread_name{m_msgproc_thread_count > 1 ? strprintf("msghand.%i", i) : "msghand"};
+        threadsMessageHandler.emplace_back(&util::TraceThread, thread_name, [this, i] { ThreadMessageHandler(i); });
+    }
 
     if (m_i2p_sam_session) {
         threadI2PAcceptIncoming =
@@ -2365,7 +2575,9 @@ bool CConnman::Start(CScheduler& scheduler, const Options& connOptions)
     }
 
     // Dump network addresses
-    scheduler.scheduleEvery([this] { DumpAddresses(); }, DUMP_PEERS_INTERVAL);
+    // Dump in a dedicated lane: writing peers.dat can take a while and must
+    // not delay time-sensitive tasks in the default lane.
+    scheduler.scheduleEvery([this] { DumpAddresses(); }, DUMP_PEERS_INTERVAL, scheduler.AllocateLane());
 
     return true;
 }
@@ -2414,8 +2626,10 @@ void CConnman::StopThreads()
     if (threadI2PAcceptIncoming.joinable()) {
         threadI2PAcceptIncoming.join();
     }
-    if (threadMessageHandler.joinable())
-        threadMessageHandler.join();
+    for (auto& thread : threadsMessageHandler) {
+        if (thread.joinable()) thread.join();
+    }
+    threadsMessageHandler.clear();
     if (threadOpenConnections.joinable())
         threadOpenConnections.join();
     if (threadOpenAddedConnections.joinable())
@@ -2738,7 +2952,8 @@ CNode::CNode(NodeId idIn,
              ConnectionType conn_type_in,
              bool inbound_onion,
              CNodeOptions&& node_opts)
-    : m_deserializer{std::make_unique<V1TransportDeserializer>(V1TransportDeserializer(Params(), idIn, SER_NETWORK, INIT_PROTO_VERSION))},
+    : m_deserializer{std::make_unique<V1TransportDeserializer>(V1TransportDeserializer(Params(), idIn, SER_NETWORK, INIT_PROTO_VERSION,
+          NetPermissions::HasFlag(node_opts.permission_flags, NetPermissionFlags::NoChecksum)))},
       m_serializer{std::make_unique<V1TransportSerializer>(V1TransportSerializer())},
       m_permission_flags{node_opts.permission_flags},
       m_sock{sock},
@@ -2760,6 +2975,9 @@ CNode::CNode(NodeId idIn,
         mapRecvBytesPerMsgType[msg] = 0;
     mapRecvBytesPerMsgType[NET_MESSAGE_TYPE_OTHER] = 0;
 
+    // New peers must sort after any previously handed-out getpeerinfo token.
+    BumpStatsSeq();
+
     if (fLogIPs) {
         LogPrint(BCLog::NET, "Added connection to %s peer=%d\n", m_addr_name, id);
     } else {
@@ -2775,6 +2993,7 @@ bool CConnman::NodeFullyConnected(const CNode* pnode)
 void CConnman::PushMessage(CNode* pnode, CSerializedNetMsg&& msg)
 {
     AssertLockNotHeld(m_total_bytes_sent_mutex);
+    if (pnode->m_compressed_relay) MaybeCompressMessage(msg);
     size_t nMessageSize = msg.data.size();
     LogPrint(BCLog::NET, "sending %s (%d bytes) peer=%d\n", msg.m_type, nMessageSize, pnode->GetId());
     if (gArgs.GetBoolArg("-capturemessages", false)) {
@@ -2805,8 +3024,62 @@ void CConnman::PushMessage(CNode* pnode, CSerializedNetMsg&& msg)
         pnode->nSendSize += nTotalSize;
 
         if (pnode->nSendSize > nSendBufferMaxSize) pnode->fPauseSend = true;
-        pnode->vSendMsg.push_back(std::move(serializedHeader));
-        if (nMessageSize) pnode->vSendMsg.push_back(std::move(msg.data));
+        pnode->vSendMsg.push_back(std::make_shared<const std::vector<unsigned char>>(std::move(serializedHeader)));
+        if (nMessageSize) pnode->vSendMsg.push_back(std::make_shared<const std::vector<unsigned char>>(std::move(msg.data)));
+
+        // If write queue empty, attempt "optimistic write"
+        if (optimisticSend) nBytesSent = SocketSendData(*pnode);
+    }
+    if (nBytesSent) RecordBytesSent(nBytesSent);
+}
+
+CSharedNetMsg CConnman::MakeSharedMsg(CSerializedNetMsg&& msg)
+{
+    // Every peer uses the V1 transport, whose header (including the payload
+    // checksum) does not depend on the peer, so it can be computed once here
+    // instead of once per peer in PushMessage.
+    std::vector<unsigned char> header;
+    V1TransportSerializer{}.prepareForTransport(msg, header);
+
+    CSharedNetMsg shared;
+    shared.m_type = std::move(msg.m_type);
+    shared.m_header = std::make_shared<const std::vector<unsigned char>>(std::move(header));
+    shared.m_data = std::make_shared<const std::vector<unsigned char>>(std::move(msg.data));
+    return shared;
+}
+
+void CConnman::PushMessage(CNode* pnode, const CSharedNetMsg& msg)
+{
+    AssertLockNotHeld(m_total_bytes_sent_mutex);
+    size_t nMessageSize = msg.m_data->size();
+    LogPrint(BCLog::NET, "sending %s (%d bytes) peer=%d\n", msg.m_type, nMessageSize, pnode->GetId());
+    if (gArgs.GetBoolArg("-capturemessages", false)) {
+        CaptureMessage(pnode->addr, msg.m_type, *msg.m_data, /*is_incoming=*/false);
+    }
+
+    TRACE6(net, outbound_message,
+        pnode->GetId(),
+        pnode->m_addr_name.c_str(),
+        pnode->ConnectionTypeAsString().c_str(),
+        msg.m_type.c_str(),
+        msg.m_data->size(),
+        msg.m_data->data()
+    );
+
+    size_t nTotalSize = nMessageSize + msg.m_header->size();
+
+    size_t nBytesSent = 0;
+    {
+        LOCK(pnode->cs_vSend);
+        bool optimisticSend(pnode->vSendMsg.empty());
+
+        //log total amount of bytes per message type
+        pnode->mapSendBytesPerMsgType[msg.m_type] += nTotalSize;
+        pnode->nSendSize += nTotalSize;
+
+        if (pnode->nSendSize > nSendBufferMaxSize) pnode->fPauseSend = true;
+        pnode->vSendMsg.push_back(msg.m_header);
+        if (nMessageSize) pnode->vSendMsg.push_back(msg.m_data);
 
         // If write queue empty, attempt "optimistic write"
         if (optimisticSend) nBytesSent = SocketSendData(*pnode);
@@ -29,6 +29,7 @@
 #include <util/check.h>
 #include <util/sock.h>
 
+#include <array>
 #include <atomic>
 #include <condition_variable>
 #include <cstdint>
@@ -82,6 +83,10 @@ static const bool DEFAULT_BLOCKSONLY = false;
 static const int64_t DEFAULT_PEER_CONNECT_TIMEOUT = 60;
 /** Number of file descriptors required for message capture **/
 static const int NUM_FDS_MESSAGE_CAPTURE = 1;
+/** Default number of message handler threads; peers are sharded across them by node id */
+static const int DEFAULT_MSGHANDLER_THREADS = 1;
+/** Default for -compressedrelay (advertise NODE_COMPRESSED_RELAY) */
+static const bool DEFAULT_COMPRESSED_RELAY = false;
 
 static constexpr bool DEFAULT_FORCEDNSSEED{false};
 static constexpr bool DEFAULT_DNSSEED{true};
@@ -122,6 +127,22 @@ struct CSerializedNetMsg {
     std::string m_type;
 };
 
+/**
+ * A serialized message whose bytes are shared between all peers it is queued
+ * to. The transport header (including the payload checksum) is computed once,
+ * and each peer's send queue merely references the same immutable buffers, so
+ * announcing a block to hundreds of peers does not copy the serialized block
+ * per peer. The buffers are freed when the last send queue releases them.
+ * Create via CConnman::MakeSharedMsg.
+ */
+struct CSharedNetMsg {
+    std::string m_type;
+    //! Pre-built transport header, including the payload checksum.
+    std::shared_ptr<const std::vector<unsigned char>> m_header;
+    //! Serialized payload.
+    std::shared_ptr<const std::vector<unsigned char>> m_data;
+};
+
 /**
  * Look up IP addresses from all interfaces on the machine and add them to the
  * list of local addresses to self-advertise.
@@ -218,6 +239,9 @@ public:
     Network m_network;
     uint32_t m_mapped_as;
     ConnectionType m_conn_type;
+    // Position of the peer's last statistics change in the global change
+    // sequence; compared against getpeerinfo's changed_since token.
+    uint64_t m_stats_seq;
 };
 
 
@@ -263,10 +287,13 @@ class V1TransportDeserializer final : public TransportDeserializer
 private:
     const CChainParams& m_chain_params;
     const NodeId m_node_id; // Only for logging
+    //! Whether to skip hashing the payload and verifying its checksum
+    //! (NetPermissionFlags::NoChecksum). Header checks still apply.
+    const bool m_skip_checksum;
     mutable CHash256 hasher;
     mutable uint256 data_hash;
     bool in_data;                   // parsing header (false) or data (true)
-    CDataStream hdrbuf;             // partially received header
+    std::array<uint8_t, CMessageHeader::HEADER_SIZE> hdrbuf; // partially received header
     CMessageHeader hdr;             // complete header
     CDataStream vRecv;              // received message data
     unsigned int nHdrPos;
@@ -278,8 +305,6 @@ private:
 
     void Reset() {
         vRecv.clear();
-        hdrbuf.clear();
-        hdrbuf.resize(24);
         in_data = false;
         nHdrPos = 0;
         nDataPos = 0;
@@ -288,10 +313,10 @@ private:
     }
 
 public:
-    V1TransportDeserializer(const CChainParams& chain_params, const NodeId node_id, int nTypeIn, int nVersionIn)
+    V1TransportDeserializer(const CChainParams& chain_params, const NodeId node_id, int nTypeIn, int nVersionIn, bool skip_checksum = false)
         : m_chain_params(chain_params),
           m_node_id(node_id),
-          hdrbuf(nTypeIn, nVersionIn),
+          m_skip_checksum(skip_checksum),
           vRecv(nTypeIn, nVersionIn)
     {
         Reset();
@@ -305,7 +330,6 @@ public:
     }
     void SetVersion(int nVersionIn) override
     {
-        hdrbuf.SetVersion(nVersionIn);
         vRecv.SetVersion(nVersionIn);
     }
     int Read(Span<const uint8_t>& msg_bytes) override
@@ -369,7 +393,9 @@ public:
     /** Offset inside the first vSendMsg already sent */
     size_t nSendOffset GUARDED_BY(cs_vSend){0};
     uint64_t nSendBytes GUARDED_BY(cs_vSend){0};
-    std::deque<std::vector<unsigned char>> vSendMsg GUARDED_BY(cs_vSend);
+    /** Messages queued for sending. The buffers are immutable and may be
+     *  shared with other peers' send queues (see CSharedNetMsg). */
+    std::deque<std::shared_ptr<const std::vector<unsigned char>>> vSendMsg GUARDED_BY(cs_vSend);
     Mutex cs_vSend;
     Mutex m_sock_mutex;
     Mutex cs_vRecv;
@@ -488,6 +514,11 @@ public:
     // Peer selected us as (compact blocks) high-bandwidth peer (BIP152)
     std::atomic<bool> m_bip152_highbandwidth_from{false};
 
+    /** Whether compressed relay of large block/tx/headers payloads was
+     *  negotiated with this peer (both sides advertised
+     *  NODE_COMPRESSED_RELAY in the version handshake). */
+    std::atomic_bool m_compressed_relay{false};
+
     /** Whether this peer provides all services that we want. Used for eviction decisions */
     std::atomic_bool m_has_all_wanted_services{false};
 
@@ -521,6 +552,12 @@ public:
      * criterium in CConnman::AttemptToEvictConnection. */
     std::atomic<std::chrono::microseconds> m_min_ping_time{std::chrono::microseconds::max()};
 
+    /** Position of this peer's last statistics change in the global change
+     * sequence. Set from a process-wide monotonic counter by BumpStatsSeq(),
+     * so getpeerinfo's delta mode can skip peers whose stats a poller has
+     * already seen. */
+    std::atomic<uint64_t> m_stats_seq{0};
+
     CNode(NodeId id,
           std::shared_ptr<Sock> sock,
           const CAddress& addrIn,
@@ -588,6 +625,15 @@ public:
 
     void CopyStats(CNodeStats& stats) EXCLUSIVE_LOCKS_REQUIRED(!m_subver_mutex, !m_addr_local_mutex, !cs_vSend, !cs_vRecv);
 
+    /** Record that this peer's reported statistics changed.
+     *
+     * Every field reported by getpeerinfo only changes as a consequence of
+     * bytes being sent to or received from the peer (handshake, pings, block
+     * and transaction activity all involve traffic), so calling this from the
+     * socket send and receive paths is sufficient to keep the sequence fresh.
+     */
+    void BumpStatsSeq();
+
     std::string ConnectionTypeAsString() const { return ::ConnectionTypeAsString(m_conn_type); }
 
     /** A ping-pong round trip has completed successfully. Update latest and minimum ping times. */
@@ -693,6 +739,7 @@ public:
         std::vector<std::string> m_specified_outgoing;
         std::vector<std::string> m_added_nodes;
         bool m_i2p_accept_incoming;
+        int m_msgproc_threads = DEFAULT_MSGHANDLER_THREADS;
     };
 
     void Init(const Options& connOptions) EXCLUSIVE_LOCKS_REQUIRED(!m_added_nodes_mutex, !m_total_bytes_sent_mutex)
@@ -713,6 +760,7 @@ public:
         nSendBufferMaxSize = connOptions.nSendBufferMaxSize;
         nReceiveFloodSize = connOptions.nReceiveFloodSize;
         m_peer_connect_timeout = std::chrono::seconds{connOptions.m_peer_connect_timeout};
+        m_msgproc_thread_count = std::max(1, connOptions.m_msgproc_threads);
         {
             LOCK(m_total_bytes_sent_mutex);
             nMaxOutboundLimit = connOptions.nMaxOutboundLimit;
@@ -751,6 +799,15 @@ public:
 
     void PushMessage(CNode* pnode, CSerializedNetMsg&& msg) EXCLUSIVE_LOCKS_REQUIRED(!m_total_bytes_sent_mutex);
 
+    /** Queue a shared message without copying its buffers; the same
+     *  CSharedNetMsg may be pushed to any number of peers. */
+    void PushMessage(CNode* pnode, const CSharedNetMsg& msg) EXCLUSIVE_LOCKS_REQUIRED(!m_total_bytes_sent_mutex);
+
+    /** Build a shareable message from a serialized one. Computes the
+     *  transport header and checksum once so the result can be queued to
+     *  many peers without re-serializing. */
+    static CSharedNetMsg MakeSharedMsg(CSerializedNetMsg&& msg);
+
     using NodeFn = std::function<void(CNode*)>;
     void ForEachNode(const NodeFn& func)
     {
@@ -890,7 +947,7 @@ private:
     void AddAddrFetch(const std::string& strDest) EXCLUSIVE_LOCKS_REQUIRED(!m_addr_fetches_mutex);
     void ProcessAddrFetch() EXCLUSIVE_LOCKS_REQUIRED(!m_addr_fetches_mutex);
     void ThreadOpenConnections(std::vector<std::string> connect) EXCLUSIVE_LOCKS_REQUIRED(!m_addr_fetches_mutex, !m_added_nodes_mutex, !m_nodes_mutex);
-    void ThreadMessageHandler() EXCLUSIVE_LOCKS_REQUIRED(!mutexMsgProc);
+    void ThreadMessageHandler(size_t shard) EXCLUSIVE_LOCKS_REQUIRED(!mutexMsgProc);
     void ThreadI2PAcceptIncoming();
     void AcceptConnection(const ListenSocket& hListenSocket);
 
@@ -1081,8 +1138,9 @@ private:
     /** SipHasher seeds for deterministic randomness */
     const uint64_t nSeed0, nSeed1;
 
-    /** flag for waking the message processor. */
-    bool fMsgProcWake GUARDED_BY(mutexMsgProc);
+    /** Per-thread flags for waking the message processors. All of them are set
+     * on a wake, since the waker does not know which shard a peer belongs to. */
+    std::vector<bool> fMsgProcWake GUARDED_BY(mutexMsgProc);
 
     std::condition_variable condMsgProc;
     Mutex mutexMsgProc;
@@ -1107,7 +1165,11 @@ private:
     std::thread threadSocketHandler;
     std::thread threadOpenAddedConnections;
     std::thread threadOpenConnections;
-    std::thread threadMessageHandler;
+    /** Message handler threads. Each peer is assigned to exactly one thread by
+     * node id, so messages from a single peer are always processed in order
+     * while different peers proceed in parallel. */
+    std::vector<std::thread> threadsMessageHandler;
+    int m_msgproc_thread_count{DEFAULT_MSGHANDLER_THREADS};
     std::thread threadI2PAcceptIncoming;
 
     /** flag for deciding to connect to an extra outbound peer,
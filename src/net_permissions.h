@@ -34,6 +34,13 @@ enum class NetPermissionFlags : uint32_t {
     // Can request addrs without hitting a privacy-preserving cache, and send us
     // unlimited amounts of addrs.
     Addr = (1U << 7),
+    // Skip verifying the payload checksum of received messages. The double-SHA256
+    // over every payload is computed on the socket thread and becomes the
+    // bottleneck on high-bandwidth links between nodes under common
+    // administration, where TCP already guarantees integrity. Never part of
+    // "all": it trades a defense-in-depth check for throughput and must be
+    // granted explicitly.
+    NoChecksum = (1U << 8),
 
     // True if the user did not specifically set fine grained permissions
     Implicit = (1U << 31),
@@ -5,6 +5,7 @@
 
 #include <net_processing.h>
 
+#include <addrdb.h>
 #include <addrman.h>
 #include <banman.h>
 #include <blockencodings.h>
@@ -12,6 +13,7 @@
 #include <chainparams.h>
 #include <consensus/amount.h>
 #include <consensus/validation.h>
+#include <crypto/common.h>
 #include <deploymentstatus.h>
 #include <hash.h>
 #include <headerssync.h>
@@ -20,7 +22,9 @@
 #include <netbase.h>
 #include <netmessagemaker.h>
 #include <node/blockstorage.h>
+#include <perfstats.h>
 #include <policy/fees.h>
+#include <pow.h>
 #include <policy/policy.h>
 #include <policy/settings.h>
 #include <primitives/block.h>
@@ -44,7 +48,9 @@
 #include <algorithm>
 #include <atomic>
 #include <chrono>
+#include <deque>
 #include <future>
+#include <limits>
 #include <memory>
 #include <optional>
 #include <typeinfo>
@@ -55,10 +61,10 @@ using node::fImporting;
 using node::fPruneMode;
 using node::fReindex;
 
-/** How long to cache transactions in mapRelay for normal relay */
-static constexpr auto RELAY_TX_CACHE_TIME = 15min;
-/** How long a transaction has to be in the mempool before it can unconditionally be relayed (even when not in mapRelay). */
-static constexpr auto UNCONDITIONAL_RELAY_DELAY = 2min;
+/** Rate at which a peer's misbehavior score decays: one point is forgiven per
+ *  this many seconds, so a full DISCOURAGEMENT_THRESHOLD drains in about an
+ *  hour. Only sustained misbehavior gets a warmed-up peer disconnected. */
+static constexpr int64_t MISBEHAVIOR_DECAY_SECONDS_PER_POINT{36};
 /** Headers download timeout.
  *  Timeout = base + per_header * (expected number of headers) */
 static constexpr auto HEADERS_DOWNLOAD_TIMEOUT_BASE = 15min;
@@ -77,6 +83,17 @@ static constexpr auto STALE_CHECK_INTERVAL{10min};
 static constexpr auto EXTRA_PEER_CHECK_INTERVAL{45s};
 /** Minimum time an outbound-peer-eviction candidate must be connected for, in order to evict */
 static constexpr auto MINIMUM_CONNECT_TIME{30s};
+/** At most one outbound peer is rotated for high latency per this interval */
+static constexpr auto LATENCY_ROTATION_INTERVAL{10min};
+/** Minimum connection age before a peer's latency is judged; the minimum ping
+ *  needs several round trips to settle */
+static constexpr auto LATENCY_ROTATION_MIN_CONNECT_TIME{10min};
+/** Outbound peers below this minimum ping are never rotated for latency */
+static constexpr auto LATENCY_ROTATION_MIN_PING{250ms};
+/** Rotate only when the worst minimum ping exceeds this multiple of the median */
+static constexpr int LATENCY_ROTATION_FACTOR{4};
+/** Minimum number of latency-measured outbound peers for rotation to apply */
+static constexpr size_t LATENCY_ROTATION_MIN_PEERS{4};
 /** SHA256("main address relay")[0:8] */
 static constexpr uint64_t RANDOMIZER_ID_ADDRESS_RELAY = 0x3cac0035b5866b90ULL;
 /// Age after which a stale block will no longer be served if requested as
@@ -111,6 +128,11 @@ static constexpr auto GETDATA_TX_INTERVAL{60s};
 static const unsigned int MAX_GETDATA_SZ = 1000;
 /** Number of blocks that can be requested at any given time from a single peer. */
 static const int MAX_BLOCKS_IN_TRANSIT_PER_PEER = 16;
+/** Maximum number of addresses remembered in blockhistory.dat. */
+static constexpr size_t MAX_BLOCK_HISTORY_SIZE{4096};
+/** Minimum number of recorded delivery samples before a persisted average
+ *  seeds a reconnecting peer's delivery-time estimate. */
+static constexpr uint64_t MIN_BLOCK_HISTORY_SAMPLES{4};
 /** Time during which a peer must stall block download progress before being disconnected. */
 static constexpr auto BLOCK_STALLING_TIMEOUT{2s};
 /** Number of headers sent in one getheaders result. We rely on the assumption that if a peer sends
@@ -154,13 +176,6 @@ static constexpr auto OUTBOUND_INVENTORY_BROADCAST_INTERVAL{2s};
 static constexpr unsigned int INVENTORY_BROADCAST_PER_SECOND = 7;
 /** Maximum number of inventory items to send per transmission. */
 static constexpr unsigned int INVENTORY_BROADCAST_MAX = INVENTORY_BROADCAST_PER_SECOND * count_seconds(INBOUND_INVENTORY_BROADCAST_INTERVAL);
-/** The number of most recently announced transactions a peer can request. */
-static constexpr unsigned int INVENTORY_MAX_RECENT_RELAY = 3500;
-/** Verify that INVENTORY_MAX_RECENT_RELAY is enough to cache everything typically
- *  relayed before unconditional relay from the mempool kicks in. This is only a
- *  lower bound, and it should be larger to account for higher inv rate to outbound
- *  peers, and random variations in the broadcast mechanism. */
-static_assert(INVENTORY_MAX_RECENT_RELAY >= INVENTORY_BROADCAST_PER_SECOND * UNCONDITIONAL_RELAY_DELAY / std::chrono::seconds{1}, "INVENTORY_RELAY_MAX too low");
 /** Average delay between feefilter broadcasts in seconds. */
 static constexpr auto AVG_FEEFILTER_BROADCAST_INTERVAL{10min};
 /** Maximum feefilter broadcast delay after significant change. */
@@ -169,6 +184,8 @@ static constexpr auto MAX_FEEFILTER_CHANGE_DELAY{5min};
 static constexpr uint32_t MAX_GETCFILTERS_SIZE = 1000;
 /** Maximum number of cf hashes that may be requested with one getcfheaders. See BIP 157. */
 static constexpr uint32_t MAX_GETCFHEADERS_SIZE = 2000;
+/** Maximum total serialized size of the cfilter response cache. */
+static constexpr size_t CFILTER_CACHE_MAX_BYTES{8 * 1024 * 1024};
 /** the maximum percentage of addresses from our addrman to return in response to a getaddr message. */
 static constexpr size_t MAX_PCT_ADDR_TO_SEND = 23;
 /** The maximum number of address records permitted in an ADDR message. */
@@ -226,12 +243,16 @@ struct Peer {
     /** Services this peer offered to us. */
     std::atomic<ServiceFlags> m_their_services{NODE_NONE};
 
-    /** Protects misbehavior data members */
-    Mutex m_misbehavior_mutex;
-    /** Accumulated misbehavior score for this peer */
-    int m_misbehavior_score GUARDED_BY(m_misbehavior_mutex){0};
+    /** Accumulated misbehavior score for this peer. Maintained as a decaying
+     *  token bucket: Misbehaving() adds to it and drains it at a fixed rate
+     *  (see MISBEHAVIOR_DECAY_SECONDS_PER_POINT), so a long-lived peer is not
+     *  disconnected for transient glitches spread over hours. Atomic because
+     *  Misbehaving() is called in-line on hot parse paths. */
+    std::atomic<int> m_misbehavior_score{0};
+    /** Time (unix, seconds) up to which decay has been applied to m_misbehavior_score. */
+    std::atomic<int64_t> m_misbehavior_last_decay{0};
     /** Whether this peer should be disconnected and marked as discouraged (unless it has NetPermissionFlags::NoBan permission). */
-    bool m_should_discourage GUARDED_BY(m_misbehavior_mutex){false};
+    std::atomic<bool> m_should_discourage{false};
 
     /** Protects block inventory data members */
     Mutex m_block_inv_mutex;
@@ -287,15 +308,22 @@ struct Peer {
          *  the same txid/wtxid to a peer that already has the transaction. */
         CRollingBloomFilter m_tx_inventory_known_filter GUARDED_BY(m_tx_inventory_mutex){50000, 0.000001};
         /** Set of transaction ids we still have to announce (txid for
-         *  non-wtxid-relay peers, wtxid for wtxid-relay peers). We use the
-         *  mempool to sort transactions in dependency order before relay, so
-         *  this does not have to be sorted. */
+         *  non-wtxid-relay peers, wtxid for wtxid-relay peers). Filled at
+         *  trickle time from the shared relay log (see m_tx_relay_log) and
+         *  only touched by this peer's message handler, so it is no longer a
+         *  cross-thread contention point. We use the mempool to sort
+         *  transactions in dependency order before relay, so this does not
+         *  have to be sorted. */
         std::set<uint256> m_tx_inventory_to_send GUARDED_BY(m_tx_inventory_mutex);
+        /** Sequence number of the next entry of the shared relay log this
+         *  peer has yet to consume. Initialized to the log end at the first
+         *  trickle after the version handshake, so transactions that arrived
+         *  during the handshake are never announced (their arrival time must
+         *  not leak to a spy). */
+        uint64_t m_relay_log_pos GUARDED_BY(m_tx_inventory_mutex){std::numeric_limits<uint64_t>::max()};
         /** Whether the peer has requested us to send our complete mempool. Only
          *  permitted if the peer has NetPermissionFlags::Mempool. See BIP35. */
         bool m_send_mempool GUARDED_BY(m_tx_inventory_mutex){false};
-        /** The last time a BIP35 `mempool` request was serviced. */
-        std::atomic<std::chrono::seconds> m_last_mempool_req{0s};
         /** The next time after which we will send an `inv` message containing
          *  transaction announcements to this peer. */
         std::chrono::microseconds m_next_inv_send_time{0};
@@ -433,6 +461,14 @@ struct CNodeState {
     std::list<QueuedBlock> vBlocksInFlight;
     //! When the first entry in vBlocksInFlight started downloading. Don't care when vBlocksInFlight is empty.
     std::chrono::microseconds m_downloading_since{0us};
+    //! Exponential moving average of this peer's per-block delivery time, or 0
+    //! if no block has been delivered yet. Used to size the in-flight window.
+    //! Seeded from the persisted per-address history on connect.
+    std::chrono::microseconds m_avg_block_delivery{0us};
+    //! Number of delivery-time samples folded into m_avg_block_delivery in
+    //! this session (excludes any persisted history the average was seeded
+    //! from).
+    uint64_t m_delivery_samples{0};
     int nBlocksInFlight{0};
     //! Whether we consider this a preferred download peer.
     bool fPreferredDownload{false};
@@ -486,8 +522,11 @@ struct CNodeState {
     //! Whether this peer is an inbound connection
     const bool m_is_inbound;
 
-    //! A rolling bloom filter of all announced tx CInvs to this peer.
-    CRollingBloomFilter m_recently_announced_invs = CRollingBloomFilter{INVENTORY_MAX_RECENT_RELAY, 0.000001};
+    //! The mempool sequence number observed when we last sent this peer a
+    //! batch of transaction INVs. The peer may request any mempool
+    //! transaction with a lower entry sequence: it was either announced in
+    //! one of those batches or deliberately skipped (e.g. by its fee filter).
+    uint64_t m_last_inv_sequence{1};
 
     CNodeState(bool is_inbound) : m_is_inbound(is_inbound) {}
 };
@@ -498,6 +537,7 @@ public:
     PeerManagerImpl(CConnman& connman, AddrMan& addrman,
                     BanMan* banman, ChainstateManager& chainman,
                     CTxMemPool& pool, bool ignore_incoming_txs);
+    ~PeerManagerImpl();
 
     /** Overridden from CValidationInterface. */
     void BlockConnected(const std::shared_ptr<const CBlock>& pblock, const CBlockIndex* pindexConnected) override
@@ -515,7 +555,7 @@ public:
     void InitializeNode(CNode& node, ServiceFlags our_services) override EXCLUSIVE_LOCKS_REQUIRED(!m_peer_mutex);
     void FinalizeNode(const CNode& node) override EXCLUSIVE_LOCKS_REQUIRED(!m_peer_mutex, !m_headers_presync_mutex);
     bool ProcessMessages(CNode* pfrom, std::atomic<bool>& interrupt) override
-        EXCLUSIVE_LOCKS_REQUIRED(!m_peer_mutex, !m_recent_confirmed_transactions_mutex, !m_most_recent_block_mutex, !m_headers_presync_mutex);
+        EXCLUSIVE_LOCKS_REQUIRED(!m_peer_mutex, !m_recent_confirmed_transactions_mutex, !m_most_recent_block_mutex, !m_headers_presync_mutex, !m_cfilter_cache_mutex);
     bool SendMessages(CNode* pto) override EXCLUSIVE_LOCKS_REQUIRED(pto->cs_sendProcessing)
         EXCLUSIVE_LOCKS_REQUIRED(!m_peer_mutex, !m_recent_confirmed_transactions_mutex, !m_most_recent_block_mutex);
 
@@ -527,12 +567,12 @@ public:
     bool GetNodeStateStats(NodeId nodeid, CNodeStateStats& stats) const override EXCLUSIVE_LOCKS_REQUIRED(!m_peer_mutex);
     bool IgnoresIncomingTxs() override { return m_ignore_incoming_txs; }
     void SendPings() override EXCLUSIVE_LOCKS_REQUIRED(!m_peer_mutex);
-    void RelayTransaction(const uint256& txid, const uint256& wtxid) override EXCLUSIVE_LOCKS_REQUIRED(!m_peer_mutex);
+    void RelayTransaction(const uint256& txid, const uint256& wtxid) override EXCLUSIVE_LOCKS_REQUIRED(!m_relay_log_mutex);
     void SetBestHeight(int height) override { m_best_height = height; };
     void UnitTestMisbehaving(NodeId peer_id, int howmuch) override EXCLUSIVE_LOCKS_REQUIRED(!m_peer_mutex) { Misbehaving(*Assert(GetPeerRef(peer_id)), howmuch, ""); };
     void ProcessMessage(CNode& pfrom, const std::string& msg_type, CDataStream& vRecv,
                         const std::chrono::microseconds time_received, const std::atomic<bool>& interruptMsgProc) override
-        EXCLUSIVE_LOCKS_REQUIRED(!m_peer_mutex, !m_recent_confirmed_transactions_mutex, !m_most_recent_block_mutex, !m_headers_presync_mutex);
+        EXCLUSIVE_LOCKS_REQUIRED(!m_peer_mutex, !m_recent_confirmed_transactions_mutex, !m_most_recent_block_mutex, !m_headers_presync_mutex, !m_cfilter_cache_mutex);
     void UpdateLastBlockAnnounceTime(NodeId node, int64_t time_in_seconds) override;
 
 private:
@@ -542,6 +582,11 @@ private:
     /** If we have extra outbound peers, try to disconnect the one with the oldest block announcement */
     void EvictExtraOutboundPeers(std::chrono::seconds now) EXCLUSIVE_LOCKS_REQUIRED(cs_main);
 
+    /** Disconnect the outbound-full-relay peer whose minimum ping time is an
+     *  outlier among our outbound peers, so its slot is refilled from addrman.
+     *  Rate-limited to one rotation per LATENCY_ROTATION_INTERVAL. */
+    void RotateHighLatencyPeer(std::chrono::seconds now) EXCLUSIVE_LOCKS_REQUIRED(cs_main);
+
     /** Retrieve unbroadcast transactions from the mempool and reattempt sending to peers */
     void ReattemptInitialBroadcast(CScheduler& scheduler) EXCLUSIVE_LOCKS_REQUIRED(!m_peer_mutex);
 
@@ -603,8 +648,10 @@ private:
                                bool via_compact_block)
         EXCLUSIVE_LOCKS_REQUIRED(!m_peer_mutex, !m_headers_presync_mutex);
     /** Various helpers for headers processing, invoked by ProcessHeadersMessage() */
-    /** Return true if headers are continuous and have valid proof-of-work (DoS points assigned on failure) */
-    bool CheckHeadersPoW(const std::vector<CBlockHeader>& headers, const Consensus::Params& consensusParams, Peer& peer);
+    /** Return true if headers are continuous and have valid proof-of-work (DoS points assigned on failure).
+     *  If verify_pow is false only the cheap continuity check is performed; callers must
+     *  ensure full verification happens before the headers are stored. */
+    bool CheckHeadersPoW(const std::vector<CBlockHeader>& headers, const Consensus::Params& consensusParams, Peer& peer, bool verify_pow = true);
     /** Calculate an anti-DoS work threshold for headers chains */
     arith_uint256 GetAntiDoSWorkThreshold();
     /** Deal with state tracking and headers sync for peers that send the
@@ -715,6 +762,9 @@ private:
     /** Next time to check for stale tip */
     std::chrono::seconds m_stale_tip_check_time GUARDED_BY(cs_main){0s};
 
+    /** Earliest time another outbound peer may be rotated for high latency */
+    std::chrono::seconds m_latency_rotation_time GUARDED_BY(cs_main){0s};
+
     /** Whether this node is running in -blocksonly mode */
     const bool m_ignore_incoming_txs;
 
@@ -735,6 +785,30 @@ private:
      */
     std::map<NodeId, PeerRef> m_peer_map GUARDED_BY(m_peer_mutex);
 
+    /** One entry of the shared transaction announcement log. Both hashes are
+     *  kept because the announced hash depends on the peer's wtxid-relay
+     *  state. */
+    struct TxRelayLogEntry {
+        uint256 txid;
+        uint256 wtxid;
+    };
+    /** Bound on m_tx_relay_log growth if trimming lags; a peer whose cursor
+     *  falls behind this many announcements skips the overwritten ones. */
+    static constexpr size_t MAX_TX_RELAY_LOG_ENTRIES{65536};
+    mutable Mutex m_relay_log_mutex;
+    /** Shared log of transactions to announce. RelayTransaction() appends one
+     *  entry here (multi-producer) instead of taking every peer's inventory
+     *  lock, and each peer's message handler consumes the log by cursor
+     *  (single consumer per cursor) at its trickle interval, where per-peer
+     *  filtering happens. Trimmed up to the slowest cursor from
+     *  CheckForStaleTipAndEvictPeers(). */
+    std::deque<TxRelayLogEntry> m_tx_relay_log GUARDED_BY(m_relay_log_mutex);
+    /** Sequence number of the first entry in m_tx_relay_log. */
+    uint64_t m_relay_log_start GUARDED_BY(m_relay_log_mutex){0};
+
+    /** Drop relay log entries that every peer has consumed. */
+    void TrimTxRelayLog() EXCLUSIVE_LOCKS_REQUIRED(!m_peer_mutex, !m_relay_log_mutex);
+
     /** Map maintaining per-node state. */
     std::map<NodeId, CNodeState> m_node_states GUARDED_BY(cs_main);
 
@@ -843,6 +917,28 @@ private:
     std::shared_ptr<const CBlock> m_most_recent_block GUARDED_BY(m_most_recent_block_mutex);
     std::shared_ptr<const CBlockHeaderAndShortTxIDs> m_most_recent_compact_block GUARDED_BY(m_most_recent_block_mutex);
     uint256 m_most_recent_block_hash GUARDED_BY(m_most_recent_block_mutex);
+    /** Serialized CMPCTBLOCK message for m_most_recent_compact_block, built on
+     *  first use so the same bytes are queued to every announced peer. */
+    std::optional<CSharedNetMsg> m_most_recent_cmpctblock_msg GUARDED_BY(m_most_recent_block_mutex);
+
+    /** A cached, fully serialized CFILTER response (transport header and
+     *  checksum included), shared between the send queues of every peer that
+     *  requests the same filter. */
+    struct CachedCFilterMsg {
+        BlockFilterType filter_type;
+        CSharedNetMsg msg;
+    };
+    /** Mutex guarding the cfilter response cache. */
+    Mutex m_cfilter_cache_mutex;
+    /** Cache of recently served cfilter messages by block hash. Light clients
+     *  tend to request the same (recent) ranges, so popular ranges are served
+     *  without touching the filter index or re-serializing filter bytes.
+     *  Bounded by CFILTER_CACHE_MAX_BYTES with oldest-first eviction. */
+    std::unordered_map<uint256, CachedCFilterMsg, BlockHasher> m_cfilter_cache GUARDED_BY(m_cfilter_cache_mutex);
+    /** Block hashes in m_cfilter_cache, in insertion order. */
+    std::deque<uint256> m_cfilter_cache_order GUARDED_BY(m_cfilter_cache_mutex);
+    /** Total serialized bytes held by m_cfilter_cache. */
+    size_t m_cfilter_cache_bytes GUARDED_BY(m_cfilter_cache_mutex){0};
 
     // Data about the low-work headers synchronization, aggregated from all peers' HeadersSyncStates.
     /** Mutex guarding the other m_headers_presync_* variables. */
@@ -887,13 +983,27 @@ private:
      */
     void FindNextBlocksToDownload(const Peer& peer, unsigned int count, std::vector<const CBlockIndex*>& vBlocks, NodeId& nodeStaller) EXCLUSIVE_LOCKS_REQUIRED(cs_main);
 
+    /** How many blocks we are willing to have in flight from this peer, based
+     *  on its measured delivery rate relative to all download peers. */
+    unsigned int BlockDownloadWindow(const CNodeState& state) const EXCLUSIVE_LOCKS_REQUIRED(cs_main);
+
     std::map<uint256, std::pair<NodeId, std::list<QueuedBlock>::iterator> > mapBlocksInFlight GUARDED_BY(cs_main);
 
+    /** Exponential moving average of block delivery times across all download
+     *  peers, or 0 if no block has been delivered yet. */
+    std::chrono::microseconds m_avg_block_delivery GUARDED_BY(cs_main){0us};
+
+    /** Per-address block delivery performance carried across restarts
+     *  (blockhistory.dat, stored alongside peers.dat). Seeds the delivery
+     *  average of reconnecting peers and absorbs their updated averages when
+     *  they disconnect. */
+    PeerBlockHistory m_block_history GUARDED_BY(cs_main);
+
     /** When our tip was last updated. */
     std::atomic<std::chrono::seconds> m_last_tip_update{0s};
 
     /** Determine whether or not a peer can request a transaction, and return it (or nullptr if not found or not allowed). */
-    CTransactionRef FindTxForGetData(const CNode& peer, const GenTxid& gtxid, const std::chrono::seconds mempool_req, const std::chrono::seconds now) LOCKS_EXCLUDED(cs_main);
+    CTransactionRef FindTxForGetData(const CNode& peer, const GenTxid& gtxid) LOCKS_EXCLUDED(cs_main);
 
     void ProcessGetData(CNode& pfrom, Peer& peer, const std::atomic<bool>& interruptMsgProc)
         EXCLUSIVE_LOCKS_REQUIRED(!m_most_recent_block_mutex, peer.m_getdata_requests_mutex) LOCKS_EXCLUDED(::cs_main);
@@ -901,12 +1011,6 @@ private:
     /** Process a new block. Perform any post-processing housekeeping */
     void ProcessBlock(CNode& node, const std::shared_ptr<const CBlock>& block, bool force_processing, bool min_pow_checked);
 
-    /** Relay map (txid or wtxid -> CTransactionRef) */
-    typedef std::map<uint256, CTransactionRef> MapRelay;
-    MapRelay mapRelay GUARDED_BY(cs_main);
-    /** Expiration-time ordered list of (expire time, relay map entry) pairs. */
-    std::deque<std::pair<std::chrono::microseconds, MapRelay::iterator>> g_relay_expiration GUARDED_BY(cs_main);
-
     /**
      * When a peer sends us a valid block, instruct it to announce blocks to us
      * using CMPCTBLOCK if possible by adding its nodeid to the end of
@@ -980,7 +1084,7 @@ private:
      * @param[in]   peer            The peer that we received the request from
      * @param[in]   vRecv           The raw message received
      */
-    void ProcessGetCFilters(CNode& node, Peer& peer, CDataStream& vRecv);
+    void ProcessGetCFilters(CNode& node, Peer& peer, CDataStream& vRecv) EXCLUSIVE_LOCKS_REQUIRED(!m_cfilter_cache_mutex);
 
     /**
      * Handle a cfheaders request.
@@ -1066,6 +1170,138 @@ static void AddKnownTx(Peer& peer, const uint256& hash)
     tx_relay->m_tx_inventory_known_filter.insert(hash);
 }
 
+/** Txid and wtxid of a serialized transaction, computed by ShallowHashTx(). */
+struct ShallowTxHashes {
+    uint256 txid;
+    uint256 wtxid;
+};
+
+/** Compute the txid and wtxid of a serialized transaction directly from its
+ *  bytes, without constructing a CTransaction. Used to deduplicate incoming
+ *  transactions before paying for a full deserialization. The parser mirrors
+ *  UnserializeTransaction() exactly, including the rejection of non-canonical
+ *  compact sizes and of superfluous witness records, so std::nullopt is only
+ *  returned for encodings the deserializer would reject as well. Trailing
+ *  bytes after the transaction are ignored, as they are by stream extraction.
+ */
+static std::optional<ShallowTxHashes> ShallowHashTx(Span<const unsigned char> data)
+{
+    size_t pos{0};
+    // Equivalent of ReadCompactSize(s, /*range_check=*/true).
+    const auto read_compact_size = [&]() -> std::optional<uint64_t> {
+        if (pos >= data.size()) return std::nullopt;
+        const uint8_t first{data[pos++]};
+        uint64_t ret{first};
+        if (first == 253) {
+            if (data.size() - pos < 2) return std::nullopt;
+            ret = ReadLE16(data.data() + pos);
+            pos += 2;
+            if (ret < 253) return std::nullopt;
+        } else if (first == 254) {
+            if (data.size() - pos < 4) return std::nullopt;
+            ret = ReadLE32(data.data() + pos);
+            pos += 4;
+            if (ret < 0x10000) return std::nullopt;
+        } else if (first == 255) {
+            if (data.size() - pos < 8) return std::nullopt;
+            ret = ReadLE64(data.data() + pos);
+            pos += 8;
+            if (ret < 0x100000000ULL) return std::nullopt;
+        }
+        if (ret > MAX_SIZE) return std::nullopt;
+        return ret;
+    };
+    const auto skip = [&](uint64_t n) -> bool {
+        if (data.size() - pos < n) return false;
+        pos += n;
+        return true;
+    };
+    const auto skip_inputs = [&](uint64_t count) -> bool {
+        for (uint64_t i = 0; i < count; ++i) {
+            // COutPoint, scriptSig, nSequence
+            if (!skip(36)) return false;
+            const auto script_len{read_compact_size()};
+            if (!script_len || !skip(*script_len)) return false;
+            if (!skip(4)) return false;
+        }
+        return true;
+    };
+    const auto skip_outputs = [&]() -> bool {
+        const auto count{read_compact_size()};
+        if (!count) return false;
+        for (uint64_t i = 0; i < *count; ++i) {
+            // nValue, scriptPubKey
+            if (!skip(8)) return false;
+            const auto script_len{read_compact_size()};
+            if (!script_len || !skip(*script_len)) return false;
+        }
+        return true;
+    };
+
+    if (!skip(4)) return std::nullopt; // nVersion
+    const auto vin_count{read_compact_size()};
+    if (!vin_count) return std::nullopt;
+    bool segwit{false};
+    size_t body_begin{0}; // Start of the real vin in the extended format
+    uint64_t n_inputs{*vin_count};
+    if (n_inputs == 0) {
+        // We read a dummy or an empty vin; the next byte is the flags field.
+        if (pos >= data.size()) return std::nullopt;
+        const unsigned char flags{data[pos++]};
+        if (flags == 1) {
+            segwit = true;
+            body_begin = pos;
+            const auto real_vin_count{read_compact_size()};
+            if (!real_vin_count) return std::nullopt;
+            n_inputs = *real_vin_count;
+            if (!skip_inputs(n_inputs) || !skip_outputs()) return std::nullopt;
+        } else if (flags != 0) {
+            // Unknown flag in the serialization
+            return std::nullopt;
+        }
+        // flags == 0: an empty vin followed by no vout; only nLockTime is left.
+    } else {
+        if (!skip_inputs(n_inputs) || !skip_outputs()) return std::nullopt;
+    }
+
+    const size_t witness_begin{pos};
+    if (segwit) {
+        bool any_witness{false};
+        for (uint64_t i = 0; i < n_inputs; ++i) {
+            const auto n_items{read_compact_size()};
+            if (!n_items) return std::nullopt;
+            if (*n_items > 0) any_witness = true;
+            for (uint64_t j = 0; j < *n_items; ++j) {
+                const auto item_len{read_compact_size()};
+                if (!item_len || !skip(*item_len)) return std::nullopt;
+            }
+        }
+        // It's illegal to encode witnesses when all witness stacks are empty.
+        if (!any_witness) return std::nullopt;
+    }
+    const size_t locktime_begin{pos};
+    if (!skip(4)) return std::nullopt; // nLockTime
+
+    ShallowTxHashes ret;
+    {
+        HashWriter ss{};
+        ss.write(MakeByteSpan(data.first(pos)));
+        ret.wtxid = ss.GetHash();
+    }
+    if (segwit) {
+        // The txid commits to the basic format: nVersion and vin/vout with
+        // the dummy, flags and witness sections spliced out.
+        HashWriter ss{};
+        ss.write(MakeByteSpan(data.first(4)));
+        ss.write(MakeByteSpan(data.subspan(body_begin, witness_begin - body_begin)));
+        ss.write(MakeByteSpan(data.subspan(locktime_begin, 4)));
+        ret.txid = ss.GetHash();
+    } else {
+        ret.txid = ret.wtxid;
+    }
+    return ret;
+}
+
 /** Whether this peer can serve us blocks. */
 static bool CanServeBlocks(const Peer& peer)
 {
@@ -1116,8 +1352,19 @@ void PeerManagerImpl::RemoveBlockRequest(const uint256& hash)
     assert(state != nullptr);
 
     if (state->vBlocksInFlight.begin() == list_it) {
+        const auto now{GetTime<std::chrono::microseconds>()};
+        // Take the time this block spent at the head of the queue as a
+        // delivery-time sample for the peer. Blocks removed because someone
+        // else delivered them first also count, which correctly penalizes the
+        // slower peer.
+        if (state->m_downloading_since > 0us && now > state->m_downloading_since) {
+            const auto sample{now - state->m_downloading_since};
+            state->m_avg_block_delivery = state->m_avg_block_delivery == 0us ? sample : (3 * state->m_avg_block_delivery + sample) / 4;
+            state->m_delivery_samples++;
+            m_avg_block_delivery = m_avg_block_delivery == 0us ? sample : (15 * m_avg_block_delivery + sample) / 16;
+        }
         // First block on the queue was received, update the start download time for the next one
-        state->m_downloading_since = std::max(state->m_downloading_since, GetTime<std::chrono::microseconds>());
+        state->m_downloading_since = std::max(state->m_downloading_since, now);
     }
     state->vBlocksInFlight.erase(list_it);
 
@@ -1279,6 +1526,21 @@ void PeerManagerImpl::UpdateBlockAvailability(NodeId nodeid, const uint256 &hash
     }
 }
 
+unsigned int PeerManagerImpl::BlockDownloadWindow(const CNodeState& state) const
+{
+    AssertLockHeld(cs_main);
+    if (state.m_avg_block_delivery == 0us || m_avg_block_delivery == 0us) {
+        return MAX_BLOCKS_IN_TRANSIT_PER_PEER;
+    }
+    // Scale the in-flight window down for peers that deliver measurably slower
+    // than the average download peer, so one slow peer cannot pin a full
+    // window's worth of blocks and stall the moving tip window. Keep a floor
+    // so slow peers continue to produce samples and can recover.
+    if (state.m_avg_block_delivery >= 4 * m_avg_block_delivery) return MAX_BLOCKS_IN_TRANSIT_PER_PEER / 4;
+    if (state.m_avg_block_delivery >= 2 * m_avg_block_delivery) return MAX_BLOCKS_IN_TRANSIT_PER_PEER / 2;
+    return MAX_BLOCKS_IN_TRANSIT_PER_PEER;
+}
+
 void PeerManagerImpl::FindNextBlocksToDownload(const Peer& peer, unsigned int count, std::vector<const CBlockIndex*>& vBlocks, NodeId& nodeStaller)
 {
     if (count == 0)
@@ -1432,7 +1694,14 @@ void PeerManagerImpl::InitializeNode(CNode& node, ServiceFlags our_services)
     NodeId nodeid = node.GetId();
     {
         LOCK(cs_main);
-        m_node_states.emplace_hint(m_node_states.end(), std::piecewise_construct, std::forward_as_tuple(nodeid), std::forward_as_tuple(node.IsInboundConn()));
+        auto it = m_node_states.emplace_hint(m_node_states.end(), std::piecewise_construct, std::forward_as_tuple(nodeid), std::forward_as_tuple(node.IsInboundConn()));
+        // Seed the delivery-time average from the persisted history, so the
+        // block download window is sized sensibly from the first request
+        // instead of re-learning a known peer's speed from scratch.
+        const auto hist = m_block_history.find(node.addr);
+        if (hist != m_block_history.end() && hist->second.samples >= MIN_BLOCK_HISTORY_SAMPLES) {
+            it->second.m_avg_block_delivery = std::chrono::microseconds{hist->second.avg_block_delivery_us};
+        }
         assert(m_txrequest.Count(nodeid) == 0);
     }
     PeerRef peer = std::make_shared<Peer>(nodeid, our_services);
@@ -1479,7 +1748,7 @@ void PeerManagerImpl::FinalizeNode(const CNode& node)
         // destructed.
         PeerRef peer = RemovePeer(nodeid);
         assert(peer != nullptr);
-        misbehavior = WITH_LOCK(peer->m_misbehavior_mutex, return peer->m_misbehavior_score);
+        misbehavior = peer->m_misbehavior_score.load();
         m_wtxid_relay_peers -= peer->m_wtxid_relay;
         assert(m_wtxid_relay_peers >= 0);
     }
@@ -1500,6 +1769,19 @@ void PeerManagerImpl::FinalizeNode(const CNode& node)
     m_outbound_peers_with_protect_from_disconnect -= state->m_chain_sync.m_protect;
     assert(m_outbound_peers_with_protect_from_disconnect >= 0);
 
+    if (state->m_delivery_samples > 0 && node.addr.IsRoutable()) {
+        // Fold the peer's measured delivery time into the persistent history.
+        if (m_block_history.size() >= MAX_BLOCK_HISTORY_SIZE && m_block_history.count(node.addr) == 0) {
+            // Evict the slowest remembered address; the fast ones are the
+            // peers worth recognizing after a restart.
+            m_block_history.erase(std::max_element(m_block_history.begin(), m_block_history.end(),
+                [](const auto& a, const auto& b) { return a.second.avg_block_delivery_us < b.second.avg_block_delivery_us; }));
+        }
+        PeerBlockHistoryEntry& entry = m_block_history[node.addr];
+        entry.avg_block_delivery_us = count_microseconds(state->m_avg_block_delivery);
+        entry.samples += state->m_delivery_samples;
+    }
+
     m_node_states.erase(nodeid);
 
     if (m_node_states.empty()) {
@@ -1613,10 +1895,25 @@ void PeerManagerImpl::Misbehaving(Peer& peer, int howmuch, const std::string& me
 {
     assert(howmuch > 0);
 
-    LOCK(peer.m_misbehavior_mutex);
-    const int score_before{peer.m_misbehavior_score};
-    peer.m_misbehavior_score += howmuch;
-    const int score_now{peer.m_misbehavior_score};
+    // Drain the token bucket before adding to it. The thread that advances
+    // m_misbehavior_last_decay (by whole decay intervals, so sub-interval
+    // remainders carry over) wins the right to subtract the matching points;
+    // racing callers at worst apply a point of decay a call early or late.
+    const int64_t now{GetTime()};
+    int64_t last{peer.m_misbehavior_last_decay.load(std::memory_order_relaxed)};
+    if (last == 0) {
+        peer.m_misbehavior_last_decay.compare_exchange_strong(last, now);
+    } else if (now > last) {
+        const int64_t points{(now - last) / MISBEHAVIOR_DECAY_SECONDS_PER_POINT};
+        if (points > 0 && peer.m_misbehavior_last_decay.compare_exchange_strong(last, last + points * MISBEHAVIOR_DECAY_SECONDS_PER_POINT)) {
+            int score{peer.m_misbehavior_score.load(std::memory_order_relaxed)};
+            while (score > 0 && !peer.m_misbehavior_score.compare_exchange_weak(score, std::max<int64_t>(0, score - points))) {
+            }
+        }
+    }
+
+    const int score_before{peer.m_misbehavior_score.fetch_add(howmuch)};
+    const int score_now{score_before + howmuch};
 
     const std::string message_prefixed = message.empty() ? "" : (": " + message);
     std::string warning;
@@ -1778,6 +2075,14 @@ PeerManagerImpl::PeerManagerImpl(CConnman& connman, AddrMan& addrman,
       m_mempool(pool),
       m_ignore_incoming_txs(ignore_incoming_txs)
 {
+    WITH_LOCK(cs_main, m_block_history = ReadPeerBlockHistory(gArgs.GetDataDirNet() / "blockhistory.dat"));
+}
+
+PeerManagerImpl::~PeerManagerImpl()
+{
+    // All peers have been finalized by now (CConnman is stopped first), so
+    // the history holds every disconnected peer's final delivery average.
+    DumpPeerBlockHistory(gArgs.GetDataDirNet() / "blockhistory.dat", WITH_LOCK(cs_main, return m_block_history));
 }
 
 void PeerManagerImpl::StartScheduledTasks(CScheduler& scheduler)
@@ -1854,14 +2159,22 @@ void PeerManagerImpl::NewPoWValidBlock(const CBlockIndex *pindex, const std::sha
     if (!DeploymentActiveAt(*pindex, m_chainman, Consensus::DEPLOYMENT_SEGWIT)) return;
 
     uint256 hashBlock(pblock->GetHash());
-    const std::shared_future<CSerializedNetMsg> lazy_ser{
-        std::async(std::launch::deferred, [&] { return msgMaker.Make(NetMsgType::CMPCTBLOCK, *pcmpctblock); })};
+    // Serialize (and checksum) the compact block at most once; every peer's
+    // send queue then shares the same buffers, and the result is cached for
+    // reuse by SendMessages() announcements of the same block.
+    const std::shared_future<CSharedNetMsg> lazy_ser{
+        std::async(std::launch::deferred, [&] {
+            CSharedNetMsg ser_cmpctblock{CConnman::MakeSharedMsg(msgMaker.Make(NetMsgType::CMPCTBLOCK, *pcmpctblock))};
+            WITH_LOCK(m_most_recent_block_mutex, m_most_recent_cmpctblock_msg = ser_cmpctblock);
+            return ser_cmpctblock;
+        })};
 
     {
         LOCK(m_most_recent_block_mutex);
         m_most_recent_block_hash = hashBlock;
         m_most_recent_block = pblock;
         m_most_recent_compact_block = pcmpctblock;
+        m_most_recent_cmpctblock_msg.reset();
     }
 
     m_connman.ForEachNode([this, pindex, &lazy_ser, &hashBlock](CNode* pnode) EXCLUSIVE_LOCKS_REQUIRED(::cs_main) {
@@ -1878,8 +2191,7 @@ void PeerManagerImpl::NewPoWValidBlock(const CBlockIndex *pindex, const std::sha
             LogPrint(BCLog::NET, "%s sending header-and-ids %s to peer=%d\n", "PeerManager::NewPoWValidBlock",
                     hashBlock.ToString(), pnode->GetId());
 
-            const CSerializedNetMsg& ser_cmpctblock{lazy_ser.get()};
-            m_connman.PushMessage(pnode, ser_cmpctblock.Copy());
+            m_connman.PushMessage(pnode, lazy_ser.get());
             state.pindexBestHeaderSent = pindex;
         }
     });
@@ -2001,25 +2313,40 @@ void PeerManagerImpl::SendPings()
 
 void PeerManagerImpl::RelayTransaction(const uint256& txid, const uint256& wtxid)
 {
-    LOCK(m_peer_mutex);
-    for(auto& it : m_peer_map) {
-        Peer& peer = *it.second;
-        auto tx_relay = peer.GetTxRelay();
-        if (!tx_relay) continue;
-
-        LOCK(tx_relay->m_tx_inventory_mutex);
-        // Only queue transactions for announcement once the version handshake
-        // is completed. The time of arrival for these transactions is
-        // otherwise at risk of leaking to a spy, if the spy is able to
-        // distinguish transactions received during the handshake from the rest
-        // in the announcement.
-        if (tx_relay->m_next_inv_send_time == 0s) continue;
-
-        const uint256& hash{peer.m_wtxid_relay ? wtxid : txid};
-        if (!tx_relay->m_tx_inventory_known_filter.contains(hash)) {
-            tx_relay->m_tx_inventory_to_send.insert(hash);
+    // A single append to the shared log instead of taking every peer's
+    // inventory lock: each peer's message handler consumes the log by cursor
+    // at its trickle interval, where the per-peer known-transaction filtering
+    // happens. Peers that complete the version handshake later start their
+    // cursor at the then-current log end, preserving the old behavior of not
+    // announcing transactions that arrived during the handshake.
+    LOCK(m_relay_log_mutex);
+    m_tx_relay_log.push_back({txid, wtxid});
+    while (m_tx_relay_log.size() > MAX_TX_RELAY_LOG_ENTRIES) {
+        m_tx_relay_log.pop_front();
+        ++m_relay_log_start;
+    }
+}
+
+void PeerManagerImpl::TrimTxRelayLog()
+{
+    uint64_t min_pos{std::numeric_limits<uint64_t>::max()};
+    {
+        LOCK(m_peer_mutex);
+        for (const auto& [id, peer] : m_peer_map) {
+            if (auto tx_relay = peer->GetTxRelay()) {
+                LOCK(tx_relay->m_tx_inventory_mutex);
+                min_pos = std::min(min_pos, tx_relay->m_relay_log_pos);
+            }
         }
-    };
+    }
+    LOCK(m_relay_log_mutex);
+    // Cursors at the uninitialized sentinel (and an empty peer set) pose no
+    // constraint: such peers start at the log end anyway.
+    min_pos = std::min(min_pos, m_relay_log_start + m_tx_relay_log.size());
+    while (m_relay_log_start < min_pos) {
+        m_tx_relay_log.pop_front();
+        ++m_relay_log_start;
+    }
 }
 
 void PeerManagerImpl::RelayAddress(NodeId originator,
@@ -2138,10 +2465,15 @@ void PeerManagerImpl::ProcessGetBlockData(CNode& pfrom, Peer& peer, const CInv&
     if (!(pindex->nStatus & BLOCK_HAVE_DATA)) {
         return;
     }
+    // Compact block requests for blocks deeper than MAX_CMPCTBLOCK_DEPTH are
+    // answered with a full witness block (see below), which can be served
+    // straight from disk just like witness block requests.
+    const bool cmpct_as_full_block{inv.IsMsgCmpctBlk() &&
+        !(CanDirectFetch() && pindex->nHeight >= m_chainman.ActiveChain().Height() - MAX_CMPCTBLOCK_DEPTH)};
     std::shared_ptr<const CBlock> pblock;
     if (a_recent_block && a_recent_block->GetHash() == pindex->GetBlockHash()) {
         pblock = a_recent_block;
-    } else if (inv.IsMsgWitnessBlk()) {
+    } else if (inv.IsMsgWitnessBlk() || cmpct_as_full_block) {
         // Fast-path: in this case it is possible to serve the block directly from disk,
         // as the network format matches the format on disk
         std::vector<uint8_t> block_data;
@@ -2192,7 +2524,7 @@ void PeerManagerImpl::ProcessGetBlockData(CNode& pfrom, Peer& peer, const CInv&
             // they won't have a useful mempool to match against a compact block,
             // and we don't feel like constructing the object for them, so
             // instead we respond with the full, non-compact block.
-            if (CanDirectFetch() && pindex->nHeight >= m_chainman.ActiveChain().Height() - MAX_CMPCTBLOCK_DEPTH) {
+            if (!cmpct_as_full_block) {
                 if (a_recent_compact_block && a_recent_compact_block->header.GetHash() == pindex->GetBlockHash()) {
                     m_connman.PushMessage(&pfrom, msgMaker.Make(NetMsgType::CMPCTBLOCK, *a_recent_compact_block));
                 } else {
@@ -2200,6 +2532,8 @@ void PeerManagerImpl::ProcessGetBlockData(CNode& pfrom, Peer& peer, const CInv&
                     m_connman.PushMessage(&pfrom, msgMaker.Make(NetMsgType::CMPCTBLOCK, cmpctblock));
                 }
             } else {
+                // Only reachable via a_recent_block; deep requests were
+                // already served raw from disk above.
                 m_connman.PushMessage(&pfrom, msgMaker.Make(NetMsgType::BLOCK, *pblock));
             }
         }
@@ -2220,31 +2554,14 @@ void PeerManagerImpl::ProcessGetBlockData(CNode& pfrom, Peer& peer, const CInv&
     }
 }
 
-CTransactionRef PeerManagerImpl::FindTxForGetData(const CNode& peer, const GenTxid& gtxid, const std::chrono::seconds mempool_req, const std::chrono::seconds now)
+CTransactionRef PeerManagerImpl::FindTxForGetData(const CNode& peer, const GenTxid& gtxid)
 {
-    auto txinfo = m_mempool.info(gtxid);
-    if (txinfo.tx) {
-        // If a TX could have been INVed in reply to a MEMPOOL request,
-        // or is older than UNCONDITIONAL_RELAY_DELAY, permit the request
-        // unconditionally.
-        if ((mempool_req.count() && txinfo.m_time <= mempool_req) || txinfo.m_time <= now - UNCONDITIONAL_RELAY_DELAY) {
-            return std::move(txinfo.tx);
-        }
-    }
-
-    {
-        LOCK(cs_main);
-        // Otherwise, the transaction must have been announced recently.
-        if (State(peer.GetId())->m_recently_announced_invs.contains(gtxid.GetHash())) {
-            // If it was, it can be relayed from either the mempool...
-            if (txinfo.tx) return std::move(txinfo.tx);
-            // ... or the relay pool.
-            auto mi = mapRelay.find(gtxid.GetHash());
-            if (mi != mapRelay.end()) return mi->second;
-        }
-    }
-
-    return {};
+    // The peer may request any transaction that entered the mempool before
+    // our last INV batch to it; everything with a lower entry sequence was
+    // either announced in that batch (or an earlier one) or skipped on
+    // purpose, e.g. because of the peer's fee filter.
+    const uint64_t last_inv_sequence{WITH_LOCK(cs_main, return State(peer.GetId())->m_last_inv_sequence)};
+    return m_mempool.info_for_relay(gtxid, last_inv_sequence).tx;
 }
 
 void PeerManagerImpl::ProcessGetData(CNode& pfrom, Peer& peer, const std::atomic<bool>& interruptMsgProc)
@@ -2257,10 +2574,6 @@ void PeerManagerImpl::ProcessGetData(CNode& pfrom, Peer& peer, const std::atomic
     std::vector<CInv> vNotFound;
     const CNetMsgMaker msgMaker(pfrom.GetCommonVersion());
 
-    const auto now{GetTime<std::chrono::seconds>()};
-    // Get last mempool request time
-    const auto mempool_req = tx_relay != nullptr ? tx_relay->m_last_mempool_req.load() : std::chrono::seconds::min();
-
     // Process as many TX items from the front of the getdata queue as
     // possible, since they're common and it's efficient to batch process
     // them.
@@ -2278,34 +2591,15 @@ void PeerManagerImpl::ProcessGetData(CNode& pfrom, Peer& peer, const std::atomic
             continue;
         }
 
-        CTransactionRef tx = FindTxForGetData(pfrom, ToGenTxid(inv), mempool_req, now);
+        CTransactionRef tx = FindTxForGetData(pfrom, ToGenTxid(inv));
         if (tx) {
             // WTX and WITNESS_TX imply we serialize with witness
             int nSendFlags = (inv.IsMsgTx() ? SERIALIZE_TRANSACTION_NO_WITNESS : 0);
             m_connman.PushMessage(&pfrom, msgMaker.Make(nSendFlags, NetMsgType::TX, *tx));
             m_mempool.RemoveUnbroadcastTx(tx->GetHash());
-            // As we're going to send tx, make sure its unconfirmed parents are made requestable.
-            std::vector<uint256> parent_ids_to_add;
-            {
-                LOCK(m_mempool.cs);
-                auto txiter = m_mempool.GetIter(tx->GetHash());
-                if (txiter) {
-                    const CTxMemPoolEntry::Parents& parents = (*txiter)->GetMemPoolParentsConst();
-                    parent_ids_to_add.reserve(parents.size());
-                    for (const CTxMemPoolEntry& parent : parents) {
-                        if (parent.GetTime() > now - UNCONDITIONAL_RELAY_DELAY) {
-                            parent_ids_to_add.push_back(parent.GetTx().GetHash());
-                        }
-                    }
-                }
-            }
-            for (const uint256& parent_txid : parent_ids_to_add) {
-                // Relaying a transaction with a recent but unconfirmed parent.
-                if (WITH_LOCK(tx_relay->m_tx_inventory_mutex, return !tx_relay->m_tx_inventory_known_filter.contains(parent_txid))) {
-                    LOCK(cs_main);
-                    State(pfrom.GetId())->m_recently_announced_invs.insert(parent_txid);
-                }
-            }
+            // Unconfirmed parents of tx are automatically requestable: they
+            // entered the mempool before tx did, so their entry sequence is
+            // lower than the INV stamp that made tx itself requestable.
         } else {
             vNotFound.push_back(inv);
         }
@@ -2367,12 +2661,44 @@ void PeerManagerImpl::SendBlockTransactions(CNode& pfrom, Peer& peer, const CBlo
     m_connman.PushMessage(&pfrom, msgMaker.Make(NetMsgType::BLOCKTXN, resp));
 }
 
-bool PeerManagerImpl::CheckHeadersPoW(const std::vector<CBlockHeader>& headers, const Consensus::Params& consensusParams, Peer& peer)
+bool PeerManagerImpl::CheckHeadersPoW(const std::vector<CBlockHeader>& headers, const Consensus::Params& consensusParams, Peer& peer, bool verify_pow)
 {
     // Do these headers have proof-of-work matching what's claimed?
-    if (!HasValidProofOfWork(headers, consensusParams)) {
-        Misbehaving(peer, 100, "header with invalid proof of work");
-        return false;
+    if (verify_pow && !headers.empty()) {
+        // Classify the batch for RandomX admission: headers building on the
+        // best known header chain are active-chain work; an unknown parent or
+        // a branch off that chain is speculative and queues behind it when
+        // hashing capacity is contended.
+        RandomXSource source{RandomXSource::FORK};
+        const CBlockIndex* prev{nullptr};
+        {
+            LOCK(cs_main);
+            prev = m_chainman.m_blockman.LookupBlockIndex(headers[0].hashPrevBlock);
+            const CBlockIndex* best{m_chainman.m_best_header};
+            if (prev && best && best->GetAncestor(prev->nHeight) == prev) {
+                source = RandomXSource::CHAIN;
+            }
+        }
+        // Apply the deep-history sampling policy per header when the batch
+        // connects to a known parent. The work claimed through the end of the
+        // batch is used for every header in it, which is the conservative
+        // choice: a batch crossing the minimum-chainwork anchor is verified in
+        // full.
+        const std::vector<CBlockHeader>* to_verify{&headers};
+        std::vector<CBlockHeader> sampled;
+        if (prev) {
+            const arith_uint256 claimed_work{prev->nChainWork + CalculateHeadersWork(headers)};
+            for (size_t i = 0; i < headers.size(); ++i) {
+                if (ShouldVerifyHeaderPoW(prev->nHeight + 1 + static_cast<int>(i), claimed_work, consensusParams)) {
+                    sampled.push_back(headers[i]);
+                }
+            }
+            if (sampled.size() < headers.size()) to_verify = &sampled;
+        }
+        if (!to_verify->empty() && !HasValidProofOfWork(*to_verify, consensusParams, source)) {
+            Misbehaving(peer, 100, "header with invalid proof of work");
+            return false;
+        }
     }
 
     // Are these headers connected to each other?
@@ -2763,9 +3089,22 @@ void PeerManagerImpl::ProcessHeadersMessage(CNode& pfrom, Peer& peer,
 
     // Before we do any processing, make sure these pass basic sanity checks.
     // We'll rely on headers having valid proof-of-work further down, as an
-    // anti-DoS criteria (note: this check is required before passing any
-    // headers into HeadersSyncState).
-    if (!CheckHeadersPoW(headers, m_chainparams.GetConsensus(), peer)) {
+    // anti-DoS criteria.
+    //
+    // While this peer is in the PRESYNC phase of a low-work headers sync we
+    // skip the proof-of-work check: with RandomX it is by far the most
+    // expensive part of headers processing, which would let a low-work spam
+    // peer burn minutes of hashing before the claimed-work threshold is ever
+    // reached. PRESYNC itself validates difficulty transitions and only
+    // stores salted commitments; nothing enters m_block_index until the
+    // REDOWNLOAD phase, where every batch is fully verified on receipt.
+    bool in_presync{false};
+    {
+        LOCK(peer.m_headers_sync_mutex);
+        in_presync = peer.m_headers_sync &&
+                     peer.m_headers_sync->GetState() == HeadersSyncState::State::PRESYNC;
+    }
+    if (!CheckHeadersPoW(headers, m_chainparams.GetConsensus(), peer, /*verify_pow=*/!in_presync)) {
         // Misbehaving() calls are handled within CheckHeadersPoW(), so we can
         // just return. (Note that even if a header is announced via compact
         // block, the header itself should be valid, so this type of error can
@@ -2806,6 +3145,15 @@ void PeerManagerImpl::ProcessHeadersMessage(CNode& pfrom, Peer& peer,
         have_headers_sync = !!peer.m_headers_sync;
     }
 
+    // If proof-of-work verification was skipped above because this peer was in
+    // PRESYNC, but the headers sync did not consume these headers (it failed or
+    // completed), perform the full check now before any further processing.
+    if (in_presync && !headers.empty()) {
+        if (!CheckHeadersPoW(headers, m_chainparams.GetConsensus(), peer)) {
+            return;
+        }
+    }
+
     // Do these headers connect to something in our block index?
     const CBlockIndex *chain_start_header{WITH_LOCK(::cs_main, return m_chainman.m_blockman.LookupBlockIndex(headers[0].hashPrevBlock))};
     bool headers_connect_blockindex{chain_start_header != nullptr};
@@ -2901,67 +3249,87 @@ void PeerManagerImpl::ProcessOrphanTx(std::set<uint256>& orphan_work_set)
     AssertLockHeld(g_cs_orphans);
 
     while (!orphan_work_set.empty()) {
-        const uint256 orphanHash = *orphan_work_set.begin();
-        orphan_work_set.erase(orphan_work_set.begin());
-
-        const auto [porphanTx, from_peer] = m_orphanage.GetTx(orphanHash);
-        if (porphanTx == nullptr) continue;
-
-        const MempoolAcceptResult result = m_chainman.ProcessTransaction(porphanTx);
-        const TxValidationState& state = result.m_state;
-
-        if (result.m_result_type == MempoolAcceptResult::ResultType::VALID) {
-            LogPrint(BCLog::MEMPOOL, "   accepted orphan tx %s\n", orphanHash.ToString());
-            RelayTransaction(orphanHash, porphanTx->GetWitnessHash());
-            m_orphanage.AddChildrenToWorkSet(*porphanTx, orphan_work_set);
-            m_orphanage.EraseTx(orphanHash);
-            for (const CTransactionRef& removedTx : result.m_replaced_transactions.value()) {
-                AddToCompactExtraTransactions(removedTx);
-            }
-            break;
-        } else if (state.GetResult() != TxValidationResult::TX_MISSING_INPUTS) {
-            if (state.IsInvalid()) {
-                LogPrint(BCLog::MEMPOOL, "   invalid orphan tx %s from peer=%d. %s\n",
-                    orphanHash.ToString(),
-                    from_peer,
-                    state.ToString());
-                // Maybe punish peer that gave us an invalid orphan tx
-                MaybePunishNodeForTx(from_peer, state);
-            }
-            // Has inputs but not accepted to mempool
-            // Probably non-standard or insufficient fee
-            LogPrint(BCLog::MEMPOOL, "   removed orphan tx %s\n", orphanHash.ToString());
-            if (state.GetResult() != TxValidationResult::TX_WITNESS_STRIPPED) {
-                // We can add the wtxid of this transaction to our reject filter.
-                // Do not add txids of witness transactions or witness-stripped
-                // transactions to the filter, as they can have been malleated;
-                // adding such txids to the reject filter would potentially
-                // interfere with relay of valid transactions from peers that
-                // do not support wtxid-based relay. See
-                // https://github.com/coral/coral/issues/8279 for details.
-                // We can remove this restriction (and always add wtxids to
-                // the filter even for witness stripped transactions) once
-                // wtxid-based relay is broadly deployed.
-                // See also comments in https://github.com/coral/coral/pull/18044#discussion_r443419034
-                // for concerns around weakening security of unupgraded nodes
-                // if we start doing this too early.
-                m_recent_rejects.insert(porphanTx->GetWitnessHash());
-                // If the transaction failed for TX_INPUTS_NOT_STANDARD,
-                // then we know that the witness was irrelevant to the policy
-                // failure, since this check depends only on the txid
-                // (the scriptPubKey being spent is covered by the txid).
-                // Add the txid to the reject filter to prevent repeated
-                // processing of this transaction in the event that child
-                // transactions are later received (resulting in
-                // parent-fetching by txid via the orphan-handling logic).
-                if (state.GetResult() == TxValidationResult::TX_INPUTS_NOT_STANDARD && porphanTx->GetWitnessHash() != porphanTx->GetHash()) {
-                    // We only add the txid if it differs from the wtxid, to
-                    // avoid wasting entries in the rolling bloom filter.
-                    m_recent_rejects.insert(porphanTx->GetHash());
+        // Validate the whole work set as one batch: AcceptToMemoryPoolBatch
+        // fetches the coins for every orphan in a single pass and reuses one
+        // cs_main/mempool-lock hold, instead of re-entering ATMP once per
+        // transaction as parents arrive. Orphans accepted here may complete
+        // further orphans; those are collected and batched on the next round
+        // of the loop.
+        std::vector<std::pair<CTransactionRef, int64_t>> txns;
+        std::vector<NodeId> from_peers;
+        txns.reserve(orphan_work_set.size());
+        from_peers.reserve(orphan_work_set.size());
+        const int64_t accept_time{GetTime()};
+        for (const uint256& orphan_hash : orphan_work_set) {
+            const auto [porphanTx, from_peer] = m_orphanage.GetTx(orphan_hash);
+            if (porphanTx == nullptr) continue;
+            txns.emplace_back(porphanTx, accept_time);
+            from_peers.push_back(from_peer);
+        }
+        orphan_work_set.clear();
+        if (txns.empty()) return;
+
+        const auto results{AcceptToMemoryPoolBatch(m_chainman.ActiveChainstate(), txns, /*bypass_limits=*/false)};
+        m_mempool.check(m_chainman.ActiveChainstate().CoinsTip(), m_chainman.ActiveChain().Height() + 1);
+
+        for (size_t i = 0; i < txns.size(); ++i) {
+            const CTransactionRef& porphanTx = txns[i].first;
+            const uint256 orphanHash = porphanTx->GetHash();
+            const NodeId from_peer = from_peers[i];
+            const MempoolAcceptResult& result = results[i];
+            const TxValidationState& state = result.m_state;
+
+            if (result.m_result_type == MempoolAcceptResult::ResultType::VALID) {
+                LogPrint(BCLog::MEMPOOL, "   accepted orphan tx %s\n", orphanHash.ToString());
+                RelayTransaction(orphanHash, porphanTx->GetWitnessHash());
+                m_orphanage.AddChildrenToWorkSet(*porphanTx, orphan_work_set);
+                m_orphanage.EraseTx(orphanHash);
+                for (const CTransactionRef& removedTx : result.m_replaced_transactions.value()) {
+                    AddToCompactExtraTransactions(removedTx);
+                }
+            } else if (state.GetResult() != TxValidationResult::TX_MISSING_INPUTS) {
+                if (state.IsInvalid()) {
+                    LogPrint(BCLog::MEMPOOL, "   invalid orphan tx %s from peer=%d. %s\n",
+                        orphanHash.ToString(),
+                        from_peer,
+                        state.ToString());
+                    // Maybe punish peer that gave us an invalid orphan tx
+                    MaybePunishNodeForTx(from_peer, state);
+                }
+                // Has inputs but not accepted to mempool
+                // Probably non-standard or insufficient fee
+                LogPrint(BCLog::MEMPOOL, "   removed orphan tx %s\n", orphanHash.ToString());
+                if (state.GetResult() != TxValidationResult::TX_WITNESS_STRIPPED) {
+                    // We can add the wtxid of this transaction to our reject filter.
+                    // Do not add txids of witness transactions or witness-stripped
+                    // transactions to the filter, as they can have been malleated;
+                    // adding such txids to the reject filter would potentially
+                    // interfere with relay of valid transactions from peers that
+                    // do not support wtxid-based relay. See
+                    // https://github.com/coral/coral/issues/8279 for details.
+                    // We can remove this restriction (and always add wtxids to
+                    // the filter even for witness stripped transactions) once
+                    // wtxid-based relay is broadly deployed.
+                    // See also comments in https://github.com/coral/coral/pull/18044#discussion_r443419034
+                    // for concerns around weakening security of unupgraded nodes
+                    // if we start doing this too early.
+                    m_recent_rejects.insert(porphanTx->GetWitnessHash());
+                    // If the transaction failed for TX_INPUTS_NOT_STANDARD,
+                    // then we know that the witness was irrelevant to the policy
+                    // failure, since this check depends only on the txid
+                    // (the scriptPubKey being spent is covered by the txid).
+                    // Add the txid to the reject filter to prevent repeated
+                    // processing of this transaction in the event that child
+                    // transactions are later received (resulting in
+                    // parent-fetching by txid via the orphan-handling logic).
+                    if (state.GetResult() == TxValidationResult::TX_INPUTS_NOT_STANDARD && porphanTx->GetWitnessHash() != porphanTx->GetHash()) {
+                        // We only add the txid if it differs from the wtxid, to
+                        // avoid wasting entries in the rolling bloom filter.
+                        m_recent_rejects.insert(porphanTx->GetHash());
+                    }
                 }
+                m_orphanage.EraseTx(orphanHash);
             }
-            m_orphanage.EraseTx(orphanHash);
-            break;
         }
     }
 }
@@ -3036,6 +3404,36 @@ void PeerManagerImpl::ProcessGetCFilters(CNode& node,Peer& peer, CDataStream& vR
         return;
     }
 
+    // Collect the block indexes of the requested range, oldest first.
+    std::vector<const CBlockIndex*> range(stop_index->nHeight - start_height + 1);
+    const CBlockIndex* block_index{stop_index};
+    for (auto it = range.rbegin(); it != range.rend(); ++it) {
+        *it = block_index;
+        block_index = block_index->pprev;
+    }
+
+    // Serve hot ranges straight from the response cache: the serialized
+    // cfilter messages are refcounted into the requester's send queue without
+    // touching the filter index or copying filter bytes. Light clients tend to
+    // request the same recent ranges, so most requests resolve here.
+    {
+        std::vector<CSharedNetMsg> cached;
+        cached.reserve(range.size());
+        WITH_LOCK(m_cfilter_cache_mutex, {
+            for (const CBlockIndex* index : range) {
+                const auto it{m_cfilter_cache.find(index->GetBlockHash())};
+                if (it == m_cfilter_cache.end() || it->second.filter_type != filter_type) break;
+                cached.push_back(it->second.msg);
+            }
+        });
+        if (cached.size() == range.size()) {
+            for (const CSharedNetMsg& msg : cached) {
+                m_connman.PushMessage(&node, msg);
+            }
+            return;
+        }
+    }
+
     std::vector<BlockFilter> filters;
     if (!filter_index->LookupFilterRange(start_height, stop_index, filters)) {
         LogPrint(BCLog::NET, "Failed to find block filter in index: filter_type=%s, start_height=%d, stop_hash=%s\n",
@@ -3043,10 +3441,33 @@ void PeerManagerImpl::ProcessGetCFilters(CNode& node,Peer& peer, CDataStream& vR
         return;
     }
 
+    std::vector<CSharedNetMsg> msgs;
+    msgs.reserve(filters.size());
     for (const auto& filter : filters) {
-        CSerializedNetMsg msg = CNetMsgMaker(node.GetCommonVersion())
-            .Make(NetMsgType::CFILTER, filter);
-        m_connman.PushMessage(&node, std::move(msg));
+        msgs.push_back(CConnman::MakeSharedMsg(
+            CNetMsgMaker(node.GetCommonVersion()).Make(NetMsgType::CFILTER, filter)));
+    }
+
+    {
+        LOCK(m_cfilter_cache_mutex);
+        for (size_t i{0}; i < msgs.size(); ++i) {
+            const uint256& block_hash{filters[i].GetBlockHash()};
+            const auto [it, inserted] = m_cfilter_cache.emplace(block_hash, CachedCFilterMsg{filter_type, msgs[i]});
+            if (!inserted) continue;
+            m_cfilter_cache_order.push_back(block_hash);
+            m_cfilter_cache_bytes += msgs[i].m_header->size() + msgs[i].m_data->size();
+        }
+        while (m_cfilter_cache_bytes > CFILTER_CACHE_MAX_BYTES && !m_cfilter_cache_order.empty()) {
+            const auto it{m_cfilter_cache.find(m_cfilter_cache_order.front())};
+            m_cfilter_cache_order.pop_front();
+            if (it == m_cfilter_cache.end()) continue;
+            m_cfilter_cache_bytes -= it->second.msg.m_header->size() + it->second.msg.m_data->size();
+            m_cfilter_cache.erase(it);
+        }
+    }
+
+    for (const CSharedNetMsg& msg : msgs) {
+        m_connman.PushMessage(&node, msg);
     }
 }
 
@@ -3136,6 +3557,15 @@ void PeerManagerImpl::ProcessGetCFCheckPt(CNode& node, Peer& peer, CDataStream&
 
 void PeerManagerImpl::ProcessBlock(CNode& node, const std::shared_ptr<const CBlock>& block, bool force_processing, bool min_pow_checked)
 {
+    // Hash the header before ProcessNewBlock takes cs_main. For blocks whose
+    // header was announced ahead of the body this is a cache lookup; for
+    // full-block pushes it moves the RandomX computation off the lock, so the
+    // pre-validation relay out of AcceptBlock is never queued behind a hash
+    // running under cs_main.
+    if (!block->hashPrevBlock.IsNull()) {
+        GetRandomXHash(block->GetBlockHeader());
+    }
+
     bool new_block{false};
     m_chainman.ProcessNewBlock(block, force_processing, min_pow_checked, &new_block);
     if (new_block) {
@@ -3255,6 +3685,12 @@ void PeerManagerImpl::ProcessMessage(CNode& pfrom, const std::string& msg_type,
 
         pfrom.m_has_all_wanted_services = HasAllDesirableServiceFlags(nServices);
         peer->m_their_services = nServices;
+        // Compressed relay of large messages applies only when both sides
+        // advertise it. The local bit is only ever set in builds with zlib
+        // support (see -compressedrelay handling in init).
+        if ((nServices & NODE_COMPRESSED_RELAY) && (peer->m_our_services & NODE_COMPRESSED_RELAY)) {
+            pfrom.m_compressed_relay = true;
+        }
         pfrom.SetAddrLocal(addrMe);
         {
             LOCK(pfrom.m_subver_mutex);
@@ -3910,28 +4346,36 @@ void PeerManagerImpl::ProcessMessage(CNode& pfrom, const std::string& msg_type,
         // is not considered a protocol violation, so don't punish the peer.
         if (m_chainman.ActiveChainstate().IsInitialBlockDownload()) return;
 
+        // Compute the txid/wtxid straight from the serialized bytes. In the
+        // common case where we already have the transaction, the hashes are
+        // all the bookkeeping below needs, and we avoid deserializing it
+        // entirely; deserialization is deferred until the transaction is
+        // actually handed to validation.
         CTransactionRef ptx;
-        vRecv >> ptx;
-        const CTransaction& tx = *ptx;
-
-        const uint256& txid = ptx->GetHash();
-        const uint256& wtxid = ptx->GetWitnessHash();
+        uint256 txid, wtxid;
+        if (const auto hashes{ShallowHashTx(MakeUCharSpan(vRecv))}) {
+            txid = hashes->txid;
+            wtxid = hashes->wtxid;
+        } else {
+            // Unparsable bytes: let the deserializer raise the usual error.
+            vRecv >> ptx;
+            txid = ptx->GetHash();
+            wtxid = ptx->GetWitnessHash();
+        }
 
         const uint256& hash = peer->m_wtxid_relay ? wtxid : txid;
         AddKnownTx(*peer, hash);
         if (peer->m_wtxid_relay && txid != wtxid) {
             // Insert txid into m_tx_inventory_known_filter, even for
-            // wtxidrelay peers. This prevents re-adding of
-            // unconfirmed parents to the recently_announced
-            // filter, when a child tx is requested. See
-            // ProcessGetData().
+            // wtxidrelay peers: the peer evidently knows the transaction
+            // under either identifier, so never announce it by txid.
             AddKnownTx(*peer, txid);
         }
 
         LOCK2(cs_main, g_cs_orphans);
 
         m_txrequest.ReceivedResponse(pfrom.GetId(), txid);
-        if (tx.HasWitness()) m_txrequest.ReceivedResponse(pfrom.GetId(), wtxid);
+        if (wtxid != txid) m_txrequest.ReceivedResponse(pfrom.GetId(), wtxid);
 
         // We do the AlreadyHaveTx() check using wtxid, rather than txid - in the
         // absence of witness malleation, this is strictly better, because the
@@ -3950,16 +4394,25 @@ void PeerManagerImpl::ProcessMessage(CNode& pfrom, const std::string& msg_type,
                 // Always relay transactions received from peers with forcerelay
                 // permission, even if they were already in the mempool, allowing
                 // the node to function as a gateway for nodes hidden behind it.
-                if (!m_mempool.exists(GenTxid::Txid(tx.GetHash()))) {
-                    LogPrintf("Not relaying non-mempool transaction %s from forcerelay peer=%d\n", tx.GetHash().ToString(), pfrom.GetId());
+                if (!m_mempool.exists(GenTxid::Txid(txid))) {
+                    LogPrintf("Not relaying non-mempool transaction %s from forcerelay peer=%d\n", txid.ToString(), pfrom.GetId());
                 } else {
-                    LogPrintf("Force relaying tx %s from peer=%d\n", tx.GetHash().ToString(), pfrom.GetId());
-                    RelayTransaction(tx.GetHash(), tx.GetWitnessHash());
+                    LogPrintf("Force relaying tx %s from peer=%d\n", txid.ToString(), pfrom.GetId());
+                    RelayTransaction(txid, wtxid);
                 }
             }
             return;
         }
 
+        if (!ptx) {
+            // The shallow parse accepts exactly the encodings the
+            // deserializer accepts, so this cannot throw and the hashes
+            // must agree.
+            vRecv >> ptx;
+            Assume(ptx->GetHash() == txid && ptx->GetWitnessHash() == wtxid);
+        }
+        const CTransaction& tx = *ptx;
+
         const MempoolAcceptResult result = m_chainman.ProcessTransaction(ptx);
         const TxValidationState& state = result.m_state;
 
@@ -4138,6 +4591,14 @@ void PeerManagerImpl::ProcessMessage(CNode& pfrom, const std::string& msg_type,
         }
         }
 
+        // The anti-DoS checks above passed, so this header is about to pay
+        // for a RandomX hash either way; computing it here keeps it off
+        // cs_main, which AcceptBlockHeader holds while it checks proof of
+        // work. Re-announcements from further peers hit the hash cache.
+        if (received_new_header) {
+            GetRandomXHash(cmpctblock.header);
+        }
+
         const CBlockIndex *pindex = nullptr;
         BlockValidationState state;
         if (!m_chainman.ProcessNewBlockHeaders({cmpctblock.header}, /*min_pow_checked=*/true, state, &pindex)) {
@@ -4739,14 +5200,8 @@ void PeerManagerImpl::ProcessMessage(CNode& pfrom, const std::string& msg_type,
 
 bool PeerManagerImpl::MaybeDiscourageAndDisconnect(CNode& pnode, Peer& peer)
 {
-    {
-        LOCK(peer.m_misbehavior_mutex);
-
-        // There's nothing to do if the m_should_discourage flag isn't set
-        if (!peer.m_should_discourage) return false;
-
-        peer.m_should_discourage = false;
-    } // peer.m_misbehavior_mutex
+    // There's nothing to do if the m_should_discourage flag isn't set
+    if (!peer.m_should_discourage.exchange(false)) return false;
 
     if (pnode.HasPermission(NetPermissionFlags::NoBan)) {
         // We never disconnect or discourage peers for bad behavior if they have NetPermissionFlags::NoBan permission
@@ -4843,7 +5298,10 @@ bool PeerManagerImpl::ProcessMessages(CNode* pfrom, std::atomic<bool>& interrupt
     msg.SetVersion(pfrom->GetCommonVersion());
 
     try {
+        const int64_t process_start_us{GetTimeMicros()};
         ProcessMessage(*pfrom, msg.m_type, msg.m_recv, msg.m_time, interruptMsgProc);
+        perf::Bump(perf::GetCounters().msghand_iterations);
+        perf::Bump(perf::GetCounters().msghand_time_us, GetTimeMicros() - process_start_us);
         if (interruptMsgProc) return false;
         {
             LOCK(peer->m_getdata_requests_mutex);
@@ -5019,13 +5477,67 @@ void PeerManagerImpl::EvictExtraOutboundPeers(std::chrono::seconds now)
     }
 }
 
+void PeerManagerImpl::RotateHighLatencyPeer(std::chrono::seconds now)
+{
+    if (now < m_latency_rotation_time + LATENCY_ROTATION_INTERVAL) return;
+
+    // Collect the minimum observed ping time of every mature
+    // outbound-full-relay peer. The minimum over the connection's regular
+    // pings is the best estimate of path latency we have, free of transient
+    // processing delays.
+    struct LatencyEntry {
+        NodeId id;
+        std::chrono::microseconds min_ping;
+    };
+    std::vector<LatencyEntry> peers;
+    m_connman.ForEachNode([&](CNode* pnode) {
+        if (!pnode->IsFullOutboundConn() || pnode->fDisconnect) return;
+        if (now - pnode->m_connected < LATENCY_ROTATION_MIN_CONNECT_TIME) return;
+        const auto min_ping{pnode->m_min_ping_time.load()};
+        if (min_ping == std::chrono::microseconds::max()) return;
+        peers.push_back({pnode->GetId(), min_ping});
+    });
+    if (peers.size() < LATENCY_ROTATION_MIN_PEERS) return;
+
+    std::sort(peers.begin(), peers.end(),
+              [](const LatencyEntry& a, const LatencyEntry& b) { return a.min_ping < b.min_ping; });
+    const auto median_ping{peers[peers.size() / 2].min_ping};
+    const LatencyEntry& worst{peers.back()};
+
+    // Only rotate a clear outlier: latency must be both high in absolute
+    // terms and far above what the rest of our outbound peers demonstrate is
+    // attainable. Keeping the bar high avoids churning through peers on
+    // marginal differences.
+    if (worst.min_ping < LATENCY_ROTATION_MIN_PING) return;
+    if (worst.min_ping < median_ping * LATENCY_ROTATION_FACTOR) return;
+
+    m_connman.ForNode(worst.id, [&](CNode* pnode) EXCLUSIVE_LOCKS_REQUIRED(::cs_main) {
+        AssertLockHeld(::cs_main);
+        CNodeState* state = State(pnode->GetId());
+        if (state == nullptr) return false;
+        // Don't drop peers protected from chain-sync eviction or peers we
+        // are currently downloading a block from.
+        if (state->m_chain_sync.m_protect || state->nBlocksInFlight > 0) return false;
+        LogPrint(BCLog::NET, "rotating high-latency outbound peer=%d (min ping %dms, outbound median %dms)\n",
+                 pnode->GetId(), Ticks<std::chrono::milliseconds>(worst.min_ping),
+                 Ticks<std::chrono::milliseconds>(median_ping));
+        pnode->fDisconnect = true;
+        m_latency_rotation_time = now;
+        return true;
+    });
+}
+
 void PeerManagerImpl::CheckForStaleTipAndEvictPeers()
 {
+    // Opportunistically drop relay log entries every peer has announced.
+    TrimTxRelayLog();
+
     LOCK(cs_main);
 
     auto now{GetTime<std::chrono::seconds>()};
 
     EvictExtraOutboundPeers(now);
+    RotateHighLatencyPeer(now);
 
     if (now > m_stale_tip_check_time) {
         // Check whether our tip is stale, and if so, allow using an extra
@@ -5335,7 +5847,13 @@ bool PeerManagerImpl::SendMessages(CNode* pto)
 
         if (!state.fSyncStarted && CanServeBlocks(*peer) && !fImporting && !fReindex) {
             // Only actively request headers from a single peer, unless we're close to today.
-            if ((nSyncStarted == 0 && sync_blocks_and_headers_from_peer) || m_chainman.m_best_header->Time() > GetAdjustedTime() - 24h) {
+            // While RandomX verification is saturated, don't fan header sync
+            // out to additional peers: each would answer with 2000-header
+            // batches that all need hashing, so new syncs wait until the
+            // verifier has free capacity again.
+            if ((nSyncStarted == 0 && sync_blocks_and_headers_from_peer) ||
+                (m_chainman.m_best_header->Time() > GetAdjustedTime() - 24h &&
+                 (nSyncStarted == 0 || !RandomXVerificationSaturated()))) {
                 const CBlockIndex* pindexStart = m_chainman.m_best_header;
                 /* If possible, start at the block preceding the currently
                    best known header.  This ensures that we always get a
@@ -5435,15 +5953,20 @@ bool PeerManagerImpl::SendMessages(CNode* pto)
                     LogPrint(BCLog::NET, "%s sending header-and-ids %s to peer=%d\n", __func__,
                             vHeaders.front().GetHash().ToString(), pto->GetId());
 
-                    std::optional<CSerializedNetMsg> cached_cmpctblock_msg;
+                    std::optional<CSharedNetMsg> cached_cmpctblock_msg;
                     {
                         LOCK(m_most_recent_block_mutex);
                         if (m_most_recent_block_hash == pBestIndex->GetBlockHash()) {
-                            cached_cmpctblock_msg = msgMaker.Make(NetMsgType::CMPCTBLOCK, *m_most_recent_compact_block);
+                            // Serialize once and share the bytes with every
+                            // peer this block is announced to.
+                            if (!m_most_recent_cmpctblock_msg) {
+                                m_most_recent_cmpctblock_msg = CConnman::MakeSharedMsg(msgMaker.Make(NetMsgType::CMPCTBLOCK, *m_most_recent_compact_block));
+                            }
+                            cached_cmpctblock_msg = *m_most_recent_cmpctblock_msg;
                         }
                     }
                     if (cached_cmpctblock_msg.has_value()) {
-                        m_connman.PushMessage(pto, std::move(cached_cmpctblock_msg.value()));
+                        m_connman.PushMessage(pto, cached_cmpctblock_msg.value());
                     } else {
                         CBlock block;
                         bool ret = ReadBlockFromDisk(block, pBestIndex, consensusParams);
@@ -5520,6 +6043,14 @@ bool PeerManagerImpl::SendMessages(CNode* pto)
                 bool fSendTrickle = pto->HasPermission(NetPermissionFlags::NoBan);
                 if (tx_relay->m_next_inv_send_time < current_time) {
                     fSendTrickle = true;
+                    if (tx_relay->m_next_inv_send_time == 0s) {
+                        // First trickle since the version handshake completed:
+                        // start consuming the shared relay log at its current
+                        // end, so transactions that arrived earlier are never
+                        // announced to this peer.
+                        LOCK(m_relay_log_mutex);
+                        tx_relay->m_relay_log_pos = m_relay_log_start + m_tx_relay_log.size();
+                    }
                     if (pto->IsInboundConn()) {
                         tx_relay->m_next_inv_send_time = NextInvToInbounds(current_time, INBOUND_INVENTORY_BROADCAST_INTERVAL);
                     } else {
@@ -5530,7 +6061,32 @@ bool PeerManagerImpl::SendMessages(CNode* pto)
                 // Time to send but the peer has requested we not relay transactions.
                 if (fSendTrickle) {
                     LOCK(tx_relay->m_bloom_filter_mutex);
-                    if (!tx_relay->m_relay_txs) tx_relay->m_tx_inventory_to_send.clear();
+                    if (!tx_relay->m_relay_txs) {
+                        tx_relay->m_tx_inventory_to_send.clear();
+                        // Also skip everything queued in the shared relay log.
+                        LOCK(m_relay_log_mutex);
+                        tx_relay->m_relay_log_pos = m_relay_log_start + m_tx_relay_log.size();
+                    }
+                }
+
+                // Pull new announcements from the shared relay log into this
+                // peer's to-send set. The known-transaction filtering happens
+                // here on the consuming thread, instead of under every peer's
+                // inventory lock on each producer.
+                if (fSendTrickle) {
+                    LOCK(m_relay_log_mutex);
+                    uint64_t pos{tx_relay->m_relay_log_pos};
+                    // If the log was trimmed past our cursor (or the cursor is
+                    // still at its sentinel), skip the unavailable entries.
+                    if (pos < m_relay_log_start) pos = m_relay_log_start;
+                    for (size_t idx = pos - m_relay_log_start; idx < m_tx_relay_log.size(); ++idx) {
+                        const TxRelayLogEntry& entry{m_tx_relay_log[idx]};
+                        const uint256& hash{peer->m_wtxid_relay ? entry.wtxid : entry.txid};
+                        if (!tx_relay->m_tx_inventory_known_filter.contains(hash)) {
+                            tx_relay->m_tx_inventory_to_send.insert(hash);
+                        }
+                    }
+                    tx_relay->m_relay_log_pos = m_relay_log_start + m_tx_relay_log.size();
                 }
 
                 // Respond to BIP35 mempool requests
@@ -5553,14 +6109,14 @@ bool PeerManagerImpl::SendMessages(CNode* pto)
                             if (!tx_relay->m_bloom_filter->IsRelevantAndUpdate(*txinfo.tx)) continue;
                         }
                         tx_relay->m_tx_inventory_known_filter.insert(hash);
-                        // Responses to MEMPOOL requests bypass the m_recently_announced_invs filter.
+                        // Responses to MEMPOOL requests are made requestable by
+                        // the m_last_inv_sequence update below.
                         vInv.push_back(inv);
                         if (vInv.size() == MAX_INV_SZ) {
                             m_connman.PushMessage(pto, msgMaker.Make(NetMsgType::INV, vInv));
                             vInv.clear();
                         }
                     }
-                    tx_relay->m_last_mempool_req = std::chrono::duration_cast<std::chrono::seconds>(current_time);
                 }
 
                 // Determine transactions to relay
@@ -5598,49 +6154,25 @@ bool PeerManagerImpl::SendMessages(CNode* pto)
                         if (!txinfo.tx) {
                             continue;
                         }
-                        auto txid = txinfo.tx->GetHash();
-                        auto wtxid = txinfo.tx->GetWitnessHash();
                         // Peer told you to not send transactions at that feerate? Don't bother sending it.
                         if (txinfo.fee < filterrate.GetFee(txinfo.vsize)) {
                             continue;
                         }
                         if (tx_relay->m_bloom_filter && !tx_relay->m_bloom_filter->IsRelevantAndUpdate(*txinfo.tx)) continue;
                         // Send
-                        State(pto->GetId())->m_recently_announced_invs.insert(hash);
                         vInv.push_back(inv);
                         nRelayedTransactions++;
-                        {
-                            // Expire old relay messages
-                            while (!g_relay_expiration.empty() && g_relay_expiration.front().first < current_time)
-                            {
-                                mapRelay.erase(g_relay_expiration.front().second);
-                                g_relay_expiration.pop_front();
-                            }
-
-                            auto ret = mapRelay.emplace(txid, std::move(txinfo.tx));
-                            if (ret.second) {
-                                g_relay_expiration.emplace_back(current_time + RELAY_TX_CACHE_TIME, ret.first);
-                            }
-                            // Add wtxid-based lookup into mapRelay as well, so that peers can request by wtxid
-                            auto ret2 = mapRelay.emplace(wtxid, ret.first->second);
-                            if (ret2.second) {
-                                g_relay_expiration.emplace_back(current_time + RELAY_TX_CACHE_TIME, ret2.first);
-                            }
-                        }
                         if (vInv.size() == MAX_INV_SZ) {
                             m_connman.PushMessage(pto, msgMaker.Make(NetMsgType::INV, vInv));
                             vInv.clear();
                         }
                         tx_relay->m_tx_inventory_known_filter.insert(hash);
-                        if (hash != txid) {
-                            // Insert txid into m_tx_inventory_known_filter, even for
-                            // wtxidrelay peers. This prevents re-adding of
-                            // unconfirmed parents to the recently_announced
-                            // filter, when a child tx is requested. See
-                            // ProcessGetData().
-                            tx_relay->m_tx_inventory_known_filter.insert(txid);
-                        }
                     }
+
+                    // Note the current mempool sequence: every entry below it
+                    // was either just announced or deliberately withheld, so
+                    // the peer may request it with GETDATA from now on.
+                    State(pto->GetId())->m_last_inv_sequence = WITH_LOCK(m_mempool.cs, return m_mempool.GetSequence());
                 }
         }
         if (!vInv.empty())
@@ -5710,10 +6242,11 @@ bool PeerManagerImpl::SendMessages(CNode* pto)
         // Message: getdata (blocks)
         //
         std::vector<CInv> vGetData;
-        if (CanServeBlocks(*peer) && ((sync_blocks_and_headers_from_peer && !IsLimitedPeer(*peer)) || !m_chainman.ActiveChainstate().IsInitialBlockDownload()) && state.nBlocksInFlight < MAX_BLOCKS_IN_TRANSIT_PER_PEER) {
+        const unsigned int block_window{BlockDownloadWindow(state)};
+        if (CanServeBlocks(*peer) && ((sync_blocks_and_headers_from_peer && !IsLimitedPeer(*peer)) || !m_chainman.ActiveChainstate().IsInitialBlockDownload()) && state.nBlocksInFlight < static_cast<int>(block_window)) {
             std::vector<const CBlockIndex*> vToDownload;
             NodeId staller = -1;
-            FindNextBlocksToDownload(*peer, MAX_BLOCKS_IN_TRANSIT_PER_PEER - state.nBlocksInFlight, vToDownload, staller);
+            FindNextBlocksToDownload(*peer, block_window - state.nBlocksInFlight, vToDownload, staller);
             for (const CBlockIndex *pindex : vToDownload) {
                 uint32_t nFetchFlags = GetFetchFlags(*peer);
                 vGetData.push_back(CInv(MSG_BLOCK | nFetchFlags, pindex->GetBlockHash()));
@@ -16,6 +16,7 @@
 #include <algorithm>
 #include <array>
 #include <cstdint>
+#include <cstring>
 #include <ios>
 #include <iterator>
 #include <tuple>
@@ -629,12 +630,20 @@ std::string CNetAddr::ToString() const
 
 bool operator==(const CNetAddr& a, const CNetAddr& b)
 {
-    return a.m_net == b.m_net && a.m_addr == b.m_addr;
+    // Addresses of the same network always have the same size, so a single
+    // memcmp (word-sized compares in practice) replaces the element-wise
+    // prevector comparison. Address-keyed maps hit this on every probe.
+    return a.m_net == b.m_net && a.m_addr.size() == b.m_addr.size() &&
+           memcmp(a.m_addr.data(), b.m_addr.data(), a.m_addr.size()) == 0;
 }
 
 bool operator<(const CNetAddr& a, const CNetAddr& b)
 {
-    return std::tie(a.m_net, a.m_addr) < std::tie(b.m_net, b.m_addr);
+    if (a.m_net != b.m_net) return a.m_net < b.m_net;
+    // Same network implies same address size, so memcmp yields the same
+    // order as the former lexicographical prevector comparison.
+    if (a.m_addr.size() != b.m_addr.size()) return a.m_addr.size() < b.m_addr.size();
+    return memcmp(a.m_addr.data(), b.m_addr.data(), a.m_addr.size()) < 0;
 }
 
 /**
@@ -855,12 +864,17 @@ uint16_t CService::GetPort() const
 
 bool operator==(const CService& a, const CService& b)
 {
-    return static_cast<CNetAddr>(a) == static_cast<CNetAddr>(b) && a.port == b.port;
+    // Compare members in place; slicing to CNetAddr would copy the address
+    // storage on every comparison.
+    return a.port == b.port && static_cast<const CNetAddr&>(a) == static_cast<const CNetAddr&>(b);
 }
 
 bool operator<(const CService& a, const CService& b)
 {
-    return static_cast<CNetAddr>(a) < static_cast<CNetAddr>(b) || (static_cast<CNetAddr>(a) == static_cast<CNetAddr>(b) && a.port < b.port);
+    const CNetAddr& addr_a{a};
+    const CNetAddr& addr_b{b};
+    if (addr_a < addr_b) return true;
+    return !(addr_b < addr_a) && a.port < b.port;
 }
 
 /**
@@ -19,6 +19,11 @@ public:
     {
         CSerializedNetMsg msg;
         msg.m_type = std::move(msg_type);
+        // Precompute the payload size so the send buffer is one exactly-sized
+        // allocation instead of a geometric realloc+copy chain.
+        CSizeComputer sizer{SER_NETWORK, nFlags | nVersion};
+        ::SerializeMany(sizer, args...);
+        msg.data.reserve(sizer.size());
         CVectorWriter{ SER_NETWORK, nFlags | nVersion, msg.data, 0, std::forward<Args>(args)... };
         return msg;
     }
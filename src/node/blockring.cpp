@@ -0,0 +1,202 @@
+// Copyright (c) 2022 The Coral Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <node/blockring.h>
+
+#include <logging.h>
+#include <primitives/block.h>
+#include <streams.h>
+#include <version.h>
+
+#include <cstring>
+
+#ifndef WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace node {
+
+std::unique_ptr<BlockRingWriter> g_block_ring;
+
+namespace {
+
+constexpr uint32_t BLOCK_RING_MAGIC{0x424c5243}; // "CRLB"
+constexpr uint32_t BLOCK_RING_VERSION{1};
+
+//! File header, padded so the data area starts cache-line aligned.
+struct RingHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t ring_size;
+    //! Sequence number of the most recently published record (0 = none yet).
+    std::atomic<uint64_t> seq;
+    //! Data-area offset of the most recently published record.
+    std::atomic<uint64_t> last_offset;
+    unsigned char padding[32];
+};
+
+//! Per-record header preceding the raw block bytes. The sequence number is
+//! zero while the record is being (over)written and is published last.
+struct RecordHeader {
+    std::atomic<uint64_t> seq;
+    uint64_t data_size;
+    int32_t height;
+    uint32_t padding;
+    unsigned char hash[32];
+};
+
+static_assert(sizeof(RingHeader) % 64 == 0);
+static_assert(sizeof(RecordHeader) % 8 == 0);
+
+size_t AlignRecord(size_t size) { return (size + 7) & ~size_t{7}; }
+
+} // namespace
+
+BlockRingWriter::~BlockRingWriter()
+{
+#ifndef WIN32
+    if (m_map) munmap(m_map, m_map_size);
+#endif
+}
+
+bool BlockRingWriter::Open(const fs::path& path, size_t size_mb)
+{
+#ifndef WIN32
+    const size_t ring_size{size_mb * 1024 * 1024};
+    m_map_size = sizeof(RingHeader) + ring_size;
+    const int fd{open(fs::PathToString(path).c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644)};
+    if (fd < 0) {
+        LogPrintf("BlockRing: Failed to create %s\n", fs::PathToString(path));
+        return false;
+    }
+    if (ftruncate(fd, m_map_size) != 0) {
+        close(fd);
+        return false;
+    }
+    m_map = static_cast<unsigned char*>(mmap(nullptr, m_map_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0));
+    close(fd);
+    if (m_map == MAP_FAILED) {
+        m_map = nullptr;
+        LogPrintf("BlockRing: mmap of %s failed\n", fs::PathToString(path));
+        return false;
+    }
+    RingHeader* header{reinterpret_cast<RingHeader*>(m_map)};
+    header->magic = BLOCK_RING_MAGIC;
+    header->version = BLOCK_RING_VERSION;
+    header->ring_size = ring_size;
+    header->seq.store(0, std::memory_order_relaxed);
+    header->last_offset.store(0, std::memory_order_relaxed);
+    LogPrintf("BlockRing: Publishing connected blocks to %s (%u MiB)\n", fs::PathToString(path), size_mb);
+    return true;
+#else
+    LogPrintf("BlockRing: Not supported on this platform\n");
+    return false;
+#endif
+}
+
+void BlockRingWriter::WriteBlock(const CBlock& block, int height, const uint256& hash)
+{
+    if (!m_map) return;
+
+    CDataStream ss(SER_NETWORK, PROTOCOL_VERSION);
+    ss << block;
+
+    RingHeader* header{reinterpret_cast<RingHeader*>(m_map)};
+    unsigned char* data_area{m_map + sizeof(RingHeader)};
+    const size_t record_size{AlignRecord(sizeof(RecordHeader) + ss.size())};
+    if (record_size > header->ring_size) {
+        LogPrintf("BlockRing: Block %s (%u bytes) exceeds ring capacity, skipping\n", hash.ToString(), ss.size());
+        return;
+    }
+    if (m_write_pos + record_size > header->ring_size) {
+        m_write_pos = 0;
+    }
+
+    RecordHeader* rec{reinterpret_cast<RecordHeader*>(data_area + m_write_pos)};
+    // Invalidate first so a reader mid-copy of the record being overwritten
+    // detects the tear when it re-checks the sequence number.
+    rec->seq.store(0, std::memory_order_release);
+    rec->data_size = ss.size();
+    rec->height = height;
+    std::memcpy(rec->hash, hash.begin(), 32);
+    std::memcpy(data_area + m_write_pos + sizeof(RecordHeader), ss.data(), ss.size());
+
+    const uint64_t seq{header->seq.load(std::memory_order_relaxed) + 1};
+    rec->seq.store(seq, std::memory_order_release);
+    header->last_offset.store(m_write_pos, std::memory_order_relaxed);
+    header->seq.store(seq, std::memory_order_release);
+    m_write_pos += record_size;
+}
+
+BlockRingReader::~BlockRingReader()
+{
+#ifndef WIN32
+    if (m_map) munmap(const_cast<unsigned char*>(m_map), m_map_size);
+#endif
+}
+
+bool BlockRingReader::Open(const fs::path& path)
+{
+#ifndef WIN32
+    const int fd{open(fs::PathToString(path).c_str(), O_RDONLY)};
+    if (fd < 0) return false;
+    const off_t file_size{lseek(fd, 0, SEEK_END)};
+    if (file_size < static_cast<off_t>(sizeof(RingHeader))) {
+        close(fd);
+        return false;
+    }
+    m_map_size = file_size;
+    m_map = static_cast<const unsigned char*>(mmap(nullptr, m_map_size, PROT_READ, MAP_SHARED, fd, 0));
+    close(fd);
+    if (m_map == MAP_FAILED) {
+        m_map = nullptr;
+        return false;
+    }
+    const RingHeader* header{reinterpret_cast<const RingHeader*>(m_map)};
+    if (header->magic != BLOCK_RING_MAGIC || header->version != BLOCK_RING_VERSION ||
+        sizeof(RingHeader) + header->ring_size > m_map_size) {
+        munmap(const_cast<unsigned char*>(m_map), m_map_size);
+        m_map = nullptr;
+        return false;
+    }
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool BlockRingReader::ReadLatest(std::vector<unsigned char>& block_data, int& height, uint256& hash, uint64_t& seq)
+{
+    if (!m_map) return false;
+    const RingHeader* header{reinterpret_cast<const RingHeader*>(m_map)};
+    const uint64_t head_seq{header->seq.load(std::memory_order_acquire)};
+    if (head_seq == 0 || head_seq <= m_last_seq) return false;
+
+    const uint64_t offset{header->last_offset.load(std::memory_order_relaxed)};
+    if (sizeof(RecordHeader) + offset > header->ring_size) return false;
+    const RecordHeader* rec{reinterpret_cast<const RecordHeader*>(m_map + sizeof(RingHeader) + offset)};
+
+    const uint64_t rec_seq{rec->seq.load(std::memory_order_acquire)};
+    if (rec_seq == 0 || rec_seq <= m_last_seq) return false;
+    const uint64_t data_size{rec->data_size};
+    if (sizeof(RecordHeader) + offset + data_size > header->ring_size) return false;
+
+    block_data.assign(m_map + sizeof(RingHeader) + offset + sizeof(RecordHeader),
+                      m_map + sizeof(RingHeader) + offset + sizeof(RecordHeader) + data_size);
+    height = rec->height;
+    std::memcpy(hash.begin(), rec->hash, 32);
+
+    // The copy is only good if the writer did not lap the ring while it was
+    // in progress.
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (rec->seq.load(std::memory_order_relaxed) != rec_seq) return false;
+
+    m_last_seq = rec_seq;
+    seq = rec_seq;
+    return true;
+}
+
+} // namespace node
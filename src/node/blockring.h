@@ -0,0 +1,92 @@
+// Copyright (c) 2022 The Coral Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef CORAL_NODE_BLOCKRING_H
+#define CORAL_NODE_BLOCKRING_H
+
+#include <fs.h>
+#include <uint256.h>
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+class CBlock;
+
+namespace node {
+
+/** Default for -blockring, in MiB (0 = disabled) */
+static constexpr int64_t DEFAULT_BLOCK_RING_MB{0};
+
+/**
+ * A single-writer shared-memory ring of recently connected raw blocks, so
+ * co-located consumers (indexers, analytics) can pick up new blocks from an
+ * mmap'd file instead of copying every byte through an RPC or ZMQ socket.
+ *
+ * Layout: a page-aligned header followed by a byte-addressed data area into
+ * which variable-size records are appended, wrapping to the start when a
+ * record does not fit at the tail. Each record carries its own sequence
+ * number, published with a release store only after the block bytes are in
+ * place; the header tracks the latest sequence number and record offset.
+ *
+ * Readers follow a seqlock protocol: read the record indicated by the header,
+ * copy the bytes out, then re-check the record's sequence number. A mismatch
+ * means the writer lapped the ring during the read and the copy must be
+ * discarded. There is no backpressure — a reader that falls behind by more
+ * than the ring capacity misses blocks and must fall back to RPC.
+ */
+class BlockRingWriter
+{
+private:
+    unsigned char* m_map{nullptr};
+    size_t m_map_size{0};
+    size_t m_write_pos{0};
+
+public:
+    BlockRingWriter() = default;
+    ~BlockRingWriter();
+    BlockRingWriter(const BlockRingWriter&) = delete;
+    BlockRingWriter& operator=(const BlockRingWriter&) = delete;
+
+    /** Create (or recreate) the ring file and map it. Returns false on
+     * platforms without mmap support or on filesystem errors. */
+    bool Open(const fs::path& path, size_t size_mb);
+
+    /** Publish one connected block. Called with cs_main held by the block
+     * connection path, which makes the single-writer assumption hold. */
+    void WriteBlock(const CBlock& block, int height, const uint256& hash);
+};
+
+/**
+ * Client side of the block ring, for sidecar processes. Maps the ring file
+ * read-only and hands out the most recent block past the caller's cursor.
+ */
+class BlockRingReader
+{
+private:
+    const unsigned char* m_map{nullptr};
+    size_t m_map_size{0};
+    uint64_t m_last_seq{0};
+
+public:
+    BlockRingReader() = default;
+    ~BlockRingReader();
+    BlockRingReader(const BlockRingReader&) = delete;
+    BlockRingReader& operator=(const BlockRingReader&) = delete;
+
+    bool Open(const fs::path& path);
+
+    /** Copy out the most recent block with a sequence number greater than the
+     * last one returned. Returns false when there is nothing new or the
+     * record was overwritten mid-read (the caller just polls again). */
+    bool ReadLatest(std::vector<unsigned char>& block_data, int& height, uint256& hash, uint64_t& seq);
+};
+
+/** The global block ring, written on block connection. May be null. */
+extern std::unique_ptr<BlockRingWriter> g_block_ring;
+
+} // namespace node
+
+#endif // CORAL_NODE_BLOCKRING_H
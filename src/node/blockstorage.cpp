@@ -8,6 +8,8 @@
 #include <chainparams.h>
 #include <clientversion.h>
 #include <consensus/validation.h>
+#include <crypto/common.h>
+#include <diskio.h>
 #include <flatfile.h>
 #include <fs.h>
 #include <hash.h>
@@ -21,9 +23,16 @@
 #include <util/system.h>
 #include <validation.h>
 
+#include <algorithm>
 #include <map>
 #include <unordered_map>
 
+#ifndef WIN32
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 namespace node {
 std::atomic_bool fImporting(false);
 std::atomic_bool fReindex(false);
@@ -117,6 +126,12 @@ CBlockIndex* BlockManager::AddToBlockIndex(const CBlockHeader& block, CBlockInde
     return pindexNew;
 }
 
+void BlockManager::ReserveBlockIndex(size_t count)
+{
+    AssertLockHeld(cs_main);
+    m_block_index.reserve(m_block_index.size() + count);
+}
+
 void BlockManager::PruneOneBlockFile(const int fileNumber)
 {
     AssertLockHeld(cs_main);
@@ -459,23 +474,29 @@ static bool UndoWriteToDisk(const CBlockUndo& blockundo, FlatFilePos& pos, const
         return error("%s: OpenUndoFile failed", __func__);
     }
 
+    // Serialize the undo data once into a contiguous buffer. The checksum is
+    // computed over the same bytes, and data and checksum reach the file in a
+    // single write, instead of serializing twice (once for the file, once for
+    // the hasher) and issuing one small buffered write per field.
+    CDataStream record{SER_DISK, fileout.GetVersion()};
+    record << blockundo;
+    const unsigned int nSize = record.size();
+
+    HashWriter hasher{};
+    hasher << hashBlock;
+    hasher.write(MakeByteSpan(record));
+    record << hasher.GetHash();
+
     // Write index header
-    unsigned int nSize = GetSerializeSize(blockundo, fileout.GetVersion());
     fileout << messageStart << nSize;
 
-    // Write undo data
+    // Write undo data and checksum
     long fileOutPos = ftell(fileout.Get());
     if (fileOutPos < 0) {
         return error("%s: ftell failed", __func__);
     }
     pos.nPos = (unsigned int)fileOutPos;
-    fileout << blockundo;
-
-    // calculate & write checksum
-    HashWriter hasher{};
-    hasher << hashBlock;
-    hasher << blockundo;
-    fileout << hasher.GetHash();
+    fileout.write(MakeByteSpan(record));
 
     return true;
 }
@@ -483,7 +504,11 @@ static bool UndoWriteToDisk(const CBlockUndo& blockundo, FlatFilePos& pos, const
 bool UndoReadFromDisk(CBlockUndo& blockundo, const CBlockIndex* pindex)
 {
     const FlatFilePos pos{WITH_LOCK(::cs_main, return pindex->GetUndoPos())};
+    return UndoReadFromDisk(blockundo, pos, pindex->pprev->GetBlockHash());
+}
 
+bool UndoReadFromDisk(CBlockUndo& blockundo, const FlatFilePos& pos, const uint256& prev_block_hash)
+{
     if (pos.IsNull()) {
         return error("%s: no undo data available", __func__);
     }
@@ -498,7 +523,7 @@ bool UndoReadFromDisk(CBlockUndo& blockundo, const CBlockIndex* pindex)
     uint256 hashChecksum;
     CHashVerifier<CAutoFile> verifier(&filein); // We need a CHashVerifier as reserializing may lose data
     try {
-        verifier << pindex->pprev->GetBlockHash();
+        verifier << prev_block_hash;
         verifier >> blockundo;
         filein >> hashChecksum;
     } catch (const std::exception& e) {
@@ -580,6 +605,19 @@ fs::path GetBlockPosFilename(const FlatFilePos& pos)
     return BlockFileSeq().FileName(pos);
 }
 
+/** Size above which a blk?????.dat file is considered full and the next file
+ *  is started. -blockfilesize can raise this (fewer, larger files mean less
+ *  fragmentation and a smaller directory on some storage backends); since
+ *  FlatFilePos stores 32-bit offsets, the limit is capped at 2 GiB. */
+static unsigned int MaxBlockfileSize()
+{
+    if (gArgs.GetBoolArg("-fastprune", false)) {
+        return 0x10000; // 64kb
+    }
+    const int64_t user_mib{gArgs.GetIntArg("-blockfilesize", MAX_BLOCKFILE_SIZE >> 20)};
+    return static_cast<unsigned int>(std::clamp<int64_t>(user_mib, 1, 2048) << 20);
+}
+
 bool BlockManager::FindBlockPos(FlatFilePos& pos, unsigned int nAddSize, unsigned int nHeight, CChain& active_chain, uint64_t nTime, bool fKnown)
 {
     LOCK(cs_LastBlockFile);
@@ -591,7 +629,8 @@ bool BlockManager::FindBlockPos(FlatFilePos& pos, unsigned int nAddSize, unsigne
 
     bool finalize_undo = false;
     if (!fKnown) {
-        while (m_blockfile_info[nFile].nSize + nAddSize >= (gArgs.GetBoolArg("-fastprune", false) ? 0x10000 /* 64kb */ : MAX_BLOCKFILE_SIZE)) {
+        const unsigned int max_blockfile_size{MaxBlockfileSize()};
+        while (m_blockfile_info[nFile].nSize + nAddSize >= max_blockfile_size) {
             // when the undo file is keeping up with the block file, we want to flush it explicitly
             // when it is lagging behind (more blocks arrive than are being connected), we let the
             // undo block write case handle it
@@ -683,6 +722,7 @@ static bool WriteBlockToDisk(const CBlock& block, FlatFilePos& pos, const CMessa
 bool BlockManager::WriteUndoDataForBlock(const CBlockUndo& blockundo, BlockValidationState& state, CBlockIndex* pindex, const CChainParams& chainparams)
 {
     AssertLockHeld(::cs_main);
+    const diskio::ValidationWriteGuard write_guard;
     // Write undo information to disk
     if (pindex->GetUndoPos().IsNull()) {
         FlatFilePos _pos;
@@ -710,21 +750,94 @@ bool BlockManager::WriteUndoDataForBlock(const CBlockUndo& blockundo, BlockValid
     return true;
 }
 
+#ifndef WIN32
+namespace {
+/**
+ * RAII read-only memory mapping of a whole block file. Deserializing
+ * straight out of the page cache avoids the buffered read syscalls and the
+ * extra copy per block that the CAutoFile path pays, which adds up when
+ * serving archival peers or rescanning.
+ */
+class MappedBlockFile
+{
+    const unsigned char* m_data{nullptr};
+    size_t m_size{0};
+
+public:
+    explicit MappedBlockFile(const FlatFilePos& pos)
+    {
+        FILE* file = OpenBlockFile(pos, true);
+        if (!file) return;
+        struct stat st;
+        if (fstat(fileno(file), &st) == 0 && st.st_size > 0) {
+            void* addr = mmap(nullptr, st.st_size, PROT_READ, MAP_SHARED, fileno(file), 0);
+            if (addr != MAP_FAILED) {
+                m_data = static_cast<const unsigned char*>(addr);
+                m_size = static_cast<size_t>(st.st_size);
+            }
+        }
+        // The mapping outlives the descriptor.
+        fclose(file);
+    }
+    ~MappedBlockFile()
+    {
+        if (m_data) munmap(const_cast<unsigned char*>(m_data), m_size);
+    }
+    MappedBlockFile(const MappedBlockFile&) = delete;
+    MappedBlockFile& operator=(const MappedBlockFile&) = delete;
+
+    bool IsNull() const { return m_data == nullptr; }
+
+    //! Span covering [offset, offset + length), or an empty span if out of range.
+    Span<const unsigned char> Region(size_t offset, size_t length) const
+    {
+        if (IsNull() || offset > m_size || length > m_size - offset) return {};
+        return {m_data + offset, length};
+    }
+};
+} // namespace
+#endif // !WIN32
+
 bool ReadBlockFromDisk(CBlock& block, const FlatFilePos& pos, const Consensus::Params& consensusParams)
 {
     block.SetNull();
 
-    // Open history file to read
-    CAutoFile filein(OpenBlockFile(pos, true), SER_DISK, CLIENT_VERSION);
-    if (filein.IsNull()) {
-        return error("ReadBlockFromDisk: OpenBlockFile failed for %s", pos.ToString());
+    bool deserialized = false;
+#ifndef WIN32
+    {
+        // Fast path: zero-copy deserialization out of a memory mapping. Any
+        // inconsistency falls through to the buffered path below, which
+        // produces the usual error messages.
+        MappedBlockFile mapped{pos};
+        const auto size_span{mapped.Region(pos.nPos - 4, 4)};
+        if (size_span.size() == 4) {
+            const uint32_t blk_size{ReadLE32(size_span.data())};
+            const auto block_span{mapped.Region(pos.nPos, blk_size)};
+            if (blk_size > 0 && blk_size <= MAX_SIZE && block_span.size() == blk_size) {
+                try {
+                    SpanReader{SER_DISK, CLIENT_VERSION, block_span} >> block;
+                    deserialized = true;
+                } catch (const std::exception&) {
+                    block.SetNull();
+                }
+            }
+        }
     }
+#endif
 
-    // Read block
-    try {
-        filein >> block;
-    } catch (const std::exception& e) {
-        return error("%s: Deserialize or I/O error - %s at %s", __func__, e.what(), pos.ToString());
+    if (!deserialized) {
+        // Open history file to read
+        CAutoFile filein(OpenBlockFile(pos, true), SER_DISK, CLIENT_VERSION);
+        if (filein.IsNull()) {
+            return error("ReadBlockFromDisk: OpenBlockFile failed for %s", pos.ToString());
+        }
+
+        // Read block
+        try {
+            filein >> block;
+        } catch (const std::exception& e) {
+            return error("%s: Deserialize or I/O error - %s at %s", __func__, e.what(), pos.ToString());
+        }
     }
 
     // Check the header (using RandomX PoW for Coral)
@@ -756,6 +869,31 @@ bool ReadBlockFromDisk(CBlock& block, const CBlockIndex* pindex, const Consensus
 
 bool ReadRawBlockFromDisk(std::vector<uint8_t>& block, const FlatFilePos& pos, const CMessageHeader::MessageStartChars& message_start)
 {
+#ifndef WIN32
+    {
+        // Fast path: copy the raw block straight out of a memory mapping.
+        MappedBlockFile mapped{pos};
+        const auto header_span{mapped.Region(pos.nPos - 8, 8)};
+        if (header_span.size() == 8) {
+            if (memcmp(header_span.data(), message_start, CMessageHeader::MESSAGE_START_SIZE)) {
+                return error("%s: Block magic mismatch for %s: %s versus expected %s", __func__, pos.ToString(),
+                             HexStr(header_span.first(CMessageHeader::MESSAGE_START_SIZE)),
+                             HexStr(message_start));
+            }
+            const uint32_t blk_size{ReadLE32(header_span.data() + 4)};
+            if (blk_size > MAX_SIZE) {
+                return error("%s: Block data is larger than maximum deserialization size for %s: %s versus %s", __func__, pos.ToString(),
+                             blk_size, MAX_SIZE);
+            }
+            const auto block_span{mapped.Region(pos.nPos, blk_size)};
+            if (block_span.size() == blk_size) {
+                block.assign(block_span.begin(), block_span.end());
+                return true;
+            }
+        }
+    }
+#endif
+
     FlatFilePos hpos = pos;
     hpos.nPos -= 8; // Seek back 8 bytes for meta header
     CAutoFile filein(OpenBlockFile(hpos, true), SER_DISK, CLIENT_VERSION);
@@ -792,6 +930,9 @@ bool ReadRawBlockFromDisk(std::vector<uint8_t>& block, const FlatFilePos& pos, c
 /** Store block on disk. If dbp is non-nullptr, the file is known to already reside on disk */
 FlatFilePos BlockManager::SaveBlockToDisk(const CBlock& block, int nHeight, CChain& active_chain, const CChainParams& chainparams, const FlatFilePos* dbp)
 {
+    // Block file writes are on the validation critical path; background index
+    // and rescan I/O yields to them (see diskio.h).
+    const diskio::ValidationWriteGuard write_guard;
     unsigned int nBlockSize = ::GetSerializeSize(block, CLIENT_VERSION);
     FlatFilePos blockPos;
     if (dbp != nullptr) {
@@ -898,5 +1039,8 @@ void ThreadImport(ChainstateManager& chainman, std::vector<fs::path> vImportFile
         }
     } // End scope of CImportingNow
     chainman.ActiveChainstate().LoadMempool(mempool_path);
+    if (args.GetBoolArg("-warmcoinscache", DEFAULT_WARM_COINS_CACHE)) {
+        chainman.ActiveChainstate().WarmCoinsCache();
+    }
 }
 } // namespace node
@@ -9,6 +9,7 @@
 #include <chain.h>
 #include <fs.h>
 #include <protocol.h>
+#include <support/allocators/pool.h>
 #include <sync.h>
 #include <txdb.h>
 
@@ -41,7 +42,7 @@ static constexpr bool DEFAULT_STOPAFTERBLOCKIMPORT{false};
 static const unsigned int BLOCKFILE_CHUNK_SIZE = 0x1000000; // 16 MiB
 /** The pre-allocation chunk size for rev?????.dat files (since 0.8) */
 static const unsigned int UNDOFILE_CHUNK_SIZE = 0x100000; // 1 MiB
-/** The maximum size of a blk?????.dat file (since 0.8) */
+/** The default maximum size of a blk?????.dat file (since 0.8); overridable with -blockfilesize */
 static const unsigned int MAX_BLOCKFILE_SIZE = 0x8000000; // 128 MiB
 
 extern std::atomic_bool fImporting;
@@ -56,7 +57,19 @@ extern uint64_t nPruneTarget;
 // we ever switch to another associative container, we need to either use a
 // container that has stable addressing (true of all std associative
 // containers), or make the key a `std::unique_ptr<CBlockIndex>`
-using BlockMap = std::unordered_map<uint256, CBlockIndex, BlockHasher>;
+//
+// The map's nodes are drawn from a pool resource, so the millions of index
+// entries sit densely packed in insertion (roughly height) order instead of
+// being scattered across the heap, which keeps ancestor walks over pprev and
+// pskip cache-friendly. The bucket array exceeds the pool's block size and
+// transparently uses the regular heap.
+using BlockMap = std::unordered_map<uint256,
+                                    CBlockIndex,
+                                    BlockHasher,
+                                    std::equal_to<uint256>,
+                                    PoolAllocator<std::pair<const uint256, CBlockIndex>,
+                                                  /*MAX_BLOCK_SIZE_BYTES=*/256,
+                                                  alignof(std::pair<const uint256, CBlockIndex>)>>;
 
 struct CBlockIndexWorkComparator {
     bool operator()(const CBlockIndex* pa, const CBlockIndex* pb) const;
@@ -139,8 +152,12 @@ private:
      */
     std::unordered_map<std::string, PruneLockInfo> m_prune_locks GUARDED_BY(::cs_main);
 
+    //! Pool the nodes of m_block_index are carved from. Declared before the
+    //! map so it outlives it on destruction.
+    BlockMap::allocator_type::ResourceType m_block_index_resource;
+
 public:
-    BlockMap m_block_index GUARDED_BY(cs_main);
+    BlockMap m_block_index GUARDED_BY(cs_main){BlockMap::allocator_type{&m_block_index_resource}};
 
     std::vector<CBlockIndex*> GetAllBlockIndices() EXCLUSIVE_LOCKS_REQUIRED(::cs_main);
 
@@ -156,6 +173,10 @@ public:
     bool LoadBlockIndexDB(const Consensus::Params& consensus_params) EXCLUSIVE_LOCKS_REQUIRED(::cs_main);
 
     CBlockIndex* AddToBlockIndex(const CBlockHeader& block, CBlockIndex*& best_header) EXCLUSIVE_LOCKS_REQUIRED(cs_main);
+    /** Reserve bucket capacity for `count` additional block index entries, so
+     *  that inserting a whole batch of headers cannot trigger a rehash of
+     *  m_block_index mid-batch. */
+    void ReserveBlockIndex(size_t count) EXCLUSIVE_LOCKS_REQUIRED(cs_main);
     /** Create a new block index entry for a given block hash */
     CBlockIndex* InsertBlockIndex(const uint256& hash) EXCLUSIVE_LOCKS_REQUIRED(cs_main);
 
@@ -210,6 +231,9 @@ bool ReadBlockFromDisk(CBlock& block, const CBlockIndex* pindex, const Consensus
 bool ReadRawBlockFromDisk(std::vector<uint8_t>& block, const FlatFilePos& pos, const CMessageHeader::MessageStartChars& message_start);
 
 bool UndoReadFromDisk(CBlockUndo& blockundo, const CBlockIndex* pindex);
+//! Read undo data from a known position, verifying the checksum against the
+//! given previous block hash. Does not require cs_main.
+bool UndoReadFromDisk(CBlockUndo& blockundo, const FlatFilePos& pos, const uint256& prev_block_hash);
 
 void ThreadImport(ChainstateManager& chainman, std::vector<fs::path> vImportFiles, const ArgsManager& args, const fs::path& mempool_path);
 } // namespace node
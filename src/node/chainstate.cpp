@@ -6,6 +6,7 @@
 
 #include <chain.h>
 #include <coins.h>
+#include <coinsjournal.h>
 #include <consensus/params.h>
 #include <node/blockstorage.h>
 #include <node/caches.h>
@@ -119,6 +120,17 @@ ChainstateLoadResult LoadChainstate(ChainstateManager& chainman, const CacheSize
                                                                      "rebuild the chainstate database.")};
         }
 
+        // Apply any coins journal left behind by an unclean shutdown, so the
+        // coins database catches up to the last journal write without
+        // reconnecting the intervening blocks. Stale or corrupt journals are
+        // discarded, falling back to the usual block replay.
+        if (!options.reindex && !options.reindex_chainstate && !chainstate->m_from_snapshot_blockhash &&
+            !ApplyCoinsJournal(chainstate->CoinsDB(), CoinsJournalPath(), [&](const uint256& hash) EXCLUSIVE_LOCKS_REQUIRED(::cs_main) {
+                return chainman.m_blockman.LookupBlockIndex(hash) != nullptr;
+            })) {
+            return {ChainstateLoadStatus::FAILURE, _("Unable to apply the coins journal. You will need to rebuild the database using -reindex-chainstate.")};
+        }
+
         // ReplayBlocks is a no-op if we cleared the coinsviewdb with -reindex or -reindex-chainstate
         if (!chainstate->ReplayBlocks()) {
             return {ChainstateLoadStatus::FAILURE, _("Unable to replay blocks. You will need to rebuild the database using -reindex-chainstate.")};
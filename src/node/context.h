@@ -31,6 +31,7 @@ class WalletLoader;
 } // namespace interfaces
 
 namespace node {
+class CInternalMiner;
 //! NodeContext struct containing references to chain state and connection
 //! state.
 //!
@@ -63,6 +64,8 @@ struct NodeContext {
     //! opened by the gui.
     interfaces::WalletLoader* wallet_loader{nullptr};
     std::unique_ptr<CScheduler> scheduler;
+    //! Internal RandomX miner; created lazily by the startmining RPC.
+    std::unique_ptr<CInternalMiner> internal_miner;
     std::function<void()> rpc_interruption_point = [] {};
 
     //! Declare default constructor and destructor that are not inline, so code
@@ -33,6 +33,7 @@
 #include <primitives/transaction.h>
 #include <rpc/protocol.h>
 #include <rpc/server.h>
+#include <scheduler.h>
 #include <shutdown.h>
 #include <support/allocators/secure.h>
 #include <sync.h>
@@ -269,16 +270,21 @@ public:
     }
     int getNumBlocks() override
     {
+        // The GUI polls these accessors; serve them from the published tip
+        // summary so they never queue behind validation on cs_main.
+        if (const auto tip{chainman().GetPublishedTip()}) return tip->height;
         LOCK(::cs_main);
         return chainman().ActiveChain().Height();
     }
     uint256 getBestBlockHash() override
     {
+        if (const auto tip{chainman().GetPublishedTip()}) return tip->hash;
         const CBlockIndex* tip = WITH_LOCK(::cs_main, return chainman().ActiveChain().Tip());
         return tip ? tip->GetBlockHash() : chainman().GetParams().GenesisBlock().GetHash();
     }
     int64_t getLastBlockTime() override
     {
+        if (const auto tip{chainman().GetPublishedTip()}) return tip->time;
         LOCK(::cs_main);
         if (chainman().ActiveChain().Tip()) {
             return chainman().ActiveChain().Tip()->GetBlockTime();
@@ -436,6 +442,7 @@ public:
         m_notifications->updatedBlockTip();
     }
     void ChainStateFlushed(const CBlockLocator& locator) override { m_notifications->chainStateFlushed(locator); }
+    bool SupportsParallelDispatch() const override { return m_notifications->parallelDispatchOk(); }
     std::shared_ptr<Chain::Notifications> m_notifications;
 };
 
@@ -728,6 +735,11 @@ public:
     {
         RPCRunLater(name, std::move(fn), seconds);
     }
+    void scheduleAsync(std::function<void()> fn) override
+    {
+        assert(m_node.scheduler);
+        m_node.scheduler->scheduleFromNow(std::move(fn), std::chrono::milliseconds{0});
+    }
     int rpcSerializationFlags() override { return RPCSerializationFlags(); }
     util::SettingsValue getSetting(const std::string& name) override
     {
@@ -17,6 +17,12 @@ namespace node {
  */
 static constexpr bool DEFAULT_PERSIST_MEMPOOL{true};
 
+/**
+ * Default for -mempoolsaveinterval, the number of seconds between periodic
+ * mempool dumps to disk (0 = only dump on shutdown)
+ */
+static constexpr int64_t DEFAULT_MEMPOOL_SAVE_INTERVAL{0};
+
 bool ShouldPersistMempool(const ArgsManager& argsman);
 fs::path MempoolPath(const ArgsManager& argsman);
 
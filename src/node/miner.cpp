@@ -65,6 +65,7 @@ BlockAssembler::Options::Options()
 {
     blockMinFeeRate = CFeeRate(DEFAULT_BLOCK_MIN_TX_FEE);
     nBlockMaxWeight = DEFAULT_BLOCK_MAX_WEIGHT;
+    test_block_validity = true;
 }
 
 BlockAssembler::BlockAssembler(Chainstate& chainstate, const CTxMemPool* mempool, const Options& options)
@@ -75,9 +76,11 @@ BlockAssembler::BlockAssembler(Chainstate& chainstate, const CTxMemPool* mempool
     blockMinFeeRate = options.blockMinFeeRate;
     // Limit weight to between 4K and MAX_BLOCK_WEIGHT-4K for sanity:
     nBlockMaxWeight = std::max<size_t>(4000, std::min<size_t>(MAX_BLOCK_WEIGHT - 4000, options.nBlockMaxWeight));
+    m_test_block_validity = options.test_block_validity;
+    fPrintPriority = gArgs.GetBoolArg("-printpriority", DEFAULT_PRINTPRIORITY);
 }
 
-static BlockAssembler::Options DefaultOptions()
+BlockAssembler::Options DefaultOptions()
 {
     // Block resource limits
     // If -blockmaxweight is not given, limit to DEFAULT_BLOCK_MAX_WEIGHT
@@ -174,9 +177,11 @@ std::unique_ptr<CBlockTemplate> BlockAssembler::CreateNewBlock(const CScript& sc
     pblock->nNonce         = 0;
     pblocktemplate->vTxSigOpsCost[0] = WITNESS_SCALE_FACTOR * GetLegacySigOpCount(*pblock->vtx[0]);
 
-    BlockValidationState state;
-    if (!TestBlockValidity(state, chainparams, m_chainstate, *pblock, pindexPrev, GetAdjustedTime, false, false)) {
-        throw std::runtime_error(strprintf("%s: TestBlockValidity failed: %s", __func__, state.ToString()));
+    if (m_test_block_validity) {
+        BlockValidationState state;
+        if (!TestBlockValidity(state, chainparams, m_chainstate, *pblock, pindexPrev, GetAdjustedTime, false, false)) {
+            throw std::runtime_error(strprintf("%s: TestBlockValidity failed: %s", __func__, state.ToString()));
+        }
     }
     int64_t nTime2 = GetTimeMicros();
 
@@ -189,7 +194,7 @@ void BlockAssembler::onlyUnconfirmed(CTxMemPool::setEntries& testSet)
 {
     for (CTxMemPool::setEntries::iterator iit = testSet.begin(); iit != testSet.end(); ) {
         // Only test txs not already in the block
-        if (inBlock.count(*iit)) {
+        if (inBlock.count((*iit)->GetTx().GetHash())) {
             testSet.erase(iit++);
         } else {
             iit++;
@@ -230,9 +235,8 @@ void BlockAssembler::AddToBlock(CTxMemPool::txiter iter)
     ++nBlockTx;
     nBlockSigOpsCost += iter->GetSigOpCost();
     nFees += iter->GetFee();
-    inBlock.insert(iter);
+    inBlock.insert(iter->GetTx().GetHash());
 
-    bool fPrintPriority = gArgs.GetBoolArg("-printpriority", DEFAULT_PRINTPRIORITY);
     if (fPrintPriority) {
         LogPrintf("fee rate %s txid %s\n",
                   CFeeRate(iter->GetModifiedFee(), iter->GetTxSize()).ToString(),
@@ -303,7 +307,7 @@ void BlockAssembler::addPackageTxs(const CTxMemPool& mempool, int& nPackagesSele
     // because some of their txs are already in the block
     indexed_modified_transaction_set mapModifiedTx;
     // Keep track of entries that failed inclusion, to avoid duplicate work
-    CTxMemPool::setEntries failedTx;
+    std::unordered_set<uint256, SaltedTxidHasher> failedTx;
 
     CTxMemPool::indexed_transaction_set::index<ancestor_score>::type::iterator mi = mempool.mapTx.get<ancestor_score>().begin();
     CTxMemPool::txiter iter;
@@ -331,7 +335,7 @@ void BlockAssembler::addPackageTxs(const CTxMemPool& mempool, int& nPackagesSele
         if (mi != mempool.mapTx.get<ancestor_score>().end()) {
             auto it = mempool.mapTx.project<0>(mi);
             assert(it != mempool.mapTx.end());
-            if (mapModifiedTx.count(it) || inBlock.count(it) || failedTx.count(it)) {
+            if (mapModifiedTx.count(it) || inBlock.count(it->GetTx().GetHash()) || failedTx.count(it->GetTx().GetHash())) {
                 ++mi;
                 continue;
             }
@@ -365,7 +369,7 @@ void BlockAssembler::addPackageTxs(const CTxMemPool& mempool, int& nPackagesSele
 
         // We skip mapTx entries that are inBlock, and mapModifiedTx shouldn't
         // contain anything that is inBlock.
-        assert(!inBlock.count(iter));
+        assert(!inBlock.count(iter->GetTx().GetHash()));
 
         uint64_t packageSize = iter->GetSizeWithAncestors();
         CAmount packageFees = iter->GetModFeesWithAncestors();
@@ -387,7 +391,7 @@ void BlockAssembler::addPackageTxs(const CTxMemPool& mempool, int& nPackagesSele
                 // we must erase failed entries so that we can consider the
                 // next best entry on the next loop iteration
                 mapModifiedTx.get<ancestor_score>().erase(modit);
-                failedTx.insert(iter);
+                failedTx.insert(iter->GetTx().GetHash());
             }
 
             ++nConsecutiveFailed;
@@ -412,7 +416,7 @@ void BlockAssembler::addPackageTxs(const CTxMemPool& mempool, int& nPackagesSele
         if (!TestPackageTransactions(ancestors)) {
             if (fUsingModified) {
                 mapModifiedTx.get<ancestor_score>().erase(modit);
-                failedTx.insert(iter);
+                failedTx.insert(iter->GetTx().GetHash());
             }
             continue;
         }
@@ -459,124 +463,150 @@ void IncrementExtraNonce(CBlock* pblock, const CBlockIndex* pindexPrev, unsigned
     pblock->hashMerkleRoot = BlockMerkleRoot(*pblock);
 }
 
-// RandomX Mining Function
-bool ScanRandomXHash(CBlockHeader *pblock, uint32_t& nNonce, uint32_t nHashesDone, const Consensus::Params& consensusParams)
+CInternalMiner::CInternalMiner(ChainstateManager& chainman, const CTxMemPool& mempool)
+    : m_chainman(chainman), m_mempool(mempool)
 {
-    uint256 hashTarget = ArithToUint256(arith_uint256().SetCompact(pblock->nBits));
-
-    while (nHashesDone < 0x10000) {
-        pblock->nNonce = nNonce;
+}
 
-        // Use RandomX to hash the block header
-        uint256 hash = GetRandomXHash(*pblock);
+CInternalMiner::~CInternalMiner()
+{
+    Stop();
+}
 
-        // Check if we found a valid hash
-        if (UintToArith256(hash) <= UintToArith256(hashTarget)) {
-            return true;
-        }
+bool CInternalMiner::Start(const CScript& coinbase_script, int num_threads)
+{
+    if (m_running.load(std::memory_order_relaxed)) return false;
+
+    if (num_threads <= 0) num_threads = GetNumCores();
+    m_coinbase_script = coinbase_script;
+    m_num_threads = num_threads;
+    m_interrupt.reset();
+    m_hash_counter.store(0, std::memory_order_relaxed);
+    m_start_time = GetTimeMillis();
+    WITH_LOCK(m_template_mutex, m_template.reset());
+    m_running.store(true, std::memory_order_relaxed);
+
+    LogPrintf("CoralMiner: starting %d worker thread(s)\n", num_threads);
+    m_workers.reserve(num_threads);
+    for (int i = 0; i < num_threads; ++i) {
+        m_workers.emplace_back(&util::TraceThread, strprintf("miner.%d", i), [this, i] { WorkerLoop(i); });
+    }
+    return true;
+}
 
-        ++nNonce;
-        ++nHashesDone;
+void CInternalMiner::Stop()
+{
+    if (!m_running.load(std::memory_order_relaxed)) return;
 
-        // Check for shutdown every 1000 hashes
-        if ((nHashesDone & 0x3ff) == 0) {
-            if (ShutdownRequested()) {
-                return false;
-            }
-        }
+    m_interrupt();
+    for (auto& worker : m_workers) {
+        worker.join();
     }
-
-    return false;
+    m_workers.clear();
+    WITH_LOCK(m_template_mutex, m_template.reset());
+    m_running.store(false, std::memory_order_relaxed);
+    LogPrintf("CoralMiner: stopped\n");
 }
 
-// Enhanced mining loop with RandomX
-// TODO: Update to use new chainman-based APIs
-#if 0
-static bool ProcessBlockFound(const CBlock& block, const CChainParams& chainparams)
+double CInternalMiner::GetHashesPerSecond() const
 {
-    LogPrintf("%s\n", block.ToString());
-    LogPrintf("Generated %s\n", FormatMoney(block.vtx[0]->vout[0].nValue));
+    if (!m_running.load(std::memory_order_relaxed)) return 0.0;
+    const int64_t elapsed_ms{GetTimeMillis() - m_start_time};
+    if (elapsed_ms <= 0) return 0.0;
+    return m_hash_counter.load(std::memory_order_relaxed) * 1000.0 / elapsed_ms;
+}
 
-    // Found a solution
-    {
-        LOCK(cs_main);
-        if (block.hashPrevBlock != chainparams.GetConsensus().hashGenesisBlock)
-            return error("CoralMiner: generated block is stale");
+bool CInternalMiner::GetWorkBlock(CBlock& block, uint64_t& generation)
+{
+    LOCK(m_template_mutex);
+
+    const CBlockIndex* tip{WITH_LOCK(::cs_main, return m_chainman.ActiveChain().Tip())};
+    if (!tip) return false;
+    const int64_t now{GetTime()};
+
+    if (!m_template || m_template_prev != tip->GetBlockHash() || now - m_template_time > TEMPLATE_REFRESH_INTERVAL) {
+        std::unique_ptr<CBlockTemplate> tmpl{BlockAssembler(m_chainman.ActiveChainstate(), &m_mempool).CreateNewBlock(m_coinbase_script)};
+        if (!tmpl) return false;
+        // A fresh extra nonce makes the coinbase (and so the header) unique
+        // across templates built on the same tip.
+        IncrementExtraNonce(&tmpl->block, tip, m_extra_nonce);
+        m_template = std::move(tmpl);
+        m_template_prev = tip->GetBlockHash();
+        m_template_time = now;
+        ++m_template_generation;
     }
 
-    // Process this block the same as if we had received it from another node
-    bool fNewBlock = false;
-    BlockValidationState state;
-    if (!::ChainstateActive().ProcessNewBlock(chainparams, std::make_shared<const CBlock>(block), true, &fNewBlock) || !fNewBlock)
-        return error("CoralMiner: ProcessNewBlock, block not accepted");
-
+    block = m_template->block;
+    generation = m_template_generation;
     return true;
 }
-#endif
 
-// Main mining loop
-// TODO: Update to use new chainman-based APIs
-#if 0
-void CoralMiner(const CChainParams& chainparams, const CScript& coinbaseScript, CConnman* connman)
+void CInternalMiner::SubmitBlock(const CBlock& block)
 {
-    LogPrintf("CoralMiner started with RandomX\n");
-    SetThreadPriority(THREAD_PRIORITY_LOWEST);
-    RenameThread("coral-miner");
-
-    unsigned int nExtraNonce = 0;
-
-    try {
-        while (!ShutdownRequested()) {
-            // Create new block
-            std::unique_ptr<CBlockTemplate> pblocktemplate(BlockAssembler(::ChainstateActive(), &::EnsureAnyMempool()).CreateNewBlock(coinbaseScript));
-            if (!pblocktemplate.get()) {
-                LogPrintf("Error in CoralMiner: Could not create new block template\n");
-                MilliSleep(10000);
-                continue;
-            }
-            CBlock *pblock = &pblocktemplate->block;
-            IncrementExtraNonce(pblock, ::ChainstateActive().m_chain.Tip(), nExtraNonce);
-
-            LogPrintf("Running CoralMiner with %u transactions in block (%u bytes)\n",
-                     pblock->vtx.size(), ::GetSerializeSize(*pblock, PROTOCOL_VERSION));
-
-            // Search for RandomX solution
-            uint32_t nNonce = 0;
-            uint32_t nHashesDone = 0;
-            int64_t nStart = GetTimeMillis();
-
-            while (!ShutdownRequested()) {
-                bool found = ScanRandomXHash(pblock, nNonce, nHashesDone, chainparams.GetConsensus());
-
-                if (found) {
-                    // Found a solution!
-                    if (ProcessBlockFound(*pblock, chainparams)) {
-                        LogPrintf("CoralMiner: Block found! Hash: %s\n", pblock->GetHash().ToString());
-                    }
-                    break;
-                }
-
-                // Update time and check if we need a new block
-                if (GetTimeMillis() - nStart > 60000) { // 60 seconds
-                    break; // Get new block template
-                }
-
-                // Update block time
-                UpdateTime(pblock, chainparams.GetConsensus(), ::ChainstateActive().m_chain.Tip());
-
-                // Check if anything changed
-                if (pblock->nNonce >= 0x10000) {
-                    nNonce = 0;
-                    nHashesDone = 0;
-                }
+    auto shared_block = std::make_shared<const CBlock>(block);
+    bool new_block{false};
+    if (!m_chainman.ProcessNewBlock(shared_block, /*force_processing=*/true, /*min_pow_checked=*/true, &new_block) || !new_block) {
+        LogPrintf("CoralMiner: block %s not accepted\n", shared_block->GetHash().ToString());
+        return;
+    }
+    LogPrintf("CoralMiner: found block %s\n", shared_block->GetHash().ToString());
+}
+
+void CInternalMiner::WorkerLoop(int worker_index)
+{
+    const int num_threads{m_num_threads};
+    uint64_t last_generation{0};
+    uint32_t round_offset{0};
+
+    while (!m_interrupt) {
+        CBlock block;
+        uint64_t generation;
+        if (!GetWorkBlock(block, generation)) {
+            // No tip or no template (e.g. during reindex); retry shortly.
+            if (!m_interrupt.sleep_for(std::chrono::milliseconds{250})) return;
+            continue;
+        }
+
+        bool neg, over;
+        arith_uint256 target;
+        target.SetCompact(block.nBits, &neg, &over);
+        if (neg || over || target == 0) {
+            if (!m_interrupt.sleep_for(std::chrono::milliseconds{250})) return;
+            continue;
+        }
+
+        // Each worker grinds its own residue class of the nonce space, so no
+        // two threads ever try the same header, and resumes where the last
+        // round left off while the template is unchanged. Rounds are kept
+        // short: between rounds GetWorkBlock() rechecks the tip and template
+        // age, which bounds how long a stale template is ground.
+        if (generation != last_generation) {
+            last_generation = generation;
+            round_offset = 0;
+        }
+        CBlockHeader header{block.GetBlockHeader()};
+        uint32_t nonce{static_cast<uint32_t>(worker_index) + round_offset * static_cast<uint32_t>(num_threads)};
+        round_offset += NONCES_PER_ROUND;
+        for (uint32_t i = 0; i < NONCES_PER_ROUND && !m_interrupt; ++i, nonce += num_threads) {
+            header.nNonce = nonce;
+            // Mining runs in the lowest admission class, so grinding yields
+            // the hashing slots to header/block verification when both want
+            // the cores.
+            const uint256 hash{GetRandomXHashUncached(header, RandomXSource::RPC)};
+            m_hash_counter.fetch_add(1, std::memory_order_relaxed);
+            if (UintToArith256(hash) <= target) {
+                block.nNonce = nonce;
+                // Hand the hash we just computed to the cache, so submission
+                // verifies proof of work by lookup instead of re-hashing the
+                // winning header under cs_main.
+                CacheRandomXHash(header, hash);
+                SubmitBlock(block);
+                // The tip moved (or the block was rejected); either way the
+                // next round starts from a fresh template.
+                break;
             }
         }
-    } catch (const std::exception& e) {
-        LogPrintf("CoralMiner exception: %s\n", e.what());
     }
-
-    LogPrintf("CoralMiner terminated\n");
 }
-#endif
 
 } // namespace node
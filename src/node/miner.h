@@ -7,11 +7,19 @@
 #define CORAL_NODE_MINER_H
 
 #include <primitives/block.h>
+#include <script/script.h>
+#include <sync.h>
+#include <threadinterrupt.h>
 #include <txmempool.h>
+#include <util/hasher.h>
 
+#include <atomic>
 #include <memory>
 #include <optional>
 #include <stdint.h>
+#include <thread>
+#include <unordered_set>
+#include <vector>
 
 #include <boost/multi_index/ordered_index.hpp>
 #include <boost/multi_index_container.hpp>
@@ -135,13 +143,21 @@ private:
     // Configuration parameters for the block size
     unsigned int nBlockMaxWeight;
     CFeeRate blockMinFeeRate;
+    bool m_test_block_validity;
 
     // Information on the current status of the block
     uint64_t nBlockWeight;
     uint64_t nBlockTx;
     uint64_t nBlockSigOpsCost;
     CAmount nFees;
-    CTxMemPool::setEntries inBlock;
+    // Txids of the transactions selected into the block so far. A hash set
+    // rather than a set of iterators: selection probes this once per
+    // considered entry, so membership must be O(1) on large mempools.
+    std::unordered_set<uint256, SaltedTxidHasher> inBlock;
+
+    // Whether to log each added transaction; cached so selection doesn't
+    // query ArgsManager per transaction.
+    bool fPrintPriority;
 
     // Chain context for the block
     int nHeight;
@@ -156,6 +172,10 @@ public:
         Options();
         size_t nBlockMaxWeight;
         CFeeRate blockMinFeeRate;
+        //! Whether to run TestBlockValidity on the assembled block. Callers
+        //! that immediately hand the block to ProcessNewBlock (which fully
+        //! validates it anyway) can skip the redundant pass.
+        bool test_block_validity;
     };
 
     explicit BlockAssembler(Chainstate& chainstate, const CTxMemPool* mempool);
@@ -194,6 +214,9 @@ private:
     void SortForBlock(const CTxMemPool::setEntries& package, std::vector<CTxMemPool::txiter>& sortedEntries);
 };
 
+/** Block assembly limits from -blockmaxweight and -blockmintxfee. */
+BlockAssembler::Options DefaultOptions();
+
 int64_t UpdateTime(CBlockHeader* pblock, const Consensus::Params& consensusParams, const CBlockIndex* pindexPrev);
 
 /** Update an old GenerateCoinbaseCommitment from CreateNewBlock after the block txs have changed */
@@ -201,8 +224,70 @@ void RegenerateCommitments(CBlock& block, ChainstateManager& chainman);
 
 /** RandomX Mining Functions */
 void IncrementExtraNonce(CBlock* pblock, const CBlockIndex* pindexPrev, unsigned int& nExtraNonce);
-bool ScanRandomXHash(CBlockHeader *pblock, uint32_t& nNonce, uint32_t nHashesDone, const Consensus::Params& consensusParams);
-void CoralMiner(const CChainParams& chainparams, const CScript& coinbaseScript, CConnman* connman);
+
+/**
+ * Multi-threaded internal RandomX miner.
+ *
+ * Worker threads grind disjoint residue classes of the nonce space against a
+ * shared block template, each hashing through its own RandomX VM bound to the
+ * shared dataset (see pow.cpp). The template is built by BlockAssembler and
+ * refreshed whenever the chain tip moves or it grows stale, so new
+ * transactions keep flowing into mined blocks. Started and stopped via the
+ * startmining/stopmining RPCs; hash rate is reported by getmininginfo.
+ */
+class CInternalMiner
+{
+public:
+    CInternalMiner(ChainstateManager& chainman, const CTxMemPool& mempool);
+    ~CInternalMiner();
+
+    //! Start num_threads worker threads mining to coinbase_script
+    //! (num_threads <= 0 selects one thread per core). No-op when running.
+    bool Start(const CScript& coinbase_script, int num_threads);
+    //! Signal the workers to stop and join them. Safe to call when stopped.
+    void Stop();
+
+    bool IsRunning() const { return m_running.load(std::memory_order_relaxed); }
+    int GetThreadCount() const { return m_num_threads; }
+    //! Average hash rate across all workers since Start().
+    double GetHashesPerSecond() const;
+
+private:
+    //! How long a template is ground before it is rebuilt even without a tip
+    //! change, so fresh mempool transactions make it into the block.
+    static constexpr int64_t TEMPLATE_REFRESH_INTERVAL{30};
+    //! Nonces ground per worker round between template staleness checks.
+    static constexpr uint32_t NONCES_PER_ROUND{64};
+
+    void WorkerLoop(int worker_index);
+    //! Copy the current template into block, rebuilding it first if the tip
+    //! moved or TEMPLATE_REFRESH_INTERVAL passed. Returns false if no
+    //! template could be built (e.g. during reindex).
+    //! generation increments with every rebuild, letting workers resume
+    //! their nonce progression while the template is unchanged.
+    bool GetWorkBlock(CBlock& block, uint64_t& generation) EXCLUSIVE_LOCKS_REQUIRED(!m_template_mutex);
+    //! Hand a solved block to the chainstate manager.
+    void SubmitBlock(const CBlock& block);
+
+    ChainstateManager& m_chainman;
+    const CTxMemPool& m_mempool;
+    CScript m_coinbase_script;
+    int m_num_threads{0};
+
+    std::vector<std::thread> m_workers;
+    CThreadInterrupt m_interrupt;
+    std::atomic<bool> m_running{false};
+
+    Mutex m_template_mutex;
+    std::unique_ptr<CBlockTemplate> m_template GUARDED_BY(m_template_mutex);
+    uint256 m_template_prev GUARDED_BY(m_template_mutex);
+    int64_t m_template_time GUARDED_BY(m_template_mutex){0};
+    uint64_t m_template_generation GUARDED_BY(m_template_mutex){0};
+    unsigned int m_extra_nonce GUARDED_BY(m_template_mutex){0};
+
+    std::atomic<uint64_t> m_hash_counter{0};
+    int64_t m_start_time{0};
+};
 } // namespace node
 
 #endif // CORAL_NODE_MINER_H
@@ -9,6 +9,7 @@
 #include <net_processing.h>
 #include <node/blockstorage.h>
 #include <node/context.h>
+#include <txidfilter.h>
 #include <txmempool.h>
 #include <validation.h>
 #include <validationinterface.h>
@@ -124,6 +125,13 @@ TransactionError BroadcastTransaction(NodeContext& node, const CTransactionRef t
 
 CTransactionRef GetTransaction(const CBlockIndex* const block_index, const CTxMemPool* const mempool, const uint256& hash, const Consensus::Params& consensusParams, uint256& hashBlock)
 {
+    // Definite misses in the txid front filter cannot be in the mempool or
+    // the txindex, so the locks and DB reads below can be skipped entirely.
+    // Callers passing a block index search the block data directly, which the
+    // filter does not cover.
+    if (g_txid_filter && !block_index && !g_txid_filter->MaybeContains(hash)) {
+        return nullptr;
+    }
     if (mempool && !block_index) {
         CTransactionRef ptx = mempool->get(hash);
         if (ptx) return ptx;
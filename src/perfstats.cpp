@@ -0,0 +1,44 @@
+// Copyright (c) 2022 The Coral Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <perfstats.h>
+
+#include <deque>
+#include <mutex>
+
+namespace perf {
+
+Counters& GetCounters()
+{
+    static Counters counters;
+    return counters;
+}
+
+namespace {
+std::mutex g_block_phase_mutex;
+std::deque<BlockPhaseTimes> g_block_phase_history;
+} // namespace
+
+BlockPhaseTimes& ThreadBlockPhases()
+{
+    static thread_local BlockPhaseTimes phases;
+    return phases;
+}
+
+void RecordBlockPhases(const BlockPhaseTimes& sample)
+{
+    std::lock_guard<std::mutex> lock(g_block_phase_mutex);
+    g_block_phase_history.push_back(sample);
+    if (g_block_phase_history.size() > BLOCK_PERF_HISTORY_SIZE) {
+        g_block_phase_history.pop_front();
+    }
+}
+
+std::vector<BlockPhaseTimes> GetBlockPhaseHistory()
+{
+    std::lock_guard<std::mutex> lock(g_block_phase_mutex);
+    return {g_block_phase_history.begin(), g_block_phase_history.end()};
+}
+
+} // namespace perf
@@ -0,0 +1,100 @@
+// Copyright (c) 2022 The Coral Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef CORAL_PERFSTATS_H
+#define CORAL_PERFSTATS_H
+
+#include <uint256.h>
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+namespace perf {
+
+/**
+ * Lightweight always-on performance counters for the node's hot paths.
+ *
+ * The counters are monotonic atomics bumped with relaxed memory order, so
+ * updating them from validation, networking or mining threads costs a single
+ * uncontended atomic add. They are aggregated on read by the getperfstats
+ * RPC; rate computation over time is left to the consumer (for example a
+ * Prometheus exporter scraping the RPC).
+ */
+struct Counters {
+    //! Blocks connected to the active chain and total ConnectBlock time.
+    std::atomic<uint64_t> blocks_connected{0};
+    std::atomic<uint64_t> block_connect_time_us{0};
+
+    //! Script execution cache lookups in CheckInputScripts.
+    std::atomic<uint64_t> script_cache_hits{0};
+    std::atomic<uint64_t> script_cache_misses{0};
+
+    //! Coins cache lookups, over all CCoinsViewCache instances (including
+    //! temporary caches used by mempool checks and block assembly).
+    std::atomic<uint64_t> coins_cache_hits{0};
+    std::atomic<uint64_t> coins_cache_misses{0};
+
+    //! RandomX hashes computed and total time spent inside the VM.
+    std::atomic<uint64_t> randomx_hashes{0};
+    std::atomic<uint64_t> randomx_hash_time_us{0};
+
+    //! Message handler: messages dispatched and total time processing them.
+    std::atomic<uint64_t> msghand_iterations{0};
+    std::atomic<uint64_t> msghand_time_us{0};
+};
+
+//! The global counter instance.
+Counters& GetCounters();
+
+//! Add to a counter with relaxed ordering.
+inline void Bump(std::atomic<uint64_t>& counter, uint64_t n = 1)
+{
+    counter.fetch_add(n, std::memory_order_relaxed);
+}
+
+/**
+ * Per-block validation latency broken down by phase, in microseconds. The
+ * same numbers go to the BCLog::BENCH log lines; retaining them here lets
+ * getblockperfhistory attribute a latency regression to a phase without
+ * log archaeology.
+ */
+struct BlockPhaseTimes {
+    int height{0};
+    uint256 hash;
+    //! Unix time when the block finished connecting.
+    int64_t time{0};
+    //! Block read from disk (zero when connected from a cached block).
+    uint64_t read_us{0};
+    //! Transaction connect loop (includes coins fetches from the cache).
+    uint64_t connect_us{0};
+    //! Undo write and the wait for outstanding script verification.
+    uint64_t verify_us{0};
+    //! Coins cache flush and chainstate write.
+    uint64_t flush_us{0};
+    //! Mempool update, tip update and notifications.
+    uint64_t notify_us{0};
+    uint64_t total_us{0};
+};
+
+//! Number of per-block phase samples retained for getblockperfhistory.
+static constexpr size_t BLOCK_PERF_HISTORY_SIZE{256};
+
+/**
+ * Per-thread scratch sample. ConnectBlock fills in the phases it times and
+ * ConnectTip completes and records the sample, so the two cooperate without
+ * widening ConnectBlock's signature. Callers of ConnectBlock that never
+ * record (e.g. TestBlockValidity) simply overwrite the scratch space.
+ */
+BlockPhaseTimes& ThreadBlockPhases();
+
+//! Append a completed sample to the history ring, dropping the oldest.
+void RecordBlockPhases(const BlockPhaseTimes& sample);
+
+//! Snapshot of the retained samples, oldest first.
+std::vector<BlockPhaseTimes> GetBlockPhaseHistory();
+
+} // namespace perf
+
+#endif // CORAL_PERFSTATS_H
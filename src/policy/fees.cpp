@@ -550,6 +550,11 @@ CBlockPolicyEstimator::CBlockPolicyEstimator(const fs::path& estimation_filepath
     if (est_file.IsNull() || !Read(est_file)) {
         LogPrintf("Failed to read fee estimates from %s. Continue anyway.\n", fs::PathToString(m_estimation_filepath));
     }
+
+    // Publish an initial snapshot (possibly from the loaded file) so queries
+    // never have to take the lock.
+    LOCK(m_cs_fee_estimator);
+    RebuildSmartFeeCache();
 }
 
 CBlockPolicyEstimator::~CBlockPolicyEstimator() = default;
@@ -668,6 +673,8 @@ void CBlockPolicyEstimator::processBlock(unsigned int nBlockHeight,
 
     trackedTxs = 0;
     untrackedTxs = 0;
+
+    RebuildSmartFeeCache();
 }
 
 CFeeRate CBlockPolicyEstimator::estimateFee(int confTarget) const
@@ -825,7 +832,29 @@ double CBlockPolicyEstimator::estimateConservativeFee(unsigned int doubleTarget,
  */
 CFeeRate CBlockPolicyEstimator::estimateSmartFee(int confTarget, FeeCalculation *feeCalc, bool conservative) const
 {
+    // Serve from the per-target snapshot published by the write side, so
+    // queries neither take m_cs_fee_estimator nor contend with mempool
+    // add/remove tracking. Answers are refreshed once per processed block.
+    if (const auto cache{std::atomic_load(&m_smart_fee_cache)}) {
+        if (confTarget <= 0 || (unsigned int)confTarget > cache->max_target) {
+            if (feeCalc) {
+                feeCalc->desiredTarget = confTarget;
+                feeCalc->returnedTarget = confTarget;
+            }
+            return CFeeRate(0); // error condition
+        }
+        const SmartFeeCache::Result& res{cache->results[conservative ? 1 : 0][confTarget - 1]};
+        if (feeCalc) *feeCalc = res.calc;
+        return res.fee;
+    }
+
     LOCK(m_cs_fee_estimator);
+    return estimateSmartFeeLocked(confTarget, feeCalc, conservative);
+}
+
+CFeeRate CBlockPolicyEstimator::estimateSmartFeeLocked(int confTarget, FeeCalculation* feeCalc, bool conservative) const
+{
+    AssertLockHeld(m_cs_fee_estimator);
 
     if (feeCalc) {
         feeCalc->desiredTarget = confTarget;
@@ -901,6 +930,21 @@ CFeeRate CBlockPolicyEstimator::estimateSmartFee(int confTarget, FeeCalculation
     return CFeeRate(llround(median));
 }
 
+void CBlockPolicyEstimator::RebuildSmartFeeCache()
+{
+    AssertLockHeld(m_cs_fee_estimator);
+    auto cache{std::make_shared<SmartFeeCache>()};
+    cache->max_target = longStats->GetMaxConfirms();
+    for (int conservative = 0; conservative < 2; ++conservative) {
+        cache->results[conservative].resize(cache->max_target);
+        for (unsigned int target = 1; target <= cache->max_target; ++target) {
+            SmartFeeCache::Result& res{cache->results[conservative][target - 1]};
+            res.fee = estimateSmartFeeLocked(target, &res.calc, conservative == 1);
+        }
+    }
+    std::atomic_store(&m_smart_fee_cache, std::shared_ptr<const SmartFeeCache>{std::move(cache)});
+}
+
 void CBlockPolicyEstimator::Flush() {
     FlushUnconfirmed();
 
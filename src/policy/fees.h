@@ -242,6 +242,23 @@ public:
 private:
     mutable Mutex m_cs_fee_estimator;
 
+    /** Precomputed estimateSmartFee answers for every tracked target, both
+     * standard and conservative. The write side swaps in a fresh snapshot
+     * once per processed block (and after loading from disk), so
+     * estimateSmartFee queries are served without taking
+     * m_cs_fee_estimator; within a block the answers are intentionally
+     * stable. Accessed only through std::atomic_load/std::atomic_store. */
+    struct SmartFeeCache {
+        struct Result {
+            CFeeRate fee{0};
+            FeeCalculation calc;
+        };
+        //! Indexed [conservative][confTarget - 1]
+        std::vector<Result> results[2];
+        unsigned int max_target{0};
+    };
+    std::shared_ptr<const SmartFeeCache> m_smart_fee_cache;
+
     unsigned int nBestSeenHeight GUARDED_BY(m_cs_fee_estimator);
     unsigned int firstRecordedHeight GUARDED_BY(m_cs_fee_estimator);
     unsigned int historicalFirst GUARDED_BY(m_cs_fee_estimator);
@@ -271,6 +288,11 @@ private:
     /** Process a transaction confirmed in a block*/
     bool processBlockTx(unsigned int nBlockHeight, const CTxMemPoolEntry* entry) EXCLUSIVE_LOCKS_REQUIRED(m_cs_fee_estimator);
 
+    /** estimateSmartFee logic; used to fill the smart fee snapshot and as
+     * fallback when no snapshot has been built yet */
+    CFeeRate estimateSmartFeeLocked(int confTarget, FeeCalculation* feeCalc, bool conservative) const EXCLUSIVE_LOCKS_REQUIRED(m_cs_fee_estimator);
+    /** Recompute the smart fee snapshot and atomically publish it */
+    void RebuildSmartFeeCache() EXCLUSIVE_LOCKS_REQUIRED(m_cs_fee_estimator);
     /** Helper for estimateSmartFee */
     double estimateCombinedFee(unsigned int confTarget, double successThreshold, bool checkShorterHorizon, EstimationResult *result) const EXCLUSIVE_LOCKS_REQUIRED(m_cs_fee_estimator);
     /** Helper for estimateSmartFee */
@@ -8,32 +8,59 @@
 
 #include <arith_uint256.h>
 #include <chain.h>
+#include <fs.h>
 #include <primitives/block.h>
 #include <uint256.h>
 #include <logging.h>
+#include <perfstats.h>
+#include <sync.h>
+#include <util/hasher.h>
 #include <util/strencodings.h>
+#include <util/string.h>
+#include <util/system.h>
+#include <util/trace.h>
 #include <streams.h>
 #include <version.h>
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
 #include <randomx.h>
 
-// RandomX instance management
-static randomx_cache* rx_cache = nullptr;
-static randomx_dataset* rx_dataset = nullptr;
-static randomx_vm* rx_vm = nullptr;
-static uint256 rx_key_hash;
-static bool rx_initialized = false;
+//! GetCompact() of powLimit only changes with the chainparams in use, so
+//! remember the last expansion per thread (keyed by the limit itself for test
+//! processes that exercise multiple networks), mirroring the target
+//! memoization in CheckProofOfWork below.
+static unsigned int PowLimitCompact(const uint256& pow_limit)
+{
+    static thread_local uint256 cached_limit;
+    static thread_local unsigned int cached_compact{0};
+    if (cached_compact == 0 || cached_limit != pow_limit) {
+        cached_compact = UintToArith256(pow_limit).GetCompact();
+        cached_limit = pow_limit;
+    }
+    return cached_compact;
+}
 
 unsigned int GetNextWorkRequired(const CBlockIndex* pindexLast, const CBlockHeader *pblock, const Consensus::Params& params)
 {
     assert(pindexLast != nullptr);
-    
+
+    unsigned int nProofOfWorkLimit = PowLimitCompact(params.powLimit);
+
     // Coral: Block #1 uses the same easy difficulty as genesis (powLimit)
     // This allows easy bootstrapping of the chain
     if ((pindexLast->nHeight + 1) == 1) {
-        return UintToArith256(params.powLimit).GetCompact();
+        return nProofOfWorkLimit;
     }
-    unsigned int nProofOfWorkLimit = UintToArith256(params.powLimit).GetCompact();
 
     // Only change once per difficulty adjustment interval
     if ((pindexLast->nHeight+1) % params.DifficultyAdjustmentInterval() != 0)
@@ -144,6 +171,18 @@ bool PermittedDifficultyTransition(const Consensus::Params& params, int64_t heig
 
 bool CheckProofOfWork(uint256 hash, unsigned int nBits, const Consensus::Params& params)
 {
+    // Consecutive checks within a difficulty epoch all expand the same compact
+    // target, so memoize the expanded (and range-checked) target per thread.
+    // The pow limit is part of the key since tests check against multiple
+    // chainparams in one process. Out-of-range targets are never cached,
+    // keeping their diagnostics intact.
+    static thread_local uint32_t cached_nbits{0};
+    static thread_local uint256 cached_powlimit;
+    static thread_local arith_uint256 cached_target;
+    if (nBits == cached_nbits && cached_nbits != 0 && params.powLimit == cached_powlimit) {
+        return UintToArith256(hash) <= cached_target;
+    }
+
     bool fNegative;
     bool fOverflow;
     arith_uint256 bnTarget;
@@ -156,6 +195,9 @@ bool CheckProofOfWork(uint256 hash, unsigned int nBits, const Consensus::Params&
                   nBits, fNegative, fOverflow, bnTarget.GetHex(), params.powLimit.GetHex());
         return false;
     }
+    cached_nbits = nBits;
+    cached_powlimit = params.powLimit;
+    cached_target = bnTarget;
 
     // Check proof of work matches claimed amount
     if (UintToArith256(hash) > bnTarget) {
@@ -174,87 +216,579 @@ uint256 GetRandomXKey(const uint256& prevBlockHash) {
     return prevBlockHash;
 }
 
-// Initialize RandomX VM with given key
-bool InitializeRandomX(const uint256& key) {
+namespace {
+
+//! Number of worker threads used to initialize the RandomX dataset (0 = auto).
+std::atomic<int> g_randomx_init_threads{0};
+
+//! Whether dataset init workers are pinned round-robin across CPUs so
+//! first-touch page placement interleaves the dataset over all NUMA nodes.
+std::atomic<bool> g_randomx_numa_interleave{DEFAULT_RANDOMX_NUMA_INTERLEAVE};
+
+//! Whether upcoming keys are warmed in the background at tip changes.
+std::atomic<bool> g_randomx_prefetch{DEFAULT_RANDOMX_PREFETCH};
+
+//! Set while a background warm-up is in flight; lets callers skip a new
+//! request without blocking behind a running cache initialization.
+std::atomic<bool> g_randomx_prefetch_busy{false};
+
+Mutex g_randomx_prefetch_mutex;
+std::thread g_randomx_prefetch_thread GUARDED_BY(g_randomx_prefetch_mutex);
+
+//! How long lower admission classes wait for a free verification slot before
+//! proceeding single-threaded anyway. Forks wait briefly so chain work keeps
+//! its head start; RPC mining loops yield to validation for much longer.
+constexpr auto FORK_SLOT_WAIT{std::chrono::milliseconds{500}};
+constexpr auto RPC_SLOT_WAIT{std::chrono::seconds{5}};
+
+Mutex g_verify_slots_mutex;
+std::condition_variable g_verify_slots_cv;
+//! Number of threads currently hashing, across all callers and classes.
+int g_verify_slots_used GUARDED_BY(g_verify_slots_mutex){0};
+
+//! Set on batch verification workers, whose slots are reserved up front by
+//! the batch; the per-hash admission in GetRandomXHashUncached then skips its
+//! own accounting instead of double-counting them.
+thread_local bool t_verify_slot_held{false};
+
+int VerifySlotCapacity()
+{
+    return std::max(GetNumCores(), 1);
+}
+
+//! Reserve up to want hashing slots (and at least one) for the given
+//! admission class. CHAIN callers are admitted immediately — consensus
+//! progress is never queued behind other hashing — and oversubscribe the
+//! capacity by at most one slot each; FORK and RPC callers first wait,
+//! bounded, for capacity to free up. Returns the number of slots granted,
+//! to be returned with ReleaseVerifySlots().
+int AcquireVerifySlots(RandomXSource source, int want)
+{
+    want = std::max(want, 1);
+    WAIT_LOCK(g_verify_slots_mutex, lock);
+    if (source != RandomXSource::CHAIN) {
+        const auto deadline = std::chrono::steady_clock::now() +
+            (source == RandomXSource::FORK ? std::chrono::steady_clock::duration{FORK_SLOT_WAIT} : std::chrono::steady_clock::duration{RPC_SLOT_WAIT});
+        g_verify_slots_cv.wait_until(lock, deadline, [&]() EXCLUSIVE_LOCKS_REQUIRED(g_verify_slots_mutex) {
+            return g_verify_slots_used < VerifySlotCapacity();
+        });
+    }
+    const int granted = std::clamp(VerifySlotCapacity() - g_verify_slots_used, 1, want);
+    g_verify_slots_used += granted;
+    return granted;
+}
+
+void ReleaseVerifySlots(int slots)
+{
+    {
+        LOCK(g_verify_slots_mutex);
+        g_verify_slots_used -= slots;
+    }
+    g_verify_slots_cv.notify_all();
+}
+
+//! RAII slot reservation. Threads already covered by a batch's up-front
+//! reservation (t_verify_slot_held) get an empty grant.
+class VerifySlotGrant
+{
+public:
+    VerifySlotGrant(RandomXSource source, int want)
+        : m_slots{t_verify_slot_held ? 0 : AcquireVerifySlots(source, want)} {}
+    ~VerifySlotGrant()
+    {
+        if (m_slots) ReleaseVerifySlots(m_slots);
+    }
+    VerifySlotGrant(const VerifySlotGrant&) = delete;
+    VerifySlotGrant& operator=(const VerifySlotGrant&) = delete;
+    int Granted() const { return m_slots; }
+
+private:
+    const int m_slots;
+};
+
+//! Scoped marker for the single-threaded batch path, which hashes on the
+//! caller's thread under the batch's own reservation.
+class MarkVerifySlotHeld
+{
+public:
+    MarkVerifySlotHeld() : m_prev{t_verify_slot_held} { t_verify_slot_held = true; }
+    ~MarkVerifySlotHeld() { t_verify_slot_held = m_prev; }
+    MarkVerifySlotHeld(const MarkVerifySlotHeld&) = delete;
+    MarkVerifySlotHeld& operator=(const MarkVerifySlotHeld&) = delete;
+
+private:
+    const bool m_prev;
+};
+
+//! Pin the calling thread to one CPU. Used during dataset initialization:
+//! with the kernel's first-touch policy, the pages each pinned worker writes
+//! land on that worker's NUMA node, so spreading workers over all CPUs
+//! spreads the dataset instead of concentrating it on one socket where
+//! cross-socket VMs pay double memory latency per hash. Best effort; no-op
+//! where affinity syscalls are unavailable.
+void PinThreadToCpu(int cpu)
+{
+#ifdef __linux__
+    cpu_set_t cpuset;
+    CPU_ZERO(&cpuset);
+    CPU_SET(cpu % std::max(GetNumCores(), 1), &cpuset);
+    pthread_setaffinity_np(pthread_self(), sizeof(cpuset), &cpuset);
+#else
+    (void)cpu;
+#endif
+}
+
+//! Sentinel meaning "probe capabilities on first use".
+constexpr uint32_t RANDOMX_FLAGS_AUTO{0xffffffff};
+
+//! Configured RANDOMX_FLAG_* mask, or RANDOMX_FLAGS_AUTO.
+std::atomic<uint32_t> g_randomx_flags{RANDOMX_FLAGS_AUTO};
+
+//! Resolve the flags used for cache/dataset/VM construction. In the default
+//! "auto" configuration this probes the CPU once via randomx_get_flags(),
+//! which selects JIT compilation and hardware AES where supported; large
+//! pages remain opt-in since they need operating system configuration.
+randomx_flags GetConfiguredRandomXFlags()
+{
+    uint32_t flags = g_randomx_flags.load(std::memory_order_relaxed);
+    if (flags == RANDOMX_FLAGS_AUTO) {
+        flags = static_cast<uint32_t>(randomx_get_flags());
+        g_randomx_flags.store(flags, std::memory_order_relaxed);
+        LogPrintf("RandomX: Autodetected flags 0x%x\n", flags);
+    }
+    return static_cast<randomx_flags>(flags);
+}
+
+//! Maximum number of initialized key states kept alive. Two states cover the
+//! current and previous epoch, so reorgs and out-of-order header arrival
+//! across an epoch boundary do not thrash full cache/dataset rebuilds.
+constexpr size_t MAX_RANDOMX_STATES{2};
+
+//! Directory for persisted dataset files; empty when persistence is disabled.
+Mutex g_randomx_dataset_dir_mutex;
+fs::path g_randomx_dataset_dir GUARDED_BY(g_randomx_dataset_dir_mutex);
+
+fs::path GetRandomXDatasetPath(const uint256& key)
+{
+    LOCK(g_randomx_dataset_dir_mutex);
+    if (g_randomx_dataset_dir.empty()) return {};
+    return g_randomx_dataset_dir / fs::u8path(strprintf("dataset-%s.dat", key.ToString()));
+}
+
+//! Try to fill the dataset memory from a previously persisted file. Returns
+//! false (without touching the dataset) on any mismatch so the caller falls
+//! back to recomputing from the cache.
+bool LoadDatasetFromDisk(randomx_dataset* dataset, const fs::path& path, size_t dataset_size)
+{
+    if (path.empty() || !fs::exists(path)) return false;
+    if (fs::file_size(path) != dataset_size) {
+        LogPrintf("RandomX: Ignoring dataset file %s with unexpected size\n", fs::PathToString(path));
+        return false;
+    }
+    FILE* file = fsbridge::fopen(path, "rb");
+    if (!file) return false;
+    const size_t read = fread(randomx_get_dataset_memory(dataset), 1, dataset_size, file);
+    fclose(file);
+    if (read != dataset_size) {
+        LogPrintf("RandomX: Short read from dataset file %s\n", fs::PathToString(path));
+        return false;
+    }
+    LogPrintf("RandomX: Loaded dataset from %s\n", fs::PathToString(path));
+    return true;
+}
+
+//! Persist an initialized dataset so the next restart skips recomputation.
+//! Older dataset files beyond the states we keep in memory are pruned.
+void StoreDatasetToDisk(randomx_dataset* dataset, const fs::path& path, size_t dataset_size, size_t keep_files)
+{
+    if (path.empty()) return;
     try {
-        // Clean up existing instances
-        if (rx_vm) {
-            randomx_destroy_vm(rx_vm);
-            rx_vm = nullptr;
+        fs::create_directories(path.parent_path());
+        // Write to a temporary name first so a crash mid-write never leaves a
+        // plausible-looking but truncated dataset behind.
+        const fs::path tmp_path{path + ".tmp"};
+        FILE* file = fsbridge::fopen(tmp_path, "wb");
+        if (!file) return;
+        const size_t written = fwrite(randomx_get_dataset_memory(dataset), 1, dataset_size, file);
+        fclose(file);
+        if (written != dataset_size) {
+            fs::remove(tmp_path);
+            return;
         }
-        if (rx_dataset) {
-            randomx_release_dataset(rx_dataset);
-            rx_dataset = nullptr;
+        fs::rename(tmp_path, path);
+        LogPrintf("RandomX: Persisted dataset to %s\n", fs::PathToString(path));
+
+        // Prune stale epoch files, oldest first.
+        std::vector<std::pair<fs::file_time_type, fs::path>> files;
+        for (const auto& entry : fs::directory_iterator(path.parent_path())) {
+            if (entry.is_regular_file() && entry.path().extension() == ".dat") {
+                files.emplace_back(fs::last_write_time(entry.path()), entry.path());
+            }
         }
-        if (rx_cache) {
-            randomx_release_cache(rx_cache);
-            rx_cache = nullptr;
+        std::sort(files.begin(), files.end());
+        while (files.size() > keep_files) {
+            fs::remove(files.front().second);
+            files.erase(files.begin());
         }
+    } catch (const fs::filesystem_error& e) {
+        LogPrintf("RandomX: Failed to persist dataset: %s\n", e.what());
+    }
+}
+
+//! Initialize the 2 GiB dataset, partitioning the item range across worker
+//! threads the same way RandomX miners do. Single-threaded initialization
+//! takes tens of seconds and stalls validation at every key epoch.
+void InitDatasetThreaded(randomx_dataset* dataset, randomx_cache* cache)
+{
+    const unsigned long item_count = randomx_dataset_item_count();
+    int threads = g_randomx_init_threads.load(std::memory_order_relaxed);
+    if (threads <= 0) threads = GetNumCores();
+    threads = std::clamp<int>(threads, 1, 64);
+
+    if (threads == 1) {
+        randomx_init_dataset(dataset, cache, 0, item_count);
+        return;
+    }
 
-        // Create new cache with the key
-        rx_cache = randomx_alloc_cache(RANDOMX_FLAG_DEFAULT);
-        if (!rx_cache) {
+    std::vector<std::thread> workers;
+    workers.reserve(threads);
+    const unsigned long items_per_thread = item_count / threads;
+    const bool pin = g_randomx_numa_interleave.load(std::memory_order_relaxed);
+    // Stride the pinned CPUs over the whole core range so workers (and hence
+    // first-touched dataset pages) cover every socket even when fewer init
+    // threads than cores are configured.
+    const int cpu_stride = std::max(1, GetNumCores() / threads);
+    for (int i = 0; i < threads; ++i) {
+        const unsigned long start = i * items_per_thread;
+        // The last worker picks up the remainder of the division.
+        const unsigned long count = (i == threads - 1) ? item_count - start : items_per_thread;
+        workers.emplace_back([dataset, cache, start, count, pin, i, cpu_stride] {
+            if (pin) PinThreadToCpu(i * cpu_stride);
+            randomx_init_dataset(dataset, cache, start, count);
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+//! A VM checked out of a state's pool, tagged with whether it was created
+//! against the full dataset or in light (cache-only) mode.
+struct PooledVM {
+    randomx_vm* vm{nullptr};
+    bool full_mem{false};
+};
+
+/**
+ * An initialized RandomX cache/dataset for a single key, together with a pool
+ * of VMs bound to it. VMs are handed out one per concurrent caller (the pool
+ * grows to the peak number of concurrent verifiers and no further), so header
+ * validation from the message handler and RPC threads can proceed in parallel
+ * against the same shared dataset.
+ *
+ * Construction only initializes the 256 MiB light cache, so validation can
+ * start immediately after a key switch; the 2 GiB dataset is built on a
+ * background thread and VMs are promoted to full-mem once it is ready.
+ *
+ * Instances are reference counted via shared_ptr: a key change swaps in a new
+ * state while in-flight hash computations keep the old cache/dataset alive
+ * until the last borrowed VM is returned.
+ */
+class RandomXState
+{
+public:
+    explicit RandomXState(const uint256& key) : m_key(key), m_flags(GetConfiguredRandomXFlags())
+    {
+        m_cache = randomx_alloc_cache(m_flags);
+        if (!m_cache && (m_flags & RANDOMX_FLAG_LARGE_PAGES)) {
+            // Graceful fallback when no huge pages are reserved.
+            LogPrintf("RandomX: Large-page cache allocation failed, retrying without\n");
+            m_flags = static_cast<randomx_flags>(m_flags & ~RANDOMX_FLAG_LARGE_PAGES);
+            m_cache = randomx_alloc_cache(m_flags);
+        }
+        if (!m_cache) {
             LogPrintf("RandomX: Failed to allocate cache\n");
-            return false;
+            return;
         }
+        randomx_init_cache(m_cache, key.begin(), 32);
 
-        randomx_init_cache(rx_cache, key.begin(), 32);
+        // Validation proceeds in light mode against the cache while the
+        // dataset initializes in the background.
+        m_init_thread = std::thread(&RandomXState::InitDatasetBackground, this);
+    }
 
-        // Create dataset (for better performance)
-        rx_dataset = randomx_alloc_dataset(RANDOMX_FLAG_FULL_MEM);
-        if (rx_dataset) {
-            randomx_init_dataset(rx_dataset, rx_cache, 0, randomx_dataset_item_count());
+    ~RandomXState()
+    {
+        if (m_init_thread.joinable()) m_init_thread.join();
+        for (const PooledVM& pooled : m_vm_pool) {
+            randomx_destroy_vm(pooled.vm);
+        }
+        if (m_dataset) randomx_release_dataset(m_dataset);
+        if (m_cache) randomx_release_cache(m_cache);
+    }
 
-            // Create VM with dataset
-            rx_vm = randomx_create_vm(RANDOMX_FLAG_FULL_MEM, rx_cache, rx_dataset);
-        } else {
+    RandomXState(const RandomXState&) = delete;
+    RandomXState& operator=(const RandomXState&) = delete;
+
+    bool IsValid() const { return m_cache != nullptr; }
+    const uint256& GetKey() const { return m_key; }
+
+    //! Take an idle VM from the pool, or create a new one if all are in use.
+    PooledVM AcquireVM()
+    {
+        bool full_mem;
+        {
+            LOCK(m_pool_mutex);
+            if (!m_vm_pool.empty()) {
+                PooledVM pooled = m_vm_pool.back();
+                m_vm_pool.pop_back();
+                return pooled;
+            }
+            // Reading under the pool lock orders this against promotion, so
+            // m_dataset is safe to use below whenever full_mem is true.
+            full_mem = m_dataset_ready;
+        }
+        const randomx_flags vm_flags = full_mem ? static_cast<randomx_flags>(m_flags | RANDOMX_FLAG_FULL_MEM) : m_flags;
+        randomx_vm* vm = randomx_create_vm(vm_flags, m_cache, full_mem ? m_dataset : nullptr);
+        if (!vm && (vm_flags & RANDOMX_FLAG_LARGE_PAGES)) {
+            vm = randomx_create_vm(static_cast<randomx_flags>(vm_flags & ~RANDOMX_FLAG_LARGE_PAGES), m_cache, full_mem ? m_dataset : nullptr);
+        }
+        return {vm, full_mem};
+    }
+
+    //! Return a VM borrowed with AcquireVM() to the pool. Light-mode VMs
+    //! returned after promotion are retired instead of pooled.
+    void ReleaseVM(const PooledVM& pooled)
+    {
+        LOCK(m_pool_mutex);
+        if (pooled.full_mem != m_dataset_ready) {
+            randomx_destroy_vm(pooled.vm);
+            return;
+        }
+        m_vm_pool.push_back(pooled);
+    }
+
+private:
+    //! Build (or load) the dataset off the validation path, then atomically
+    //! promote: pooled light VMs are retired so subsequent acquires run
+    //! against the full dataset.
+    void InitDatasetBackground()
+    {
+        randomx_dataset* dataset = randomx_alloc_dataset(m_flags);
+        if (!dataset && (m_flags & RANDOMX_FLAG_LARGE_PAGES)) {
+            dataset = randomx_alloc_dataset(static_cast<randomx_flags>(m_flags & ~RANDOMX_FLAG_LARGE_PAGES));
+        }
+        if (!dataset) {
             // Fallback to light mode if not enough memory
             LogPrintf("RandomX: Using light mode (dataset allocation failed)\n");
-            rx_vm = randomx_create_vm(RANDOMX_FLAG_DEFAULT, rx_cache, nullptr);
+            return;
+        }
+        const size_t dataset_size{randomx_dataset_item_count() * RANDOMX_DATASET_ITEM_SIZE};
+        const fs::path dataset_path = GetRandomXDatasetPath(m_key);
+        if (!LoadDatasetFromDisk(dataset, dataset_path, dataset_size)) {
+            InitDatasetThreaded(dataset, m_cache);
+            StoreDatasetToDisk(dataset, dataset_path, dataset_size, MAX_RANDOMX_STATES);
         }
 
-        if (!rx_vm) {
-            LogPrintf("RandomX: Failed to create VM\n");
-            return false;
+        LOCK(m_pool_mutex);
+        m_dataset = dataset;
+        for (const PooledVM& pooled : m_vm_pool) {
+            randomx_destroy_vm(pooled.vm);
         }
+        m_vm_pool.clear();
+        m_dataset_ready = true;
+        LogPrintf("RandomX: Promoted key %s to full-mem dataset\n", m_key.ToString());
+    }
 
-        rx_key_hash = key;
-        rx_initialized = true;
-        LogPrintf("RandomX: Initialized with key %s\n", key.ToString());
-        return true;
+    const uint256 m_key;
+    randomx_flags m_flags;
+    randomx_cache* m_cache{nullptr};
+    randomx_dataset* m_dataset{nullptr};
+    std::thread m_init_thread;
+    Mutex m_pool_mutex;
+    bool m_dataset_ready GUARDED_BY(m_pool_mutex){false};
+    std::vector<PooledVM> m_vm_pool GUARDED_BY(m_pool_mutex);
+};
+
+//! RAII handle that returns a borrowed VM to its owning state's pool. Keeps a
+//! reference on the state so the cache/dataset outlive the hash computation.
+class RandomXVMHandle
+{
+public:
+    RandomXVMHandle(std::shared_ptr<RandomXState> state, PooledVM vm)
+        : m_state(std::move(state)), m_vm(vm) {}
 
-    } catch (const std::exception& e) {
-        LogPrintf("RandomX: Exception during initialization: %s\n", e.what());
-        return false;
+    ~RandomXVMHandle()
+    {
+        if (m_vm.vm) m_state->ReleaseVM(m_vm);
     }
+
+    RandomXVMHandle(const RandomXVMHandle&) = delete;
+    RandomXVMHandle& operator=(const RandomXVMHandle&) = delete;
+
+    randomx_vm* Get() const { return m_vm.vm; }
+
+private:
+    std::shared_ptr<RandomXState> m_state;
+    PooledVM m_vm;
+};
+
+//! Upper bound on remembered header hash -> RandomX hash entries. Headers are
+//! hashed in CheckBlockHeader, AcceptBlockHeader and ConnectBlock; at 80 bytes
+//! of key plus 32 bytes of value per entry this caps the cache below 1 MiB
+//! while comfortably covering headers in flight during sync and reorgs.
+constexpr size_t MAX_RANDOMX_HASH_CACHE{8192};
+
+Mutex g_randomx_hash_cache_mutex;
+//! Map from (SHA256d) header hash to its computed RandomX hash, with FIFO
+//! eviction tracked by insertion order.
+std::unordered_map<uint256, uint256, BlockHasher> g_randomx_hash_cache GUARDED_BY(g_randomx_hash_cache_mutex);
+std::deque<uint256> g_randomx_hash_cache_order GUARDED_BY(g_randomx_hash_cache_mutex);
+
+Mutex g_randomx_mutex;
+//! Most-recently-used first list of initialized states.
+std::vector<std::shared_ptr<RandomXState>> g_randomx_states GUARDED_BY(g_randomx_mutex);
+
+//! Get the shared state for the given key, initializing it on first use and
+//! evicting the least recently used state beyond MAX_RANDOMX_STATES.
+std::shared_ptr<RandomXState> GetRandomXState(const uint256& key, bool* key_switched = nullptr)
+{
+    if (key_switched) *key_switched = false;
+    LOCK(g_randomx_mutex);
+    for (auto it = g_randomx_states.begin(); it != g_randomx_states.end(); ++it) {
+        if ((*it)->GetKey() == key) {
+            std::shared_ptr<RandomXState> state = *it;
+            // Move to front so the eviction order stays least-recently-used.
+            g_randomx_states.erase(it);
+            g_randomx_states.insert(g_randomx_states.begin(), state);
+            return state;
+        }
+    }
+    if (key_switched) *key_switched = true;
+    auto state = std::make_shared<RandomXState>(key);
+    if (!state->IsValid()) {
+        return nullptr;
+    }
+    g_randomx_states.insert(g_randomx_states.begin(), state);
+    if (g_randomx_states.size() > MAX_RANDOMX_STATES) {
+        // Evicted states are freed once the last in-flight hash computation
+        // drops its reference.
+        g_randomx_states.pop_back();
+    }
+    LogPrintf("RandomX: Initialized with key %s\n", state->GetKey().ToString());
+    return state;
 }
 
-// Compute RandomX hash for a block header
-uint256 GetRandomXHash(const CBlockHeader& block) {
+} // namespace
+
+// Initialize RandomX for the given key
+bool InitializeRandomX(const uint256& key) {
+    return GetRandomXState(key) != nullptr;
+}
+
+void SetRandomXInitThreads(int threads) {
+    g_randomx_init_threads.store(threads, std::memory_order_relaxed);
+}
+
+void SetRandomXNumaInterleave(bool interleave) {
+    g_randomx_numa_interleave.store(interleave, std::memory_order_relaxed);
+}
+
+void SetRandomXPrefetch(bool enable) {
+    g_randomx_prefetch.store(enable, std::memory_order_relaxed);
+}
+
+void PrefetchRandomXState(const uint256& next_key) {
+    if (!g_randomx_prefetch.load(std::memory_order_relaxed)) return;
+    {
+        LOCK(g_randomx_mutex);
+        for (const auto& state : g_randomx_states) {
+            if (state->GetKey() == next_key) return; // Already warm
+        }
+    }
+    if (g_randomx_prefetch_busy.exchange(true)) return;
+    LOCK(g_randomx_prefetch_mutex);
+    if (g_randomx_prefetch_thread.joinable()) g_randomx_prefetch_thread.join();
+    g_randomx_prefetch_thread = std::thread([next_key] {
+        LogPrintf("RandomX: Warming state for upcoming key %s\n", next_key.ToString());
+        GetRandomXState(next_key);
+        g_randomx_prefetch_busy.store(false, std::memory_order_release);
+    });
+}
+
+void SetRandomXDatasetDir(const fs::path& dir) {
+    LOCK(g_randomx_dataset_dir_mutex);
+    g_randomx_dataset_dir = dir;
+}
+
+bool SetRandomXFlags(const std::string& config) {
+    if (config == "auto") {
+        g_randomx_flags.store(RANDOMX_FLAGS_AUTO, std::memory_order_relaxed);
+        return true;
+    }
+    uint32_t flags{RANDOMX_FLAG_DEFAULT};
+    for (const std::string& token : SplitString(config, ',')) {
+        if (token == "default" || token.empty()) {
+            // no-op: interpreted VM, software AES
+        } else if (token == "jit") {
+            flags |= RANDOMX_FLAG_JIT;
+        } else if (token == "hardaes") {
+            flags |= RANDOMX_FLAG_HARD_AES;
+        } else if (token == "largepages") {
+            flags |= RANDOMX_FLAG_LARGE_PAGES;
+        } else if (token == "secure") {
+            flags |= RANDOMX_FLAG_SECURE;
+        } else {
+            return false;
+        }
+    }
+    g_randomx_flags.store(flags, std::memory_order_relaxed);
+    return true;
+}
+
+// Compute RandomX hash for a block header without touching the hash cache
+uint256 GetRandomXHashUncached(const CBlockHeader& block, RandomXSource source) {
+    // Account this hash against the verification slot cap (a no-op on batch
+    // workers, whose slots were reserved up front). Lower admission classes
+    // wait here while chain verification has the cores busy.
+    VerifySlotGrant slot{source, 1};
+
     // Get the key for this block (previous block hash)
     uint256 key = GetRandomXKey(block.hashPrevBlock);
+    TRACE1(randomx, hash_start, key.data());
 
-    // Initialize RandomX if needed or key changed
-    if (!rx_initialized || rx_key_hash != key) {
-        if (!InitializeRandomX(key)) {
-            LogPrintf("RandomX: Failed to initialize, falling back to SHA256\n");
-            return block.GetHash(); // Fallback to SHA256
-        }
+    bool key_switched{false};
+    std::shared_ptr<RandomXState> state = GetRandomXState(key, &key_switched);
+    if (!state) {
+        LogPrintf("RandomX: Failed to initialize, falling back to SHA256\n");
+        return block.GetHash(); // Fallback to SHA256
     }
 
     try {
+        RandomXVMHandle vm_handle(state, state->AcquireVM());
+        if (!vm_handle.Get()) {
+            LogPrintf("RandomX: Failed to create VM\n");
+            return block.GetHash(); // Fallback to SHA256
+        }
+
         // Serialize block header for hashing
         CDataStream ss(SER_NETWORK, INIT_PROTO_VERSION);
         ss << block;
 
         // Calculate RandomX hash
         char hash[RANDOMX_HASH_SIZE];
-        randomx_calculate_hash(rx_vm, ss.data(), ss.size(), hash);
+        const int64_t hash_start_us{GetTimeMicros()};
+        randomx_calculate_hash(vm_handle.Get(), ss.data(), ss.size(), hash);
+        perf::Bump(perf::GetCounters().randomx_hashes);
+        perf::Bump(perf::GetCounters().randomx_hash_time_us, GetTimeMicros() - hash_start_us);
 
         // Convert to uint256
         uint256 result;
         memcpy(result.begin(), hash, 32);
-
+        TRACE3(randomx, hash_end,
+               key.data(),
+               (bool)key_switched,
+               result.data());
         return result;
 
     } catch (const std::exception& e) {
@@ -263,6 +797,45 @@ uint256 GetRandomXHash(const CBlockHeader& block) {
     }
 }
 
+// Compute RandomX hash for a block header
+uint256 GetRandomXHash(const CBlockHeader& block) {
+    // Each header pays the RandomX cost exactly once: later checks of the
+    // same header are served from the bounded hash cache.
+    const uint256 header_hash = block.GetHash();
+    {
+        LOCK(g_randomx_hash_cache_mutex);
+        const auto it = g_randomx_hash_cache.find(header_hash);
+        if (it != g_randomx_hash_cache.end()) {
+            return it->second;
+        }
+    }
+
+    const uint256 result = GetRandomXHashUncached(block);
+
+    LOCK(g_randomx_hash_cache_mutex);
+    if (g_randomx_hash_cache.emplace(header_hash, result).second) {
+        g_randomx_hash_cache_order.push_back(header_hash);
+        if (g_randomx_hash_cache_order.size() > MAX_RANDOMX_HASH_CACHE) {
+            g_randomx_hash_cache.erase(g_randomx_hash_cache_order.front());
+            g_randomx_hash_cache_order.pop_front();
+        }
+    }
+
+    return result;
+}
+
+void CacheRandomXHash(const CBlockHeader& block, const uint256& rx_hash) {
+    const uint256 header_hash = block.GetHash();
+    LOCK(g_randomx_hash_cache_mutex);
+    if (g_randomx_hash_cache.emplace(header_hash, rx_hash).second) {
+        g_randomx_hash_cache_order.push_back(header_hash);
+        if (g_randomx_hash_cache_order.size() > MAX_RANDOMX_HASH_CACHE) {
+            g_randomx_hash_cache.erase(g_randomx_hash_cache_order.front());
+            g_randomx_hash_cache_order.pop_front();
+        }
+    }
+}
+
 // Check RandomX proof of work
 bool CheckRandomXProofOfWork(const CBlockHeader& block, unsigned int nBits, const Consensus::Params& params) {
     // Genesis block uses SHA256d (hashPrevBlock is null)
@@ -274,34 +847,174 @@ bool CheckRandomXProofOfWork(const CBlockHeader& block, unsigned int nBits, cons
         return result;
     }
 
-    // DEV MODE: Only use SHA256d for now to allow fast mining with generatetoaddress
-    // This makes the built-in RPC miner work efficiently
-    // TODO: For production, implement proper RandomX mining with separate miner
+    // Accept headers whose SHA256d hash meets the target. This keeps blocks
+    // mined via the legacy dev-mode path valid, and is what generatetoaddress
+    // grinds against so regtest block generation stays instant. It is checked
+    // first because it is orders of magnitude cheaper than a RandomX hash.
     if (CheckProofOfWork(block.GetHash(), nBits, params)) {
-        LogPrintf("Block %s accepted via SHA256d PoW (height=%d)\n", block.GetHash().ToString(), 0);
         return true;
     }
 
-    // Don't try RandomX during mining - it's too slow for nonce iteration
-    // RandomX will be used by dedicated external miners
-    return false;
+    // Full RandomX proof of work, as produced by the internal miner and by
+    // external RandomX miners.
+    return CheckProofOfWork(GetRandomXHash(block), nBits, params);
 }
 
-// Cleanup RandomX resources
-void ShutdownRandomX() {
-    if (rx_vm) {
-        randomx_destroy_vm(rx_vm);
-        rx_vm = nullptr;
+//! Verify a run of headers sharing one RandomX key with the pipelined
+//! hashing API: randomx_calculate_hash_next() overlaps the previous hash's
+//! finalization with the next input's scratchpad initialization on the same
+//! VM, roughly doubling sequential throughput over one-shot calls. Only
+//! valid for same-key runs, since a VM is bound to one key's cache/dataset.
+static bool CheckRandomXHeaderRunPipelined(const std::vector<CBlockHeader>& headers, size_t begin, size_t end, const Consensus::Params& params)
+{
+    // Headers whose SHA256d hash already meets the target (legacy dev-mode
+    // and regtest generation) and headers with a cached RandomX hash do not
+    // need to enter the pipeline.
+    std::vector<size_t> pending;
+    pending.reserve(end - begin);
+    for (size_t i = begin; i < end; ++i) {
+        const CBlockHeader& header = headers[i];
+        if (CheckProofOfWork(header.GetHash(), header.nBits, params)) continue;
+        {
+            LOCK(g_randomx_hash_cache_mutex);
+            const auto it = g_randomx_hash_cache.find(header.GetHash());
+            if (it != g_randomx_hash_cache.end()) {
+                if (!CheckProofOfWork(it->second, header.nBits, params)) return false;
+                continue;
+            }
+        }
+        pending.push_back(i);
+    }
+    if (pending.empty()) return true;
+
+    const uint256 key = GetRandomXKey(headers[pending.front()].hashPrevBlock);
+    std::shared_ptr<RandomXState> state = GetRandomXState(key);
+    PooledVM vm{};
+    if (state) vm = state->AcquireVM();
+    if (!state || !vm.vm) {
+        // Fall back to the one-shot path, which handles initialization
+        // failures with its own SHA256d fallback.
+        for (const size_t i : pending) {
+            if (!CheckRandomXProofOfWork(headers[i], headers[i].nBits, params)) return false;
+        }
+        return true;
+    }
+    RandomXVMHandle vm_handle(state, vm);
+
+    // Serialize all pending headers up front; the pipeline needs the next
+    // input alive while the previous hash finalizes.
+    std::vector<CDataStream> blobs;
+    blobs.reserve(pending.size());
+    for (const size_t i : pending) {
+        CDataStream ss(SER_NETWORK, INIT_PROTO_VERSION);
+        ss << headers[i];
+        blobs.push_back(std::move(ss));
+    }
+
+    std::vector<uint256> hashes(pending.size());
+    const int64_t hash_start_us{GetTimeMicros()};
+    randomx_calculate_hash_first(vm_handle.Get(), blobs.front().data(), blobs.front().size());
+    for (size_t n = 1; n < blobs.size(); ++n) {
+        randomx_calculate_hash_next(vm_handle.Get(), blobs[n].data(), blobs[n].size(), hashes[n - 1].begin());
     }
-    if (rx_dataset) {
-        randomx_release_dataset(rx_dataset);
-        rx_dataset = nullptr;
+    randomx_calculate_hash_last(vm_handle.Get(), hashes.back().begin());
+    perf::Bump(perf::GetCounters().randomx_hashes, pending.size());
+    perf::Bump(perf::GetCounters().randomx_hash_time_us, GetTimeMicros() - hash_start_us);
+
+    // Cache every computed hash even when one of them fails the target, so a
+    // retry of the surviving headers is served from the cache.
+    bool all_valid{true};
+    for (size_t n = 0; n < pending.size(); ++n) {
+        const CBlockHeader& header = headers[pending[n]];
+        CacheRandomXHash(header, hashes[n]);
+        if (!CheckProofOfWork(hashes[n], header.nBits, params)) all_valid = false;
     }
-    if (rx_cache) {
-        randomx_release_cache(rx_cache);
-        rx_cache = nullptr;
+    return all_valid;
+}
+
+//! Verify a contiguous slice of a header batch, feeding maximal same-key
+//! runs through the pipelined path and everything else through the one-shot
+//! path. The RandomX key is the previous block hash, so headers forming a
+//! chain get runs of one; runs longer than one arise from sibling headers
+//! competing for the same parent.
+static bool CheckRandomXHeaderRange(const std::vector<CBlockHeader>& headers, size_t begin, size_t end, const Consensus::Params& params, const std::atomic<bool>* keep_going)
+{
+    size_t run_start = begin;
+    while (run_start < end) {
+        if (keep_going && !keep_going->load(std::memory_order_relaxed)) return false;
+        size_t run_end = run_start + 1;
+        while (run_end < end && !headers[run_start].hashPrevBlock.IsNull() &&
+               headers[run_end].hashPrevBlock == headers[run_start].hashPrevBlock) {
+            ++run_end;
+        }
+        if (run_end - run_start > 1) {
+            if (!CheckRandomXHeaderRunPipelined(headers, run_start, run_end, params)) return false;
+        } else if (!CheckRandomXProofOfWork(headers[run_start], headers[run_start].nBits, params)) {
+            return false;
+        }
+        run_start = run_end;
+    }
+    return true;
+}
+
+// Check RandomX proof of work for a batch of headers
+bool CheckRandomXProofOfWorkBatch(const std::vector<CBlockHeader>& headers, const Consensus::Params& params, RandomXSource source) {
+    // Below this the thread fan-out costs more than it saves.
+    constexpr size_t MIN_HEADERS_PER_THREAD{64};
+
+    const size_t num_headers = headers.size();
+    size_t threads = std::min<size_t>(GetNumCores(), num_headers / MIN_HEADERS_PER_THREAD);
+
+    // Reserve the fan-out width up front. Concurrent batches split the
+    // capacity between them instead of each spawning a pool per caller, and
+    // lower admission classes wait inside the acquisition while chain work
+    // has the cores busy. Workers are marked as covered by this reservation
+    // so the per-hash admission does not count them a second time.
+    VerifySlotGrant slots{source, static_cast<int>(std::max<size_t>(threads, 1))};
+    threads = std::max<size_t>(std::min<size_t>(threads, slots.Granted()), 1);
+
+    if (threads <= 1) {
+        const MarkVerifySlotHeld held;
+        return CheckRandomXHeaderRange(headers, 0, num_headers, params, nullptr);
+    }
+
+    // Workers take contiguous slices, so consecutive headers — which share
+    // key epochs — stay on the same thread and its borrowed VM stays hot.
+    // A single failure makes the remaining workers bail out early.
+    std::atomic<bool> all_valid{true};
+    const size_t headers_per_thread = num_headers / threads;
+    std::vector<std::thread> workers;
+    workers.reserve(threads);
+    for (size_t i = 0; i < threads; ++i) {
+        const size_t start = i * headers_per_thread;
+        const size_t end = (i == threads - 1) ? num_headers : start + headers_per_thread;
+        workers.emplace_back([&, start, end] {
+            t_verify_slot_held = true;
+            if (!CheckRandomXHeaderRange(headers, start, end, params, &all_valid)) {
+                all_valid.store(false, std::memory_order_relaxed);
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    return all_valid.load(std::memory_order_relaxed);
+}
+
+bool RandomXVerificationSaturated() {
+    LOCK(g_verify_slots_mutex);
+    return g_verify_slots_used >= VerifySlotCapacity();
+}
+
+// Cleanup RandomX resources
+void ShutdownRandomX() {
+    {
+        // Let an in-flight warm-up finish before tearing the states down.
+        LOCK(g_randomx_prefetch_mutex);
+        if (g_randomx_prefetch_thread.joinable()) g_randomx_prefetch_thread.join();
     }
-    rx_initialized = false;
+    LOCK(g_randomx_mutex);
+    g_randomx_states.clear();
     LogPrintf("RandomX: Shutdown complete\n");
 }
 
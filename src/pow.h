@@ -7,9 +7,13 @@
 #define CORAL_POW_H
 
 #include <consensus/params.h>
+#include <fs.h>
 
 #include <stdint.h>
 
+#include <string>
+#include <vector>
+
 class CBlockHeader;
 class CBlockIndex;
 class uint256;
@@ -34,11 +38,91 @@ bool CheckProofOfWork(uint256 hash, unsigned int nBits, const Consensus::Params&
  */
 bool PermittedDifficultyTransition(const Consensus::Params& params, int64_t height, uint32_t old_nbits, uint32_t new_nbits);
 
+/** Default number of RandomX dataset initialization threads (0 = one per core) */
+static const int DEFAULT_RANDOMX_INIT_THREADS{0};
+/** Default for persisting initialized RandomX datasets to disk */
+static const bool DEFAULT_RANDOMX_DATASET_CACHE{false};
+/** Default RandomX flag selection (probe CPU capabilities at first use) */
+static const std::string DEFAULT_RANDOMX_FLAGS{"auto"};
+/** Default for interleaving dataset pages across NUMA nodes via pinned init workers */
+static const bool DEFAULT_RANDOMX_NUMA_INTERLEAVE{true};
+/** Default for warming the next block's RandomX key in the background at tip changes */
+static const bool DEFAULT_RANDOMX_PREFETCH{true};
+
+/**
+ * Admission classes for RandomX hashing, from highest to lowest priority.
+ * The total number of concurrently hashing threads is capped at the core
+ * count; CHAIN work is admitted immediately, while lower classes wait
+ * (bounded) for free capacity. Verification is never refused for scheduling
+ * reasons — a timed-out waiter proceeds on a single thread.
+ */
+enum class RandomXSource {
+    CHAIN, //!< Headers/blocks extending the best known chain
+    FORK,  //!< Headers on speculative forks or with unknown parents
+    RPC,   //!< RPC-driven hashing, e.g. generate* mining loops
+};
+
+/**
+ * Whether RandomX hashing currently occupies all verification slots. Used by
+ * net_processing as a backpressure signal to avoid fanning header sync out to
+ * additional peers while the verifier is saturated.
+ */
+bool RandomXVerificationSaturated();
+
 /** RandomX proof-of-work functions for Coral */
 uint256 GetRandomXKey(const uint256& prevBlockHash);
 bool InitializeRandomX(const uint256& key);
+/** Set the number of worker threads used for dataset initialization (0 = auto). */
+void SetRandomXInitThreads(int threads);
+/** Set the directory used to persist initialized datasets (empty = disabled). */
+void SetRandomXDatasetDir(const fs::path& dir);
+/** Enable/disable NUMA interleaving of dataset pages via pinned init workers. */
+void SetRandomXNumaInterleave(bool interleave);
+/** Enable/disable background warm-up of upcoming keys (see PrefetchRandomXState). */
+void SetRandomXPrefetch(bool enable);
+/**
+ * Start a background warm-up of the state for an upcoming key unless it is
+ * already initialized. Every block's key is its parent's hash, so the state
+ * the next block (and the miner working on top of the tip) will need is known
+ * the moment a tip connects; building it off the validation path turns the
+ * per-block key switch from an inline cache initialization into a lookup.
+ * At most one warm-up runs at a time and further requests while one is in
+ * flight are dropped. No-op when disabled via -randomxprefetch=0.
+ */
+void PrefetchRandomXState(const uint256& next_key);
+/**
+ * Configure RandomX VM construction flags. Accepts "auto" (probe the CPU for
+ * JIT and hardware AES support) or a comma-separated list of "default",
+ * "jit", "hardaes", "largepages" and "secure". Returns false on an unknown
+ * token. Flags that turn out to be unusable at allocation time (e.g. no huge
+ * pages reserved) are dropped with a log message rather than failing.
+ */
+bool SetRandomXFlags(const std::string& config);
 uint256 GetRandomXHash(const CBlockHeader& block);
+/**
+ * Record an externally computed RandomX hash for a header in the hash cache,
+ * so the validation pipeline's proof-of-work checks become lookups. Used by
+ * the internal miner for a winning header: the grinding loop has already paid
+ * for the hash, and recomputing it at submission would double the
+ * submit-to-broadcast latency of exactly the block where it matters.
+ */
+void CacheRandomXHash(const CBlockHeader& block, const uint256& rx_hash);
+/**
+ * Compute the RandomX hash of a header without consulting or populating the
+ * header hash cache. Used by the internal miner, where every attempt is a
+ * fresh header and caching would only evict entries validation needs. The
+ * source selects the admission class each hash is accounted under.
+ */
+uint256 GetRandomXHashUncached(const CBlockHeader& block, RandomXSource source = RandomXSource::CHAIN);
 bool CheckRandomXProofOfWork(const CBlockHeader& block, unsigned int nBits, const Consensus::Params&);
+/**
+ * Check proof of work for a batch of headers (e.g. a 2000-header headers
+ * message during initial sync), fanning contiguous slices out to a worker
+ * pool so each thread keeps reusing its own VM. Returns true iff every
+ * header passes. The fan-out width is limited to the free verification
+ * slots, so concurrent floods cannot multiply up to a pool per caller.
+ */
+bool CheckRandomXProofOfWorkBatch(const std::vector<CBlockHeader>& headers, const Consensus::Params&, RandomXSource source = RandomXSource::CHAIN);
 void ShutdownRandomX();
 
 #endif // CORAL_POW_H
@@ -8,9 +8,12 @@
 
 #include <primitives/transaction.h>
 #include <serialize.h>
+#include <support/allocators/bump_arena.h>
 #include <uint256.h>
 #include <util/time.h>
 
+#include <memory>
+
 /** Nodes collect new transactions into a block, hash them into a hash tree,
  * and scan through nonce values to make the block's hash satisfy proof-of-work
  * requirements.  When they solve the proof-of-work, they broadcast the block
@@ -85,10 +88,37 @@ public:
         *(static_cast<CBlockHeader*>(this)) = header;
     }
 
-    SERIALIZE_METHODS(CBlock, obj)
+    template <typename Stream>
+    void Serialize(Stream& s) const
+    {
+        CBlockHeader::Serialize(s);
+        s << vtx;
+    }
+
+    template <typename Stream>
+    void Unserialize(Stream& s)
     {
-        READWRITEAS(CBlockHeader, obj);
-        READWRITE(obj.vtx);
+        CBlockHeader::Unserialize(s);
+        fChecked = false;
+        // Bump-allocate each transaction (object and shared_ptr control
+        // block together, via allocate_shared) from one arena: a full block
+        // otherwise costs a malloc per transaction here and as many frees
+        // once the block leaves validation. The arena is freed wholesale
+        // when the last transaction reference is dropped.
+        const auto arena{std::make_shared<BumpArena>()};
+        vtx.clear();
+        const size_t size{ReadCompactSize(s)};
+        size_t allocated{0};
+        while (allocated < size) {
+            // For DoS prevention, do not blindly allocate as much as the
+            // stream claims to contain (see Unser in serialize.h).
+            allocated = std::min(size, allocated + MAX_VECTOR_ALLOCATE / sizeof(CTransactionRef));
+            vtx.reserve(allocated);
+            while (vtx.size() < allocated) {
+                vtx.push_back(std::allocate_shared<const CTransaction>(
+                    bump_arena_allocator<const CTransaction>{arena}, deserialize, s));
+            }
+        }
     }
 
     void SetNull()
@@ -85,6 +85,9 @@ uint256 CTransaction::ComputeWitnessHash() const
 
 CTransaction::CTransaction(const CMutableTransaction& tx) : vin(tx.vin), vout(tx.vout), nVersion(tx.nVersion), nLockTime(tx.nLockTime), hash{ComputeHash()}, m_witness_hash{ComputeWitnessHash()} {}
 CTransaction::CTransaction(CMutableTransaction&& tx) : vin(std::move(tx.vin)), vout(std::move(tx.vout)), nVersion(tx.nVersion), nLockTime(tx.nLockTime), hash{ComputeHash()}, m_witness_hash{ComputeWitnessHash()} {}
+// The stream hash covers exactly the bytes Serialize() would emit, so it is the
+// witness hash, and for transactions without witness data the txid as well.
+CTransaction::CTransaction(DeserializedTx data) : vin(std::move(data.tx.vin)), vout(std::move(data.tx.vout)), nVersion(data.tx.nVersion), nLockTime(data.tx.nLockTime), hash{HasWitness() ? ComputeHash() : data.serialized_hash}, m_witness_hash{data.serialized_hash} {}
 
 CAmount CTransaction::GetValueOut() const
 {
@@ -7,6 +7,7 @@
 #define CORAL_PRIMITIVES_TRANSACTION_H
 
 #include <consensus/amount.h>
+#include <hash.h>
 #include <prevector.h>
 #include <script/script.h>
 #include <serialize.h>
@@ -66,6 +67,11 @@ public:
     std::string ToString() const;
 };
 
+/* COutPoint serializes as 32 raw hash bytes followed by n as a little-endian
+ * uint32, which is exactly its memory layout on little-endian targets. */
+template<> struct TriviallySerializable<COutPoint> : std::true_type {};
+static_assert(std::has_unique_object_representations_v<COutPoint>);
+
 /** An input of a transaction.  It contains the location of the previous
  * transaction's output that it claims and a signature that matches the
  * output's public key.
@@ -308,6 +314,20 @@ private:
     uint256 ComputeHash() const;
     uint256 ComputeWitnessHash() const;
 
+    /** A deserialized transaction together with the hash of the bytes it was
+     *  read from, so the cached hash can be taken from the stream instead of
+     *  re-serializing. Produced by ReadTxAndHash() below. */
+    struct DeserializedTx;
+
+    /** Deserialize a CMutableTransaction while hashing the bytes read.
+     *  ReadCompactSize() rejects non-canonical encodings, so the bytes read
+     *  are identical to what Serialize() would produce and their hash equals
+     *  ComputeWitnessHash() (or ComputeHash() for the basic format). */
+    template <typename Stream>
+    static DeserializedTx ReadTxAndHash(Stream& s);
+
+    explicit CTransaction(DeserializedTx data);
+
 public:
     /** Convert a CMutableTransaction into a CTransaction. */
     explicit CTransaction(const CMutableTransaction& tx);
@@ -321,7 +341,7 @@ public:
     /** This deserializing constructor is provided instead of an Unserialize method.
      *  Unserialize is not possible, since it would require overwriting const fields. */
     template <typename Stream>
-    CTransaction(deserialize_type, Stream& s) : CTransaction(CMutableTransaction(deserialize, s)) {}
+    CTransaction(deserialize_type, Stream& s);
 
     bool IsNull() const {
         return vin.empty() && vout.empty();
@@ -411,6 +431,24 @@ struct CMutableTransaction
     }
 };
 
+struct CTransaction::DeserializedTx
+{
+    CMutableTransaction tx;
+    uint256 serialized_hash;
+};
+
+template <typename Stream>
+CTransaction::DeserializedTx CTransaction::ReadTxAndHash(Stream& s)
+{
+    CHashVerifier<Stream> hasher{&s};
+    DeserializedTx ret{CMutableTransaction{deserialize, hasher}, uint256{}};
+    ret.serialized_hash = hasher.GetHash();
+    return ret;
+}
+
+template <typename Stream>
+CTransaction::CTransaction(deserialize_type, Stream& s) : CTransaction{ReadTxAndHash(s)} {}
+
 typedef std::shared_ptr<const CTransaction> CTransactionRef;
 template <typename Tx> static inline CTransactionRef MakeTransactionRef(Tx&& txIn) { return std::make_shared<const CTransaction>(std::forward<Tx>(txIn)); }
 
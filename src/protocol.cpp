@@ -44,6 +44,9 @@ const char *CFHEADERS="cfheaders";
 const char *GETCFCHECKPT="getcfcheckpt";
 const char *CFCHECKPT="cfcheckpt";
 const char *WTXIDRELAY="wtxidrelay";
+const char *ZBLOCK="zblock";
+const char *ZTX="ztx";
+const char *ZHEADERS="zheaders";
 // Poker protocol messages
 const char *PKRANNOUNCE="pkrannounce";
 const char *PKRJOIN="pkrjoin";
@@ -97,6 +100,9 @@ const static std::string allNetMessageTypes[] = {
     NetMsgType::GETCFCHECKPT,
     NetMsgType::CFCHECKPT,
     NetMsgType::WTXIDRELAY,
+    NetMsgType::ZBLOCK,
+    NetMsgType::ZTX,
+    NetMsgType::ZHEADERS,
     // Poker protocol
     NetMsgType::PKRANNOUNCE,
     NetMsgType::PKRJOIN,
@@ -222,6 +228,7 @@ static std::string serviceFlagToStr(size_t bit)
     case NODE_WITNESS:         return "WITNESS";
     case NODE_COMPACT_FILTERS: return "COMPACT_FILTERS";
     case NODE_NETWORK_LIMITED: return "NETWORK_LIMITED";
+    case NODE_COMPRESSED_RELAY: return "COMPRESSED_RELAY";
     // Not using default, so we get warned when a case is missing
     }
 
@@ -258,6 +258,20 @@ extern const char* CFCHECKPT;
  * @since protocol version 70016 as described by BIP 339.
  */
 extern const char* WTXIDRELAY;
+/**
+ * The zblock message transmits a single serialized block, compressed with
+ * zlib and prefixed with the uncompressed payload size. Only sent when
+ * compressed relay was negotiated via NODE_COMPRESSED_RELAY.
+ */
+extern const char* ZBLOCK;
+/**
+ * The ztx message transmits a single compressed transaction (see zblock).
+ */
+extern const char* ZTX;
+/**
+ * The zheaders message transmits a compressed headers payload (see zblock).
+ */
+extern const char* ZHEADERS;
 
 // Poker game protocol messages
 /**
@@ -336,6 +350,15 @@ enum ServiceFlags : uint64_t {
     // See BIP159 for details on how this is implemented.
     NODE_NETWORK_LIMITED = (1 << 10),
 
+    // NODE_COMPRESSED_RELAY means the node accepts zlib-compressed block, tx
+    // and headers messages (zblock/ztx/zheaders) and will send them to peers
+    // that advertise this bit too. Opt-in via -compressedrelay; intended for
+    // operator-controlled links between own nodes. Taken from the experiment
+    // range below; like any service bit it is an unauthenticated
+    // advertisement, so compressed messages are only honored after both
+    // sides advertised the bit in their version handshake.
+    NODE_COMPRESSED_RELAY = (1 << 25),
+
     // Bits 24-31 are reserved for temporary experiments. Just pick a bit that
     // isn't getting used, or one not being used much, and notify the
     // coral-development mailing list. Remember that service bits are just
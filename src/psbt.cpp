@@ -4,9 +4,14 @@
 
 #include <psbt.h>
 
+#include <random.h>
+#include <sync.h>
 #include <util/check.h>
 #include <util/strencodings.h>
 
+#include <deque>
+#include <unordered_map>
+
 
 PartiallySignedTransaction::PartiallySignedTransaction(const CMutableTransaction& tx) : tx(tx)
 {
@@ -488,3 +493,67 @@ uint32_t PartiallySignedTransaction::GetVersion() const
     }
     return 0;
 }
+
+namespace {
+//! Open PSBT sessions (see psbt.h). Bounded so abandoned sessions cannot
+//! accumulate; the oldest session is dropped first once the cap is exceeded.
+constexpr size_t MAX_PSBT_SESSIONS{64};
+Mutex g_psbt_sessions_mutex;
+std::unordered_map<std::string, PartiallySignedTransaction> g_psbt_sessions GUARDED_BY(g_psbt_sessions_mutex);
+std::deque<std::string> g_psbt_session_order GUARDED_BY(g_psbt_sessions_mutex);
+} // namespace
+
+std::string OpenPSBTSession(PartiallySignedTransaction psbtx)
+{
+    std::string session_id{GetRandHash().GetHex()};
+    LOCK(g_psbt_sessions_mutex);
+    g_psbt_sessions.emplace(session_id, std::move(psbtx));
+    g_psbt_session_order.push_back(session_id);
+    while (g_psbt_sessions.size() > MAX_PSBT_SESSIONS) {
+        // Ids of sessions already closed may linger in the order queue; erasing
+        // them again is a no-op and the loop moves on to the next-oldest id.
+        g_psbt_sessions.erase(g_psbt_session_order.front());
+        g_psbt_session_order.pop_front();
+    }
+    return session_id;
+}
+
+std::optional<PartiallySignedTransaction> GetPSBTSession(const std::string& session_id)
+{
+    LOCK(g_psbt_sessions_mutex);
+    const auto it{g_psbt_sessions.find(session_id)};
+    if (it == g_psbt_sessions.end()) return std::nullopt;
+    return it->second;
+}
+
+bool UpdatePSBTSession(const std::string& session_id, PartiallySignedTransaction psbtx)
+{
+    LOCK(g_psbt_sessions_mutex);
+    const auto it{g_psbt_sessions.find(session_id)};
+    if (it == g_psbt_sessions.end()) return false;
+    it->second = std::move(psbtx);
+    return true;
+}
+
+bool ClosePSBTSession(const std::string& session_id)
+{
+    LOCK(g_psbt_sessions_mutex);
+    return g_psbt_sessions.erase(session_id) > 0;
+}
+
+bool DecodePSBTOrSession(PartiallySignedTransaction& psbtx, const std::string& input, std::string& error, bool* from_session)
+{
+    if (from_session) *from_session = false;
+    // Session ids are 64 hex characters, which is never a valid base64-encoded
+    // PSBT (those start with the "cHNidP8" magic).
+    if (input.size() == 64 && IsHex(input)) {
+        if (auto session{GetPSBTSession(input)}) {
+            psbtx = std::move(*session);
+            if (from_session) *from_session = true;
+            return true;
+        }
+        error = "unknown PSBT session id";
+        return false;
+    }
+    return DecodeBase64PSBT(psbtx, input, error);
+}
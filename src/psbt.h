@@ -1268,4 +1268,25 @@ bool FinalizeAndExtractPSBT(PartiallySignedTransaction& psbtx, CMutableTransacti
 //! Decode a raw (binary blob) PSBT into a PartiallySignedTransaction
 [[nodiscard]] bool DecodeRawPSBT(PartiallySignedTransaction& decoded_psbt, Span<const std::byte> raw_psbt, std::string& error);
 
+/**
+ * In-node PSBT session store. Multi-step signing flows over large PSBTs pay a
+ * full base64 decode/encode round-trip per RPC call; a session keeps the
+ * parsed PartiallySignedTransaction in the node and hands the caller an opaque
+ * id (64 hex characters) that PSBT-taking RPCs accept in place of the base64
+ * string, so the transaction is parsed once and emitted once. The store is
+ * bounded; the oldest session is dropped when the cap is exceeded.
+ */
+//! Store a parsed PSBT and return the id of the new session.
+std::string OpenPSBTSession(PartiallySignedTransaction psbtx);
+//! Return a copy of the session's PSBT, or nullopt if the id is unknown.
+std::optional<PartiallySignedTransaction> GetPSBTSession(const std::string& session_id);
+//! Replace the session's PSBT. Returns false if the id is unknown.
+bool UpdatePSBTSession(const std::string& session_id, PartiallySignedTransaction psbtx);
+//! Drop a session. Returns false if the id is unknown.
+bool ClosePSBTSession(const std::string& session_id);
+//! Decode an RPC "psbt" argument that is either a base64-encoded PSBT or the
+//! id of an open session. Sets from_session so the caller can write results
+//! back to the session instead of reserializing them.
+[[nodiscard]] bool DecodePSBTOrSession(PartiallySignedTransaction& psbtx, const std::string& input, std::string& error, bool* from_session = nullptr);
+
 #endif // CORAL_PSBT_H
@@ -15,11 +15,64 @@
 
 #include <algorithm>
 #include <cassert>
+#include <list>
+#include <map>
+#include <vector>
 
 namespace
 {
 /* Global secp256k1_context object used for verification. */
 secp256k1_context* secp256k1_context_verify = nullptr;
+
+/** Bounded LRU cache of parsed public keys.
+ *
+ * Parsing (point decompression in particular) accounts for a measurable share
+ * of signature verification time, and both script validation and wallet
+ * signing repeatedly see the same keys. Entries are keyed by the serialized
+ * key bytes; only successful parses are cached, since failed ones are
+ * rejected by the caller and not retried.
+ */
+class PubKeyParseCache
+{
+public:
+    bool Parse(const unsigned char* data, size_t size, secp256k1_pubkey& out)
+    {
+        const std::vector<unsigned char> key{data, data + size};
+        const auto it = m_index.find(key);
+        if (it != m_index.end()) {
+            m_entries.splice(m_entries.begin(), m_entries, it->second);
+            out = it->second->second;
+            return true;
+        }
+        if (!secp256k1_ec_pubkey_parse(secp256k1_context_verify, &out, data, size)) {
+            return false;
+        }
+        if (m_entries.size() >= MAX_ENTRIES) {
+            m_index.erase(m_entries.back().first);
+            m_entries.pop_back();
+        }
+        m_entries.emplace_front(key, out);
+        m_index.emplace(m_entries.front().first, m_entries.begin());
+        return true;
+    }
+
+private:
+    //! Upper bound on cached keys; at ~100 bytes per entry the per-thread
+    //! footprint stays negligible while covering a hot wallet's keyset.
+    static constexpr size_t MAX_ENTRIES{128};
+    //! Cached keys, most recently used first.
+    std::list<std::pair<std::vector<unsigned char>, secp256k1_pubkey>> m_entries;
+    std::map<std::vector<unsigned char>, decltype(m_entries)::iterator> m_index;
+};
+
+/** Parse a serialized public key, consulting a per-thread parse cache. The
+ * cache is thread-local so the script check worker threads hit it without
+ * synchronization. */
+bool ParsePubKeyCached(const unsigned char* data, size_t size, secp256k1_pubkey& out)
+{
+    static thread_local PubKeyParseCache cache;
+    return cache.Parse(data, size, out);
+}
 } // namespace
 
 /** This function is taken from the libsecp256k1 distribution and implements
@@ -256,7 +309,7 @@ bool CPubKey::Verify(const uint256 &hash, const std::vector<unsigned char>& vchS
     secp256k1_pubkey pubkey;
     secp256k1_ecdsa_signature sig;
     assert(secp256k1_context_verify && "secp256k1_context_verify must be initialized to use CPubKey.");
-    if (!secp256k1_ec_pubkey_parse(secp256k1_context_verify, &pubkey, vch, size())) {
+    if (!ParsePubKeyCached(vch, size(), pubkey)) {
         return false;
     }
     if (!ecdsa_signature_parse_der_lax(secp256k1_context_verify, &sig, vchSig.data(), vchSig.size())) {
@@ -294,7 +347,7 @@ bool CPubKey::IsFullyValid() const {
         return false;
     secp256k1_pubkey pubkey;
     assert(secp256k1_context_verify && "secp256k1_context_verify must be initialized to use CPubKey.");
-    return secp256k1_ec_pubkey_parse(secp256k1_context_verify, &pubkey, vch, size());
+    return ParsePubKeyCached(vch, size(), pubkey);
 }
 
 bool CPubKey::Decompress() {
@@ -302,7 +355,7 @@ bool CPubKey::Decompress() {
         return false;
     secp256k1_pubkey pubkey;
     assert(secp256k1_context_verify && "secp256k1_context_verify must be initialized to use CPubKey.");
-    if (!secp256k1_ec_pubkey_parse(secp256k1_context_verify, &pubkey, vch, size())) {
+    if (!ParsePubKeyCached(vch, size(), pubkey)) {
         return false;
     }
     unsigned char pub[SIZE];
@@ -321,7 +374,7 @@ bool CPubKey::Derive(CPubKey& pubkeyChild, ChainCode &ccChild, unsigned int nChi
     memcpy(ccChild.begin(), out+32, 32);
     secp256k1_pubkey pubkey;
     assert(secp256k1_context_verify && "secp256k1_context_verify must be initialized to use CPubKey.");
-    if (!secp256k1_ec_pubkey_parse(secp256k1_context_verify, &pubkey, vch, size())) {
+    if (!ParsePubKeyCached(vch, size(), pubkey)) {
         return false;
     }
     if (!secp256k1_ec_pubkey_tweak_add(secp256k1_context_verify, &pubkey, out)) {
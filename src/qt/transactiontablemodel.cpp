@@ -17,10 +17,12 @@
 
 #include <core_io.h>
 #include <interfaces/handler.h>
+#include <sync.h>
 #include <uint256.h>
 
 #include <algorithm>
 #include <functional>
+#include <map>
 
 #include <QColor>
 #include <QDateTime>
@@ -29,6 +31,7 @@
 #include <QLatin1Char>
 #include <QLatin1String>
 #include <QList>
+#include <QTimer>
 
 
 // Amount column is right-aligned it contains numbers
@@ -76,7 +79,7 @@ public:
                                   Q_ARG(bool, showTransaction));
         assert(invoked);
     }
-private:
+
     uint256 hash;
     ChangeType status;
     bool showTransaction;
@@ -103,7 +106,12 @@ public:
     bool m_loaded = false;
     /** True when transactions are being notified, for instance when scanning */
     bool m_loading = false;
-    std::vector< TransactionNotification > vQueueNotifications;
+    /** Pending notifications from core threads, drained in batches on the GUI
+     *  thread by DispatchNotifications(). Coalesced per transaction so a busy
+     *  sync cannot flood the event loop with one queued call per update. */
+    Mutex m_queue_mutex;
+    std::vector<TransactionNotification> vQueueNotifications GUARDED_BY(m_queue_mutex);
+    std::map<uint256, size_t> m_queue_index GUARDED_BY(m_queue_mutex);
 
     void NotifyTransactionChanged(const uint256 &hash, ChangeType status);
     void DispatchNotifications();
@@ -262,6 +270,14 @@ TransactionTableModel::TransactionTableModel(const PlatformStyle *_platformStyle
     priv->refreshWallet(walletModel->wallet());
 
     connect(walletModel->getOptionsModel(), &OptionsModel::displayUnitChanged, this, &TransactionTableModel::updateDisplayUnit);
+
+    // Pull queued core notifications in batches instead of replaying one
+    // cross-thread event per transaction: this is what keeps the GUI
+    // responsive when a sync or rescan touches thousands of wallet
+    // transactions, while losing nothing at steady state.
+    QTimer* dispatch_timer = new QTimer(this);
+    connect(dispatch_timer, &QTimer::timeout, this, [this] { priv->DispatchNotifications(); });
+    dispatch_timer->start(MODEL_UPDATE_DELAY);
 }
 
 TransactionTableModel::~TransactionTableModel()
@@ -711,38 +727,53 @@ void TransactionTableModel::updateDisplayUnit()
 
 void TransactionTablePriv::NotifyTransactionChanged(const uint256 &hash, ChangeType status)
 {
-    // Find transaction in wallet
     // Determine whether to show transaction or not (determine this here so that no relocking is needed in GUI thread)
     bool showTransaction = TransactionRecord::showTransaction();
 
-    TransactionNotification notification(hash, status, showTransaction);
-
-    if (!m_loaded || m_loading)
-    {
-        vQueueNotifications.push_back(notification);
+    // Notifications are always queued and pulled in batches by the model's
+    // timer (and by rescan progress updates), never replayed one queued
+    // cross-thread call at a time.
+    LOCK(m_queue_mutex);
+    const auto it = m_queue_index.find(hash);
+    if (it != m_queue_index.end()) {
+        // Coalesce with the pending notification for this transaction: the
+        // table only needs the net effect, not every intermediate update. A
+        // CT_UPDATED folds into whatever is already pending; CT_NEW and
+        // CT_DELETED replace it.
+        TransactionNotification& pending = vQueueNotifications[it->second];
+        if (status != CT_UPDATED || pending.status == CT_DELETED) pending.status = status;
+        pending.showTransaction = showTransaction;
         return;
     }
-    notification.invoke(parent);
+    m_queue_index.emplace(hash, vQueueNotifications.size());
+    vQueueNotifications.emplace_back(hash, status, showTransaction);
 }
 
 void TransactionTablePriv::DispatchNotifications()
 {
     if (!m_loaded || m_loading) return;
 
-    if (vQueueNotifications.size() > 10) { // prevent balloon spam, show maximum 10 balloons
+    std::vector<TransactionNotification> notifications;
+    {
+        LOCK(m_queue_mutex);
+        notifications.swap(vQueueNotifications);
+        m_queue_index.clear();
+    }
+    if (notifications.empty()) return;
+
+    if (notifications.size() > 10) { // prevent balloon spam, show maximum 10 balloons
         bool invoked = QMetaObject::invokeMethod(parent, "setProcessingQueuedTransactions", Qt::QueuedConnection, Q_ARG(bool, true));
         assert(invoked);
     }
-    for (unsigned int i = 0; i < vQueueNotifications.size(); ++i)
+    for (unsigned int i = 0; i < notifications.size(); ++i)
     {
-        if (vQueueNotifications.size() - i <= 10) {
+        if (notifications.size() - i <= 10) {
             bool invoked = QMetaObject::invokeMethod(parent, "setProcessingQueuedTransactions", Qt::QueuedConnection, Q_ARG(bool, false));
             assert(invoked);
         }
 
-        vQueueNotifications[i].invoke(parent);
+        notifications[i].invoke(parent);
     }
-    vQueueNotifications.clear();
 }
 
 void TransactionTableModel::subscribeToCoreSignals()
@@ -396,8 +396,10 @@ static void NotifyTransactionChanged(WalletModel *walletmodel, const uint256 &ha
 {
     Q_UNUSED(hash);
     Q_UNUSED(status);
-    bool invoked = QMetaObject::invokeMethod(walletmodel, "updateTransaction", Qt::QueuedConnection);
-    assert(invoked);
+    // Just flag the balance as dirty for the poll timer: queueing a
+    // cross-thread invocation per transaction floods the GUI event loop
+    // during sync, and the timer pull delivers the same end state.
+    walletmodel->updateTransaction();
 }
 
 static void ShowProgress(WalletModel *walletmodel, const std::string &title, int nProgress)
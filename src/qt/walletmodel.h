@@ -17,6 +17,7 @@
 #include <interfaces/wallet.h>
 #include <support/allocators/secure.h>
 
+#include <atomic>
 #include <vector>
 
 #include <QObject>
@@ -175,7 +176,8 @@ private:
     interfaces::Node& m_node;
 
     bool fHaveWatchOnly;
-    bool fForceCheckBalanceChanged{false};
+    //! Set from core notification threads, consumed by the GUI poll timer.
+    std::atomic<bool> fForceCheckBalanceChanged{false};
 
     // Wallet has an options model for wallet-specific options
     // (transaction fee, for example)
@@ -37,9 +37,14 @@
 using node::GetTransaction;
 using node::NodeContext;
 using node::ReadBlockFromDisk;
+using node::ReadRawBlockFromDisk;
 
 static const size_t MAX_GETUTXOS_OUTPOINTS = 15; //allow a max of 15 outpoints to be queried at once
 static constexpr unsigned int MAX_REST_HEADERS_RESULTS = 2000;
+//! Maximum number of blocks that a single /rest/blockrange/ request may ask for.
+static constexpr int MAX_REST_BLOCKRANGE_BLOCKS = 2000;
+//! Stop adding blocks to a /rest/blockrange/ reply once it holds this many bytes.
+static constexpr size_t MAX_REST_BLOCKRANGE_BYTES = 32 * 1024 * 1024;
 
 static const struct {
     RESTResponseFormat rf;
@@ -156,6 +161,30 @@ RESTResponseFormat ParseDataFormat(std::string& param, const std::string& strReq
     return rf_names[0].rf;
 }
 
+RESTResponseFormat FormatFromMediaType(const std::string& accept)
+{
+    if (accept.find("application/octet-stream") != std::string::npos) return RESTResponseFormat::BINARY;
+    if (accept.find("application/json") != std::string::npos) return RESTResponseFormat::JSON;
+    if (accept.find("text/plain") != std::string::npos) return RESTResponseFormat::HEX;
+    return RESTResponseFormat::UNDEF;
+}
+
+/**
+ * Determine the response format for a request. An explicit format suffix in
+ * the URI takes precedence; without one, the Accept header is consulted so
+ * clients can negotiate the binary serialization of an endpoint instead of
+ * paying for hex or JSON encoding.
+ */
+static RESTResponseFormat NegotiateDataFormat(HTTPRequest* req, std::string& param, const std::string& strReq)
+{
+    const RESTResponseFormat rf = ParseDataFormat(param, strReq);
+    if (rf != RESTResponseFormat::UNDEF) return rf;
+
+    const auto [has_accept, accept] = req->GetHeader("accept");
+    if (!has_accept) return rf;
+    return FormatFromMediaType(accept);
+}
+
 static std::string AvailableDataFormatsString()
 {
     std::string formats;
@@ -188,7 +217,7 @@ static bool rest_headers(const std::any& context,
     if (!CheckWarmup(req))
         return false;
     std::string param;
-    const RESTResponseFormat rf = ParseDataFormat(param, strURIPart);
+    const RESTResponseFormat rf = NegotiateDataFormat(req, param, strURIPart);
     std::vector<std::string> path = SplitString(param, '/');
 
     std::string raw_count;
@@ -282,7 +311,7 @@ static bool rest_block(const std::any& context,
     if (!CheckWarmup(req))
         return false;
     std::string hashStr;
-    const RESTResponseFormat rf = ParseDataFormat(hashStr, strURIPart);
+    const RESTResponseFormat rf = NegotiateDataFormat(req, hashStr, strURIPart);
 
     uint256 hash;
     if (!ParseHashStr(hashStr, hash))
@@ -329,8 +358,7 @@ static bool rest_block(const std::any& context,
     }
 
     case RESTResponseFormat::JSON: {
-        UniValue objBlock = blockToJSON(chainman.m_blockman, block, tip, pblockindex, tx_verbosity);
-        std::string strJSON = objBlock.write() + "\n";
+        std::string strJSON = blockToJSONString(chainman.m_blockman, block, tip, pblockindex, tx_verbosity) + "\n";
         req->WriteHeader("Content-Type", "application/json");
         req->WriteReply(HTTP_OK, strJSON);
         return true;
@@ -357,7 +385,7 @@ static bool rest_filter_header(const std::any& context, HTTPRequest* req, const
     if (!CheckWarmup(req)) return false;
 
     std::string param;
-    const RESTResponseFormat rf = ParseDataFormat(param, strURIPart);
+    const RESTResponseFormat rf = NegotiateDataFormat(req, param, strURIPart);
 
     std::vector<std::string> uri_parts = SplitString(param, '/');
     std::string raw_count;
@@ -476,7 +504,7 @@ static bool rest_block_filter(const std::any& context, HTTPRequest* req, const s
     if (!CheckWarmup(req)) return false;
 
     std::string param;
-    const RESTResponseFormat rf = ParseDataFormat(param, strURIPart);
+    const RESTResponseFormat rf = NegotiateDataFormat(req, param, strURIPart);
 
     // request is sent over URI scheme /rest/blockfilter/filtertype/blockhash
     std::vector<std::string> uri_parts = SplitString(param, '/');
@@ -571,7 +599,7 @@ static bool rest_chaininfo(const std::any& context, HTTPRequest* req, const std:
     if (!CheckWarmup(req))
         return false;
     std::string param;
-    const RESTResponseFormat rf = ParseDataFormat(param, strURIPart);
+    const RESTResponseFormat rf = NegotiateDataFormat(req, param, strURIPart);
 
     switch (rf) {
     case RESTResponseFormat::JSON: {
@@ -596,7 +624,7 @@ static bool rest_mempool(const std::any& context, HTTPRequest* req, const std::s
         return false;
 
     std::string param;
-    const RESTResponseFormat rf = ParseDataFormat(param, str_uri_part);
+    const RESTResponseFormat rf = NegotiateDataFormat(req, param, str_uri_part);
     if (param != "contents" && param != "info") {
         return RESTERR(req, HTTP_BAD_REQUEST, "Invalid URI format. Expected /rest/mempool/<info|contents>.json");
     }
@@ -628,7 +656,7 @@ static bool rest_tx(const std::any& context, HTTPRequest* req, const std::string
     if (!CheckWarmup(req))
         return false;
     std::string hashStr;
-    const RESTResponseFormat rf = ParseDataFormat(hashStr, strURIPart);
+    const RESTResponseFormat rf = NegotiateDataFormat(req, hashStr, strURIPart);
 
     uint256 hash;
     if (!ParseHashStr(hashStr, hash))
@@ -687,7 +715,7 @@ static bool rest_getutxos(const std::any& context, HTTPRequest* req, const std::
     if (!CheckWarmup(req))
         return false;
     std::string param;
-    const RESTResponseFormat rf = ParseDataFormat(param, strURIPart);
+    const RESTResponseFormat rf = NegotiateDataFormat(req, param, strURIPart);
 
     std::vector<std::string> uriParts;
     if (param.length() > 1)
@@ -881,7 +909,7 @@ static bool rest_blockhash_by_height(const std::any& context, HTTPRequest* req,
 {
     if (!CheckWarmup(req)) return false;
     std::string height_str;
-    const RESTResponseFormat rf = ParseDataFormat(height_str, str_uri_part);
+    const RESTResponseFormat rf = NegotiateDataFormat(req, height_str, str_uri_part);
 
     int32_t blockheight = -1; // Initialization done only to prevent valgrind false positive, see https://github.com/coral/coral/pull/18785
     if (!ParseInt32(height_str, &blockheight) || blockheight < 0) {
@@ -926,6 +954,79 @@ static bool rest_blockhash_by_height(const std::any& context, HTTPRequest* req,
     }
 }
 
+static bool rest_block_range(const std::any& context, HTTPRequest* req,
+                             const std::string& str_uri_part)
+{
+    if (!CheckWarmup(req)) return false;
+    std::string param;
+    const RESTResponseFormat rf = NegotiateDataFormat(req, param, str_uri_part);
+
+    std::vector<std::string> path = SplitString(param, '/');
+    if (path.size() != 2) {
+        return RESTERR(req, HTTP_BAD_REQUEST, "Invalid URI format. Expected /rest/blockrange/<height>/<count>.bin");
+    }
+
+    int32_t start_height = -1;
+    if (!ParseInt32(path[0], &start_height) || start_height < 0) {
+        return RESTERR(req, HTTP_BAD_REQUEST, "Invalid height: " + SanitizeString(path[0]));
+    }
+    const auto parsed_count{ToIntegral<int32_t>(path[1])};
+    if (!parsed_count.has_value() || *parsed_count < 1 || *parsed_count > MAX_REST_BLOCKRANGE_BLOCKS) {
+        return RESTERR(req, HTTP_BAD_REQUEST, strprintf("Block count is invalid or out of acceptable range (1-%d): %s", MAX_REST_BLOCKRANGE_BLOCKS, SanitizeString(path[1])));
+    }
+
+    if (rf != RESTResponseFormat::BINARY) {
+        return RESTERR(req, HTTP_NOT_FOUND, "output format not found (available: .bin)");
+    }
+
+    ChainstateManager* maybe_chainman = GetChainman(context, req);
+    if (!maybe_chainman) return false;
+    ChainstateManager& chainman = *maybe_chainman;
+
+    // Collect the on-disk positions under cs_main, then read the raw block
+    // data without the lock so that long backfill reads cannot stall
+    // validation.
+    std::vector<FlatFilePos> positions;
+    {
+        LOCK(cs_main);
+        const CChain& active_chain = chainman.ActiveChain();
+        if (start_height > active_chain.Height()) {
+            return RESTERR(req, HTTP_NOT_FOUND, "Block height out of range");
+        }
+        const int end_height{std::min(start_height + *parsed_count - 1, active_chain.Height())};
+        positions.reserve(end_height - start_height + 1);
+        for (int height = start_height; height <= end_height; ++height) {
+            const CBlockIndex* pindex = active_chain[height];
+            if (chainman.m_blockman.IsBlockPruned(pindex)) {
+                if (positions.empty()) {
+                    return RESTERR(req, HTTP_NOT_FOUND, strprintf("Block at height %d not available (pruned data)", height));
+                }
+                break;
+            }
+            positions.push_back(pindex->GetBlockPos());
+        }
+    }
+
+    // Each block is framed as a CompactSize length followed by the raw
+    // serialized block, copied straight from the block file without
+    // deserializing. The response ends after the last complete frame that
+    // fits the byte budget; the client resumes at start + frames received.
+    CDataStream ss_range(SER_NETWORK, PROTOCOL_VERSION);
+    std::vector<uint8_t> raw_block;
+    for (const FlatFilePos& pos : positions) {
+        if (!ReadRawBlockFromDisk(raw_block, pos, chainman.GetParams().MessageStart())) {
+            return RESTERR(req, HTTP_NOT_FOUND, "Block not found on disk");
+        }
+        WriteCompactSize(ss_range, raw_block.size());
+        ss_range.write(MakeByteSpan(raw_block));
+        if (ss_range.size() >= MAX_REST_BLOCKRANGE_BYTES) break;
+    }
+
+    req->WriteHeader("Content-Type", "application/octet-stream");
+    req->WriteReply(HTTP_OK, ss_range.str());
+    return true;
+}
+
 static const struct {
     const char* prefix;
     bool (*handler)(const std::any& context, HTTPRequest* req, const std::string& strReq);
@@ -940,6 +1041,7 @@ static const struct {
       {"/rest/headers/", rest_headers},
       {"/rest/getutxos", rest_getutxos},
       {"/rest/blockhashbyheight/", rest_blockhash_by_height},
+      {"/rest/blockrange/", rest_block_range},
 };
 
 void StartREST(const std::any& context)
@@ -25,4 +25,18 @@ enum class RESTResponseFormat {
  */
 RESTResponseFormat ParseDataFormat(std::string& param, const std::string& strReq);
 
+/**
+ * Map an HTTP Accept header value to a response format, for requests whose
+ * URI carries no format suffix. This lets clients negotiate raw binary
+ * serializations (blocks, headers, filters, utxo lookups) without rewriting
+ * URIs. Recognized media types, in order of preference:
+ * application/octet-stream (BINARY), application/json (JSON) and
+ * text/plain (HEX).
+ *
+ * @param[in]  accept  The value of the request's Accept header.
+ * @return     RESTResponseFormat negotiated from the media types, or UNDEF
+ *             if none of them is recognized.
+ */
+RESTResponseFormat FormatFromMediaType(const std::string& accept);
+
 #endif // CORAL_REST_H
@@ -19,7 +19,9 @@
 #include <hash.h>
 #include <index/blockfilterindex.h>
 #include <index/coinstatsindex.h>
+#include <index/scripthashindex.h>
 #include <kernel/coinstats.h>
+#include <key_io.h>
 #include <logging/timer.h>
 #include <net.h>
 #include <net_processing.h>
@@ -30,6 +32,7 @@
 #include <rpc/server.h>
 #include <rpc/server_util.h>
 #include <rpc/util.h>
+#include <scheduler.h>
 #include <script/descriptor.h>
 #include <streams.h>
 #include <sync.h>
@@ -48,9 +51,14 @@
 
 #include <stdint.h>
 
+#include <atomic>
 #include <condition_variable>
+#include <deque>
+#include <map>
 #include <memory>
 #include <mutex>
+#include <optional>
+#include <thread>
 
 using kernel::CCoinsStats;
 using kernel::CoinStatsHashType;
@@ -71,15 +79,82 @@ static GlobalMutex cs_blockchange;
 static std::condition_variable cond_blockchange;
 static CUpdatedBlock latestblock GUARDED_BY(cs_blockchange);
 
+/** A parked waitfor* request. The reply is delivered outside the RPC worker
+ * threads: from the validation interface when the predicate is satisfied, from
+ * the scheduler on timeout, or from StopRPC() at shutdown. */
+struct BlockWaiter {
+    uint64_t id;
+    //! Returns true once the given tip satisfies what the caller waits for.
+    std::function<bool(const CUpdatedBlock&)> predicate;
+    //! Transport completion delivering the reply; invoked at most once.
+    std::function<void(const UniValue&)> complete;
+};
+static std::vector<BlockWaiter> g_block_waiters GUARDED_BY(cs_blockchange);
+static uint64_t g_next_block_waiter_id GUARDED_BY(cs_blockchange){0};
+
+static UniValue BlockWaitResult(const CUpdatedBlock& block)
+{
+    UniValue ret(UniValue::VOBJ);
+    ret.pushKV("hash", block.hash.GetHex());
+    ret.pushKV("height", block.height);
+    return ret;
+}
+
+/** Complete and drop the waiter with the given id, replying with the current
+ * tip. Scheduled by DeferBlockWait to enforce timeouts; a no-op if the waiter
+ * has already been completed. */
+static void TimeoutBlockWaiter(uint64_t waiter_id)
+{
+    std::function<void(const UniValue&)> complete;
+    UniValue result;
+    {
+        LOCK(cs_blockchange);
+        auto it{std::find_if(g_block_waiters.begin(), g_block_waiters.end(),
+                             [waiter_id](const BlockWaiter& waiter) { return waiter.id == waiter_id; })};
+        if (it == g_block_waiters.end()) return;
+        complete = std::move(it->complete);
+        g_block_waiters.erase(it);
+        result = BlockWaitResult(latestblock);
+    }
+    complete(result);
+}
+
+/** Park a waitfor* request without occupying an RPC worker thread. Requires
+ * request.defer_reply to be set by the transport. A timeout of 0 waits until
+ * the predicate is satisfied or the node shuts down. */
+static UniValue DeferBlockWait(const JSONRPCRequest& request, int64_t timeout, std::function<bool(const CUpdatedBlock&)> predicate)
+{
+    CScheduler& scheduler{*Assert(EnsureAnyNodeContext(request.context).scheduler)};
+    auto complete{request.defer_reply()};
+    std::optional<uint64_t> waiter_id;
+    UniValue result;
+    {
+        LOCK(cs_blockchange);
+        if (predicate(latestblock) || !IsRPCRunning()) {
+            result = BlockWaitResult(latestblock);
+        } else {
+            waiter_id = g_next_block_waiter_id++;
+            g_block_waiters.push_back({*waiter_id, std::move(predicate), std::move(complete)});
+        }
+    }
+    if (!waiter_id) {
+        // Already satisfied (or shutting down); reply right away.
+        complete(result);
+    } else if (timeout) {
+        scheduler.scheduleFromNow([waiter_id = *waiter_id] { TimeoutBlockWaiter(waiter_id); }, std::chrono::milliseconds{timeout});
+    }
+    // The reply has been taken over by the completion callback; this return
+    // value is discarded by the transport.
+    return NullUniValue;
+}
+
 /* Calculate the difficulty for a given block index.
  */
-double GetDifficulty(const CBlockIndex* blockindex)
+double GetDifficultyFromBits(uint32_t nbits)
 {
-    CHECK_NONFATAL(blockindex);
-
-    int nShift = (blockindex->nBits >> 24) & 0xff;
+    int nShift = (nbits >> 24) & 0xff;
     double dDiff =
-        (double)0x0000ffff / (double)(blockindex->nBits & 0x00ffffff);
+        (double)0x0000ffff / (double)(nbits & 0x00ffffff);
 
     while (nShift < 29)
     {
@@ -95,6 +170,12 @@ double GetDifficulty(const CBlockIndex* blockindex)
     return dDiff;
 }
 
+double GetDifficulty(const CBlockIndex* blockindex)
+{
+    CHECK_NONFATAL(blockindex);
+    return GetDifficultyFromBits(blockindex->nBits);
+}
+
 static int ComputeNextBlockAndDepth(const CBlockIndex* tip, const CBlockIndex* blockindex, const CBlockIndex*& next)
 {
     next = tip->GetAncestor(blockindex->nHeight + 1);
@@ -199,6 +280,54 @@ UniValue blockToJSON(BlockManager& blockman, const CBlock& block, const CBlockIn
     return result;
 }
 
+std::string blockToJSONString(BlockManager& blockman, const CBlock& block, const CBlockIndex* tip, const CBlockIndex* blockindex, TxVerbosity verbosity)
+{
+    // Serialize the scalar fields through a (small) UniValue, then append the
+    // transactions to the output one at a time, so a DOM of the whole block
+    // is never materialized. For a verbose full block this cuts peak memory
+    // from hundreds of megabytes of UniValue nodes to the output string plus
+    // a single transaction's worth of nodes.
+    UniValue result = blockheaderToJSON(tip, blockindex);
+    result.pushKV("strippedsize", (int)::GetSerializeSize(block, PROTOCOL_VERSION | SERIALIZE_TRANSACTION_NO_WITNESS));
+    result.pushKV("size", (int)::GetSerializeSize(block, PROTOCOL_VERSION));
+    result.pushKV("weight", (int)::GetBlockWeight(block));
+
+    std::string out{result.write()};
+    assert(out.back() == '}');
+    out.pop_back();
+    out += ",\"tx\":[";
+
+    switch (verbosity) {
+        case TxVerbosity::SHOW_TXID:
+            for (size_t i = 0; i < block.vtx.size(); ++i) {
+                if (i > 0) out += ',';
+                out += '"';
+                out += block.vtx[i]->GetHash().GetHex();
+                out += '"';
+            }
+            break;
+
+        case TxVerbosity::SHOW_DETAILS:
+        case TxVerbosity::SHOW_DETAILS_AND_PREVOUT:
+            CBlockUndo blockUndo;
+            const bool have_undo{WITH_LOCK(::cs_main, return !blockman.IsBlockPruned(blockindex) && UndoReadFromDisk(blockUndo, blockindex))};
+
+            for (size_t i = 0; i < block.vtx.size(); ++i) {
+                const CTransactionRef& tx = block.vtx.at(i);
+                // coinbase transaction (i.e. i == 0) doesn't have undo data
+                const CTxUndo* txundo = (have_undo && i > 0) ? &blockUndo.vtxundo.at(i - 1) : nullptr;
+                UniValue objTx(UniValue::VOBJ);
+                TxToUniv(*tx, /*block_hash=*/uint256(), /*entry=*/objTx, /*include_hex=*/true, RPCSerializationFlags(), txundo, verbosity);
+                if (i > 0) out += ',';
+                out += objTx.write();
+            }
+            break;
+    }
+
+    out += "]}";
+    return out;
+}
+
 static RPCHelpMan getblockcount()
 {
     return RPCHelpMan{"getblockcount",
@@ -214,6 +343,9 @@ static RPCHelpMan getblockcount()
         [&](const RPCHelpMan& self, const JSONRPCRequest& request) -> UniValue
 {
     ChainstateManager& chainman = EnsureAnyChainman(request.context);
+    // Served from the published tip summary, so a validation thread holding
+    // cs_main cannot stall this common polling endpoint.
+    if (const auto tip{chainman.GetPublishedTip()}) return tip->height;
     LOCK(cs_main);
     return chainman.ActiveChain().Height();
 },
@@ -234,6 +366,7 @@ static RPCHelpMan getbestblockhash()
         [&](const RPCHelpMan& self, const JSONRPCRequest& request) -> UniValue
 {
     ChainstateManager& chainman = EnsureAnyChainman(request.context);
+    if (const auto tip{chainman.GetPublishedTip()}) return tip->hash.GetHex();
     LOCK(cs_main);
     return chainman.ActiveChain().Tip()->GetBlockHash().GetHex();
 },
@@ -242,12 +375,30 @@ static RPCHelpMan getbestblockhash()
 
 void RPCNotifyBlockChange(const CBlockIndex* pindex)
 {
-    if(pindex) {
+    std::vector<std::function<void(const UniValue&)>> completions;
+    UniValue result;
+    {
         LOCK(cs_blockchange);
-        latestblock.hash = pindex->GetBlockHash();
-        latestblock.height = pindex->nHeight;
+        if (pindex) {
+            latestblock.hash = pindex->GetBlockHash();
+            latestblock.height = pindex->nHeight;
+        }
+        // Collect deferred waiters that are now satisfied; at shutdown
+        // (called with RPC stopped), flush all of them so that the HTTP
+        // server can wind down.
+        const bool flush_all{!IsRPCRunning()};
+        for (auto it = g_block_waiters.begin(); it != g_block_waiters.end();) {
+            if (flush_all || it->predicate(latestblock)) {
+                completions.push_back(std::move(it->complete));
+                it = g_block_waiters.erase(it);
+            } else {
+                ++it;
+            }
+        }
+        if (!completions.empty()) result = BlockWaitResult(latestblock);
     }
     cond_blockchange.notify_all();
+    for (const auto& complete : completions) complete(result);
 }
 
 static RPCHelpMan waitfornewblock()
@@ -274,6 +425,13 @@ static RPCHelpMan waitfornewblock()
     if (!request.params[0].isNull())
         timeout = request.params[0].getInt<int>();
 
+    if (request.defer_reply) {
+        const CUpdatedBlock current{WITH_LOCK(cs_blockchange, return latestblock)};
+        return DeferBlockWait(request, timeout, [current](const CUpdatedBlock& tip) {
+            return tip.height != current.height || tip.hash != current.hash;
+        });
+    }
+
     CUpdatedBlock block;
     {
         WAIT_LOCK(cs_blockchange, lock);
@@ -320,6 +478,10 @@ static RPCHelpMan waitforblock()
     if (!request.params[1].isNull())
         timeout = request.params[1].getInt<int>();
 
+    if (request.defer_reply) {
+        return DeferBlockWait(request, timeout, [hash](const CUpdatedBlock& tip) { return tip.hash == hash; });
+    }
+
     CUpdatedBlock block;
     {
         WAIT_LOCK(cs_blockchange, lock);
@@ -367,6 +529,10 @@ static RPCHelpMan waitforblockheight()
     if (!request.params[1].isNull())
         timeout = request.params[1].getInt<int>();
 
+    if (request.defer_reply) {
+        return DeferBlockWait(request, timeout, [height](const CUpdatedBlock& tip) { return tip.height >= height; });
+    }
+
     CUpdatedBlock block;
     {
         WAIT_LOCK(cs_blockchange, lock);
@@ -416,25 +582,46 @@ static RPCHelpMan getdifficulty()
         [&](const RPCHelpMan& self, const JSONRPCRequest& request) -> UniValue
 {
     ChainstateManager& chainman = EnsureAnyChainman(request.context);
+    if (const auto tip{chainman.GetPublishedTip()}) return GetDifficultyFromBits(tip->nBits);
     LOCK(cs_main);
     return GetDifficulty(chainman.ActiveChain().Tip());
 },
     };
 }
 
+//! Largest block range a single getblockfrompeer call may schedule.
+static constexpr int MAX_BLOCK_FETCH_RANGE{2000};
+
 static RPCHelpMan getblockfrompeer()
 {
     return RPCHelpMan{
         "getblockfrompeer",
         "Attempt to fetch block from a given peer.\n\n"
         "We must have the header for this block, e.g. using submitheader.\n"
-        "Subsequent calls for the same block and a new peer will cause the response from the previous peer to be ignored.\n\n"
+        "Subsequent calls for the same block and a new peer will cause the response from the previous peer to be ignored.\n"
+        "With count > 1, fetches a range of count blocks ending at blockhash (walking back along the header chain),\n"
+        "skipping blocks we already have. Supplying additional peers stripes the requests across all given peers\n"
+        "round-robin, so a range downloads at the peers' aggregate upload rate. Each block is still fully\n"
+        "validated on arrival.\n\n"
         "Returns an empty JSON object if the request was successfully scheduled.",
         {
             {"blockhash", RPCArg::Type::STR_HEX, RPCArg::Optional::NO, "The block hash to try to fetch"},
             {"peer_id", RPCArg::Type::NUM, RPCArg::Optional::NO, "The peer to fetch it from (see getpeerinfo for peer IDs)"},
+            {"count", RPCArg::Type::NUM, RPCArg::Default{1}, "Number of blocks to fetch, ending at blockhash"},
+            {"peers", RPCArg::Type::ARR, RPCArg::DefaultHint{"[]"}, "Additional peers to stripe the requests across",
+                {
+                    {"peer_id", RPCArg::Type::NUM, RPCArg::Optional::OMITTED, "A peer ID (see getpeerinfo for peer IDs)"},
+                }},
         },
-        RPCResult{RPCResult::Type::OBJ, "", /*optional=*/false, "", {}},
+        RPCResult{RPCResult::Type::OBJ, "", /*optional=*/false, "",
+        {
+            {RPCResult::Type::NUM, "blocks_requested", /*optional=*/true, "Number of blocks requested (only present for range fetches)"},
+            {RPCResult::Type::NUM, "blocks_skipped", /*optional=*/true, "Number of blocks in the range we already had (only present for range fetches)"},
+            {RPCResult::Type::ARR, "warnings", /*optional=*/true, "Blocks that could not be scheduled (only present for range fetches)",
+            {
+                {RPCResult::Type::STR, "", ""},
+            }},
+        }},
         RPCExamples{
             HelpExampleCli("getblockfrompeer", "\"00000000c937983704a73af28acdec37b049d214adbda81d7e2a3dd146f6ed09\" 0")
             + HelpExampleRpc("getblockfrompeer", "\"00000000c937983704a73af28acdec37b049d214adbda81d7e2a3dd146f6ed09\" 0")
@@ -453,21 +640,69 @@ static RPCHelpMan getblockfrompeer()
     const uint256& block_hash{ParseHashV(request.params[0], "blockhash")};
     const NodeId peer_id{request.params[1].getInt<int64_t>()};
 
+    const int count{request.params[2].isNull() ? 1 : request.params[2].getInt<int>()};
+    if (count < 1 || count > MAX_BLOCK_FETCH_RANGE) {
+        throw JSONRPCError(RPC_INVALID_PARAMETER, strprintf("count must be between 1 and %d", MAX_BLOCK_FETCH_RANGE));
+    }
+    std::vector<NodeId> peers{peer_id};
+    if (!request.params[3].isNull()) {
+        for (const UniValue& entry : request.params[3].get_array().getValues()) {
+            const NodeId extra_peer{entry.getInt<int64_t>()};
+            if (std::find(peers.begin(), peers.end(), extra_peer) == peers.end()) {
+                peers.push_back(extra_peer);
+            }
+        }
+    }
+    const bool range_fetch{count > 1 || peers.size() > 1};
+
     const CBlockIndex* const index = WITH_LOCK(cs_main, return chainman.m_blockman.LookupBlockIndex(block_hash););
 
     if (!index) {
         throw JSONRPCError(RPC_MISC_ERROR, "Block header missing");
     }
 
-    const bool block_has_data = WITH_LOCK(::cs_main, return index->nStatus & BLOCK_HAVE_DATA);
-    if (block_has_data) {
+    // Walk back along the header chain, collecting the blocks we are missing.
+    std::vector<const CBlockIndex*> to_fetch;
+    int skipped{0};
+    {
+        LOCK(cs_main);
+        const CBlockIndex* walk{index};
+        for (int i = 0; i < count && walk != nullptr; ++i, walk = walk->pprev) {
+            if (walk->nStatus & BLOCK_HAVE_DATA) {
+                ++skipped;
+            } else {
+                to_fetch.push_back(walk);
+            }
+        }
+    }
+    if (to_fetch.empty() && !range_fetch) {
         throw JSONRPCError(RPC_MISC_ERROR, "Block already downloaded");
     }
 
-    if (const auto err{peerman.FetchBlock(peer_id, *index)}) {
-        throw JSONRPCError(RPC_MISC_ERROR, err.value());
+    // Stripe the requests across the given peers round-robin; each getdata
+    // goes out immediately, so the blocks download in parallel.
+    UniValue warnings(UniValue::VARR);
+    size_t failures{0};
+    for (size_t i = 0; i < to_fetch.size(); ++i) {
+        const NodeId peer{peers[i % peers.size()]};
+        if (const auto err{peerman.FetchBlock(peer, *to_fetch[i])}) {
+            if (!range_fetch) {
+                throw JSONRPCError(RPC_MISC_ERROR, err.value());
+            }
+            ++failures;
+            warnings.push_back(strprintf("%s from peer %d: %s", to_fetch[i]->GetBlockHash().ToString(), peer, err.value()));
+        }
+    }
+
+    UniValue result{UniValue::VOBJ};
+    if (range_fetch) {
+        result.pushKV("blocks_requested", static_cast<int64_t>(to_fetch.size() - failures));
+        result.pushKV("blocks_skipped", skipped);
+        if (!warnings.empty()) {
+            result.pushKV("warnings", warnings);
+        }
     }
-    return UniValue::VOBJ;
+    return result;
 },
     };
 }
@@ -849,6 +1084,45 @@ static std::optional<kernel::CCoinsStats> GetUTXOStats(CCoinsView* view, node::B
     return kernel::ComputeUTXOStats(hash_type, view, blockman, interruption_point);
 }
 
+static RPCHelpMan getcoinsdbstats()
+{
+    return RPCHelpMan{"getcoinsdbstats",
+        "\nReturns LevelDB internal statistics for the coins database.\n"
+        "Useful for tuning -dbcache, -dbfilterbits and related database options in production.\n",
+        {},
+        RPCResult{
+            RPCResult::Type::OBJ, "", "",
+            {
+                {RPCResult::Type::STR, "stats", "the leveldb.stats property (per-level compaction statistics)"},
+                {RPCResult::Type::STR, "sstables", "the leveldb.sstables property (sstables per level)"},
+                {RPCResult::Type::NUM, "approximate_memory_usage", "the leveldb.approximate-memory-usage property, in bytes"},
+            }},
+        RPCExamples{
+            HelpExampleCli("getcoinsdbstats", "") + HelpExampleRpc("getcoinsdbstats", "")
+        },
+        [&](const RPCHelpMan& self, const JSONRPCRequest& request) -> UniValue
+{
+    ChainstateManager& chainman = EnsureAnyChainman(request.context);
+    LOCK(cs_main);
+    const CCoinsViewDB& coins_db = chainman.ActiveChainstate().CoinsDB();
+
+    UniValue ret(UniValue::VOBJ);
+    if (const auto stats{coins_db.GetDBProperty("leveldb.stats")}) {
+        ret.pushKV("stats", *stats);
+    }
+    if (const auto sstables{coins_db.GetDBProperty("leveldb.sstables")}) {
+        ret.pushKV("sstables", *sstables);
+    }
+    if (const auto memory{coins_db.GetDBProperty("leveldb.approximate-memory-usage")}) {
+        if (const auto parsed{ToIntegral<uint64_t>(*memory)}) {
+            ret.pushKV("approximate_memory_usage", *parsed);
+        }
+    }
+    return ret;
+},
+    };
+}
+
 static RPCHelpMan gettxoutsetinfo()
 {
     return RPCHelpMan{"gettxoutsetinfo",
@@ -1463,6 +1737,39 @@ static RPCHelpMan getchaintips()
     };
 }
 
+static RPCHelpMan getchainactivationstatus()
+{
+    return RPCHelpMan{"getchainactivationstatus",
+                "Return the progress of the best-chain activation currently running, if any.\n"
+                "Mainly useful with -asyncactivation, where block connection happens on a\n"
+                "dedicated thread and may lag behind block acceptance during a long reorg.\n",
+                {},
+                RPCResult{
+                    RPCResult::Type::OBJ, "", "",
+                    {
+                        {RPCResult::Type::BOOL, "in_progress", "whether a best-chain activation is currently running"},
+                        {RPCResult::Type::NUM, "current_height", "height of the active chain tip"},
+                        {RPCResult::Type::NUM, "target_height", "height of the most-work tip being activated, or -1 if not yet determined"},
+                        {RPCResult::Type::NUM, "blocks_connected", "blocks connected by the current (or, if none, the most recent) activation"},
+                    }},
+                RPCExamples{
+                    HelpExampleCli("getchainactivationstatus", "")
+            + HelpExampleRpc("getchainactivationstatus", "")
+                },
+        [&](const RPCHelpMan& self, const JSONRPCRequest& request) -> UniValue
+{
+    ChainstateManager& chainman = EnsureAnyChainman(request.context);
+
+    UniValue obj(UniValue::VOBJ);
+    obj.pushKV("in_progress", chainman.m_activation_in_progress.load());
+    obj.pushKV("current_height", WITH_LOCK(cs_main, return chainman.ActiveChain().Height()));
+    obj.pushKV("target_height", chainman.m_activation_target_height.load());
+    obj.pushKV("blocks_connected", chainman.m_activation_blocks_connected.load());
+    return obj;
+},
+    };
+}
+
 static RPCHelpMan preciousblock()
 {
     return RPCHelpMan{"preciousblock",
@@ -1720,6 +2027,33 @@ static inline bool SetHasKeys(const std::set<T>& set, const Tk& key, const Args&
 // outpoint (needed for the utxo index) + nHeight + fCoinBase
 static constexpr size_t PER_UTXO_OVERHEAD = sizeof(COutPoint) + sizeof(uint32_t) + sizeof(bool);
 
+namespace {
+/**
+ * Bounded FIFO cache of fully-computed getblockstats results, keyed by block
+ * hash. Dashboards tend to query stats block by block and repeatedly; serving
+ * repeats from the cache avoids re-reading and deserializing block and undo
+ * data. Only complete results are cached, so a hit can answer any stat
+ * selection, and since the key is the block hash the entries stay correct
+ * across reorgs.
+ */
+Mutex g_blockstats_cache_mutex;
+std::map<uint256, UniValue> g_blockstats_cache GUARDED_BY(g_blockstats_cache_mutex);
+std::deque<uint256> g_blockstats_cache_order GUARDED_BY(g_blockstats_cache_mutex);
+constexpr size_t MAX_BLOCKSTATS_CACHE_SIZE{1000};
+
+//! Pick the requested subset out of a fully-computed stats object.
+UniValue SelectBlockStats(const UniValue& all_stats, const std::set<std::string>& stats)
+{
+    UniValue ret(UniValue::VOBJ);
+    for (const std::string& stat : stats) {
+        const UniValue& value{all_stats[stat]};
+        CHECK_NONFATAL(!value.isNull());
+        ret.pushKV(stat, value);
+    }
+    return ret;
+}
+} // namespace
+
 static RPCHelpMan getblockstats()
 {
     return RPCHelpMan{"getblockstats",
@@ -1795,9 +2129,6 @@ static RPCHelpMan getblockstats()
         }
     }
 
-    const CBlock& block = GetBlockChecked(chainman.m_blockman, &pindex);
-    const CBlockUndo& blockUndo = GetUndoChecked(chainman.m_blockman, &pindex);
-
     const bool do_all = stats.size() == 0; // Calculate everything if nothing selected (default)
     const bool do_mediantxsize = do_all || stats.count("mediantxsize") != 0;
     const bool do_medianfee = do_all || stats.count("medianfee") != 0;
@@ -1809,6 +2140,40 @@ static RPCHelpMan getblockstats()
         SetHasKeys(stats, "total_size", "avgtxsize", "mintxsize", "maxtxsize", "swtotal_size");
     const bool do_calculate_weight = do_all || SetHasKeys(stats, "total_weight", "avgfeerate", "swtotal_weight", "avgfeerate", "feerate_percentiles", "minfeerate", "maxfeerate");
     const bool do_calculate_sw = do_all || SetHasKeys(stats, "swtxs", "swtotal_size", "swtotal_weight");
+    // Whether the block itself is needed at all; some stats come straight
+    // from the block index.
+    const bool need_block = do_all || loop_inputs || loop_outputs || do_calculate_size ||
+        do_calculate_weight || do_calculate_sw || SetHasKeys(stats, "ins", "outs", "utxo_increase");
+
+    // Reject unknown stat names before doing any work.
+    static const std::set<std::string> VALID_STATS{
+        "avgfee", "avgfeerate", "avgtxsize", "blockhash", "feerate_percentiles", "height", "ins",
+        "maxfee", "maxfeerate", "maxtxsize", "medianfee", "mediantime", "mediantxsize", "minfee",
+        "minfeerate", "mintxsize", "outs", "subsidy", "swtotal_size", "swtotal_weight", "swtxs",
+        "time", "total_out", "total_size", "total_weight", "totalfee", "txs", "utxo_increase",
+        "utxo_size_inc"};
+    for (const std::string& stat : stats) {
+        if (VALID_STATS.count(stat) == 0) {
+            throw JSONRPCError(RPC_INVALID_PARAMETER, strprintf("Invalid selected statistic '%s'", stat));
+        }
+    }
+
+    const uint256 block_hash{pindex.GetBlockHash()};
+    {
+        LOCK(g_blockstats_cache_mutex);
+        const auto it{g_blockstats_cache.find(block_hash)};
+        if (it != g_blockstats_cache.end()) {
+            return do_all ? it->second : SelectBlockStats(it->second, stats);
+        }
+    }
+
+    // Only read and deserialize what the selected stats require: undo data
+    // only when input amounts are involved, and the block itself not at all
+    // when everything requested comes from the block index.
+    std::optional<CBlock> block;
+    if (need_block) block = GetBlockChecked(chainman.m_blockman, &pindex);
+    std::optional<CBlockUndo> block_undo;
+    if (loop_inputs) block_undo = GetUndoChecked(chainman.m_blockman, &pindex);
 
     CAmount maxfee = 0;
     CAmount maxfeerate = 0;
@@ -1830,8 +2195,8 @@ static RPCHelpMan getblockstats()
     std::vector<std::pair<CAmount, int64_t>> feerate_array;
     std::vector<int64_t> txsize_array;
 
-    for (size_t i = 0; i < block.vtx.size(); ++i) {
-        const auto& tx = block.vtx.at(i);
+    for (size_t i = 0; block && i < block->vtx.size(); ++i) {
+        const auto& tx = block->vtx.at(i);
         outputs += tx->vout.size();
 
         CAmount tx_total_out = 0;
@@ -1875,7 +2240,7 @@ static RPCHelpMan getblockstats()
 
         if (loop_inputs) {
             CAmount tx_total_in = 0;
-            const auto& txundo = blockUndo.vtxundo.at(i - 1);
+            const auto& txundo = block_undo->vtxundo.at(i - 1);
             for (const Coin& coin: txundo.vprevout) {
                 const CTxOut& prevoutput = coin.out;
 
@@ -1911,79 +2276,157 @@ static RPCHelpMan getblockstats()
     }
 
     UniValue ret_all(UniValue::VOBJ);
-    ret_all.pushKV("avgfee", (block.vtx.size() > 1) ? totalfee / (block.vtx.size() - 1) : 0);
-    ret_all.pushKV("avgfeerate", total_weight ? (totalfee * WITNESS_SCALE_FACTOR) / total_weight : 0); // Unit: sat/vbyte
-    ret_all.pushKV("avgtxsize", (block.vtx.size() > 1) ? total_size / (block.vtx.size() - 1) : 0);
+    // Stats available from the block index alone.
     ret_all.pushKV("blockhash", pindex.GetBlockHash().GetHex());
-    ret_all.pushKV("feerate_percentiles", feerates_res);
     ret_all.pushKV("height", (int64_t)pindex.nHeight);
-    ret_all.pushKV("ins", inputs);
-    ret_all.pushKV("maxfee", maxfee);
-    ret_all.pushKV("maxfeerate", maxfeerate);
-    ret_all.pushKV("maxtxsize", maxtxsize);
-    ret_all.pushKV("medianfee", CalculateTruncatedMedian(fee_array));
     ret_all.pushKV("mediantime", pindex.GetMedianTimePast());
-    ret_all.pushKV("mediantxsize", CalculateTruncatedMedian(txsize_array));
-    ret_all.pushKV("minfee", (minfee == MAX_MONEY) ? 0 : minfee);
-    ret_all.pushKV("minfeerate", (minfeerate == MAX_MONEY) ? 0 : minfeerate);
-    ret_all.pushKV("mintxsize", mintxsize == MAX_BLOCK_SERIALIZED_SIZE ? 0 : mintxsize);
-    ret_all.pushKV("outs", outputs);
     ret_all.pushKV("subsidy", GetBlockSubsidy(pindex.nHeight, chainman.GetParams().GetConsensus()));
-    ret_all.pushKV("swtotal_size", swtotal_size);
-    ret_all.pushKV("swtotal_weight", swtotal_weight);
-    ret_all.pushKV("swtxs", swtxs);
     ret_all.pushKV("time", pindex.GetBlockTime());
-    ret_all.pushKV("total_out", total_out);
-    ret_all.pushKV("total_size", total_size);
-    ret_all.pushKV("total_weight", total_weight);
-    ret_all.pushKV("totalfee", totalfee);
-    ret_all.pushKV("txs", (int64_t)block.vtx.size());
-    ret_all.pushKV("utxo_increase", outputs - inputs);
-    ret_all.pushKV("utxo_size_inc", utxo_size_inc);
+    ret_all.pushKV("txs", (int64_t)pindex.nTx);
+    if (block) {
+        ret_all.pushKV("avgfee", (block->vtx.size() > 1) ? totalfee / (block->vtx.size() - 1) : 0);
+        ret_all.pushKV("avgfeerate", total_weight ? (totalfee * WITNESS_SCALE_FACTOR) / total_weight : 0); // Unit: sat/vbyte
+        ret_all.pushKV("avgtxsize", (block->vtx.size() > 1) ? total_size / (block->vtx.size() - 1) : 0);
+        ret_all.pushKV("feerate_percentiles", feerates_res);
+        ret_all.pushKV("ins", inputs);
+        ret_all.pushKV("maxfee", maxfee);
+        ret_all.pushKV("maxfeerate", maxfeerate);
+        ret_all.pushKV("maxtxsize", maxtxsize);
+        ret_all.pushKV("medianfee", CalculateTruncatedMedian(fee_array));
+        ret_all.pushKV("mediantxsize", CalculateTruncatedMedian(txsize_array));
+        ret_all.pushKV("minfee", (minfee == MAX_MONEY) ? 0 : minfee);
+        ret_all.pushKV("minfeerate", (minfeerate == MAX_MONEY) ? 0 : minfeerate);
+        ret_all.pushKV("mintxsize", mintxsize == MAX_BLOCK_SERIALIZED_SIZE ? 0 : mintxsize);
+        ret_all.pushKV("outs", outputs);
+        ret_all.pushKV("swtotal_size", swtotal_size);
+        ret_all.pushKV("swtotal_weight", swtotal_weight);
+        ret_all.pushKV("swtxs", swtxs);
+        ret_all.pushKV("total_out", total_out);
+        ret_all.pushKV("total_size", total_size);
+        ret_all.pushKV("total_weight", total_weight);
+        ret_all.pushKV("totalfee", totalfee);
+        ret_all.pushKV("utxo_increase", outputs - inputs);
+        ret_all.pushKV("utxo_size_inc", utxo_size_inc);
+    }
 
     if (do_all) {
+        // Only complete results go into the cache, so that any later stat
+        // selection can be answered from a hit.
+        LOCK(g_blockstats_cache_mutex);
+        if (g_blockstats_cache.emplace(block_hash, ret_all).second) {
+            g_blockstats_cache_order.push_back(block_hash);
+            if (g_blockstats_cache_order.size() > MAX_BLOCKSTATS_CACHE_SIZE) {
+                g_blockstats_cache.erase(g_blockstats_cache_order.front());
+                g_blockstats_cache_order.pop_front();
+            }
+        }
         return ret_all;
     }
 
-    UniValue ret(UniValue::VOBJ);
-    for (const std::string& stat : stats) {
-        const UniValue& value = ret_all[stat];
-        if (value.isNull()) {
-            throw JSONRPCError(RPC_INVALID_PARAMETER, strprintf("Invalid selected statistic '%s'", stat));
-        }
-        ret.pushKV(stat, value);
-    }
-    return ret;
+    return SelectBlockStats(ret_all, stats);
 },
     };
 }
 
 namespace {
-//! Search for a given set of pubkey scripts
+/**
+ * Search for a given set of pubkey scripts, evaluating matches on all cores.
+ *
+ * The cursor iterates a LevelDB snapshot taken at creation time, so the walk
+ * itself runs without cs_main; it stays sequential on the calling thread,
+ * which batches decoded coins to a small worker pool. Script matching
+ * dominates for large descriptor sets and is trivially parallel: each worker
+ * collects hits into a private map and the maps are merged at the end.
+ */
 bool FindScriptPubKey(std::atomic<int>& scan_progress, const std::atomic<bool>& should_abort, int64_t& count, CCoinsViewCursor* cursor, const std::set<CScript>& needles, std::map<COutPoint, Coin>& out_results, std::function<void()>& interruption_point)
 {
+    using CoinEntry = std::pair<COutPoint, Coin>;
+    constexpr size_t BATCH_COINS{1024};
+    constexpr size_t MAX_QUEUED_BATCHES{16};
+
+    std::mutex mutex;
+    std::condition_variable cv_work, cv_space;
+    std::deque<std::vector<CoinEntry>> work;
+    bool done{false};
+
+    const size_t worker_count{std::max<size_t>(1, std::thread::hardware_concurrency())};
+    std::vector<std::map<COutPoint, Coin>> results(worker_count);
+    std::vector<std::thread> workers;
+    workers.reserve(worker_count);
+    for (size_t w = 0; w < worker_count; ++w) {
+        workers.emplace_back([&, w] {
+            for (;;) {
+                std::vector<CoinEntry> batch;
+                {
+                    std::unique_lock<std::mutex> lock(mutex);
+                    cv_work.wait(lock, [&] { return !work.empty() || done; });
+                    if (work.empty()) return;
+                    batch = std::move(work.front());
+                    work.pop_front();
+                }
+                cv_space.notify_one();
+                for (CoinEntry& entry : batch) {
+                    if (needles.count(entry.second.out.scriptPubKey)) {
+                        results[w].insert(std::move(entry));
+                    }
+                }
+            }
+        });
+    }
+
     scan_progress = 0;
     count = 0;
-    while (cursor->Valid()) {
-        COutPoint key;
-        Coin coin;
-        if (!cursor->GetKey(key) || !cursor->GetValue(coin)) return false;
-        if (++count % 8192 == 0) {
-            interruption_point();
-            if (should_abort) {
-                // allow to abort the scan via the abort reference
-                return false;
+    bool ok{true};
+    std::exception_ptr interrupted;
+    std::vector<CoinEntry> batch;
+    try {
+        while (cursor->Valid()) {
+            COutPoint key;
+            Coin coin;
+            if (!cursor->GetKey(key) || !cursor->GetValue(coin)) {
+                ok = false;
+                break;
             }
+            if (++count % 8192 == 0) {
+                interruption_point();
+                if (should_abort) {
+                    // allow to abort the scan via the abort reference
+                    ok = false;
+                    break;
+                }
+            }
+            if (count % 256 == 0) {
+                // update progress reference every 256 item
+                uint32_t high = 0x100 * *key.hash.begin() + *(key.hash.begin() + 1);
+                scan_progress = (int)(high * 100.0 / 65536.0 + 0.5);
+            }
+            batch.emplace_back(key, std::move(coin));
+            if (batch.size() >= BATCH_COINS) {
+                std::unique_lock<std::mutex> lock(mutex);
+                cv_space.wait(lock, [&] { return work.size() < MAX_QUEUED_BATCHES; });
+                work.push_back(std::move(batch));
+                batch.clear();
+                cv_work.notify_one();
+            }
+            cursor->Next();
         }
-        if (count % 256 == 0) {
-            // update progress reference every 256 item
-            uint32_t high = 0x100 * *key.hash.begin() + *(key.hash.begin() + 1);
-            scan_progress = (int)(high * 100.0 / 65536.0 + 0.5);
-        }
-        if (needles.count(coin.out.scriptPubKey)) {
-            out_results.emplace(key, coin);
-        }
-        cursor->Next();
+    } catch (...) {
+        // Interruption points throw; unblock the workers before rethrowing.
+        interrupted = std::current_exception();
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (ok && !interrupted && !batch.empty()) work.push_back(std::move(batch));
+        done = true;
+    }
+    cv_work.notify_all();
+    for (std::thread& t : workers) t.join();
+    if (interrupted) std::rethrow_exception(interrupted);
+    if (!ok) return false;
+
+    for (std::map<COutPoint, Coin>& result : results) {
+        out_results.merge(result);
     }
     scan_progress = 100;
     return true;
@@ -2150,7 +2593,7 @@ static RPCHelpMan scantxoutset()
             LOCK(cs_main);
             Chainstate& active_chainstate = chainman.ActiveChainstate();
             active_chainstate.ForceFlushStateToDisk();
-            pcursor = CHECK_NONFATAL(active_chainstate.CoinsDB().Cursor());
+            pcursor = std::make_unique<CPrefetchingCoinsViewCursor>(CHECK_NONFATAL(active_chainstate.CoinsDB().Cursor()));
             tip = CHECK_NONFATAL(active_chainstate.m_chain.Tip());
         }
         bool res = FindScriptPubKey(g_scan_progress, g_should_abort_scan, count, pcursor.get(), needles, coins, node.rpc_interruption_point);
@@ -2265,6 +2708,83 @@ static RPCHelpMan getblockfilter()
     };
 }
 
+static RPCHelpMan getaddresshistory()
+{
+    return RPCHelpMan{"getaddresshistory",
+                "\nRetrieve the confirmed history of an address from the scripthash index:\n"
+                "every output paying to the address, and every spend of such an output,\n"
+                "ordered by block height.\n",
+                {
+                    {"address", RPCArg::Type::STR, RPCArg::Optional::NO, "The address to look up"},
+                },
+                RPCResult{
+                    RPCResult::Type::OBJ, "", "",
+                    {
+                        {RPCResult::Type::BOOL, "synced", "Whether the index has caught up with the active chain tip; if false, recent blocks may be missing from the history"},
+                        {RPCResult::Type::ARR, "history", "Confirmed history events, height-ascending",
+                        {
+                            {RPCResult::Type::OBJ, "", "",
+                            {
+                                {RPCResult::Type::STR_HEX, "txid", "The transaction creating or spending the output"},
+                                {RPCResult::Type::NUM, "height", "The height of the block containing the transaction"},
+                                {RPCResult::Type::STR, "type", "\"funding\" if the transaction pays to the address, \"spend\" if it consumes such an output"},
+                                {RPCResult::Type::NUM, "index", "The output index (funding) or input index (spend) within the transaction"},
+                                {RPCResult::Type::STR_AMOUNT, "amount", "The value of the output created or consumed"},
+                            }},
+                        }},
+                    }},
+                RPCExamples{
+                    HelpExampleCli("getaddresshistory", "\"address\"") +
+                    HelpExampleRpc("getaddresshistory", "\"address\"")
+                },
+        [&](const RPCHelpMan& self, const JSONRPCRequest& request) -> UniValue
+{
+    if (!g_scripthash_index) {
+        throw JSONRPCError(RPC_MISC_ERROR, "Scripthash index is not enabled (start with -scripthashindex)");
+    }
+
+    const CTxDestination dest{DecodeDestination(request.params[0].get_str())};
+    if (!IsValidDestination(dest)) {
+        throw JSONRPCError(RPC_INVALID_ADDRESS_OR_KEY, "Invalid address");
+    }
+    const uint256 scripthash{ScriptHashIndex::HashScript(GetScriptForDestination(dest))};
+
+    const bool index_ready{g_scripthash_index->BlockUntilSyncedToCurrentChain()};
+
+    std::vector<ScriptHashIndex::HistoryEntry> entries;
+    if (!g_scripthash_index->FindHistory(scripthash, entries)) {
+        throw JSONRPCError(RPC_INTERNAL_ERROR, "Scripthash index lookup failed; this indicates index corruption");
+    }
+
+    UniValue history(UniValue::VARR);
+    for (const auto& entry : entries) {
+        UniValue event(UniValue::VOBJ);
+        event.pushKV("txid", entry.txid.GetHex());
+        event.pushKV("height", entry.height);
+        event.pushKV("type", entry.spending ? "spend" : "funding");
+        event.pushKV("index", static_cast<int64_t>(entry.index));
+        event.pushKV("amount", ValueFromAmount(entry.amount));
+        history.push_back(event);
+    }
+
+    UniValue ret(UniValue::VOBJ);
+    ret.pushKV("synced", index_ready);
+    ret.pushKV("history", history);
+    return ret;
+},
+    };
+}
+
+//! Upper bound on the `dumptxoutset` shard count; keeps the number of
+//! concurrent leveldb cursors and writer threads modest.
+static constexpr int MAX_SNAPSHOT_SHARDS{16};
+
+static UniValue CreateUTXOSnapshotSharded(
+    node::NodeContext& node,
+    Chainstate& chainstate,
+    const std::vector<fs::path>& paths,
+    const std::vector<fs::path>& temppaths);
+
 /**
  * Serialize the UTXO set to a file for loading elsewhere.
  *
@@ -2277,6 +2797,9 @@ static RPCHelpMan dumptxoutset()
         "Write the serialized UTXO set to disk.",
         {
             {"path", RPCArg::Type::STR, RPCArg::Optional::NO, "Path to the output file. If relative, will be prefixed by datadir."},
+            {"shards", RPCArg::Type::NUM, RPCArg::Default{1}, "Number of range-partitioned files to write in parallel (1 to " + ToString(MAX_SNAPSHOT_SHARDS) + "). "
+             "With more than one shard, each file <path>.<i> covers a disjoint txid range and carries the full snapshot metadata; "
+             "pass the base path to loadtxoutset to read them back in parallel."},
         },
         RPCResult{
             RPCResult::Type::OBJ, "", "",
@@ -2287,6 +2810,7 @@ static RPCHelpMan dumptxoutset()
                     {RPCResult::Type::STR, "path", "the absolute path that the snapshot was written to"},
                     {RPCResult::Type::STR_HEX, "txoutset_hash", "the hash of the UTXO set contents"},
                     {RPCResult::Type::NUM, "nchaintx", "the number of transactions in the chain up to and including the base block"},
+                    {RPCResult::Type::NUM, "shards", /*optional=*/true, "the number of shard files written (only present when shards > 1)"},
                 }
         },
         RPCExamples{
@@ -2300,6 +2824,39 @@ static RPCHelpMan dumptxoutset()
     // to avoid confusion due to an interruption.
     const fs::path temppath = fsbridge::AbsPathJoin(args.GetDataDirNet(), fs::u8path(request.params[0].get_str() + ".incomplete"));
 
+    const int n_shards{request.params[1].isNull() ? 1 : request.params[1].getInt<int>()};
+    if (n_shards < 1 || n_shards > MAX_SNAPSHOT_SHARDS) {
+        throw JSONRPCError(RPC_INVALID_PARAMETER,
+            strprintf("shards must be between 1 and %d", MAX_SNAPSHOT_SHARDS));
+    }
+
+    NodeContext& node = EnsureAnyNodeContext(request.context);
+    if (n_shards > 1) {
+        std::vector<fs::path> paths;
+        std::vector<fs::path> temppaths;
+        for (int i = 0; i < n_shards; ++i) {
+            const std::string name{request.params[0].get_str() + "." + ToString(i)};
+            paths.push_back(fsbridge::AbsPathJoin(args.GetDataDirNet(), fs::u8path(name)));
+            temppaths.push_back(fsbridge::AbsPathJoin(args.GetDataDirNet(), fs::u8path(name + ".incomplete")));
+            if (fs::exists(paths.back())) {
+                throw JSONRPCError(
+                    RPC_INVALID_PARAMETER,
+                    paths.back().u8string() + " already exists. If you are sure this is what you want, "
+                    "move it out of the way first");
+            }
+        }
+
+        UniValue result = CreateUTXOSnapshotSharded(
+            node, node.chainman->ActiveChainstate(), paths, temppaths);
+        for (int i = 0; i < n_shards; ++i) {
+            fs::rename(temppaths[i], paths[i]);
+        }
+
+        result.pushKV("path", path.u8string());
+        result.pushKV("shards", n_shards);
+        return result;
+    }
+
     if (fs::exists(path)) {
         throw JSONRPCError(
             RPC_INVALID_PARAMETER,
@@ -2315,7 +2872,6 @@ static RPCHelpMan dumptxoutset()
             "Couldn't open file " + temppath.u8string() + " for writing.");
     }
 
-    NodeContext& node = EnsureAnyNodeContext(request.context);
     UniValue result = CreateUTXOSnapshot(
         node, node.chainman->ActiveChainstate(), afile, path, temppath);
     fs::rename(temppath, path);
@@ -2359,7 +2915,7 @@ UniValue CreateUTXOSnapshot(
             throw JSONRPCError(RPC_INTERNAL_ERROR, "Unable to read UTXO set");
         }
 
-        pcursor = chainstate.CoinsDB().Cursor();
+        pcursor = std::make_unique<CPrefetchingCoinsViewCursor>(chainstate.CoinsDB().Cursor());
         tip = CHECK_NONFATAL(chainstate.m_blockman.LookupBlockIndex(maybe_stats->hashBlock));
     }
 
@@ -2400,6 +2956,220 @@ UniValue CreateUTXOSnapshot(
     return result;
 }
 
+static UniValue CreateUTXOSnapshotSharded(
+    NodeContext& node,
+    Chainstate& chainstate,
+    const std::vector<fs::path>& paths,
+    const std::vector<fs::path>& temppaths)
+{
+    const int n_shards(paths.size());
+    std::vector<std::unique_ptr<CCoinsViewCursor>> cursors;
+    std::optional<CCoinsStats> maybe_stats;
+    const CBlockIndex* tip;
+
+    {
+        // See CreateUTXOSnapshot() for why cs_main must be held from the
+        // flush until the cursors exist. Each leveldb cursor iterates over a
+        // database snapshot taken when it is created, so constructing all of
+        // them inside this block guarantees every shard observes the same
+        // UTXO set. The shard workers run in parallel already, so the
+        // cursors are used directly rather than through
+        // CPrefetchingCoinsViewCursor.
+        LOCK(::cs_main);
+
+        chainstate.ForceFlushStateToDisk();
+
+        maybe_stats = GetUTXOStats(&chainstate.CoinsDB(), chainstate.m_blockman, CoinStatsHashType::HASH_SERIALIZED, node.rpc_interruption_point);
+        if (!maybe_stats) {
+            throw JSONRPCError(RPC_INTERNAL_ERROR, "Unable to read UTXO set");
+        }
+
+        for (int i = 0; i < n_shards; ++i) {
+            if (i == 0) {
+                cursors.push_back(chainstate.CoinsDB().Cursor());
+            } else {
+                // Coin keys sort by raw txid bytes, so shard i starts at the
+                // first txid whose leading byte is i*256/N.
+                COutPoint start{uint256{}, 0};
+                *start.hash.begin() = static_cast<uint8_t>(i * 256 / n_shards);
+                cursors.push_back(chainstate.CoinsDB().Cursor(start));
+            }
+        }
+        tip = CHECK_NONFATAL(chainstate.m_blockman.LookupBlockIndex(maybe_stats->hashBlock));
+    }
+
+    LOG_TIME_SECONDS(strprintf("writing UTXO snapshot at height %s (%s) to %d shard files",
+        tip->nHeight, tip->GetBlockHash().ToString(), n_shards));
+
+    // Every shard carries the same metadata (with the total coin count), so
+    // any one file identifies the snapshot its siblings belong to.
+    const SnapshotMetadata metadata{tip->GetBlockHash(), maybe_stats->coins_count, tip->nChainTx};
+
+    std::vector<uint64_t> shard_coins(n_shards, 0);
+    std::vector<std::string> shard_errors(n_shards);
+    std::atomic<bool> failed{false};
+    std::vector<std::thread> workers;
+    workers.reserve(n_shards);
+    for (int i = 0; i < n_shards; ++i) {
+        workers.emplace_back([&, i] {
+            try {
+                AutoFile afile{fsbridge::fopen(temppaths[i], "wb")};
+                if (afile.IsNull()) {
+                    throw std::runtime_error("Couldn't open file " + temppaths[i].u8string() + " for writing.");
+                }
+                afile << metadata;
+
+                // This shard covers txids whose leading byte falls in
+                // [i*256/N, (i+1)*256/N).
+                const int stop_byte{(i + 1) * 256 / n_shards};
+                CCoinsViewCursor& cursor{*cursors[i]};
+                COutPoint key;
+                Coin coin;
+                unsigned int iter{0};
+                while (cursor.Valid()) {
+                    if (iter % 5000 == 0 && failed.load(std::memory_order_relaxed)) return;
+                    ++iter;
+                    if (cursor.GetKey(key)) {
+                        if (stop_byte < 256 && *key.hash.begin() >= stop_byte) break;
+                        if (cursor.GetValue(coin)) {
+                            afile << key;
+                            afile << coin;
+                            ++shard_coins[i];
+                        }
+                    }
+                    cursor.Next();
+                }
+                afile.fclose();
+            } catch (const std::exception& e) {
+                shard_errors[i] = e.what();
+                failed = true;
+            }
+        });
+    }
+    for (std::thread& worker : workers) worker.join();
+
+    if (failed) {
+        for (const fs::path& temppath : temppaths) fs::remove(temppath);
+        for (const std::string& err : shard_errors) {
+            if (!err.empty()) throw JSONRPCError(RPC_INTERNAL_ERROR, err);
+        }
+    }
+
+    uint64_t coins_written{0};
+    for (const uint64_t n : shard_coins) coins_written += n;
+    if (coins_written != maybe_stats->coins_count) {
+        for (const fs::path& temppath : temppaths) fs::remove(temppath);
+        throw JSONRPCError(RPC_INTERNAL_ERROR,
+            strprintf("Shard coin counts (%d) don't add up to the UTXO set size (%d)",
+                      coins_written, maybe_stats->coins_count));
+    }
+
+    UniValue result(UniValue::VOBJ);
+    result.pushKV("coins_written", coins_written);
+    result.pushKV("base_hash", tip->GetBlockHash().ToString());
+    result.pushKV("base_height", tip->nHeight);
+    result.pushKV("txoutset_hash", maybe_stats->hashSerialized.ToString());
+    // Cast required because univalue doesn't have serialization specified for
+    // `unsigned int`, nChainTx's type.
+    result.pushKV("nchaintx", uint64_t{tip->nChainTx});
+    return result;
+}
+
+static RPCHelpMan loadtxoutset()
+{
+    return RPCHelpMan{
+        "loadtxoutset",
+        "Load a serialized UTXO set written by dumptxoutset and deploy it as the active chainstate.\n"
+        "If the given path doesn't exist, shard files <path>.0, <path>.1, ... (as written by\n"
+        "dumptxoutset with shards > 1) are discovered automatically and read in parallel.\n"
+        "The base block header of the snapshot must already be part of the headers chain, and\n"
+        "its height must be listed in the chain parameters' assumeutxo values.",
+        {
+            {"path", RPCArg::Type::STR, RPCArg::Optional::NO, "Path to the snapshot file or the base path of a shard set. If relative, will be prefixed by datadir."},
+        },
+        RPCResult{
+            RPCResult::Type::OBJ, "", "",
+                {
+                    {RPCResult::Type::NUM, "coins_loaded", "the number of coins loaded from the snapshot"},
+                    {RPCResult::Type::NUM, "files", "the number of snapshot files read"},
+                    {RPCResult::Type::STR_HEX, "base_hash", "the hash of the base of the snapshot"},
+                    {RPCResult::Type::NUM, "base_height", "the height of the base of the snapshot"},
+                }
+        },
+        RPCExamples{
+            HelpExampleCli("loadtxoutset", "utxo.dat")
+        },
+        [&](const RPCHelpMan& self, const JSONRPCRequest& request) -> UniValue
+{
+    const ArgsManager& args{EnsureAnyArgsman(request.context)};
+    NodeContext& node = EnsureAnyNodeContext(request.context);
+    ChainstateManager& chainman = EnsureChainman(node);
+
+    const fs::path base_path = fsbridge::AbsPathJoin(args.GetDataDirNet(), fs::u8path(request.params[0].get_str()));
+    std::vector<fs::path> paths;
+    if (fs::exists(base_path)) {
+        paths.push_back(base_path);
+    } else {
+        for (int i = 0; i <= MAX_SNAPSHOT_SHARDS; ++i) {
+            const fs::path shard_path{fsbridge::AbsPathJoin(
+                args.GetDataDirNet(), fs::u8path(request.params[0].get_str() + "." + ToString(i)))};
+            if (!fs::exists(shard_path)) break;
+            paths.push_back(shard_path);
+        }
+    }
+    if (paths.empty()) {
+        throw JSONRPCError(
+            RPC_INVALID_PARAMETER,
+            "Couldn't find snapshot file " + base_path.u8string() + " or shard files " + base_path.u8string() + ".0, ...");
+    }
+
+    // Open every file up front and cross-check that the shards all describe
+    // the same snapshot before committing to the (expensive) load.
+    std::vector<std::unique_ptr<AutoFile>> files;
+    std::vector<AutoFile*> file_ptrs;
+    std::optional<SnapshotMetadata> metadata;
+    for (const fs::path& path : paths) {
+        auto afile{std::make_unique<AutoFile>(fsbridge::fopen(path, "rb"))};
+        if (afile->IsNull()) {
+            throw JSONRPCError(
+                RPC_INVALID_PARAMETER,
+                "Couldn't open file " + path.u8string() + " for reading.");
+        }
+        SnapshotMetadata file_metadata;
+        try {
+            *afile >> file_metadata;
+        } catch (const std::ios_base::failure&) {
+            throw JSONRPCError(RPC_DESERIALIZATION_ERROR, "Unable to parse metadata in " + path.u8string());
+        }
+        if (!metadata) {
+            metadata = file_metadata;
+        } else if (file_metadata.m_base_blockhash != metadata->m_base_blockhash ||
+                   file_metadata.m_coins_count != metadata->m_coins_count) {
+            throw JSONRPCError(
+                RPC_INVALID_PARAMETER,
+                path.u8string() + " describes a different snapshot than the preceding shard files");
+        }
+        file_ptrs.push_back(afile.get());
+        files.push_back(std::move(afile));
+    }
+
+    if (!chainman.ActivateSnapshot(file_ptrs, *metadata, /*in_memory=*/false)) {
+        throw JSONRPCError(RPC_INTERNAL_ERROR, "Unable to load UTXO snapshot, see debug.log");
+    }
+
+    const CBlockIndex* snapshot_start_block{WITH_LOCK(::cs_main,
+        return chainman.m_blockman.LookupBlockIndex(metadata->m_base_blockhash))};
+
+    UniValue result(UniValue::VOBJ);
+    result.pushKV("coins_loaded", metadata->m_coins_count);
+    result.pushKV("files", static_cast<int>(paths.size()));
+    result.pushKV("base_hash", metadata->m_base_blockhash.ToString());
+    result.pushKV("base_height", CHECK_NONFATAL(snapshot_start_block)->nHeight);
+    return result;
+},
+    };
+}
+
 void RegisterBlockchainRPCCommands(CRPCTable& t)
 {
     static const CRPCCommand commands[]{
@@ -2412,6 +3182,7 @@ void RegisterBlockchainRPCCommands(CRPCTable& t)
         {"blockchain", &getblockfrompeer},
         {"blockchain", &getblockhash},
         {"blockchain", &getblockheader},
+        {"blockchain", &getchainactivationstatus},
         {"blockchain", &getchaintips},
         {"blockchain", &getdifficulty},
         {"blockchain", &getdeploymentinfo},
@@ -2422,6 +3193,7 @@ void RegisterBlockchainRPCCommands(CRPCTable& t)
         {"blockchain", &preciousblock},
         {"blockchain", &scantxoutset},
         {"blockchain", &getblockfilter},
+        {"blockchain", &getaddresshistory},
         {"hidden", &invalidateblock},
         {"hidden", &reconsiderblock},
         {"hidden", &waitfornewblock},
@@ -2429,6 +3201,8 @@ void RegisterBlockchainRPCCommands(CRPCTable& t)
         {"hidden", &waitforblockheight},
         {"hidden", &syncwithvalidationinterfacequeue},
         {"hidden", &dumptxoutset},
+        {"hidden", &loadtxoutset},
+        {"hidden", &getcoinsdbstats},
     };
     for (const auto& c : commands) {
         t.appendCommand(c.name, &c);
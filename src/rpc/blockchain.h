@@ -36,12 +36,21 @@ static constexpr int NUM_GETBLOCKSTATS_PERCENTILES = 5;
  */
 double GetDifficulty(const CBlockIndex* blockindex);
 
+/** As above, from a compact difficulty target directly (e.g. taken from the
+ * published tip summary, without cs_main). */
+double GetDifficultyFromBits(uint32_t nbits);
+
 /** Callback for when block tip changed. */
 void RPCNotifyBlockChange(const CBlockIndex*);
 
 /** Block description to JSON */
 UniValue blockToJSON(node::BlockManager& blockman, const CBlock& block, const CBlockIndex* tip, const CBlockIndex* blockindex, TxVerbosity verbosity) LOCKS_EXCLUDED(cs_main);
 
+/** Block description to a JSON string, streaming the transactions into the
+ *  output instead of materializing a UniValue tree of the whole block. Same
+ *  output as blockToJSON(...).write(). */
+std::string blockToJSONString(node::BlockManager& blockman, const CBlock& block, const CBlockIndex* tip, const CBlockIndex* blockindex, TxVerbosity verbosity) LOCKS_EXCLUDED(cs_main);
+
 /** Block header to JSON */
 UniValue blockheaderToJSON(const CBlockIndex* tip, const CBlockIndex* blockindex) LOCKS_EXCLUDED(cs_main);
 
@@ -260,33 +260,104 @@ static std::vector<RPCResult> MempoolEntryDescription()
     };
 }
 
-static void entryToJSON(const CTxMemPool& pool, UniValue& info, const CTxMemPoolEntry& e) EXCLUSIVE_LOCKS_REQUIRED(pool.cs)
+/**
+ * Frozen copy of everything the verbose mempool RPCs report for one entry.
+ * Capturing one of these under pool.cs is a handful of loads and small
+ * copies per entry; the expensive part of rendering (hex conversion and
+ * UniValue construction) then runs on the snapshot without the lock, so a
+ * verbose getrawmempool over a large pool no longer stalls transaction
+ * acceptance for its whole duration.
+ */
+struct MempoolEntrySnapshot {
+    uint256 txid;
+    uint256 wtxid;
+    int32_t vsize;
+    int32_t weight;
+    int64_t time;
+    int32_t height;
+    uint64_t descendant_count;
+    uint64_t descendant_size;
+    uint64_t ancestor_count;
+    uint64_t ancestor_size;
+    CAmount fee;
+    CAmount modified_fee;
+    CAmount ancestor_fees;
+    CAmount descendant_fees;
+    std::vector<uint256> depends;
+    std::vector<uint256> spentby;
+    bool rbf;
+    bool unbroadcast;
+};
+
+static MempoolEntrySnapshot SnapshotMempoolEntry(const CTxMemPool& pool, const CTxMemPoolEntry& e) EXCLUSIVE_LOCKS_REQUIRED(pool.cs)
 {
     AssertLockHeld(pool.cs);
 
-    info.pushKV("vsize", (int)e.GetTxSize());
-    info.pushKV("weight", (int)e.GetTxWeight());
-    info.pushKV("time", count_seconds(e.GetTime()));
-    info.pushKV("height", (int)e.GetHeight());
-    info.pushKV("descendantcount", e.GetCountWithDescendants());
-    info.pushKV("descendantsize", e.GetSizeWithDescendants());
-    info.pushKV("ancestorcount", e.GetCountWithAncestors());
-    info.pushKV("ancestorsize", e.GetSizeWithAncestors());
-    info.pushKV("wtxid", pool.vTxHashes[e.vTxHashesIdx].first.ToString());
+    const CTransaction& tx = e.GetTx();
 
-    UniValue fees(UniValue::VOBJ);
-    fees.pushKV("base", ValueFromAmount(e.GetFee()));
-    fees.pushKV("modified", ValueFromAmount(e.GetModifiedFee()));
-    fees.pushKV("ancestor", ValueFromAmount(e.GetModFeesWithAncestors()));
-    fees.pushKV("descendant", ValueFromAmount(e.GetModFeesWithDescendants()));
-    info.pushKV("fees", fees);
+    MempoolEntrySnapshot snap;
+    snap.txid = tx.GetHash();
+    snap.wtxid = pool.vTxHashes[e.vTxHashesIdx].first;
+    snap.vsize = (int)e.GetTxSize();
+    snap.weight = (int)e.GetTxWeight();
+    snap.time = count_seconds(e.GetTime());
+    snap.height = (int)e.GetHeight();
+    snap.descendant_count = e.GetCountWithDescendants();
+    snap.descendant_size = e.GetSizeWithDescendants();
+    snap.ancestor_count = e.GetCountWithAncestors();
+    snap.ancestor_size = e.GetSizeWithAncestors();
+    snap.fee = e.GetFee();
+    snap.modified_fee = e.GetModifiedFee();
+    snap.ancestor_fees = e.GetModFeesWithAncestors();
+    snap.descendant_fees = e.GetModFeesWithDescendants();
+
+    for (const CTxIn& txin : tx.vin) {
+        if (pool.exists(GenTxid::Txid(txin.prevout.hash)))
+            snap.depends.push_back(txin.prevout.hash);
+    }
 
-    const CTransaction& tx = e.GetTx();
+    const CTxMemPool::txiter& it = pool.mapTx.find(snap.txid);
+    const CTxMemPoolEntry::Children& children = it->GetMemPoolChildrenConst();
+    snap.spentby.reserve(children.size());
+    for (const CTxMemPoolEntry& child : children) {
+        snap.spentby.push_back(child.GetTx().GetHash());
+    }
+
+    // Add opt-in RBF status
+    RBFTransactionState rbfState = IsRBFOptIn(tx, pool);
+    if (rbfState == RBFTransactionState::UNKNOWN) {
+        throw JSONRPCError(RPC_MISC_ERROR, "Transaction is not in mempool");
+    }
+    snap.rbf = rbfState == RBFTransactionState::REPLACEABLE_BIP125;
+    snap.unbroadcast = pool.IsUnbroadcastTx(snap.txid);
+
+    return snap;
+}
+
+static void entryToJSON(UniValue& info, const MempoolEntrySnapshot& e)
+{
+    info.pushKV("vsize", e.vsize);
+    info.pushKV("weight", e.weight);
+    info.pushKV("time", e.time);
+    info.pushKV("height", e.height);
+    info.pushKV("descendantcount", e.descendant_count);
+    info.pushKV("descendantsize", e.descendant_size);
+    info.pushKV("ancestorcount", e.ancestor_count);
+    info.pushKV("ancestorsize", e.ancestor_size);
+    info.pushKV("wtxid", e.wtxid.ToString());
+
+    UniValue fees(UniValue::VOBJ);
+    fees.pushKV("base", ValueFromAmount(e.fee));
+    fees.pushKV("modified", ValueFromAmount(e.modified_fee));
+    fees.pushKV("ancestor", ValueFromAmount(e.ancestor_fees));
+    fees.pushKV("descendant", ValueFromAmount(e.descendant_fees));
+    info.pushKV("fees", std::move(fees));
+
+    // Sorted by string representation to keep the reported order unchanged;
+    // uint256's byte order does not match its reversed-hex rendering.
     std::set<std::string> setDepends;
-    for (const CTxIn& txin : tx.vin)
-    {
-        if (pool.exists(GenTxid::Txid(txin.prevout.hash)))
-            setDepends.insert(txin.prevout.hash.ToString());
+    for (const uint256& dep : e.depends) {
+        setDepends.insert(dep.ToString());
     }
 
     UniValue depends(UniValue::VARR);
@@ -295,28 +366,17 @@ static void entryToJSON(const CTxMemPool& pool, UniValue& info, const CTxMemPool
         depends.push_back(dep);
     }
 
-    info.pushKV("depends", depends);
+    info.pushKV("depends", std::move(depends));
 
     UniValue spent(UniValue::VARR);
-    const CTxMemPool::txiter& it = pool.mapTx.find(tx.GetHash());
-    const CTxMemPoolEntry::Children& children = it->GetMemPoolChildrenConst();
-    for (const CTxMemPoolEntry& child : children) {
-        spent.push_back(child.GetTx().GetHash().ToString());
+    for (const uint256& child : e.spentby) {
+        spent.push_back(child.ToString());
     }
 
-    info.pushKV("spentby", spent);
-
-    // Add opt-in RBF status
-    bool rbfStatus = false;
-    RBFTransactionState rbfState = IsRBFOptIn(tx, pool);
-    if (rbfState == RBFTransactionState::UNKNOWN) {
-        throw JSONRPCError(RPC_MISC_ERROR, "Transaction is not in mempool");
-    } else if (rbfState == RBFTransactionState::REPLACEABLE_BIP125) {
-        rbfStatus = true;
-    }
+    info.pushKV("spentby", std::move(spent));
 
-    info.pushKV("bip125-replaceable", rbfStatus);
-    info.pushKV("unbroadcast", pool.IsUnbroadcastTx(tx.GetHash()));
+    info.pushKV("bip125-replaceable", e.rbf);
+    info.pushKV("unbroadcast", e.unbroadcast);
 }
 
 UniValue MempoolToJSON(const CTxMemPool& pool, bool verbose, bool include_mempool_sequence)
@@ -325,16 +385,23 @@ UniValue MempoolToJSON(const CTxMemPool& pool, bool verbose, bool include_mempoo
         if (include_mempool_sequence) {
             throw JSONRPCError(RPC_INVALID_PARAMETER, "Verbose results cannot contain mempool sequence values.");
         }
-        LOCK(pool.cs);
+        std::vector<MempoolEntrySnapshot> snapshots;
+        {
+            LOCK(pool.cs);
+            snapshots.reserve(pool.mapTx.size());
+            for (const CTxMemPoolEntry& e : pool.mapTx) {
+                snapshots.push_back(SnapshotMempoolEntry(pool, e));
+            }
+        }
         UniValue o(UniValue::VOBJ);
-        for (const CTxMemPoolEntry& e : pool.mapTx) {
-            const uint256& hash = e.GetTx().GetHash();
+        o.reserve(snapshots.size());
+        for (const MempoolEntrySnapshot& snap : snapshots) {
             UniValue info(UniValue::VOBJ);
-            entryToJSON(pool, info, e);
+            entryToJSON(info, snap);
             // Mempool has unique entries so there is no advantage in using
             // UniValue::pushKV, which checks if the key already exists in O(N).
             // UniValue::__pushKV is used instead which currently is O(1).
-            o.__pushKV(hash.ToString(), info);
+            o.__pushKV(snap.txid.ToString(), std::move(info));
         }
         return o;
     } else {
@@ -346,6 +413,7 @@ UniValue MempoolToJSON(const CTxMemPool& pool, bool verbose, bool include_mempoo
             mempool_sequence = pool.GetSequence();
         }
         UniValue a(UniValue::VARR);
+        a.reserve(vtxid.size());
         for (const uint256& hash : vtxid)
             a.push_back(hash.ToString());
 
@@ -353,7 +421,7 @@ UniValue MempoolToJSON(const CTxMemPool& pool, bool verbose, bool include_mempoo
             return a;
         } else {
             UniValue o(UniValue::VOBJ);
-            o.pushKV("txids", a);
+            o.pushKV("txids", std::move(a));
             o.pushKV("mempool_sequence", mempool_sequence);
             return o;
         }
@@ -441,35 +509,39 @@ static RPCHelpMan getmempoolancestors()
     uint256 hash = ParseHashV(request.params[0], "parameter 1");
 
     const CTxMemPool& mempool = EnsureAnyMemPool(request.context);
-    LOCK(mempool.cs);
+    std::vector<MempoolEntrySnapshot> snapshots;
+    {
+        LOCK(mempool.cs);
 
-    CTxMemPool::txiter it = mempool.mapTx.find(hash);
-    if (it == mempool.mapTx.end()) {
-        throw JSONRPCError(RPC_INVALID_ADDRESS_OR_KEY, "Transaction not in mempool");
-    }
+        CTxMemPool::txiter it = mempool.mapTx.find(hash);
+        if (it == mempool.mapTx.end()) {
+            throw JSONRPCError(RPC_INVALID_ADDRESS_OR_KEY, "Transaction not in mempool");
+        }
 
-    CTxMemPool::setEntries setAncestors;
-    uint64_t noLimit = std::numeric_limits<uint64_t>::max();
-    std::string dummy;
-    mempool.CalculateMemPoolAncestors(*it, setAncestors, noLimit, noLimit, noLimit, noLimit, dummy, false);
+        CTxMemPool::setEntries setAncestors;
+        uint64_t noLimit = std::numeric_limits<uint64_t>::max();
+        std::string dummy;
+        mempool.CalculateMemPoolAncestors(*it, setAncestors, noLimit, noLimit, noLimit, noLimit, dummy, false);
 
-    if (!fVerbose) {
-        UniValue o(UniValue::VARR);
-        for (CTxMemPool::txiter ancestorIt : setAncestors) {
-            o.push_back(ancestorIt->GetTx().GetHash().ToString());
+        if (!fVerbose) {
+            UniValue o(UniValue::VARR);
+            for (CTxMemPool::txiter ancestorIt : setAncestors) {
+                o.push_back(ancestorIt->GetTx().GetHash().ToString());
+            }
+            return o;
         }
-        return o;
-    } else {
-        UniValue o(UniValue::VOBJ);
+        snapshots.reserve(setAncestors.size());
         for (CTxMemPool::txiter ancestorIt : setAncestors) {
-            const CTxMemPoolEntry &e = *ancestorIt;
-            const uint256& _hash = e.GetTx().GetHash();
-            UniValue info(UniValue::VOBJ);
-            entryToJSON(mempool, info, e);
-            o.pushKV(_hash.ToString(), info);
+            snapshots.push_back(SnapshotMempoolEntry(mempool, *ancestorIt));
         }
-        return o;
     }
+    UniValue o(UniValue::VOBJ);
+    for (const MempoolEntrySnapshot& snap : snapshots) {
+        UniValue info(UniValue::VOBJ);
+        entryToJSON(info, snap);
+        o.pushKV(snap.txid.ToString(), info);
+    }
+    return o;
 },
     };
 }
@@ -505,36 +577,40 @@ static RPCHelpMan getmempooldescendants()
     uint256 hash = ParseHashV(request.params[0], "parameter 1");
 
     const CTxMemPool& mempool = EnsureAnyMemPool(request.context);
-    LOCK(mempool.cs);
+    std::vector<MempoolEntrySnapshot> snapshots;
+    {
+        LOCK(mempool.cs);
 
-    CTxMemPool::txiter it = mempool.mapTx.find(hash);
-    if (it == mempool.mapTx.end()) {
-        throw JSONRPCError(RPC_INVALID_ADDRESS_OR_KEY, "Transaction not in mempool");
-    }
+        CTxMemPool::txiter it = mempool.mapTx.find(hash);
+        if (it == mempool.mapTx.end()) {
+            throw JSONRPCError(RPC_INVALID_ADDRESS_OR_KEY, "Transaction not in mempool");
+        }
 
-    CTxMemPool::setEntries setDescendants;
-    mempool.CalculateDescendants(it, setDescendants);
-    // CTxMemPool::CalculateDescendants will include the given tx
-    setDescendants.erase(it);
+        CTxMemPool::setEntries setDescendants;
+        mempool.CalculateDescendants(it, setDescendants);
+        // CTxMemPool::CalculateDescendants will include the given tx
+        setDescendants.erase(it);
 
-    if (!fVerbose) {
-        UniValue o(UniValue::VARR);
-        for (CTxMemPool::txiter descendantIt : setDescendants) {
-            o.push_back(descendantIt->GetTx().GetHash().ToString());
-        }
+        if (!fVerbose) {
+            UniValue o(UniValue::VARR);
+            for (CTxMemPool::txiter descendantIt : setDescendants) {
+                o.push_back(descendantIt->GetTx().GetHash().ToString());
+            }
 
-        return o;
-    } else {
-        UniValue o(UniValue::VOBJ);
+            return o;
+        }
+        snapshots.reserve(setDescendants.size());
         for (CTxMemPool::txiter descendantIt : setDescendants) {
-            const CTxMemPoolEntry &e = *descendantIt;
-            const uint256& _hash = e.GetTx().GetHash();
-            UniValue info(UniValue::VOBJ);
-            entryToJSON(mempool, info, e);
-            o.pushKV(_hash.ToString(), info);
+            snapshots.push_back(SnapshotMempoolEntry(mempool, *descendantIt));
         }
-        return o;
     }
+    UniValue o(UniValue::VOBJ);
+    for (const MempoolEntrySnapshot& snap : snapshots) {
+        UniValue info(UniValue::VOBJ);
+        entryToJSON(info, snap);
+        o.pushKV(snap.txid.ToString(), info);
+    }
+    return o;
 },
     };
 }
@@ -557,16 +633,18 @@ static RPCHelpMan getmempoolentry()
     uint256 hash = ParseHashV(request.params[0], "parameter 1");
 
     const CTxMemPool& mempool = EnsureAnyMemPool(request.context);
-    LOCK(mempool.cs);
+    const MempoolEntrySnapshot snap{[&]() {
+        LOCK(mempool.cs);
 
-    CTxMemPool::txiter it = mempool.mapTx.find(hash);
-    if (it == mempool.mapTx.end()) {
-        throw JSONRPCError(RPC_INVALID_ADDRESS_OR_KEY, "Transaction not in mempool");
-    }
+        CTxMemPool::txiter it = mempool.mapTx.find(hash);
+        if (it == mempool.mapTx.end()) {
+            throw JSONRPCError(RPC_INVALID_ADDRESS_OR_KEY, "Transaction not in mempool");
+        }
 
-    const CTxMemPoolEntry &e = *it;
+        return SnapshotMempoolEntry(mempool, *it);
+    }()};
     UniValue info(UniValue::VOBJ);
-    entryToJSON(mempool, info, e);
+    entryToJSON(info, snap);
     return info;
 },
     };
@@ -705,6 +783,53 @@ static RPCHelpMan getmempoolinfo()
     };
 }
 
+static RPCHelpMan getmempoolfeehistogram()
+{
+    return RPCHelpMan{"getmempoolfeehistogram",
+        "Returns the mempool's fee-rate histogram.\n"
+        "The histogram is maintained incrementally as transactions enter and leave the mempool,\n"
+        "so this call is constant time regardless of mempool size. Rates are modified fee rates,\n"
+        "i.e. they include prioritisetransaction deltas. Empty buckets are omitted.",
+        {},
+        RPCResult{
+            RPCResult::Type::ARR, "", "",
+            {
+                {RPCResult::Type::OBJ, "", "",
+                {
+                    {RPCResult::Type::NUM, "feerate_from", "Lower fee-rate bound of this bucket (inclusive), in sat/vB"},
+                    {RPCResult::Type::NUM, "feerate_to", /*optional=*/true, "Upper fee-rate bound (exclusive), in sat/vB; omitted for the highest bucket"},
+                    {RPCResult::Type::NUM, "count", "Number of transactions in this bucket"},
+                    {RPCResult::Type::NUM, "vsize", "Sum of the transactions' virtual sizes, in vbytes"},
+                    {RPCResult::Type::STR_AMOUNT, "fees", "Sum of the transactions' modified fees in " + CURRENCY_UNIT},
+                }},
+            }},
+        RPCExamples{
+            HelpExampleCli("getmempoolfeehistogram", "")
+            + HelpExampleRpc("getmempoolfeehistogram", "")
+        },
+        [&](const RPCHelpMan& self, const JSONRPCRequest& request) -> UniValue
+{
+    const CTxMemPool& mempool{EnsureAnyMemPool(request.context)};
+    const CTxMemPool::FeeHistogram histogram{mempool.GetFeeHistogram()};
+
+    UniValue buckets(UniValue::VARR);
+    for (size_t i = 0; i < CTxMemPool::FEE_HISTOGRAM_BUCKETS; ++i) {
+        if (histogram.count[i] == 0) continue;
+        UniValue bucket(UniValue::VOBJ);
+        bucket.pushKV("feerate_from", CTxMemPool::FeeHistogramBucketLow(i));
+        if (i + 1 < CTxMemPool::FEE_HISTOGRAM_BUCKETS) {
+            bucket.pushKV("feerate_to", CTxMemPool::FeeHistogramBucketLow(i + 1));
+        }
+        bucket.pushKV("count", histogram.count[i]);
+        bucket.pushKV("vsize", histogram.vsize[i]);
+        bucket.pushKV("fees", ValueFromAmount(histogram.fee[i]));
+        buckets.push_back(bucket);
+    }
+    return buckets;
+},
+    };
+}
+
 static RPCHelpMan savemempool()
 {
     return RPCHelpMan{"savemempool",
@@ -730,7 +855,10 @@ static RPCHelpMan savemempool()
 
     const fs::path& dump_path = MempoolPath(args);
 
-    if (!DumpMempool(mempool, dump_path)) {
+    ChainstateManager& chainman = EnsureAnyChainman(request.context);
+    const uint256 tip_hash{WITH_LOCK(cs_main, return chainman.ActiveChain().Tip()->GetBlockHash())};
+
+    if (!DumpMempool(mempool, dump_path, fsbridge::fopen, /*skip_file_commit=*/false, tip_hash)) {
         throw JSONRPCError(RPC_MISC_ERROR, "Unable to dump mempool to disk");
     }
 
@@ -895,6 +1023,7 @@ void RegisterMempoolRPCCommands(CRPCTable& t)
         {"blockchain", &getmempooldescendants},
         {"blockchain", &getmempoolentry},
         {"blockchain", &gettxspendingprevout},
+        {"blockchain", &getmempoolfeehistogram},
         {"blockchain", &getmempoolinfo},
         {"blockchain", &getrawmempool},
         {"blockchain", &savemempool},
@@ -38,11 +38,15 @@
 #include <validationinterface.h>
 #include <warnings.h>
 
+#include <deque>
+#include <map>
 #include <memory>
+#include <set>
 #include <stdint.h>
 
 using node::BlockAssembler;
 using node::CBlockTemplate;
+using node::DefaultOptions;
 using node::NodeContext;
 using node::RegenerateCommitments;
 using node::UpdateTime;
@@ -120,7 +124,10 @@ static bool GenerateBlock(ChainstateManager& chainman, CBlock& block, uint64_t&
     block_hash.SetNull();
     block.hashMerkleRoot = BlockMerkleRoot(block);
 
-    while (max_tries > 0 && block.nNonce < std::numeric_limits<uint32_t>::max() && !CheckRandomXProofOfWork(block, block.nBits, chainman.GetConsensus()) && !ShutdownRequested()) {
+    // Grind against the (cheap) SHA256d arm of the proof-of-work check, which
+    // keeps regtest block generation instant. Full-speed RandomX mining is
+    // the job of the internal miner (startmining) and external miners.
+    while (max_tries > 0 && block.nNonce < std::numeric_limits<uint32_t>::max() && !CheckProofOfWork(block.GetHash(), block.nBits, chainman.GetConsensus()) && !ShutdownRequested()) {
         ++block.nNonce;
         --max_tries;
     }
@@ -143,8 +150,14 @@ static bool GenerateBlock(ChainstateManager& chainman, CBlock& block, uint64_t&
 static UniValue generateBlocks(ChainstateManager& chainman, const CTxMemPool& mempool, const CScript& coinbase_script, int nGenerate, uint64_t nMaxTries)
 {
     UniValue blockHashes(UniValue::VARR);
+    BlockAssembler::Options options{DefaultOptions()};
+    // Every block assembled here is fully validated by ProcessNewBlock right
+    // away, so the TestBlockValidity pass inside CreateNewBlock is redundant.
+    // Skipping it on regtest roughly halves the cost of generating the large
+    // block fixtures the functional tests and staging environments rely on.
+    options.test_block_validity = !chainman.GetParams().MineBlocksOnDemand();
     while (nGenerate > 0 && !ShutdownRequested()) {
-        std::unique_ptr<CBlockTemplate> pblocktemplate(BlockAssembler{chainman.ActiveChainstate(), &mempool}.CreateNewBlock(coinbase_script));
+        std::unique_ptr<CBlockTemplate> pblocktemplate(BlockAssembler{chainman.ActiveChainstate(), &mempool, options}.CreateNewBlock(coinbase_script));
         if (!pblocktemplate.get())
             throw JSONRPCError(RPC_INTERNAL_ERROR, "Couldn't create new block");
         CBlock *pblock = &pblocktemplate->block;
@@ -405,6 +418,9 @@ static RPCHelpMan getmininginfo()
                         {RPCResult::Type::NUM, "networkhashps", "The network hashes per second"},
                         {RPCResult::Type::NUM, "pooledtx", "The size of the mempool"},
                         {RPCResult::Type::STR, "chain", "current network name (main, test, signet, regtest)"},
+                        {RPCResult::Type::BOOL, "generate", "whether the internal miner is running (see startmining)"},
+                        {RPCResult::Type::NUM, "genproclimit", "number of internal miner threads (0 when not mining)"},
+                        {RPCResult::Type::NUM, "hashespersec", "internal miner hash rate since it was started (0 when not mining)"},
                         {RPCResult::Type::STR, "warnings", "any network and blockchain warnings"},
                     }},
                 RPCExamples{
@@ -427,12 +443,87 @@ static RPCHelpMan getmininginfo()
     obj.pushKV("networkhashps",    getnetworkhashps().HandleRequest(request));
     obj.pushKV("pooledtx",         (uint64_t)mempool.size());
     obj.pushKV("chain", chainman.GetParams().NetworkIDString());
+    const bool mining{node.internal_miner && node.internal_miner->IsRunning()};
+    obj.pushKV("generate",         mining);
+    obj.pushKV("genproclimit",     mining ? node.internal_miner->GetThreadCount() : 0);
+    obj.pushKV("hashespersec",     mining ? node.internal_miner->GetHashesPerSecond() : 0.0);
     obj.pushKV("warnings",         GetWarnings(false).original);
     return obj;
 },
     };
 }
 
+static RPCHelpMan startmining()
+{
+    return RPCHelpMan{"startmining",
+        "\nStart the internal RandomX miner, mining block rewards to the given address.\n"
+        "Worker threads share one RandomX dataset and grind disjoint parts of the nonce space;\n"
+        "the block template is refreshed automatically as the tip and mempool change.\n",
+        {
+            {"address", RPCArg::Type::STR, RPCArg::Optional::NO, "The address to send the newly generated coral to."},
+            {"threads", RPCArg::Type::NUM, RPCArg::Default{-1}, "Number of mining threads (-1 = one per processor core)."},
+        },
+        RPCResult{
+            RPCResult::Type::OBJ, "", "",
+            {
+                {RPCResult::Type::BOOL, "running", "whether the miner is now running"},
+                {RPCResult::Type::NUM, "threads", "number of worker threads started"},
+            }},
+        RPCExamples{
+            HelpExampleCli("startmining", "\"myaddress\" 4")
+    + HelpExampleRpc("startmining", "\"myaddress\", 4")
+        },
+        [&](const RPCHelpMan& self, const JSONRPCRequest& request) -> UniValue
+{
+    NodeContext& node = EnsureAnyNodeContext(request.context);
+    ChainstateManager& chainman = EnsureChainman(node);
+    const CTxMemPool& mempool = EnsureMemPool(node);
+
+    const CTxDestination destination{DecodeDestination(request.params[0].get_str())};
+    if (!IsValidDestination(destination)) {
+        throw JSONRPCError(RPC_INVALID_ADDRESS_OR_KEY, "Error: Invalid address");
+    }
+    const int threads{request.params[1].isNull() ? -1 : request.params[1].getInt<int>()};
+
+    if (!node.internal_miner) {
+        node.internal_miner = std::make_unique<node::CInternalMiner>(chainman, mempool);
+    }
+    if (node.internal_miner->IsRunning()) {
+        throw JSONRPCError(RPC_INVALID_REQUEST, "Error: Miner is already running, call stopmining first");
+    }
+    if (!node.internal_miner->Start(GetScriptForDestination(destination), threads)) {
+        throw JSONRPCError(RPC_INTERNAL_ERROR, "Error: Failed to start miner");
+    }
+
+    UniValue obj(UniValue::VOBJ);
+    obj.pushKV("running", true);
+    obj.pushKV("threads", node.internal_miner->GetThreadCount());
+    return obj;
+},
+    };
+}
+
+static RPCHelpMan stopmining()
+{
+    return RPCHelpMan{"stopmining",
+        "\nStop the internal RandomX miner.\n",
+        {},
+        RPCResult{
+            RPCResult::Type::BOOL, "", "whether the miner was running"},
+        RPCExamples{
+            HelpExampleCli("stopmining", "")
+    + HelpExampleRpc("stopmining", "")
+        },
+        [&](const RPCHelpMan& self, const JSONRPCRequest& request) -> UniValue
+{
+    NodeContext& node = EnsureAnyNodeContext(request.context);
+    const bool was_running{node.internal_miner && node.internal_miner->IsRunning()};
+    if (was_running) node.internal_miner->Stop();
+    return was_running;
+},
+    };
+}
+
 
 // NOTE: Unlike wallet RPC (which use BTC values), mining RPCs follow GBT (BIP 22) in using satoshi amounts
 static RPCHelpMan prioritisetransaction()
@@ -513,7 +604,7 @@ static RPCHelpMan getblocktemplate()
         {
             {"template_request", RPCArg::Type::OBJ, RPCArg::Default{UniValue::VOBJ}, "Format of the template",
             {
-                {"mode", RPCArg::Type::STR, /* treat as named arg */ RPCArg::Optional::OMITTED_NAMED_ARG, "This must be set to \"template\", \"proposal\" (see BIP 23), or omitted"},
+                {"mode", RPCArg::Type::STR, /* treat as named arg */ RPCArg::Optional::OMITTED_NAMED_ARG, "This must be set to \"template\", \"proposal\" (see BIP 23), \"delta\", or omitted. With \"delta\", 'longpollid' identifies the template the client already holds and the reply's 'transactions' only contains entries added relative to it"},
                 {"capabilities", RPCArg::Type::ARR, /* treat as named arg */ RPCArg::Optional::OMITTED_NAMED_ARG, "A list of strings",
                 {
                     {"str", RPCArg::Type::STR, RPCArg::Optional::OMITTED, "client side supported feature, 'longpoll', 'coinbasevalue', 'proposal', 'serverlist', 'workid'"},
@@ -568,6 +659,7 @@ static RPCHelpMan getblocktemplate()
                 }},
                 {RPCResult::Type::NUM, "coinbasevalue", "maximum allowable input to coinbase transaction, including the generation award and transaction fees (in satoshis)"},
                 {RPCResult::Type::STR, "longpollid", "an id to include with a request to longpoll on an update to this template"},
+                {RPCResult::Type::NUM, "mempoolloadprogress", /*optional=*/true, "only present while the persisted mempool is still being imported after startup: fraction of the dump processed so far. The template is valid to mine on but will keep improving as the import proceeds"},
                 {RPCResult::Type::STR, "target", "The hash target"},
                 {RPCResult::Type::NUM_TIME, "mintime", "The minimum timestamp appropriate for the next block time, expressed in " + UNIX_EPOCH_TIME},
                 {RPCResult::Type::ARR, "mutable", "list of ways the block template may be changed",
@@ -581,6 +673,14 @@ static RPCHelpMan getblocktemplate()
                 {RPCResult::Type::NUM_TIME, "curtime", "current timestamp in " + UNIX_EPOCH_TIME},
                 {RPCResult::Type::STR, "bits", "compressed target of next block"},
                 {RPCResult::Type::NUM, "height", "The height of the next block"},
+                {RPCResult::Type::ARR, "txids", /*optional=*/true, "with mode=='delta', txids of all non-coinbase transactions in template order",
+                {
+                    {RPCResult::Type::STR_HEX, "", "transaction id"},
+                }},
+                {RPCResult::Type::ARR, "removedtxids", /*optional=*/true, "with mode=='delta', txids present in the client's template but no longer in this one",
+                {
+                    {RPCResult::Type::STR_HEX, "", "transaction id"},
+                }},
                 {RPCResult::Type::STR_HEX, "signet_challenge", /*optional=*/true, "Only on signet"},
                 {RPCResult::Type::STR_HEX, "default_witness_commitment", /*optional=*/true, "a valid witness commitment for the unmodified block template"},
             }},
@@ -652,7 +752,7 @@ static RPCHelpMan getblocktemplate()
         }
     }
 
-    if (strMode != "template")
+    if (strMode != "template" && strMode != "delta")
         throw JSONRPCError(RPC_INVALID_PARAMETER, "Invalid mode");
 
     if (!chainman.GetParams().IsTestChain()) {
@@ -732,8 +832,13 @@ static RPCHelpMan getblocktemplate()
     static CBlockIndex* pindexPrev;
     static int64_t nStart;
     static std::unique_ptr<CBlockTemplate> pblocktemplate;
+    // While the persisted mempool is still streaming in after a restart,
+    // refresh more aggressively: each rebuild picks up the transactions
+    // imported since the last one, so early templates improve quickly
+    // instead of staying near-empty for the usual refresh interval.
+    const bool mempool_loading{!mempool.GetLoadTried()};
     if (pindexPrev != active_chain.Tip() ||
-        (mempool.GetTransactionsUpdated() != nTransactionsUpdatedLast && GetTime() - nStart > 5))
+        (mempool.GetTransactionsUpdated() != nTransactionsUpdatedLast && GetTime() - nStart > (mempool_loading ? 1 : 5)))
     {
         // Clear pindexPrev so future calls make a new block, despite any failures from here on
         pindexPrev = nullptr;
@@ -764,42 +869,79 @@ static RPCHelpMan getblocktemplate()
 
     UniValue aCaps(UniValue::VARR); aCaps.push_back("proposal");
 
-    UniValue transactions(UniValue::VARR);
-    std::map<uint256, int64_t> setTxIndex;
-    int i = 0;
-    for (const auto& it : pblock->vtx) {
-        const CTransaction& tx = *it;
-        uint256 txHash = tx.GetHash();
-        setTxIndex[txHash] = i++;
-
-        if (tx.IsCoinBase())
-            continue;
-
-        UniValue entry(UniValue::VOBJ);
-
-        entry.pushKV("data", EncodeHexTx(tx));
-        entry.pushKV("txid", txHash.GetHex());
-        entry.pushKV("hash", tx.GetWitnessHash().GetHex());
+    // The serialized 'transactions' array only depends on the cached template,
+    // so it is cached alongside it: hex-encoding every transaction is the
+    // dominant per-call cost for clients polling an unchanged template. The
+    // txid sets of recently issued templates are kept so that mode=='delta'
+    // requests can be answered with just the additions.
+    const std::string template_id{active_chain.Tip()->GetBlockHash().GetHex() + ToString(nTransactionsUpdatedLast)};
+    static std::string cached_template_id;
+    static UniValue cached_transactions{UniValue::VARR};
+    static std::vector<uint256> cached_txids;
+    static std::deque<std::pair<std::string, std::set<uint256>>> recent_template_txids;
+    constexpr size_t MAX_RECENT_TEMPLATES{8};
+
+    if (template_id != cached_template_id) {
+        UniValue transactions(UniValue::VARR);
+        std::vector<uint256> txids;
+        std::map<uint256, int64_t> setTxIndex;
+        int i = 0;
+        for (const auto& it : pblock->vtx) {
+            const CTransaction& tx = *it;
+            uint256 txHash = tx.GetHash();
+            setTxIndex[txHash] = i++;
+
+            if (tx.IsCoinBase())
+                continue;
+
+            UniValue entry(UniValue::VOBJ);
+
+            entry.pushKV("data", EncodeHexTx(tx));
+            entry.pushKV("txid", txHash.GetHex());
+            entry.pushKV("hash", tx.GetWitnessHash().GetHex());
+
+            UniValue deps(UniValue::VARR);
+            for (const CTxIn &in : tx.vin)
+            {
+                if (setTxIndex.count(in.prevout.hash))
+                    deps.push_back(setTxIndex[in.prevout.hash]);
+            }
+            entry.pushKV("depends", deps);
+
+            int index_in_template = i - 1;
+            entry.pushKV("fee", pblocktemplate->vTxFees[index_in_template]);
+            int64_t nTxSigOps = pblocktemplate->vTxSigOpsCost[index_in_template];
+            if (fPreSegWit) {
+                CHECK_NONFATAL(nTxSigOps % WITNESS_SCALE_FACTOR == 0);
+                nTxSigOps /= WITNESS_SCALE_FACTOR;
+            }
+            entry.pushKV("sigops", nTxSigOps);
+            entry.pushKV("weight", GetTransactionWeight(tx));
 
-        UniValue deps(UniValue::VARR);
-        for (const CTxIn &in : tx.vin)
-        {
-            if (setTxIndex.count(in.prevout.hash))
-                deps.push_back(setTxIndex[in.prevout.hash]);
+            transactions.push_back(entry);
+            txids.push_back(txHash);
         }
-        entry.pushKV("depends", deps);
-
-        int index_in_template = i - 1;
-        entry.pushKV("fee", pblocktemplate->vTxFees[index_in_template]);
-        int64_t nTxSigOps = pblocktemplate->vTxSigOpsCost[index_in_template];
-        if (fPreSegWit) {
-            CHECK_NONFATAL(nTxSigOps % WITNESS_SCALE_FACTOR == 0);
-            nTxSigOps /= WITNESS_SCALE_FACTOR;
-        }
-        entry.pushKV("sigops", nTxSigOps);
-        entry.pushKV("weight", GetTransactionWeight(tx));
+        cached_transactions = std::move(transactions);
+        cached_txids = std::move(txids);
+        cached_template_id = template_id;
+        recent_template_txids.emplace_back(template_id, std::set<uint256>(cached_txids.begin(), cached_txids.end()));
+        if (recent_template_txids.size() > MAX_RECENT_TEMPLATES) recent_template_txids.pop_front();
+    }
 
-        transactions.push_back(entry);
+    // For delta mode, locate the txid set of the template the client claims
+    // to hold; if it has already been evicted (or is this very template),
+    // fall through to a full response so the client can resynchronize.
+    const std::set<uint256>* delta_base{nullptr};
+    if (strMode == "delta" && lpval.isStr()) {
+        const std::string& base_id{lpval.get_str()};
+        if (base_id != template_id) {
+            for (const auto& [id, txid_set] : recent_template_txids) {
+                if (id == base_id) {
+                    delta_base = &txid_set;
+                    break;
+                }
+            }
+        }
     }
 
     UniValue aux(UniValue::VOBJ);
@@ -869,10 +1011,34 @@ static RPCHelpMan getblocktemplate()
     result.pushKV("vbrequired", int(0));
 
     result.pushKV("previousblockhash", pblock->hashPrevBlock.GetHex());
-    result.pushKV("transactions", transactions);
+    if (delta_base) {
+        UniValue added(UniValue::VARR);
+        UniValue txids_uv(UniValue::VARR);
+        for (size_t k = 0; k < cached_txids.size(); ++k) {
+            txids_uv.push_back(cached_txids[k].GetHex());
+            if (!delta_base->count(cached_txids[k])) {
+                added.push_back(cached_transactions[k]);
+            }
+        }
+        std::set<uint256> current_txids(cached_txids.begin(), cached_txids.end());
+        UniValue removed(UniValue::VARR);
+        for (const uint256& txid : *delta_base) {
+            if (!current_txids.count(txid)) removed.push_back(txid.GetHex());
+        }
+        result.pushKV("transactions", added);
+        result.pushKV("txids", txids_uv);
+        result.pushKV("removedtxids", removed);
+    } else {
+        result.pushKV("transactions", cached_transactions);
+    }
     result.pushKV("coinbaseaux", aux);
     result.pushKV("coinbasevalue", (int64_t)pblock->vtx[0]->vout[0].nValue);
     result.pushKV("longpollid", active_chain.Tip()->GetBlockHash().GetHex() + ToString(nTransactionsUpdatedLast));
+    if (mempool_loading) {
+        // Tell pool software the template was built from a partially loaded
+        // mempool: minable immediately, but fee-stale until progress hits 1.
+        result.pushKV("mempoolloadprogress", mempool.GetLoadProgress());
+    }
     result.pushKV("target", hashTarget.GetHex());
     result.pushKV("mintime", (int64_t)pindexPrev->GetMedianTimePast()+1);
     result.pushKV("mutable", aMutable);
@@ -978,6 +1144,16 @@ static RPCHelpMan submitblock()
         }
     }
 
+    // Hash the header outside cs_main before entering the pipeline.
+    // CheckBlock() runs under cs_main inside ProcessNewBlock(); warming the
+    // RandomX hash cache here turns the proof-of-work check there (and every
+    // later re-check of the same header) into a lookup, so a pool submission
+    // neither waits for validation traffic to release the lock before it can
+    // start hashing, nor holds the lock while it hashes.
+    if (!block.hashPrevBlock.IsNull()) {
+        GetRandomXHash(block);
+    }
+
     bool new_block;
     auto sc = std::make_shared<submitblock_StateCatcher>(block.GetHash());
     RegisterSharedValidationInterface(sc);
@@ -1033,6 +1209,161 @@ static RPCHelpMan submitheader()
     };
 }
 
+namespace {
+/** Outstanding work handed out by getminingheader, keyed by merkle root.
+ *  The node keeps the full block for each header it hands out so external
+ *  RandomX miners only ever exchange 80-byte headers with us. */
+struct MiningHeaderWork {
+    //! Rebuild the cached template after this long even without a tip change,
+    //! so new mempool transactions make it into handed-out work.
+    static constexpr int64_t TEMPLATE_REFRESH_INTERVAL{30};
+    //! Cap on outstanding header->block entries; old entries are evicted.
+    static constexpr size_t MAX_OUTSTANDING{1024};
+
+    Mutex mutex;
+    std::unique_ptr<CBlockTemplate> block_template GUARDED_BY(mutex);
+    CScript coinbase_script GUARDED_BY(mutex);
+    uint256 template_prev GUARDED_BY(mutex);
+    int64_t template_time GUARDED_BY(mutex){0};
+    unsigned int extra_nonce GUARDED_BY(mutex){0};
+    std::map<uint256, std::shared_ptr<const CBlock>> blocks GUARDED_BY(mutex);
+};
+MiningHeaderWork g_mining_header_work;
+} // namespace
+
+static RPCHelpMan getminingheader()
+{
+    return RPCHelpMan{"getminingheader",
+        "\nReturn an 80-byte block header to grind nonces against, along with its target.\n"
+        "The node assembles and keeps the full block; hand the solved header back via\n"
+        "submitminingsolution. Each call returns a distinct header (the coinbase extra\n"
+        "nonce is incremented), so concurrent miners can work disjoint search spaces.\n",
+        {
+            {"address", RPCArg::Type::STR, RPCArg::Optional::NO, "The address to send the newly generated coral to."},
+        },
+        RPCResult{
+            RPCResult::Type::OBJ, "", "",
+            {
+                {RPCResult::Type::STR_HEX, "header", "the serialized block header to solve"},
+                {RPCResult::Type::STR_HEX, "target", "the hash target"},
+                {RPCResult::Type::NUM, "height", "the height of the block being mined"},
+            }},
+        RPCExamples{
+            HelpExampleCli("getminingheader", "\"myaddress\"")
+    + HelpExampleRpc("getminingheader", "\"myaddress\"")
+        },
+        [&](const RPCHelpMan& self, const JSONRPCRequest& request) -> UniValue
+{
+    NodeContext& node = EnsureAnyNodeContext(request.context);
+    ChainstateManager& chainman = EnsureChainman(node);
+    const CTxMemPool& mempool = EnsureMemPool(node);
+
+    const CTxDestination destination{DecodeDestination(request.params[0].get_str())};
+    if (!IsValidDestination(destination)) {
+        throw JSONRPCError(RPC_INVALID_ADDRESS_OR_KEY, "Error: Invalid address");
+    }
+    const CScript coinbase_script{GetScriptForDestination(destination)};
+
+    MiningHeaderWork& work = g_mining_header_work;
+    LOCK(work.mutex);
+
+    const CBlockIndex* tip{WITH_LOCK(::cs_main, return chainman.ActiveChain().Tip())};
+    if (!tip) {
+        throw JSONRPCError(RPC_CLIENT_IN_INITIAL_DOWNLOAD, "Chain has no tip yet");
+    }
+
+    const int64_t now{GetTime()};
+    if (!work.block_template || work.template_prev != tip->GetBlockHash() ||
+        work.coinbase_script != coinbase_script ||
+        now - work.template_time > MiningHeaderWork::TEMPLATE_REFRESH_INTERVAL) {
+        work.block_template = BlockAssembler(chainman.ActiveChainstate(), &mempool).CreateNewBlock(coinbase_script);
+        if (!work.block_template) {
+            throw JSONRPCError(RPC_INTERNAL_ERROR, "Could not create new block");
+        }
+        if (work.template_prev != tip->GetBlockHash()) {
+            // Work on the old tip can no longer be submitted.
+            work.blocks.clear();
+        }
+        work.coinbase_script = coinbase_script;
+        work.template_prev = tip->GetBlockHash();
+        work.template_time = now;
+    }
+
+    auto block{std::make_shared<CBlock>(work.block_template->block)};
+    node::IncrementExtraNonce(block.get(), tip, work.extra_nonce);
+    while (work.blocks.size() >= MiningHeaderWork::MAX_OUTSTANDING) {
+        work.blocks.erase(work.blocks.begin());
+    }
+    work.blocks.emplace(block->hashMerkleRoot, block);
+
+    CDataStream ss(SER_NETWORK, PROTOCOL_VERSION);
+    ss << block->GetBlockHeader();
+
+    UniValue obj(UniValue::VOBJ);
+    obj.pushKV("header", HexStr(ss));
+    obj.pushKV("target", arith_uint256().SetCompact(block->nBits).GetHex());
+    obj.pushKV("height", tip->nHeight + 1);
+    return obj;
+},
+    };
+}
+
+static RPCHelpMan submitminingsolution()
+{
+    return RPCHelpMan{"submitminingsolution",
+        "\nSubmit a solved block header obtained from getminingheader.\n"
+        "The node fills in the block body it kept for that header and submits the\n"
+        "result as if via submitblock.\n",
+        {
+            {"hexdata", RPCArg::Type::STR_HEX, RPCArg::Optional::NO, "the hex-encoded solved block header"},
+        },
+        {
+            RPCResult{"If the block was accepted", RPCResult::Type::NONE, "", ""},
+            RPCResult{"Otherwise", RPCResult::Type::STR, "", "According to BIP22"},
+        },
+        RPCExamples{
+            HelpExampleCli("submitminingsolution", "\"mydata\"")
+    + HelpExampleRpc("submitminingsolution", "\"mydata\"")
+        },
+        [&](const RPCHelpMan& self, const JSONRPCRequest& request) -> UniValue
+{
+    CBlockHeader header;
+    if (!DecodeHexBlockHeader(header, request.params[0].get_str())) {
+        throw JSONRPCError(RPC_DESERIALIZATION_ERROR, "Block header decode failed");
+    }
+
+    std::shared_ptr<CBlock> blockptr;
+    {
+        MiningHeaderWork& work = g_mining_header_work;
+        LOCK(work.mutex);
+        const auto it{work.blocks.find(header.hashMerkleRoot)};
+        if (it == work.blocks.end()) {
+            throw JSONRPCError(RPC_INVALID_PARAMETER, "Header not found among outstanding work; it may be stale");
+        }
+        blockptr = std::make_shared<CBlock>(*it->second);
+    }
+    // The miner may have rolled nTime along with the nonce.
+    blockptr->nVersion = header.nVersion;
+    blockptr->nTime = header.nTime;
+    blockptr->nNonce = header.nNonce;
+
+    ChainstateManager& chainman = EnsureAnyChainman(request.context);
+    bool new_block;
+    auto sc = std::make_shared<submitblock_StateCatcher>(blockptr->GetHash());
+    RegisterSharedValidationInterface(sc);
+    bool accepted = chainman.ProcessNewBlock(blockptr, /*force_processing=*/true, /*min_pow_checked=*/true, /*new_block=*/&new_block);
+    UnregisterSharedValidationInterface(sc);
+    if (!new_block && accepted) {
+        return "duplicate";
+    }
+    if (!sc->found) {
+        return "inconclusive";
+    }
+    return BIP22ValidationResult(sc->state);
+},
+    };
+}
+
 void RegisterMiningRPCCommands(CRPCTable& t)
 {
     static const CRPCCommand commands[]{
@@ -1042,6 +1373,10 @@ void RegisterMiningRPCCommands(CRPCTable& t)
         {"mining", &getblocktemplate},
         {"mining", &submitblock},
         {"mining", &submitheader},
+        {"mining", &getminingheader},
+        {"mining", &submitminingsolution},
+        {"mining", &startmining},
+        {"mining", &stopmining},
 
         {"mining", &generatetoaddress},
         {"mining", &generatetodescriptor},
@@ -29,6 +29,7 @@
 #include <version.h>
 #include <warnings.h>
 
+#include <algorithm>
 #include <optional>
 
 #include <univalue.h>
@@ -94,9 +95,15 @@ static RPCHelpMan getpeerinfo()
 {
     return RPCHelpMan{
         "getpeerinfo",
-        "Returns data about each connected network peer as a json array of objects.",
-        {},
-        RPCResult{
+        "Returns data about each connected network peer as a json array of objects.\n"
+        "If changed_since is given, only peers whose statistics changed since that token are\n"
+        "returned, wrapped in an object together with the token for the next call, so that\n"
+        "frequent pollers do not pay for re-serializing unchanged peers.",
+        {
+            {"changed_since", RPCArg::Type::NUM, RPCArg::Optional::OMITTED_NAMED_ARG, "Only return peers whose statistics changed after this token, taken from the previous reply. Pass 0 on the first call."},
+        },
+        {
+            RPCResult{"without changed_since",
             RPCResult::Type::ARR, "", "",
             {
                 {RPCResult::Type::OBJ, "", "",
@@ -165,6 +172,20 @@ static RPCHelpMan getpeerinfo()
                                                               "best capture connection behaviors."},
                 }},
             }},
+            },
+            RPCResult{"with changed_since",
+            RPCResult::Type::OBJ, "", "",
+            {
+                {RPCResult::Type::ARR, "peers", "The peers whose statistics changed since the token",
+                {
+                    {RPCResult::Type::OBJ, "", "", {{RPCResult::Type::ELISION, "", "Same output as without changed_since"}}},
+                }},
+                {RPCResult::Type::ARR, "connected_ids", "The ids of all currently connected peers, so that no-longer-listed peers can be dropped",
+                {
+                    {RPCResult::Type::NUM, "n", "Peer index"},
+                }},
+                {RPCResult::Type::NUM, "token", "Pass as changed_since in the next call to receive only subsequent changes"},
+            }},
         },
         RPCExamples{
             HelpExampleCli("getpeerinfo", "")
@@ -176,12 +197,34 @@ static RPCHelpMan getpeerinfo()
     const CConnman& connman = EnsureConnman(node);
     const PeerManager& peerman = EnsurePeerman(node);
 
+    std::optional<uint64_t> changed_since;
+    if (!request.params[0].isNull()) {
+        const int64_t since{request.params[0].getInt<int64_t>()};
+        if (since < 0) {
+            throw JSONRPCError(RPC_INVALID_PARAMETER, "changed_since must be non-negative");
+        }
+        changed_since = since;
+    }
+
     std::vector<CNodeStats> vstats;
     connman.GetNodeStats(vstats);
 
     UniValue ret(UniValue::VARR);
+    UniValue connected_ids(UniValue::VARR);
+    // The change sequence is global and monotonic, so the highest value seen
+    // across the connected peers covers everything either reported in this
+    // reply or skipped as already seen.
+    uint64_t token{0};
 
     for (const CNodeStats& stats : vstats) {
+        if (changed_since) {
+            connected_ids.push_back(stats.nodeid);
+            token = std::max(token, stats.m_stats_seq);
+            // Skip peers the poller has already seen in this state. Fields
+            // derived from the current time (such as pingwait) are not
+            // refreshed for a peer with no traffic since the token.
+            if (stats.m_stats_seq <= *changed_since) continue;
+        }
         UniValue obj(UniValue::VOBJ);
         CNodeStateStats statestats;
         bool fStateStats = peerman.GetNodeStateStats(stats.nodeid, statestats);
@@ -265,6 +308,13 @@ static RPCHelpMan getpeerinfo()
         ret.push_back(obj);
     }
 
+    if (changed_since) {
+        UniValue delta(UniValue::VOBJ);
+        delta.pushKV("peers", ret);
+        delta.pushKV("connected_ids", connected_ids);
+        delta.pushKV("token", token);
+        return delta;
+    }
     return ret;
 },
     };
@@ -4,6 +4,7 @@
 // file COPYING or http://www.opensource.org/licenses/mit-license.php.
 
 #include <chainparams.h>
+#include <cuckoocache.h>
 #include <httpserver.h>
 #include <index/blockfilterindex.h>
 #include <index/coinstatsindex.h>
@@ -13,14 +14,19 @@
 #include <interfaces/init.h>
 #include <interfaces/ipc.h>
 #include <node/context.h>
+#include <perfstats.h>
 #include <rpc/server.h>
 #include <rpc/server_util.h>
 #include <rpc/util.h>
 #include <scheduler.h>
+#include <script/sigcache.h>
+#include <txmempool.h>
 #include <univalue.h>
 #include <util/check.h>
 #include <util/syscall_sandbox.h>
 #include <util/system.h>
+#include <validation.h>
+#include <validationinterface.h>
 
 #include <stdint.h>
 #ifdef HAVE_MALLOC_INFO
@@ -180,6 +186,13 @@ static RPCHelpMan getmemoryinfo()
                                 {RPCResult::Type::NUM, "chunks_used", "Number allocated chunks"},
                                 {RPCResult::Type::NUM, "chunks_free", "Number unused chunks"},
                             }},
+                            {RPCResult::Type::OBJ, "caches", "Bytes held by the major in-memory caches",
+                            {
+                                {RPCResult::Type::NUM, "coins_tip", /*optional=*/true, "Exact bytes held by the chainstate coins cache (the -dbcache in-memory portion)"},
+                                {RPCResult::Type::NUM, "mempool", /*optional=*/true, "Estimated bytes held by the mempool (the -maxmempool budget)"},
+                                {RPCResult::Type::NUM, "signature_cache", "Bytes allocated for the signature cache"},
+                                {RPCResult::Type::NUM, "script_execution_cache", "Bytes allocated for the script execution cache"},
+                            }},
                         }
                     },
                     RPCResult{"mode \"mallocinfo\"",
@@ -196,6 +209,18 @@ static RPCHelpMan getmemoryinfo()
     if (mode == "stats") {
         UniValue obj(UniValue::VOBJ);
         obj.pushKV("locked", RPCLockedMemoryInfo());
+        const NodeContext& node = EnsureAnyNodeContext(request.context);
+        UniValue caches(UniValue::VOBJ);
+        if (node.chainman) {
+            LOCK(cs_main);
+            caches.pushKV("coins_tip", (uint64_t)node.chainman->ActiveChainstate().CoinsTip().DynamicMemoryUsage());
+        }
+        if (node.mempool) {
+            caches.pushKV("mempool", (uint64_t)node.mempool->DynamicMemoryUsage());
+        }
+        caches.pushKV("signature_cache", (uint64_t)SignatureCacheBytes());
+        caches.pushKV("script_execution_cache", (uint64_t)ScriptExecutionCacheBytes());
+        obj.pushKV("caches", caches);
         return obj;
     } else if (mode == "mallocinfo") {
 #ifdef HAVE_MALLOC_INFO
@@ -210,6 +235,198 @@ static RPCHelpMan getmemoryinfo()
     };
 }
 
+static UniValue CacheStatsToJSON(const CuckooCache::Stats& stats)
+{
+    UniValue obj(UniValue::VOBJ);
+    obj.pushKV("entries", (uint64_t)stats.occupied);
+    obj.pushKV("max_entries", (uint64_t)stats.max_elements);
+    obj.pushKV("hits", stats.hits);
+    obj.pushKV("misses", stats.misses);
+    const uint64_t lookups{stats.hits + stats.misses};
+    obj.pushKV("hit_ratio", lookups == 0 ? 0.0 : (double)stats.hits / (double)lookups);
+    return obj;
+}
+
+static RPCHelpMan getcachestats()
+{
+    return RPCHelpMan{"getcachestats",
+                "Returns occupancy and hit-rate statistics of the signature and script execution caches,\n"
+                "useful for sizing -maxsigcachesize from live data.\n",
+                {},
+                RPCResult{
+                    RPCResult::Type::OBJ, "", "",
+                    {
+                        {RPCResult::Type::OBJ, "signature_cache", "statistics of the signature verification cache",
+                        {
+                            {RPCResult::Type::NUM, "entries", "number of entries currently in the cache"},
+                            {RPCResult::Type::NUM, "max_entries", "maximum number of entries the cache can hold"},
+                            {RPCResult::Type::NUM, "hits", "lookups that found their entry"},
+                            {RPCResult::Type::NUM, "misses", "lookups that did not find their entry"},
+                            {RPCResult::Type::NUM, "hit_ratio", "hits / (hits + misses), or 0 if no lookups yet"},
+                        }},
+                        {RPCResult::Type::OBJ, "script_execution_cache", "statistics of the script execution cache",
+                        {
+                            {RPCResult::Type::NUM, "entries", "number of entries currently in the cache"},
+                            {RPCResult::Type::NUM, "max_entries", "maximum number of entries the cache can hold"},
+                            {RPCResult::Type::NUM, "hits", "lookups that found their entry"},
+                            {RPCResult::Type::NUM, "misses", "lookups that did not find their entry"},
+                            {RPCResult::Type::NUM, "hit_ratio", "hits / (hits + misses), or 0 if no lookups yet"},
+                        }},
+                    }},
+                RPCExamples{
+                    HelpExampleCli("getcachestats", "")
+            + HelpExampleRpc("getcachestats", "")
+                },
+        [&](const RPCHelpMan& self, const JSONRPCRequest& request) -> UniValue
+{
+    UniValue obj(UniValue::VOBJ);
+    obj.pushKV("signature_cache", CacheStatsToJSON(GetSignatureCacheStats()));
+    obj.pushKV("script_execution_cache", CacheStatsToJSON(GetScriptExecutionCacheStats()));
+    return obj;
+},
+    };
+}
+
+static RPCHelpMan getperfstats()
+{
+    return RPCHelpMan{"getperfstats",
+                "Returns always-on performance counters for the node's hot paths.\n"
+                "All counters are cumulative since startup; compute rates by sampling\n"
+                "the RPC periodically (times are in microseconds).\n",
+                {},
+                RPCResult{
+                    RPCResult::Type::OBJ, "", "",
+                    {
+                        {RPCResult::Type::NUM, "uptime", "node uptime in seconds"},
+                        {RPCResult::Type::NUM, "blocks_connected", "blocks connected to the active chain"},
+                        {RPCResult::Type::NUM, "block_connect_time_us", "total time spent in ConnectBlock"},
+                        {RPCResult::Type::NUM, "script_cache_hits", "script execution cache hits"},
+                        {RPCResult::Type::NUM, "script_cache_misses", "script execution cache misses"},
+                        {RPCResult::Type::NUM, "coins_cache_hits", "coins cache lookups served from memory"},
+                        {RPCResult::Type::NUM, "coins_cache_misses", "coins cache lookups that hit the backing view"},
+                        {RPCResult::Type::NUM, "randomx_hashes", "RandomX hashes computed"},
+                        {RPCResult::Type::NUM, "randomx_hash_time_us", "total time spent computing RandomX hashes"},
+                        {RPCResult::Type::NUM, "randomx_hash_mean_us", "mean RandomX hash latency"},
+                        {RPCResult::Type::NUM, "msghand_iterations", "P2P messages dispatched by the message handler"},
+                        {RPCResult::Type::NUM, "msghand_time_us", "total time spent processing P2P messages"},
+                    }},
+                RPCExamples{
+                    HelpExampleCli("getperfstats", "")
+            + HelpExampleRpc("getperfstats", "")
+                },
+        [&](const RPCHelpMan& self, const JSONRPCRequest& request) -> UniValue
+{
+    const perf::Counters& c{perf::GetCounters()};
+    const uint64_t randomx_hashes{c.randomx_hashes.load(std::memory_order_relaxed)};
+    const uint64_t randomx_time_us{c.randomx_hash_time_us.load(std::memory_order_relaxed)};
+    UniValue obj(UniValue::VOBJ);
+    obj.pushKV("uptime", GetTime() - GetStartupTime());
+    obj.pushKV("blocks_connected", c.blocks_connected.load(std::memory_order_relaxed));
+    obj.pushKV("block_connect_time_us", c.block_connect_time_us.load(std::memory_order_relaxed));
+    obj.pushKV("script_cache_hits", c.script_cache_hits.load(std::memory_order_relaxed));
+    obj.pushKV("script_cache_misses", c.script_cache_misses.load(std::memory_order_relaxed));
+    obj.pushKV("coins_cache_hits", c.coins_cache_hits.load(std::memory_order_relaxed));
+    obj.pushKV("coins_cache_misses", c.coins_cache_misses.load(std::memory_order_relaxed));
+    obj.pushKV("randomx_hashes", randomx_hashes);
+    obj.pushKV("randomx_hash_time_us", randomx_time_us);
+    obj.pushKV("randomx_hash_mean_us", randomx_hashes ? randomx_time_us / randomx_hashes : 0);
+    obj.pushKV("msghand_iterations", c.msghand_iterations.load(std::memory_order_relaxed));
+    obj.pushKV("msghand_time_us", c.msghand_time_us.load(std::memory_order_relaxed));
+    return obj;
+},
+    };
+}
+
+static RPCHelpMan getblockperfhistory()
+{
+    return RPCHelpMan{"getblockperfhistory",
+                "Returns per-phase validation latency for recently connected blocks\n"
+                "(the last " + ToString(perf::BLOCK_PERF_HISTORY_SIZE) + " at most), oldest first. The phases correspond to the\n"
+                "-debug=bench log lines; all times are in microseconds.\n",
+                {
+                    {"count", RPCArg::Type::NUM, RPCArg::Default{(int)perf::BLOCK_PERF_HISTORY_SIZE}, "Return at most this many of the newest samples"},
+                },
+                RPCResult{
+                    RPCResult::Type::ARR, "", "",
+                    {
+                        {RPCResult::Type::OBJ, "", "",
+                        {
+                            {RPCResult::Type::NUM, "height", "height of the connected block"},
+                            {RPCResult::Type::STR_HEX, "hash", "hash of the connected block"},
+                            {RPCResult::Type::NUM_TIME, "time", "unix time when the block finished connecting"},
+                            {RPCResult::Type::NUM, "read_us", "block read from disk (zero when connected from a cached block)"},
+                            {RPCResult::Type::NUM, "connect_us", "transaction connect loop, including coins fetches"},
+                            {RPCResult::Type::NUM, "verify_us", "undo write and wait for outstanding script verification"},
+                            {RPCResult::Type::NUM, "flush_us", "coins cache flush and chainstate write"},
+                            {RPCResult::Type::NUM, "notify_us", "mempool update, tip update and notifications"},
+                            {RPCResult::Type::NUM, "total_us", "end-to-end block connection time"},
+                        }},
+                    }},
+                RPCExamples{
+                    HelpExampleCli("getblockperfhistory", "10")
+            + HelpExampleRpc("getblockperfhistory", "10")
+                },
+        [&](const RPCHelpMan& self, const JSONRPCRequest& request) -> UniValue
+{
+    const size_t count{request.params[0].isNull() ? perf::BLOCK_PERF_HISTORY_SIZE : (size_t)std::max<int64_t>(0, request.params[0].getInt<int64_t>())};
+    std::vector<perf::BlockPhaseTimes> history{perf::GetBlockPhaseHistory()};
+    const size_t first{history.size() > count ? history.size() - count : 0};
+    UniValue result(UniValue::VARR);
+    for (size_t i = first; i < history.size(); ++i) {
+        const perf::BlockPhaseTimes& sample{history[i]};
+        UniValue obj(UniValue::VOBJ);
+        obj.pushKV("height", sample.height);
+        obj.pushKV("hash", sample.hash.GetHex());
+        obj.pushKV("time", sample.time);
+        obj.pushKV("read_us", sample.read_us);
+        obj.pushKV("connect_us", sample.connect_us);
+        obj.pushKV("verify_us", sample.verify_us);
+        obj.pushKV("flush_us", sample.flush_us);
+        obj.pushKV("notify_us", sample.notify_us);
+        obj.pushKV("total_us", sample.total_us);
+        result.push_back(obj);
+    }
+    return result;
+},
+    };
+}
+
+static RPCHelpMan getvalidationqueueinfo()
+{
+    return RPCHelpMan{"getvalidationqueueinfo",
+                "Returns backpressure statistics of the validation interface notification queue.\n"
+                "A growing depth means a slow subscriber callback is delaying every notification\n"
+                "queued behind it (see the validation debug log category for the culprits).\n",
+                {},
+                RPCResult{
+                    RPCResult::Type::OBJ, "", "",
+                    {
+                        {RPCResult::Type::NUM, "depth", "number of events currently queued"},
+                        {RPCResult::Type::NUM, "depth_high_water", "maximum queue depth observed since startup"},
+                        {RPCResult::Type::NUM, "enqueued", "total events enqueued since startup"},
+                        {RPCResult::Type::NUM, "slow_callbacks", "subscriber callbacks that took long enough to delay the queue"},
+                        {RPCResult::Type::NUM, "subscribers", "number of registered subscribers"},
+                        {RPCResult::Type::NUM, "subscribers_high_priority", "subscribers notified first for each event"},
+                    }},
+                RPCExamples{
+                    HelpExampleCli("getvalidationqueueinfo", "")
+            + HelpExampleRpc("getvalidationqueueinfo", "")
+                },
+        [&](const RPCHelpMan& self, const JSONRPCRequest& request) -> UniValue
+{
+    const CMainSignals::QueueStats stats{GetMainSignals().GetQueueStats()};
+    UniValue obj(UniValue::VOBJ);
+    obj.pushKV("depth", (uint64_t)stats.depth);
+    obj.pushKV("depth_high_water", (uint64_t)stats.depth_high_water);
+    obj.pushKV("enqueued", stats.enqueued);
+    obj.pushKV("slow_callbacks", stats.slow_callbacks);
+    obj.pushKV("subscribers", (uint64_t)stats.subscribers);
+    obj.pushKV("subscribers_high_priority", (uint64_t)stats.subscribers_high);
+    return obj;
+},
+    };
+}
+
 static void EnableOrDisableLogCategories(UniValue cats, bool enable) {
     cats = cats.get_array();
     for (unsigned int i = 0; i < cats.size(); ++i) {
@@ -422,7 +639,11 @@ static RPCHelpMan getindexinfo()
 void RegisterNodeRPCCommands(CRPCTable& t)
 {
     static const CRPCCommand commands[]{
+        {"control", &getcachestats},
         {"control", &getmemoryinfo},
+        {"control", &getperfstats},
+        {"control", &getblockperfhistory},
+        {"control", &getvalidationqueueinfo},
         {"control", &logging},
         {"util", &getindexinfo},
         {"hidden", &setmocktime},
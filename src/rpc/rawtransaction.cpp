@@ -274,6 +274,82 @@ static RPCHelpMan getrawtransaction()
     };
 }
 
+static RPCHelpMan getrawtransactions()
+{
+    return RPCHelpMan{
+                "getrawtransactions",
+                "Return the raw transaction data for multiple transaction ids in one call.\n"
+
+                "\nRequires -txindex. Unlike getrawtransaction, the mempool is not consulted:\n"
+                "only transactions already included in a block are returned. The lookups are\n"
+                "batched against the transaction index and the block files are read in disk\n"
+                "order, which is considerably faster than one getrawtransaction call per txid\n"
+                "when exporting transactions in bulk.",
+                {
+                    {"txids", RPCArg::Type::ARR, RPCArg::Optional::NO, "The transaction ids",
+                        {
+                            {"txid", RPCArg::Type::STR_HEX, RPCArg::Optional::OMITTED, "A transaction id"},
+                        }},
+                    {"verbose", RPCArg::Type::BOOL, RPCArg::Default{false}, "If false, return hex strings, otherwise return json objects"},
+                },
+                RPCResult{
+                    RPCResult::Type::ARR, "", "One entry per requested txid, in the same order. Entries for\n"
+                    "transaction ids that are not indexed are null.",
+                    {
+                        {RPCResult::Type::STR_HEX, "data", "The serialized, hex-encoded data (a json object instead if verbose is set)"},
+                    },
+                    /*skip_type_check=*/true},
+                RPCExamples{
+                    HelpExampleCli("getrawtransactions", "'[\"mytxid1\",\"mytxid2\"]'")
+            + HelpExampleRpc("getrawtransactions", "[\"mytxid1\",\"mytxid2\"], true")
+                },
+        [&](const RPCHelpMan& self, const JSONRPCRequest& request) -> UniValue
+{
+    const NodeContext& node = EnsureAnyNodeContext(request.context);
+    ChainstateManager& chainman = EnsureChainman(node);
+
+    if (!g_txindex) {
+        throw JSONRPCError(RPC_MISC_ERROR, "getrawtransactions requires -txindex");
+    }
+    if (!g_txindex->BlockUntilSyncedToCurrentChain()) {
+        throw JSONRPCError(RPC_MISC_ERROR, "Blockchain transactions are still in the process of being indexed");
+    }
+
+    // Accept either a bool (true) or a num (>=1) to indicate verbose output.
+    bool fVerbose = false;
+    if (!request.params[1].isNull()) {
+        fVerbose = request.params[1].isNum() ? (request.params[1].getInt<int>() != 0) : request.params[1].get_bool();
+    }
+
+    const UniValue& txids = request.params[0].get_array();
+    std::vector<uint256> tx_hashes;
+    tx_hashes.reserve(txids.size());
+    for (unsigned int i = 0; i < txids.size(); ++i) {
+        tx_hashes.push_back(ParseHashV(txids[i], strprintf("txids[%d]", i)));
+    }
+
+    std::vector<std::optional<std::pair<CTransactionRef, uint256>>> found;
+    if (!g_txindex->FindTxs(tx_hashes, found)) {
+        throw JSONRPCError(RPC_MISC_ERROR, "Error reading from the transaction index");
+    }
+
+    UniValue result(UniValue::VARR);
+    for (const auto& entry : found) {
+        if (!entry) {
+            result.push_back(NullUniValue);
+        } else if (!fVerbose) {
+            result.push_back(EncodeHexTx(*entry->first, RPCSerializationFlags()));
+        } else {
+            UniValue obj(UniValue::VOBJ);
+            TxToJSON(*entry->first, entry->second, obj, chainman.ActiveChainstate());
+            result.push_back(obj);
+        }
+    }
+    return result;
+},
+    };
+}
+
 static RPCHelpMan createrawtransaction()
 {
     return RPCHelpMan{"createrawtransaction",
@@ -1373,7 +1449,7 @@ static RPCHelpMan finalizepsbt()
                 "created which has the final_scriptSig and final_scriptWitness fields filled for inputs that are complete.\n"
                 "Implements the Finalizer and Extractor roles.\n",
                 {
-                    {"psbt", RPCArg::Type::STR, RPCArg::Optional::NO, "A base64 string of a PSBT"},
+                    {"psbt", RPCArg::Type::STR, RPCArg::Optional::NO, "A base64 string of a PSBT, or a PSBT session id (see openpsbtsession)"},
                     {"extract", RPCArg::Type::BOOL, RPCArg::Default{true}, "If true and the transaction is complete,\n"
             "                             extract and return the complete transaction in normal network serialization instead of the PSBT."},
                 },
@@ -1395,7 +1471,8 @@ static RPCHelpMan finalizepsbt()
     // Unserialize the transactions
     PartiallySignedTransaction psbtx;
     std::string error;
-    if (!DecodeBase64PSBT(psbtx, request.params[0].get_str(), error)) {
+    bool from_session{false};
+    if (!DecodePSBTOrSession(psbtx, request.params[0].get_str(), error, &from_session)) {
         throw JSONRPCError(RPC_DESERIALIZATION_ERROR, strprintf("TX decode failed %s", error));
     }
 
@@ -1404,6 +1481,15 @@ static RPCHelpMan finalizepsbt()
     CMutableTransaction mtx;
     bool complete = FinalizeAndExtractPSBT(psbtx, mtx);
 
+    if (from_session) {
+        if (complete && extract) {
+            // The session's job is done once the final transaction is out.
+            ClosePSBTSession(request.params[0].get_str());
+        } else {
+            UpdatePSBTSession(request.params[0].get_str(), psbtx);
+        }
+    }
+
     UniValue result(UniValue::VOBJ);
     CDataStream ssTx(SER_NETWORK, PROTOCOL_VERSION);
     std::string result_str;
@@ -1546,7 +1632,7 @@ static RPCHelpMan utxoupdatepsbt()
     return RPCHelpMan{"utxoupdatepsbt",
             "\nUpdates all segwit inputs and outputs in a PSBT with data from output descriptors, the UTXO set or the mempool.\n",
             {
-                {"psbt", RPCArg::Type::STR, RPCArg::Optional::NO, "A base64 string of a PSBT"},
+                {"psbt", RPCArg::Type::STR, RPCArg::Optional::NO, "A base64 string of a PSBT, or a PSBT session id (see openpsbtsession)"},
                 {"descriptors", RPCArg::Type::ARR, RPCArg::Optional::OMITTED_NAMED_ARG, "An array of either strings or objects", {
                     {"", RPCArg::Type::STR, RPCArg::Optional::OMITTED, "An output descriptor"},
                     {"", RPCArg::Type::OBJ, RPCArg::Optional::OMITTED, "An object with an output descriptor and extra information", {
@@ -1556,7 +1642,7 @@ static RPCHelpMan utxoupdatepsbt()
                 }},
             },
             RPCResult {
-                    RPCResult::Type::STR, "", "The base64-encoded partially signed transaction with inputs updated"
+                    RPCResult::Type::STR, "", "The base64-encoded partially signed transaction with inputs updated, or the session id when operating on a session (the updated PSBT stays in the node)"
             },
             RPCExamples {
                 HelpExampleCli("utxoupdatepsbt", "\"psbt\"")
@@ -1568,7 +1654,8 @@ static RPCHelpMan utxoupdatepsbt()
     // Unserialize the transactions
     PartiallySignedTransaction psbtx;
     std::string error;
-    if (!DecodeBase64PSBT(psbtx, request.params[0].get_str(), error)) {
+    bool from_session{false};
+    if (!DecodePSBTOrSession(psbtx, request.params[0].get_str(), error, &from_session)) {
         throw JSONRPCError(RPC_DESERIALIZATION_ERROR, strprintf("TX decode failed %s", error));
     }
 
@@ -1628,6 +1715,11 @@ static RPCHelpMan utxoupdatepsbt()
         UpdatePSBTOutput(public_provider, psbtx, i);
     }
 
+    if (from_session) {
+        UpdatePSBTSession(request.params[0].get_str(), std::move(psbtx));
+        return request.params[0].get_str();
+    }
+
     CDataStream ssTx(SER_NETWORK, PROTOCOL_VERSION);
     ssTx << psbtx;
     return EncodeBase64(ssTx);
@@ -1635,6 +1727,74 @@ static RPCHelpMan utxoupdatepsbt()
     };
 }
 
+static RPCHelpMan openpsbtsession()
+{
+    return RPCHelpMan{"openpsbtsession",
+            "\nParse a PSBT once and keep it in the node as a session. PSBT-taking RPCs\n"
+            "(walletprocesspsbt, utxoupdatepsbt, finalizepsbt) accept the returned session id\n"
+            "in place of a base64 string and operate on the in-node transaction, so multi-step\n"
+            "signing flows avoid a full decode/encode round-trip per call.\n"
+            "Sessions are node-local and capped in number; the oldest is dropped when the cap is hit.\n",
+            {
+                {"psbt", RPCArg::Type::STR, RPCArg::Optional::NO, "A base64 string of a PSBT"},
+            },
+            RPCResult{
+                RPCResult::Type::OBJ, "", "",
+                {
+                    {RPCResult::Type::STR_HEX, "session_id", "The id of the new PSBT session"},
+                }
+            },
+            RPCExamples{
+                HelpExampleCli("openpsbtsession", "\"psbt\"")
+            },
+        [&](const RPCHelpMan& self, const JSONRPCRequest& request) -> UniValue
+{
+    RPCTypeCheck(request.params, {UniValue::VSTR});
+
+    PartiallySignedTransaction psbtx;
+    std::string error;
+    if (!DecodeBase64PSBT(psbtx, request.params[0].get_str(), error)) {
+        throw JSONRPCError(RPC_DESERIALIZATION_ERROR, strprintf("TX decode failed %s", error));
+    }
+
+    UniValue result(UniValue::VOBJ);
+    result.pushKV("session_id", OpenPSBTSession(std::move(psbtx)));
+    return result;
+},
+    };
+}
+
+static RPCHelpMan closepsbtsession()
+{
+    return RPCHelpMan{"closepsbtsession",
+            "\nEmit the PSBT held by a session and drop the session.\n",
+            {
+                {"session_id", RPCArg::Type::STR_HEX, RPCArg::Optional::NO, "The id returned by openpsbtsession"},
+            },
+            RPCResult{
+                RPCResult::Type::STR, "", "The base64-encoded partially signed transaction"
+            },
+            RPCExamples{
+                HelpExampleCli("closepsbtsession", "\"session_id\"")
+            },
+        [&](const RPCHelpMan& self, const JSONRPCRequest& request) -> UniValue
+{
+    RPCTypeCheck(request.params, {UniValue::VSTR});
+
+    const std::string& session_id{request.params[0].get_str()};
+    std::optional<PartiallySignedTransaction> psbtx{GetPSBTSession(session_id)};
+    if (!psbtx) {
+        throw JSONRPCError(RPC_INVALID_PARAMETER, "Unknown PSBT session id");
+    }
+    ClosePSBTSession(session_id);
+
+    CDataStream ssTx(SER_NETWORK, PROTOCOL_VERSION);
+    ssTx << *psbtx;
+    return EncodeBase64(ssTx);
+},
+    };
+}
+
 static RPCHelpMan joinpsbts()
 {
     return RPCHelpMan{"joinpsbts",
@@ -1853,6 +2013,7 @@ void RegisterRawTransactionRPCCommands(CRPCTable& t)
 {
     static const CRPCCommand commands[]{
         {"rawtransactions", &getrawtransaction},
+        {"rawtransactions", &getrawtransactions},
         {"rawtransactions", &createrawtransaction},
         {"rawtransactions", &decoderawtransaction},
         {"rawtransactions", &decodescript},
@@ -1864,6 +2025,8 @@ void RegisterRawTransactionRPCCommands(CRPCTable& t)
         {"rawtransactions", &createpsbt},
         {"rawtransactions", &converttopsbt},
         {"rawtransactions", &utxoupdatepsbt},
+        {"rawtransactions", &openpsbtsession},
+        {"rawtransactions", &closepsbtsession},
         {"rawtransactions", &joinpsbts},
         {"rawtransactions", &analyzepsbt},
     };
@@ -7,13 +7,14 @@
 #define CORAL_RPC_REQUEST_H
 
 #include <any>
+#include <functional>
 #include <string>
 
 #include <univalue.h>
 
 UniValue JSONRPCRequestObj(const std::string& strMethod, const UniValue& params, const UniValue& id);
-UniValue JSONRPCReplyObj(const UniValue& result, const UniValue& error, const UniValue& id);
-std::string JSONRPCReply(const UniValue& result, const UniValue& error, const UniValue& id);
+UniValue JSONRPCReplyObj(UniValue result, UniValue error, UniValue id);
+std::string JSONRPCReply(UniValue result, UniValue error, UniValue id);
 UniValue JSONRPCError(int code, const std::string& message);
 
 /** Generate a new RPC authentication cookie and write it to disk */
@@ -36,6 +37,13 @@ public:
     std::string authUser;
     std::string peerAddr;
     std::any context;
+    //! Set by transports that can deliver the reply asynchronously (currently
+    //! the HTTP server, for non-batch requests). A long-polling method may
+    //! invoke it from within its handler to release the worker thread: it
+    //! returns a completion callback that must later be called exactly once,
+    //! from any thread, with the result object. Once a request has been
+    //! deferred, the handler's return value is discarded.
+    std::function<std::function<void(const UniValue& result)>()> defer_reply;
 
     void parse(const UniValue& valRequest);
 };
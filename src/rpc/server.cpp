@@ -25,6 +25,28 @@ static GlobalMutex g_rpc_warmup_mutex;
 static std::atomic<bool> g_rpc_running{false};
 static bool fRPCInWarmup GUARDED_BY(g_rpc_warmup_mutex) = true;
 static std::string rpcWarmupStatus GUARDED_BY(g_rpc_warmup_mutex) = "RPC server started";
+//! Startup subsystems that have become ready, mapped to the (unix) time they
+//! did. Populated by SetRPCSubsystemReady() as initialization progresses.
+static std::map<std::string, int64_t> g_rpc_ready_subsystems GUARDED_BY(g_rpc_warmup_mutex);
+//! Read-only commands served during warmup as soon as the subsystem they
+//! depend on is ready, so health checks and sync dashboards can query the node
+//! seconds after process start instead of waiting for full initialization.
+static const std::map<std::string, std::string> EARLY_RPC_COMMANDS{
+    {"getbestblockhash", "chain"},
+    {"getblockchaininfo", "chain"},
+    {"getblockcount", "chain"},
+    {"getblockhash", "chain"},
+    {"getblockheader", "chain"},
+    {"getchaintips", "chain"},
+    {"getdifficulty", "chain"},
+    {"getconnectioncount", "network"},
+    {"getnettotals", "network"},
+    {"getnetworkinfo", "network"},
+    {"getpeerinfo", "network"},
+    {"getrpcinfo", "rpc"},
+    {"help", "rpc"},
+    {"uptime", "rpc"},
+};
 /* Timer-creating functions */
 static RPCTimerInterface* timerInterface = nullptr;
 /* Map of name to timer. */
@@ -220,6 +242,11 @@ static RPCHelpMan getrpcinfo()
                                  {RPCResult::Type::NUM, "duration", "The running time in microseconds"},
                             }},
                         }},
+                        {RPCResult::Type::BOOL, "warmup", "Whether the RPC server is still in warmup"},
+                        {RPCResult::Type::OBJ_DYN, "readiness", "Startup subsystems that are ready, mapped to the time they became so",
+                        {
+                            {RPCResult::Type::NUM_TIME, "subsystem", "The " + UNIX_EPOCH_TIME + " at which the subsystem (e.g. \"chain\", \"network\", \"wallet\") became ready"},
+                        }},
                         {RPCResult::Type::STR, "logpath", "The complete file path to the debug log"},
                     }
                 },
@@ -240,6 +267,16 @@ static RPCHelpMan getrpcinfo()
     UniValue result(UniValue::VOBJ);
     result.pushKV("active_commands", active_commands);
 
+    {
+        LOCK(g_rpc_warmup_mutex);
+        result.pushKV("warmup", fRPCInWarmup);
+        UniValue readiness(UniValue::VOBJ);
+        for (const auto& [subsystem, ready_time] : g_rpc_ready_subsystems) {
+            readiness.pushKV(subsystem, ready_time);
+        }
+        result.pushKV("readiness", readiness);
+    }
+
     const std::string path = LogInstance().m_file_path.u8string();
     UniValue log_path(UniValue::VSTR, path);
     result.pushKV("logpath", log_path);
@@ -288,6 +325,7 @@ void StartRPC()
 {
     LogPrint(BCLog::RPC, "Starting RPC\n");
     g_rpc_running = true;
+    SetRPCSubsystemReady("rpc");
     g_rpcSignals.Started();
 }
 
@@ -331,6 +369,12 @@ void SetRPCWarmupStatus(const std::string& newStatus)
     rpcWarmupStatus = newStatus;
 }
 
+void SetRPCSubsystemReady(const std::string& subsystem)
+{
+    LOCK(g_rpc_warmup_mutex);
+    g_rpc_ready_subsystems.emplace(subsystem, GetTime());
+}
+
 void SetRPCWarmupFinished()
 {
     LOCK(g_rpc_warmup_mutex);
@@ -361,7 +405,7 @@ static UniValue JSONRPCExecOne(JSONRPCRequest jreq, const UniValue& req)
         jreq.parse(req);
 
         UniValue result = tableRPC.execute(jreq);
-        rpc_result = JSONRPCReplyObj(result, NullUniValue, jreq.id);
+        rpc_result = JSONRPCReplyObj(std::move(result), NullUniValue, jreq.id);
     }
     catch (const UniValue& objError)
     {
@@ -446,11 +490,16 @@ static bool ExecuteCommands(const std::vector<const CRPCCommand*>& commands, con
 
 UniValue CRPCTable::execute(const JSONRPCRequest &request) const
 {
-    // Return immediately if in warmup
+    // Return immediately if in warmup, unless the command is read-only and
+    // the subsystem it depends on has already become ready.
     {
         LOCK(g_rpc_warmup_mutex);
-        if (fRPCInWarmup)
-            throw JSONRPCError(RPC_IN_WARMUP, rpcWarmupStatus);
+        if (fRPCInWarmup) {
+            const auto early{EARLY_RPC_COMMANDS.find(request.strMethod)};
+            if (early == EARLY_RPC_COMMANDS.end() || !g_rpc_ready_subsystems.count(early->second)) {
+                throw JSONRPCError(RPC_IN_WARMUP, rpcWarmupStatus);
+            }
+        }
     }
 
     // Find method
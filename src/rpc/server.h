@@ -37,6 +37,13 @@ void RpcInterruptionPoint();
  * immediately with RPC_IN_WARMUP.
  */
 void SetRPCWarmupStatus(const std::string& newStatus);
+/**
+ * Mark a startup subsystem (e.g. "chain", "network", "wallet") as ready.
+ * Read-only RPC commands that depend only on ready subsystems are served
+ * during warmup instead of erroring out with RPC_IN_WARMUP; getrpcinfo
+ * reports per-subsystem readiness.
+ */
+void SetRPCSubsystemReady(const std::string& subsystem);
 /* Mark warmup as done.  RPC calls will be processed from now on.  */
 void SetRPCWarmupFinished();
 
@@ -5,9 +5,12 @@
 #include <scheduler.h>
 
 #include <sync.h>
+#include <tinyformat.h>
 #include <util/syscall_sandbox.h>
+#include <util/thread.h>
 #include <util/time.h>
 
+#include <algorithm>
 #include <cassert>
 #include <functional>
 #include <utility>
@@ -32,35 +35,44 @@ void CScheduler::serviceQueue()
     // is called.
     while (!shouldStop()) {
         try {
-            while (!shouldStop() && taskQueue.empty()) {
+            if (taskQueue.empty()) {
                 // Wait until there is something to do.
                 newTaskScheduled.wait(lock);
+                continue;
             }
 
-            // Wait until either there is a new task, or until
-            // the time of the first item on the queue:
-
-            while (!shouldStop() && !taskQueue.empty()) {
-                std::chrono::steady_clock::time_point timeToWaitFor = taskQueue.begin()->first;
-                if (newTaskScheduled.wait_until(lock, timeToWaitFor) == std::cv_status::timeout) {
-                    break; // Exit loop after timeout, it means we reached the time of the event
-                }
+            // Find the earliest task whose lane is not being serviced by
+            // another thread; later tasks in a busy lane must wait so lanes
+            // stay ordered.
+            const auto it{std::find_if(taskQueue.begin(), taskQueue.end(),
+                                       [&](const auto& entry) { return m_lanes_running.count(entry.second.lane) == 0; })};
+            if (it == taskQueue.end()) {
+                // Every pending task is behind a running lane; wait for one
+                // to finish (or for new work).
+                newTaskScheduled.wait(lock);
+                continue;
             }
 
-            // If there are multiple threads, the queue can empty while we're waiting (another
-            // thread may service the task we were waiting on).
-            if (shouldStop() || taskQueue.empty())
+            if (it->first > std::chrono::steady_clock::now()) {
+                // Wait until the task is due, then re-scan: the queue and the
+                // running lanes may have changed in the meantime.
+                newTaskScheduled.wait_until(lock, it->first);
                 continue;
+            }
 
-            Function f = taskQueue.begin()->second;
-            taskQueue.erase(taskQueue.begin());
+            Task task = std::move(it->second);
+            taskQueue.erase(it);
+            m_lanes_running.insert(task.lane);
 
             {
-                // Unlock before calling f, so it can reschedule itself or another task
-                // without deadlocking:
+                // Unlock before calling the function, so it can reschedule
+                // itself or another task without deadlocking:
                 REVERSE_LOCK(lock);
-                f();
+                task.func();
             }
+
+            m_lanes_running.erase(task.lane);
+            newTaskScheduled.notify_all();
         } catch (...) {
             --nThreadsServicingQueue;
             throw;
@@ -70,11 +82,19 @@ void CScheduler::serviceQueue()
     newTaskScheduled.notify_one();
 }
 
-void CScheduler::schedule(CScheduler::Function f, std::chrono::steady_clock::time_point t)
+void CScheduler::StartServiceThreads(int num_threads)
+{
+    for (int i = 0; i < num_threads; ++i) {
+        m_service_threads.emplace_back(&util::TraceThread, i == 0 ? "scheduler" : strprintf("scheduler.%d", i),
+                                       [this] { serviceQueue(); });
+    }
+}
+
+void CScheduler::schedule(CScheduler::Function f, std::chrono::steady_clock::time_point t, SerialLane lane)
 {
     {
         LOCK(newTaskMutex);
-        taskQueue.insert(std::make_pair(t, f));
+        taskQueue.emplace(t, Task{std::move(f), lane});
     }
     newTaskScheduled.notify_one();
 }
@@ -87,7 +107,7 @@ void CScheduler::MockForward(std::chrono::seconds delta_seconds)
         LOCK(newTaskMutex);
 
         // use temp_queue to maintain updated schedule
-        std::multimap<std::chrono::steady_clock::time_point, Function> temp_queue;
+        decltype(taskQueue) temp_queue;
 
         for (const auto& element : taskQueue) {
             temp_queue.emplace_hint(temp_queue.cend(), element.first - delta_seconds, element.second);
@@ -101,15 +121,15 @@ void CScheduler::MockForward(std::chrono::seconds delta_seconds)
     newTaskScheduled.notify_one();
 }
 
-static void Repeat(CScheduler& s, CScheduler::Function f, std::chrono::milliseconds delta)
+static void Repeat(CScheduler& s, CScheduler::Function f, std::chrono::milliseconds delta, CScheduler::SerialLane lane)
 {
     f();
-    s.scheduleFromNow([=, &s] { Repeat(s, f, delta); }, delta);
+    s.scheduleFromNow([=, &s] { Repeat(s, f, delta, lane); }, delta, lane);
 }
 
-void CScheduler::scheduleEvery(CScheduler::Function f, std::chrono::milliseconds delta)
+void CScheduler::scheduleEvery(CScheduler::Function f, std::chrono::milliseconds delta, SerialLane lane)
 {
-    scheduleFromNow([this, f, delta] { Repeat(*this, f, delta); }, delta);
+    scheduleFromNow([this, f, delta, lane] { Repeat(*this, f, delta, lane); }, delta, lane);
 }
 
 size_t CScheduler::getQueueInfo(std::chrono::steady_clock::time_point& first,
@@ -9,14 +9,21 @@
 #include <sync.h>
 #include <threadsafety.h>
 
+#include <atomic>
 #include <chrono>
 #include <condition_variable>
 #include <cstddef>
+#include <cstdint>
 #include <functional>
 #include <list>
 #include <map>
+#include <set>
 #include <thread>
 #include <utility>
+#include <vector>
+
+/** Default number of threads servicing the scheduler queue. */
+static const int DEFAULT_SCHEDULER_THREADS = 2;
 
 /**
  * Simple class for background tasks that should be run
@@ -45,13 +52,31 @@ public:
 
     typedef std::function<void()> Function;
 
+    /**
+     * Tag for a serial lane. Tasks in the same lane never run concurrently and
+     * keep their relative order; tasks in different lanes may run in parallel
+     * when more than one thread services the queue. Callers schedule into
+     * LANE_DEFAULT unless they say otherwise, which keeps them fully
+     * serialized with each other as before.
+     */
+    typedef uint32_t SerialLane;
+    static constexpr SerialLane LANE_DEFAULT{0};
+
+    /** Return a fresh lane, serialized only against itself. Use for tasks
+     * that may run long (e.g. periodic flushes), so they cannot delay
+     * time-sensitive work in the default lane. */
+    SerialLane AllocateLane() { return m_next_lane.fetch_add(1, std::memory_order_relaxed); }
+
+    /** Start num_threads threads servicing the queue. */
+    void StartServiceThreads(int num_threads);
+
     /** Call func at/after time t */
-    void schedule(Function f, std::chrono::steady_clock::time_point t) EXCLUSIVE_LOCKS_REQUIRED(!newTaskMutex);
+    void schedule(Function f, std::chrono::steady_clock::time_point t, SerialLane lane = LANE_DEFAULT) EXCLUSIVE_LOCKS_REQUIRED(!newTaskMutex);
 
     /** Call f once after the delta has passed */
-    void scheduleFromNow(Function f, std::chrono::milliseconds delta) EXCLUSIVE_LOCKS_REQUIRED(!newTaskMutex)
+    void scheduleFromNow(Function f, std::chrono::milliseconds delta, SerialLane lane = LANE_DEFAULT) EXCLUSIVE_LOCKS_REQUIRED(!newTaskMutex)
     {
-        schedule(std::move(f), std::chrono::steady_clock::now() + delta);
+        schedule(std::move(f), std::chrono::steady_clock::now() + delta, lane);
     }
 
     /**
@@ -60,7 +85,7 @@ public:
      * The timing is not exact: Every time f is finished, it is rescheduled to run again after delta. If you need more
      * accurate scheduling, don't use this method.
      */
-    void scheduleEvery(Function f, std::chrono::milliseconds delta) EXCLUSIVE_LOCKS_REQUIRED(!newTaskMutex);
+    void scheduleEvery(Function f, std::chrono::milliseconds delta, SerialLane lane = LANE_DEFAULT) EXCLUSIVE_LOCKS_REQUIRED(!newTaskMutex);
 
     /**
      * Mock the scheduler to fast forward in time.
@@ -79,14 +104,14 @@ public:
     {
         WITH_LOCK(newTaskMutex, stopRequested = true);
         newTaskScheduled.notify_all();
-        if (m_service_thread.joinable()) m_service_thread.join();
+        JoinServiceThreads();
     }
     /** Tell any threads running serviceQueue to stop when there is no work left to be done */
     void StopWhenDrained() EXCLUSIVE_LOCKS_REQUIRED(!newTaskMutex)
     {
         WITH_LOCK(newTaskMutex, stopWhenEmpty = true);
         newTaskScheduled.notify_all();
-        if (m_service_thread.joinable()) m_service_thread.join();
+        JoinServiceThreads();
     }
 
     /**
@@ -101,9 +126,28 @@ public:
     bool AreThreadsServicingQueue() const EXCLUSIVE_LOCKS_REQUIRED(!newTaskMutex);
 
 private:
+    struct Task {
+        Function func;
+        SerialLane lane;
+    };
+
+    void JoinServiceThreads()
+    {
+        if (m_service_thread.joinable()) m_service_thread.join();
+        for (auto& thread : m_service_threads) {
+            if (thread.joinable()) thread.join();
+        }
+        m_service_threads.clear();
+    }
+
     mutable Mutex newTaskMutex;
     std::condition_variable newTaskScheduled;
-    std::multimap<std::chrono::steady_clock::time_point, Function> taskQueue GUARDED_BY(newTaskMutex);
+    std::multimap<std::chrono::steady_clock::time_point, Task> taskQueue GUARDED_BY(newTaskMutex);
+    //! Lanes with a task currently executing; pending tasks in these lanes
+    //! must wait for it to finish.
+    std::set<SerialLane> m_lanes_running GUARDED_BY(newTaskMutex);
+    std::vector<std::thread> m_service_threads;
+    std::atomic<SerialLane> m_next_lane{1};
     int nThreadsServicingQueue GUARDED_BY(newTaskMutex){0};
     bool stopRequested GUARDED_BY(newTaskMutex){false};
     bool stopWhenEmpty GUARDED_BY(newTaskMutex){false};
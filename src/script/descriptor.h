@@ -5,11 +5,13 @@
 #ifndef CORAL_SCRIPT_DESCRIPTOR_H
 #define CORAL_SCRIPT_DESCRIPTOR_H
 
+#include <key.h>
 #include <outputtype.h>
 #include <script/script.h>
 #include <script/sign.h>
 #include <script/signingprovider.h>
 
+#include <map>
 #include <optional>
 #include <vector>
 
@@ -78,6 +80,29 @@ public:
     DescriptorCache MergeAndDiff(const DescriptorCache& other);
 };
 
+/** Ephemeral cache of derived parent extended private keys, used to batch
+ * hardened derivation when expanding many consecutive positions.
+ *
+ * Expanding a descriptor with a hardened step derives the root xprv through
+ * the entire key path before the final derivation, so a large keypool top-up
+ * repeats the full BIP32 path derivation once per index. Callers expanding a
+ * range of positions pass one of these so the path derivation happens once
+ * per key expression, leaving a single derivation step per index.
+ *
+ * Unlike DescriptorCache this holds private key material, so it is never
+ * persisted; keep it on the stack for the duration of the batch. */
+class DescriptorExtKeyCache
+{
+    /** Map key expression index -> (parent xprv, last hardened xprv) */
+    std::map<uint32_t, std::pair<CExtKey, CExtKey>> m_parent_xprvs;
+
+public:
+    /** Cache the parent xprv (and last hardened xprv) for a key expression */
+    void CacheParentExtKey(uint32_t key_exp_pos, const CExtKey& xprv, const CExtKey& last_hardened);
+    /** Retrieve a cached parent xprv (and last hardened xprv), if present */
+    bool GetCachedParentExtKey(uint32_t key_exp_pos, CExtKey& xprv, CExtKey& last_hardened) const;
+};
+
 /** \brief Interface for parsed descriptor objects.
  *
  * Descriptors are strings that describe a set of scriptPubKeys, together with
@@ -124,8 +149,9 @@ struct Descriptor {
      * @param[out] output_scripts The expanded scriptPubKeys.
      * @param[out] out Scripts and public keys necessary for solving the expanded scriptPubKeys (may be equal to `provider`).
      * @param[out] write_cache Cache data necessary to evaluate the descriptor at this point without access to private keys.
+     * @param[in,out] xprv_cache Optional ephemeral cache of derived parent xprvs, shared across calls when expanding a range of positions.
      */
-    virtual bool Expand(int pos, const SigningProvider& provider, std::vector<CScript>& output_scripts, FlatSigningProvider& out, DescriptorCache* write_cache = nullptr) const = 0;
+    virtual bool Expand(int pos, const SigningProvider& provider, std::vector<CScript>& output_scripts, FlatSigningProvider& out, DescriptorCache* write_cache = nullptr, DescriptorExtKeyCache* xprv_cache = nullptr) const = 0;
 
     /** Expand a descriptor at a specified position using cached expansion data.
      *
@@ -10,6 +10,7 @@
 #include <crypto/sha256.h>
 #include <pubkey.h>
 #include <script/script.h>
+#include <streams.h>
 #include <uint256.h>
 
 typedef std::vector<unsigned char> valtype;
@@ -60,6 +61,35 @@ static inline void popstack(std::vector<valtype>& stack)
     stack.pop_back();
 }
 
+/** Whether `opcode` is one of the permanently disabled opcodes
+ * (CVE-2010-5137). This applies to every instruction, executed or not, so
+ * it runs once per opcode; as a switch it compiles down to a range check
+ * and bitmap test instead of a chain of fifteen comparisons.
+ */
+static constexpr bool IsOpcodeDisabled(opcodetype opcode)
+{
+    switch (opcode) {
+    case OP_CAT:
+    case OP_SUBSTR:
+    case OP_LEFT:
+    case OP_RIGHT:
+    case OP_INVERT:
+    case OP_AND:
+    case OP_OR:
+    case OP_XOR:
+    case OP_2MUL:
+    case OP_2DIV:
+    case OP_MUL:
+    case OP_DIV:
+    case OP_MOD:
+    case OP_LSHIFT:
+    case OP_RSHIFT:
+        return true;
+    default:
+        return false;
+    }
+}
+
 bool static IsCompressedOrUncompressedPubKey(const valtype &vchPubKey) {
     if (vchPubKey.size() < CPubKey::COMPRESSED_SIZE) {
         //  Non-canonical public key: too short
@@ -453,21 +483,7 @@ bool EvalScript(std::vector<std::vector<unsigned char> >& stack, const CScript&
                 }
             }
 
-            if (opcode == OP_CAT ||
-                opcode == OP_SUBSTR ||
-                opcode == OP_LEFT ||
-                opcode == OP_RIGHT ||
-                opcode == OP_INVERT ||
-                opcode == OP_AND ||
-                opcode == OP_OR ||
-                opcode == OP_XOR ||
-                opcode == OP_2MUL ||
-                opcode == OP_2DIV ||
-                opcode == OP_MUL ||
-                opcode == OP_DIV ||
-                opcode == OP_MOD ||
-                opcode == OP_LSHIFT ||
-                opcode == OP_RSHIFT)
+            if (IsOpcodeDisabled(opcode))
                 return set_error(serror, SCRIPT_ERR_DISABLED_OPCODE); // Disabled opcodes (CVE-2010-5137).
 
             // With SCRIPT_VERIFY_CONST_SCRIPTCODE, OP_CODESEPARATOR in non-segwit script is rejected even in an unexecuted branch
@@ -1437,6 +1453,11 @@ void PrecomputedTransactionData::Init(const T& txTo, std::vector<CTxOut>&& spent
         hashPrevouts = SHA256Uint256(m_prevouts_single_hash);
         hashSequence = SHA256Uint256(m_sequences_single_hash);
         hashOutputs = SHA256Uint256(m_outputs_single_hash);
+        // Every input's SIGHASH_ALL preimage starts with the same 68 bytes
+        // (nVersion || hashPrevouts || hashSequence), which covers the first
+        // SHA256 compression block. Run it once here; SignatureHash() clones
+        // the midstate per input instead of recompressing the prefix.
+        m_bip143_midstate << txTo.nVersion << hashPrevouts << hashSequence;
         m_bip143_segwit_ready = true;
     }
     if (uses_bip341_taproot) {
@@ -1444,6 +1465,17 @@ void PrecomputedTransactionData::Init(const T& txTo, std::vector<CTxOut>&& spent
         m_spent_scripts_single_hash = GetSpentScriptsSHA256(m_spent_outputs);
         m_bip341_taproot_ready = true;
     }
+
+    // Precompute the legacy SIGHASH_ALL serialization template (all
+    // scriptSigs blanked; see m_legacy_all_template). Only worthwhile when
+    // more than one input would otherwise reserialize the transaction.
+    if (txTo.vin.size() > 1) {
+        const CScript empty_script;
+        const CTransactionSignatureSerializer<T> blanked(txTo, empty_script, txTo.vin.size(), SIGHASH_ALL);
+        CVectorWriter writer{SER_GETHASH, 0, m_legacy_all_template, 0};
+        writer << blanked;
+        m_legacy_ready = true;
+    }
 }
 
 template <class T>
@@ -1592,12 +1624,20 @@ uint256 SignatureHash(const CScript& scriptCode, const T& txTo, unsigned int nIn
             hashOutputs = ss.GetHash();
         }
 
-        HashWriter ss{};
-        // Version
-        ss << txTo.nVersion;
-        // Input prevouts/nSequence (none/all, depending on flags)
-        ss << hashPrevouts;
-        ss << hashSequence;
+        // For the common SIGHASH_ALL (non-ANYONECANPAY) case the first 68
+        // preimage bytes match the precomputed midstate; clone it instead of
+        // rehashing the prefix. The midstate embeds the cached hashPrevouts
+        // and hashSequence, so it is only valid when both are in use.
+        const bool midstate_usable{cacheready && !(nHashType & SIGHASH_ANYONECANPAY) &&
+                                   (nHashType & 0x1f) != SIGHASH_SINGLE && (nHashType & 0x1f) != SIGHASH_NONE};
+        HashWriter ss{midstate_usable ? cache->m_bip143_midstate : HashWriter{}};
+        if (!midstate_usable) {
+            // Version
+            ss << txTo.nVersion;
+            // Input prevouts/nSequence (none/all, depending on flags)
+            ss << hashPrevouts;
+            ss << hashSequence;
+        }
         // The input being signed (replacing the scriptSig with scriptCode + amount)
         // The prevout may already be contained in hashPrevout, and the nSequence
         // may already be contain in hashSequence.
@@ -1626,6 +1666,22 @@ uint256 SignatureHash(const CScript& scriptCode, const T& txTo, unsigned int nIn
     // Wrapper to serialize only the necessary parts of the transaction being signed
     CTransactionSignatureSerializer<T> txTmp(txTo, scriptCode, nIn, nHashType);
 
+    // For SIGHASH_ALL without ANYONECANPAY -- the overwhelmingly common case
+    // -- everything but the input being signed serializes identically for
+    // every input, so the digest can be composed from the precomputed
+    // blanked-scriptSig template by splicing scriptCode over input nIn's
+    // single-byte blank script field.
+    if (cache && cache->m_legacy_ready && !(nHashType & SIGHASH_ANYONECANPAY) &&
+        (nHashType & 0x1f) != SIGHASH_SINGLE && (nHashType & 0x1f) != SIGHASH_NONE) {
+        const size_t script_off{GetSizeOfCompactSize(txTo.vin.size()) + 4 + size_t{nIn} * 41 + 36};
+        HashWriter ss{};
+        ss.write(MakeByteSpan(cache->m_legacy_all_template).first(script_off));
+        txTmp.SerializeScriptCode(ss);
+        ss.write(MakeByteSpan(cache->m_legacy_all_template).subspan(script_off + 1));
+        ss << nHashType;
+        return ss.GetHash();
+    }
+
     // Serialize and hash
     HashWriter ss{};
     ss << txTmp << nHashType;
@@ -162,13 +162,29 @@ struct PrecomputedTransactionData
 
     // BIP143 precomputed data (double-SHA256).
     uint256 hashPrevouts, hashSequence, hashOutputs;
-    //! Whether the 3 fields above are initialized.
+    //! SHA256 midstate after the fixed per-transaction prefix of the BIP143
+    //! preimage (nVersion || hashPrevouts || hashSequence). SignatureHash()
+    //! copies it per input for the SIGHASH_ALL (non-ANYONECANPAY) case, the
+    //! same way the tagged-hash midstates are cloned per use, saving one
+    //! compression-function call per signature.
+    HashWriter m_bip143_midstate;
+    //! Whether the 4 fields above are initialized.
     bool m_bip143_segwit_ready = false;
 
     std::vector<CTxOut> m_spent_outputs;
     //! Whether m_spent_outputs is initialized.
     bool m_spent_outputs_ready = false;
 
+    //! Serialization of the transaction as the legacy (pre-segwit)
+    //! SIGHASH_ALL scheme sees it, with every scriptSig blanked: input i's
+    //! script field is a single 0x00 byte at a computable offset.
+    //! SignatureHash() splices the real scriptCode over that byte per input
+    //! instead of reserializing the whole transaction for each one, which
+    //! would be quadratic for large consolidation transactions.
+    std::vector<unsigned char> m_legacy_all_template;
+    //! Whether m_legacy_all_template is initialized.
+    bool m_legacy_ready = false;
+
     PrecomputedTransactionData() = default;
 
     /** Initialize this PrecomputedTransactionData with transaction data.
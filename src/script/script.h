@@ -401,8 +401,18 @@ private:
  *  of vectors in cases where they normally contain a small number of small elements.
  * Tests in October 2015 showed use of this reduced dbcache memory usage by 23%
  *  and made an initial sync 13% faster.
+ *
+ * The direct (in-object) capacity is a build-time knob: e.g.
+ *  CPPFLAGS=-DCSCRIPT_PREVECTOR_SIZE=36 keeps 34-byte witness programs (P2WSH,
+ *  taproot) out of the heap, at the cost of 8 bytes per CTxOut everywhere.
+ * The PrevectorScriptSizeMix benchmark measures the configured capacity
+ *  against a representative script size distribution. The dbcache memory
+ *  accounting above was tuned with the default of 28.
  */
-typedef prevector<28, unsigned char> CScriptBase;
+#ifndef CSCRIPT_PREVECTOR_SIZE
+#define CSCRIPT_PREVECTOR_SIZE 28
+#endif
+typedef prevector<CSCRIPT_PREVECTOR_SIZE, unsigned char> CScriptBase;
 
 bool GetScriptOp(CScriptBase::const_iterator& pc, CScriptBase::const_iterator end, opcodetype& opcodeRet, std::vector<unsigned char>* pvchRet);
 
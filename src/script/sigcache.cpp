@@ -13,6 +13,7 @@
 #include <cuckoocache.h>
 
 #include <algorithm>
+#include <array>
 #include <mutex>
 #include <optional>
 #include <shared_mutex>
@@ -31,8 +32,23 @@ private:
     CSHA256 m_salted_hasher_ecdsa;
     CSHA256 m_salted_hasher_schnorr;
     typedef CuckooCache::cache<uint256, SignatureCacheHasher> map_type;
-    map_type setValid;
-    std::shared_mutex cs_sigcache;
+
+    //! Number of independently locked cache shards. Must be a power of two.
+    //! Sharding keeps parallel script-check workers from serializing on (or
+    //! bouncing the cache line of) a single lock when they all hit the cache.
+    static constexpr size_t NUM_SHARDS{16};
+    struct Shard {
+        map_type setValid;
+        std::shared_mutex cs_sigcache;
+    };
+    std::array<Shard, NUM_SHARDS> m_shards;
+
+    Shard& ShardFor(const uint256& entry)
+    {
+        // The entry is a salted hash, so any single byte selects a shard
+        // uniformly and unpredictably.
+        return m_shards[*(entry.begin() + 31) & (NUM_SHARDS - 1)];
+    }
 
 public:
     CSignatureCache()
@@ -67,18 +83,42 @@ public:
     bool
     Get(const uint256& entry, const bool erase)
     {
-        std::shared_lock<std::shared_mutex> lock(cs_sigcache);
-        return setValid.contains(entry, erase);
+        Shard& shard = ShardFor(entry);
+        std::shared_lock<std::shared_mutex> lock(shard.cs_sigcache);
+        return shard.setValid.contains(entry, erase);
     }
 
     void Set(const uint256& entry)
     {
-        std::unique_lock<std::shared_mutex> lock(cs_sigcache);
-        setValid.insert(entry);
+        Shard& shard = ShardFor(entry);
+        std::unique_lock<std::shared_mutex> lock(shard.cs_sigcache);
+        shard.setValid.insert(entry);
     }
+    CuckooCache::Stats GetStats()
+    {
+        CuckooCache::Stats ret{0, 0, 0, 0};
+        for (Shard& shard : m_shards) {
+            std::shared_lock<std::shared_mutex> lock(shard.cs_sigcache);
+            const CuckooCache::Stats shard_stats{shard.setValid.get_stats()};
+            ret.hits += shard_stats.hits;
+            ret.misses += shard_stats.misses;
+            ret.max_elements += shard_stats.max_elements;
+            ret.occupied += shard_stats.occupied;
+        }
+        return ret;
+    }
+
     std::optional<std::pair<uint32_t, size_t>> setup_bytes(size_t n)
     {
-        return setValid.setup_bytes(n);
+        uint32_t num_elems{0};
+        size_t approx_size_bytes{0};
+        for (Shard& shard : m_shards) {
+            auto setup_results = shard.setValid.setup_bytes(n / NUM_SHARDS);
+            if (!setup_results) return std::nullopt;
+            num_elems += setup_results->first;
+            approx_size_bytes += setup_results->second;
+        }
+        return std::make_pair(num_elems, approx_size_bytes);
     }
 };
 
@@ -93,17 +133,30 @@ static CSignatureCache signatureCache;
 
 // To be called once in AppInitMain/BasicTestingSetup to initialize the
 // signatureCache.
+static size_t g_signature_cache_bytes{0};
+
 bool InitSignatureCache(size_t max_size_bytes)
 {
     auto setup_results = signatureCache.setup_bytes(max_size_bytes);
     if (!setup_results) return false;
 
     const auto [num_elems, approx_size_bytes] = *setup_results;
+    g_signature_cache_bytes = approx_size_bytes;
     LogPrintf("Using %zu MiB out of %zu MiB requested for signature cache, able to store %zu elements\n",
               approx_size_bytes >> 20, max_size_bytes >> 20, num_elems);
     return true;
 }
 
+size_t SignatureCacheBytes()
+{
+    return g_signature_cache_bytes;
+}
+
+CuckooCache::Stats GetSignatureCacheStats()
+{
+    return signatureCache.GetStats();
+}
+
 bool CachingTransactionSignatureChecker::VerifyECDSASignature(const std::vector<unsigned char>& vchSig, const CPubKey& pubkey, const uint256& sighash) const
 {
     uint256 entry;
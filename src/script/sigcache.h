@@ -6,6 +6,7 @@
 #ifndef CORAL_SCRIPT_SIGCACHE_H
 #define CORAL_SCRIPT_SIGCACHE_H
 
+#include <cuckoocache.h>
 #include <script/interpreter.h>
 #include <span.h>
 #include <util/hasher.h>
@@ -34,4 +35,10 @@ public:
 
 [[nodiscard]] bool InitSignatureCache(size_t max_size_bytes);
 
+/** Aggregate occupancy and hit/miss counters across all signature cache shards. */
+CuckooCache::Stats GetSignatureCacheStats();
+
+//! Bytes actually allocated for the signature cache table.
+size_t SignatureCacheBytes();
+
 #endif // CORAL_SCRIPT_SIGCACHE_H
@@ -18,6 +18,7 @@
 #include <set>
 #include <string>
 #include <string.h>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
@@ -47,6 +48,23 @@ static const unsigned int MAX_VECTOR_ALLOCATE = 5000000;
 struct deserialize_type {};
 constexpr deserialize_type deserialize {};
 
+/**
+ * Whether a type's in-memory representation on a little-endian target is
+ * exactly its serialized form, so that whole objects (and contiguous arrays
+ * of them) can be copied with a single memcpy instead of per-field calls.
+ *
+ * This is strictly opt-in via explicit specialization. It is only correct
+ * for types that serialize every byte of their object representation in
+ * declaration order with little-endian integer encoding; specializations
+ * must be accompanied by a
+ * static_assert(std::has_unique_object_representations_v<T>) next to the
+ * type definition, so that any padding introduced by a later layout change
+ * fails to compile rather than leaking uninitialized bytes to the wire.
+ * On big-endian targets the trait is ignored and the per-field code runs.
+ */
+template <typename T>
+struct TriviallySerializable : std::false_type {};
+
 /*
  * Lowest-level serialization and conversion.
  */
@@ -691,17 +709,30 @@ template<typename Stream, typename T> void Unserialize(Stream& os, std::unique_p
 
 
 /**
- * If none of the specialized versions above matched, default to calling member function.
+ * If none of the specialized versions above matched, default to calling member function,
+ * or to a whole-object copy for trivially serializable types on little-endian targets.
  */
 template<typename Stream, typename T>
 inline void Serialize(Stream& os, const T& a)
 {
+#ifndef WORDS_BIGENDIAN
+    if constexpr (TriviallySerializable<T>::value) {
+        os.write(AsBytes(Span{&a, 1}));
+        return;
+    }
+#endif
     a.Serialize(os);
 }
 
 template<typename Stream, typename T>
 inline void Unserialize(Stream& is, T&& a)
 {
+#ifndef WORDS_BIGENDIAN
+    if constexpr (TriviallySerializable<std::remove_reference_t<T>>::value) {
+        is.read(AsWritableBytes(Span{&a, 1}));
+        return;
+    }
+#endif
     a.Unserialize(is);
 }
 
@@ -831,6 +862,16 @@ void Serialize_impl(Stream& os, const std::vector<T, A>& v, const V&)
 template<typename Stream, typename T, typename A>
 inline void Serialize(Stream& os, const std::vector<T, A>& v)
 {
+#ifndef WORDS_BIGENDIAN
+    if constexpr (TriviallySerializable<T>::value) {
+        // Element bytes match their serialized form, so the whole vector can
+        // go out as one opaque blob, like vectors of unsigned char.
+        WriteCompactSize(os, v.size());
+        if (!v.empty())
+            os.write(MakeByteSpan(v));
+        return;
+    }
+#endif
     Serialize_impl(os, v, T());
 }
 
@@ -860,6 +901,22 @@ void Unserialize_impl(Stream& is, std::vector<T, A>& v, const V&)
 template<typename Stream, typename T, typename A>
 inline void Unserialize(Stream& is, std::vector<T, A>& v)
 {
+#ifndef WORDS_BIGENDIAN
+    if constexpr (TriviallySerializable<T>::value) {
+        // Limit size per read so bogus size value won't cause out of memory
+        v.clear();
+        unsigned int nSize = ReadCompactSize(is);
+        unsigned int i = 0;
+        while (i < nSize)
+        {
+            unsigned int blk = std::min(nSize - i, (unsigned int)(1 + 4999999 / sizeof(T)));
+            v.resize(i + blk);
+            is.read(AsWritableBytes(Span{&v[i], blk}));
+            i += blk;
+        }
+        return;
+    }
+#endif
     Unserialize_impl(is, v, T());
 }
 
@@ -1007,9 +1064,11 @@ class CSizeComputer
 protected:
     size_t nSize;
 
+    const int nType;
     const int nVersion;
 public:
-    explicit CSizeComputer(int nVersionIn) : nSize(0), nVersion(nVersionIn) {}
+    explicit CSizeComputer(int nVersionIn) : nSize(0), nType(0), nVersion(nVersionIn) {}
+    CSizeComputer(int nTypeIn, int nVersionIn) : nSize(0), nType(nTypeIn), nVersion(nVersionIn) {}
 
     void write(Span<const std::byte> src)
     {
@@ -1033,6 +1092,7 @@ public:
         return nSize;
     }
 
+    int GetType() const { return nType; }
     int GetVersion() const { return nVersion; }
 };
 
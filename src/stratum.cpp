@@ -0,0 +1,451 @@
+// Copyright (c) 2023 The Coral Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <stratum.h>
+
+#include <arith_uint256.h>
+#include <chain.h>
+#include <chainparamsbase.h>
+#include <consensus/merkle.h>
+#include <core_io.h>
+#include <key_io.h>
+#include <logging.h>
+#include <netbase.h>
+#include <node/context.h>
+#include <node/miner.h>
+#include <primitives/block.h>
+#include <script/standard.h>
+#include <streams.h>
+#include <sync.h>
+#include <txmempool.h>
+#include <univalue.h>
+#include <util/strencodings.h>
+#include <util/system.h>
+#include <util/thread.h>
+#include <util/time.h>
+#include <validation.h>
+#include <validationinterface.h>
+#include <version.h>
+
+#include <cstdlib>
+#include <map>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <event2/buffer.h>
+#include <event2/bufferevent.h>
+#include <event2/event.h>
+#include <event2/listener.h>
+#include <event2/thread.h>
+#include <event2/util.h>
+
+/** Maximum length of a single protocol line from a miner. */
+static const size_t MAX_STRATUM_LINE_LENGTH = 16 * 1024;
+/** Rebuild the shared template after this long even without a tip change,
+ *  so new mempool transactions make it into handed-out work. */
+static const int64_t STRATUM_TEMPLATE_REFRESH_INTERVAL = 30;
+/** Cap on outstanding header->block entries; old entries are evicted. */
+static const size_t MAX_STRATUM_OUTSTANDING_WORK = 4096;
+
+namespace {
+
+struct StratumClient {
+    bufferevent* bev{nullptr};
+    std::string peer;
+    CScript payout_script;
+    bool authorized{false};
+};
+
+struct StratumServer {
+    Mutex mutex;
+    event_base* base{nullptr};
+    std::vector<evconnlistener*> listeners;
+    std::thread thread;
+    node::NodeContext* node{nullptr};
+
+    std::map<bufferevent*, StratumClient> clients GUARDED_BY(mutex);
+
+    //! Shared template; per-client work differs only in the coinbase.
+    std::unique_ptr<node::CBlockTemplate> block_template GUARDED_BY(mutex);
+    uint256 template_prev GUARDED_BY(mutex);
+    int64_t template_time GUARDED_BY(mutex){0};
+    unsigned int extra_nonce GUARDED_BY(mutex){0};
+    //! Blocks for handed-out headers, keyed by merkle root.
+    std::map<uint256, std::shared_ptr<const CBlock>> work GUARDED_BY(mutex);
+};
+
+StratumServer g_stratum;
+
+} // namespace
+
+static void StratumSendLine(bufferevent* bev, const std::string& line)
+{
+    bufferevent_write(bev, line.data(), line.size());
+    bufferevent_write(bev, "\n", 1);
+}
+
+static void StratumReplyResult(bufferevent* bev, const UniValue& id, const UniValue& result)
+{
+    UniValue reply(UniValue::VOBJ);
+    reply.pushKV("id", id);
+    reply.pushKV("result", result);
+    reply.pushKV("error", NullUniValue);
+    StratumSendLine(bev, reply.write());
+}
+
+static void StratumReplyError(bufferevent* bev, const UniValue& id, const std::string& message)
+{
+    UniValue reply(UniValue::VOBJ);
+    reply.pushKV("id", id);
+    reply.pushKV("result", NullUniValue);
+    reply.pushKV("error", message);
+    StratumSendLine(bev, reply.write());
+}
+
+/** Refresh the shared block template if the tip moved or it grew stale.
+ *  Returns the current tip, or nullptr if no template could be built. */
+static const CBlockIndex* StratumEnsureTemplate() EXCLUSIVE_LOCKS_REQUIRED(g_stratum.mutex)
+{
+    ChainstateManager& chainman = *Assert(g_stratum.node->chainman);
+    const CBlockIndex* tip{WITH_LOCK(::cs_main, return chainman.ActiveChain().Tip())};
+    if (!tip) return nullptr;
+
+    const int64_t now{GetTime()};
+    if (!g_stratum.block_template || g_stratum.template_prev != tip->GetBlockHash() ||
+        now - g_stratum.template_time > STRATUM_TEMPLATE_REFRESH_INTERVAL) {
+        // The coinbase payout script is rewritten per client, so any script
+        // will do for the shared template.
+        auto tmpl{node::BlockAssembler(chainman.ActiveChainstate(), g_stratum.node->mempool.get())
+                      .CreateNewBlock(CScript() << OP_TRUE)};
+        if (!tmpl) return nullptr;
+        if (g_stratum.template_prev != tip->GetBlockHash()) {
+            // Work on the old tip can no longer be submitted.
+            g_stratum.work.clear();
+        }
+        g_stratum.block_template = std::move(tmpl);
+        g_stratum.template_prev = tip->GetBlockHash();
+        g_stratum.template_time = now;
+    }
+    return tip;
+}
+
+/** Build a work block for the client: the shared template with the coinbase
+ *  paying the client and carrying a fresh extra nonce. */
+static std::shared_ptr<const CBlock> StratumMakeWork(const StratumClient& client, int& height)
+    EXCLUSIVE_LOCKS_REQUIRED(g_stratum.mutex)
+{
+    const CBlockIndex* tip{StratumEnsureTemplate()};
+    if (!tip) return nullptr;
+    height = tip->nHeight + 1;
+
+    auto block{std::make_shared<CBlock>(g_stratum.block_template->block)};
+    CMutableTransaction coinbase(*block->vtx[0]);
+    coinbase.vout[0].scriptPubKey = client.payout_script;
+    coinbase.vin[0].scriptSig = CScript() << height << CScriptNum(++g_stratum.extra_nonce);
+    block->vtx[0] = MakeTransactionRef(std::move(coinbase));
+    block->hashMerkleRoot = BlockMerkleRoot(*block);
+
+    while (g_stratum.work.size() >= MAX_STRATUM_OUTSTANDING_WORK) {
+        g_stratum.work.erase(g_stratum.work.begin());
+    }
+    g_stratum.work.emplace(block->hashMerkleRoot, block);
+    return block;
+}
+
+static void StratumPushWork(StratumClient& client, bool clean) EXCLUSIVE_LOCKS_REQUIRED(g_stratum.mutex)
+{
+    int height{0};
+    const auto block{StratumMakeWork(client, height)};
+    if (!block) return;
+
+    CDataStream ss(SER_NETWORK, PROTOCOL_VERSION);
+    ss << block->GetBlockHeader();
+
+    UniValue params(UniValue::VOBJ);
+    params.pushKV("header", HexStr(ss));
+    params.pushKV("target", arith_uint256().SetCompact(block->nBits).GetHex());
+    params.pushKV("height", height);
+    params.pushKV("clean", clean);
+
+    UniValue notify(UniValue::VOBJ);
+    notify.pushKV("id", NullUniValue);
+    notify.pushKV("method", "mining.notify");
+    notify.pushKV("params", params);
+    StratumSendLine(client.bev, notify.write());
+}
+
+static void StratumHandleSubmit(bufferevent* bev, const UniValue& id, const std::string& header_hex)
+{
+    CBlockHeader header;
+    if (!DecodeHexBlockHeader(header, header_hex)) {
+        StratumReplyError(bev, id, "Block header decode failed");
+        return;
+    }
+
+    std::shared_ptr<CBlock> blockptr;
+    {
+        LOCK(g_stratum.mutex);
+        const auto it{g_stratum.work.find(header.hashMerkleRoot)};
+        if (it == g_stratum.work.end()) {
+            StratumReplyError(bev, id, "stale-work");
+            return;
+        }
+        blockptr = std::make_shared<CBlock>(*it->second);
+    }
+    // The miner may have rolled nTime along with the nonce.
+    blockptr->nVersion = header.nVersion;
+    blockptr->nTime = header.nTime;
+    blockptr->nNonce = header.nNonce;
+
+    bool new_block{false};
+    const bool accepted{Assert(g_stratum.node->chainman)
+                            ->ProcessNewBlock(blockptr, /*force_processing=*/true, /*min_pow_checked=*/true, &new_block)};
+    if (accepted && new_block) {
+        LogPrintf("Stratum: accepted block %s\n", blockptr->GetHash().ToString());
+        StratumReplyResult(bev, id, true);
+    } else if (accepted) {
+        StratumReplyError(bev, id, "duplicate");
+    } else {
+        StratumReplyError(bev, id, "rejected");
+    }
+}
+
+static void StratumHandleLine(bufferevent* bev, const std::string& line)
+{
+    UniValue request;
+    if (!request.read(line) || !request.isObject()) {
+        StratumReplyError(bev, NullUniValue, "Parse error");
+        return;
+    }
+    const UniValue& id{find_value(request, "id")};
+    const UniValue& method{find_value(request, "method")};
+    const UniValue& params{find_value(request, "params")};
+    if (!method.isStr()) {
+        StratumReplyError(bev, id, "Missing method");
+        return;
+    }
+
+    if (method.get_str() == "mining.subscribe") {
+        StratumReplyResult(bev, id, true);
+    } else if (method.get_str() == "mining.authorize") {
+        if (!params.isArray() || params.size() < 1 || !params[0].isStr()) {
+            StratumReplyError(bev, id, "Missing payout address");
+            return;
+        }
+        const CTxDestination destination{DecodeDestination(params[0].get_str())};
+        if (!IsValidDestination(destination)) {
+            StratumReplyError(bev, id, "Invalid payout address");
+            return;
+        }
+        LOCK(g_stratum.mutex);
+        auto it{g_stratum.clients.find(bev)};
+        if (it == g_stratum.clients.end()) return;
+        it->second.payout_script = GetScriptForDestination(destination);
+        it->second.authorized = true;
+        StratumReplyResult(bev, id, true);
+        StratumPushWork(it->second, /*clean=*/true);
+    } else if (method.get_str() == "mining.submit") {
+        if (!params.isArray() || params.size() < 1 || !params[0].isStr()) {
+            StratumReplyError(bev, id, "Missing header");
+            return;
+        }
+        StratumHandleSubmit(bev, id, params[0].get_str());
+    } else {
+        StratumReplyError(bev, id, "Unknown method");
+    }
+}
+
+static void StratumCloseClient(bufferevent* bev) EXCLUSIVE_LOCKS_REQUIRED(g_stratum.mutex)
+{
+    g_stratum.clients.erase(bev);
+    bufferevent_free(bev);
+}
+
+static void stratum_read_cb(bufferevent* bev, void*)
+{
+    evbuffer* input{bufferevent_get_input(bev)};
+    for (;;) {
+        size_t len{0};
+        char* line{evbuffer_readln(input, &len, EVBUFFER_EOL_ANY)};
+        if (!line) break;
+        if (len > 0) StratumHandleLine(bev, std::string(line, len));
+        free(line);
+    }
+    if (evbuffer_get_length(input) > MAX_STRATUM_LINE_LENGTH) {
+        LOCK(g_stratum.mutex);
+        const auto it{g_stratum.clients.find(bev)};
+        LogPrint(BCLog::NET, "Stratum: dropping %s (oversized line)\n",
+                 it != g_stratum.clients.end() ? it->second.peer : "?");
+        StratumCloseClient(bev);
+    }
+}
+
+static void stratum_event_cb(bufferevent* bev, short events, void*)
+{
+    if (events & (BEV_EVENT_EOF | BEV_EVENT_ERROR)) {
+        LOCK(g_stratum.mutex);
+        StratumCloseClient(bev);
+    }
+}
+
+static void stratum_accept_cb(evconnlistener* listener, evutil_socket_t fd, sockaddr* addr, int addrlen, void*)
+{
+    bufferevent* bev{bufferevent_socket_new(evconnlistener_get_base(listener), fd,
+                                            BEV_OPT_CLOSE_ON_FREE | BEV_OPT_THREADSAFE)};
+    if (!bev) {
+        evutil_closesocket(fd);
+        return;
+    }
+    StratumClient client;
+    client.bev = bev;
+    CService service;
+    if (service.SetSockAddr(addr)) client.peer = service.ToString();
+    LogPrint(BCLog::NET, "Stratum: connection from %s\n", client.peer);
+
+    LOCK(g_stratum.mutex);
+    g_stratum.clients.emplace(bev, std::move(client));
+    bufferevent_setcb(bev, stratum_read_cb, nullptr, stratum_event_cb, nullptr);
+    bufferevent_enable(bev, EV_READ | EV_WRITE);
+}
+
+namespace {
+/** Pushes fresh work to every authorized miner as soon as the tip moves,
+ *  replacing any polling pipeline. Runs on the scheduler thread; the
+ *  bufferevents are thread-safe and shared state is locked. */
+class StratumNotifier final : public CValidationInterface
+{
+protected:
+    void UpdatedBlockTip(const CBlockIndex* pindexNew, const CBlockIndex* pindexFork, bool fInitialDownload) override
+    {
+        if (fInitialDownload) return;
+        LOCK(g_stratum.mutex);
+        if (!g_stratum.base) return;
+        // Force a rebuild against the new tip before notifying.
+        g_stratum.block_template.reset();
+        for (auto& [bev, client] : g_stratum.clients) {
+            if (client.authorized) StratumPushWork(client, /*clean=*/true);
+        }
+    }
+};
+
+std::unique_ptr<StratumNotifier> g_stratum_notifier;
+} // namespace
+
+static bool StratumBindAddresses(event_base* base) EXCLUSIVE_LOCKS_REQUIRED(g_stratum.mutex)
+{
+    const uint16_t default_port{static_cast<uint16_t>(gArgs.GetIntArg("-stratumport", DEFAULT_STRATUM_PORT))};
+    std::vector<std::string> binds{gArgs.GetArgs("-stratumbind")};
+    if (binds.empty()) {
+        // Default to loopback: stratum performs no authentication.
+        binds.push_back("127.0.0.1");
+        binds.push_back("[::1]");
+    }
+
+    for (const std::string& strBind : binds) {
+        CService service;
+        if (!Lookup(strBind, service, default_port, /*fAllowLookup=*/false)) {
+            LogPrintf("Stratum: invalid bind address %s\n", strBind);
+            return false;
+        }
+        sockaddr_storage storage;
+        socklen_t len{sizeof(storage)};
+        if (!service.GetSockAddr(reinterpret_cast<sockaddr*>(&storage), &len)) {
+            LogPrintf("Stratum: cannot resolve bind address %s\n", strBind);
+            return false;
+        }
+        evconnlistener* listener{evconnlistener_new_bind(base, stratum_accept_cb, nullptr,
+                                                         LEV_OPT_CLOSE_ON_FREE | LEV_OPT_REUSEABLE, -1,
+                                                         reinterpret_cast<sockaddr*>(&storage), len)};
+        if (!listener) {
+            LogPrintf("Stratum: binding on %s failed\n", service.ToString());
+            continue;
+        }
+        LogPrintf("Stratum: listening on %s\n", service.ToString());
+        g_stratum.listeners.push_back(listener);
+    }
+    return !g_stratum.listeners.empty();
+}
+
+static void ThreadStratum(event_base* base)
+{
+    LogPrint(BCLog::NET, "Entering stratum event loop\n");
+    event_base_dispatch(base);
+    LogPrint(BCLog::NET, "Exited stratum event loop\n");
+}
+
+bool StartStratumServer(node::NodeContext& node)
+{
+    if (!gArgs.IsArgSet("-stratumbind") && !gArgs.IsArgSet("-stratumport")) {
+        return true;
+    }
+
+#ifdef WIN32
+    evthread_use_windows_threads();
+#else
+    evthread_use_pthreads();
+#endif
+
+    event_base* base{event_base_new()};
+    if (!base) {
+        LogPrintf("Stratum: couldn't create an event_base\n");
+        return false;
+    }
+
+    {
+        LOCK(g_stratum.mutex);
+        g_stratum.node = &node;
+        g_stratum.base = base;
+        if (!StratumBindAddresses(base)) {
+            LogPrintf("Stratum: unable to bind any endpoint\n");
+            g_stratum.base = nullptr;
+            event_base_free(base);
+            return false;
+        }
+    }
+
+    g_stratum.thread = std::thread(&util::TraceThread, "stratum", [base] { ThreadStratum(base); });
+
+    g_stratum_notifier = std::make_unique<StratumNotifier>();
+    // High priority: miners should switch work before slower bookkeeping
+    // subscribers handle the tip change.
+    RegisterValidationInterface(g_stratum_notifier.get(), ValidationInterfacePriority::HIGH);
+    return true;
+}
+
+void InterruptStratumServer()
+{
+    LOCK(g_stratum.mutex);
+    for (evconnlistener* listener : g_stratum.listeners) {
+        evconnlistener_disable(listener);
+    }
+}
+
+void StopStratumServer()
+{
+    if (g_stratum_notifier) {
+        UnregisterValidationInterface(g_stratum_notifier.get());
+        g_stratum_notifier.reset();
+    }
+    event_base* base{WITH_LOCK(g_stratum.mutex, return g_stratum.base)};
+    if (!base) return;
+
+    event_base_loopbreak(base);
+    if (g_stratum.thread.joinable()) g_stratum.thread.join();
+
+    LOCK(g_stratum.mutex);
+    for (evconnlistener* listener : g_stratum.listeners) {
+        evconnlistener_free(listener);
+    }
+    g_stratum.listeners.clear();
+    for (auto& [bev, client] : g_stratum.clients) {
+        bufferevent_free(bev);
+    }
+    g_stratum.clients.clear();
+    g_stratum.work.clear();
+    g_stratum.block_template.reset();
+    g_stratum.base = nullptr;
+    event_base_free(base);
+}
@@ -0,0 +1,43 @@
+// Copyright (c) 2023 The Coral Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef CORAL_STRATUM_H
+#define CORAL_STRATUM_H
+
+#include <cstdint>
+
+namespace node {
+struct NodeContext;
+} // namespace node
+
+static const uint16_t DEFAULT_STRATUM_PORT = 3333;
+
+/** Start the stratum work server if -stratumbind or -stratumport is
+ * configured. Returns false on a configuration or bind error, true
+ * otherwise (including when the server is simply not enabled).
+ *
+ * The server speaks a stratum-like newline-delimited JSON-RPC protocol
+ * tailored to RandomX, which hashes only the 80-byte block header:
+ *
+ *   {"id":1,"method":"mining.subscribe","params":["useragent"]}
+ *   {"id":2,"method":"mining.authorize","params":["payout address"]}
+ *   {"id":3,"method":"mining.submit","params":["solved header hex"]}
+ *
+ * After authorization the server pushes work to the client, and again
+ * from the UpdatedBlockTip validation callback whenever the chain tip
+ * changes, as:
+ *
+ *   {"id":null,"method":"mining.notify",
+ *    "params":{"header":hex,"target":hex,"height":n,"clean":bool}}
+ *
+ * The node keeps the full block for every header it hands out, so a
+ * miner only ever exchanges headers with the node.
+ */
+bool StartStratumServer(node::NodeContext& node);
+/** Stop accepting new stratum connections. */
+void InterruptStratumServer();
+/** Disconnect all miners and stop the stratum server. */
+void StopStratumServer();
+
+#endif // CORAL_STRATUM_H
@@ -226,6 +226,16 @@ public:
         return std::string{UCharCast(data()), UCharCast(data() + size())};
     }
 
+    //! Move the unread bytes out of the stream, leaving it empty.
+    vector_type release()
+    {
+        vch.erase(vch.begin(), vch.begin() + m_read_pos);
+        m_read_pos = 0;
+        vector_type ret{std::move(vch)};
+        clear();
+        return ret;
+    }
+
 
     //
     // Vector subset
@@ -351,13 +361,36 @@ public:
             return;
         }
 
-        for (size_type i = 0, j = 0; i != size(); i++) {
-            vch[i] ^= std::byte{key[j++]};
+        size_type i{0};
+
+        // This potentially acts on very many bytes of data (every value
+        // flushed through an obfuscated CDBWrapper goes through here), so
+        // process a 64-bit word per iteration whenever the repeating key
+        // pattern fits one exactly; the obfuscation key is 8 bytes in
+        // practice (see CDBWrapper). Compilers widen this loop to SSE2/NEON
+        // on their own, so no runtime dispatch is needed. memcpy is used for
+        // the unaligned accesses; it compiles to plain loads and stores.
+        if (8 % key.size() == 0) {
+            unsigned char pattern[8];
+            for (size_type k = 0; k < 8; ++k) {
+                pattern[k] = key[k % key.size()];
+            }
+            uint64_t key64;
+            memcpy(&key64, pattern, 8);
+            for (; i + 8 <= size(); i += 8) {
+                uint64_t word;
+                memcpy(&word, vch.data() + i, 8);
+                word ^= key64;
+                memcpy(vch.data() + i, &word, 8);
+            }
+        }
 
-            // This potentially acts on very many bytes of data, so it's
-            // important that we calculate `j`, i.e. the `key` index in this
-            // way instead of doing a %, which would effectively be a division
-            // for each byte Xor'd -- much slower than need be.
+        // Tail (and keys whose length does not divide 8) byte by byte. The
+        // key index `j` is maintained by comparison instead of a %, which
+        // would effectively be a division for each byte Xor'd -- much slower
+        // than need be.
+        for (size_type j = i % key.size(); i != size(); i++) {
+            vch[i] ^= std::byte{key[j++]};
             if (j == key.size())
                 j = 0;
         }
@@ -413,9 +446,11 @@ class BitStreamWriter
 private:
     OStream& m_ostream;
 
-    /// Buffered byte waiting to be written to the output stream. The byte is
-    /// written buffer when m_offset reaches 8 or Flush() is called.
-    uint8_t m_buffer{0};
+    /// Buffered bits waiting to be written to the output stream. The word is
+    /// written out when m_offset reaches 64 or Flush() is called, so encoders
+    /// that emit a few bits at a time (e.g. Golomb-Rice) touch the stream
+    /// once per 64 bits instead of once per byte.
+    uint64_t m_buffer{0};
 
     /// Number of high order bits in m_buffer already written by previous
     /// Write() calls and not yet flushed to the stream. The next bit to be
@@ -431,7 +466,7 @@ public:
     }
 
     /** Write the nbits least significant bits of a 64-bit int to the output
-     * stream. Data is buffered until it completes an octet.
+     * stream. Data is buffered until it completes a 64-bit word.
      */
     void Write(uint64_t data, int nbits) {
         if (nbits < 0 || nbits > 64) {
@@ -439,12 +474,12 @@ public:
         }
 
         while (nbits > 0) {
-            int bits = std::min(8 - m_offset, nbits);
-            m_buffer |= (data << (64 - nbits)) >> (64 - 8 + m_offset);
+            int bits = std::min(64 - m_offset, nbits);
+            m_buffer |= (data << (64 - nbits)) >> m_offset;
             m_offset += bits;
             nbits -= bits;
 
-            if (m_offset == 8) {
+            if (m_offset == 64) {
                 Flush();
             }
         }
@@ -458,7 +493,12 @@ public:
             return;
         }
 
-        m_ostream << m_buffer;
+        uint8_t bytes[8];
+        const int nbytes = (m_offset + 7) / 8;
+        for (int i = 0; i < nbytes; ++i) {
+            bytes[i] = m_buffer >> (56 - 8 * i);
+        }
+        m_ostream.write(AsBytes(Span{bytes, static_cast<size_t>(nbytes)}));
         m_buffer = 0;
         m_offset = 0;
     }
@@ -0,0 +1,103 @@
+// Copyright (c) 2022 The Coral Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef CORAL_SUPPORT_ALLOCATORS_BUMP_ARENA_H
+#define CORAL_SUPPORT_ALLOCATORS_BUMP_ARENA_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/**
+ * A chunked bump allocator. Allocations advance a pointer through
+ * fixed-size chunks; individual deallocations are no-ops and all memory is
+ * returned at once when the arena is destroyed.
+ *
+ * Intended for groups of small objects with a common lifetime, such as the
+ * transactions of a deserialized block: allocation is a pointer bump instead
+ * of a malloc per object, and teardown frees whole chunks instead of
+ * thousands of individual objects.
+ *
+ * Not thread-safe: allocate from one thread at a time. Note that any
+ * surviving reference into the arena (via bump_arena_allocator below) keeps
+ * every chunk alive, so do not use it for objects that may be retained long
+ * after the rest of the group is gone.
+ */
+class BumpArena
+{
+private:
+    const size_t m_chunk_size;
+    std::vector<std::unique_ptr<std::byte[]>> m_chunks;
+    //! Chunk currently being bump-filled (never an oversized chunk).
+    std::byte* m_current{nullptr};
+    //! Bytes used in m_current.
+    size_t m_used{0};
+
+public:
+    explicit BumpArena(size_t chunk_size = 256 * 1024) : m_chunk_size{chunk_size} {}
+
+    BumpArena(const BumpArena&) = delete;
+    BumpArena& operator=(const BumpArena&) = delete;
+
+    void* Allocate(size_t bytes, size_t align)
+    {
+        // Oversized requests get their own chunk rather than growing all of
+        // them; the current bump chunk keeps filling up afterwards.
+        if (bytes + align > m_chunk_size) {
+            m_chunks.emplace_back(new std::byte[bytes + align]);
+            return AlignUp(m_chunks.back().get(), align);
+        }
+        size_t aligned_used{m_current ? AlignUp(m_used, align) : 0};
+        if (!m_current || aligned_used + bytes > m_chunk_size) {
+            m_chunks.emplace_back(new std::byte[m_chunk_size]);
+            m_current = m_chunks.back().get();
+            aligned_used = 0;
+        }
+        void* ret{m_current + aligned_used};
+        m_used = aligned_used + bytes;
+        return ret;
+    }
+
+private:
+    static size_t AlignUp(size_t n, size_t align) { return (n + align - 1) & ~(align - 1); }
+
+    static void* AlignUp(std::byte* p, size_t align)
+    {
+        return reinterpret_cast<void*>((reinterpret_cast<uintptr_t>(p) + align - 1) & ~(uintptr_t{align} - 1));
+    }
+};
+
+/**
+ * Minimal allocator handing out memory from a shared BumpArena. deallocate()
+ * is a no-op; the arena (and with it all allocations) is freed once the last
+ * copy of the allocator lets go of it, e.g. when the last std::shared_ptr
+ * created through std::allocate_shared with this allocator is released.
+ */
+template <typename T>
+class bump_arena_allocator
+{
+private:
+    std::shared_ptr<BumpArena> m_arena;
+
+    template <typename U>
+    friend class bump_arena_allocator;
+
+public:
+    using value_type = T;
+
+    explicit bump_arena_allocator(std::shared_ptr<BumpArena> arena) noexcept : m_arena{std::move(arena)} {}
+    template <typename U>
+    bump_arena_allocator(const bump_arena_allocator<U>& other) noexcept : m_arena{other.m_arena} {}
+
+    T* allocate(size_t n) { return static_cast<T*>(m_arena->Allocate(n * sizeof(T), alignof(T))); }
+    void deallocate(T*, size_t) noexcept {}
+
+    template <typename U>
+    bool operator==(const bump_arena_allocator<U>& other) const noexcept { return m_arena == other.m_arena; }
+    template <typename U>
+    bool operator!=(const bump_arena_allocator<U>& other) const noexcept { return !(*this == other); }
+};
+
+#endif // CORAL_SUPPORT_ALLOCATORS_BUMP_ARENA_H
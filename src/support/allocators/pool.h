@@ -0,0 +1,208 @@
+// Copyright (c) 2022 The Coral Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef CORAL_SUPPORT_ALLOCATORS_POOL_H
+#define CORAL_SUPPORT_ALLOCATORS_POOL_H
+
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+ * A memory resource for same-sized allocations from node-based containers.
+ * Blocks of at most MAX_BLOCK_SIZE_BYTES are carved out of large contiguous
+ * chunks and recycled through per-size free lists, so container nodes end up
+ * densely packed in allocation order instead of scattered across the heap by
+ * a general-purpose allocator; anything larger (e.g. a hash map's bucket
+ * array) falls through to ::operator new.
+ *
+ * Unlike BumpArena, freed blocks are reused, so the resource also suits
+ * long-lived containers that occasionally erase or rehash. All chunks are
+ * released when the resource is destroyed; every container using it must be
+ * destroyed first.
+ *
+ * Not thread-safe: the containers on top of it must be externally
+ * synchronized, as they already are for their own structure.
+ */
+template <std::size_t MAX_BLOCK_SIZE_BYTES, std::size_t ALIGN_BYTES>
+class PoolResource final
+{
+    static_assert((ALIGN_BYTES & (ALIGN_BYTES - 1)) == 0, "ALIGN_BYTES must be a power of two");
+    static_assert(ALIGN_BYTES >= sizeof(void*), "free list nodes must fit into a block");
+    static_assert(ALIGN_BYTES <= alignof(std::max_align_t), "chunks are only max_align_t aligned");
+    static_assert((MAX_BLOCK_SIZE_BYTES % ALIGN_BYTES) == 0, "MAX_BLOCK_SIZE_BYTES must be a multiple of ALIGN_BYTES");
+
+    //! An in-place singly linked list node threaded through freed blocks.
+    struct ListNode {
+        ListNode* m_next;
+        explicit ListNode(ListNode* next) : m_next{next} {}
+    };
+
+    //! One free list per block size (a multiple of ALIGN_BYTES); index 0 is unused.
+    static constexpr std::size_t NUM_FREE_LISTS{MAX_BLOCK_SIZE_BYTES / ALIGN_BYTES + 1};
+
+    const std::size_t m_chunk_size_bytes;
+
+    //! Heads of the per-size free lists.
+    std::array<ListNode*, NUM_FREE_LISTS> m_free_lists{};
+
+    //! All chunks allocated so far, freed on destruction.
+    std::vector<std::byte*> m_chunks{};
+
+    //! Bounds of the not yet handed out tail of the newest chunk.
+    std::byte* m_unused_begin{nullptr};
+    std::byte* m_unused_end{nullptr};
+
+    //! Bytes currently allocated outside the pool (e.g. a map's bucket
+    //! array), so AllocatedBytes() reflects everything the resource's
+    //! containers hold.
+    std::size_t m_fallback_bytes{0};
+
+    //! Whether an allocation request is served from the pool.
+    [[nodiscard]] static constexpr bool UsesPool(std::size_t bytes, std::size_t alignment)
+    {
+        return bytes > 0 && bytes <= MAX_BLOCK_SIZE_BYTES && alignment <= ALIGN_BYTES;
+    }
+
+    //! Free list index for a pooled request; the block size it describes is
+    //! the request rounded up to a multiple of ALIGN_BYTES.
+    [[nodiscard]] static constexpr std::size_t SizeClass(std::size_t bytes)
+    {
+        return (bytes + ALIGN_BYTES - 1) / ALIGN_BYTES;
+    }
+
+public:
+    explicit PoolResource(std::size_t chunk_size_bytes = 262144) : m_chunk_size_bytes{chunk_size_bytes}
+    {
+        assert(m_chunk_size_bytes >= MAX_BLOCK_SIZE_BYTES);
+    }
+
+    PoolResource(const PoolResource&) = delete;
+    PoolResource& operator=(const PoolResource&) = delete;
+
+    ~PoolResource()
+    {
+        for (std::byte* chunk : m_chunks) {
+            delete[] chunk;
+        }
+    }
+
+    void* Allocate(std::size_t bytes, std::size_t alignment)
+    {
+        if (UsesPool(bytes, alignment)) {
+            const std::size_t list{SizeClass(bytes)};
+            if (m_free_lists[list] != nullptr) {
+                ListNode* node{m_free_lists[list]};
+                m_free_lists[list] = node->m_next;
+                node->~ListNode();
+                return node;
+            }
+            const std::size_t block_bytes{list * ALIGN_BYTES};
+            if (static_cast<std::size_t>(m_unused_end - m_unused_begin) < block_bytes) {
+                // Thread any unusable remainder of the current chunk onto the
+                // free list matching its size before starting a new chunk.
+                const std::size_t remainder{static_cast<std::size_t>(m_unused_end - m_unused_begin)};
+                if (remainder > 0) {
+                    m_free_lists[remainder / ALIGN_BYTES] = new (m_unused_begin) ListNode{m_free_lists[remainder / ALIGN_BYTES]};
+                }
+                m_chunks.push_back(new std::byte[m_chunk_size_bytes]);
+                m_unused_begin = m_chunks.back();
+                m_unused_end = m_unused_begin + m_chunk_size_bytes;
+            }
+            void* ret{m_unused_begin};
+            m_unused_begin += block_bytes;
+            return ret;
+        }
+        m_fallback_bytes += bytes;
+        return ::operator new(bytes, std::align_val_t{alignment});
+    }
+
+    void Deallocate(void* p, std::size_t bytes, std::size_t alignment) noexcept
+    {
+        if (UsesPool(bytes, alignment)) {
+            const std::size_t list{SizeClass(bytes)};
+            m_free_lists[list] = new (p) ListNode{m_free_lists[list]};
+        } else {
+            m_fallback_bytes -= bytes;
+            ::operator delete(p, std::align_val_t{alignment});
+        }
+    }
+
+    //! Number of chunks allocated so far (exposed for tests).
+    std::size_t NumChunks() const { return m_chunks.size(); }
+
+    std::size_t ChunkSizeBytes() const { return m_chunk_size_bytes; }
+
+    //! Bytes currently allocated outside the pool.
+    std::size_t FallbackBytes() const { return m_fallback_bytes; }
+};
+
+/**
+ * Standard allocator backed by a PoolResource. All rebound copies (e.g. for a
+ * container's node type) must stay within the resource's block size limit;
+ * larger allocations transparently use the global heap.
+ *
+ * The allocator only references the resource, so the resource must outlive
+ * every container using it.
+ */
+template <class T, std::size_t MAX_BLOCK_SIZE_BYTES, std::size_t ALIGN_BYTES = alignof(T)>
+class PoolAllocator
+{
+    PoolResource<MAX_BLOCK_SIZE_BYTES, ALIGN_BYTES>* m_resource;
+
+    template <typename U, std::size_t M, std::size_t A>
+    friend class PoolAllocator;
+
+public:
+    using value_type = T;
+    using ResourceType = PoolResource<MAX_BLOCK_SIZE_BYTES, ALIGN_BYTES>;
+
+    explicit PoolAllocator(ResourceType* resource) noexcept : m_resource{resource} {}
+
+    PoolAllocator(const PoolAllocator& other) noexcept = default;
+    PoolAllocator& operator=(const PoolAllocator& other) noexcept = default;
+
+    template <class U>
+    PoolAllocator(const PoolAllocator<U, MAX_BLOCK_SIZE_BYTES, ALIGN_BYTES>& other) noexcept
+        : m_resource{other.m_resource}
+    {
+    }
+
+    template <typename U>
+    struct rebind {
+        using other = PoolAllocator<U, MAX_BLOCK_SIZE_BYTES, ALIGN_BYTES>;
+    };
+
+    T* allocate(size_t n)
+    {
+        return static_cast<T*>(m_resource->Allocate(n * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T* p, size_t n) noexcept
+    {
+        m_resource->Deallocate(p, n * sizeof(T), alignof(T));
+    }
+
+    ResourceType* resource() const noexcept { return m_resource; }
+};
+
+template <class T1, class T2, std::size_t MAX_BLOCK_SIZE_BYTES, std::size_t ALIGN_BYTES>
+bool operator==(const PoolAllocator<T1, MAX_BLOCK_SIZE_BYTES, ALIGN_BYTES>& a,
+                const PoolAllocator<T2, MAX_BLOCK_SIZE_BYTES, ALIGN_BYTES>& b) noexcept
+{
+    return a.resource() == b.resource();
+}
+
+template <class T1, class T2, std::size_t MAX_BLOCK_SIZE_BYTES, std::size_t ALIGN_BYTES>
+bool operator!=(const PoolAllocator<T1, MAX_BLOCK_SIZE_BYTES, ALIGN_BYTES>& a,
+                const PoolAllocator<T2, MAX_BLOCK_SIZE_BYTES, ALIGN_BYTES>& b) noexcept
+{
+    return !(a == b);
+}
+
+#endif // CORAL_SUPPORT_ALLOCATORS_POOL_H
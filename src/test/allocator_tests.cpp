@@ -2,12 +2,17 @@
 // Distributed under the MIT software license, see the accompanying
 // file COPYING or http://www.opensource.org/licenses/mit-license.php.
 
+#include <support/allocators/bump_arena.h>
+#include <support/allocators/pool.h>
 #include <support/lockedpool.h>
 #include <util/system.h>
 
+#include <cstdint>
+#include <cstring>
 #include <limits>
 #include <memory>
 #include <stdexcept>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -235,4 +240,117 @@ BOOST_AUTO_TEST_CASE(lockedpool_tests_live)
     BOOST_CHECK(pool.stats().used == initial.used);
 }
 
+BOOST_AUTO_TEST_CASE(bump_arena_tests)
+{
+    // Allocations must be aligned and non-overlapping, within and across
+    // chunk boundaries.
+    BumpArena arena{/*chunk_size=*/256};
+    std::vector<std::pair<char*, size_t>> allocs;
+    for (size_t i = 1; i <= 100; ++i) {
+        const size_t bytes{i % 40 + 1};
+        const size_t align{size_t{1} << (i % 4)};
+        char* p{static_cast<char*>(arena.Allocate(bytes, align))};
+        BOOST_CHECK_EQUAL(reinterpret_cast<uintptr_t>(p) % align, 0U);
+        memset(p, 0x5a, bytes);
+        allocs.emplace_back(p, bytes);
+    }
+    // Oversized allocations get a dedicated chunk and must not disturb
+    // subsequent bump allocations.
+    char* big{static_cast<char*>(arena.Allocate(1000, 16))};
+    memset(big, 0x5a, 1000);
+    allocs.emplace_back(big, 1000);
+    allocs.emplace_back(static_cast<char*>(arena.Allocate(24, 8)), 24);
+    memset(allocs.back().first, 0x5a, 24);
+    for (size_t i = 0; i < allocs.size(); ++i) {
+        for (size_t j = i + 1; j < allocs.size(); ++j) {
+            BOOST_CHECK(allocs[i].first + allocs[i].second <= allocs[j].first ||
+                        allocs[j].first + allocs[j].second <= allocs[i].first);
+        }
+    }
+
+    // allocate_shared keeps the arena alive until the last reference goes.
+    std::shared_ptr<const int> kept;
+    {
+        auto shared_arena{std::make_shared<BumpArena>()};
+        auto dropped{std::allocate_shared<const int>(bump_arena_allocator<const int>{shared_arena}, 17)};
+        kept = std::allocate_shared<const int>(bump_arena_allocator<const int>{shared_arena}, 42);
+        BOOST_CHECK_EQUAL(*dropped, 17);
+    }
+    BOOST_CHECK_EQUAL(*kept, 42);
+}
+
+BOOST_AUTO_TEST_CASE(pool_resource_tests)
+{
+    PoolResource</*MAX_BLOCK_SIZE_BYTES=*/128, /*ALIGN_BYTES=*/8> pool{/*chunk_size_bytes=*/1024};
+
+    // A freed block of the same size class is handed out again.
+    void* a{pool.Allocate(24, 8)};
+    memset(a, 0x5a, 24);
+    pool.Deallocate(a, 24, 8);
+    void* b{pool.Allocate(24, 8)};
+    BOOST_CHECK_EQUAL(a, b);
+    // Sizes round up to the same class and share the free list.
+    pool.Deallocate(b, 24, 8);
+    BOOST_CHECK_EQUAL(pool.Allocate(17, 8), a);
+
+    // Pooled allocations are aligned, non-overlapping, and densely packed
+    // into few chunks.
+    std::vector<std::pair<char*, size_t>> allocs;
+    for (size_t i = 1; i <= 200; ++i) {
+        const size_t bytes{i % 120 + 1};
+        char* p{static_cast<char*>(pool.Allocate(bytes, 8))};
+        BOOST_CHECK_EQUAL(reinterpret_cast<uintptr_t>(p) % 8, 0U);
+        memset(p, 0x5a, bytes);
+        allocs.emplace_back(p, bytes);
+    }
+    for (size_t i = 0; i < allocs.size(); ++i) {
+        for (size_t j = i + 1; j < allocs.size(); ++j) {
+            BOOST_CHECK(allocs[i].first + allocs[i].second <= allocs[j].first ||
+                        allocs[j].first + allocs[j].second <= allocs[i].first);
+        }
+    }
+    for (const auto& [p, bytes] : allocs) {
+        pool.Deallocate(p, bytes, 8);
+    }
+
+    // After freeing everything, the same footprint satisfies another round.
+    const size_t chunks{pool.NumChunks()};
+    for (size_t i = 1; i <= 200; ++i) {
+        pool.Allocate(i % 120 + 1, 8);
+    }
+    BOOST_CHECK_EQUAL(pool.NumChunks(), chunks);
+
+    // Oversized requests bypass the pool and are still served correctly.
+    void* big{pool.Allocate(4096, 8)};
+    memset(big, 0x5a, 4096);
+    pool.Deallocate(big, 4096, 8);
+}
+
+BOOST_AUTO_TEST_CASE(pool_allocator_container_tests)
+{
+    // An unordered_map does all its node allocations through the pool and
+    // can grow, shrink and rehash without issue.
+    using Alloc = PoolAllocator<std::pair<const int64_t, int64_t>, /*MAX_BLOCK_SIZE_BYTES=*/128, /*ALIGN_BYTES=*/8>;
+    Alloc::ResourceType pool{/*chunk_size_bytes=*/1024};
+    std::unordered_map<int64_t, int64_t, std::hash<int64_t>, std::equal_to<int64_t>, Alloc> map{Alloc{&pool}};
+
+    for (int64_t i = 0; i < 1000; ++i) {
+        map[i] = i * i;
+    }
+    BOOST_CHECK(pool.NumChunks() > 0);
+    for (int64_t i = 0; i < 1000; ++i) {
+        BOOST_CHECK_EQUAL(map.at(i), i * i);
+    }
+    for (int64_t i = 0; i < 500; ++i) {
+        map.erase(i);
+    }
+    const size_t chunks{pool.NumChunks()};
+    for (int64_t i = 0; i < 500; ++i) {
+        map[i] = i * i;
+    }
+    // The erased nodes' blocks were recycled rather than new chunks grown.
+    BOOST_CHECK_EQUAL(pool.NumChunks(), chunks);
+    map.clear();
+}
+
 BOOST_AUTO_TEST_SUITE_END()
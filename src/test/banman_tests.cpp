@@ -40,4 +40,33 @@ BOOST_AUTO_TEST_CASE(file)
     }
 }
 
+BOOST_AUTO_TEST_CASE(decision_cache)
+{
+    SetMockTime(777s);
+    const fs::path banlist_path{m_args.GetDataDirBase() / "banlist_test_cache"};
+    BanMan banman{banlist_path, /*client_interface=*/nullptr, /*default_ban_time=*/0};
+    CNetAddr addr;
+    BOOST_REQUIRE(LookupHost("1.2.3.4", addr, /*fAllowLookup=*/false));
+    CSubNet sub_net;
+    BOOST_REQUIRE(LookupSubNet("1.2.3.0/24", sub_net));
+
+    // Repeated queries are answered from the decision cache; the results must
+    // match the uncached ones exactly, across bans, expiry and unbans.
+    BOOST_CHECK(!banman.IsBanned(addr));
+    BOOST_CHECK(!banman.IsBanned(addr));
+
+    banman.Ban(sub_net, /*ban_time_offset=*/100);
+    BOOST_CHECK(banman.IsBanned(addr));
+    BOOST_CHECK(banman.IsBanned(addr));
+
+    // A cached verdict still honors the ban expiry, even without a sweep.
+    SetMockTime(777s + 200s);
+    BOOST_CHECK(!banman.IsBanned(addr));
+
+    banman.Ban(sub_net, /*ban_time_offset=*/100);
+    BOOST_CHECK(banman.IsBanned(addr));
+    banman.Unban(sub_net);
+    BOOST_CHECK(!banman.IsBanned(addr));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -53,18 +53,22 @@ public:
 
     uint256 GetBestBlock() const override { return hashBestBlock_; }
 
-    bool BatchWrite(CCoinsMap& mapCoins, const uint256& hashBlock) override
+    bool BatchWrite(CCoinsMap& mapCoins, const uint256& hashBlock, bool erase = true) override
     {
         for (CCoinsMap::iterator it = mapCoins.begin(); it != mapCoins.end(); ) {
             if (it->second.flags & CCoinsCacheEntry::DIRTY) {
                 // Same optimization used in CCoinsViewDB is to only write dirty entries.
-                map_[it->first] = it->second.coin;
+                map_[it->first.outpoint] = it->second.coin;
                 if (it->second.coin.IsSpent() && InsecureRandRange(3) == 0) {
                     // Randomly delete empty entries on write.
-                    map_.erase(it->first);
+                    map_.erase(it->first.outpoint);
                 }
             }
-            mapCoins.erase(it++);
+            if (erase) {
+                mapCoins.erase(it++);
+            } else {
+                ++it;
+            }
         }
         if (!hashBlock.IsNull())
             hashBestBlock_ = hashBlock;
@@ -80,18 +84,25 @@ public:
     void SelfTest() const
     {
         // Manually recompute the dynamic usage of the whole data, and compare it.
-        size_t ret = memusage::DynamicUsage(cacheCoins);
+        size_t ret = 0;
         size_t count = 0;
-        for (const auto& entry : cacheCoins) {
-            ret += entry.second.coin.DynamicMemoryUsage();
-            ++count;
+        for (const CoinsShard& shard : m_shards) {
+            ret += memusage::DynamicUsage(shard.map);
+            for (const auto& entry : shard.map) {
+                ret += entry.second.coin.DynamicMemoryUsage();
+                ++count;
+            }
         }
         BOOST_CHECK_EQUAL(GetCacheSize(), count);
         BOOST_CHECK_EQUAL(DynamicMemoryUsage(), ret);
     }
 
-    CCoinsMap& map() const { return cacheCoins; }
-    size_t& usage() const { return cachedCoinsUsage; }
+    //! Sub-map a given outpoint is routed to (the tests below all operate on
+    //! a single constant outpoint).
+    CCoinsMap& map(const COutPoint& outpoint) const { return ShardMapFor(outpoint); }
+    //! Key for a given outpoint in this cache's maps (salted by this cache).
+    HashedOutpoint key(const COutPoint& outpoint) const { return HashedKey(outpoint); }
+    void add_usage(size_t usage) const { cachedCoinsUsage += usage; }
 };
 
 } // namespace
@@ -574,7 +585,7 @@ static void SetCoinsValue(CAmount value, Coin& coin)
     }
 }
 
-static size_t InsertCoinsMapEntry(CCoinsMap& map, CAmount value, char flags)
+static size_t InsertCoinsMapEntry(CCoinsMap& map, const HashedOutpoint& key, CAmount value, char flags)
 {
     if (value == ABSENT) {
         assert(flags == NO_ENTRY);
@@ -584,14 +595,14 @@ static size_t InsertCoinsMapEntry(CCoinsMap& map, CAmount value, char flags)
     CCoinsCacheEntry entry;
     entry.flags = flags;
     SetCoinsValue(value, entry.coin);
-    auto inserted = map.emplace(OUTPOINT, std::move(entry));
+    auto inserted = map.emplace(key, std::move(entry));
     assert(inserted.second);
     return inserted.first->second.coin.DynamicMemoryUsage();
 }
 
-void GetCoinsMapEntry(const CCoinsMap& map, CAmount& value, char& flags)
+void GetCoinsMapEntry(const CCoinsMap& map, const HashedOutpoint& key, CAmount& value, char& flags)
 {
-    auto it = map.find(OUTPOINT);
+    auto it = map.find(key);
     if (it == map.end()) {
         value = ABSENT;
         flags = NO_ENTRY;
@@ -608,8 +619,12 @@ void GetCoinsMapEntry(const CCoinsMap& map, CAmount& value, char& flags)
 
 void WriteCoinsViewEntry(CCoinsView& view, CAmount value, char flags)
 {
-    CCoinsMap map;
-    InsertCoinsMapEntry(map, value, flags);
+    CCoinsMapMemoryResource resource;
+    CCoinsMap map{CCoinsMap::allocator_type{&resource}};
+    // Any salt works for a standalone map; BatchWrite re-keys the entries
+    // with the destination cache's own salt.
+    const SaltedOutpointHasher hasher;
+    InsertCoinsMapEntry(map, HashedOutpoint{OUTPOINT, hasher}, value, flags);
     BOOST_CHECK(view.BatchWrite(map, {}));
 }
 
@@ -619,7 +634,7 @@ public:
     SingleEntryCacheTest(CAmount base_value, CAmount cache_value, char cache_flags)
     {
         WriteCoinsViewEntry(base, base_value, base_value == ABSENT ? NO_ENTRY : DIRTY);
-        cache.usage() += InsertCoinsMapEntry(cache.map(), cache_value, cache_flags);
+        cache.add_usage(InsertCoinsMapEntry(cache.map(OUTPOINT), cache.key(OUTPOINT), cache_value, cache_flags));
     }
 
     CCoinsView root;
@@ -635,7 +650,7 @@ static void CheckAccessCoin(CAmount base_value, CAmount cache_value, CAmount exp
 
     CAmount result_value;
     char result_flags;
-    GetCoinsMapEntry(test.cache.map(), result_value, result_flags);
+    GetCoinsMapEntry(test.cache.map(OUTPOINT), test.cache.key(OUTPOINT), result_value, result_flags);
     BOOST_CHECK_EQUAL(result_value, expected_value);
     BOOST_CHECK_EQUAL(result_flags, expected_flags);
 }
@@ -686,7 +701,7 @@ static void CheckSpendCoins(CAmount base_value, CAmount cache_value, CAmount exp
 
     CAmount result_value;
     char result_flags;
-    GetCoinsMapEntry(test.cache.map(), result_value, result_flags);
+    GetCoinsMapEntry(test.cache.map(OUTPOINT), test.cache.key(OUTPOINT), result_value, result_flags);
     BOOST_CHECK_EQUAL(result_value, expected_value);
     BOOST_CHECK_EQUAL(result_flags, expected_flags);
 };
@@ -740,7 +755,7 @@ static void CheckAddCoinBase(CAmount base_value, CAmount cache_value, CAmount mo
         output.nValue = modify_value;
         test.cache.AddCoin(OUTPOINT, Coin(std::move(output), 1, coinbase), coinbase);
         test.cache.SelfTest();
-        GetCoinsMapEntry(test.cache.map(), result_value, result_flags);
+        GetCoinsMapEntry(test.cache.map(OUTPOINT), test.cache.key(OUTPOINT), result_value, result_flags);
     } catch (std::logic_error&) {
         result_value = FAIL;
         result_flags = NO_ENTRY;
@@ -801,7 +816,7 @@ void CheckWriteCoins(CAmount parent_value, CAmount child_value, CAmount expected
     try {
         WriteCoinsViewEntry(test.cache, child_value, child_flags);
         test.cache.SelfTest();
-        GetCoinsMapEntry(test.cache.map(), result_value, result_flags);
+        GetCoinsMapEntry(test.cache.map(OUTPOINT), test.cache.key(OUTPOINT), result_value, result_flags);
     } catch (std::logic_error&) {
         result_value = FAIL;
         result_flags = NO_ENTRY;
@@ -368,4 +368,59 @@ BOOST_AUTO_TEST_CASE(cuckoocache_generations)
     test_cache_generations<CuckooCache::cache<uint256, SignatureCacheHasher>>();
 }
 
+/* Test that bulk_invalidate logically erases all entries, that the freed
+ * slots are reused by subsequent inserts, and that get_stats reports
+ * occupancy and hit/miss counts consistently.
+ */
+BOOST_AUTO_TEST_CASE(cuckoocache_bulk_invalidate)
+{
+    SeedInsecureRand(SeedRand::ZEROS);
+    CuckooCache::cache<uint256, SignatureCacheHasher> cc{};
+    size_t megabytes = 4;
+    cc.setup_bytes(megabytes << 20);
+
+    std::vector<uint256> hashes(10000);
+    for (uint256& h : hashes) {
+        h = InsecureRand256();
+    }
+    for (const uint256& h : hashes) {
+        cc.insert(h);
+    }
+    for (const uint256& h : hashes) {
+        BOOST_CHECK(cc.contains(h, false));
+    }
+    {
+        const CuckooCache::Stats stats{cc.get_stats()};
+        BOOST_CHECK_EQUAL(stats.hits, hashes.size());
+        BOOST_CHECK_EQUAL(stats.misses, 0U);
+        BOOST_CHECK_EQUAL(stats.occupied, hashes.size());
+    }
+
+    cc.bulk_invalidate();
+
+    // All previously inserted entries are gone and no longer count as
+    // occupied.
+    for (const uint256& h : hashes) {
+        BOOST_CHECK(!cc.contains(h, false));
+    }
+    {
+        const CuckooCache::Stats stats{cc.get_stats()};
+        BOOST_CHECK_EQUAL(stats.misses, hashes.size());
+        BOOST_CHECK_EQUAL(stats.occupied, 0U);
+    }
+
+    // Invalidated slots are reusable: the cache holds a fresh working set of
+    // the same size without evictions.
+    for (uint256& h : hashes) {
+        h = InsecureRand256();
+    }
+    for (const uint256& h : hashes) {
+        cc.insert(h);
+    }
+    for (const uint256& h : hashes) {
+        BOOST_CHECK(cc.contains(h, false));
+    }
+    BOOST_CHECK_EQUAL(cc.get_stats().occupied, hashes.size());
+};
+
 BOOST_AUTO_TEST_SUITE_END();
@@ -112,7 +112,11 @@ FUZZ_TARGET_INIT(coins_view, initialize_coins_view)
                 random_mutable_transaction = *opt_mutable_transaction;
             },
             [&] {
-                CCoinsMap coins_map;
+                CCoinsMapMemoryResource coins_map_resource;
+                CCoinsMap coins_map{CCoinsMap::allocator_type{&coins_map_resource}};
+                // Any salt works for a standalone map; BatchWrite re-keys the
+                // entries with the destination cache's own salt.
+                const SaltedOutpointHasher hasher;
                 LIMITED_WHILE(fuzzed_data_provider.ConsumeBool(), 10000) {
                     CCoinsCacheEntry coins_cache_entry;
                     coins_cache_entry.flags = fuzzed_data_provider.ConsumeIntegral<unsigned char>();
@@ -125,7 +129,7 @@ FUZZ_TARGET_INIT(coins_view, initialize_coins_view)
                         }
                         coins_cache_entry.coin = *opt_coin;
                     }
-                    coins_map.emplace(random_out_point, std::move(coins_cache_entry));
+                    coins_map.emplace(HashedOutpoint{random_out_point, hasher}, std::move(coins_cache_entry));
                 }
                 bool expected_code_path = false;
                 try {
@@ -145,6 +145,22 @@ BOOST_AUTO_TEST_CASE(siphash)
         BOOST_CHECK_EQUAL(SipHashUint256(k1, k2, x), sip256.Finalize());
         BOOST_CHECK_EQUAL(SipHashUint256Extra(k1, k2, x, n), sip288.Finalize());
     }
+
+    // Check consistency between SipHashUint256Batch (which may use a SIMD
+    // implementation selected by SipHashAutoDetect) and SipHashUint256, for
+    // every batch size up to two 4-way blocks plus tail.
+    for (size_t count = 0; count <= 11; ++count) {
+        uint64_t k1 = ctx.rand64();
+        uint64_t k2 = ctx.rand64();
+        std::vector<uint256> vals;
+        vals.reserve(count);
+        for (size_t i = 0; i < count; ++i) vals.push_back(InsecureRand256());
+        std::vector<uint64_t> out(count);
+        SipHashUint256Batch(k1, k2, vals.data(), out.data(), count);
+        for (size_t i = 0; i < count; ++i) {
+            BOOST_CHECK_EQUAL(out[i], SipHashUint256(k1, k2, vals[i]));
+        }
+    }
 }
 
 BOOST_AUTO_TEST_SUITE_END()
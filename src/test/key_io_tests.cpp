@@ -146,4 +146,43 @@ BOOST_AUTO_TEST_CASE(key_io_invalid)
     }
 }
 
+// Goal: check that the destination decode cache keeps repeated and batch
+// decodes consistent, including across chain switches
+BOOST_AUTO_TEST_CASE(key_io_decode_cache)
+{
+    SelectParams(CBaseChainParams::MAIN);
+
+    std::vector<std::string> addresses;
+    std::vector<CTxDestination> expected;
+    for (int i = 0; i < 10; ++i) {
+        uint160 hash;
+        hash.begin()[0] = i;
+        expected.emplace_back(WitnessV0KeyHash(hash));
+        addresses.push_back(EncodeDestination(expected.back()));
+    }
+
+    // Repeated decodes (cached after the first) must keep returning the same
+    // destination, and the batch API must agree with single decodes.
+    for (int round = 0; round < 3; ++round) {
+        const std::vector<CTxDestination> decoded = DecodeDestinations(addresses);
+        BOOST_REQUIRE_EQUAL(decoded.size(), addresses.size());
+        for (size_t j = 0; j < addresses.size(); ++j) {
+            BOOST_CHECK(decoded[j] == expected[j]);
+            BOOST_CHECK(DecodeDestination(addresses[j]) == expected[j]);
+        }
+    }
+
+    // A mainnet address cached above must not leak into another chain's
+    // decodes: the HRP no longer matches, so decoding has to fail.
+    SelectParams(CBaseChainParams::REGTEST);
+    for (const std::string& address : addresses) {
+        BOOST_CHECK(!IsValidDestination(DecodeDestination(address)));
+    }
+
+    SelectParams(CBaseChainParams::MAIN);
+    for (size_t j = 0; j < addresses.size(); ++j) {
+        BOOST_CHECK(DecodeDestination(addresses[j]) == expected[j]);
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -344,4 +344,26 @@ BOOST_AUTO_TEST_CASE(bip340_test_vectors)
     }
 }
 
+BOOST_AUTO_TEST_CASE(pubkey_parse_cache)
+{
+    // Repeated verifications with the same key hit the thread-local parse
+    // cache; cached and uncached results must not differ, and a cached key
+    // must not make verification of a bad signature pass.
+    CKey key;
+    key.MakeNewKey(/*fCompressed=*/true);
+    const CPubKey pubkey = key.GetPubKey();
+    const uint256 hash{InsecureRand256()};
+    std::vector<unsigned char> sig;
+    BOOST_CHECK(key.Sign(hash, sig));
+    for (int i = 0; i < 3; ++i) {
+        BOOST_CHECK(pubkey.Verify(hash, sig));
+        BOOST_CHECK(!pubkey.Verify(InsecureRand256(), sig));
+    }
+    // Decompress() parses through the same cache and must round-trip.
+    CPubKey decompressed = pubkey;
+    BOOST_CHECK(decompressed.Decompress());
+    BOOST_CHECK(!decompressed.IsCompressed());
+    BOOST_CHECK(decompressed.Verify(hash, sig));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -800,4 +800,64 @@ BOOST_AUTO_TEST_CASE(MempoolAncestryTestsDiamond)
     BOOST_CHECK_EQUAL(descendants, 4ULL);
 }
 
+BOOST_AUTO_TEST_CASE(MempoolFeeHistogramTest)
+{
+    // Bucket 0 holds everything below 1 sat/vB; higher buckets are log-scale
+    // and the top bucket absorbs arbitrarily high rates.
+    BOOST_CHECK_EQUAL(CTxMemPool::FeeHistogramBucketIndex(/*fee=*/0, /*vsize=*/100), 0U);
+    BOOST_CHECK_EQUAL(CTxMemPool::FeeHistogramBucketIndex(50, 100), 0U);
+    BOOST_CHECK_EQUAL(CTxMemPool::FeeHistogramBucketIndex(100, 100), 1U);
+    BOOST_CHECK(CTxMemPool::FeeHistogramBucketIndex(200, 100) > CTxMemPool::FeeHistogramBucketIndex(100, 100));
+    BOOST_CHECK_EQUAL(CTxMemPool::FeeHistogramBucketIndex(1000 * COIN, 100), CTxMemPool::FEE_HISTOGRAM_BUCKETS - 1);
+    // Bucket bounds are increasing and consistent with the index function.
+    for (size_t i = 1; i < CTxMemPool::FEE_HISTOGRAM_BUCKETS; ++i) {
+        BOOST_CHECK(CTxMemPool::FeeHistogramBucketLow(i) > CTxMemPool::FeeHistogramBucketLow(i - 1));
+    }
+
+    CTxMemPool& pool = *Assert(m_node.mempool);
+    TestMemPoolEntryHelper entry;
+
+    CMutableTransaction tx1;
+    tx1.vin.resize(1);
+    tx1.vin[0].scriptSig = CScript() << OP_11;
+    tx1.vout.resize(1);
+    tx1.vout[0].scriptPubKey = CScript() << OP_11 << OP_EQUAL;
+    tx1.vout[0].nValue = 10 * COIN;
+    CMutableTransaction tx2{tx1};
+    tx2.vout[0].nValue = 5 * COIN;
+
+    const auto total_count = [](const CTxMemPool::FeeHistogram& h) {
+        uint64_t total{0};
+        for (uint64_t c : h.count) total += c;
+        return total;
+    };
+    const auto total_fee = [](const CTxMemPool::FeeHistogram& h) {
+        CAmount total{0};
+        for (CAmount f : h.fee) total += f;
+        return total;
+    };
+
+    BOOST_CHECK_EQUAL(total_count(pool.GetFeeHistogram()), 0U);
+    {
+        LOCK2(cs_main, pool.cs);
+        pool.addUnchecked(entry.Fee(1000LL).FromTx(tx1));
+        pool.addUnchecked(entry.Fee(50000LL).FromTx(tx2));
+    }
+    BOOST_CHECK_EQUAL(total_count(pool.GetFeeHistogram()), 2U);
+    BOOST_CHECK_EQUAL(total_fee(pool.GetFeeHistogram()), 51000LL);
+
+    // Prioritisation moves the entry's modified fee between buckets and the
+    // histogram follows.
+    pool.PrioritiseTransaction(tx1.GetHash(), 9000LL);
+    BOOST_CHECK_EQUAL(total_count(pool.GetFeeHistogram()), 2U);
+    BOOST_CHECK_EQUAL(total_fee(pool.GetFeeHistogram()), 60000LL);
+
+    {
+        LOCK2(cs_main, pool.cs);
+        pool.removeRecursive(CTransaction(tx1), REMOVAL_REASON_DUMMY);
+    }
+    BOOST_CHECK_EQUAL(total_count(pool.GetFeeHistogram()), 1U);
+    BOOST_CHECK_EQUAL(total_fee(pool.GetFeeHistogram()), 50000LL);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -45,4 +45,21 @@ BOOST_AUTO_TEST_CASE(test_query_string)
     BOOST_CHECK_EQUAL(param, "/rest/endpoint/someresource");
     BOOST_CHECK_EQUAL(rf, RESTResponseFormat::UNDEF);
 }
+
+BOOST_AUTO_TEST_CASE(test_format_from_media_type)
+{
+    // Single media type
+    BOOST_CHECK_EQUAL(FormatFromMediaType("application/octet-stream"), RESTResponseFormat::BINARY);
+    BOOST_CHECK_EQUAL(FormatFromMediaType("application/json"), RESTResponseFormat::JSON);
+    BOOST_CHECK_EQUAL(FormatFromMediaType("text/plain"), RESTResponseFormat::HEX);
+
+    // Lists with quality values; binary is preferred when offered at all
+    BOOST_CHECK_EQUAL(FormatFromMediaType("application/json, application/octet-stream;q=0.9"), RESTResponseFormat::BINARY);
+    BOOST_CHECK_EQUAL(FormatFromMediaType("text/plain, application/json"), RESTResponseFormat::JSON);
+
+    // Unrecognized or wildcard media types keep the suffix-less default
+    BOOST_CHECK_EQUAL(FormatFromMediaType("*/*"), RESTResponseFormat::UNDEF);
+    BOOST_CHECK_EQUAL(FormatFromMediaType("text/html"), RESTResponseFormat::UNDEF);
+    BOOST_CHECK_EQUAL(FormatFromMediaType(""), RESTResponseFormat::UNDEF);
+}
 BOOST_AUTO_TEST_SUITE_END()
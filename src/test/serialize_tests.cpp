@@ -242,4 +242,46 @@ BOOST_AUTO_TEST_CASE(class_methods)
     BOOST_CHECK(methodtest3 == methodtest4);
 }
 
+BOOST_AUTO_TEST_CASE(trivially_serializable)
+{
+    static_assert(TriviallySerializable<uint256>::value);
+    static_assert(TriviallySerializable<COutPoint>::value);
+    static_assert(!TriviallySerializable<CTxIn>::value);
+    static_assert(!TriviallySerializable<unsigned char>::value);
+
+    // The whole-object copy must produce the same bytes as per-field
+    // serialization: raw hash bytes followed by a little-endian uint32.
+    const COutPoint out{uint256S("0102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f20"), 0x12345678};
+    CDataStream ss(SER_DISK, 0);
+    ss << out;
+    CDataStream expected(SER_DISK, 0);
+    expected.write(AsBytes(Span{out.hash.begin(), out.hash.size()}));
+    ser_writedata32(expected, out.n);
+    BOOST_CHECK_EQUAL(HexStr(ss), HexStr(expected));
+
+    COutPoint read_back;
+    ss >> read_back;
+    BOOST_CHECK(read_back == out);
+
+    // Vectors of trivially serializable elements go out as one blob behind a
+    // compact size, which is byte-identical to per-element serialization.
+    std::vector<COutPoint> outs;
+    for (uint32_t i = 0; i < 5; ++i) {
+        outs.emplace_back(uint256{uint8_t(i + 1)}, i);
+    }
+    CDataStream ss_vec(SER_DISK, 0);
+    ss_vec << outs;
+    CDataStream expected_vec(SER_DISK, 0);
+    WriteCompactSize(expected_vec, outs.size());
+    for (const COutPoint& o : outs) {
+        expected_vec.write(AsBytes(Span{o.hash.begin(), o.hash.size()}));
+        ser_writedata32(expected_vec, o.n);
+    }
+    BOOST_CHECK_EQUAL(HexStr(ss_vec), HexStr(expected_vec));
+
+    std::vector<COutPoint> outs_read;
+    ss_vec >> outs_read;
+    BOOST_CHECK(outs_read == outs);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -159,6 +159,27 @@ BOOST_AUTO_TEST_CASE(sighash_test)
     #endif
 }
 
+// Goal: check that the precomputed legacy SIGHASH_ALL template produces the
+// same digests as serializing the transaction from scratch, for every input
+// and hash type (non-ALL types fall back to the uncached path).
+BOOST_AUTO_TEST_CASE(sighash_legacy_template)
+{
+    for (int i = 0; i < 5000; i++) {
+        int nHashType{int(InsecureRand32())};
+        CMutableTransaction txTo;
+        RandomTransaction(txTo, (nHashType & 0x1f) == SIGHASH_SINGLE);
+        CScript scriptCode;
+        RandomScript(scriptCode);
+
+        const PrecomputedTransactionData txdata{txTo};
+        for (unsigned int nIn = 0; nIn < txTo.vin.size(); nIn++) {
+            const uint256 cached{SignatureHash(scriptCode, txTo, nIn, nHashType, 0, SigVersion::BASE, &txdata)};
+            const uint256 uncached{SignatureHash(scriptCode, txTo, nIn, nHashType, 0, SigVersion::BASE)};
+            BOOST_CHECK(cached == uncached);
+        }
+    }
+}
+
 // Goal: check that SignatureHash generates correct hash
 BOOST_AUTO_TEST_CASE(sighash_from_data)
 {
@@ -195,6 +195,25 @@ BOOST_AUTO_TEST_CASE(streams_serializedata_xor)
     }
 }
 
+BOOST_AUTO_TEST_CASE(streams_datastream_release)
+{
+    CDataStream ds{SER_NETWORK, 0};
+    ds << uint8_t{0x11} << uint8_t{0x22} << uint8_t{0x33};
+
+    // Consumed bytes must not appear in the released buffer.
+    uint8_t first;
+    ds >> first;
+    BOOST_CHECK_EQUAL(first, 0x11);
+    const SerializeData buf{ds.release()};
+    BOOST_CHECK_EQUAL(buf.size(), 2U);
+    BOOST_CHECK(buf[0] == std::byte{0x22} && buf[1] == std::byte{0x33});
+
+    // The stream is empty and reusable afterwards.
+    BOOST_CHECK(ds.empty());
+    ds << uint8_t{0x44};
+    BOOST_CHECK_EQUAL(ds.release().size(), 1U);
+}
+
 BOOST_AUTO_TEST_CASE(streams_buffered_file)
 {
     fs::path streams_test_filename = m_args.GetDataDirBase() / "streams_test_tmp";
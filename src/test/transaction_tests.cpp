@@ -383,6 +383,33 @@ BOOST_AUTO_TEST_CASE(basic_transaction_tests)
     BOOST_CHECK_MESSAGE(!CheckTransaction(CTransaction(tx), state) || !state.IsValid(), "Transaction with duplicate txins should be invalid.");
 }
 
+BOOST_AUTO_TEST_CASE(test_deserialize_cached_hashes)
+{
+    // The deserializing constructor takes the cached hash from the stream
+    // bytes instead of re-serializing; it must match the recomputed hashes
+    // both with and without witness data.
+    CMutableTransaction mtx;
+    mtx.nVersion = 2;
+    mtx.vin.resize(1);
+    mtx.vin[0].prevout.hash = InsecureRand256();
+    mtx.vin[0].prevout.n = 0;
+    mtx.vout.resize(1);
+    mtx.vout[0].nValue = CENT;
+    mtx.vout[0].scriptPubKey = CScript() << OP_TRUE;
+
+    for (const bool with_witness : {false, true}) {
+        if (with_witness) {
+            mtx.vin[0].scriptWitness.stack.push_back({1, 2, 3});
+        }
+        const CTransaction tx{mtx};
+        CDataStream stream(SER_NETWORK, PROTOCOL_VERSION);
+        stream << tx;
+        const CTransaction tx_des{deserialize, stream};
+        BOOST_CHECK_EQUAL(tx_des.GetHash(), tx.GetHash());
+        BOOST_CHECK_EQUAL(tx_des.GetWitnessHash(), tx.GetWitnessHash());
+    }
+}
+
 BOOST_AUTO_TEST_CASE(test_Get)
 {
     FillableSigningProvider keystore;
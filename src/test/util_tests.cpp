@@ -181,6 +181,28 @@ BOOST_AUTO_TEST_CASE(parse_hex)
     // Stop parsing at invalid value
     result = ParseHex("1234 invalid 1234");
     BOOST_CHECK(result.size() == 2 && result[0] == 0x12 && result[1] == 0x34);
+
+    // Round-trip through HexStr at sizes around the bulk-codec block size
+    // (32 bytes), in lower and upper case
+    for (const size_t size : {31, 32, 33, 63, 64, 65, 96, 127}) {
+        std::vector<unsigned char> bytes;
+        bytes.reserve(size);
+        for (size_t i = 0; i < size; ++i) {
+            bytes.push_back(static_cast<unsigned char>(i * 13 + 7));
+        }
+        const std::string hex = HexStr(bytes);
+        result = ParseHex(hex);
+        BOOST_CHECK_EQUAL_COLLECTIONS(result.begin(), result.end(), bytes.begin(), bytes.end());
+        result = ParseHex(ToUpper(hex));
+        BOOST_CHECK_EQUAL_COLLECTIONS(result.begin(), result.end(), bytes.begin(), bytes.end());
+
+        // An invalid character inside the first block stops parsing there
+        std::string broken = hex;
+        broken[10] = 'x';
+        result = ParseHex(broken);
+        BOOST_CHECK(result.size() == 5);
+        BOOST_CHECK(std::equal(result.begin(), result.end(), bytes.begin()));
+    }
 }
 
 BOOST_AUTO_TEST_CASE(util_HexStr)
@@ -6,6 +6,7 @@
 #include <txdb.h>
 
 #include <chain.h>
+#include <diskio.h>
 #include <pow.h>
 #include <random.h>
 #include <shutdown.h>
@@ -16,6 +17,10 @@
 
 #include <stdint.h>
 
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
 static constexpr uint8_t DB_COIN{'C'};
 static constexpr uint8_t DB_BLOCK_FILES{'f'};
 static constexpr uint8_t DB_BLOCK_INDEX{'b'};
@@ -70,8 +75,19 @@ struct CoinEntry {
 
 } // namespace
 
+//! LevelDB tuning for the coins database, overridable for production tuning.
+static DBParams CoinsDBParams()
+{
+    DBParams params;
+    params.filter_bits_per_key = gArgs.GetIntArg("-dbfilterbits", params.filter_bits_per_key);
+    params.block_cache_percent = gArgs.GetIntArg("-dbblockcachepercent", params.block_cache_percent);
+    params.compression = gArgs.GetBoolArg("-dbcompression", params.compression);
+    params.max_file_size = gArgs.GetIntArg("-dbmaxfilesize", params.max_file_size);
+    return params;
+}
+
 CCoinsViewDB::CCoinsViewDB(fs::path ldb_path, size_t nCacheSize, bool fMemory, bool fWipe) :
-    m_db(std::make_unique<CDBWrapper>(ldb_path, nCacheSize, fMemory, fWipe, true)),
+    m_db(std::make_unique<CDBWrapper>(ldb_path, nCacheSize, fMemory, fWipe, true, CoinsDBParams())),
     m_ldb_path(ldb_path),
     m_is_memory(fMemory) { }
 
@@ -84,7 +100,7 @@ void CCoinsViewDB::ResizeCache(size_t new_cache_size)
         // filesystem lock.
         m_db.reset();
         m_db = std::make_unique<CDBWrapper>(
-            m_ldb_path, new_cache_size, m_is_memory, /*fWipe=*/false, /*obfuscate=*/true);
+            m_ldb_path, new_cache_size, m_is_memory, /*fWipe=*/false, /*obfuscate=*/true, CoinsDBParams());
     }
 }
 
@@ -111,7 +127,15 @@ std::vector<uint256> CCoinsViewDB::GetHeadBlocks() const {
     return vhashHeadBlocks;
 }
 
-bool CCoinsViewDB::BatchWrite(CCoinsMap &mapCoins, const uint256 &hashBlock) {
+bool CCoinsViewDB::BatchWrite(CCoinsMap &mapCoins, const uint256 &hashBlock, bool erase) {
+    std::vector<CCoinsMap*> shards{&mapCoins};
+    return BatchWriteShards(shards, hashBlock, erase);
+}
+
+bool CCoinsViewDB::BatchWriteShards(std::vector<CCoinsMap*>& shards, const uint256 &hashBlock, bool erase) {
+    // Coins flushes are on the validation critical path; background index and
+    // rescan I/O yields to them (see diskio.h).
+    const diskio::ValidationWriteGuard write_guard;
     CDBBatch batch(*m_db);
     size_t count = 0;
     size_t changed = 0;
@@ -130,24 +154,36 @@ bool CCoinsViewDB::BatchWrite(CCoinsMap &mapCoins, const uint256 &hashBlock) {
     }
 
     // In the first batch, mark the database as being in the middle of a
-    // transition from old_tip to hashBlock.
+    // transition from old_tip to hashBlock. The marker spans all shard maps,
+    // so a crash anywhere in the multi-shard write is replayed on startup.
     // A vector is used for future extensibility, as we may want to support
     // interrupting after partial writes from multiple independent reorgs.
     batch.Erase(DB_BEST_BLOCK);
     batch.Write(DB_HEAD_BLOCKS, Vector(hashBlock, old_tip));
 
-    for (CCoinsMap::iterator it = mapCoins.begin(); it != mapCoins.end();) {
-        if (it->second.flags & CCoinsCacheEntry::DIRTY) {
-            CoinEntry entry(&it->first);
-            if (it->second.coin.IsSpent())
-                batch.Erase(entry);
-            else
-                batch.Write(entry, it->second.coin);
-            changed++;
+    // Collect the dirty entries from all shards and sort them by outpoint,
+    // so keys are appended to each (size-bounded) batch in LevelDB's
+    // comparator order. The cache maps iterate in hash order; feeding that
+    // random key sequence to LevelDB makes every flushed sstable span the
+    // whole key space and compact against everything, while sorted runs stay
+    // disjoint and compact cheaply.
+    std::vector<CCoinsMap::iterator> dirty_entries;
+    for (CCoinsMap* mapCoins : shards) {
+        count += mapCoins->size();
+        for (CCoinsMap::iterator it = mapCoins->begin(); it != mapCoins->end(); ++it) {
+            if (it->second.flags & CCoinsCacheEntry::DIRTY) dirty_entries.push_back(it);
         }
-        count++;
-        CCoinsMap::iterator itOld = it++;
-        mapCoins.erase(itOld);
+    }
+    std::sort(dirty_entries.begin(), dirty_entries.end(),
+              [](const CCoinsMap::iterator& a, const CCoinsMap::iterator& b) { return a->first < b->first; });
+
+    for (const CCoinsMap::iterator& it : dirty_entries) {
+        CoinEntry entry(&it->first.outpoint);
+        if (it->second.coin.IsSpent())
+            batch.Erase(entry);
+        else
+            batch.Write(entry, it->second.coin);
+        changed++;
         if (batch.SizeEstimate() > batch_size) {
             LogPrint(BCLog::COINDB, "Writing partial batch of %.2f MiB\n", batch.SizeEstimate() * (1.0 / 1048576.0));
             m_db->WriteBatch(batch);
@@ -161,6 +197,11 @@ bool CCoinsViewDB::BatchWrite(CCoinsMap &mapCoins, const uint256 &hashBlock) {
             }
         }
     }
+    if (erase) {
+        for (CCoinsMap* mapCoins : shards) {
+            mapCoins->clear();
+        }
+    }
 
     // In the last batch, mark the database as consistent with hashBlock again.
     batch.Erase(DB_HEAD_BLOCKS);
@@ -177,6 +218,11 @@ size_t CCoinsViewDB::EstimateSize() const
     return m_db->EstimateSize(DB_COIN, uint8_t(DB_COIN + 1));
 }
 
+std::optional<std::string> CCoinsViewDB::GetDBProperty(const std::string& property) const
+{
+    return m_db->GetProperty(property);
+}
+
 CBlockTreeDB::CBlockTreeDB(size_t nCacheSize, bool fMemory, bool fWipe) : CDBWrapper(gArgs.GetDataDirNet() / "blocks" / "index", nCacheSize, fMemory, fWipe) {
 }
 
@@ -241,6 +287,24 @@ std::unique_ptr<CCoinsViewCursor> CCoinsViewDB::Cursor() const
     return i;
 }
 
+std::unique_ptr<CCoinsViewCursor> CCoinsViewDB::Cursor(const COutPoint& start) const
+{
+    auto i = std::make_unique<CCoinsViewDBCursor>(
+        const_cast<CDBWrapper&>(*m_db).NewIterator(), GetBestBlock());
+    // Coin keys sort by (txid, output index) in raw byte order, so seeking to
+    // `start` positions the cursor at the first coin at or after it.
+    i->pcursor->Seek(CoinEntry(&start));
+    // Cache key of first record
+    if (i->pcursor->Valid()) {
+        CoinEntry entry(&i->keyTmp.second);
+        i->pcursor->GetKey(entry);
+        i->keyTmp.first = entry.key;
+    } else {
+        i->keyTmp.first = 0; // Make sure Valid() and GetKey() return false
+    }
+    return i;
+}
+
 bool CCoinsViewDBCursor::GetKey(COutPoint &key) const
 {
     // Return cached key
@@ -302,47 +366,79 @@ bool CBlockTreeDB::LoadBlockIndexGuts(const Consensus::Params& consensusParams,
     std::unique_ptr<CDBIterator> pcursor(NewIterator());
     pcursor->Seek(std::make_pair(DB_BLOCK_INDEX, uint256()));
 
-    // Load m_block_index
-    while (pcursor->Valid()) {
+    // A LevelDB iterator cannot be shared between threads, so records are
+    // read sequentially in chunks. Each chunk's proof-of-work checks -- the
+    // CPU-dominant part of loading a multi-million entry index -- then run
+    // on all cores, before a single-threaded link phase inserts the chunk
+    // into m_block_index under cs_main.
+    constexpr size_t CHUNK_SIZE{1 << 17};
+    const size_t nThreads{static_cast<size_t>(std::max(1, GetNumCores()))};
+
+    bool done = false;
+    while (!done) {
         if (ShutdownRequested()) return false;
-        std::pair<uint8_t, uint256> key;
-        if (pcursor->GetKey(key) && key.first == DB_BLOCK_INDEX) {
-            CDiskBlockIndex diskindex;
-            if (pcursor->GetValue(diskindex)) {
-                // Construct block index object
-                CBlockIndex* pindexNew = insertBlockIndex(diskindex.ConstructBlockHash());
-                pindexNew->pprev          = insertBlockIndex(diskindex.hashPrev);
-                pindexNew->nHeight        = diskindex.nHeight;
-                pindexNew->nFile          = diskindex.nFile;
-                pindexNew->nDataPos       = diskindex.nDataPos;
-                pindexNew->nUndoPos       = diskindex.nUndoPos;
-                pindexNew->nVersion       = diskindex.nVersion;
-                pindexNew->hashMerkleRoot = diskindex.hashMerkleRoot;
-                pindexNew->nTime          = diskindex.nTime;
-                pindexNew->nBits          = diskindex.nBits;
-                pindexNew->nNonce         = diskindex.nNonce;
-                pindexNew->nStatus        = diskindex.nStatus;
-                pindexNew->nTx            = diskindex.nTx;
-
-                // Use RandomX PoW check for Coral
-                // Construct header from disk data (pprev pointer may not be valid yet)
-                CBlockHeader header;
-                header.nVersion = diskindex.nVersion;
-                header.hashPrevBlock = diskindex.hashPrev;
-                header.hashMerkleRoot = diskindex.hashMerkleRoot;
-                header.nTime = diskindex.nTime;
-                header.nBits = diskindex.nBits;
-                header.nNonce = diskindex.nNonce;
-                if (!CheckRandomXProofOfWork(header, pindexNew->nBits, consensusParams)) {
-                    return error("%s: CheckProofOfWork failed: %s", __func__, pindexNew->ToString());
-                }
 
-                pcursor->Next();
-            } else {
+        // Read a chunk of records.
+        std::vector<CDiskBlockIndex> disk_entries;
+        while (disk_entries.size() < CHUNK_SIZE) {
+            std::pair<uint8_t, uint256> key;
+            if (!pcursor->Valid() || !pcursor->GetKey(key) || key.first != DB_BLOCK_INDEX) {
+                done = true;
+                break;
+            }
+            CDiskBlockIndex diskindex;
+            if (!pcursor->GetValue(diskindex)) {
                 return error("%s: failed to read value", __func__);
             }
-        } else {
-            break;
+            disk_entries.push_back(std::move(diskindex));
+            pcursor->Next();
+        }
+        if (disk_entries.empty()) break;
+
+        // Use RandomX PoW check for Coral. Verify the chunk in parallel;
+        // headers are constructed from the disk records directly, as pprev
+        // pointers may not be valid yet.
+        std::atomic<bool> all_valid{true};
+        const size_t per_thread{(disk_entries.size() + nThreads - 1) / nThreads};
+        std::vector<std::thread> workers;
+        for (size_t start = 0; start < disk_entries.size(); start += per_thread) {
+            const size_t end{std::min(start + per_thread, disk_entries.size())};
+            workers.emplace_back([&, start, end] {
+                for (size_t i = start; i < end && all_valid.load(std::memory_order_relaxed); ++i) {
+                    const CDiskBlockIndex& diskindex = disk_entries[i];
+                    CBlockHeader header;
+                    header.nVersion = diskindex.nVersion;
+                    header.hashPrevBlock = diskindex.hashPrev;
+                    header.hashMerkleRoot = diskindex.hashMerkleRoot;
+                    header.nTime = diskindex.nTime;
+                    header.nBits = diskindex.nBits;
+                    header.nNonce = diskindex.nNonce;
+                    if (!CheckRandomXProofOfWork(header, diskindex.nBits, consensusParams)) {
+                        all_valid.store(false, std::memory_order_relaxed);
+                    }
+                }
+            });
+        }
+        for (std::thread& t : workers) t.join();
+        if (!all_valid.load()) {
+            return error("%s: CheckProofOfWork failed", __func__);
+        }
+
+        // Link phase: construct the block index objects single-threaded.
+        for (const CDiskBlockIndex& diskindex : disk_entries) {
+            CBlockIndex* pindexNew = insertBlockIndex(diskindex.ConstructBlockHash());
+            pindexNew->pprev          = insertBlockIndex(diskindex.hashPrev);
+            pindexNew->nHeight        = diskindex.nHeight;
+            pindexNew->nFile          = diskindex.nFile;
+            pindexNew->nDataPos       = diskindex.nDataPos;
+            pindexNew->nUndoPos       = diskindex.nUndoPos;
+            pindexNew->nVersion       = diskindex.nVersion;
+            pindexNew->hashMerkleRoot = diskindex.hashMerkleRoot;
+            pindexNew->nTime          = diskindex.nTime;
+            pindexNew->nBits          = diskindex.nBits;
+            pindexNew->nNonce         = diskindex.nNonce;
+            pindexNew->nStatus        = diskindex.nStatus;
+            pindexNew->nTx            = diskindex.nTx;
         }
     }
 
@@ -63,13 +63,22 @@ public:
     bool HaveCoin(const COutPoint &outpoint) const override;
     uint256 GetBestBlock() const override;
     std::vector<uint256> GetHeadBlocks() const override;
-    bool BatchWrite(CCoinsMap &mapCoins, const uint256 &hashBlock) override;
+    bool BatchWrite(CCoinsMap &mapCoins, const uint256 &hashBlock, bool erase = true) override;
+    bool BatchWriteShards(std::vector<CCoinsMap*>& shards, const uint256 &hashBlock, bool erase = true) override;
     std::unique_ptr<CCoinsViewCursor> Cursor() const override;
+    //! As Cursor(), but positioned at the first coin at or after `start`.
+    //! Used to iterate a txid range of the UTXO set, e.g. one shard of a
+    //! sharded `dumptxoutset` export.
+    std::unique_ptr<CCoinsViewCursor> Cursor(const COutPoint& start) const;
 
     //! Whether an unsupported database format is used.
     bool NeedsUpgrade();
     size_t EstimateSize() const override;
 
+    //! Value of a LevelDB property (e.g. "leveldb.stats") of the underlying
+    //! database, if available. Used by the getcoinsdbstats RPC.
+    std::optional<std::string> GetDBProperty(const std::string& property) const;
+
     //! Dynamically alter the underlying leveldb cache size.
     void ResizeCache(size_t new_cache_size) EXCLUSIVE_LOCKS_REQUIRED(cs_main);
 };
@@ -0,0 +1,39 @@
+// Copyright (c) 2022 The Coral Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <txidfilter.h>
+
+#include <algorithm>
+
+std::unique_ptr<TxidFilter> g_txid_filter;
+
+TxidFilter::TxidFilter(size_t size_mb)
+{
+    size_t num_words{std::max<size_t>(size_mb, 1) * (1024 * 1024 / sizeof(uint64_t))};
+    // Round down to a power of two so probe positions reduce to a mask.
+    while (num_words & (num_words - 1)) num_words &= num_words - 1;
+    m_bits = std::vector<std::atomic<uint64_t>>(num_words);
+    for (auto& word : m_bits) word.store(0, std::memory_order_relaxed);
+    m_word_mask = num_words - 1;
+}
+
+void TxidFilter::Add(const uint256& txid)
+{
+    for (int probe = 0; probe < 4; ++probe) {
+        const uint64_t bit{txid.GetUint64(probe)};
+        m_bits[(bit >> 6) & m_word_mask].fetch_or(uint64_t{1} << (bit & 0x3f), std::memory_order_relaxed);
+    }
+}
+
+bool TxidFilter::MaybeContains(const uint256& txid) const
+{
+    if (!m_active.load(std::memory_order_acquire)) return true;
+    for (int probe = 0; probe < 4; ++probe) {
+        const uint64_t bit{txid.GetUint64(probe)};
+        if (!(m_bits[(bit >> 6) & m_word_mask].load(std::memory_order_relaxed) & (uint64_t{1} << (bit & 0x3f)))) {
+            return false;
+        }
+    }
+    return true;
+}
@@ -0,0 +1,56 @@
+// Copyright (c) 2022 The Coral Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef CORAL_TXIDFILTER_H
+#define CORAL_TXIDFILTER_H
+
+#include <uint256.h>
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/** Default for -txidfilter, in MiB (0 = disabled) */
+static constexpr int64_t DEFAULT_TXID_FILTER_MB{0};
+
+/**
+ * A lock-free Bloom filter over the txids the node knows about (mempool plus
+ * txindex), used as a front filter so that lookups for transactions we have
+ * never seen can be rejected without touching cs_main or LevelDB.
+ *
+ * Txids are already uniformly distributed, so the probe positions are taken
+ * directly from the four 64-bit words of the txid rather than rehashing.
+ * Entries are never removed: a txid that leaves the mempool keeps reporting
+ * "maybe present", which only costs a fall-through to the full lookup path.
+ * The filter answers "maybe present" for everything until it has been seeded
+ * with the complete set of indexed txids and activated.
+ */
+class TxidFilter
+{
+private:
+    std::vector<std::atomic<uint64_t>> m_bits;
+    uint64_t m_word_mask;
+    std::atomic<bool> m_active{false};
+
+public:
+    /** size_mb is rounded down to a power-of-two number of bits. */
+    explicit TxidFilter(size_t size_mb);
+
+    void Add(const uint256& txid);
+
+    /** False means the txid is definitely not in the mempool or the txindex.
+     * Always true until Activate() has been called. */
+    bool MaybeContains(const uint256& txid) const;
+
+    /** Mark the filter as complete; MaybeContains() answers start being
+     * authoritative for misses. */
+    void Activate() { m_active.store(true, std::memory_order_release); }
+};
+
+/** The global txid front filter, maintained by the mempool and the txindex
+ * and consulted in GetTransaction. May be null. */
+extern std::unique_ptr<TxidFilter> g_txid_filter;
+
+#endif // CORAL_TXIDFILTER_H
@@ -14,6 +14,7 @@
 #include <policy/policy.h>
 #include <policy/settings.h>
 #include <reverse_iterator.h>
+#include <txidfilter.h>
 #include <util/check.h>
 #include <util/moneystr.h>
 #include <util/overflow.h>
@@ -41,6 +42,36 @@ bool TestLockPointValidity(CChain& active_chain, const LockPoints& lp)
     return true;
 }
 
+CTransactionRef CompactTransactionForMempool(const CTransactionRef& tx)
+{
+    //! Slack below this many bytes is not worth a reallocation pass.
+    constexpr size_t MIN_SLACK_TO_COMPACT{128};
+
+    // Prevector-backed scripts only waste reclaimable memory when they have
+    // spilled to the heap; inline storage is part of the object either way.
+    const auto script_slack = [](const CScript& script) -> size_t {
+        return script.allocated_memory() > 0 ? script.capacity() - script.size() : 0;
+    };
+
+    size_t slack{0};
+    for (const CTxIn& txin : tx->vin) {
+        slack += script_slack(txin.scriptSig);
+        const auto& stack{txin.scriptWitness.stack};
+        slack += (stack.capacity() - stack.size()) * sizeof(stack[0]);
+        for (const auto& elem : stack) {
+            slack += elem.capacity() - elem.size();
+        }
+    }
+    for (const CTxOut& txout : tx->vout) {
+        slack += script_slack(txout.scriptPubKey);
+    }
+    if (slack < MIN_SLACK_TO_COMPACT) return tx;
+
+    // Copy construction reallocates every vector, script and witness stack
+    // element at exactly its size.
+    return MakeTransactionRef(CMutableTransaction{*tx});
+}
+
 CTxMemPoolEntry::CTxMemPoolEntry(const CTransactionRef& tx, CAmount fee,
                                  int64_t time, unsigned int entry_height,
                                  bool spends_coinbase, int64_t sigops_cost, LockPoints lp)
@@ -80,25 +111,33 @@ size_t CTxMemPoolEntry::GetTxSize() const
 void CTxMemPool::UpdateForDescendants(txiter updateIt, cacheMap& cachedDescendants,
                                       const std::set<uint256>& setExclude, std::set<uint256>& descendants_to_remove)
 {
-    CTxMemPoolEntry::Children stageEntries, descendants;
-    stageEntries = updateIt->GetMemPoolChildrenConst();
-
-    while (!stageEntries.empty()) {
-        const CTxMemPoolEntry& descendant = *stageEntries.begin();
-        descendants.insert(descendant);
-        stageEntries.erase(descendant);
-        const CTxMemPoolEntry::Children& children = descendant.GetMemPoolChildrenConst();
-        for (const CTxMemPoolEntry& childEntry : children) {
-            cacheMap::iterator cacheIt = cachedDescendants.find(mapTx.iterator_to(childEntry));
-            if (cacheIt != cachedDescendants.end()) {
-                // We've already calculated this one, just add the entries for this set
-                // but don't traverse again.
-                for (txiter cacheEntry : cacheIt->second) {
-                    descendants.insert(*cacheEntry);
+    // Track visited entries with an epoch mark instead of set membership, so
+    // deduplication is a counter compare rather than a red-black-tree insert.
+    std::vector<txiter> stageEntries, descendants;
+    {
+        WITH_FRESH_EPOCH(m_epoch);
+        for (const CTxMemPoolEntry& child : updateIt->GetMemPoolChildrenConst()) {
+            txiter childIter = mapTx.iterator_to(child);
+            if (!visited(childIter)) stageEntries.push_back(childIter);
+        }
+        while (!stageEntries.empty()) {
+            const txiter descendantIt = stageEntries.back();
+            stageEntries.pop_back();
+            descendants.push_back(descendantIt);
+            const CTxMemPoolEntry::Children& children = descendantIt->GetMemPoolChildrenConst();
+            for (const CTxMemPoolEntry& childEntry : children) {
+                txiter childIter = mapTx.iterator_to(childEntry);
+                cacheMap::iterator cacheIt = cachedDescendants.find(childIter);
+                if (cacheIt != cachedDescendants.end()) {
+                    // We've already calculated this one, just add the entries for this set
+                    // but don't traverse again.
+                    for (txiter cacheEntry : cacheIt->second) {
+                        if (!visited(cacheEntry)) descendants.push_back(cacheEntry);
+                    }
+                } else if (!visited(childIter)) {
+                    // Schedule for later processing
+                    stageEntries.push_back(childIter);
                 }
-            } else if (!descendants.count(childEntry)) {
-                // Schedule for later processing
-                stageEntries.insert(childEntry);
             }
         }
     }
@@ -107,14 +146,15 @@ void CTxMemPool::UpdateForDescendants(txiter updateIt, cacheMap& cachedDescendan
     int64_t modifySize = 0;
     CAmount modifyFee = 0;
     int64_t modifyCount = 0;
-    for (const CTxMemPoolEntry& descendant : descendants) {
+    for (txiter descendantIt : descendants) {
+        const CTxMemPoolEntry& descendant = *descendantIt;
         if (!setExclude.count(descendant.GetTx().GetHash())) {
             modifySize += descendant.GetTxSize();
             modifyFee += descendant.GetModifiedFee();
             modifyCount++;
-            cachedDescendants[updateIt].insert(mapTx.iterator_to(descendant));
+            cachedDescendants[updateIt].insert(descendantIt);
             // Update ancestor state for each descendant
-            mapTx.modify(mapTx.iterator_to(descendant), [=](CTxMemPoolEntry& e) {
+            mapTx.modify(descendantIt, [=](CTxMemPoolEntry& e) {
               e.UpdateAncestorState(updateIt->GetTxSize(), updateIt->GetModifiedFee(), 1, updateIt->GetSigOpCost());
             });
             // Don't directly remove the transaction here -- doing so would
@@ -195,6 +235,22 @@ bool CTxMemPool::CalculateAncestorsAndCheckLimits(size_t entry_size,
 {
     size_t totalSizeWithAncestors = entry_size;
 
+    // Fast bound checks using the cached ancestor aggregates of the staged
+    // parents: every parent's ancestor set is a subset of the final ancestor
+    // set, so its cached totals lower-bound the result (and are exact for a
+    // single in-mempool parent, the common shape of long payment chains).
+    // This rejects over-limit chains in O(parents), without walking the chain
+    // or allocating the full ancestor set.
+    for (const CTxMemPoolEntry& parent : staged_ancestors) {
+        if (parent.GetCountWithAncestors() + entry_count > limitAncestorCount) {
+            errString = strprintf("too many unconfirmed ancestors [limit: %u]", limitAncestorCount);
+            return false;
+        } else if (parent.GetSizeWithAncestors() + entry_size > limitAncestorSize) {
+            errString = strprintf("exceeds ancestor size limit [limit: %u]", limitAncestorSize);
+            return false;
+        }
+    }
+
     while (!staged_ancestors.empty()) {
         const CTxMemPoolEntry& stage = staged_ancestors.begin()->get();
         txiter stageit = mapTx.iterator_to(stage);
@@ -440,6 +496,45 @@ CTxMemPool::CTxMemPool(const Options& opts)
     _clear(); //lock free clear
 }
 
+size_t CTxMemPool::FeeHistogramBucketIndex(CAmount fee, size_t vsize)
+{
+    if (vsize == 0) return 0;
+    const double rate{static_cast<double>(fee) / vsize}; // sat/vB
+    if (rate < 1.0) return 0;
+    // Bucket i >= 1 covers [sqrt(2)^(i-1), sqrt(2)^i) sat/vB.
+    const size_t index{1 + static_cast<size_t>(2.0 * std::log2(rate))};
+    return std::min(index, FEE_HISTOGRAM_BUCKETS - 1);
+}
+
+double CTxMemPool::FeeHistogramBucketLow(size_t index)
+{
+    if (index == 0) return 0.0;
+    return std::pow(2.0, (index - 1) / 2.0);
+}
+
+void CTxMemPool::FeeHistogramAdd(const CTxMemPoolEntry& entry)
+{
+    const size_t bucket{FeeHistogramBucketIndex(entry.GetModifiedFee(), entry.GetTxSize())};
+    m_fee_histogram.count[bucket] += 1;
+    m_fee_histogram.vsize[bucket] += entry.GetTxSize();
+    m_fee_histogram.fee[bucket] += entry.GetModifiedFee();
+}
+
+void CTxMemPool::FeeHistogramRemove(const CTxMemPoolEntry& entry)
+{
+    const size_t bucket{FeeHistogramBucketIndex(entry.GetModifiedFee(), entry.GetTxSize())};
+    assert(m_fee_histogram.count[bucket] > 0);
+    m_fee_histogram.count[bucket] -= 1;
+    m_fee_histogram.vsize[bucket] -= entry.GetTxSize();
+    m_fee_histogram.fee[bucket] -= entry.GetModifiedFee();
+}
+
+CTxMemPool::FeeHistogram CTxMemPool::GetFeeHistogram() const
+{
+    LOCK(cs);
+    return m_fee_histogram;
+}
+
 bool CTxMemPool::isSpent(const COutPoint& outpoint) const
 {
     LOCK(cs);
@@ -463,6 +558,12 @@ void CTxMemPool::addUnchecked(const CTxMemPoolEntry &entry, setEntries &setAnces
     // all the appropriate checks.
     indexed_transaction_set::iterator newit = mapTx.insert(entry).first;
 
+    if (g_txid_filter) g_txid_filter->Add(entry.GetTx().GetHash());
+
+    // Stamp the entry with the current mempool sequence number, so that
+    // net_processing can tell whether it predates a peer's last INV batch.
+    mapTx.modify(newit, [seq = GetSequence()](CTxMemPoolEntry& e) { e.SetSequence(seq); });
+
     // Update transaction for any feeDelta created by PrioritiseTransaction
     CAmount delta{0};
     ApplyDelta(entry.GetTx().GetHash(), delta);
@@ -471,6 +572,7 @@ void CTxMemPool::addUnchecked(const CTxMemPoolEntry &entry, setEntries &setAnces
     if (delta) {
         mapTx.modify(newit, [&delta](CTxMemPoolEntry& e) { e.UpdateModifiedFee(delta); });
     }
+    FeeHistogramAdd(*newit);
 
     // Update cachedInnerUsage to include contained transaction's usage.
     // (When we update the entry for in-mempool parents, memory usage will be
@@ -506,6 +608,15 @@ void CTxMemPool::addUnchecked(const CTxMemPoolEntry &entry, setEntries &setAnces
 
     vTxHashes.emplace_back(tx.GetWitnessHash(), newit);
     newit->vTxHashesIdx = vTxHashes.size() - 1;
+
+    {
+        TxidShard& shard = TxidShardFor(tx.GetHash());
+        WITH_LOCK(shard.mutex, shard.txids.insert(tx.GetHash()));
+    }
+    {
+        TxidShard& shard = TxidShardFor(tx.GetWitnessHash());
+        WITH_LOCK(shard.mutex, shard.wtxids.insert(tx.GetWitnessHash()));
+    }
 }
 
 void CTxMemPool::removeUnchecked(txiter it, MemPoolRemovalReason reason)
@@ -522,7 +633,17 @@ void CTxMemPool::removeUnchecked(txiter it, MemPoolRemovalReason reason)
         GetMainSignals().TransactionRemovedFromMempool(it->GetSharedTx(), reason, mempool_sequence);
     }
 
+    FeeHistogramRemove(*it);
     const uint256 hash = it->GetTx().GetHash();
+    const uint256& wtxid = it->GetTx().GetWitnessHash();
+    {
+        TxidShard& shard = TxidShardFor(hash);
+        WITH_LOCK(shard.mutex, shard.txids.erase(hash));
+    }
+    {
+        TxidShard& shard = TxidShardFor(wtxid);
+        WITH_LOCK(shard.mutex, shard.wtxids.erase(wtxid));
+    }
     for (const CTxIn& txin : it->GetTx().vin)
         mapNextTx.erase(txin.prevout);
 
@@ -554,23 +675,27 @@ void CTxMemPool::removeUnchecked(txiter it, MemPoolRemovalReason reason)
 // can save time by not iterating over those entries.
 void CTxMemPool::CalculateDescendants(txiter entryit, setEntries& setDescendants) const
 {
-    setEntries stage;
+    WITH_FRESH_EPOCH(m_epoch);
+    std::vector<txiter> stage;
     if (setDescendants.count(entryit) == 0) {
-        stage.insert(entryit);
+        stage.push_back(entryit);
+        visited(entryit);
     }
     // Traverse down the children of entry, only adding children that are not
     // accounted for in setDescendants already (because those children have either
-    // already been walked, or will be walked in this iteration).
+    // already been walked, or will be walked in this iteration). Within this
+    // call an epoch mark replaces lookups into the staging structure, so each
+    // entry is staged at most once without per-element set inserts.
     while (!stage.empty()) {
-        txiter it = *stage.begin();
+        txiter it = stage.back();
+        stage.pop_back();
         setDescendants.insert(it);
-        stage.erase(it);
 
         const CTxMemPoolEntry::Children& children = it->GetMemPoolChildrenConst();
         for (const CTxMemPoolEntry& child : children) {
             txiter childiter = mapTx.iterator_to(child);
-            if (!setDescendants.count(childiter)) {
-                stage.insert(childiter);
+            if (!visited(childiter) && !setDescendants.count(childiter)) {
+                stage.push_back(childiter);
             }
         }
     }
@@ -677,9 +802,15 @@ void CTxMemPool::removeForBlock(const std::vector<CTransactionRef>& vtx, unsigne
 
 void CTxMemPool::_clear()
 {
+    for (TxidShard& shard : m_txid_shards) {
+        LOCK(shard.mutex);
+        shard.txids.clear();
+        shard.wtxids.clear();
+    }
     vTxHashes.clear();
     mapTx.clear();
     mapNextTx.clear();
+    m_fee_histogram = FeeHistogram{};
     totalTxSize = 0;
     m_total_fee = 0;
     cachedInnerUsage = 0;
@@ -897,6 +1028,16 @@ TxMempoolInfo CTxMemPool::info(const GenTxid& gtxid) const
     return GetInfo(i);
 }
 
+TxMempoolInfo CTxMemPool::info_for_relay(const GenTxid& gtxid, uint64_t last_sequence) const
+{
+    LOCK(cs);
+    indexed_transaction_set::const_iterator i = (gtxid.IsWtxid() ? get_iter_from_wtxid(gtxid.GetHash()) : mapTx.find(gtxid.GetHash()));
+    if (i != mapTx.end() && i->GetSequence() < last_sequence) {
+        return GetInfo(i);
+    }
+    return TxMempoolInfo();
+}
+
 void CTxMemPool::PrioritiseTransaction(const uint256& hash, const CAmount& nFeeDelta)
 {
     {
@@ -905,7 +1046,10 @@ void CTxMemPool::PrioritiseTransaction(const uint256& hash, const CAmount& nFeeD
         delta = SaturatingAdd(delta, nFeeDelta);
         txiter it = mapTx.find(hash);
         if (it != mapTx.end()) {
+            // Move the entry between histogram buckets along with its fee.
+            FeeHistogramRemove(*it);
             mapTx.modify(it, [&nFeeDelta](CTxMemPoolEntry& e) { e.UpdateModifiedFee(nFeeDelta); });
+            FeeHistogramAdd(*it);
             // Now update all ancestors' modified fees with descendants
             setEntries setAncestors;
             uint64_t nNoLimit = std::numeric_limits<uint64_t>::max();
@@ -1197,3 +1341,16 @@ void CTxMemPool::SetLoadTried(bool load_tried)
     LOCK(cs);
     m_load_tried = load_tried;
 }
+
+void CTxMemPool::SetLoadProgress(uint64_t processed, uint64_t total)
+{
+    m_load_processed = processed;
+    m_load_total = total;
+}
+
+double CTxMemPool::GetLoadProgress() const
+{
+    const uint64_t total{m_load_total};
+    if (total == 0) return 1.0;
+    return std::min(1.0, static_cast<double>(m_load_processed) / static_cast<double>(total));
+}
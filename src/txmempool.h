@@ -6,11 +6,13 @@
 #ifndef CORAL_TXMEMPOOL_H
 #define CORAL_TXMEMPOOL_H
 
+#include <array>
 #include <atomic>
 #include <map>
 #include <optional>
 #include <set>
 #include <string>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
@@ -73,6 +75,16 @@ struct CompareIteratorByHash {
     }
 };
 
+/**
+ * If the transaction's scripts or witness data carry noticeable allocation
+ * slack (growth headroom left behind by push_back-style construction),
+ * return a compactly reallocated copy to store in the mempool; otherwise
+ * return the input unchanged. The copy is byte-identical, so txid and wtxid
+ * are unaffected. The mempool holds transactions for hours, so trimming
+ * slack once on admission pays for itself in resident memory.
+ */
+CTransactionRef CompactTransactionForMempool(const CTransactionRef& tx);
+
 /** \class CTxMemPoolEntry
  *
  * CTxMemPoolEntry stores data about the corresponding transaction, as well
@@ -106,6 +118,7 @@ private:
     const int64_t sigOpCost;        //!< Total sigop cost
     CAmount m_modified_fee;         //!< Used for determining the priority of the transaction for mining in a block
     LockPoints lockPoints;     //!< Track the height and time at which tx was final
+    uint64_t m_sequence{0};    //!< The mempool sequence number when this entry was added
 
     // Information about descendants of this transaction that are in the
     // mempool; if we remove this transaction we must remove all of these
@@ -146,6 +159,9 @@ public:
     void UpdateModifiedFee(CAmount fee_diff);
     // Update the LockPoints after a reorg
     void UpdateLockPoints(const LockPoints& lp);
+    // Set by CTxMemPool::addUnchecked when the entry is inserted
+    void SetSequence(uint64_t sequence) { m_sequence = sequence; }
+    uint64_t GetSequence() const { return m_sequence; }
 
     uint64_t GetCountWithDescendants() const { return nCountWithDescendants; }
     uint64_t GetSizeWithDescendants() const { return nSizeWithDescendants; }
@@ -430,6 +446,20 @@ enum class MemPoolRemovalReason {
  */
 class CTxMemPool
 {
+public:
+    //! Number of log-scale buckets in the fee-rate histogram. Bucket 0 holds
+    //! rates below 1 sat/vB; each further bucket spans a factor of sqrt(2).
+    static constexpr size_t FEE_HISTOGRAM_BUCKETS{48};
+
+    /** Per-bucket totals of the always-current fee-rate histogram, maintained
+     * incrementally on add/remove so reading it never touches mapTx. Rates
+     * are modified fee rates (i.e. including prioritisetransaction deltas). */
+    struct FeeHistogram {
+        std::array<uint64_t, FEE_HISTOGRAM_BUCKETS> count{};
+        std::array<uint64_t, FEE_HISTOGRAM_BUCKETS> vsize{};
+        std::array<CAmount, FEE_HISTOGRAM_BUCKETS> fee{};
+    };
+
 protected:
     const int m_check_ratio; //!< Value n means that 1 times in n we check.
     std::atomic<unsigned int> nTransactionsUpdated{0}; //!< Used by getblocktemplate to trigger CreateNewBlock() invocation
@@ -438,6 +468,10 @@ protected:
     uint64_t totalTxSize GUARDED_BY(cs);      //!< sum of all mempool tx's virtual sizes. Differs from serialized tx size since witness data is discounted. Defined in BIP 141.
     CAmount m_total_fee GUARDED_BY(cs);       //!< sum of all mempool tx's fees (NOT modified fee)
     uint64_t cachedInnerUsage GUARDED_BY(cs); //!< sum of dynamic memory usage of all the map elements (NOT the maps themselves)
+    FeeHistogram m_fee_histogram GUARDED_BY(cs); //!< per-bucket totals over all mempool entries, kept current by add/remove/prioritise
+
+    void FeeHistogramAdd(const CTxMemPoolEntry& entry) EXCLUSIVE_LOCKS_REQUIRED(cs);
+    void FeeHistogramRemove(const CTxMemPoolEntry& entry) EXCLUSIVE_LOCKS_REQUIRED(cs);
 
     mutable int64_t lastRollingFeeUpdate GUARDED_BY(cs);
     mutable bool blockSinceLastRollingFeeBump GUARDED_BY(cs);
@@ -453,6 +487,35 @@ protected:
 
     bool m_load_tried GUARDED_BY(cs){false};
 
+    //! Progress of the initial mempool load from disk: transactions processed
+    //! so far and the total recorded in the dump file. Atomic so that
+    //! getblocktemplate can report progress while the loader is busy inside
+    //! the pool's critical sections.
+    std::atomic<uint64_t> m_load_processed{0};
+    std::atomic<uint64_t> m_load_total{0};
+
+    //! Number of shards of the txid/wtxid presence index. Must be a power of two.
+    static constexpr size_t NUM_TXID_SHARDS{16};
+
+    /**
+     * Sharded presence index of the txids and wtxids currently in the pool,
+     * maintained alongside mapTx (within the same cs critical sections). It
+     * lets exists() -- the hottest read, called for every inv during relay --
+     * answer from a briefly-held per-shard lock instead of contending on cs
+     * with ATMP and RPC.
+     */
+    struct TxidShard {
+        mutable Mutex mutex;
+        std::unordered_set<uint256, SaltedTxidHasher> txids GUARDED_BY(mutex);
+        std::unordered_set<uint256, SaltedTxidHasher> wtxids GUARDED_BY(mutex);
+    };
+    mutable std::array<TxidShard, NUM_TXID_SHARDS> m_txid_shards;
+
+    TxidShard& TxidShardFor(const uint256& hash) const
+    {
+        return m_txid_shards[*(hash.begin() + 31) & (NUM_TXID_SHARDS - 1)];
+    }
+
     CFeeRate GetMinFee(size_t sizelimit) const;
 
 public:
@@ -746,6 +809,15 @@ public:
      */
     void SetLoadTried(bool load_tried);
 
+    /** Record progress of the initial mempool load from disk. */
+    void SetLoadProgress(uint64_t processed, uint64_t total);
+
+    /**
+     * Progress of the initial mempool load as a fraction in [0,1]. Returns 1
+     * when no load is in progress or the dump was empty.
+     */
+    double GetLoadProgress() const;
+
     unsigned long size() const
     {
         LOCK(cs);
@@ -766,11 +838,12 @@ public:
 
     bool exists(const GenTxid& gtxid) const
     {
-        LOCK(cs);
+        const TxidShard& shard = TxidShardFor(gtxid.GetHash());
+        LOCK(shard.mutex);
         if (gtxid.IsWtxid()) {
-            return (mapTx.get<index_by_wtxid>().count(gtxid.GetHash()) != 0);
+            return shard.wtxids.count(gtxid.GetHash()) != 0;
         }
-        return (mapTx.count(gtxid.GetHash()) != 0);
+        return shard.txids.count(gtxid.GetHash()) != 0;
     }
 
     CTransactionRef get(const uint256& hash) const;
@@ -780,8 +853,20 @@ public:
         return mapTx.project<0>(mapTx.get<index_by_wtxid>().find(wtxid));
     }
     TxMempoolInfo info(const GenTxid& gtxid) const;
+
+    /** Returns info for a transaction if its entry sequence is lower than
+     * last_sequence, i.e. if it entered the mempool before that sequence
+     * number was observed. */
+    TxMempoolInfo info_for_relay(const GenTxid& gtxid, uint64_t last_sequence) const;
     std::vector<TxMempoolInfo> infoAll() const;
 
+    //! Histogram bucket for a transaction paying `fee` over `vsize` vbytes.
+    static size_t FeeHistogramBucketIndex(CAmount fee, size_t vsize);
+    //! Lower fee-rate bound of a histogram bucket, in sat/vB.
+    static double FeeHistogramBucketLow(size_t index);
+
+    FeeHistogram GetFeeHistogram() const EXCLUSIVE_LOCKS_REQUIRED(!cs);
+
     size_t DynamicMemoryUsage() const;
 
     /** Adds a transaction to the unbroadcast set */
@@ -599,6 +599,11 @@ public:
         // Move time.
         SetTimePoint(now, expired);
 
+        // Most peers have no announcements at all at any given time. Skip the
+        // ByPeer index probe for them; SetTimePoint above has already done all
+        // the required state transitions.
+        if (m_peerinfo.count(peer) == 0) return {};
+
         // Find all CANDIDATE_BEST announcements for this peer.
         std::vector<const Announcement*> selected;
         auto it_peer = m_index.get<ByPeer>().lower_bound(ByPeerView{peer, true, uint256::ZERO});
@@ -7,6 +7,7 @@
 #define CORAL_UINT256_H
 
 #include <crypto/common.h>
+#include <serialize.h>
 #include <span.h>
 
 #include <assert.h>
@@ -125,6 +126,13 @@ public:
     static const uint256 ONE;
 };
 
+/* Opaque blobs serialize as their raw bytes, so they (and contiguous arrays
+ * of them, e.g. block locators and merkle branches) can be copied wholesale. */
+template<> struct TriviallySerializable<uint160> : std::true_type {};
+template<> struct TriviallySerializable<uint256> : std::true_type {};
+static_assert(std::has_unique_object_representations_v<uint160>);
+static_assert(std::has_unique_object_representations_v<uint256>);
+
 /* uint256 from const char *.
  * This is a separate function because the constructor uint256(const char*) can result
  * in dangerously catching uint256(0).
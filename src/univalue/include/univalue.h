@@ -20,9 +20,9 @@ public:
     enum VType { VNULL, VOBJ, VARR, VSTR, VNUM, VBOOL, };
 
     UniValue() { typ = VNULL; }
-    UniValue(UniValue::VType initialType, const std::string& initialStr = "") {
+    UniValue(UniValue::VType initialType, std::string initialStr = "") {
         typ = initialType;
-        val = initialStr;
+        val = std::move(initialStr);
     }
     template <typename Ref, typename T = std::remove_cv_t<std::remove_reference_t<Ref>>,
               std::enable_if_t<std::is_floating_point_v<T> ||                      // setFloat
@@ -49,15 +49,27 @@ public:
 
     void setNull();
     void setBool(bool val);
-    void setNumStr(const std::string& val);
+    void setNumStr(std::string val);
     void setInt(uint64_t val);
     void setInt(int64_t val);
     void setInt(int val_) { return setInt(int64_t{val_}); }
     void setFloat(double val);
-    void setStr(const std::string& val);
+    void setStr(std::string val);
     void setArray();
     void setObject();
 
+    /** Reserve capacity for n array entries or object members, to avoid
+     *  vector reallocations while building large responses. No-op for
+     *  scalar values. */
+    void reserve(size_t n) {
+        if (typ == VOBJ) {
+            keys.reserve(n);
+        }
+        if (typ == VOBJ || typ == VARR) {
+            values.reserve(n);
+        }
+    }
+
     enum VType getType() const { return typ; }
     const std::string& getValStr() const { return val; }
     bool empty() const { return (values.size() == 0); }
@@ -44,7 +44,7 @@ static bool validNumStr(const std::string& s)
     return (tt == JTOK_NUMBER);
 }
 
-void UniValue::setNumStr(const std::string& val_)
+void UniValue::setNumStr(std::string val_)
 {
     if (!validNumStr(val_)) {
         throw std::runtime_error{"The string '" + val_ + "' is not a valid JSON number"};
@@ -52,7 +52,7 @@ void UniValue::setNumStr(const std::string& val_)
 
     clear();
     typ = VNUM;
-    val = val_;
+    val = std::move(val_);
 }
 
 void UniValue::setInt(uint64_t val_)
@@ -82,11 +82,11 @@ void UniValue::setFloat(double val_)
     return setNumStr(oss.str());
 }
 
-void UniValue::setStr(const std::string& val_)
+void UniValue::setStr(std::string val_)
 {
     clear();
     typ = VSTR;
-    val = val_;
+    val = std::move(val_);
 }
 
 void UniValue::setArray()
@@ -11,6 +11,8 @@
 #include <util/system.h>
 #include <util/time.h>
 
+#include <algorithm>
+#include <array>
 #include <memory>
 #include <stdexcept>
 #include <string>
@@ -56,6 +58,34 @@ ssize_t Sock::Send(const void* data, size_t len, int flags) const
     return send(m_socket, static_cast<const char*>(data), len, flags);
 }
 
+ssize_t Sock::SendMany(Span<const Span<const unsigned char>> buffers, int flags) const
+{
+    if (buffers.empty()) return 0;
+#ifdef WIN32
+    // No sendmsg(2) on Windows: emulate the vectored send with one send(2)
+    // per buffer, stopping at the first partial or failed send.
+    ssize_t total{0};
+    for (const auto& buffer : buffers) {
+        const ssize_t sent{Send(buffer.data(), buffer.size(), flags)};
+        if (sent < 0) return total > 0 ? total : sent;
+        total += sent;
+        if (static_cast<size_t>(sent) < buffer.size()) break;
+    }
+    return total;
+#else
+    std::array<iovec, 64> iov;
+    const size_t num_buffers{std::min(buffers.size(), iov.size())};
+    for (size_t i = 0; i < num_buffers; ++i) {
+        iov[i].iov_base = const_cast<unsigned char*>(buffers[i].data());
+        iov[i].iov_len = buffers[i].size();
+    }
+    msghdr msg{};
+    msg.msg_iov = iov.data();
+    msg.msg_iovlen = num_buffers;
+    return sendmsg(m_socket, &msg, flags);
+#endif
+}
+
 ssize_t Sock::Recv(void* buf, size_t len, int flags) const
 {
     return recv(m_socket, static_cast<char*>(buf), len, flags);
@@ -6,6 +6,7 @@
 #define CORAL_UTIL_SOCK_H
 
 #include <compat/compat.h>
+#include <span.h>
 #include <threadinterrupt.h>
 #include <util/time.h>
 
@@ -74,6 +75,16 @@ public:
      */
     [[nodiscard]] virtual ssize_t Send(const void* data, size_t len, int flags) const;
 
+    /**
+     * Vectored send. Sends the given buffers with a single sendmsg(2) syscall
+     * where the platform supports it, falling back to a plain `Send()` of the
+     * first buffer otherwise (callers retry with the remainder). Code that uses
+     * this wrapper can be unit tested if this method is overridden by a mock
+     * Sock implementation.
+     * @return the total number of bytes sent, or -1 on error.
+     */
+    [[nodiscard]] virtual ssize_t SendMany(Span<const Span<const unsigned char>> buffers, int flags) const;
+
     /**
      * recv(2) wrapper. Equivalent to `recv(this->Get(), buf, len, flags);`. Code that uses this
      * wrapper can be unit tested if this method is overridden by a mock Sock implementation.
@@ -3,6 +3,11 @@
 // Distributed under the MIT software license, see the accompanying
 // file COPYING or http://www.opensource.org/licenses/mit-license.php.
 
+#if defined(HAVE_CONFIG_H)
+#include <config/coral-config.h>
+#endif
+
+#include <compat/cpuid.h>
 #include <span.h>
 #include <util/strencodings.h>
 
@@ -15,6 +20,67 @@
 #include <string>
 #include <vector>
 
+#if defined(ENABLE_AVX2) && !defined(BUILD_CORAL_INTERNAL)
+namespace hex_avx2
+{
+void Encode(const unsigned char* in, char* out, size_t blocks);
+size_t Decode(const char* in, unsigned char* out, size_t blocks);
+}
+#endif
+
+namespace
+{
+typedef void (*HexEncodeFn)(const unsigned char* in, char* out, size_t blocks);
+typedef size_t (*HexDecodeFn)(const char* in, unsigned char* out, size_t blocks);
+
+/** Bulk hex kernels selected by HexAutoDetect(), if any. They process
+ * 32-byte/64-character blocks; the callers handle tails (and, for decoding,
+ * whitespace and invalid input) with the byte-at-a-time code. */
+HexEncodeFn g_hex_encode{nullptr};
+HexDecodeFn g_hex_decode{nullptr};
+
+#if defined(USE_ASM) && (defined(__x86_64__) || defined(__amd64__) || defined(__i386__))
+/** Check whether the OS has enabled AVX registers. */
+bool AVXEnabled()
+{
+    uint32_t a, d;
+    __asm__("xgetbv" : "=a"(a), "=d"(d) : "c"(0));
+    return (a & 6) == 6;
+}
+#endif
+} // namespace
+
+std::string HexAutoDetect()
+{
+    std::string ret = "standard";
+#if defined(USE_ASM) && defined(HAVE_GETCPUID)
+    [[maybe_unused]] bool have_avx2 = false;
+    [[maybe_unused]] bool enabled_avx = false;
+
+    uint32_t eax, ebx, ecx, edx;
+    GetCPUID(1, 0, eax, ebx, ecx, edx);
+    const bool have_xsave = (ecx >> 27) & 1;
+    const bool have_avx = (ecx >> 28) & 1;
+    if (have_xsave && have_avx) {
+        enabled_avx = AVXEnabled();
+    }
+    if (have_avx) {
+        GetCPUID(7, 0, eax, ebx, ecx, edx);
+        have_avx2 = (ebx >> 5) & 1;
+    }
+
+#if defined(ENABLE_AVX2) && !defined(BUILD_CORAL_INTERNAL)
+    if (have_avx2 && enabled_avx) {
+        g_hex_encode = hex_avx2::Encode;
+        g_hex_decode = hex_avx2::Decode;
+        ret = "avx2";
+    }
+#endif
+#endif // defined(USE_ASM) && defined(HAVE_GETCPUID)
+
+    return ret;
+}
+
 static const std::string CHARS_ALPHA_NUM = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789";
 
 static const std::string SAFE_CHARS[] =
@@ -82,6 +148,16 @@ std::vector<Byte> ParseHex(std::string_view str)
 {
     std::vector<Byte> vch;
     auto it = str.begin();
+    if (g_hex_decode && str.end() - it >= 64) {
+        // Bulk-decode while the input consists of whole valid blocks; the
+        // loop below handles whitespace, invalid characters and the tail
+        // exactly as before.
+        const size_t blocks = (str.end() - it) / 64;
+        vch.resize(blocks * 32);
+        const size_t done = g_hex_decode(&*it, reinterpret_cast<unsigned char*>(vch.data()), blocks);
+        vch.resize(done * 32);
+        it += done * 64;
+    }
     while (it != str.end() && it + 1 != str.end()) {
         if (IsSpace(*it)) {
             ++it;
@@ -480,8 +556,16 @@ std::string HexStr(const Span<const uint8_t> s)
     static_assert(sizeof(byte_to_hex) == 512);
 
     char* it = rv.data();
-    for (uint8_t v : s) {
-        std::memcpy(it, byte_to_hex[v].data(), 2);
+    const uint8_t* data = s.data();
+    const uint8_t* end = data + s.size();
+    if (g_hex_encode) {
+        const size_t blocks = s.size() / 32;
+        g_hex_encode(data, it, blocks);
+        data += blocks * 32;
+        it += blocks * 64;
+    }
+    while (data != end) {
+        std::memcpy(it, byte_to_hex[*data++].data(), 2);
         it += 2;
     }
 
@@ -216,6 +216,10 @@ std::optional<T> ToIntegral(std::string_view str)
  */
 [[nodiscard]] bool ParseUInt64(std::string_view str, uint64_t *out);
 
+/** Select the best available bulk hex encode/decode implementation for
+ * HexStr() and ParseHex(), and return its name. */
+std::string HexAutoDetect();
+
 /**
  * Convert a span of bytes to a lower-case hexadecimal string.
  */
@@ -1274,9 +1274,11 @@ void AllocateFileRange(FILE *file, unsigned int offset, unsigned int length) {
     ftruncate(fileno(file), static_cast<off_t>(offset) + length);
 #else
     #if defined(HAVE_POSIX_FALLOCATE)
-    // Version using posix_fallocate
-    off_t nEndPos = (off_t)offset + length;
-    if (0 == posix_fallocate(fileno(file), 0, nEndPos)) return;
+    // Version using posix_fallocate. Only the newly added range is passed,
+    // so repeated grows of the same file do not re-examine (or, on
+    // filesystems without a fast allocation path, re-write) what was
+    // already allocated.
+    if (0 == posix_fallocate(fileno(file), (off_t)offset, (off_t)length)) return;
     #endif
     // Fallback version
     // TODO: just write one byte per block
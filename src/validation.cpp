@@ -13,6 +13,7 @@
 #include <chain.h>
 #include <chainparams.h>
 #include <checkqueue.h>
+#include <coinsjournal.h>
 #include <consensus/amount.h>
 #include <consensus/consensus.h>
 #include <consensus/merkle.h>
@@ -25,9 +26,11 @@
 #include <hash.h>
 #include <logging.h>
 #include <logging/timer.h>
+#include <node/blockring.h>
 #include <node/blockstorage.h>
 #include <node/interface_ui.h>
 #include <node/utxo_snapshot.h>
+#include <perfstats.h>
 #include <policy/policy.h>
 #include <policy/rbf.h>
 #include <policy/settings.h>
@@ -51,6 +54,8 @@
 #include <util/rbf.h>
 #include <util/strencodings.h>
 #include <util/system.h>
+#include <util/thread.h>
+#include <util/threadnames.h>
 #include <util/time.h>
 #include <util/trace.h>
 #include <util/translation.h>
@@ -60,10 +65,14 @@
 #include <algorithm>
 #include <cassert>
 #include <chrono>
+#include <condition_variable>
 #include <deque>
+#include <future>
+#include <mutex>
 #include <numeric>
 #include <optional>
 #include <string>
+#include <thread>
 
 using kernel::CCoinsStats;
 using kernel::CoinStatsHashType;
@@ -108,6 +117,9 @@ const std::vector<std::string> CHECKLEVEL_DOC {
  *  noticeably interfere with the pruning mechanism.
  * */
 static constexpr int PRUNE_LOCK_BUFFER{10};
+/** Minimum number of transactions in a block before its signature hash
+ * precomputation is batched over worker threads in ConnectBlock(). */
+static constexpr size_t MIN_PARALLEL_PRECOMPUTE_TXS{32};
 
 /**
  * Mutex to guard access to validation specific variables, such as reading
@@ -460,6 +472,12 @@ public:
          * policies such as mempool min fee and min relay fee.
          */
         const bool m_package_feerates;
+        /** When true, skip script execution entirely (both policy and consensus script checks).
+         * Only sound when replaying transactions this node itself validated against the same tip,
+         * i.e. when reloading our own mempool dump and the chain has not advanced since it was
+         * written. All other checks (inputs available, fees, policy limits) still run.
+         */
+        const bool m_skip_script_checks;
 
         /** Parameters for single transaction mempool validation. */
         static ATMPArgs SingleAccept(const CChainParams& chainparams, int64_t accept_time,
@@ -473,6 +491,24 @@ public:
                             /* m_allow_replacement */ true,
                             /* m_package_submission */ false,
                             /* m_package_feerates */ false,
+                            /* m_skip_script_checks */ false,
+            };
+        }
+
+        /** Parameters for replaying our own mempool dump against an unchanged tip. Scripts were
+         * already executed by this node when the transactions first entered the mempool, so
+         * re-execution is skipped. */
+        static ATMPArgs SingleReplayAccept(const CChainParams& chainparams, int64_t accept_time,
+                                           std::vector<COutPoint>& coins_to_uncache) {
+            return ATMPArgs{/* m_chainparams */ chainparams,
+                            /* m_accept_time */ accept_time,
+                            /* m_bypass_limits */ false,
+                            /* m_coins_to_uncache */ coins_to_uncache,
+                            /* m_test_accept */ false,
+                            /* m_allow_replacement */ true,
+                            /* m_package_submission */ false,
+                            /* m_package_feerates */ false,
+                            /* m_skip_script_checks */ true,
             };
         }
 
@@ -487,6 +523,7 @@ public:
                             /* m_allow_replacement */ false,
                             /* m_package_submission */ false, // not submitting to mempool
                             /* m_package_feerates */ false,
+                            /* m_skip_script_checks */ false,
             };
         }
 
@@ -501,6 +538,7 @@ public:
                             /* m_allow_replacement */ false,
                             /* m_package_submission */ true,
                             /* m_package_feerates */ true,
+                            /* m_skip_script_checks */ false,
             };
         }
 
@@ -514,6 +552,7 @@ public:
                             /* m_allow_replacement */ true,
                             /* m_package_submission */ false,
                             /* m_package_feerates */ false, // only 1 transaction
+                            /* m_skip_script_checks */ false,
             };
         }
 
@@ -527,7 +566,8 @@ public:
                  bool test_accept,
                  bool allow_replacement,
                  bool package_submission,
-                 bool package_feerates)
+                 bool package_feerates,
+                 bool skip_script_checks)
             : m_chainparams{chainparams},
               m_accept_time{accept_time},
               m_bypass_limits{bypass_limits},
@@ -535,7 +575,8 @@ public:
               m_test_accept{test_accept},
               m_allow_replacement{allow_replacement},
               m_package_submission{package_submission},
-              m_package_feerates{package_feerates}
+              m_package_feerates{package_feerates},
+              m_skip_script_checks{skip_script_checks}
         {
         }
     };
@@ -834,7 +875,9 @@ bool MemPoolAccept::PreChecks(ATMPArgs& args, Workspace& ws)
         }
     }
 
-    entry.reset(new CTxMemPoolEntry(ptx, ws.m_base_fees, nAcceptTime, m_active_chainstate.m_chain.Height(),
+    // The mempool may hold the transaction for a long time; store a compactly
+    // reallocated copy if the relayed one carries allocation slack.
+    entry.reset(new CTxMemPoolEntry(CompactTransactionForMempool(ptx), ws.m_base_fees, nAcceptTime, m_active_chainstate.m_chain.Height(),
             fSpendsCoinbase, nSigOpsCost, lp));
     ws.m_vsize = entry->GetTxSize();
 
@@ -989,6 +1032,7 @@ bool MemPoolAccept::PolicyScriptChecks(const ATMPArgs& args, Workspace& ws)
 {
     AssertLockHeld(cs_main);
     AssertLockHeld(m_pool.cs);
+    if (args.m_skip_script_checks) return true;
     const CTransaction& tx = *ws.m_ptx;
     TxValidationState& state = ws.m_state;
 
@@ -1017,6 +1061,7 @@ bool MemPoolAccept::ConsensusScriptChecks(const ATMPArgs& args, Workspace& ws)
 {
     AssertLockHeld(cs_main);
     AssertLockHeld(m_pool.cs);
+    if (args.m_skip_script_checks) return true;
     const CTransaction& tx = *ws.m_ptx;
     const uint256& hash = ws.m_hash;
     TxValidationState& state = ws.m_state;
@@ -1439,6 +1484,75 @@ MempoolAcceptResult AcceptToMemoryPool(Chainstate& active_chainstate, const CTra
     return result;
 }
 
+/** Run the script checks of a batch of transactions in parallel on the
+ * script-check worker threads with the signature-cache store enabled, so that
+ * a subsequent serial validation of the same transactions hits the cache
+ * instead of verifying signatures again. Inputs must already be in the coins
+ * cache; transactions spending outputs not in the UTXO set (e.g. in-batch
+ * parents) are left entirely to the serial path. Check failures are ignored
+ * here: the serial path re-runs the scripts and reports the proper rejection.
+ * Defined below, next to the script check queue it uses. */
+static void PrewarmScriptCaches(Chainstate& active_chainstate, const std::vector<std::pair<CTransactionRef, int64_t>>& txns) EXCLUSIVE_LOCKS_REQUIRED(::cs_main);
+
+std::vector<MempoolAcceptResult> AcceptToMemoryPoolBatch(Chainstate& active_chainstate,
+                                                         const std::vector<std::pair<CTransactionRef, int64_t>>& txns,
+                                                         bool bypass_limits,
+                                                         bool skip_script_checks)
+{
+    AssertLockHeld(::cs_main);
+    const CChainParams& chainparams{active_chainstate.m_params};
+    assert(active_chainstate.GetMempool() != nullptr);
+    CTxMemPool& pool{*active_chainstate.GetMempool()};
+    CCoinsViewCache& coins_tip{active_chainstate.CoinsTip()};
+
+    // Warm the coins cache with every input of the batch in one pass, so each
+    // transaction's validation hits the cache instead of fetching its inputs
+    // from the database one transaction at a time. Track what the warming
+    // added, so coins belonging to rejected transactions can be evicted again
+    // (the same memory-DoS protection the single-transaction path has).
+    std::vector<std::vector<COutPoint>> warmed(txns.size());
+    for (size_t i = 0; i < txns.size(); ++i) {
+        for (const CTxIn& txin : txns[i].first->vin) {
+            if (!coins_tip.HaveCoinInCache(txin.prevout)) {
+                warmed[i].push_back(txin.prevout);
+                coins_tip.AccessCoin(txin.prevout);
+            }
+        }
+    }
+
+    // When scripts do have to be executed, verify independent transactions
+    // concurrently on the script-check workers first; the serial acceptance
+    // below then validates against a warm signature cache.
+    if (!skip_script_checks && txns.size() > 1) {
+        PrewarmScriptCaches(active_chainstate, txns);
+    }
+
+    std::vector<MempoolAcceptResult> results;
+    results.reserve(txns.size());
+    for (size_t i = 0; i < txns.size(); ++i) {
+        const auto& [tx, accept_time] = txns[i];
+        std::vector<COutPoint> coins_to_uncache;
+        auto args = skip_script_checks ?
+            MemPoolAccept::ATMPArgs::SingleReplayAccept(chainparams, accept_time, coins_to_uncache) :
+            MemPoolAccept::ATMPArgs::SingleAccept(chainparams, accept_time, bypass_limits, coins_to_uncache, /*test_accept=*/false);
+        results.push_back(MemPoolAccept(pool, active_chainstate).AcceptSingleTransaction(tx, args));
+        if (results.back().m_result_type != MempoolAcceptResult::ResultType::VALID) {
+            for (const COutPoint& outpoint : coins_to_uncache) {
+                coins_tip.Uncache(outpoint);
+            }
+            for (const COutPoint& outpoint : warmed[i]) {
+                coins_tip.Uncache(outpoint);
+            }
+        }
+    }
+
+    // A single cache-limit check for the whole batch, instead of one per
+    // transaction as the single-transaction path does.
+    BlockValidationState state_dummy;
+    active_chainstate.FlushStateToDisk(state_dummy, FlushStateMode::PERIODIC);
+    return results;
+}
+
 PackageMempoolAcceptResult ProcessNewPackage(Chainstate& active_chainstate, CTxMemPool& pool,
                                                    const Package& package, bool test_accept)
 {
@@ -1666,7 +1780,13 @@ bool CScriptCheck::operator()() {
 }
 
 static CuckooCache::cache<uint256, SignatureCacheHasher> g_scriptExecutionCache;
+//! Per-input script execution cache, keyed by (txid, input index, witness,
+//! flags). Unlike g_scriptExecutionCache it survives changes to the rest of
+//! the transaction's witness data, so inputs whose own witness is unchanged
+//! between transaction variants skip re-execution.
+static CuckooCache::cache<uint256, SignatureCacheHasher> g_inputScriptExecutionCache;
 static CSHA256 g_scriptExecutionCacheHasher;
+static size_t g_script_execution_cache_bytes{0};
 
 bool InitScriptExecutionCache(size_t max_size_bytes)
 {
@@ -1678,15 +1798,41 @@ bool InitScriptExecutionCache(size_t max_size_bytes)
     g_scriptExecutionCacheHasher.Write(nonce.begin(), 32);
     g_scriptExecutionCacheHasher.Write(nonce.begin(), 32);
 
-    auto setup_results = g_scriptExecutionCache.setup_bytes(max_size_bytes);
+    // Split the budget between the whole-transaction cache and the per-input
+    // cache; entries are the same size, but the per-input cache holds one
+    // entry per input rather than one per transaction.
+    auto setup_results = g_scriptExecutionCache.setup_bytes(max_size_bytes / 2);
     if (!setup_results) return false;
+    auto input_setup_results = g_inputScriptExecutionCache.setup_bytes(max_size_bytes - max_size_bytes / 2);
+    if (!input_setup_results) return false;
 
     const auto [num_elems, approx_size_bytes] = *setup_results;
-    LogPrintf("Using %zu MiB out of %zu MiB requested for script execution cache, able to store %zu elements\n",
-              approx_size_bytes >> 20, max_size_bytes >> 20, num_elems);
+    const auto [input_num_elems, input_approx_size_bytes] = *input_setup_results;
+    g_script_execution_cache_bytes = approx_size_bytes + input_approx_size_bytes;
+    LogPrintf("Using %zu MiB out of %zu MiB requested for script execution cache, able to store %zu transaction and %zu input elements\n",
+              (approx_size_bytes + input_approx_size_bytes) >> 20, max_size_bytes >> 20, num_elems, input_num_elems);
     return true;
 }
 
+size_t ScriptExecutionCacheBytes()
+{
+    return g_script_execution_cache_bytes;
+}
+
+CuckooCache::Stats GetScriptExecutionCacheStats()
+{
+    // The cache requires no concurrent writes during a read; inserts happen
+    // under cs_main (see CheckInputScripts), so holding it here suffices.
+    LOCK(cs_main);
+    CuckooCache::Stats ret{g_scriptExecutionCache.get_stats()};
+    const CuckooCache::Stats input_stats{g_inputScriptExecutionCache.get_stats()};
+    ret.hits += input_stats.hits;
+    ret.misses += input_stats.misses;
+    ret.max_elements += input_stats.max_elements;
+    ret.occupied += input_stats.occupied;
+    return ret;
+}
+
 /**
  * Check whether all of this transaction's input scripts succeed.
  *
@@ -1727,8 +1873,10 @@ bool CheckInputScripts(const CTransaction& tx, TxValidationState& state,
     hasher.Write(tx.GetWitnessHash().begin(), 32).Write((unsigned char*)&flags, sizeof(flags)).Finalize(hashCacheEntry.begin());
     AssertLockHeld(cs_main); //TODO: Remove this requirement by making CuckooCache not require external locks
     if (g_scriptExecutionCache.contains(hashCacheEntry, !cacheFullScriptStore)) {
+        perf::Bump(perf::GetCounters().script_cache_hits);
         return true;
     }
+    perf::Bump(perf::GetCounters().script_cache_misses);
 
     if (!txdata.m_spent_outputs_ready) {
         std::vector<CTxOut> spent_outputs;
@@ -1752,6 +1900,28 @@ bool CheckInputScripts(const CTransaction& tx, TxValidationState& state,
         // failures through additional data in, eg, the coins being
         // spent being checked as a part of CScriptCheck.
 
+        // An input's execution outcome depends only on the transaction's
+        // non-witness data (its txid, which also commits to the outpoint and
+        // thus the coin fetched from the inputs view), this input's own
+        // witness, and the flags. Key the per-input cache on exactly those,
+        // so inputs verified earlier are skipped even when other inputs'
+        // witnesses have changed in the meantime.
+        uint256 input_cache_entry;
+        {
+            CHashWriter witness_hasher{SER_GETHASH, 0};
+            witness_hasher << tx.vin[i].scriptWitness.stack;
+            const uint256 witness_hash{witness_hasher.GetSHA256()};
+            CSHA256 input_hasher = g_scriptExecutionCacheHasher;
+            input_hasher.Write(tx.GetHash().begin(), 32)
+                        .Write(witness_hash.begin(), 32)
+                        .Write((unsigned char*)&i, sizeof(i))
+                        .Write((unsigned char*)&flags, sizeof(flags))
+                        .Finalize(input_cache_entry.begin());
+        }
+        if (g_inputScriptExecutionCache.contains(input_cache_entry, !cacheFullScriptStore)) {
+            continue;
+        }
+
         // Verify signature
         CScriptCheck check(txdata.m_spent_outputs[i], tx, i, flags, cacheSigStore, &txdata);
         if (pvChecks) {
@@ -1783,6 +1953,10 @@ bool CheckInputScripts(const CTransaction& tx, TxValidationState& state,
             // such errors).
             return state.Invalid(TxValidationResult::TX_CONSENSUS, strprintf("mandatory-script-verify-flag-failed (%s)", ScriptErrorString(check.GetScriptError())));
         }
+
+        if (cacheFullScriptStore && !pvChecks) {
+            g_inputScriptExecutionCache.insert(input_cache_entry);
+        }
     }
 
     if (cacheFullScriptStore && !pvChecks) {
@@ -1835,24 +2009,68 @@ int ApplyTxInUndo(Coin&& undo, CCoinsViewCache& view, const COutPoint& out)
     return fClean ? DISCONNECT_OK : DISCONNECT_UNCLEAN;
 }
 
+void Chainstate::CacheBlockUndo(const uint256& block_hash, CBlockUndo&& undo)
+{
+    AssertLockHeld(::cs_main);
+    const size_t max_bytes{static_cast<size_t>(std::max<int64_t>(0, gArgs.GetIntArg("-maxreorgcache", DEFAULT_MAX_REORG_CACHE_MB))) << 20};
+    const size_t undo_bytes{::GetSerializeSize(undo, CLIENT_VERSION)};
+    if (undo_bytes > max_bytes) return;
+    const auto [it, inserted] = m_recent_undo.try_emplace(block_hash, std::move(undo));
+    if (!inserted) return;
+    m_recent_undo_order.push_back(block_hash);
+    m_recent_undo_bytes += undo_bytes;
+    while (m_recent_undo_bytes > max_bytes && !m_recent_undo_order.empty()) {
+        const auto oldest{m_recent_undo.find(m_recent_undo_order.front())};
+        m_recent_undo_order.pop_front();
+        // The entry may already have been taken by a disconnect; the stale
+        // hash in the eviction order is simply skipped.
+        if (oldest == m_recent_undo.end()) continue;
+        m_recent_undo_bytes -= ::GetSerializeSize(oldest->second, CLIENT_VERSION);
+        m_recent_undo.erase(oldest);
+    }
+}
+
+std::optional<CBlockUndo> Chainstate::TakeCachedBlockUndo(const uint256& block_hash)
+{
+    AssertLockHeld(::cs_main);
+    const auto it{m_recent_undo.find(block_hash)};
+    if (it == m_recent_undo.end()) return std::nullopt;
+    std::optional<CBlockUndo> undo{std::move(it->second)};
+    m_recent_undo_bytes -= std::min(m_recent_undo_bytes, ::GetSerializeSize(*undo, CLIENT_VERSION));
+    m_recent_undo.erase(it);
+    return undo;
+}
+
 /** Undo the effects of this block (with given index) on the UTXO set represented by coins.
  *  When FAILED is returned, view is left in an indeterminate state. */
-DisconnectResult Chainstate::DisconnectBlock(const CBlock& block, const CBlockIndex* pindex, CCoinsViewCache& view)
+DisconnectResult Chainstate::DisconnectBlock(const CBlock& block, const CBlockIndex* pindex, CCoinsViewCache& view, CBlockUndo* undo)
 {
     AssertLockHeld(::cs_main);
     bool fClean = true;
 
-    CBlockUndo blockUndo;
-    if (!UndoReadFromDisk(blockUndo, pindex)) {
-        error("DisconnectBlock(): failure reading undo data");
-        return DISCONNECT_FAILED;
+    CBlockUndo undo_from_disk;
+    if (!undo) {
+        if (!UndoReadFromDisk(undo_from_disk, pindex)) {
+            error("DisconnectBlock(): failure reading undo data");
+            return DISCONNECT_FAILED;
+        }
+        undo = &undo_from_disk;
     }
+    CBlockUndo& blockUndo = *undo;
 
     if (blockUndo.vtxundo.size() + 1 != block.vtx.size()) {
         error("DisconnectBlock(): block and undo data inconsistent");
         return DISCONNECT_FAILED;
     }
 
+    // Everything the block spent is about to be re-added to the view; size
+    // the cache for it once instead of growing it a few coins at a time.
+    size_t coins_to_restore{0};
+    for (const CTxUndo& txundo : blockUndo.vtxundo) {
+        coins_to_restore += txundo.vprevout.size();
+    }
+    view.ReserveAdditional(coins_to_restore);
+
     // undo transactions in reverse order
     for (int i = block.vtx.size() - 1; i >= 0; i--) {
         const CTransaction &tx = *(block.vtx[i]);
@@ -1908,6 +2126,41 @@ void StopScriptCheckWorkerThreads()
     scriptcheckqueue.StopWorkerThreads();
 }
 
+static void PrewarmScriptCaches(Chainstate& active_chainstate, const std::vector<std::pair<CTransactionRef, int64_t>>& txns)
+{
+    AssertLockHeld(::cs_main);
+    if (!g_parallel_script_checks) return;
+
+    CCoinsViewCache& coins_tip{active_chainstate.CoinsTip()};
+    std::vector<PrecomputedTransactionData> txdata{txns.size()};
+    CCheckQueueControl<CScriptCheck> control(&scriptcheckqueue);
+    for (size_t i = 0; i < txns.size(); ++i) {
+        const CTransaction& tx{*txns[i].first};
+        std::vector<CTxOut> spent_outputs;
+        spent_outputs.reserve(tx.vin.size());
+        bool have_all{true};
+        for (const CTxIn& txin : tx.vin) {
+            const Coin& coin{coins_tip.AccessCoin(txin.prevout)};
+            if (coin.IsSpent()) {
+                // Input not in the UTXO set, e.g. a parent later in this
+                // batch; leave this transaction to the serial path.
+                have_all = false;
+                break;
+            }
+            spent_outputs.push_back(coin.out);
+        }
+        if (!have_all) continue;
+        txdata[i].Init(tx, std::move(spent_outputs));
+        std::vector<CScriptCheck> vChecks;
+        vChecks.reserve(tx.vin.size());
+        for (unsigned int j = 0; j < tx.vin.size(); ++j) {
+            vChecks.emplace_back(txdata[i].m_spent_outputs[j], tx, j, STANDARD_SCRIPT_VERIFY_FLAGS, /*cacheIn=*/true, &txdata[i]);
+        }
+        control.Add(vChecks);
+    }
+    control.Wait();
+}
+
 /**
  * Threshold condition checker that triggers when unknown versionbits are seen on the network.
  */
@@ -2181,6 +2434,53 @@ bool Chainstate::ConnectBlock(const CBlock& block, BlockValidationState& state,
     CCheckQueueControl<CScriptCheck> control(fScriptChecks && g_parallel_script_checks ? &scriptcheckqueue : nullptr);
     std::vector<PrecomputedTransactionData> txsdata(block.vtx.size());
 
+    // Precompute signature hash data for the whole block before any script
+    // checks dispatch. The per-tx hashPrevouts/hashSequence/hashOutputs
+    // computations are independent, so batching them over a few threads
+    // removes serial SHA256 work from the validation loop; CheckInputScripts()
+    // finds the data ready and skips its lazy Init(). Spent outputs are
+    // gathered serially first, because later transactions may spend outputs
+    // created earlier in the block, and transactions whose inputs cannot be
+    // resolved are left for CheckTxInputs() to reject.
+    if (fScriptChecks && g_parallel_script_checks && block.vtx.size() >= MIN_PARALLEL_PRECOMPUTE_TXS) {
+        std::unordered_map<uint256, const CTransaction*, SaltedTxidHasher> block_txs;
+        block_txs.reserve(block.vtx.size());
+        for (const auto& tx : block.vtx) {
+            block_txs.emplace(tx->GetHash(), tx.get());
+        }
+        std::vector<std::optional<std::vector<CTxOut>>> spent_per_tx(block.vtx.size());
+        for (size_t i = 1; i < block.vtx.size(); ++i) {
+            const CTransaction& tx{*block.vtx[i]};
+            if (tx.vin.empty()) continue;
+            std::vector<CTxOut> spent_outputs;
+            spent_outputs.reserve(tx.vin.size());
+            for (const CTxIn& txin : tx.vin) {
+                if (const auto it{block_txs.find(txin.prevout.hash)}; it != block_txs.end()) {
+                    if (txin.prevout.n >= it->second->vout.size()) break;
+                    spent_outputs.push_back(it->second->vout[txin.prevout.n]);
+                } else {
+                    const Coin& coin{view.AccessCoin(txin.prevout)};
+                    if (coin.IsSpent()) break;
+                    spent_outputs.push_back(coin.out);
+                }
+            }
+            if (spent_outputs.size() == tx.vin.size()) spent_per_tx[i] = std::move(spent_outputs);
+        }
+        std::atomic<size_t> next_tx{1};
+        auto precompute_worker{[&] {
+            for (size_t i = next_tx.fetch_add(1); i < block.vtx.size(); i = next_tx.fetch_add(1)) {
+                if (spent_per_tx[i]) txsdata[i].Init(*block.vtx[i], std::move(*spent_per_tx[i]));
+            }
+        }};
+        const int precompute_threads{std::clamp(GetNumCores() - 1, 1, 4)};
+        std::vector<std::thread> workers;
+        for (int t = 1; t < precompute_threads; ++t) {
+            workers.emplace_back(precompute_worker);
+        }
+        precompute_worker();
+        for (auto& worker : workers) worker.join();
+    }
+
     std::vector<int> prevheights;
     CAmount nFees = 0;
     int nInputs = 0;
@@ -2254,7 +2554,14 @@ bool Chainstate::ConnectBlock(const CBlock& block, BlockValidationState& state,
         UpdateCoins(tx, view, i == 0 ? undoDummy : blockundo.vtxundo.back(), pindex->nHeight);
     }
     int64_t nTime3 = GetTimeMicros(); nTimeConnect += nTime3 - nTime2;
+    perf::ThreadBlockPhases().connect_us = nTime3 - nTime2;
     LogPrint(BCLog::BENCH, "      - Connect %u transactions: %.2fms (%.3fms/tx, %.3fms/txin) [%.2fs (%.2fms/blk)]\n", (unsigned)block.vtx.size(), MILLI * (nTime3 - nTime2), MILLI * (nTime3 - nTime2) / block.vtx.size(), nInputs <= 1 ? 0 : MILLI * (nTime3 - nTime2) / (nInputs-1), nTimeConnect * MICRO, nTimeConnect * MILLI / nBlocksTotal);
+    TRACE4(validation, connect_block_inputs,
+        block_hash.data(),
+        pindex->nHeight,
+        (uint64_t)nInputs,
+        nTime3 - nTime2 // in microseconds (µs)
+    );
 
     CAmount blockReward = nFees + GetBlockSubsidy(pindex->nHeight, m_params.GetConsensus());
     if (block.vtx[0]->GetValueOut() > blockReward) {
@@ -2262,23 +2569,41 @@ bool Chainstate::ConnectBlock(const CBlock& block, BlockValidationState& state,
         return state.Invalid(BlockValidationResult::BLOCK_CONSENSUS, "bad-cb-amount");
     }
 
+    // Write the undo data while the script check workers are still draining
+    // their queue: the undo records depend only on the UTXO view updates
+    // above, not on the script results, and an undo record for a block that
+    // subsequently fails script validation is never read. This keeps the
+    // cores busy through the undo-file write instead of idling between the
+    // last check and the disk I/O.
+    if (!fJustCheck) {
+        if (!m_blockman.WriteUndoDataForBlock(blockundo, state, pindex, m_params)) {
+            return false;
+        }
+        // Keep the undo data of recent blocks in memory: short reorgs around
+        // the tip are by far the most common and can then disconnect without
+        // reading the rev file back.
+        CacheBlockUndo(pindex->GetBlockHash(), std::move(blockundo));
+    }
+    int64_t nTime4 = GetTimeMicros(); nTimeUndo += nTime4 - nTime3;
+    LogPrint(BCLog::BENCH, "    - Write undo data: %.2fms [%.2fs (%.2fms/blk)]\n", MILLI * (nTime4 - nTime3), nTimeUndo * MICRO, nTimeUndo * MILLI / nBlocksTotal);
+
     if (!control.Wait()) {
         LogPrintf("ERROR: %s: CheckQueue failed\n", __func__);
         return state.Invalid(BlockValidationResult::BLOCK_CONSENSUS, "block-validation-failed");
     }
-    int64_t nTime4 = GetTimeMicros(); nTimeVerify += nTime4 - nTime2;
-    LogPrint(BCLog::BENCH, "    - Verify %u txins: %.2fms (%.3fms/txin) [%.2fs (%.2fms/blk)]\n", nInputs - 1, MILLI * (nTime4 - nTime2), nInputs <= 1 ? 0 : MILLI * (nTime4 - nTime2) / (nInputs-1), nTimeVerify * MICRO, nTimeVerify * MILLI / nBlocksTotal);
+    int64_t nTime5 = GetTimeMicros(); nTimeVerify += nTime5 - nTime2;
+    perf::ThreadBlockPhases().verify_us = nTime5 - nTime3;
+    LogPrint(BCLog::BENCH, "    - Verify %u txins: %.2fms (%.3fms/txin) [%.2fs (%.2fms/blk)]\n", nInputs - 1, MILLI * (nTime5 - nTime2), nInputs <= 1 ? 0 : MILLI * (nTime5 - nTime2) / (nInputs-1), nTimeVerify * MICRO, nTimeVerify * MILLI / nBlocksTotal);
+    TRACE4(validation, connect_block_scripts,
+        block_hash.data(),
+        pindex->nHeight,
+        (uint64_t)nSigOpsCost,
+        nTime5 - nTime2 // in microseconds (µs)
+    );
 
     if (fJustCheck)
         return true;
 
-    if (!m_blockman.WriteUndoDataForBlock(blockundo, state, pindex, m_params)) {
-        return false;
-    }
-
-    int64_t nTime5 = GetTimeMicros(); nTimeUndo += nTime5 - nTime4;
-    LogPrint(BCLog::BENCH, "    - Write undo data: %.2fms [%.2fs (%.2fms/blk)]\n", MILLI * (nTime5 - nTime4), nTimeUndo * MICRO, nTimeUndo * MILLI / nBlocksTotal);
-
     if (!pindex->IsValid(BLOCK_VALID_SCRIPTS)) {
         pindex->RaiseValidity(BLOCK_VALID_SCRIPTS);
         m_blockman.m_dirty_blockindex.insert(pindex);
@@ -2289,6 +2614,11 @@ bool Chainstate::ConnectBlock(const CBlock& block, BlockValidationState& state,
 
     int64_t nTime6 = GetTimeMicros(); nTimeIndex += nTime6 - nTime5;
     LogPrint(BCLog::BENCH, "    - Index writing: %.2fms [%.2fs (%.2fms/blk)]\n", MILLI * (nTime6 - nTime5), nTimeIndex * MICRO, nTimeIndex * MILLI / nBlocksTotal);
+    TRACE3(validation, connect_block_index,
+        block_hash.data(),
+        pindex->nHeight,
+        nTime6 - nTime5 // in microseconds (µs)
+    );
 
     TRACE6(validation, block_connected,
         block_hash.data(),
@@ -2441,6 +2771,18 @@ bool Chainstate::FlushStateToDisk(
             }
             nLastWrite = nNow;
         }
+        // Journal the dirty coins on the block-index write cadence when the
+        // cache itself is not being flushed. After a crash the journal brings
+        // the coins database forward to this point directly, instead of
+        // reconnecting every block since the last flush. Failure is not
+        // fatal: the journal only accelerates crash recovery.
+        if (fPeriodicWrite && !fDoFullFlush && !m_from_snapshot_blockhash && !CoinsTip().GetBestBlock().IsNull()) {
+            LOG_TIME_MILLIS_WITH_CATEGORY("write coins journal", BCLog::BENCH);
+
+            if (!WriteCoinsJournal(CoinsTip(), CoinsDB().GetBestBlock(), CoinsJournalPath())) {
+                LogPrintf("Failed to write coins journal; crash recovery will replay blocks instead\n");
+            }
+        }
         // Flush best chain related state. This can only be done if the blocks / block index write was also done.
         if (fDoFullFlush && !CoinsTip().GetBestBlock().IsNull()) {
             LOG_TIME_MILLIS_WITH_CATEGORY(strprintf("write coins cache to disk (%d coins, %.2fkB)",
@@ -2455,10 +2797,42 @@ bool Chainstate::FlushStateToDisk(
                 return AbortNode(state, "Disk space is too low!", _("Disk space is too low!"));
             }
             // Flush the chainstate (which may refer to block index entries).
-            if (!CoinsTip().Flush())
+            // Periodic flushes keep the cache warm: the dirty entries are
+            // synced to the database without being dropped, so recent coins
+            // stay available for subsequent block connections. Only empty the
+            // cache when it has grown too large (or a full flush was
+            // explicitly requested).
+            const bool empty_cache{(mode == FlushStateMode::ALWAYS) || fCacheLarge || fCacheCritical || fFlushForPrune};
+            TRACE4(utxocache, flush_start,
+                   (uint32_t)mode,
+                   (uint64_t)coins_count,
+                   (uint64_t)coins_mem_usage,
+                   (bool)empty_cache);
+            // Withhold young fresh coins from periodic syncs: most outputs
+            // are spent again within a few hundred blocks, and a FRESH coin
+            // spent while still in the cache then never touches the database
+            // at all. The database's best block moves past the withheld
+            // entries, so a journal covering them must be durable first; if
+            // it cannot be written, fall back to writing everything.
+            static const int coins_retain_window{static_cast<int>(gArgs.GetIntArg("-coinsretainwindow", DEFAULT_COINS_RETAIN_WINDOW))};
+            int young_coin_height{-1};
+            if (!empty_cache && coins_retain_window > 0 && !m_from_snapshot_blockhash && m_chain.Height() >= 0) {
+                if (WriteCoinsJournal(CoinsTip(), CoinsTip().GetBestBlock(), CoinsJournalPath())) {
+                    young_coin_height = std::max(0, m_chain.Height() - coins_retain_window + 1);
+                } else {
+                    LogPrintf("Failed to write coins journal; writing young coins to the coin database\n");
+                }
+            }
+            if (empty_cache ? !CoinsTip().Flush() : !CoinsTip().Sync(young_coin_height)) {
                 return AbortNode(state, "Failed to write to coin database");
+            }
             nLastFlush = nNow;
             full_flush_completed = true;
+            // The database has caught up with the cache, so any journal on
+            // disk is now stale. When coins were withheld above it has not:
+            // the journal written before the sync is what restores them
+            // after a crash, so it must stay.
+            if (!m_from_snapshot_blockhash && young_coin_height < 0) RemoveCoinsJournal(CoinsJournalPath());
             TRACE5(utxocache, flush,
                    (int64_t)(GetTimeMicros() - nNow.count()), // in microseconds (µs)
                    (uint32_t)mode,
@@ -2559,6 +2933,16 @@ void Chainstate::UpdateTip(const CBlockIndex* pindexNew)
         g_best_block_cv.notify_all();
     }
 
+    m_chainman.PublishTip(*pindexNew);
+
+    // The next block's RandomX key is this tip's hash; warm its state in the
+    // background so neither the next block's validation nor the miner pays
+    // the key switch. Skipped during initial sync, where the tip advances
+    // faster than cache initializations complete.
+    if (!this->IsInitialBlockDownload()) {
+        PrefetchRandomXState(GetRandomXKey(pindexNew->GetBlockHash()));
+    }
+
     bilingual_str warning_messages;
     if (!this->IsInitialBlockDownload()) {
         const CBlockIndex* pindex = pindexNew;
@@ -2588,7 +2972,7 @@ void Chainstate::UpdateTip(const CBlockIndex* pindexNew)
   * disconnectpool (note that the caller is responsible for mempool consistency
   * in any case).
   */
-bool Chainstate::DisconnectTip(BlockValidationState& state, DisconnectedBlockTransactions* disconnectpool)
+bool Chainstate::DisconnectTip(BlockValidationState& state, DisconnectedBlockTransactions* disconnectpool, CBlockUndo* prefetched_undo)
 {
     AssertLockHeld(cs_main);
     if (m_mempool) AssertLockHeld(m_mempool->cs);
@@ -2607,7 +2991,10 @@ bool Chainstate::DisconnectTip(BlockValidationState& state, DisconnectedBlockTra
     {
         CCoinsViewCache view(&CoinsTip());
         assert(view.GetBestBlock() == pindexDelete->GetBlockHash());
-        if (DisconnectBlock(block, pindexDelete, view) != DISCONNECT_OK)
+        // Prefer the in-memory undo data kept since this block connected; it
+        // needs no disk read at all.
+        std::optional<CBlockUndo> cached_undo{TakeCachedBlockUndo(pindexDelete->GetBlockHash())};
+        if (DisconnectBlock(block, pindexDelete, view, cached_undo ? &*cached_undo : prefetched_undo) != DISCONNECT_OK)
             return error("DisconnectTip(): DisconnectBlock %s failed", pindexDelete->GetBlockHash().ToString());
         bool flushed = view.Flush();
         assert(flushed);
@@ -2738,6 +3125,8 @@ bool Chainstate::ConnectTip(BlockValidationState& state, CBlockIndex* pindexNew,
             return error("%s: ConnectBlock %s failed, %s", __func__, pindexNew->GetBlockHash().ToString(), state.ToString());
         }
         nTime3 = GetTimeMicros(); nTimeConnectTotal += nTime3 - nTime2;
+        perf::Bump(perf::GetCounters().blocks_connected);
+        perf::Bump(perf::GetCounters().block_connect_time_us, nTime3 - nTime2);
         assert(nBlocksTotal > 0);
         LogPrint(BCLog::BENCH, "  - Connect total: %.2fms [%.2fs (%.2fms/blk)]\n", (nTime3 - nTime2) * MILLI, nTimeConnectTotal * MICRO, nTimeConnectTotal * MILLI / nBlocksTotal);
         bool flushed = view.Flush();
@@ -2760,10 +3149,30 @@ bool Chainstate::ConnectTip(BlockValidationState& state, CBlockIndex* pindexNew,
     m_chain.SetTip(*pindexNew);
     UpdateTip(pindexNew);
 
+    // Publish the raw block to the shared-memory ring for co-located
+    // consumers. ConnectTip is the only writer, so the ring's single-writer
+    // protocol holds.
+    if (node::g_block_ring) {
+        node::g_block_ring->WriteBlock(blockConnecting, pindexNew->nHeight, pindexNew->GetBlockHash());
+    }
+
     int64_t nTime6 = GetTimeMicros(); nTimePostConnect += nTime6 - nTime5; nTimeTotal += nTime6 - nTime1;
     LogPrint(BCLog::BENCH, "  - Connect postprocess: %.2fms [%.2fs (%.2fms/blk)]\n", (nTime6 - nTime5) * MILLI, nTimePostConnect * MICRO, nTimePostConnect * MILLI / nBlocksTotal);
     LogPrint(BCLog::BENCH, "- Connect block: %.2fms [%.2fs (%.2fms/blk)]\n", (nTime6 - nTime1) * MILLI, nTimeTotal * MICRO, nTimeTotal * MILLI / nBlocksTotal);
 
+    {
+        // ConnectBlock already filled in the phases it times.
+        perf::BlockPhaseTimes& phases{perf::ThreadBlockPhases()};
+        phases.height = pindexNew->nHeight;
+        phases.hash = pindexNew->GetBlockHash();
+        phases.time = nTime6 / 1000000;
+        phases.read_us = nTime2 - nTime1;
+        phases.flush_us = nTime5 - nTime3;
+        phases.notify_us = nTime6 - nTime5;
+        phases.total_us = nTime6 - nTime1;
+        perf::RecordBlockPhases(phases);
+    }
+
     connectTrace.BlockConnected(pindexNew, std::move(pthisBlock));
     return true;
 }
@@ -2859,8 +3268,54 @@ bool Chainstate::ActivateBestChainStep(BlockValidationState& state, CBlockIndex*
     // Disconnect active blocks which are no longer in the best chain.
     bool fBlocksDisconnected = false;
     DisconnectedBlockTransactions disconnectpool;
+
+    // For multi-block reorgs, read the undo records for the whole disconnect
+    // batch on a background thread so each DisconnectTip does not stall on a
+    // rev-file read. The undo positions are captured here under cs_main; the
+    // position-based UndoReadFromDisk does not need the lock.
+    std::vector<std::pair<FlatFilePos, uint256>> undo_positions;
+    for (const CBlockIndex* p = m_chain.Tip(); p && p != pindexFork && p->pprev; p = p->pprev) {
+        // Blocks whose undo data is still in the recent-undo cache need no
+        // disk read; a null position makes the prefetch thread skip them and
+        // DisconnectTip picks the cached record up directly.
+        if (m_recent_undo.count(p->GetBlockHash())) {
+            undo_positions.emplace_back(FlatFilePos{}, uint256{});
+        } else {
+            undo_positions.emplace_back(p->GetUndoPos(), p->pprev->GetBlockHash());
+        }
+    }
+    std::vector<std::promise<std::optional<CBlockUndo>>> undo_promises(undo_positions.size() > 1 ? undo_positions.size() : 0);
+    std::thread undo_prefetch_thread;
+    if (!undo_promises.empty()) {
+        undo_prefetch_thread = std::thread([&undo_positions, &undo_promises] {
+            util::ThreadRename("undoprefetch");
+            for (size_t i = 0; i < undo_positions.size(); ++i) {
+                CBlockUndo undo;
+                if (!undo_positions[i].first.IsNull() && UndoReadFromDisk(undo, undo_positions[i].first, undo_positions[i].second)) {
+                    undo_promises[i].set_value(std::move(undo));
+                } else {
+                    // Fall back to the synchronous read (and its error
+                    // handling) in DisconnectBlock.
+                    undo_promises[i].set_value(std::nullopt);
+                }
+            }
+        });
+    }
+    // The thread only touches locals above; make sure it finishes before any
+    // exit from this function.
+    struct ThreadJoiner {
+        std::thread& m_thread;
+        ~ThreadJoiner() { if (m_thread.joinable()) m_thread.join(); }
+    } undo_prefetch_joiner{undo_prefetch_thread};
+
+    size_t disconnect_count{0};
     while (m_chain.Tip() && m_chain.Tip() != pindexFork) {
-        if (!DisconnectTip(state, &disconnectpool)) {
+        std::optional<CBlockUndo> prefetched_undo;
+        if (disconnect_count < undo_promises.size()) {
+            prefetched_undo = undo_promises[disconnect_count].get_future().get();
+        }
+        ++disconnect_count;
+        if (!DisconnectTip(state, &disconnectpool, prefetched_undo ? &*prefetched_undo : nullptr)) {
             // This is likely a fatal error, but keep the mempool consistent,
             // just in case. Only remove from the mempool in this case.
             MaybeUpdateMempoolForReorg(disconnectpool, false);
@@ -2891,9 +3346,40 @@ bool Chainstate::ActivateBestChainStep(BlockValidationState& state, CBlockIndex*
         }
         nHeight = nTargetHeight;
 
-        // Connect new blocks.
-        for (CBlockIndex* pindexConnect : reverse_iterate(vpindexToConnect)) {
-            if (!ConnectTip(state, pindexConnect, pindexConnect == pindexMostWork ? pblock : std::shared_ptr<const CBlock>(), connectTrace, disconnectpool)) {
+        // Connect new blocks. While each block is being connected, the next
+        // block in the batch is read from disk and its inputs warmed into the
+        // coins cache on a background thread, overlapping disk I/O and input
+        // fetching with script verification. The coins cache shards lock
+        // individually, so concurrent warming is safe; the worker avoids
+        // cs_main by taking the block position up front.
+        std::future<std::shared_ptr<const CBlock>> next_block;
+        for (size_t i = vpindexToConnect.size(); i-- > 0;) {
+            CBlockIndex* pindexConnect = vpindexToConnect[i];
+            std::shared_ptr<const CBlock> block_to_connect;
+            if (pindexConnect == pindexMostWork && pblock) {
+                block_to_connect = pblock;
+            } else if (next_block.valid()) {
+                block_to_connect = next_block.get();
+            }
+            if (i > 0) {
+                const FlatFilePos next_pos{vpindexToConnect[i - 1]->GetBlockPos()};
+                CCoinsViewCache* coins_tip = &CoinsTip();
+                const Consensus::Params& consensus_params = m_params.GetConsensus();
+                next_block = std::async(std::launch::async, [next_pos, coins_tip, &consensus_params]() -> std::shared_ptr<const CBlock> {
+                    auto block = std::make_shared<CBlock>();
+                    if (!ReadBlockFromDisk(*block, next_pos, consensus_params)) {
+                        return nullptr;
+                    }
+                    for (const auto& tx : block->vtx) {
+                        if (tx->IsCoinBase()) continue;
+                        for (const CTxIn& txin : tx->vin) {
+                            coins_tip->AccessCoin(txin.prevout);
+                        }
+                    }
+                    return block;
+                });
+            }
+            if (!ConnectTip(state, pindexConnect, block_to_connect, connectTrace, disconnectpool)) {
                 if (state.IsInvalid()) {
                     // The block violates a consensus rule.
                     if (state.GetResult() != BlockValidationResult::BLOCK_MUTATED) {
@@ -2986,6 +3472,19 @@ bool Chainstate::ActivateBestChain(BlockValidationState& state, std::shared_ptr<
     // we use m_chainstate_mutex to enforce mutual exclusion so that only one caller may execute this function at a time
     LOCK(m_chainstate_mutex);
 
+    // Publish activation progress for the getchainactivationstatus RPC; the
+    // guard clears the in-progress flag however this function exits.
+    struct ActivationProgressGuard {
+        ChainstateManager& m_chainman;
+        explicit ActivationProgressGuard(ChainstateManager& chainman) : m_chainman{chainman}
+        {
+            m_chainman.m_activation_blocks_connected = 0;
+            m_chainman.m_activation_target_height = -1;
+            m_chainman.m_activation_in_progress = true;
+        }
+        ~ActivationProgressGuard() { m_chainman.m_activation_in_progress = false; }
+    } progress_guard{m_chainman};
+
     CBlockIndex *pindexMostWork = nullptr;
     CBlockIndex *pindexNewTip = nullptr;
     int nStopAtHeight = gArgs.GetIntArg("-stopatheight", DEFAULT_STOPATHEIGHT);
@@ -3011,6 +3510,7 @@ bool Chainstate::ActivateBestChain(BlockValidationState& state, std::shared_ptr<
 
                 if (pindexMostWork == nullptr) {
                     pindexMostWork = FindMostWorkChain();
+                    if (pindexMostWork) m_chainman.m_activation_target_height = pindexMostWork->nHeight;
                 }
 
                 // Whether we have anything to do at all.
@@ -3032,9 +3532,18 @@ bool Chainstate::ActivateBestChain(BlockValidationState& state, std::shared_ptr<
                 }
                 pindexNewTip = m_chain.Tip();
 
+                // Hand the whole step's blocks to subscribers as one batch, so
+                // the step costs one notification queue hop and batch-aware
+                // subscribers (e.g. indexes) update their position once.
+                std::vector<ConnectedBlock> connected_blocks;
+                connected_blocks.reserve(connectTrace.GetBlocksConnected().size());
                 for (const PerBlockConnectTrace& trace : connectTrace.GetBlocksConnected()) {
                     assert(trace.pblock && trace.pindex);
-                    GetMainSignals().BlockConnected(trace.pblock, trace.pindex);
+                    connected_blocks.push_back({trace.pblock, trace.pindex});
+                    ++m_chainman.m_activation_blocks_connected;
+                }
+                if (!connected_blocks.empty()) {
+                    GetMainSignals().BlocksConnected(std::move(connected_blocks));
                 }
             } while (!m_chain.Tip() || (starting_tip && CBlockIndexWorkComparator()(m_chain.Tip(), starting_tip)));
             if (!blocks_connected) return true;
@@ -3332,6 +3841,21 @@ static bool CheckBlockHeader(const CBlockHeader& block, BlockValidationState& st
     return true;
 }
 
+bool ShouldVerifyHeaderPoW(int height, const arith_uint256& claimed_chain_work, const Consensus::Params& params)
+{
+    static const int64_t sample_interval{gArgs.GetIntArg("-powsampleinterval", DEFAULT_POW_SAMPLE_INTERVAL)};
+    if (sample_interval <= 1) return true;
+    // Sampling only ever applies below the minimum-chainwork anchor: an
+    // attacker must claim at least that much cumulative work before any of
+    // their headers could be skipped, and each faked header below it still
+    // survives only with probability (N-1)/N per node. Chainwork accounting
+    // is unaffected either way, since a header's work is derived from its
+    // nBits, which ContextualCheckBlockHeader() validates in full.
+    if (claimed_chain_work >= nMinimumChainWork) return true;
+    if (height % params.DifficultyAdjustmentInterval() == 0) return true;
+    return GetRand(static_cast<uint64_t>(sample_interval)) == 0;
+}
+
 bool CheckBlock(const CBlock& block, BlockValidationState& state, const Consensus::Params& consensusParams, bool fCheckPOW, bool fCheckMerkleRoot)
 {
     // These are checks that are independent of context.
@@ -3445,10 +3969,9 @@ std::vector<unsigned char> ChainstateManager::GenerateCoinbaseCommitment(CBlock&
     return commitment;
 }
 
-bool HasValidProofOfWork(const std::vector<CBlockHeader>& headers, const Consensus::Params& consensusParams)
+bool HasValidProofOfWork(const std::vector<CBlockHeader>& headers, const Consensus::Params& consensusParams, RandomXSource source)
 {
-    return std::all_of(headers.cbegin(), headers.cend(),
-            [&](const auto& header) { return CheckRandomXProofOfWork(header, header.nBits, consensusParams);});
+    return CheckRandomXProofOfWorkBatch(headers, consensusParams, source);
 }
 
 arith_uint256 CalculateHeadersWork(const std::vector<CBlockHeader>& headers)
@@ -3601,7 +4124,7 @@ static bool ContextualCheckBlock(const CBlock& block, BlockValidationState& stat
     return true;
 }
 
-bool ChainstateManager::AcceptBlockHeader(const CBlockHeader& block, BlockValidationState& state, CBlockIndex** ppindex, bool min_pow_checked)
+bool ChainstateManager::AcceptBlockHeader(const CBlockHeader& block, BlockValidationState& state, CBlockIndex** ppindex, bool min_pow_checked, CBlockIndex*& best_header)
 {
     AssertLockHeld(cs_main);
 
@@ -3621,7 +4144,10 @@ bool ChainstateManager::AcceptBlockHeader(const CBlockHeader& block, BlockValida
             return true;
         }
 
-        if (!CheckBlockHeader(block, state, GetConsensus())) {
+        // The proof of work is checked only once the previous block index is
+        // known, so the deep-history sampling policy can take the header's
+        // height and claimed chainwork into account.
+        if (!CheckBlockHeader(block, state, GetConsensus(), /*fCheckPOW=*/false)) {
             LogPrint(BCLog::VALIDATION, "%s: Consensus::CheckBlockHeader: %s, %s\n", __func__, hash.ToString(), state.ToString());
             return false;
         }
@@ -3638,6 +4164,14 @@ bool ChainstateManager::AcceptBlockHeader(const CBlockHeader& block, BlockValida
             LogPrint(BCLog::VALIDATION, "%s: %s prev block invalid\n", __func__, hash.ToString());
             return state.Invalid(BlockValidationResult::BLOCK_INVALID_PREV, "bad-prevblk");
         }
+        {
+            CBlockIndex dummy{block};
+            if (ShouldVerifyHeaderPoW(pindexPrev->nHeight + 1, pindexPrev->nChainWork + GetBlockProof(dummy), GetConsensus()) &&
+                !CheckRandomXProofOfWork(block, block.nBits, GetConsensus())) {
+                LogPrint(BCLog::VALIDATION, "%s: Consensus::CheckBlockHeader: %s, proof of work failed\n", __func__, hash.ToString());
+                return state.Invalid(BlockValidationResult::BLOCK_INVALID_HEADER, "high-hash", "proof of work failed");
+            }
+        }
         if (!ContextualCheckBlockHeader(block, state, m_blockman, *this, pindexPrev, m_options.adjusted_time_callback())) {
             LogPrint(BCLog::VALIDATION, "%s: Consensus::ContextualCheckBlockHeader: %s, %s\n", __func__, hash.ToString(), state.ToString());
             return false;
@@ -3686,7 +4220,7 @@ bool ChainstateManager::AcceptBlockHeader(const CBlockHeader& block, BlockValida
         LogPrint(BCLog::VALIDATION, "%s: not adding new block header %s, missing anti-dos proof-of-work validation\n", __func__, hash.ToString());
         return state.Invalid(BlockValidationResult::BLOCK_HEADER_LOW_WORK, "too-little-chainwork");
     }
-    CBlockIndex* pindex{m_blockman.AddToBlockIndex(block, m_best_header)};
+    CBlockIndex* pindex{m_blockman.AddToBlockIndex(block, best_header)};
 
     if (ppindex)
         *ppindex = pindex;
@@ -3700,18 +4234,32 @@ bool ChainstateManager::ProcessNewBlockHeaders(const std::vector<CBlockHeader>&
     AssertLockNotHeld(cs_main);
     {
         LOCK(cs_main);
+        // Commit the whole batch into the block index at once: pre-size the
+        // index so no rehash happens mid-batch, and track the best header in a
+        // local so m_best_header is re-evaluated and published only once per
+        // batch rather than per header. The new index entries all land in
+        // m_dirty_blockindex and are written to disk in a single batch at the
+        // next flush.
+        m_blockman.ReserveBlockIndex(headers.size());
+        CBlockIndex* best_header{m_best_header};
+        bool accepted_all{true};
         for (const CBlockHeader& header : headers) {
             CBlockIndex *pindex = nullptr; // Use a temp pindex instead of ppindex to avoid a const_cast
-            bool accepted{AcceptBlockHeader(header, state, &pindex, min_pow_checked)};
-            ActiveChainstate().CheckBlockIndex();
-
-            if (!accepted) {
-                return false;
+            if (!AcceptBlockHeader(header, state, &pindex, min_pow_checked, best_header)) {
+                accepted_all = false;
+                break;
             }
             if (ppindex) {
                 *ppindex = pindex;
             }
         }
+        // Headers accepted before a failure are already in the index, so the
+        // best-header commit and consistency check run even on early exit.
+        m_best_header = best_header;
+        ActiveChainstate().CheckBlockIndex();
+        if (!accepted_all) {
+            return false;
+        }
     }
     if (NotifyHeaderTip(ActiveChainstate())) {
         if (ActiveChainstate().IsInitialBlockDownload() && ppindex && *ppindex) {
@@ -3760,7 +4308,7 @@ bool Chainstate::AcceptBlock(const std::shared_ptr<const CBlock>& pblock, BlockV
     CBlockIndex *pindexDummy = nullptr;
     CBlockIndex *&pindex = ppindex ? *ppindex : pindexDummy;
 
-    bool accepted_header{m_chainman.AcceptBlockHeader(block, state, &pindex, min_pow_checked)};
+    bool accepted_header{m_chainman.AcceptBlockHeader(block, state, &pindex, min_pow_checked, m_chainman.m_best_header)};
     CheckBlockIndex();
 
     if (!accepted_header)
@@ -3864,6 +4412,16 @@ bool ChainstateManager::ProcessNewBlock(const std::shared_ptr<const CBlock>& blo
 
     NotifyHeaderTip(ActiveChainstate());
 
+    if (gArgs.GetBoolArg("-asyncactivation", DEFAULT_ASYNC_ACTIVATION)) {
+        // Hand the activation to the worker thread so that the caller
+        // (typically the message handler thread) is not blocked behind a
+        // potentially long reorg. The block has already been accepted and
+        // stored above; activation failures are reported via the usual
+        // validation interface notifications.
+        QueueBestChainActivation(block);
+        return true;
+    }
+
     BlockValidationState state; // Only used to report errors, not invalidity - ignore it
     if (!ActiveChainstate().ActivateBestChain(state, block)) {
         return error("%s: ActivateBestChain failed (%s)", __func__, state.ToString());
@@ -3936,6 +4494,93 @@ void Chainstate::LoadMempool(const fs::path& load_path, FopenFn mockable_fopen_f
     m_mempool->SetLoadTried(!ShutdownRequested());
 }
 
+void Chainstate::WarmCoinsCache()
+{
+    AssertLockNotHeld(cs_main);
+    //! How many recent blocks' coins to prefetch. Coins created or referenced
+    //! this recently have the highest chance of being spent by the next blocks.
+    constexpr int WARM_CACHE_BLOCKS{64};
+
+    const auto start_time{SteadyClock::now()};
+
+    // Collect candidate outpoints: every input of the loaded mempool, plus
+    // the inputs and outputs of the most recent blocks.
+    std::vector<COutPoint> outpoints;
+    if (m_mempool) {
+        for (const auto& info : m_mempool->infoAll()) {
+            for (const CTxIn& txin : info.tx->vin) {
+                outpoints.push_back(txin.prevout);
+            }
+        }
+    }
+    {
+        const CBlockIndex* pindex{WITH_LOCK(cs_main, return m_chain.Tip())};
+        for (int i = 0; i < WARM_CACHE_BLOCKS && pindex != nullptr; ++i, pindex = pindex->pprev) {
+            CBlock block;
+            if (!ReadBlockFromDisk(block, pindex, m_params.GetConsensus())) break;
+            for (const CTransactionRef& tx : block.vtx) {
+                if (!tx->IsCoinBase()) {
+                    for (const CTxIn& txin : tx->vin) {
+                        outpoints.push_back(txin.prevout);
+                    }
+                }
+                const uint256& txid{tx->GetHash()};
+                for (uint32_t n = 0; n < tx->vout.size(); ++n) {
+                    outpoints.emplace_back(txid, n);
+                }
+            }
+            if (ShutdownRequested()) return;
+        }
+    }
+    std::sort(outpoints.begin(), outpoints.end());
+    outpoints.erase(std::unique(outpoints.begin(), outpoints.end()), outpoints.end());
+    if (outpoints.empty()) return;
+
+    // Phase 1: pull the coins through the database in parallel. CCoinsViewDB
+    // reads are thread safe and this fills the LevelDB table cache and the OS
+    // page cache, so the serial pass below is not bound by disk latency.
+    {
+        CCoinsViewDB& coins_db{WITH_LOCK(cs_main, return CoinsDB())};
+        const size_t num_threads{std::clamp<size_t>(std::thread::hardware_concurrency(), 1, 8)};
+        std::atomic<size_t> next_index{0};
+        std::vector<std::thread> workers;
+        workers.reserve(num_threads);
+        for (size_t t = 0; t < num_threads; ++t) {
+            workers.emplace_back([&] {
+                constexpr size_t BATCH{256};
+                size_t begin;
+                while ((begin = next_index.fetch_add(BATCH)) < outpoints.size()) {
+                    const size_t end{std::min(begin + BATCH, outpoints.size())};
+                    Coin coin;
+                    for (size_t i = begin; i < end; ++i) {
+                        coins_db.GetCoin(outpoints[i], coin);
+                    }
+                    if (ShutdownRequested()) return;
+                }
+            });
+        }
+        for (auto& w : workers) w.join();
+    }
+    if (ShutdownRequested()) return;
+
+    // Phase 2: a single pass under cs_main inserts the coins into the cache.
+    // Stop before the prefetched coins could push the cache near its limit
+    // and force an early flush.
+    size_t warmed{0};
+    {
+        LOCK(cs_main);
+        CCoinsViewCache& cache{CoinsTip()};
+        const size_t usage_limit{m_coinstip_cache_size_bytes - m_coinstip_cache_size_bytes / 10};
+        for (const COutPoint& outpoint : outpoints) {
+            if ((warmed & 0x3ff) == 0 && cache.DynamicMemoryUsage() > usage_limit) break;
+            if (cache.HaveCoin(outpoint)) ++warmed;
+        }
+    }
+    LogPrintf("Warmed coins cache with %u coins (%u candidates) in %.2fs\n",
+              warmed, outpoints.size(),
+              Ticks<SecondsDouble>(SteadyClock::now() - start_time));
+}
+
 bool Chainstate::LoadChainTip()
 {
     AssertLockHeld(cs_main);
@@ -3956,6 +4601,7 @@ bool Chainstate::LoadChainTip()
     PruneBlockIndexCandidates();
 
     tip = m_chain.Tip();
+    if (this == &m_chainman.ActiveChainstate()) m_chainman.PublishTip(*tip);
     LogPrintf("Loaded best chain: hashBestChain=%s height=%d date=%s progress=%f\n",
               tip->GetBlockHash().ToString(),
               m_chain.Height(),
@@ -4002,14 +4648,24 @@ bool CVerifyDB::VerifyDB(
 
     const bool is_snapshot_cs{!chainstate.m_from_snapshot_blockhash};
 
+    // Gather the work items up front: the worker threads below must not take
+    // cs_main (this thread holds it for the whole verification), so the file
+    // positions they need are collected here.
+    struct BlockVerifyItem {
+        CBlockIndex* pindex;
+        FlatFilePos block_pos;
+        FlatFilePos undo_pos;
+        uint256 prev_hash;
+        // Results, valid once done.
+        CBlock block;
+        bool read_ok{false};
+        bool block_ok{true};
+        bool undo_ok{true};
+        std::string block_failure;
+        bool done{false};
+    };
+    std::vector<BlockVerifyItem> items;
     for (pindex = chainstate.m_chain.Tip(); pindex && pindex->pprev; pindex = pindex->pprev) {
-        const int percentageDone = std::max(1, std::min(99, (int)(((double)(chainstate.m_chain.Height() - pindex->nHeight)) / (double)nCheckDepth * (nCheckLevel >= 4 ? 50 : 100))));
-        if (reportDone < percentageDone / 10) {
-            // report every 10% step
-            LogPrintf("[%d%%]...", percentageDone); /* Continued */
-            reportDone = percentageDone / 10;
-        }
-        uiInterface.ShowProgress(_("Verifying blocks…").translated, percentageDone, false);
         if (pindex->nHeight <= chainstate.m_chain.Height() - nCheckDepth) {
             break;
         }
@@ -4019,43 +4675,132 @@ bool CVerifyDB::VerifyDB(
             LogPrintf("VerifyDB(): block verification stopping at height %d (pruning, no data)\n", pindex->nHeight);
             break;
         }
-        CBlock block;
-        // check level 0: read from disk
-        if (!ReadBlockFromDisk(block, pindex, consensus_params)) {
+        BlockVerifyItem item;
+        item.pindex = pindex;
+        item.block_pos = pindex->GetBlockPos();
+        item.undo_pos = pindex->GetUndoPos();
+        item.prev_hash = pindex->pprev->GetBlockHash();
+        items.push_back(std::move(item));
+    }
+    CBlockIndex* const pindex_after{pindex};
+
+    // Fan the per-block checks (level 0 disk read, level 1 CheckBlock, level
+    // 2 undo read) out across worker threads; they are independent between
+    // blocks. The level 3 disconnect replay below consumes the results on
+    // this thread in tip-to-genesis order, since it mutates the shared coins
+    // view. Workers stay a bounded number of blocks ahead of the consumer to
+    // cap memory use.
+    constexpr size_t VERIFY_LOOKAHEAD{16};
+    std::mutex mutex;
+    std::condition_variable cv_done, cv_space;
+    size_t next_item{0}; // next item a worker will claim
+    size_t consumed{0};  // items fully processed by the consumer loop below
+    bool stop{false};
+    const size_t worker_count{std::min<size_t>(std::max<size_t>(1, std::thread::hardware_concurrency()), std::max<size_t>(items.size(), 1))};
+    std::vector<std::thread> workers;
+    workers.reserve(worker_count);
+    for (size_t w = 0; w < worker_count; ++w) {
+        workers.emplace_back([&] {
+            for (;;) {
+                size_t index;
+                {
+                    std::unique_lock<std::mutex> lock(mutex);
+                    cv_space.wait(lock, [&] { return stop || (next_item < items.size() && next_item < consumed + VERIFY_LOOKAHEAD); });
+                    if (stop || next_item >= items.size()) return;
+                    index = next_item++;
+                }
+                BlockVerifyItem& item{items[index]};
+                // check level 0: read from disk
+                item.read_ok = ReadBlockFromDisk(item.block, item.block_pos, consensus_params) &&
+                               item.block.GetHash() == item.pindex->GetBlockHash();
+                // check level 1: verify block validity
+                if (item.read_ok && nCheckLevel >= 1) {
+                    BlockValidationState check_state;
+                    if (!CheckBlock(item.block, check_state, consensus_params)) {
+                        item.block_ok = false;
+                        item.block_failure = check_state.ToString();
+                    }
+                }
+                // check level 2: verify undo validity
+                if (item.read_ok && nCheckLevel >= 2 && !item.undo_pos.IsNull()) {
+                    CBlockUndo undo;
+                    item.undo_ok = UndoReadFromDisk(undo, item.undo_pos, item.prev_hash);
+                }
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    item.done = true;
+                }
+                cv_done.notify_all();
+            }
+        });
+    }
+    const auto stop_workers{[&] {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stop = true;
+        }
+        cv_space.notify_all();
+        for (auto& worker : workers) worker.join();
+    }};
+
+    for (size_t index = 0; index < items.size(); ++index) {
+        BlockVerifyItem& item{items[index]};
+        pindex = item.pindex;
+        const int percentageDone = std::max(1, std::min(99, (int)(((double)(chainstate.m_chain.Height() - pindex->nHeight)) / (double)nCheckDepth * (nCheckLevel >= 4 ? 50 : 100))));
+        if (reportDone < percentageDone / 10) {
+            // report every 10% step
+            LogPrintf("[%d%%]...", percentageDone); /* Continued */
+            reportDone = percentageDone / 10;
+        }
+        uiInterface.ShowProgress(_("Verifying blocks…").translated, percentageDone, false);
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            cv_done.wait(lock, [&] { return item.done; });
+        }
+        if (!item.read_ok) {
+            stop_workers();
             return error("VerifyDB(): *** ReadBlockFromDisk failed at %d, hash=%s", pindex->nHeight, pindex->GetBlockHash().ToString());
         }
-        // check level 1: verify block validity
-        if (nCheckLevel >= 1 && !CheckBlock(block, state, consensus_params)) {
+        if (!item.block_ok) {
+            stop_workers();
             return error("%s: *** found bad block at %d, hash=%s (%s)\n", __func__,
-                         pindex->nHeight, pindex->GetBlockHash().ToString(), state.ToString());
-        }
-        // check level 2: verify undo validity
-        if (nCheckLevel >= 2 && pindex) {
-            CBlockUndo undo;
-            if (!pindex->GetUndoPos().IsNull()) {
-                if (!UndoReadFromDisk(undo, pindex)) {
-                    return error("VerifyDB(): *** found bad undo data at %d, hash=%s\n", pindex->nHeight, pindex->GetBlockHash().ToString());
-                }
-            }
+                         pindex->nHeight, pindex->GetBlockHash().ToString(), item.block_failure);
+        }
+        if (!item.undo_ok) {
+            stop_workers();
+            return error("VerifyDB(): *** found bad undo data at %d, hash=%s\n", pindex->nHeight, pindex->GetBlockHash().ToString());
         }
         // check level 3: check for inconsistencies during memory-only disconnect of tip blocks
         size_t curr_coins_usage = coins.DynamicMemoryUsage() + chainstate.CoinsTip().DynamicMemoryUsage();
 
         if (nCheckLevel >= 3 && curr_coins_usage <= chainstate.m_coinstip_cache_size_bytes) {
             assert(coins.GetBestBlock() == pindex->GetBlockHash());
-            DisconnectResult res = chainstate.DisconnectBlock(block, pindex, coins);
+            DisconnectResult res = chainstate.DisconnectBlock(item.block, pindex, coins);
             if (res == DISCONNECT_FAILED) {
+                stop_workers();
                 return error("VerifyDB(): *** irrecoverable inconsistency in block data at %d, hash=%s", pindex->nHeight, pindex->GetBlockHash().ToString());
             }
             if (res == DISCONNECT_UNCLEAN) {
                 nGoodTransactions = 0;
                 pindexFailure = pindex;
             } else {
-                nGoodTransactions += block.vtx.size();
+                nGoodTransactions += item.block.vtx.size();
             }
         }
-        if (ShutdownRequested()) return true;
+        item.block.SetNull(); // done with the block data; release it
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            ++consumed;
+        }
+        cv_space.notify_all();
+        if (ShutdownRequested()) {
+            stop_workers();
+            return true;
+        }
     }
+    stop_workers();
+    pindex = pindex_after;
+
     if (pindexFailure) {
         return error("VerifyDB(): *** coin database inconsistencies found (last %i blocks, %i good transactions before that)\n", chainstate.m_chain.Height() - pindexFailure->nHeight + 1, nGoodTransactions);
     }
@@ -4449,6 +5194,177 @@ void Chainstate::LoadExternalBlockFile(
     LogPrintf("Loaded %i blocks from external file in %dms\n", nLoaded, Ticks<std::chrono::milliseconds>(SteadyClock::now() - start));
 }
 
+//! How often CheckBlockIndex performs a full sweep of the block tree, in
+//! seconds. Between sweeps only the entries dirtied since the last flush are
+//! re-checked, so the safety net can stay enabled on forky networks without
+//! minutes-long pauses per invocation.
+static constexpr int64_t CHECK_BLOCK_INDEX_FULL_INTERVAL{600};
+
+//! Below this many block index entries every invocation does a full sweep:
+//! small trees (regtest, unit tests) are cheap to walk and benefit from the
+//! strongest form of the checks.
+static constexpr size_t CHECK_BLOCK_INDEX_INCREMENTAL_MIN{10000};
+
+namespace {
+//! Ancestor-derived state propagated parent-to-child during CheckBlockIndex's
+//! height-ordered pass. Each pointer is the oldest ancestor (including the
+//! node itself) with the property, mirroring the pindexFirst* trackers of the
+//! previous depth-first walk.
+struct BlockIndexAncestors {
+    const CBlockIndex* first_invalid{nullptr};            //!< Oldest ancestor which is invalid.
+    const CBlockIndex* first_missing{nullptr};            //!< Oldest ancestor which does not have BLOCK_HAVE_DATA.
+    const CBlockIndex* first_never_processed{nullptr};    //!< Oldest ancestor for which nTx == 0.
+    const CBlockIndex* first_not_tree_valid{nullptr};     //!< Oldest ancestor which does not have BLOCK_VALID_TREE.
+    const CBlockIndex* first_not_tx_valid{nullptr};       //!< Oldest ancestor which does not have BLOCK_VALID_TRANSACTIONS.
+    const CBlockIndex* first_not_chain_valid{nullptr};    //!< Oldest ancestor which does not have BLOCK_VALID_CHAIN.
+    const CBlockIndex* first_not_scripts_valid{nullptr};  //!< Oldest ancestor which does not have BLOCK_VALID_SCRIPTS.
+};
+} // namespace
+
+//! Invariants of a single block index entry, checked against itself and its
+//! direct parent only. Applied to every entry as it is dirtied, the pairwise
+//! parent implications close inductively over entire ancestries, so the
+//! incremental mode preserves the chained-validity guarantees of the full
+//! sweep without walking the whole tree. Checks that need global context
+//! (candidate set and unlinked map membership) only run in the full sweep.
+static void CheckBlockIndexEntryLocal(const CBlockIndex* pindex, bool have_pruned)
+{
+    if (!pindex->HaveTxsDownloaded()) assert(pindex->nSequenceId <= 0);
+    if (!have_pruned && !pindex->IsAssumedValid()) {
+        assert(!(pindex->nStatus & BLOCK_HAVE_DATA) == (pindex->nTx == 0));
+    } else if (pindex->nStatus & BLOCK_HAVE_DATA) {
+        assert(pindex->nTx > 0);
+    }
+    if (pindex->nStatus & BLOCK_HAVE_UNDO) assert(pindex->nStatus & BLOCK_HAVE_DATA);
+    if (pindex->IsAssumedValid()) {
+        assert(pindex->nTx > 0);
+        assert((pindex->nStatus & BLOCK_VALID_MASK) >= BLOCK_VALID_TREE);
+    } else {
+        assert(((pindex->nStatus & BLOCK_VALID_MASK) >= BLOCK_VALID_TRANSACTIONS) == (pindex->nTx > 0));
+    }
+    const CBlockIndex* prev{pindex->pprev};
+    if (prev == nullptr) return;
+    assert(pindex->nHeight == prev->nHeight + 1);
+    assert(pindex->nChainWork >= prev->nChainWork);
+    assert(pindex->nHeight < 2 || (pindex->pskip && pindex->pskip->nHeight < pindex->nHeight));
+    assert((pindex->nStatus & BLOCK_VALID_MASK) >= BLOCK_VALID_TREE);
+    if (!pindex->IsAssumedValid() && !prev->IsAssumedValid()) {
+        if ((pindex->nStatus & BLOCK_VALID_MASK) >= BLOCK_VALID_CHAIN) assert((prev->nStatus & BLOCK_VALID_MASK) >= BLOCK_VALID_CHAIN);
+        if ((pindex->nStatus & BLOCK_VALID_MASK) >= BLOCK_VALID_SCRIPTS) assert((prev->nStatus & BLOCK_VALID_MASK) >= BLOCK_VALID_SCRIPTS);
+    }
+}
+
+//! The per-node consistency checks of the full sweep, lifted out of the old
+//! depth-first walk so they can run in parallel over slices of the
+//! height-ordered node list. The caller holds cs_main for the duration; all
+//! reads here are const.
+static void CheckBlockIndexNode(CBlockIndex* pindex, const BlockIndexAncestors& anc, const CChain& chain,
+                                const std::set<CBlockIndex*, node::CBlockIndexWorkComparator>& candidates,
+                                const std::multimap<CBlockIndex*, CBlockIndex*>& blocks_unlinked,
+                                bool have_pruned, bool is_active, const uint256& genesis_hash)
+{
+    if (pindex->pprev == nullptr) {
+        // Genesis block checks.
+        assert(pindex->GetBlockHash() == genesis_hash); // Genesis block's hash must match.
+        assert(pindex == chain.Genesis()); // The current active chain's genesis block must be this block.
+        assert(pindex->nHeight == 0);
+    } else {
+        assert(pindex->nHeight == pindex->pprev->nHeight + 1); // nHeight must be consistent.
+    }
+    if (!pindex->HaveTxsDownloaded()) assert(pindex->nSequenceId <= 0); // nSequenceId can't be set positive for blocks that aren't linked (negative is used for preciousblock)
+    // VALID_TRANSACTIONS is equivalent to nTx > 0 for all nodes (whether or not pruning has occurred).
+    // HAVE_DATA is only equivalent to nTx > 0 (or VALID_TRANSACTIONS) if no pruning has occurred.
+    // Unless these indexes are assumed valid and pending block download on a
+    // background chainstate.
+    if (!have_pruned && !pindex->IsAssumedValid()) {
+        // If we've never pruned, then HAVE_DATA should be equivalent to nTx > 0
+        assert(!(pindex->nStatus & BLOCK_HAVE_DATA) == (pindex->nTx == 0));
+        assert(anc.first_missing == anc.first_never_processed);
+    } else {
+        // If we have pruned, then we can only say that HAVE_DATA implies nTx > 0
+        if (pindex->nStatus & BLOCK_HAVE_DATA) assert(pindex->nTx > 0);
+    }
+    if (pindex->nStatus & BLOCK_HAVE_UNDO) assert(pindex->nStatus & BLOCK_HAVE_DATA);
+    if (pindex->IsAssumedValid()) {
+        // Assumed-valid blocks should have some nTx value.
+        assert(pindex->nTx > 0);
+        // Assumed-valid blocks should connect to the main chain.
+        assert((pindex->nStatus & BLOCK_VALID_MASK) >= BLOCK_VALID_TREE);
+    } else {
+        // Otherwise there should only be an nTx value if we have
+        // actually seen a block's transactions.
+        assert(((pindex->nStatus & BLOCK_VALID_MASK) >= BLOCK_VALID_TRANSACTIONS) == (pindex->nTx > 0)); // This is pruning-independent.
+    }
+    // All parents having had data (at some point) is equivalent to all parents being VALID_TRANSACTIONS, which is equivalent to HaveTxsDownloaded().
+    assert((anc.first_never_processed == nullptr) == pindex->HaveTxsDownloaded());
+    assert((anc.first_not_tx_valid == nullptr) == pindex->HaveTxsDownloaded());
+    assert(pindex->pprev == nullptr || pindex->nChainWork >= pindex->pprev->nChainWork); // For every block except the genesis block, the chainwork must be larger than the parent's.
+    assert(pindex->nHeight < 2 || (pindex->pskip && (pindex->pskip->nHeight < pindex->nHeight))); // The pskip pointer must point back for all but the first 2 blocks.
+    assert(anc.first_not_tree_valid == nullptr); // All m_blockman.m_block_index entries must at least be TREE valid
+    if ((pindex->nStatus & BLOCK_VALID_MASK) >= BLOCK_VALID_TREE) assert(anc.first_not_tree_valid == nullptr); // TREE valid implies all parents are TREE valid
+    if ((pindex->nStatus & BLOCK_VALID_MASK) >= BLOCK_VALID_CHAIN) assert(anc.first_not_chain_valid == nullptr); // CHAIN valid implies all parents are CHAIN valid
+    if ((pindex->nStatus & BLOCK_VALID_MASK) >= BLOCK_VALID_SCRIPTS) assert(anc.first_not_scripts_valid == nullptr); // SCRIPTS valid implies all parents are SCRIPTS valid
+    if (anc.first_invalid == nullptr) {
+        // Checks for not-invalid blocks.
+        assert((pindex->nStatus & BLOCK_FAILED_MASK) == 0); // The failed mask cannot be set for blocks without invalid parents.
+    }
+    if (!CBlockIndexWorkComparator()(pindex, chain.Tip()) && anc.first_never_processed == nullptr) {
+        if (anc.first_invalid == nullptr) {
+            // If this block sorts at least as good as the current tip and
+            // is valid and we have all data for its parents, it must be in
+            // setBlockIndexCandidates.  chain.Tip() must also be there
+            // even if some data has been pruned.
+            //
+            // Don't perform this check for the background chainstate since
+            // its setBlockIndexCandidates shouldn't have some entries (i.e. those past the
+            // snapshot block) which do exist in the block index for the active chainstate.
+            if (is_active && (anc.first_missing == nullptr || pindex == chain.Tip())) {
+                assert(candidates.count(pindex));
+            }
+            // If some parent is missing, then it could be that this block was in
+            // setBlockIndexCandidates but had to be removed because of the missing data.
+            // In this case it must be in m_blocks_unlinked -- see test below.
+        }
+    } else { // If this block sorts worse than the current tip or some ancestor's block has never been seen, it cannot be in setBlockIndexCandidates.
+        assert(candidates.count(pindex) == 0);
+    }
+    // Check whether this block is in m_blocks_unlinked.
+    auto rangeUnlinked = blocks_unlinked.equal_range(pindex->pprev);
+    bool foundInUnlinked = false;
+    while (rangeUnlinked.first != rangeUnlinked.second) {
+        assert(rangeUnlinked.first->first == pindex->pprev);
+        if (rangeUnlinked.first->second == pindex) {
+            foundInUnlinked = true;
+            break;
+        }
+        rangeUnlinked.first++;
+    }
+    if (pindex->pprev && (pindex->nStatus & BLOCK_HAVE_DATA) && anc.first_never_processed != nullptr && anc.first_invalid == nullptr) {
+        // If this block has block data available, some parent was never received, and has no invalid parents, it must be in m_blocks_unlinked.
+        assert(foundInUnlinked);
+    }
+    if (!(pindex->nStatus & BLOCK_HAVE_DATA)) assert(!foundInUnlinked); // Can't be in m_blocks_unlinked if we don't HAVE_DATA
+    if (anc.first_missing == nullptr) assert(!foundInUnlinked); // We aren't missing data for any parent -- cannot be in m_blocks_unlinked.
+    if (pindex->pprev && (pindex->nStatus & BLOCK_HAVE_DATA) && anc.first_never_processed == nullptr && anc.first_missing != nullptr) {
+        // We HAVE_DATA for this block, have received data for all parents at some point, but we're currently missing data for some parent.
+        assert(have_pruned); // We must have pruned.
+        // This block may have entered m_blocks_unlinked if:
+        //  - it has a descendant that at some point had more work than the
+        //    tip, and
+        //  - we tried switching to that descendant but were missing
+        //    data for some intermediate block between m_chain and the
+        //    tip.
+        // So if this block is itself better than chain.Tip() and it wasn't in
+        // setBlockIndexCandidates, then it must be in m_blocks_unlinked.
+        if (!CBlockIndexWorkComparator()(pindex, chain.Tip()) && candidates.count(pindex) == 0) {
+            if (anc.first_invalid == nullptr) {
+                assert(foundInUnlinked);
+            }
+        }
+    }
+    // assert(pindex->GetBlockHash() == pindex->GetBlockHeader().GetHash()); // Perhaps too slow
+}
+
 void Chainstate::CheckBlockIndex()
 {
     if (!fCheckBlockIndex) {
@@ -4465,210 +5381,95 @@ void Chainstate::CheckBlockIndex()
         return;
     }
 
-    // Build forward-pointing map of the entire block tree.
-    std::multimap<CBlockIndex*,CBlockIndex*> forward;
+    // Between full sweeps, re-check only the entries whose state changed
+    // since the last flush: new headers always appear in m_dirty_blockindex,
+    // as does every status/nTx/chainwork mutation.
+    const int64_t now{GetTime()};
+    if (m_blockman.m_block_index.size() >= CHECK_BLOCK_INDEX_INCREMENTAL_MIN &&
+        m_last_full_block_index_check > 0 && now < m_last_full_block_index_check + CHECK_BLOCK_INDEX_FULL_INTERVAL) {
+        for (const CBlockIndex* dirty : m_blockman.m_dirty_blockindex) {
+            CheckBlockIndexEntryLocal(dirty, m_blockman.m_have_pruned);
+        }
+        return;
+    }
+    m_last_full_block_index_check = now;
+
+    // Full sweep. Visit the tree in height order so the ancestor-derived
+    // state can be propagated parent-to-child in one linear pass, then run
+    // the per-node invariant checks — which dominate the cost through their
+    // candidate-set and unlinked-map lookups — in parallel over slices of
+    // the node list.
+    std::vector<CBlockIndex*> nodes;
+    nodes.reserve(m_blockman.m_block_index.size());
+    size_t roots{0};
     for (auto& [_, block_index] : m_blockman.m_block_index) {
-        forward.emplace(block_index.pprev, &block_index);
-    }
-
-    assert(forward.size() == m_blockman.m_block_index.size());
-
-    std::pair<std::multimap<CBlockIndex*,CBlockIndex*>::iterator,std::multimap<CBlockIndex*,CBlockIndex*>::iterator> rangeGenesis = forward.equal_range(nullptr);
-    CBlockIndex *pindex = rangeGenesis.first->second;
-    rangeGenesis.first++;
-    assert(rangeGenesis.first == rangeGenesis.second); // There is only one index entry with parent nullptr.
-
-    // Iterate over the entire block tree, using depth-first search.
-    // Along the way, remember whether there are blocks on the path from genesis
-    // block being explored which are the first to have certain properties.
-    size_t nNodes = 0;
-    int nHeight = 0;
-    CBlockIndex* pindexFirstInvalid = nullptr; // Oldest ancestor of pindex which is invalid.
-    CBlockIndex* pindexFirstMissing = nullptr; // Oldest ancestor of pindex which does not have BLOCK_HAVE_DATA.
-    CBlockIndex* pindexFirstNeverProcessed = nullptr; // Oldest ancestor of pindex for which nTx == 0.
-    CBlockIndex* pindexFirstNotTreeValid = nullptr; // Oldest ancestor of pindex which does not have BLOCK_VALID_TREE (regardless of being valid or not).
-    CBlockIndex* pindexFirstNotTransactionsValid = nullptr; // Oldest ancestor of pindex which does not have BLOCK_VALID_TRANSACTIONS (regardless of being valid or not).
-    CBlockIndex* pindexFirstNotChainValid = nullptr; // Oldest ancestor of pindex which does not have BLOCK_VALID_CHAIN (regardless of being valid or not).
-    CBlockIndex* pindexFirstNotScriptsValid = nullptr; // Oldest ancestor of pindex which does not have BLOCK_VALID_SCRIPTS (regardless of being valid or not).
-    while (pindex != nullptr) {
-        nNodes++;
-        if (pindexFirstInvalid == nullptr && pindex->nStatus & BLOCK_FAILED_VALID) pindexFirstInvalid = pindex;
+        nodes.push_back(&block_index);
+        if (block_index.pprev == nullptr) ++roots;
+    }
+    assert(roots == 1); // There is only one index entry with parent nullptr.
+    std::sort(nodes.begin(), nodes.end(), [](const CBlockIndex* a, const CBlockIndex* b) {
+        return a->nHeight < b->nHeight;
+    });
+
+    std::unordered_map<const CBlockIndex*, BlockIndexAncestors> ancestors;
+    ancestors.reserve(nodes.size());
+    for (const CBlockIndex* pindex : nodes) {
+        BlockIndexAncestors anc;
+        if (pindex->pprev != nullptr) {
+            const auto parent_it = ancestors.find(pindex->pprev);
+            assert(parent_it != ancestors.end()); // Parents sort before their children.
+            anc = parent_it->second;
+        }
+        if (anc.first_invalid == nullptr && pindex->nStatus & BLOCK_FAILED_VALID) anc.first_invalid = pindex;
         // Assumed-valid index entries will not have data since we haven't downloaded the
         // full block yet.
-        if (pindexFirstMissing == nullptr && !(pindex->nStatus & BLOCK_HAVE_DATA) && !pindex->IsAssumedValid()) {
-            pindexFirstMissing = pindex;
+        if (anc.first_missing == nullptr && !(pindex->nStatus & BLOCK_HAVE_DATA) && !pindex->IsAssumedValid()) {
+            anc.first_missing = pindex;
         }
-        if (pindexFirstNeverProcessed == nullptr && pindex->nTx == 0) pindexFirstNeverProcessed = pindex;
-        if (pindex->pprev != nullptr && pindexFirstNotTreeValid == nullptr && (pindex->nStatus & BLOCK_VALID_MASK) < BLOCK_VALID_TREE) pindexFirstNotTreeValid = pindex;
-
+        if (anc.first_never_processed == nullptr && pindex->nTx == 0) anc.first_never_processed = pindex;
+        if (pindex->pprev != nullptr && anc.first_not_tree_valid == nullptr && (pindex->nStatus & BLOCK_VALID_MASK) < BLOCK_VALID_TREE) anc.first_not_tree_valid = pindex;
         if (pindex->pprev != nullptr && !pindex->IsAssumedValid()) {
             // Skip validity flag checks for BLOCK_ASSUMED_VALID index entries, since these
             // *_VALID_MASK flags will not be present for index entries we are temporarily assuming
             // valid.
-            if (pindexFirstNotTransactionsValid == nullptr &&
-                    (pindex->nStatus & BLOCK_VALID_MASK) < BLOCK_VALID_TRANSACTIONS) {
-                pindexFirstNotTransactionsValid = pindex;
-            }
-
-            if (pindexFirstNotChainValid == nullptr &&
-                    (pindex->nStatus & BLOCK_VALID_MASK) < BLOCK_VALID_CHAIN) {
-                pindexFirstNotChainValid = pindex;
-            }
-
-            if (pindexFirstNotScriptsValid == nullptr &&
-                    (pindex->nStatus & BLOCK_VALID_MASK) < BLOCK_VALID_SCRIPTS) {
-                pindexFirstNotScriptsValid = pindex;
-            }
+            if (anc.first_not_tx_valid == nullptr && (pindex->nStatus & BLOCK_VALID_MASK) < BLOCK_VALID_TRANSACTIONS) anc.first_not_tx_valid = pindex;
+            if (anc.first_not_chain_valid == nullptr && (pindex->nStatus & BLOCK_VALID_MASK) < BLOCK_VALID_CHAIN) anc.first_not_chain_valid = pindex;
+            if (anc.first_not_scripts_valid == nullptr && (pindex->nStatus & BLOCK_VALID_MASK) < BLOCK_VALID_SCRIPTS) anc.first_not_scripts_valid = pindex;
         }
+        ancestors.emplace(pindex, anc);
+    }
 
-        // Begin: actual consistency checks.
-        if (pindex->pprev == nullptr) {
-            // Genesis block checks.
-            assert(pindex->GetBlockHash() == m_params.GetConsensus().hashGenesisBlock); // Genesis block's hash must match.
-            assert(pindex == m_chain.Genesis()); // The current active chain's genesis block must be this block.
-        }
-        if (!pindex->HaveTxsDownloaded()) assert(pindex->nSequenceId <= 0); // nSequenceId can't be set positive for blocks that aren't linked (negative is used for preciousblock)
-        // VALID_TRANSACTIONS is equivalent to nTx > 0 for all nodes (whether or not pruning has occurred).
-        // HAVE_DATA is only equivalent to nTx > 0 (or VALID_TRANSACTIONS) if no pruning has occurred.
-        // Unless these indexes are assumed valid and pending block download on a
-        // background chainstate.
-        if (!m_blockman.m_have_pruned && !pindex->IsAssumedValid()) {
-            // If we've never pruned, then HAVE_DATA should be equivalent to nTx > 0
-            assert(!(pindex->nStatus & BLOCK_HAVE_DATA) == (pindex->nTx == 0));
-            assert(pindexFirstMissing == pindexFirstNeverProcessed);
-        } else {
-            // If we have pruned, then we can only say that HAVE_DATA implies nTx > 0
-            if (pindex->nStatus & BLOCK_HAVE_DATA) assert(pindex->nTx > 0);
-        }
-        if (pindex->nStatus & BLOCK_HAVE_UNDO) assert(pindex->nStatus & BLOCK_HAVE_DATA);
-        if (pindex->IsAssumedValid()) {
-            // Assumed-valid blocks should have some nTx value.
-            assert(pindex->nTx > 0);
-            // Assumed-valid blocks should connect to the main chain.
-            assert((pindex->nStatus & BLOCK_VALID_MASK) >= BLOCK_VALID_TREE);
-        } else {
-            // Otherwise there should only be an nTx value if we have
-            // actually seen a block's transactions.
-            assert(((pindex->nStatus & BLOCK_VALID_MASK) >= BLOCK_VALID_TRANSACTIONS) == (pindex->nTx > 0)); // This is pruning-independent.
-        }
-        // All parents having had data (at some point) is equivalent to all parents being VALID_TRANSACTIONS, which is equivalent to HaveTxsDownloaded().
-        assert((pindexFirstNeverProcessed == nullptr) == pindex->HaveTxsDownloaded());
-        assert((pindexFirstNotTransactionsValid == nullptr) == pindex->HaveTxsDownloaded());
-        assert(pindex->nHeight == nHeight); // nHeight must be consistent.
-        assert(pindex->pprev == nullptr || pindex->nChainWork >= pindex->pprev->nChainWork); // For every block except the genesis block, the chainwork must be larger than the parent's.
-        assert(nHeight < 2 || (pindex->pskip && (pindex->pskip->nHeight < nHeight))); // The pskip pointer must point back for all but the first 2 blocks.
-        assert(pindexFirstNotTreeValid == nullptr); // All m_blockman.m_block_index entries must at least be TREE valid
-        if ((pindex->nStatus & BLOCK_VALID_MASK) >= BLOCK_VALID_TREE) assert(pindexFirstNotTreeValid == nullptr); // TREE valid implies all parents are TREE valid
-        if ((pindex->nStatus & BLOCK_VALID_MASK) >= BLOCK_VALID_CHAIN) assert(pindexFirstNotChainValid == nullptr); // CHAIN valid implies all parents are CHAIN valid
-        if ((pindex->nStatus & BLOCK_VALID_MASK) >= BLOCK_VALID_SCRIPTS) assert(pindexFirstNotScriptsValid == nullptr); // SCRIPTS valid implies all parents are SCRIPTS valid
-        if (pindexFirstInvalid == nullptr) {
-            // Checks for not-invalid blocks.
-            assert((pindex->nStatus & BLOCK_FAILED_MASK) == 0); // The failed mask cannot be set for blocks without invalid parents.
-        }
-        if (!CBlockIndexWorkComparator()(pindex, m_chain.Tip()) && pindexFirstNeverProcessed == nullptr) {
-            if (pindexFirstInvalid == nullptr) {
-                const bool is_active = this == &m_chainman.ActiveChainstate();
-
-                // If this block sorts at least as good as the current tip and
-                // is valid and we have all data for its parents, it must be in
-                // setBlockIndexCandidates.  m_chain.Tip() must also be there
-                // even if some data has been pruned.
-                //
-                // Don't perform this check for the background chainstate since
-                // its setBlockIndexCandidates shouldn't have some entries (i.e. those past the
-                // snapshot block) which do exist in the block index for the active chainstate.
-                if (is_active && (pindexFirstMissing == nullptr || pindex == m_chain.Tip())) {
-                    assert(setBlockIndexCandidates.count(pindex));
-                }
-                // If some parent is missing, then it could be that this block was in
-                // setBlockIndexCandidates but had to be removed because of the missing data.
-                // In this case it must be in m_blocks_unlinked -- see test below.
-            }
-        } else { // If this block sorts worse than the current tip or some ancestor's block has never been seen, it cannot be in setBlockIndexCandidates.
-            assert(setBlockIndexCandidates.count(pindex) == 0);
-        }
-        // Check whether this block is in m_blocks_unlinked.
-        std::pair<std::multimap<CBlockIndex*,CBlockIndex*>::iterator,std::multimap<CBlockIndex*,CBlockIndex*>::iterator> rangeUnlinked = m_blockman.m_blocks_unlinked.equal_range(pindex->pprev);
-        bool foundInUnlinked = false;
-        while (rangeUnlinked.first != rangeUnlinked.second) {
-            assert(rangeUnlinked.first->first == pindex->pprev);
-            if (rangeUnlinked.first->second == pindex) {
-                foundInUnlinked = true;
-                break;
-            }
-            rangeUnlinked.first++;
-        }
-        if (pindex->pprev && (pindex->nStatus & BLOCK_HAVE_DATA) && pindexFirstNeverProcessed != nullptr && pindexFirstInvalid == nullptr) {
-            // If this block has block data available, some parent was never received, and has no invalid parents, it must be in m_blocks_unlinked.
-            assert(foundInUnlinked);
-        }
-        if (!(pindex->nStatus & BLOCK_HAVE_DATA)) assert(!foundInUnlinked); // Can't be in m_blocks_unlinked if we don't HAVE_DATA
-        if (pindexFirstMissing == nullptr) assert(!foundInUnlinked); // We aren't missing data for any parent -- cannot be in m_blocks_unlinked.
-        if (pindex->pprev && (pindex->nStatus & BLOCK_HAVE_DATA) && pindexFirstNeverProcessed == nullptr && pindexFirstMissing != nullptr) {
-            // We HAVE_DATA for this block, have received data for all parents at some point, but we're currently missing data for some parent.
-            assert(m_blockman.m_have_pruned); // We must have pruned.
-            // This block may have entered m_blocks_unlinked if:
-            //  - it has a descendant that at some point had more work than the
-            //    tip, and
-            //  - we tried switching to that descendant but were missing
-            //    data for some intermediate block between m_chain and the
-            //    tip.
-            // So if this block is itself better than m_chain.Tip() and it wasn't in
-            // setBlockIndexCandidates, then it must be in m_blocks_unlinked.
-            if (!CBlockIndexWorkComparator()(pindex, m_chain.Tip()) && setBlockIndexCandidates.count(pindex) == 0) {
-                if (pindexFirstInvalid == nullptr) {
-                    assert(foundInUnlinked);
-                }
-            }
+    const bool is_active{this == &m_chainman.ActiveChainstate()};
+    const CChain& chain{m_chain};
+    const auto& candidates{setBlockIndexCandidates};
+    const auto& blocks_unlinked{m_blockman.m_blocks_unlinked};
+    const bool have_pruned{m_blockman.m_have_pruned};
+    const uint256& genesis_hash{m_params.GetConsensus().hashGenesisBlock};
+    const auto check_range = [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            CheckBlockIndexNode(nodes[i], ancestors.at(nodes[i]), chain, candidates, blocks_unlinked,
+                                have_pruned, is_active, genesis_hash);
         }
-        // assert(pindex->GetBlockHash() == pindex->GetBlockHeader().GetHash()); // Perhaps too slow
-        // End: actual consistency checks.
+    };
 
-        // Try descending into the first subnode.
-        std::pair<std::multimap<CBlockIndex*,CBlockIndex*>::iterator,std::multimap<CBlockIndex*,CBlockIndex*>::iterator> range = forward.equal_range(pindex);
-        if (range.first != range.second) {
-            // A subnode was found.
-            pindex = range.first->second;
-            nHeight++;
-            continue;
-        }
-        // This is a leaf node.
-        // Move upwards until we reach a node of which we have not yet visited the last child.
-        while (pindex) {
-            // We are going to either move to a parent or a sibling of pindex.
-            // If pindex was the first with a certain property, unset the corresponding variable.
-            if (pindex == pindexFirstInvalid) pindexFirstInvalid = nullptr;
-            if (pindex == pindexFirstMissing) pindexFirstMissing = nullptr;
-            if (pindex == pindexFirstNeverProcessed) pindexFirstNeverProcessed = nullptr;
-            if (pindex == pindexFirstNotTreeValid) pindexFirstNotTreeValid = nullptr;
-            if (pindex == pindexFirstNotTransactionsValid) pindexFirstNotTransactionsValid = nullptr;
-            if (pindex == pindexFirstNotChainValid) pindexFirstNotChainValid = nullptr;
-            if (pindex == pindexFirstNotScriptsValid) pindexFirstNotScriptsValid = nullptr;
-            // Find our parent.
-            CBlockIndex* pindexPar = pindex->pprev;
-            // Find which child we just visited.
-            std::pair<std::multimap<CBlockIndex*,CBlockIndex*>::iterator,std::multimap<CBlockIndex*,CBlockIndex*>::iterator> rangePar = forward.equal_range(pindexPar);
-            while (rangePar.first->second != pindex) {
-                assert(rangePar.first != rangePar.second); // Our parent must have at least the node we're coming from as child.
-                rangePar.first++;
-            }
-            // Proceed to the next one.
-            rangePar.first++;
-            if (rangePar.first != rangePar.second) {
-                // Move to the sibling.
-                pindex = rangePar.first->second;
-                break;
-            } else {
-                // Move up further.
-                pindex = pindexPar;
-                nHeight--;
-                continue;
-            }
-        }
+    // Below this the thread fan-out costs more than it saves.
+    constexpr size_t MIN_NODES_PER_CHECK_THREAD{4096};
+    const size_t num_threads{std::clamp<size_t>(std::min<size_t>(GetNumCores(), nodes.size() / MIN_NODES_PER_CHECK_THREAD), 1, 8)};
+    if (num_threads <= 1) {
+        check_range(0, nodes.size());
+        return;
+    }
+    std::vector<std::thread> workers;
+    workers.reserve(num_threads);
+    const size_t nodes_per_thread{nodes.size() / num_threads};
+    for (size_t t = 0; t < num_threads; ++t) {
+        const size_t begin{t * nodes_per_thread};
+        const size_t end{t == num_threads - 1 ? nodes.size() : begin + nodes_per_thread};
+        workers.emplace_back([&, begin, end] { check_range(begin, end); });
+    }
+    for (auto& worker : workers) {
+        worker.join();
     }
-
-    // Check that we actually traversed the entire map.
-    assert(nNodes == forward.size());
 }
 
 std::string Chainstate::ToString()
@@ -4797,6 +5598,15 @@ bool ChainstateManager::ActivateSnapshot(
         AutoFile& coins_file,
         const SnapshotMetadata& metadata,
         bool in_memory)
+{
+    std::vector<AutoFile*> coins_files{&coins_file};
+    return ActivateSnapshot(coins_files, metadata, in_memory);
+}
+
+bool ChainstateManager::ActivateSnapshot(
+        const std::vector<AutoFile*>& coins_files,
+        const SnapshotMetadata& metadata,
+        bool in_memory)
 {
     uint256 base_blockhash = metadata.m_base_blockhash;
 
@@ -4851,7 +5661,7 @@ bool ChainstateManager::ActivateSnapshot(
     }
 
     const bool snapshot_ok = this->PopulateAndValidateSnapshot(
-        *snapshot_chainstate, coins_file, metadata);
+        *snapshot_chainstate, coins_files, metadata);
 
     if (!snapshot_ok) {
         WITH_LOCK(::cs_main, this->MaybeRebalanceCaches());
@@ -4889,7 +5699,7 @@ static void FlushSnapshotToDisk(CCoinsViewCache& coins_cache, bool snapshot_load
 
 bool ChainstateManager::PopulateAndValidateSnapshot(
     Chainstate& snapshot_chainstate,
-    AutoFile& coins_file,
+    const std::vector<AutoFile*>& coins_files,
     const SnapshotMetadata& metadata)
 {
     // It's okay to release cs_main before we're done using `coins_cache` because we know
@@ -4919,67 +5729,169 @@ bool ChainstateManager::PopulateAndValidateSnapshot(
 
     const AssumeutxoData& au_data = *maybe_au_data;
 
-    COutPoint outpoint;
-    Coin coin;
     const uint64_t coins_count = metadata.m_coins_count;
     uint64_t coins_left = metadata.m_coins_count;
 
-    LogPrintf("[snapshot] loading coins from snapshot %s\n", base_blockhash.ToString());
+    LogPrintf("[snapshot] loading coins from snapshot %s (%d file%s)\n",
+              base_blockhash.ToString(), coins_files.size(), coins_files.size() == 1 ? "" : "s");
     int64_t coins_processed{0};
 
-    while (coins_left > 0) {
-        try {
-            coins_file >> outpoint;
-            coins_file >> coin;
-        } catch (const std::ios_base::failure&) {
-            LogPrintf("[snapshot] bad snapshot format or truncated snapshot after deserializing %d coins\n",
-                      coins_count - coins_left);
-            return false;
-        }
-        if (coin.nHeight > base_height ||
-            outpoint.n >= std::numeric_limits<decltype(outpoint.n)>::max() // Avoid integer wrap-around in coinstats.cpp:ApplyHash
-        ) {
-            LogPrintf("[snapshot] bad snapshot data after deserializing %d coins\n",
-                      coins_count - coins_left);
-            return false;
-        }
+    // Deserialize on reader threads (one per snapshot file) while this thread
+    // validates the coins and inserts them into the (sharded) coins cache, so
+    // stream decode overlaps hash-map insertion and periodic flushing. The
+    // files are disjoint slices of the same UTXO set, so each reader simply
+    // drains its stream to EOF and between them the readers must produce
+    // exactly `coins_count` coins.
+    constexpr size_t SNAPSHOT_BATCH_SIZE{16384};
+    constexpr size_t SNAPSHOT_MAX_QUEUED{8};
+    std::mutex queue_mutex;
+    std::condition_variable cv_batch, cv_space;
+    std::deque<std::vector<std::pair<COutPoint, Coin>>> batches;
+    int readers_running(coins_files.size());
+    bool read_error{false};
+    bool consumer_abort{false};
+
+    std::vector<std::thread> readers;
+    readers.reserve(coins_files.size());
+    for (AutoFile* coins_file : coins_files) {
+        readers.emplace_back([&, coins_file] {
+            std::vector<std::pair<COutPoint, Coin>> batch;
+            batch.reserve(SNAPSHOT_BATCH_SIZE);
+            bool error{false};
+            bool aborted{false};
+            while (true) {
+                COutPoint outpoint_in;
+                Coin coin_in;
+                try {
+                    *coins_file >> outpoint_in;
+                } catch (const std::ios_base::failure&) {
+                    // Clean end of this stream.
+                    break;
+                }
+                try {
+                    *coins_file >> coin_in;
+                } catch (const std::ios_base::failure&) {
+                    // Truncated mid-entry.
+                    error = true;
+                    break;
+                }
+                batch.emplace_back(std::move(outpoint_in), std::move(coin_in));
+                if (batch.size() == SNAPSHOT_BATCH_SIZE) {
+                    std::unique_lock<std::mutex> lock(queue_mutex);
+                    cv_space.wait(lock, [&] { return batches.size() < SNAPSHOT_MAX_QUEUED || consumer_abort; });
+                    if (consumer_abort) {
+                        aborted = true;
+                        break;
+                    }
+                    batches.push_back(std::move(batch));
+                    cv_batch.notify_one();
+                    batch = {};
+                    batch.reserve(SNAPSHOT_BATCH_SIZE);
+                }
+            }
+            {
+                std::unique_lock<std::mutex> lock(queue_mutex);
+                if (!batch.empty() && !error && !aborted) {
+                    cv_space.wait(lock, [&] { return batches.size() < SNAPSHOT_MAX_QUEUED || consumer_abort; });
+                    if (!consumer_abort) batches.push_back(std::move(batch));
+                }
+                if (error) read_error = true;
+                --readers_running;
+            }
+            cv_batch.notify_one();
+        });
+    }
 
-        coins_cache.EmplaceCoinInternalDANGER(std::move(outpoint), std::move(coin));
+    bool load_ok{true};
+    bool excess_coins{false};
+    while (load_ok) {
+        std::vector<std::pair<COutPoint, Coin>> batch;
+        {
+            std::unique_lock<std::mutex> lock(queue_mutex);
+            cv_batch.wait(lock, [&] { return !batches.empty() || readers_running == 0; });
+            if (batches.empty()) break;
+            batch = std::move(batches.front());
+            batches.pop_front();
+        }
+        cv_space.notify_all();
+
+        for (auto& entry : batch) {
+            if (!load_ok) break;
+            if (coins_left == 0) {
+                excess_coins = true;
+                load_ok = false;
+                break;
+            }
+            if (entry.second.nHeight > base_height ||
+                entry.first.n >= std::numeric_limits<decltype(entry.first.n)>::max() // Avoid integer wrap-around in coinstats.cpp:ApplyHash
+            ) {
+                LogPrintf("[snapshot] bad snapshot data after deserializing %d coins\n",
+                          coins_count - coins_left);
+                load_ok = false;
+                break;
+            }
 
-        --coins_left;
-        ++coins_processed;
+            coins_cache.EmplaceCoinInternalDANGER(std::move(entry.first), std::move(entry.second));
 
-        if (coins_processed % 1000000 == 0) {
-            LogPrintf("[snapshot] %d coins loaded (%.2f%%, %.2f MB)\n",
-                coins_processed,
-                static_cast<float>(coins_processed) * 100 / static_cast<float>(coins_count),
-                coins_cache.DynamicMemoryUsage() / (1000 * 1000));
-        }
+            --coins_left;
+            ++coins_processed;
 
-        // Batch write and flush (if we need to) every so often.
-        //
-        // If our average Coin size is roughly 41 bytes, checking every 120,000 coins
-        // means <5MB of memory imprecision.
-        if (coins_processed % 120000 == 0) {
-            if (ShutdownRequested()) {
-                return false;
+            if (coins_processed % 1000000 == 0) {
+                LogPrintf("[snapshot] %d coins loaded (%.2f%%, %.2f MB)\n",
+                    coins_processed,
+                    static_cast<float>(coins_processed) * 100 / static_cast<float>(coins_count),
+                    coins_cache.DynamicMemoryUsage() / (1000 * 1000));
             }
 
-            const auto snapshot_cache_state = WITH_LOCK(::cs_main,
-                return snapshot_chainstate.GetCoinsCacheSizeState());
+            // Batch write and flush (if we need to) every so often.
+            //
+            // If our average Coin size is roughly 41 bytes, checking every 120,000 coins
+            // means <5MB of memory imprecision.
+            if (coins_processed % 120000 == 0) {
+                if (ShutdownRequested()) {
+                    load_ok = false;
+                    break;
+                }
+
+                const auto snapshot_cache_state = WITH_LOCK(::cs_main,
+                    return snapshot_chainstate.GetCoinsCacheSizeState());
 
-            if (snapshot_cache_state >= CoinsCacheSizeState::CRITICAL) {
-                // This is a hack - we don't know what the actual best block is, but that
-                // doesn't matter for the purposes of flushing the cache here. We'll set this
-                // to its correct value (`base_blockhash`) below after the coins are loaded.
-                coins_cache.SetBestBlock(GetRandHash());
+                if (snapshot_cache_state >= CoinsCacheSizeState::CRITICAL) {
+                    // This is a hack - we don't know what the actual best block is, but that
+                    // doesn't matter for the purposes of flushing the cache here. We'll set this
+                    // to its correct value (`base_blockhash`) below after the coins are loaded.
+                    coins_cache.SetBestBlock(GetRandHash());
 
-                // No need to acquire cs_main since this chainstate isn't being used yet.
-                FlushSnapshotToDisk(coins_cache, /*snapshot_loaded=*/false);
+                    // No need to acquire cs_main since this chainstate isn't being used yet.
+                    FlushSnapshotToDisk(coins_cache, /*snapshot_loaded=*/false);
+                }
             }
         }
     }
 
+    {
+        std::lock_guard<std::mutex> lock(queue_mutex);
+        consumer_abort = true;
+    }
+    cv_space.notify_all();
+    for (std::thread& reader : readers) reader.join();
+
+    if (excess_coins) {
+        LogPrintf("[snapshot] bad snapshot - coins left over after deserializing %d coins\n",
+                  coins_count);
+        return false;
+    }
+    if (!load_ok) {
+        return false;
+    }
+    if (read_error || coins_left > 0) {
+        // A reader hit a deserialization failure, or the files between them
+        // contained fewer coins than the metadata promised.
+        LogPrintf("[snapshot] bad snapshot format or truncated snapshot after deserializing %d coins\n",
+                  coins_count - coins_left);
+        return false;
+    }
+
     // Important that we set this. This and the coins_cache accesses above are
     // sort of a layer violation, but either we reach into the innards of
     // CCoinsViewCache here or we have to invert some of the Chainstate to
@@ -4987,19 +5899,6 @@ bool ChainstateManager::PopulateAndValidateSnapshot(
     // method.
     coins_cache.SetBestBlock(base_blockhash);
 
-    bool out_of_coins{false};
-    try {
-        coins_file >> outpoint;
-    } catch (const std::ios_base::failure&) {
-        // We expect an exception since we should be out of coins.
-        out_of_coins = true;
-    }
-    if (!out_of_coins) {
-        LogPrintf("[snapshot] bad snapshot - coins left over after deserializing %d coins\n",
-            coins_count);
-        return false;
-    }
-
     LogPrintf("[snapshot] loaded %d (%.2f MB) coins from snapshot %s\n",
         coins_count,
         coins_cache.DynamicMemoryUsage() / (1000 * 1000),
@@ -5091,6 +5990,17 @@ Chainstate& ChainstateManager::ActiveChainstate() const
     return *m_active_chainstate;
 }
 
+void ChainstateManager::PublishTip(const CBlockIndex& tip)
+{
+    std::atomic_store(&m_published_tip, std::make_shared<const PublishedChainTip>(PublishedChainTip{
+        tip.nHeight, tip.GetBlockHash(), tip.GetBlockTime(), tip.nBits, tip.nChainWork}));
+}
+
+std::shared_ptr<const PublishedChainTip> ChainstateManager::GetPublishedTip() const
+{
+    return std::atomic_load(&m_published_tip);
+}
+
 bool ChainstateManager::IsSnapshotActive() const
 {
     LOCK(::cs_main);
@@ -5128,8 +6038,58 @@ void ChainstateManager::MaybeRebalanceCaches()
     }
 }
 
+void ChainstateManager::ActivationThread()
+{
+    while (true) {
+        std::shared_ptr<const CBlock> block;
+        {
+            std::unique_lock<std::mutex> lock{m_activation_mutex};
+            m_activation_cv.wait(lock, [&]() { return m_activation_stop || !m_activation_queue.empty(); });
+            if (m_activation_stop) return;
+            block = std::move(m_activation_queue.front());
+            m_activation_queue.pop_front();
+        }
+        BlockValidationState state; // Only used to report errors, not invalidity - ignore it
+        if (!ActiveChainstate().ActivateBestChain(state, block)) {
+            error("%s: ActivateBestChain failed (%s)", __func__, state.ToString());
+        }
+    }
+}
+
+void ChainstateManager::QueueBestChainActivation(const std::shared_ptr<const CBlock>& block)
+{
+    AssertLockNotHeld(::cs_main);
+    std::unique_lock<std::mutex> lock{m_activation_mutex};
+    if (m_activation_stop) return;
+    if (!m_activation_thread.joinable()) {
+        m_activation_thread = std::thread(&util::TraceThread, "chainactivation", [this] { ActivationThread(); });
+    }
+    // Any single ActivateBestChain() call walks all the way to the most-work
+    // tip, so older queued hints are redundant; keep only the latest block.
+    m_activation_queue.clear();
+    m_activation_queue.push_back(block);
+    m_activation_cv.notify_one();
+}
+
+void ChainstateManager::StopActivationThread()
+{
+    AssertLockNotHeld(::cs_main);
+    {
+        std::unique_lock<std::mutex> lock{m_activation_mutex};
+        m_activation_stop = true;
+        m_activation_queue.clear();
+    }
+    m_activation_cv.notify_all();
+    if (m_activation_thread.joinable()) m_activation_thread.join();
+}
+
 ChainstateManager::~ChainstateManager()
 {
+    // Join the -asyncactivation worker (if any) before tearing down the
+    // chainstates it operates on. Must happen before taking cs_main below,
+    // since the worker acquires cs_main itself.
+    StopActivationThread();
+
     LOCK(::cs_main);
 
     m_versionbitscache.Clear();
@@ -22,17 +22,21 @@
 #include <policy/feerate.h>
 #include <policy/packages.h>
 #include <policy/policy.h>
+#include <pow.h>
 #include <script/script_error.h>
 #include <sync.h>
 #include <txdb.h>
 #include <txmempool.h> // For CTxMemPool::cs
 #include <uint256.h>
+#include <undo.h> // For CBlockUndo in the recent-undo cache
 #include <util/check.h>
 #include <util/hasher.h>
 #include <util/translation.h>
 #include <versionbits.h>
 
 #include <atomic>
+#include <condition_variable>
+#include <deque>
 #include <map>
 #include <memory>
 #include <optional>
@@ -46,6 +50,9 @@
 class Chainstate;
 class CBlockTreeDB;
 class CTxMemPool;
+namespace CuckooCache {
+struct Stats;
+} // namespace CuckooCache
 class ChainstateManager;
 struct ChainTxData;
 struct DisconnectedBlockTransactions;
@@ -67,9 +74,20 @@ static const int64_t DEFAULT_MAX_TIP_AGE = 24 * 60 * 60;
 static const bool DEFAULT_CHECKPOINTS_ENABLED = true;
 static const bool DEFAULT_TXINDEX = false;
 static constexpr bool DEFAULT_COINSTATSINDEX{false};
+static constexpr bool DEFAULT_SCRIPTHASHINDEX{false};
 static const char* const DEFAULT_BLOCKFILTERINDEX = "0";
 /** Default for -stopatheight */
 static const int DEFAULT_STOPATHEIGHT = 0;
+/** Default for -asyncactivation */
+static constexpr bool DEFAULT_ASYNC_ACTIVATION{false};
+/** Default for -warmcoinscache */
+static constexpr bool DEFAULT_WARM_COINS_CACHE{true};
+/** Default for -maxreorgcache, in MiB */
+static constexpr int64_t DEFAULT_MAX_REORG_CACHE_MB{16};
+/** Default for -powsampleinterval (0 or 1 verifies every header) */
+static constexpr int64_t DEFAULT_POW_SAMPLE_INTERVAL{0};
+/** Default for -coinsretainwindow, in blocks (0 disables the young-coin write tier) */
+static constexpr int DEFAULT_COINS_RETAIN_WINDOW{288};
 /** Block files containing a block-height within MIN_BLOCKS_TO_KEEP of ActiveChain().Tip() will not be pruned. */
 static const unsigned int MIN_BLOCKS_TO_KEEP = 288;
 static const signed int DEFAULT_CHECKBLOCKS = 6;
@@ -244,6 +262,28 @@ MempoolAcceptResult AcceptToMemoryPool(Chainstate& active_chainstate, const CTra
                                        int64_t accept_time, bool bypass_limits, bool test_accept)
     EXCLUSIVE_LOCKS_REQUIRED(cs_main);
 
+/**
+ * Try to add a batch of independent transactions to the mempool. All inputs
+ * are fetched into the coins cache in one pass before validation, and the
+ * cache-limit check runs once for the whole batch instead of per transaction,
+ * amortizing per-call overhead during relay storms and mempool reload.
+ *
+ * @param[in]  active_chainstate  Reference to the active chainstate.
+ * @param[in]  txns               Transactions to submit, each with the timestamp
+ *                                used for mempool entry and expiry.
+ * @param[in]  bypass_limits      When true, don't enforce mempool fee and capacity limits.
+ * @param[in]  skip_script_checks When true, skip script execution. Only sound when
+ *                                replaying transactions this node already validated
+ *                                against the current tip (mempool reload).
+ *
+ * @returns one MempoolAcceptResult per transaction, in the order given.
+ */
+std::vector<MempoolAcceptResult> AcceptToMemoryPoolBatch(Chainstate& active_chainstate,
+                                                         const std::vector<std::pair<CTransactionRef, int64_t>>& txns,
+                                                         bool bypass_limits,
+                                                         bool skip_script_checks = false)
+    EXCLUSIVE_LOCKS_REQUIRED(cs_main);
+
 /**
 * Validate (and maybe submit) a package to the mempool. See doc/policy/packages.md for full details
 * on package validation rules.
@@ -325,6 +365,12 @@ public:
 /** Initializes the script-execution cache */
 [[nodiscard]] bool InitScriptExecutionCache(size_t max_size_bytes);
 
+//! Bytes actually allocated for the script execution cache table.
+size_t ScriptExecutionCacheBytes();
+
+/** Occupancy and hit/miss counters of the script-execution cache. */
+CuckooCache::Stats GetScriptExecutionCacheStats() LOCKS_EXCLUDED(cs_main);
+
 /** Functions for validating blocks and updating the block tree */
 
 /** Context-independent validity checks */
@@ -340,8 +386,15 @@ bool TestBlockValidity(BlockValidationState& state,
                        bool fCheckPOW = true,
                        bool fCheckMerkleRoot = true) EXCLUSIVE_LOCKS_REQUIRED(cs_main);
 
-/** Check with the proof of work on each blockheader matches the value in nBits */
-bool HasValidProofOfWork(const std::vector<CBlockHeader>& headers, const Consensus::Params& consensusParams);
+/** Check with the proof of work on each blockheader matches the value in nBits.
+ * The source selects the RandomX admission class the hashing runs under. */
+bool HasValidProofOfWork(const std::vector<CBlockHeader>& headers, const Consensus::Params& consensusParams, RandomXSource source = RandomXSource::CHAIN);
+
+/** Decide whether a header at the given height, on a chain claiming the given
+ * cumulative work, must have its RandomX proof of work verified. Always true at
+ * or above the minimum-chainwork anchor and on retarget boundaries; below the
+ * anchor, -powsampleinterval=<n> verifies a random 1-in-n sample. */
+bool ShouldVerifyHeaderPoW(int height, const arith_uint256& claimed_chain_work, const Consensus::Params& params);
 
 /** Return the sum of the work on a given set of headers */
 arith_uint256 CalculateHeadersWork(const std::vector<CBlockHeader>& headers);
@@ -463,6 +516,10 @@ protected:
      */
     mutable std::atomic<bool> m_cached_finished_ibd{false};
 
+    //! When CheckBlockIndex last performed a full sweep of the block tree
+    //! (0 = never); between sweeps it only re-checks dirtied entries.
+    int64_t m_last_full_block_index_check GUARDED_BY(::cs_main){0};
+
     //! Optional mempool that is kept in sync with the chain.
     //! Only the active chainstate has a mempool.
     CTxMemPool* m_mempool;
@@ -659,13 +716,15 @@ public:
     bool AcceptBlock(const std::shared_ptr<const CBlock>& pblock, BlockValidationState& state, CBlockIndex** ppindex, bool fRequested, const FlatFilePos* dbp, bool* fNewBlock, bool min_pow_checked) EXCLUSIVE_LOCKS_REQUIRED(cs_main);
 
     // Block (dis)connection on a given view:
-    DisconnectResult DisconnectBlock(const CBlock& block, const CBlockIndex* pindex, CCoinsViewCache& view)
+    //! If undo is provided, it is consumed instead of reading the undo data
+    //! from disk (used to prefetch undo records across a reorg batch).
+    DisconnectResult DisconnectBlock(const CBlock& block, const CBlockIndex* pindex, CCoinsViewCache& view, CBlockUndo* undo = nullptr)
         EXCLUSIVE_LOCKS_REQUIRED(::cs_main);
     bool ConnectBlock(const CBlock& block, BlockValidationState& state, CBlockIndex* pindex,
                       CCoinsViewCache& view, bool fJustCheck = false) EXCLUSIVE_LOCKS_REQUIRED(cs_main);
 
     // Apply the effects of a block disconnection on the UTXO set.
-    bool DisconnectTip(BlockValidationState& state, DisconnectedBlockTransactions* disconnectpool) EXCLUSIVE_LOCKS_REQUIRED(cs_main, m_mempool->cs);
+    bool DisconnectTip(BlockValidationState& state, DisconnectedBlockTransactions* disconnectpool, CBlockUndo* prefetched_undo = nullptr) EXCLUSIVE_LOCKS_REQUIRED(cs_main, m_mempool->cs);
 
     // Manual block validity manipulation:
     /** Mark a block as precious and reorganize.
@@ -705,6 +764,11 @@ public:
     /**
      * Make various assertions about the state of the block index.
      *
+     * A full sweep of the tree runs periodically; between sweeps only the
+     * entries dirtied since the last flush are re-checked against themselves
+     * and their direct parents, keeping the check cheap enough to leave
+     * enabled on forky networks.
+     *
      * By default this only executes fully when using the Regtest chain; see: fCheckBlockIndex.
      */
     void CheckBlockIndex();
@@ -712,6 +776,16 @@ public:
     /** Load the persisted mempool from disk */
     void LoadMempool(const fs::path& load_path, fsbridge::FopenFn mockable_fopen_function = fsbridge::fopen);
 
+    /**
+     * Prefetch the coins referenced by the loaded mempool's inputs and by
+     * recent blocks' transactions into the coins cache, so the first blocks
+     * connected after a restart see a warm cache instead of a LevelDB read
+     * per input. The database reads run in parallel; insertion into the
+     * cache is a single pass under cs_main and stops before the prefetched
+     * coins could force an early flush.
+     */
+    void WarmCoinsCache() EXCLUSIVE_LOCKS_REQUIRED(!cs_main);
+
     /** Update the chain tip based on database information, i.e. CoinsTip()'s best block. */
     bool LoadChainTip() EXCLUSIVE_LOCKS_REQUIRED(cs_main);
 
@@ -739,6 +813,22 @@ private:
     void CheckForkWarningConditions() EXCLUSIVE_LOCKS_REQUIRED(cs_main);
     void InvalidChainFound(CBlockIndex* pindexNew) EXCLUSIVE_LOCKS_REQUIRED(cs_main);
 
+    /**
+     * Undo data of the most recently connected blocks, so that the common
+     * short reorg disconnects its blocks without reading rev*.dat at all.
+     * Bounded by -maxreorgcache; since blocks connect in chain order, the
+     * insertion order doubles as the eviction order.
+     */
+    std::map<uint256, CBlockUndo> m_recent_undo GUARDED_BY(::cs_main);
+    std::deque<uint256> m_recent_undo_order GUARDED_BY(::cs_main);
+    size_t m_recent_undo_bytes GUARDED_BY(::cs_main){0};
+
+    //! Remember the undo data of a freshly connected block, evicting the
+    //! oldest entries once the -maxreorgcache budget is exceeded.
+    void CacheBlockUndo(const uint256& block_hash, CBlockUndo&& undo) EXCLUSIVE_LOCKS_REQUIRED(::cs_main);
+    //! Take (and erase) the cached undo data for a block, if present.
+    std::optional<CBlockUndo> TakeCachedBlockUndo(const uint256& block_hash) EXCLUSIVE_LOCKS_REQUIRED(::cs_main);
+
     //! Indirection necessary to make lock annotations work with an optional mempool.
     RecursiveMutex* MempoolMutex() const LOCK_RETURNED(m_mempool->cs)
     {
@@ -796,6 +886,21 @@ private:
  *    IBD process is happening in the background while use of the
  *    active (snapshot) chainstate allows the rest of the system to function.
  */
+/**
+ * Immutable summary of the active chain tip, published by the validation code
+ * on every tip change and readable without cs_main through
+ * ChainstateManager::GetPublishedTip(). Components that only need these basic
+ * tip fields (RPC polling endpoints, the GUI) read the published copy instead
+ * of convoying on cs_main behind block validation.
+ */
+struct PublishedChainTip {
+    int height;
+    uint256 hash;
+    int64_t time;
+    uint32_t nBits;
+    arith_uint256 chainwork;
+};
+
 class ChainstateManager
 {
 private:
@@ -844,10 +949,15 @@ private:
 
     CBlockIndex* m_best_invalid GUARDED_BY(::cs_main){nullptr};
 
-    //! Internal helper for ActivateSnapshot().
+    //! Latest published tip summary. Accessed only through the std::atomic_*
+    //! shared_ptr free functions; see PublishTip()/GetPublishedTip().
+    std::shared_ptr<const PublishedChainTip> m_published_tip;
+
+    //! Internal helper for ActivateSnapshot(). Deserializes coins from every
+    //! file in `coins_files` concurrently (one reader thread per file).
     [[nodiscard]] bool PopulateAndValidateSnapshot(
         Chainstate& snapshot_chainstate,
-        AutoFile& coins_file,
+        const std::vector<AutoFile*>& coins_files,
         const node::SnapshotMetadata& metadata);
 
     /**
@@ -856,17 +966,34 @@ private:
      * Caller must set min_pow_checked=true in order to add a new header to the
      * block index (permanent memory storage), indicating that the header is
      * known to be part of a sufficiently high-work chain (anti-dos check).
+     * `best_header` is updated in place if the new header has more work; batch
+     * callers pass a local copy and commit it to m_best_header once per batch.
      */
     bool AcceptBlockHeader(
         const CBlockHeader& block,
         BlockValidationState& state,
         CBlockIndex** ppindex,
-        bool min_pow_checked) EXCLUSIVE_LOCKS_REQUIRED(cs_main);
+        bool min_pow_checked,
+        CBlockIndex*& best_header) EXCLUSIVE_LOCKS_REQUIRED(cs_main);
     friend Chainstate;
 
     /** Most recent headers presync progress update, for rate-limiting. */
     std::chrono::time_point<std::chrono::steady_clock> m_last_presync_update GUARDED_BY(::cs_main) {};
 
+    //! State of the -asyncactivation worker, which runs ActivateBestChain()
+    //! off the caller's thread. See QueueBestChainActivation().
+    std::mutex m_activation_mutex;
+    std::condition_variable m_activation_cv;
+    //! Blocks handed to ProcessNewBlock while -asyncactivation is enabled.
+    //! Only the most recent entry matters as an activation hint, so the
+    //! queue is collapsed to a single element when a new block arrives.
+    std::deque<std::shared_ptr<const CBlock>> m_activation_queue GUARDED_BY(m_activation_mutex);
+    bool m_activation_stop GUARDED_BY(m_activation_mutex){false};
+    std::thread m_activation_thread;
+
+    //! Entry point of the -asyncactivation worker thread.
+    void ActivationThread();
+
 public:
     using Options = kernel::ChainstateManagerOpts;
 
@@ -960,9 +1087,26 @@ public:
     [[nodiscard]] bool ActivateSnapshot(
         AutoFile& coins_file, const node::SnapshotMetadata& metadata, bool in_memory);
 
+    //! As above, but load the coins from several snapshot shard files in
+    //! parallel. Each file carries identical metadata followed by a disjoint
+    //! subset of the UTXO set (see `dumptxoutset` with `shards` > 1); between
+    //! them the files must contain exactly `metadata.m_coins_count` coins.
+    [[nodiscard]] bool ActivateSnapshot(
+        const std::vector<AutoFile*>& coins_files, const node::SnapshotMetadata& metadata, bool in_memory);
+
     //! The most-work chain.
     Chainstate& ActiveChainstate() const;
     CChain& ActiveChain() const EXCLUSIVE_LOCKS_REQUIRED(GetMutex()) { return ActiveChainstate().m_chain; }
+
+    //! Publish a new tip summary for lock-free readers.
+    void PublishTip(const CBlockIndex& tip);
+    /**
+     * The last published summary of the active chain tip, or nullptr before a
+     * tip is first set. Reading takes no locks; the returned object is
+     * immutable and may trail a tip update in flight by design.
+     */
+    std::shared_ptr<const PublishedChainTip> GetPublishedTip() const;
+
     int ActiveHeight() const EXCLUSIVE_LOCKS_REQUIRED(GetMutex()) { return ActiveChain().Height(); }
     CBlockIndex* ActiveTip() const EXCLUSIVE_LOCKS_REQUIRED(GetMutex()) { return ActiveChain().Tip(); }
 
@@ -1053,6 +1197,26 @@ public:
      *  information. */
     void ReportHeadersPresync(const arith_uint256& work, int64_t height, int64_t timestamp);
 
+    /** Progress of the best-chain activation currently running, if any.
+     *  Maintained by Chainstate::ActivateBestChain() and surfaced through the
+     *  getchainactivationstatus RPC. */
+    std::atomic<bool> m_activation_in_progress{false};
+    //! Height of the most-work tip being activated, or -1 if unknown.
+    std::atomic<int> m_activation_target_height{-1};
+    //! Blocks connected by the activation currently in progress.
+    std::atomic<int> m_activation_blocks_connected{0};
+
+    /** Hand a newly processed block to the -asyncactivation worker thread
+     *  (started on first use), which calls ActivateBestChain() with the block
+     *  as a hint. Used by ProcessNewBlock() when -asyncactivation is enabled
+     *  so that a long reorg does not stall the calling (message handler)
+     *  thread. */
+    void QueueBestChainActivation(const std::shared_ptr<const CBlock>& block) LOCKS_EXCLUDED(cs_main);
+
+    /** Stop and join the -asyncactivation worker thread, discarding any
+     *  queued activation hints. Must not be called with cs_main held. */
+    void StopActivationThread() LOCKS_EXCLUDED(cs_main);
+
     ~ChainstateManager();
 };
 
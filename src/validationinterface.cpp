@@ -12,11 +12,20 @@
 #include <primitives/block.h>
 #include <primitives/transaction.h>
 #include <scheduler.h>
+#include <util/time.h>
 
+#include <algorithm>
+#include <atomic>
 #include <future>
+#include <thread>
+#include <vector>
 #include <unordered_map>
 #include <utility>
 
+//! A subscriber callback running longer than this is counted (and logged) as
+//! slow: it delays every notification queued behind it.
+static constexpr int64_t SLOW_CALLBACK_THRESHOLD_MS{100};
+
 /**
  * MainSignalsImpl manages a list of shared_ptr<CValidationInterface> callbacks.
  *
@@ -33,10 +42,14 @@ private:
     //! count is equal to the number of current executions of that entry, plus 1
     //! if it's registered. It cannot be 0 because that would imply it is
     //! unregistered and also not being executed (so shouldn't exist).
-    struct ListEntry { std::shared_ptr<CValidationInterface> callbacks; int count = 1; };
+    struct ListEntry { std::shared_ptr<CValidationInterface> callbacks; int count = 1; ValidationInterfacePriority priority = ValidationInterfacePriority::NORMAL; bool parallel = false; };
     std::list<ListEntry> m_list GUARDED_BY(m_mutex);
     std::unordered_map<CValidationInterface*, std::list<ListEntry>::iterator> m_map GUARDED_BY(m_mutex);
 
+    std::atomic<size_t> m_depth_high_water{0};
+    std::atomic<uint64_t> m_enqueued{0};
+    std::atomic<uint64_t> m_slow_callbacks{0};
+
 public:
     // We are not allowed to assume the scheduler only runs in one thread,
     // but must ensure all callbacks happen in-order, so we end up creating
@@ -45,11 +58,22 @@ public:
 
     explicit MainSignalsImpl(CScheduler& scheduler LIFETIMEBOUND) : m_schedulerClient(scheduler) {}
 
-    void Register(std::shared_ptr<CValidationInterface> callbacks) EXCLUSIVE_LOCKS_REQUIRED(!m_mutex)
+    void Register(std::shared_ptr<CValidationInterface> callbacks, ValidationInterfacePriority priority) EXCLUSIVE_LOCKS_REQUIRED(!m_mutex)
     {
         LOCK(m_mutex);
         auto inserted = m_map.emplace(callbacks.get(), m_list.end());
-        if (inserted.second) inserted.first->second = m_list.emplace(m_list.end());
+        if (inserted.second) {
+            // Keep the list sorted by priority: HIGH subscribers go in front
+            // of the first NORMAL entry, so Iterate() notifies them first.
+            auto pos{priority == ValidationInterfacePriority::HIGH
+                         ? std::find_if(m_list.begin(), m_list.end(), [](const ListEntry& entry) { return entry.priority == ValidationInterfacePriority::NORMAL; })
+                         : m_list.end()};
+            inserted.first->second = m_list.emplace(pos);
+            inserted.first->second->priority = priority;
+            // Cache the capability so the dispatch loops don't pay a virtual
+            // call per subscriber per event.
+            inserted.first->second->parallel = callbacks->SupportsParallelDispatch();
+        }
         inserted.first->second->callbacks = std::move(callbacks);
     }
 
@@ -83,11 +107,112 @@ public:
             ++it->count;
             {
                 REVERSE_LOCK(lock);
+                const int64_t started_ms{GetTimeMillis()};
                 f(*it->callbacks);
+                const int64_t elapsed_ms{GetTimeMillis() - started_ms};
+                if (elapsed_ms > SLOW_CALLBACK_THRESHOLD_MS) {
+                    m_slow_callbacks.fetch_add(1, std::memory_order_relaxed);
+                    LogPrint(BCLog::VALIDATION, "Slow validation interface callback (%dms); queued notifications were delayed behind it\n", elapsed_ms);
+                }
             }
             it = --it->count ? std::next(it) : m_list.erase(it);
         }
     }
+
+    //! As Iterate(), but subscribers that support parallel dispatch (e.g.
+    //! wallets, which are independent lock domains) are notified concurrently
+    //! on a bounded set of worker threads while the remaining subscribers are
+    //! notified in registration order on this thread. This bounds multiwallet
+    //! block handling at the slowest single wallet instead of the sum over
+    //! all wallets. Within one event there is no ordering between parallel
+    //! subscribers and the rest; across events per-subscriber ordering is
+    //! unchanged because the workers are joined before returning. Only used
+    //! for block connect/disconnect events, where per-subscriber work is
+    //! large enough to amortize the thread fan-out.
+    template<typename F> void IterateParallel(F&& f) EXCLUSIVE_LOCKS_REQUIRED(!m_mutex)
+    {
+        std::vector<std::list<ListEntry>::iterator> parallel;
+        {
+            LOCK(m_mutex);
+            for (auto it = m_list.begin(); it != m_list.end(); ++it) {
+                if (it->parallel) {
+                    ++it->count;
+                    parallel.push_back(it);
+                }
+            }
+        }
+
+        std::atomic<size_t> next_index{0};
+        std::vector<std::thread> workers;
+        if (parallel.size() > 1) {
+            const size_t n_workers{std::min(parallel.size(),
+                static_cast<size_t>(std::max(1u, std::thread::hardware_concurrency())))};
+            workers.reserve(n_workers);
+            for (size_t w = 0; w < n_workers; ++w) {
+                workers.emplace_back([&] {
+                    for (size_t i = next_index.fetch_add(1); i < parallel.size(); i = next_index.fetch_add(1)) {
+                        f(*parallel[i]->callbacks);
+                    }
+                });
+            }
+        }
+
+        // Serial subscribers run on this thread while the workers are in
+        // flight, preserving their registration (and priority) order.
+        {
+            WAIT_LOCK(m_mutex, lock);
+            for (auto it = m_list.begin(); it != m_list.end();) {
+                if (it->parallel) {
+                    ++it;
+                    continue;
+                }
+                ++it->count;
+                {
+                    REVERSE_LOCK(lock);
+                    const int64_t started_ms{GetTimeMillis()};
+                    f(*it->callbacks);
+                    const int64_t elapsed_ms{GetTimeMillis() - started_ms};
+                    if (elapsed_ms > SLOW_CALLBACK_THRESHOLD_MS) {
+                        m_slow_callbacks.fetch_add(1, std::memory_order_relaxed);
+                        LogPrint(BCLog::VALIDATION, "Slow validation interface callback (%dms); queued notifications were delayed behind it\n", elapsed_ms);
+                    }
+                }
+                it = --it->count ? std::next(it) : m_list.erase(it);
+            }
+        }
+
+        if (parallel.size() == 1) {
+            // A lone parallel subscriber isn't worth a thread.
+            f(*parallel.front()->callbacks);
+        }
+        for (std::thread& worker : workers) worker.join();
+        if (!parallel.empty()) {
+            LOCK(m_mutex);
+            for (const auto& it : parallel) {
+                if (!--it->count) m_list.erase(it);
+            }
+        }
+    }
+
+    //! Account for a newly enqueued event; called right after it is queued.
+    void RecordEnqueue()
+    {
+        m_enqueued.fetch_add(1, std::memory_order_relaxed);
+        const size_t depth{m_schedulerClient.CallbacksPending()};
+        size_t high_water{m_depth_high_water.load(std::memory_order_relaxed)};
+        while (depth > high_water && !m_depth_high_water.compare_exchange_weak(high_water, depth)) {}
+    }
+
+    void GetStats(CMainSignals::QueueStats& stats) EXCLUSIVE_LOCKS_REQUIRED(!m_mutex)
+    {
+        stats.depth = m_schedulerClient.CallbacksPending();
+        stats.depth_high_water = m_depth_high_water.load(std::memory_order_relaxed);
+        stats.enqueued = m_enqueued.load(std::memory_order_relaxed);
+        stats.slow_callbacks = m_slow_callbacks.load(std::memory_order_relaxed);
+        LOCK(m_mutex);
+        stats.subscribers = m_map.size();
+        stats.subscribers_high = std::count_if(m_list.begin(), m_list.end(), [](const ListEntry& entry) { return entry.priority == ValidationInterfacePriority::HIGH; });
+    }
 };
 
 static CMainSignals g_signals;
@@ -116,23 +241,30 @@ size_t CMainSignals::CallbacksPending()
     return m_internals->m_schedulerClient.CallbacksPending();
 }
 
+CMainSignals::QueueStats CMainSignals::GetQueueStats()
+{
+    QueueStats stats;
+    if (m_internals) m_internals->GetStats(stats);
+    return stats;
+}
+
 CMainSignals& GetMainSignals()
 {
     return g_signals;
 }
 
-void RegisterSharedValidationInterface(std::shared_ptr<CValidationInterface> callbacks)
+void RegisterSharedValidationInterface(std::shared_ptr<CValidationInterface> callbacks, ValidationInterfacePriority priority)
 {
     // Each connection captures the shared_ptr to ensure that each callback is
     // executed before the subscriber is destroyed. For more details see #18338.
-    g_signals.m_internals->Register(std::move(callbacks));
+    g_signals.m_internals->Register(std::move(callbacks), priority);
 }
 
-void RegisterValidationInterface(CValidationInterface* callbacks)
+void RegisterValidationInterface(CValidationInterface* callbacks, ValidationInterfacePriority priority)
 {
     // Create a shared_ptr with a no-op deleter - CValidationInterface lifecycle
     // is managed by the caller.
-    RegisterSharedValidationInterface({callbacks, [](CValidationInterface*){}});
+    RegisterSharedValidationInterface({callbacks, [](CValidationInterface*){}}, priority);
 }
 
 void UnregisterSharedValidationInterface(std::shared_ptr<CValidationInterface> callbacks)
@@ -183,6 +315,7 @@ void SyncWithValidationInterfaceQueue()
             LOG_EVENT(fmt, local_name, __VA_ARGS__);           \
             event();                                           \
         });                                                    \
+        m_internals->RecordEnqueue();                          \
     } while (0)
 
 #define LOG_EVENT(fmt, ...) \
@@ -222,17 +355,36 @@ void CMainSignals::TransactionRemovedFromMempool(const CTransactionRef& tx, MemP
 
 void CMainSignals::BlockConnected(const std::shared_ptr<const CBlock> &pblock, const CBlockIndex *pindex) {
     auto event = [pblock, pindex, this] {
-        m_internals->Iterate([&](CValidationInterface& callbacks) { callbacks.BlockConnected(pblock, pindex); });
+        m_internals->IterateParallel([&](CValidationInterface& callbacks) { callbacks.BlockConnected(pblock, pindex); });
     };
     ENQUEUE_AND_LOG_EVENT(event, "%s: block hash=%s block height=%d", __func__,
                           pblock->GetHash().ToString(),
                           pindex->nHeight);
 }
 
+void CMainSignals::BlocksConnected(std::vector<ConnectedBlock> blocks) {
+    assert(!blocks.empty());
+    if (blocks.size() == 1) {
+        // A single block takes the long-standing per-block path.
+        BlockConnected(blocks.front().block, blocks.front().pindex);
+        return;
+    }
+    const uint256 tip_hash{blocks.back().pindex->GetBlockHash()};
+    const int tip_height{blocks.back().pindex->nHeight};
+    const size_t count{blocks.size()};
+    auto event = [blocks = std::move(blocks), this] {
+        m_internals->IterateParallel([&](CValidationInterface& callbacks) { callbacks.BlocksConnected(blocks); });
+    };
+    ENQUEUE_AND_LOG_EVENT(event, "%s: %d blocks, tip hash=%s tip height=%d", __func__,
+                          count,
+                          tip_hash.ToString(),
+                          tip_height);
+}
+
 void CMainSignals::BlockDisconnected(const std::shared_ptr<const CBlock>& pblock, const CBlockIndex* pindex)
 {
     auto event = [pblock, pindex, this] {
-        m_internals->Iterate([&](CValidationInterface& callbacks) { callbacks.BlockDisconnected(pblock, pindex); });
+        m_internals->IterateParallel([&](CValidationInterface& callbacks) { callbacks.BlockDisconnected(pblock, pindex); });
     };
     ENQUEUE_AND_LOG_EVENT(event, "%s: block hash=%s block height=%d", __func__,
                           pblock->GetHash().ToString(),
@@ -11,6 +11,7 @@
 
 #include <functional>
 #include <memory>
+#include <vector>
 
 extern RecursiveMutex cs_main;
 class BlockValidationState;
@@ -21,8 +22,23 @@ class CValidationInterface;
 class CScheduler;
 enum class MemPoolRemovalReason;
 
+/** One entry of a BlocksConnected batch, in connection order. */
+struct ConnectedBlock {
+    std::shared_ptr<const CBlock> block;
+    const CBlockIndex* pindex;
+};
+
+/** Delivery priority of a validation interface subscriber. For each queued
+ * event, HIGH subscribers are notified before NORMAL ones, so latency-critical
+ * consumers (e.g. external notification publishers) are not delayed behind
+ * slower bookkeeping handlers of the same event. */
+enum class ValidationInterfacePriority {
+    HIGH,
+    NORMAL,
+};
+
 /** Register subscriber */
-void RegisterValidationInterface(CValidationInterface* callbacks);
+void RegisterValidationInterface(CValidationInterface* callbacks, ValidationInterfacePriority priority = ValidationInterfacePriority::NORMAL);
 /** Unregister subscriber. DEPRECATED. This is not safe to use when the RPC server or main message handler thread is running. */
 void UnregisterValidationInterface(CValidationInterface* callbacks);
 /** Unregister all subscribers */
@@ -33,7 +49,7 @@ void UnregisterAllValidationInterfaces();
 // unregistration is nonblocking and can return before the last notification is
 // processed.
 /** Register subscriber */
-void RegisterSharedValidationInterface(std::shared_ptr<CValidationInterface> callbacks);
+void RegisterSharedValidationInterface(std::shared_ptr<CValidationInterface> callbacks, ValidationInterfacePriority priority = ValidationInterfacePriority::NORMAL);
 /** Unregister subscriber */
 void UnregisterSharedValidationInterface(std::shared_ptr<CValidationInterface> callbacks);
 
@@ -137,6 +153,25 @@ protected:
      * Called on a background thread.
      */
     virtual void BlockConnected(const std::shared_ptr<const CBlock> &block, const CBlockIndex *pindex) {}
+    /**
+     * Notifies listeners of a range of consecutively connected blocks, in
+     * connection order. Fired in place of individual BlockConnected
+     * notifications when validation connects several blocks in a single
+     * activation step (typically during initial block download), so the whole
+     * step takes one hop through the notification queue. The default
+     * implementation forwards each block to BlockConnected and subscribers
+     * observe the same per-block sequence either way; subscribers with
+     * per-notification overhead (e.g. indexes updating their best-block
+     * position) can override this to process the range at once.
+     *
+     * Called on a background thread.
+     */
+    virtual void BlocksConnected(const std::vector<ConnectedBlock>& blocks)
+    {
+        for (const ConnectedBlock& connected : blocks) {
+            BlockConnected(connected.block, connected.pindex);
+        }
+    }
     /**
      * Notifies listeners of a block being disconnected
      *
@@ -171,6 +206,20 @@ protected:
      * Notifies listeners that a block which builds directly on our current tip
      * has been received and connected to the headers tree, though not validated yet */
     virtual void NewPoWValidBlock(const CBlockIndex *pindex, const std::shared_ptr<const CBlock>& block) {};
+
+public:
+    /**
+     * Whether this subscriber may be notified of block connect/disconnect
+     * events concurrently with other subscribers that also return true.
+     * Per-subscriber event ordering is unaffected since the dispatcher joins
+     * all workers before moving to the next event. Return true only if the
+     * subscriber shares no state with any other parallel-capable subscriber
+     * (e.g. wallets, which are independent lock domains); there is then no
+     * ordering between it and the other subscribers within a single event.
+     */
+    virtual bool SupportsParallelDispatch() const { return false; }
+
+protected:
     friend class CMainSignals;
     friend class ValidationInterfaceTest;
 };
@@ -180,7 +229,7 @@ class CMainSignals {
 private:
     std::unique_ptr<MainSignalsImpl> m_internals;
 
-    friend void ::RegisterSharedValidationInterface(std::shared_ptr<CValidationInterface>);
+    friend void ::RegisterSharedValidationInterface(std::shared_ptr<CValidationInterface>, ValidationInterfacePriority);
     friend void ::UnregisterValidationInterface(CValidationInterface*);
     friend void ::UnregisterAllValidationInterfaces();
     friend void ::CallFunctionInValidationInterfaceQueue(std::function<void ()> func);
@@ -195,11 +244,23 @@ public:
 
     size_t CallbacksPending();
 
+    //! Backpressure metrics for the notification queue, exposed via the
+    //! getvalidationqueueinfo RPC.
+    struct QueueStats {
+        size_t depth{0};            //!< Events currently queued
+        size_t depth_high_water{0}; //!< Maximum queue depth observed since startup
+        uint64_t enqueued{0};       //!< Total events enqueued since startup
+        uint64_t slow_callbacks{0}; //!< Subscriber callbacks that ran longer than the slow threshold
+        size_t subscribers{0};      //!< Registered subscribers
+        size_t subscribers_high{0}; //!< Registered HIGH priority subscribers
+    };
+    QueueStats GetQueueStats();
 
     void UpdatedBlockTip(const CBlockIndex *, const CBlockIndex *, bool fInitialDownload);
     void TransactionAddedToMempool(const CTransactionRef&, uint64_t mempool_sequence);
     void TransactionRemovedFromMempool(const CTransactionRef&, MemPoolRemovalReason, uint64_t mempool_sequence);
     void BlockConnected(const std::shared_ptr<const CBlock> &, const CBlockIndex *pindex);
+    void BlocksConnected(std::vector<ConnectedBlock> blocks);
     void BlockDisconnected(const std::shared_ptr<const CBlock> &, const CBlockIndex* pindex);
     void ChainStateFlushed(const CBlockLocator &);
     void BlockChecked(const CBlock&, const BlockValidationState&);
@@ -80,8 +80,11 @@ std::optional<SelectionResult> SelectCoinsBnB(std::vector<OutputGroup>& utxo_poo
         return std::nullopt;
     }
 
-    // Sort the utxo_pool
-    std::sort(utxo_pool.begin(), utxo_pool.end(), descending);
+    // Sort the utxo_pool. GroupOutputs already hands us the groups in
+    // descending order, so in practice this is a single O(n) verification pass.
+    if (!std::is_sorted(utxo_pool.begin(), utxo_pool.end(), descending)) {
+        std::sort(utxo_pool.begin(), utxo_pool.end(), descending);
+    }
 
     CAmount curr_waste = 0;
     std::vector<size_t> best_selection;
@@ -296,6 +296,10 @@ Balance GetBalance(const CWallet& wallet, const int min_depth, bool avoid_reuse)
     isminefilter reuse_filter = avoid_reuse ? ISMINE_NO : ISMINE_USED;
     {
         LOCK(wallet.cs_wallet);
+        const auto cached{wallet.m_balance_cache.find({min_depth, avoid_reuse})};
+        if (cached != wallet.m_balance_cache.end()) {
+            return cached->second;
+        }
         std::set<uint256> trusted_parents;
         for (const auto& entry : wallet.mapWallet)
         {
@@ -315,6 +319,7 @@ Balance GetBalance(const CWallet& wallet, const int min_depth, bool avoid_reuse)
             ret.m_mine_immature += CachedTxGetImmatureCredit(wallet, wtx, ISMINE_SPENDABLE);
             ret.m_watchonly_immature += CachedTxGetImmatureCredit(wallet, wtx, ISMINE_WATCH_ONLY);
         }
+        wallet.m_balance_cache.emplace(std::make_pair(min_depth, avoid_reuse), ret);
     }
     return ret;
 }
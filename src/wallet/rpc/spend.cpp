@@ -6,6 +6,7 @@
 #include <core_io.h>
 #include <key_io.h>
 #include <policy/policy.h>
+#include <psbt.h>
 #include <rpc/rawtransaction_util.h>
 #include <rpc/util.h>
 #include <util/fees.h>
@@ -27,8 +28,10 @@ static void ParseRecipients(const UniValue& address_amounts, const UniValue& sub
 {
     std::set<CTxDestination> destinations;
     int i = 0;
-    for (const std::string& address: address_amounts.getKeys()) {
-        CTxDestination dest = DecodeDestination(address);
+    const std::vector<std::string>& addresses = address_amounts.getKeys();
+    const std::vector<CTxDestination> decoded = DecodeDestinations(addresses);
+    for (const std::string& address: addresses) {
+        const CTxDestination& dest = decoded[i];
         if (!IsValidDestination(dest)) {
             throw JSONRPCError(RPC_INVALID_ADDRESS_OR_KEY, std::string("Invalid Coral address: ") + address);
         }
@@ -1477,7 +1480,7 @@ RPCHelpMan walletprocesspsbt()
                 "that we can sign for." +
         HELP_REQUIRING_PASSPHRASE,
                 {
-                    {"psbt", RPCArg::Type::STR, RPCArg::Optional::NO, "The transaction base64 string"},
+                    {"psbt", RPCArg::Type::STR, RPCArg::Optional::NO, "The transaction base64 string, or a PSBT session id (see openpsbtsession)"},
                     {"sign", RPCArg::Type::BOOL, RPCArg::Default{true}, "Also sign the transaction when updating (requires wallet to be unlocked)"},
                     {"sighashtype", RPCArg::Type::STR, RPCArg::Default{"DEFAULT for Taproot, ALL otherwise"}, "The signature hash type to sign with if not specified by the PSBT. Must be one of\n"
             "       \"DEFAULT\"\n"
@@ -1493,7 +1496,8 @@ RPCHelpMan walletprocesspsbt()
                 RPCResult{
                     RPCResult::Type::OBJ, "", "",
                     {
-                        {RPCResult::Type::STR, "psbt", "The base64-encoded partially signed transaction"},
+                        {RPCResult::Type::STR, "psbt", /*optional=*/true, "The base64-encoded partially signed transaction (omitted when processing a session)"},
+                        {RPCResult::Type::STR_HEX, "session_id", /*optional=*/true, "The session id, when a session was processed; the updated PSBT stays in the node"},
                         {RPCResult::Type::BOOL, "complete", "If the transaction has a complete set of signatures"},
                     }
                 },
@@ -1515,7 +1519,8 @@ RPCHelpMan walletprocesspsbt()
     // Unserialize the transaction
     PartiallySignedTransaction psbtx;
     std::string error;
-    if (!DecodeBase64PSBT(psbtx, request.params[0].get_str(), error)) {
+    bool from_session{false};
+    if (!DecodePSBTOrSession(psbtx, request.params[0].get_str(), error, &from_session)) {
         throw JSONRPCError(RPC_DESERIALIZATION_ERROR, strprintf("TX decode failed %s", error));
     }
 
@@ -1536,9 +1541,14 @@ RPCHelpMan walletprocesspsbt()
     }
 
     UniValue result(UniValue::VOBJ);
-    CDataStream ssTx(SER_NETWORK, PROTOCOL_VERSION);
-    ssTx << psbtx;
-    result.pushKV("psbt", EncodeBase64(ssTx.str()));
+    if (from_session) {
+        UpdatePSBTSession(request.params[0].get_str(), psbtx);
+        result.pushKV("session_id", request.params[0].get_str());
+    } else {
+        CDataStream ssTx(SER_NETWORK, PROTOCOL_VERSION);
+        ssTx << psbtx;
+        result.pushKV("psbt", EncodeBase64(ssTx.str()));
+    }
     result.pushKV("complete", complete);
 
     return result;
@@ -2022,6 +2022,17 @@ isminetype DescriptorScriptPubKeyMan::IsMine(const CScript& script) const
     return ISMINE_NO;
 }
 
+bool DescriptorScriptPubKeyMan::IsMineAny(const std::vector<CScript>& scripts) const
+{
+    LOCK(cs_desc_man);
+    for (const CScript& script : scripts) {
+        if (m_map_script_pub_keys.count(script) > 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
 bool DescriptorScriptPubKeyMan::CheckDecryptionKey(const CKeyingMaterial& master_key, bool accept_no_keys)
 {
     LOCK(cs_desc_man);
@@ -2138,13 +2149,20 @@ bool DescriptorScriptPubKeyMan::TopUp(unsigned int size)
 
     WalletBatch batch(m_storage.GetDatabase());
     uint256 id = GetID();
+    // Parent xprvs derived while expanding one index are reused for the next,
+    // so hardened descriptors pay the full-path BIP32 derivation once per
+    // top-up instead of once per index.
+    DescriptorExtKeyCache xprv_cache;
+    // Newly cached items are accumulated here and written in one batch below
+    // instead of once per index.
+    DescriptorCache new_items;
     for (int32_t i = m_max_cached_index + 1; i < new_range_end; ++i) {
         FlatSigningProvider out_keys;
         std::vector<CScript> scripts_temp;
         DescriptorCache temp_cache;
         // Maybe we have a cached xpub and we can expand from the cache first
         if (!m_wallet_descriptor.descriptor->ExpandFromCache(i, m_wallet_descriptor.cache, scripts_temp, out_keys)) {
-            if (!m_wallet_descriptor.descriptor->Expand(i, provider, scripts_temp, out_keys, &temp_cache)) return false;
+            if (!m_wallet_descriptor.descriptor->Expand(i, provider, scripts_temp, out_keys, &temp_cache, &xprv_cache)) return false;
         }
         // Add all of the scriptPubKeys to the scriptPubKey set
         for (const CScript& script : scripts_temp) {
@@ -2159,15 +2177,21 @@ bool DescriptorScriptPubKeyMan::TopUp(unsigned int size)
             }
             m_map_pubkeys[pubkey] = i;
         }
-        // Merge and write the cache
-        DescriptorCache new_items = m_wallet_descriptor.cache.MergeAndDiff(temp_cache);
-        if (!batch.WriteDescriptorCacheItems(id, new_items)) {
-            throw std::runtime_error(std::string(__func__) + ": writing cache items failed");
-        }
+        // Merge the cache, collecting the new items for the batched write
+        new_items.MergeAndDiff(m_wallet_descriptor.cache.MergeAndDiff(temp_cache));
         m_max_cached_index++;
     }
     m_wallet_descriptor.range_end = new_range_end;
+    // Commit the cache items and the descriptor in one database transaction,
+    // as in CWallet::blockConnected; a 10k top-up is otherwise dominated by
+    // per-index synchronous writes.
+    const bool batched{batch.TxnBegin()};
+    if (!batch.WriteDescriptorCacheItems(id, new_items)) {
+        if (batched) batch.TxnAbort();
+        throw std::runtime_error(std::string(__func__) + ": writing cache items failed");
+    }
     batch.WriteDescriptor(GetID(), m_wallet_descriptor);
+    if (batched) batch.TxnCommit();
 
     // By this point, the cache size should be the size of the entire range
     assert(m_wallet_descriptor.range_end - 1 == m_max_cached_index);
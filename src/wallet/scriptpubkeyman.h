@@ -10,6 +10,7 @@
 #include <script/signingprovider.h>
 #include <script/standard.h>
 #include <util/error.h>
+#include <util/hasher.h>
 #include <util/message.h>
 #include <util/result.h>
 #include <util/time.h>
@@ -175,6 +176,16 @@ public:
     virtual util::Result<CTxDestination> GetNewDestination(const OutputType type) { return util::Error{Untranslated("Not supported")}; }
     virtual isminetype IsMine(const CScript& script) const { return ISMINE_NO; }
 
+    //! Check whether any of the given scripts belongs to this ScriptPubKeyMan.
+    //! Overrides can answer the whole batch under a single lock acquisition.
+    virtual bool IsMineAny(const std::vector<CScript>& scripts) const
+    {
+        for (const CScript& script : scripts) {
+            if (IsMine(script) != ISMINE_NO) return true;
+        }
+        return false;
+    }
+
     //! Check that the given decryption key is valid for this ScriptPubKeyMan, i.e. it decrypts all of the keys handled by it.
     virtual bool CheckDecryptionKey(const CKeyingMaterial& master_key, bool accept_no_keys = false) { return false; }
     virtual bool Encrypt(const CKeyingMaterial& master_key, WalletBatch* batch) { return false; }
@@ -540,7 +551,9 @@ public:
 class DescriptorScriptPubKeyMan : public ScriptPubKeyMan
 {
 private:
-    using ScriptPubKeyMap = std::map<CScript, int32_t>; // Map of scripts to descriptor range index
+    // Map of scripts to descriptor range index. Salted hashing keeps IsMine
+    // lookups O(1) per script, which a block scan performs for every output.
+    using ScriptPubKeyMap = std::unordered_map<CScript, int32_t, SaltedSipHasher>;
     using PubKeyMap = std::map<CPubKey, int32_t>; // Map of pubkeys involved in scripts to descriptor range index
     using CryptedKeyMap = std::map<CKeyID, std::pair<CPubKey, std::vector<unsigned char>>>;
     using KeyMap = std::map<CKeyID, CKey>;
@@ -584,6 +597,7 @@ public:
 
     util::Result<CTxDestination> GetNewDestination(const OutputType type) override;
     isminetype IsMine(const CScript& script) const override;
+    bool IsMineAny(const std::vector<CScript>& scripts) const override;
 
     bool CheckDecryptionKey(const CKeyingMaterial& master_key, bool accept_no_keys = false) override;
     bool Encrypt(const CKeyingMaterial& master_key, WalletBatch* batch) override;
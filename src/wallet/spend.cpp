@@ -406,6 +406,13 @@ std::vector<OutputGroup> GroupOutputs(const CWallet& wallet, const std::vector<C
             if (positive_only && group.GetSelectionAmount() <= 0) continue;
             if (group.m_outputs.size() > 0 && group.EligibleForSpending(filter)) groups_out.push_back(group);
         }
+
+        // Return the groups presorted in descending order by selection amount.
+        // AttemptSelection regroups for every eligibility filter, so the sort
+        // happens here rather than once per selection algorithm: SelectCoinsBnB
+        // can then skip its own O(n log n) sort on large wallets.
+        std::sort(groups_out.begin(), groups_out.end(),
+                  [](const OutputGroup& a, const OutputGroup& b) { return a.GetSelectionAmount() > b.GetSelectionAmount(); });
         return groups_out;
     }
 
@@ -466,6 +473,9 @@ std::vector<OutputGroup> GroupOutputs(const CWallet& wallet, const std::vector<C
         }
     }
 
+    // Presort as in the no-grouping path above.
+    std::sort(groups_out.begin(), groups_out.end(),
+              [](const OutputGroup& a, const OutputGroup& b) { return a.GetSelectionAmount() > b.GetSelectionAmount(); });
     return groups_out;
 }
 
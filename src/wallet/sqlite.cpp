@@ -84,7 +84,7 @@ static void SetPragma(sqlite3* db, const std::string& key, const std::string& va
 }
 
 SQLiteDatabase::SQLiteDatabase(const fs::path& dir_path, const fs::path& file_path, const DatabaseOptions& options, bool mock)
-    : WalletDatabase(), m_mock(mock), m_dir_path(fs::PathToString(dir_path)), m_file_path(fs::PathToString(file_path)), m_use_unsafe_sync(options.use_unsafe_sync)
+    : WalletDatabase(), m_mock(mock), m_dir_path(fs::PathToString(dir_path)), m_file_path(fs::PathToString(file_path)), m_use_unsafe_sync(options.use_unsafe_sync), m_use_wal(options.use_wal)
 {
     {
         LOCK(g_sqlite_mutex);
@@ -261,6 +261,15 @@ void SQLiteDatabase::Open()
         SetPragma(m_db, "synchronous", "OFF", "Failed to set synchronous mode to OFF");
     }
 
+    if (m_use_wal && !m_mock) {
+        // Write-ahead logging appends committed transactions to a -wal file
+        // next to the database instead of rewriting pages in place, which
+        // makes commits sequential writes. With the exclusive locking mode
+        // taken above SQLite keeps the WAL index in heap memory, so no
+        // shared-memory file is needed.
+        SetPragma(m_db, "journal_mode", "wal", "Failed to enable WAL journal mode");
+    }
+
     // Make the table for our key-value pairs
     // First check that the main table exists
     sqlite3_stmt* check_main_stmt{nullptr};
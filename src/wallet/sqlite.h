@@ -114,6 +114,7 @@ public:
 
     sqlite3* m_db{nullptr};
     bool m_use_unsafe_sync;
+    bool m_use_wal;
 };
 
 std::unique_ptr<SQLiteDatabase> MakeSQLiteDatabase(const fs::path& path, const DatabaseOptions& options, DatabaseStatus& status, bilingual_str& error);
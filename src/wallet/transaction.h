@@ -301,9 +301,12 @@ public:
 
     // Disable copying of CWalletTx objects to prevent bugs where instances get
     // copied in and out of the mapWallet map, and fields are updated in the
-    // wrong copy.
+    // wrong copy. Moves stay available so records decoded outside the map
+    // (e.g. during wallet load) can be transferred into it.
     CWalletTx(CWalletTx const &) = delete;
     void operator=(CWalletTx const &x) = delete;
+    CWalletTx(CWalletTx&&) = default;
+    CWalletTx& operator=(CWalletTx&&) = default;
 };
 
 struct WalletTxOrderComparator {
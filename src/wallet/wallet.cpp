@@ -9,6 +9,7 @@
 #include <consensus/amount.h>
 #include <consensus/consensus.h>
 #include <consensus/validation.h>
+#include <diskio.h>
 #include <external_signer.h>
 #include <fs.h>
 #include <interfaces/chain.h>
@@ -33,6 +34,7 @@
 #include <util/moneystr.h>
 #include <util/rbf.h>
 #include <util/string.h>
+#include <util/thread.h>
 #include <util/translation.h>
 #include <wallet/coincontrol.h>
 #include <wallet/context.h>
@@ -43,7 +45,10 @@
 
 #include <algorithm>
 #include <assert.h>
+#include <condition_variable>
+#include <map>
 #include <optional>
+#include <thread>
 
 using interfaces::FoundBlock;
 
@@ -870,6 +875,7 @@ void CWallet::MarkDirty()
         LOCK(cs_wallet);
         for (std::pair<const uint256, CWalletTx>& item : mapWallet)
             item.second.MarkDirty();
+        MarkBalancesDirty();
     }
 }
 
@@ -959,6 +965,8 @@ CWalletTx* CWallet::AddToWallet(CTransactionRef tx, const TxState& state, const
 {
     LOCK(cs_wallet);
 
+    MarkBalancesDirty();
+
     WalletBatch batch(GetDatabase(), fFlushOnClose);
 
     uint256 hash = tx->GetHash();
@@ -1184,6 +1192,8 @@ bool CWallet::AbandonTransaction(const uint256& hashTx)
 {
     LOCK(cs_wallet);
 
+    MarkBalancesDirty();
+
     WalletBatch batch(GetDatabase());
 
     std::set<uint256> todo;
@@ -1239,6 +1249,8 @@ void CWallet::MarkConflicted(const uint256& hashBlock, int conflicting_height, c
 {
     LOCK(cs_wallet);
 
+    MarkBalancesDirty();
+
     int conflictconfirms = (m_last_block_processed_height - conflicting_height + 1) * -1;
     // If number of conflict confirms cannot be determined, this means
     // that the block is still unknown or not yet part of the main chain,
@@ -1298,6 +1310,7 @@ void CWallet::SyncTransaction(const CTransactionRef& ptx, const SyncTxState& sta
 
 void CWallet::transactionAddedToMempool(const CTransactionRef& tx, uint64_t mempool_sequence) {
     LOCK(cs_wallet);
+    MarkBalancesDirty();
     SyncTransaction(tx, TxStateInMempool{});
 
     auto it = mapWallet.find(tx->GetHash());
@@ -1308,6 +1321,7 @@ void CWallet::transactionAddedToMempool(const CTransactionRef& tx, uint64_t memp
 
 void CWallet::transactionRemovedFromMempool(const CTransactionRef& tx, MemPoolRemovalReason reason, uint64_t mempool_sequence) {
     LOCK(cs_wallet);
+    MarkBalancesDirty();
     auto it = mapWallet.find(tx->GetHash());
     if (it != mapWallet.end()) {
         RefreshMempoolStatus(it->second, chain());
@@ -1350,10 +1364,28 @@ void CWallet::blockConnected(const interfaces::BlockInfo& block)
 
     m_last_block_processed_height = block.height;
     m_last_block_processed = block.hash;
-    for (size_t index = 0; index < block.data->vtx.size(); index++) {
-        SyncTransaction(block.data->vtx[index], TxStateConfirmed{block.hash, block.height, static_cast<int>(index)});
-        transactionRemovedFromMempool(block.data->vtx[index], MemPoolRemovalReason::BLOCK, 0 /* mempool_sequence */);
+
+    // Transaction depths (and with them trust and maturity) change with
+    // every block, so cached balances cannot survive a tip update.
+    MarkBalancesDirty();
+
+    // Group all wallet writes caused by this block into one database
+    // transaction, so a busy block costs a single sync to disk instead of
+    // one per written record. Wallet batches share the underlying database
+    // connection, so writes made through other batches while the
+    // transaction is open join it and commit with it.
+    WalletBatch batch(GetDatabase());
+    const bool batched{batch.TxnBegin()};
+    try {
+        for (size_t index = 0; index < block.data->vtx.size(); index++) {
+            SyncTransaction(block.data->vtx[index], TxStateConfirmed{block.hash, block.height, static_cast<int>(index)});
+            transactionRemovedFromMempool(block.data->vtx[index], MemPoolRemovalReason::BLOCK, 0 /* mempool_sequence */);
+        }
+    } catch (...) {
+        if (batched) batch.TxnAbort();
+        throw;
     }
+    if (batched) batch.TxnCommit();
 }
 
 void CWallet::blockDisconnected(const interfaces::BlockInfo& block)
@@ -1367,9 +1399,20 @@ void CWallet::blockDisconnected(const interfaces::BlockInfo& block)
     // future with a stickier abandoned state or even removing abandontransaction call.
     m_last_block_processed_height = block.height - 1;
     m_last_block_processed = *Assert(block.prev_hash);
-    for (const CTransactionRef& ptx : Assert(block.data)->vtx) {
-        SyncTransaction(ptx, TxStateInactive{});
+    MarkBalancesDirty();
+
+    // As in blockConnected, commit all wallet writes for this block at once.
+    WalletBatch batch(GetDatabase());
+    const bool batched{batch.TxnBegin()};
+    try {
+        for (const CTransactionRef& ptx : Assert(block.data)->vtx) {
+            SyncTransaction(ptx, TxStateInactive{});
+        }
+    } catch (...) {
+        if (batched) batch.TxnAbort();
+        throw;
     }
+    if (batched) batch.TxnCommit();
 }
 
 void CWallet::updatedBlockTip()
@@ -1430,9 +1473,16 @@ isminetype CWallet::IsMine(const CScript& script) const
 bool CWallet::IsMine(const CTransaction& tx) const
 {
     AssertLockHeld(cs_wallet);
-    for (const CTxOut& txout : tx.vout)
-        if (IsMine(txout))
-            return true;
+    // Batch the whole transaction's outputs per ScriptPubKeyMan, so each
+    // manager's internal lock is taken once instead of once per output.
+    std::vector<CScript> scripts;
+    scripts.reserve(tx.vout.size());
+    for (const CTxOut& txout : tx.vout) {
+        scripts.push_back(txout.scriptPubKey);
+    }
+    for (const auto& spk_man_pair : m_spk_managers) {
+        if (spk_man_pair.second->IsMineAny(scripts)) return true;
+    }
     return false;
 }
 
@@ -1722,6 +1772,111 @@ int64_t CWallet::RescanFromTime(int64_t startTime, const WalletRescanReserver& r
     return startTime;
 }
 
+namespace {
+//! Number of blocks the rescan readers keep decoded ahead of the scan position.
+constexpr int RESCAN_LOOKAHEAD_BLOCKS{32};
+
+/**
+ * Reads blocks ahead of the rescan loop on background threads, so that wallet
+ * matching overlaps disk reads instead of alternating with them. Matching
+ * itself must stay serial and in block order: whether a transaction is ours
+ * can depend on keys derived while processing earlier transactions (ranged
+ * descriptor top-ups), so only the read+decode is fanned out.
+ *
+ * Blocks are resolved by height against the chain tip recorded at
+ * construction; the consumer verifies the returned hash and falls back to a
+ * synchronous read whenever a reorg or tip change invalidates a prefetched
+ * block.
+ */
+class RescanReadPool
+{
+private:
+    struct Entry {
+        uint256 hash;
+        CBlock block;
+    };
+
+    interfaces::Chain& m_chain;
+    const uint256 m_tip_hash;
+    const int m_max_height;
+
+    Mutex m_mutex;
+    std::condition_variable m_cv_work;
+    std::condition_variable m_cv_entry;
+    int m_next_height GUARDED_BY(m_mutex);
+    int m_consumed_height GUARDED_BY(m_mutex);
+    std::map<int, Entry> m_blocks GUARDED_BY(m_mutex);
+    bool m_stop GUARDED_BY(m_mutex){false};
+    std::vector<std::thread> m_threads;
+
+    void ThreadRead()
+    {
+        for (;;) {
+            int height;
+            {
+                WAIT_LOCK(m_mutex, lock);
+                m_cv_work.wait(lock, [&]() EXCLUSIVE_LOCKS_REQUIRED(m_mutex) {
+                    return m_stop || m_next_height > m_max_height || m_next_height < m_consumed_height + RESCAN_LOOKAHEAD_BLOCKS;
+                });
+                if (m_stop || m_next_height > m_max_height) return;
+                height = m_next_height++;
+            }
+            Entry entry;
+            if (m_chain.findAncestorByHeight(m_tip_hash, height, interfaces::FoundBlock().hash(entry.hash))) {
+                m_chain.findBlock(entry.hash, interfaces::FoundBlock().data(entry.block));
+            }
+            {
+                LOCK(m_mutex);
+                if (m_stop) return;
+                m_blocks.emplace(height, std::move(entry));
+            }
+            m_cv_entry.notify_all();
+        }
+    }
+
+public:
+    RescanReadPool(interfaces::Chain& chain, const uint256& tip_hash, int start_height, int max_height, int num_threads)
+        : m_chain{chain}, m_tip_hash{tip_hash}, m_max_height{max_height}, m_next_height{start_height}, m_consumed_height{start_height}
+    {
+        m_threads.reserve(num_threads);
+        for (int n = 0; n < num_threads; ++n) {
+            m_threads.emplace_back(&util::TraceThread, strprintf("rescanread.%i", n), [this] { ThreadRead(); });
+        }
+    }
+
+    ~RescanReadPool()
+    {
+        WITH_LOCK(m_mutex, m_stop = true);
+        m_cv_work.notify_all();
+        m_cv_entry.notify_all();
+        for (std::thread& thread : m_threads) thread.join();
+    }
+
+    //! Return the prefetched block at the given height, or nullopt if it was
+    //! not prefetched or no longer matches the hash the caller expects.
+    std::optional<CBlock> Take(int height, const uint256& expect_hash)
+    {
+        if (height > m_max_height) return std::nullopt;
+        Entry entry;
+        {
+            WAIT_LOCK(m_mutex, lock);
+            m_consumed_height = height;
+            m_cv_work.notify_all();
+            m_cv_entry.wait(lock, [&]() EXCLUSIVE_LOCKS_REQUIRED(m_mutex) {
+                return m_stop || m_blocks.count(height) > 0;
+            });
+            auto it = m_blocks.find(height);
+            if (it == m_blocks.end()) return std::nullopt;
+            entry = std::move(it->second);
+            // Drop the entry along with any stale ones below it.
+            m_blocks.erase(m_blocks.begin(), ++it);
+        }
+        if (entry.hash != expect_hash || entry.block.IsNull()) return std::nullopt;
+        return entry.block;
+    }
+};
+} // namespace
+
 /**
  * Scan the block chain (starting in start_block) for transactions
  * from or to us. If fUpdate is true, found transactions that already
@@ -1766,6 +1921,10 @@ CWallet::ScanResult CWallet::ScanForWalletTransactions(const uint256& start_bloc
     double progress_end = chain().guessVerificationProgress(end_hash);
     double progress_current = progress_begin;
     int block_height = start_height;
+    int tip_height{start_height};
+    chain().findBlock(tip_hash, FoundBlock().height(tip_height));
+    RescanReadPool read_pool{chain(), tip_hash, start_height, max_height ? std::min(*max_height, tip_height) : tip_height,
+                             std::clamp<int>(std::thread::hardware_concurrency() - 1, 1, 4)};
     while (!fAbortRescan && !chain().shutdownRequested()) {
         if (progress_end - progress_begin > 0.0) {
             m_scanning_progress = (progress_current - progress_begin) / (progress_end - progress_begin);
@@ -1782,9 +1941,18 @@ CWallet::ScanResult CWallet::ScanForWalletTransactions(const uint256& start_bloc
             WalletLogPrintf("Still rescanning. At block %d. Progress=%f\n", block_height, progress_current);
         }
 
-        // Read block data
+        // Yield the disk to validation-critical writes, so a rescan does not
+        // compete with block connection for I/O (see diskio.h).
+        diskio::Throttle(diskio::Priority::RESCAN);
+
+        // Read block data, preferring a block already fetched by the
+        // lookahead readers over a synchronous disk read.
         CBlock block;
-        chain().findBlock(block_hash, FoundBlock().data(block));
+        if (auto prefetched{read_pool.Take(block_height, block_hash)}) {
+            block = std::move(*prefetched);
+        } else {
+            chain().findBlock(block_hash, FoundBlock().data(block));
+        }
 
         // Find next block separately from reading data above, because reading
         // is slow and there might be a reorg while it is read.
@@ -2224,11 +2392,22 @@ void CWallet::CommitTransaction(CTransactionRef tx, mapValue_t mapValue, std::ve
         return;
     }
 
-    std::string err_string;
-    if (!SubmitTxMemoryPoolAndRelay(*wtx, err_string, true)) {
-        WalletLogPrintf("CommitTransaction(): Transaction cannot be broadcast immediately, %s\n", err_string);
-        // TODO: if we expect the failure to be long term or permanent, instead delete wtx from the wallet and return failure.
-    }
+    // The transaction is persisted in the wallet database at this point, so
+    // hand relay to the node's scheduler instead of holding cs_wallet through
+    // mempool acceptance: the caller's latency is bounded by the database
+    // write. The scheduled job deliberately captures no wallet state beyond
+    // plain values, so it cannot outlive-race an unloading wallet; the
+    // entered-mempool notification flips the wallet tx to TxStateInMempool as
+    // usual, and if the broadcast is lost (e.g. to a shutdown racing the
+    // scheduler) the periodic ResubmitWalletTransactions pass retries it.
+    WalletLogPrintf("Queueing wtx %s for async mempool submission\n", tx->GetHash().ToString());
+    chain().scheduleAsync([chain = &chain(), tx, max_tx_fee = m_default_max_tx_fee, wallet_name = GetDisplayName()] {
+        std::string err_string;
+        if (!chain->broadcastTransaction(tx, max_tx_fee, /*relay=*/true, err_string)) {
+            LogPrintf("%s CommitTransaction(): Transaction cannot be broadcast immediately, %s\n", wallet_name, err_string);
+            // TODO: if we expect the failure to be long term or permanent, instead delete wtx from the wallet and return failure.
+        }
+    });
 }
 
 DBErrors CWallet::LoadWallet()
@@ -3699,9 +3878,7 @@ bool CWallet::MigrateToSQLite(bilingual_str& error)
         if (!ret) {
             break;
         }
-        SerializeData key(ss_key.begin(), ss_key.end());
-        SerializeData value(ss_value.begin(), ss_value.end());
-        records.emplace_back(key, value);
+        records.emplace_back(ss_key.release(), ss_value.release());
     }
     batch->CloseCursor();
     batch.reset();
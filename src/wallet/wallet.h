@@ -228,6 +228,15 @@ struct CRecipient
     bool fSubtractFeeFromAmount;
 };
 
+struct Balance {
+    CAmount m_mine_trusted{0};           //!< Trusted, at depth=GetBalance.min_depth or more
+    CAmount m_mine_untrusted_pending{0}; //!< Untrusted, but in mempool (pending)
+    CAmount m_mine_immature{0};          //!< Immature coinbases in the main chain
+    CAmount m_watchonly_trusted{0};
+    CAmount m_watchonly_untrusted_pending{0};
+    CAmount m_watchonly_immature{0};
+};
+
 class WalletRescanReserver; //forward declarations for ScanForWalletTransactions/RescanFromTime
 /**
  * A CWallet maintains a set of transactions and balances, and provides the ability to create new transactions.
@@ -397,6 +406,16 @@ public:
      * interested in, including received and sent transactions. */
     std::unordered_map<uint256, CWalletTx, SaltedTxidHasher> mapWallet GUARDED_BY(cs_wallet);
 
+    /** Cache of GetBalance() results keyed by (min_depth, avoid_reuse).
+     * Cleared by MarkBalancesDirty() on every event that can change a
+     * balance, so repeated balance RPCs between wallet or chain events do
+     * not re-walk mapWallet. The per-transaction credit/debit caches on
+     * CWalletTx remain the fallback used when recomputing. */
+    mutable std::map<std::pair<int, bool>, Balance> m_balance_cache GUARDED_BY(cs_wallet);
+
+    /** Invalidate all cached GetBalance() results. */
+    void MarkBalancesDirty() EXCLUSIVE_LOCKS_REQUIRED(cs_wallet) { m_balance_cache.clear(); }
+
     typedef std::multimap<int64_t, CWalletTx*> TxItems;
     TxItems wtxOrdered;
 
@@ -520,6 +539,10 @@ public:
     void blockConnected(const interfaces::BlockInfo& block) override;
     void blockDisconnected(const interfaces::BlockInfo& block) override;
     void updatedBlockTip() override;
+    //! Each wallet is an independent lock domain (cs_wallet plus its own
+    //! database), so block notifications for different wallets may be
+    //! processed concurrently.
+    bool parallelDispatchOk() override { return true; }
     int64_t RescanFromTime(int64_t startTime, const WalletRescanReserver& reserver, bool update);
 
     struct ScanResult {
@@ -25,6 +25,7 @@
 #include <atomic>
 #include <optional>
 #include <string>
+#include <thread>
 
 namespace wallet {
 namespace DBKeys {
@@ -773,6 +774,19 @@ DBErrors WalletBatch::LoadWallet(CWallet* pwallet)
     bool rescan_required = false;
     DBErrors result = DBErrors::LOAD_OK;
 
+    // Raw transaction records held back during the cursor walk, decoded in
+    // parallel and attached to the wallet afterwards.
+    struct DeferredTxRecord {
+        CDataStream key;
+        CDataStream value;
+        uint256 hash;
+        std::optional<CWalletTx> wtx;
+        std::string err;
+        bool upgraded{false};
+        DeferredTxRecord(CDataStream key_in, CDataStream value_in) : key{std::move(key_in)}, value{std::move(value_in)} {}
+    };
+    std::vector<DeferredTxRecord> tx_records;
+
     LOCK(pwallet->cs_wallet);
 
     // Last client version to open this wallet
@@ -829,6 +843,23 @@ DBErrors WalletBatch::LoadWallet(CWallet* pwallet)
                 return DBErrors::CORRUPT;
             }
 
+            // Defer transaction records to a second pass below: they are the
+            // bulk of a large wallet file and, unlike key records, their
+            // deserialization does not feed into the processing of other
+            // record types, so it can be done on all cores at once.
+            {
+                std::string type;
+                try {
+                    CDataStream ssPeek{ssKey};
+                    ssPeek >> type;
+                } catch (...) {
+                }
+                if (type == DBKeys::TX) {
+                    tx_records.emplace_back(std::move(ssKey), std::move(ssValue));
+                    continue;
+                }
+            }
+
             // Try to be tolerant of single corrupt records:
             std::string strType, strErr;
             if (!ReadKeyValue(pwallet, ssKey, ssValue, wss, strType, strErr))
@@ -868,6 +899,80 @@ DBErrors WalletBatch::LoadWallet(CWallet* pwallet)
     }
     m_batch->CloseCursor();
 
+    // Second pass: decode the deferred transaction records on all cores,
+    // then attach them to the wallet serially in file order (conflict
+    // propagation between transactions depends on that order).
+    if (!tx_records.empty()) {
+        const size_t worker_count{std::max<size_t>(1, std::thread::hardware_concurrency())};
+        std::vector<std::thread> workers;
+        workers.reserve(worker_count);
+        for (size_t w = 0; w < worker_count; ++w) {
+            workers.emplace_back([&, w] {
+                for (size_t i = w; i < tx_records.size(); i += worker_count) {
+                    DeferredTxRecord& record{tx_records[i]};
+                    try {
+                        std::string type;
+                        record.key >> type >> record.hash;
+                        CWalletTx wtx{nullptr, TxStateInactive{}};
+                        record.value >> wtx;
+                        if (wtx.GetHash() != record.hash) continue;
+
+                        // Undo serialize changes in 31600
+                        if (31404 <= wtx.fTimeReceivedIsTxTime && wtx.fTimeReceivedIsTxTime <= 31703) {
+                            if (!record.value.empty()) {
+                                uint8_t fTmp;
+                                uint8_t fUnused;
+                                std::string unused_string;
+                                record.value >> fTmp >> fUnused >> unused_string;
+                                record.err = strprintf("LoadWallet() upgrading tx ver=%d %d %s",
+                                                       wtx.fTimeReceivedIsTxTime, fTmp, record.hash.ToString());
+                                wtx.fTimeReceivedIsTxTime = fTmp;
+                            } else {
+                                record.err = strprintf("LoadWallet() repairing tx ver=%d %s", wtx.fTimeReceivedIsTxTime, record.hash.ToString());
+                                wtx.fTimeReceivedIsTxTime = 0;
+                            }
+                            record.upgraded = true;
+                        }
+                        record.wtx.emplace(std::move(wtx));
+                    } catch (...) {
+                        record.wtx.reset();
+                    }
+                }
+            });
+        }
+        for (std::thread& t : workers) t.join();
+
+        try {
+            for (DeferredTxRecord& record : tx_records) {
+                if (!record.err.empty()) pwallet->WalletLogPrintf("%s\n", record.err);
+                if (!record.wtx) {
+                    // Same handling as a bad DBKeys::TX record: warn the user
+                    // and trigger a rescan.
+                    fNoncriticalErrors = true;
+                    rescan_required = true;
+                    continue;
+                }
+                if (record.upgraded) wss.vWalletUpgrade.push_back(record.hash);
+                if (record.wtx->nOrderPos == -1) wss.fAnyUnordered = true;
+                auto fill_wtx = [&](CWalletTx& wtx, bool new_tx) {
+                    if (!new_tx) {
+                        // There's some corruption here since the tx we just tried to load was already in the wallet.
+                        // We don't consider this type of corruption critical, and can fix it by removing tx data and
+                        // rescanning.
+                        pwallet->WalletLogPrintf("Error: Corrupt transaction found. This can be fixed by removing transactions from wallet and rescanning.\n");
+                        result = DBErrors::CORRUPT;
+                        return false;
+                    }
+                    wtx = std::move(*record.wtx);
+                    return true;
+                };
+                pwallet->LoadToWallet(record.hash, fill_wtx);
+            }
+        } catch (...) {
+            result = DBErrors::CORRUPT;
+        }
+    }
+
     // Set the active ScriptPubKeyMans
     for (auto spk_man_pair : wss.m_active_external_spks) {
         pwallet->LoadActiveScriptPubKeyMan(spk_man_pair.second, spk_man_pair.first, /*internal=*/false);
@@ -55,6 +55,9 @@ public:
     virtual bool NotifyTransactionRemoval(const CTransaction &transaction, uint64_t mempool_sequence);
     // Notifies of transactions added to mempool or appearing in blocks
     virtual bool NotifyTransaction(const CTransaction &transaction);
+    // Publishes any buffered notifications; called periodically so batching
+    // notifiers do not hold back the tail of a burst
+    virtual bool FlushPending();
 
 protected:
     void *psocket;
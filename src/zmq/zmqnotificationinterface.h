@@ -21,6 +21,11 @@ public:
 
     static CZMQNotificationInterface* Create();
 
+    //! Publish any notifications held back by batching notifiers. Scheduled
+    //! periodically on the scheduler thread, which also runs the validation
+    //! interface callbacks, so notifier access stays single-threaded.
+    void FlushPendingNotifications();
+
 protected:
     bool Initialize();
     void Shutdown();
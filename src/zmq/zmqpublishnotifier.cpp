@@ -15,12 +15,16 @@
 
 #include <zmq.h>
 
+#include <chrono>
 #include <cstdarg>
 #include <cstddef>
+#include <cstring>
 #include <map>
+#include <memory>
 #include <optional>
 #include <string>
 #include <utility>
+#include <vector>
 
 using node::ReadBlockFromDisk;
 
@@ -30,6 +34,7 @@ static const char *MSG_HASHBLOCK = "hashblock";
 static const char *MSG_HASHTX    = "hashtx";
 static const char *MSG_RAWBLOCK  = "rawblock";
 static const char *MSG_RAWTX     = "rawtx";
+static const char *MSG_RAWTXBATCH = "rawtxbatch";
 static const char *MSG_SEQUENCE  = "sequence";
 
 // Internal function to send multipart message
@@ -204,6 +209,56 @@ bool CZMQAbstractPublishNotifier::SendZmqMessage(const char *command, const void
     return true;
 }
 
+// Deallocation callback handed to zmq_msg_init_data(); runs once zmq has
+// delivered the message and no longer needs the payload.
+static void FreeZmqMessageData(void* /*data*/, void* hint)
+{
+    delete static_cast<std::vector<unsigned char>*>(hint);
+}
+
+bool CZMQAbstractPublishNotifier::SendZmqMessage(const char *command, std::vector<unsigned char>&& data)
+{
+    assert(psocket);
+
+    /* command part */
+    if (zmq_send(psocket, command, strlen(command), ZMQ_SNDMORE) == -1)
+    {
+        zmqError("Unable to send ZMQ msg");
+        return false;
+    }
+
+    /* data part; zmq takes over the serialized buffer instead of copying it,
+       and frees it through FreeZmqMessageData once delivered */
+    auto holder = std::make_unique<std::vector<unsigned char>>(std::move(data));
+    zmq_msg_t msg;
+    if (zmq_msg_init_data(&msg, holder->data(), holder->size(), FreeZmqMessageData, holder.get()) != 0)
+    {
+        zmqError("Unable to initialize ZMQ msg");
+        return false;
+    }
+    holder.release();
+    if (zmq_msg_send(&msg, psocket, ZMQ_SNDMORE) == -1)
+    {
+        zmqError("Unable to send ZMQ msg");
+        zmq_msg_close(&msg); // runs the deallocation callback
+        return false;
+    }
+
+    /* sequence number part */
+    unsigned char msgseq[sizeof(uint32_t)];
+    WriteLE32(msgseq, nSequence);
+    if (zmq_send(psocket, msgseq, sizeof(msgseq), 0) == -1)
+    {
+        zmqError("Unable to send ZMQ msg");
+        return false;
+    }
+
+    /* increment memory only sequence number after sending */
+    nSequence++;
+
+    return true;
+}
+
 bool CZMQPublishHashBlockNotifier::NotifyBlock(const CBlockIndex *pindex)
 {
     uint256 hash = pindex->GetBlockHash();
@@ -231,7 +286,7 @@ bool CZMQPublishRawBlockNotifier::NotifyBlock(const CBlockIndex *pindex)
     LogPrint(BCLog::ZMQ, "Publish rawblock %s to %s\n", pindex->GetBlockHash().GetHex(), this->address);
 
     const Consensus::Params& consensusParams = Params().GetConsensus();
-    CDataStream ss(SER_NETWORK, PROTOCOL_VERSION | RPCSerializationFlags());
+    std::vector<unsigned char> data;
     {
         LOCK(cs_main);
         CBlock block;
@@ -241,19 +296,49 @@ bool CZMQPublishRawBlockNotifier::NotifyBlock(const CBlockIndex *pindex)
             return false;
         }
 
+        CVectorWriter ss(SER_NETWORK, PROTOCOL_VERSION | RPCSerializationFlags(), data, 0);
         ss << block;
     }
 
-    return SendZmqMessage(MSG_RAWBLOCK, &(*ss.begin()), ss.size());
+    return SendZmqMessage(MSG_RAWBLOCK, std::move(data));
 }
 
 bool CZMQPublishRawTransactionNotifier::NotifyTransaction(const CTransaction &transaction)
 {
     uint256 hash = transaction.GetHash();
     LogPrint(BCLog::ZMQ, "Publish rawtx %s to %s\n", hash.GetHex(), this->address);
-    CDataStream ss(SER_NETWORK, PROTOCOL_VERSION | RPCSerializationFlags());
+    std::vector<unsigned char> data;
+    CVectorWriter ss(SER_NETWORK, PROTOCOL_VERSION | RPCSerializationFlags(), data, 0);
+    ss << transaction;
+    return SendZmqMessage(MSG_RAWTX, std::move(data));
+}
+
+bool CZMQPublishRawTransactionBatchNotifier::NotifyTransaction(const CTransaction &transaction)
+{
+    LogPrint(BCLog::ZMQ, "Buffer rawtxbatch %s to %s\n", transaction.GetHash().GetHex(), this->address);
+    if (m_pending.empty()) {
+        m_batch_start = std::chrono::steady_clock::now();
+    }
+    CVectorWriter ss(SER_NETWORK, PROTOCOL_VERSION | RPCSerializationFlags(), m_pending, m_pending.size());
     ss << transaction;
-    return SendZmqMessage(MSG_RAWTX, &(*ss.begin()), ss.size());
+    ++m_pending_count;
+
+    // Publish once the batch window has closed; until then FlushPending()
+    // picks up whatever is buffered.
+    if (std::chrono::steady_clock::now() - m_batch_start >= BATCH_WINDOW) {
+        return FlushPending();
+    }
+    return true;
+}
+
+bool CZMQPublishRawTransactionBatchNotifier::FlushPending()
+{
+    if (m_pending.empty()) return true;
+    LogPrint(BCLog::ZMQ, "Publish rawtxbatch of %u transactions to %s\n", m_pending_count, this->address);
+    std::vector<unsigned char> batch;
+    batch.swap(m_pending);
+    m_pending_count = 0;
+    return SendZmqMessage(MSG_RAWTXBATCH, std::move(batch));
 }
 
 // Helper function to send a 'sequence' topic message with the following structure:
@@ -7,6 +7,10 @@
 
 #include <zmq/zmqabstractnotifier.h>
 
+#include <chrono>
+#include <cstddef>
+#include <vector>
+
 class CBlockIndex;
 
 class CZMQAbstractPublishNotifier : public CZMQAbstractNotifier
@@ -24,6 +28,11 @@ public:
     */
     bool SendZmqMessage(const char *command, const void* data, size_t size);
 
+    /* as above, but hands ownership of an already-serialized payload to zmq
+       (zmq_msg_init_data) instead of copying it into the message; used for
+       large raw block and transaction payloads */
+    bool SendZmqMessage(const char *command, std::vector<unsigned char>&& data);
+
     bool Initialize(void *pcontext) override;
     void Shutdown() override;
 };
@@ -52,6 +61,24 @@ public:
     bool NotifyTransaction(const CTransaction &transaction) override;
 };
 
+class CZMQPublishRawTransactionBatchNotifier : public CZMQAbstractPublishNotifier
+{
+private:
+    //! Serialized transactions buffered for the current batch window.
+    std::vector<unsigned char> m_pending;
+    //! Number of transactions in m_pending.
+    size_t m_pending_count{0};
+    //! When the first transaction of the current batch was buffered.
+    std::chrono::steady_clock::time_point m_batch_start;
+
+public:
+    //! How long transactions are coalesced before a batch is published.
+    static constexpr std::chrono::milliseconds BATCH_WINDOW{10};
+
+    bool NotifyTransaction(const CTransaction &transaction) override;
+    bool FlushPending() override;
+};
+
 class CZMQPublishSequenceNotifier : public CZMQAbstractPublishNotifier
 {
 public:
@@ -107,6 +107,18 @@ class NetTest(CoralTestFramework):
         # Check dynamically generated networks list in getpeerinfo help output.
         assert "(ipv4, ipv6, onion, i2p, cjdns, not_publicly_routable)" in self.nodes[0].help("getpeerinfo")
 
+        # Test the changed_since delta mode. A token of 0 reports every peer,
+        # in the same format as the plain call.
+        delta = self.nodes[0].getpeerinfo(changed_since=0)
+        assert_greater_than(delta['token'], 0)
+        assert_equal(sorted(p['id'] for p in delta['peers']),
+                     sorted(p['id'] for p in self.nodes[0].getpeerinfo()))
+        assert_equal(sorted(delta['connected_ids']), sorted(p['id'] for p in delta['peers']))
+        # New traffic makes a peer show up again in polls with the old token.
+        self.nodes[0].ping()
+        self.wait_until(lambda: len(self.nodes[0].getpeerinfo(changed_since=delta['token'])['peers']) == len(delta['peers']), timeout=5)
+        assert_raises_rpc_error(-8, "changed_since must be non-negative", self.nodes[0].getpeerinfo, changed_since=-1)
+
     def test_getnettotals(self):
         self.log.info("Test getnettotals")
         # Test getnettotals and getpeerinfo by doing a ping. The bytes